@@ -103,6 +103,13 @@
 /*! @brief This definition is maximum line that debugconsole can scanf each time.*/
 #define IO_MAXLINE 20U
 
+/*! @brief Buffered output, only supported on LPUART.*/
+#if (DEBUG_CONSOLE_TX_BUFFER_SIZE > 0U) && defined(FSL_FEATURE_SOC_LPUART_COUNT) && (FSL_FEATURE_SOC_LPUART_COUNT > 0)
+#define DEBUG_CONSOLE_TX_BUFFERED 1U
+#else
+#define DEBUG_CONSOLE_TX_BUFFERED 0U
+#endif
+
 /*! @brief The overflow value.*/
 #ifndef HUGE_VAL
 #define HUGE_VAL (99.e99)
@@ -165,6 +172,20 @@ typedef struct DebugConsoleState
     debug_console_ops_t ops; /*!< Operation function pointers for debug UART operations. */
 } debug_console_state_t;
 
+#if DEBUG_CONSOLE_TX_BUFFERED
+/*! @brief Transmit buffer of the debug console. */
+typedef struct DebugConsoleTxBuffer
+{
+    uint8_t data[DEBUG_CONSOLE_TX_BUFFER_SIZE]; /*!< Characters waiting to be sent. */
+    volatile uint32_t head;                     /*!< Index where the next character is written. */
+    volatile uint32_t tail;                     /*!< Index of the first character not sent yet. */
+    volatile uint32_t sending;                  /*!< Number of characters passed to the LPUART driver. */
+    volatile uint32_t dropped;                  /*!< Number of characters dropped because the buffer was full. */
+    bool enabled;                               /*!< Indicator telling whether the output is buffered. */
+    lpuart_handle_t handle;                     /*!< LPUART transactional handle. */
+} debug_console_tx_buffer_t;
+#endif /* DEBUG_CONSOLE_TX_BUFFERED */
+
 /*! @brief Type of KSDK printf function pointer. */
 typedef int (*PUTCHAR_FUNC)(int a);
 
@@ -213,9 +234,19 @@ enum _debugconsole_scanf_flag
 /*! @brief Debug UART state information. */
 static debug_console_state_t s_debugConsole = {.type = DEBUG_CONSOLE_DEVICE_TYPE_NONE, .base = NULL, .ops = {{0}, {0}}};
 
+#if DEBUG_CONSOLE_TX_BUFFERED
+/*! @brief Debug console transmit buffer. */
+static debug_console_tx_buffer_t s_debugConsoleTx;
+#endif /* DEBUG_CONSOLE_TX_BUFFERED */
+
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
+#if DEBUG_CONSOLE_TX_BUFFERED
+static void DbgConsole_TxStart(void);
+static void DbgConsole_TxCallback(LPUART_Type *base, lpuart_handle_t *handle, status_t status, void *userData);
+static int DbgConsole_BufferPutchar(int ch);
+#endif /* DEBUG_CONSOLE_TX_BUFFERED */
 #if SDK_DEBUGCONSOLE
 static int DbgConsole_PrintfFormattedData(PUTCHAR_FUNC func_ptr, const char *fmt, va_list ap);
 static int DbgConsole_ScanfFormattedData(const char *line_ptr, char *format, va_list args_ptr);
@@ -292,6 +323,15 @@ status_t DbgConsole_Init(uint32_t baseAddr, uint32_t baudRate, uint8_t device, u
             /* Set the function pointer for send and receive for this kind of device. */
             s_debugConsole.ops.tx_union.LPUART_PutChar = LPUART_WriteBlocking;
             s_debugConsole.ops.rx_union.LPUART_GetChar = LPUART_ReadBlocking;
+#if DEBUG_CONSOLE_TX_BUFFERED
+            /* The output is sent from the LPUART interrupt, the input is still polled. */
+            s_debugConsoleTx.head = 0U;
+            s_debugConsoleTx.tail = 0U;
+            s_debugConsoleTx.sending = 0U;
+            s_debugConsoleTx.dropped = 0U;
+            LPUART_TransferCreateHandle(s_debugConsole.base, &s_debugConsoleTx.handle, DbgConsole_TxCallback, NULL);
+            s_debugConsoleTx.enabled = true;
+#endif /* DEBUG_CONSOLE_TX_BUFFERED */
         }
         break;
 #endif /* FSL_FEATURE_SOC_LPUART_COUNT */
@@ -356,6 +396,11 @@ status_t DbgConsole_Deinit(void)
 #endif /* FSL_FEATURE_SOC_LPSCI_COUNT */
 #if defined(FSL_FEATURE_SOC_LPUART_COUNT) && (FSL_FEATURE_SOC_LPUART_COUNT > 0)
         case DEBUG_CONSOLE_DEVICE_TYPE_LPUART:
+#if DEBUG_CONSOLE_TX_BUFFERED
+            /* Send the buffered output first. */
+            DbgConsole_Flush();
+            s_debugConsoleTx.enabled = false;
+#endif /* DEBUG_CONSOLE_TX_BUFFERED */
             /* Disable LPUART module. */
             LPUART_Deinit(s_debugConsole.base);
             break;
@@ -388,6 +433,142 @@ status_t DbgConsole_Deinit(void)
     return kStatus_Success;
 }
 
+/* See fsl_debug_console.h for documentation of this function. */
+status_t DbgConsole_Flush(void)
+{
+#if DEBUG_CONSOLE_TX_BUFFERED
+    uint32_t primask;
+    uint32_t sent;
+    uint32_t length;
+#endif /* DEBUG_CONSOLE_TX_BUFFERED */
+
+    /* Do nothing if the debug UART is not initialized. */
+    if (s_debugConsole.type == DEBUG_CONSOLE_DEVICE_TYPE_NONE)
+    {
+        return kStatus_Fail;
+    }
+
+#if DEBUG_CONSOLE_TX_BUFFERED
+    if (s_debugConsoleTx.enabled)
+    {
+        primask = DisableGlobalIRQ();
+
+        /* Take back the characters not sent yet by the driver. */
+        if (s_debugConsoleTx.sending)
+        {
+            if (kStatus_Success !=
+                LPUART_TransferGetSendCount(s_debugConsole.base, &s_debugConsoleTx.handle, &sent))
+            {
+                sent = s_debugConsoleTx.sending;
+            }
+            LPUART_TransferAbortSend(s_debugConsole.base, &s_debugConsoleTx.handle);
+            s_debugConsoleTx.tail = (s_debugConsoleTx.tail + sent) % DEBUG_CONSOLE_TX_BUFFER_SIZE;
+            s_debugConsoleTx.sending = 0U;
+        }
+
+        while (s_debugConsoleTx.tail != s_debugConsoleTx.head)
+        {
+            length = (s_debugConsoleTx.head > s_debugConsoleTx.tail) ?
+                         (s_debugConsoleTx.head - s_debugConsoleTx.tail) :
+                         (DEBUG_CONSOLE_TX_BUFFER_SIZE - s_debugConsoleTx.tail);
+            LPUART_WriteBlocking(s_debugConsole.base, &s_debugConsoleTx.data[s_debugConsoleTx.tail], length);
+            s_debugConsoleTx.tail = (s_debugConsoleTx.tail + length) % DEBUG_CONSOLE_TX_BUFFER_SIZE;
+        }
+
+        EnableGlobalIRQ(primask);
+    }
+#endif /* DEBUG_CONSOLE_TX_BUFFERED */
+
+    return kStatus_Success;
+}
+
+/* See fsl_debug_console.h for documentation of this function. */
+uint32_t DbgConsole_GetTxDropCount(void)
+{
+#if DEBUG_CONSOLE_TX_BUFFERED
+    return s_debugConsoleTx.dropped;
+#else
+    return 0U;
+#endif /* DEBUG_CONSOLE_TX_BUFFERED */
+}
+
+#if DEBUG_CONSOLE_TX_BUFFERED
+/*!
+ * @brief Passes the oldest contiguous block of the transmit buffer to the LPUART driver.
+ *
+ * Must be called with interrupts disabled, or from the LPUART interrupt.
+ */
+static void DbgConsole_TxStart(void)
+{
+    lpuart_transfer_t xfer;
+    uint32_t head = s_debugConsoleTx.head;
+    uint32_t tail = s_debugConsoleTx.tail;
+
+    if (s_debugConsoleTx.sending || (head == tail))
+    {
+        return;
+    }
+
+    xfer.data = &s_debugConsoleTx.data[tail];
+    xfer.dataSize = (head > tail) ? (head - tail) : (DEBUG_CONSOLE_TX_BUFFER_SIZE - tail);
+    s_debugConsoleTx.sending = xfer.dataSize;
+
+    if (kStatus_Success != LPUART_TransferSendNonBlocking(s_debugConsole.base, &s_debugConsoleTx.handle, &xfer))
+    {
+        s_debugConsoleTx.sending = 0U;
+    }
+}
+
+/*!
+ * @brief LPUART transfer callback. Releases the block which was sent, and starts the next one.
+ */
+static void DbgConsole_TxCallback(LPUART_Type *base, lpuart_handle_t *handle, status_t status, void *userData)
+{
+    if (kStatus_LPUART_TxIdle == status)
+    {
+        s_debugConsoleTx.tail = (s_debugConsoleTx.tail + s_debugConsoleTx.sending) % DEBUG_CONSOLE_TX_BUFFER_SIZE;
+        s_debugConsoleTx.sending = 0U;
+        DbgConsole_TxStart();
+    }
+}
+
+/*!
+ * @brief Writes a character to the transmit buffer, or drops it if the buffer is full.
+ *
+ * @param   ch Character to be written.
+ * @return  Returns 1, or -1 if the character was dropped.
+ */
+static int DbgConsole_BufferPutchar(int ch)
+{
+    uint32_t primask;
+    uint32_t next;
+    int result = 1;
+
+    primask = DisableGlobalIRQ();
+
+    next = s_debugConsoleTx.head + 1U;
+    if (next == DEBUG_CONSOLE_TX_BUFFER_SIZE)
+    {
+        next = 0U;
+    }
+
+    if (next == s_debugConsoleTx.tail)
+    {
+        s_debugConsoleTx.dropped++;
+        result = -1;
+    }
+    else
+    {
+        s_debugConsoleTx.data[s_debugConsoleTx.head] = (uint8_t)ch;
+        s_debugConsoleTx.head = next;
+    }
+
+    EnableGlobalIRQ(primask);
+
+    return result;
+}
+#endif /* DEBUG_CONSOLE_TX_BUFFERED */
+
 #if SDK_DEBUGCONSOLE
 /* See fsl_debug_console.h for documentation of this function. */
 int DbgConsole_Printf(const char *fmt_s, ...)
@@ -400,6 +581,23 @@ int DbgConsole_Printf(const char *fmt_s, ...)
     {
         return -1;
     }
+#if DEBUG_CONSOLE_TX_BUFFERED
+    if (s_debugConsoleTx.enabled)
+    {
+        uint32_t primask;
+
+        /* Format into the buffer, then start the transfer once. */
+        va_start(ap, fmt_s);
+        result = DbgConsole_PrintfFormattedData(DbgConsole_BufferPutchar, fmt_s, ap);
+        va_end(ap);
+
+        primask = DisableGlobalIRQ();
+        DbgConsole_TxStart();
+        EnableGlobalIRQ(primask);
+
+        return result;
+    }
+#endif /* DEBUG_CONSOLE_TX_BUFFERED */
     va_start(ap, fmt_s);
     result = DbgConsole_PrintfFormattedData(DbgConsole_Putchar, fmt_s, ap);
     va_end(ap);
@@ -415,6 +613,19 @@ int DbgConsole_Putchar(int ch)
     {
         return -1;
     }
+#if DEBUG_CONSOLE_TX_BUFFERED
+    if (s_debugConsoleTx.enabled)
+    {
+        uint32_t primask;
+        int result = DbgConsole_BufferPutchar(ch);
+
+        primask = DisableGlobalIRQ();
+        DbgConsole_TxStart();
+        EnableGlobalIRQ(primask);
+
+        return result;
+    }
+#endif /* DEBUG_CONSOLE_TX_BUFFERED */
     s_debugConsole.ops.tx_union.PutChar(s_debugConsole.base, (uint8_t *)(&ch), 1);
 
     return 1;
@@ -84,6 +84,13 @@
 #define SCANF_ADVANCED_ENABLE 0U
 #endif /* SCANF_ADVANCED_ENABLE */
 
+/*! @brief Size of the transmit buffer, in bytes. When not 0, the output to a LPUART console is buffered and
+ * sent by the LPUART transactional driver from interrupts. The output functions never wait for the UART,
+ * characters which do not fit in the buffer are dropped and counted. */
+#ifndef DEBUG_CONSOLE_TX_BUFFER_SIZE
+#define DEBUG_CONSOLE_TX_BUFFER_SIZE 0U
+#endif /* DEBUG_CONSOLE_TX_BUFFER_SIZE */
+
 #if SDK_DEBUGCONSOLE /* Select printf, scanf, putchar, getchar of SDK version. */
 #define PRINTF DbgConsole_Printf
 #define SCANF DbgConsole_Scanf
@@ -182,6 +189,25 @@ int DbgConsole_Getchar(void);
 
 #endif /* SDK_DEBUGCONSOLE */
 
+/*!
+ * @brief Sends the buffered output, waiting for the UART.
+ *
+ * Call this function before a reset, or from a fault or panic handler, so that the buffered output is not lost.
+ * It can be called with interrupts disabled. Does nothing if the output is not buffered.
+ *
+ * @return Indicates whether the output was sent or not.
+ * @retval kStatus_Success          The buffer is empty
+ * @retval kStatus_Fail             The debug console is not initialized
+ */
+status_t DbgConsole_Flush(void);
+
+/*!
+ * @brief Gets the number of characters dropped because the transmit buffer was full.
+ *
+ * @return The number of dropped characters, since initialization.
+ */
+uint32_t DbgConsole_GetTxDropCount(void);
+
 /*! @} */
 
 #if defined(__cplusplus)
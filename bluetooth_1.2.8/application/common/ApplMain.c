@@ -28,6 +28,7 @@
 #include "Flash_Adapter.h"
 #include "SecLib.h"
 #include "Panic.h"
+#include "Profiler.h"
 
 #if gFsciIncluded_c    
 #include "FsciInterface.h"
@@ -57,12 +58,17 @@
 #endif
 
 #include "ApplMain.h"
+#include "ble_service_discovery.h"
 
 
 #if gAppUseNvm_d
 /* include NVM interface */
 #include "NVM_Interface.h"
 #endif
+
+#if gNtfFanout_Enabled_d
+#include "notification_fanout_interface.h"
+#endif
 /************************************************************************************
 *************************************************************************************
 * Private macros
@@ -81,6 +87,17 @@
 /* Application Events */
 #define gAppEvtMsgFromHostStack_c       (1 << 0)
 #define gAppEvtAppCallback_c            (1 << 1)
+#define gAppEvtScanReport_c             (1 << 2)
+
+/* The ring indexes are free running uint8_t, masked on access: the size must be a
+   power of 2, and below 256 so that a full ring differs from an empty one */
+#if gAppScanReportRing_d && ((gAppScanRingSize_c == 0) || (gAppScanRingSize_c & (gAppScanRingSize_c - 1)))
+#error "gAppScanRingSize_c must be a power of 2"
+#endif
+
+#if gAppScanReportRing_d && (gAppScanRingSize_c > 128)
+#error "gAppScanRingSize_c must not exceed 128"
+#endif
 
 #ifdef FSL_RTOS_FREE_RTOS
     #if (configUSE_IDLE_HOOK)
@@ -175,6 +192,24 @@ typedef struct appMsgCallback_tag{
     appCallbackHandler_t   handler;
     appCallbackParam_t     param;
 }appMsgCallback_t;
+
+#if gAppScanReportRing_d
+/* Scan report ring slot. The advertising data is kept in place, next to the event. */
+typedef struct appScanSlot_tag{
+    gapScanningEvent_t  event;
+    uint8_t             aData[gcGapMaxAdvertisingDataLength_c];
+}appScanSlot_t;
+#endif
+
+#if gAppScanDedupWindowMs_c
+/* Duplicate filter entry */
+typedef struct appScanDedupEntry_tag{
+    bleAddressType_t    addressType;
+    bleDeviceAddress_t  aAddress;
+    uint32_t            dataHash;
+    uint32_t            lastSeenMs;
+}appScanDedupEntry_t;
+#endif
 /************************************************************************************
 *************************************************************************************
 * Private prototypes
@@ -200,6 +235,13 @@ static void App_GenericCallback (gapGenericEvent_t* pGenericEvent);
 static void App_ConnectionCallback (deviceId_t peerDeviceId, gapConnectionEvent_t* pConnectionEvent);
 static void App_AdvertisingCallback (gapAdvertisingEvent_t* pAdvertisingEvent);
 static void App_ScanningCallback (gapScanningEvent_t* pAdvertisingEvent);
+#if gAppScanDedupWindowMs_c
+static bool_t App_ScanIsDuplicate (gapScannedDevice_t* pDevice);
+#endif
+#if gAppScanReportRing_d
+static void App_ScanReportPush (gapScannedDevice_t* pDevice);
+static void App_ScanReportDrain (void);
+#endif
 static void App_GattServerCallback (deviceId_t peerDeviceId, gattServerEvent_t* pServerEvent);
 static void App_GattClientProcedureCallback
 (
@@ -290,11 +332,26 @@ static bleBondDataBlob_t          maBondDataBlobs[gMaxBondedDevices_c] = {{{{0}}
 static osaEventId_t  mAppEvent;
 
 /* Application input queues */
-static anchor_t mHostAppInputQueue;
+static msgMpscQueue_t mHostAppInputQueue;
 static anchor_t mAppCbInputQueue;
 
 static uint8_t platformInitialized = 0;
 
+/* Scan report path */
+static appScanStatistics_t mScanStats;
+static uint64_t mScanStartTs;
+
+#if gAppScanReportRing_d
+static appScanSlot_t maScanRing[gAppScanRingSize_c];
+static volatile uint8_t mScanRingHead;
+static volatile uint8_t mScanRingTail;
+static volatile bool_t mScanWakeupPending;
+#endif
+
+#if gAppScanDedupWindowMs_c
+static appScanDedupEntry_t maScanDedup[gAppScanDedupEntries_c];
+#endif
+
 static gapGenericCallback_t pfGenericCallback = NULL;
 static gapAdvertisingCallback_t pfAdvCallback = NULL;
 static gapScanningCallback_t pfScanCallback = NULL;
@@ -393,7 +450,7 @@ void main_task(uint32_t param)
         }
         
         /* Prepare application input queue.*/
-        MSG_InitQueue(&mHostAppInputQueue);
+        MSG_MpscInit(&mHostAppInputQueue);
         
         /* Prepare callback input queue.*/
         MSG_InitQueue(&mAppCbInputQueue);
@@ -426,26 +483,36 @@ void App_Thread (uint32_t param)
     { 
         OSA_EventWait(mAppEvent, osaEventFlagsAll_c, FALSE, osaWaitForever_c , &event);
         
+        PROFILER_PROBE_START(mAppThreadProbe, "App_Thread");
+
+#if gAppScanReportRing_d
+        /* All the reports queued since the last wakeup are handled at once */
+        if (event & gAppEvtScanReport_c)
+        {
+            App_ScanReportDrain();
+        }
+#endif
+
         /* Dequeue the host to app message */
         if (event & gAppEvtMsgFromHostStack_c)
         {
-            /* Pointer for storing the messages from host. */
-            appMsgFromHost_t *pMsgIn = NULL;  
+            /* Pointers for storing the messages from host. */
+            appMsgFromHost_t *pMsgIn;
+            appMsgFromHost_t *pMsgNext;
             
-            /* Check for existing messages in queue */
-            while(MSG_Pending(&mHostAppInputQueue))
-            {
-                pMsgIn = MSG_DeQueue(&mHostAppInputQueue);
+            /* Take all the messages queued since the last wakeup at once */
+            pMsgIn = MSG_MpscPopAll(&mHostAppInputQueue);
             
-                if (pMsgIn)
-                {
-                    /* Process it */
-                    App_HandleHostMessageInput(pMsgIn);
-                    
-                    /* Messages must always be freed. */
-                    MSG_Free(pMsgIn);
-                    pMsgIn = NULL;
-                }
+            while (pMsgIn)
+            {
+                pMsgNext = MSG_MpscNext(pMsgIn);
+                
+                /* Process it */
+                App_HandleHostMessageInput(pMsgIn);
+                
+                /* Messages must always be freed. */
+                MSG_Free(pMsgIn);
+                pMsgIn = pMsgNext;
             }
         }
         
@@ -475,6 +542,8 @@ void App_Thread (uint32_t param)
             }
         }
 
+        PROFILER_PROBE_STOP(mAppThreadProbe);
+
         /* For BareMetal break the while(1) after 1 run */
         if( gUseRtos_c == 0 )
         {
@@ -603,9 +672,28 @@ bleResult_t App_StartScanning(
 {
     pfScanCallback = scanningCallback;
     
+    FLib_MemSet(&mScanStats, 0, sizeof(mScanStats));
+    mScanStartTs = TMR_GetTimestamp();
+#if gAppScanDedupWindowMs_c
+    FLib_MemSet(maScanDedup, 0, sizeof(maScanDedup));
+#endif
+
     return Gap_StartScanning(pScanningParameters, App_ScanningCallback,  enableFilterDuplicates);
 }
 
+void App_GetScanStatistics(appScanStatistics_t* pStats)
+{
+    uint64_t elapsedUs = TMR_GetTimestamp() - mScanStartTs;
+
+    *pStats = mScanStats;
+    pStats->deliveredPerSecond = 0;
+
+    if (elapsedUs != 0)
+    {
+        pStats->deliveredPerSecond = (uint32_t)(((uint64_t)mScanStats.reportsDelivered * 1000000) / elapsedUs);
+    }
+}
+
 bleResult_t App_RegisterGattServerCallback(gattServerCallback_t  serverCallback)
 {
     pfGattServerCallback = serverCallback;
@@ -990,18 +1078,41 @@ static void App_HandleHostMessageInput(appMsgFromHost_t* pMsg)
         }
         case gAppGapScanMsg_c:
         {
+#if gAppScanReportRing_d
+            /* Reports received before this event are handled first */
+            App_ScanReportDrain();
+#endif
+            if (pMsg->msgData.scanMsg.eventType == gDeviceScanned_c)
+            {
+                mScanStats.reportsDelivered++;
+            }
+
             if (pfScanCallback)
                 pfScanCallback(&pMsg->msgData.scanMsg);
             break;
         }
         case gAppGapConnectionMsg_c:
         {
+#if gNtfFanout_Enabled_d
+            /* Keep the notification subscriber masks in sync with the links */
+            if (pMsg->msgData.connMsg.connEvent.eventType == gConnEvtConnected_c)
+            {
+                NtfFanout_AddClient(pMsg->msgData.connMsg.deviceId);
+            }
+            else if (pMsg->msgData.connMsg.connEvent.eventType == gConnEvtDisconnected_c)
+            {
+                NtfFanout_RemoveClient(pMsg->msgData.connMsg.deviceId);
+            }
+#endif
             if (pfConnCallback)
                 pfConnCallback(pMsg->msgData.connMsg.deviceId, &pMsg->msgData.connMsg.connEvent);
             break;
         }
         case gAppGattServerMsg_c:
         {
+#if gNtfFanout_Enabled_d
+            NtfFanout_HandleGattServerEvent(pMsg->msgData.gattServerMsg.deviceId, &pMsg->msgData.gattServerMsg.serverEvent);
+#endif
             if (pfGattServerCallback)
                 pfGattServerCallback(pMsg->msgData.gattServerMsg.deviceId, &pMsg->msgData.gattServerMsg.serverEvent);
             break;
@@ -1028,6 +1139,11 @@ static void App_HandleHostMessageInput(appMsgFromHost_t* pMsg)
         }
         case gAppGattClientIndicationMsg_c:
         {
+#if gServDiscCacheEnabled_d
+            BleServDisc_SignalGattClientIndication(
+                pMsg->msgData.gattClientNotifIndMsg.deviceId,
+                pMsg->msgData.gattClientNotifIndMsg.characteristicValueHandle);
+#endif
             if (pfGattClientIndCallback)
                 pfGattClientIndCallback(
                     pMsg->msgData.gattClientNotifIndMsg.deviceId,
@@ -1074,7 +1190,7 @@ static void App_GenericCallback (gapGenericEvent_t* pGenericEvent)
     FLib_MemCpy(&pMsgIn->msgData.genericMsg, pGenericEvent, sizeof(gapGenericEvent_t));
 
     /* Put message in the Host Stack to App queue */
-    MSG_Queue(&mHostAppInputQueue, pMsgIn);
+    MSG_MpscPush(&mHostAppInputQueue, pMsgIn);
 
     /* Signal application */
     OSA_EventSet(mAppEvent, gAppEvtMsgFromHostStack_c);  
@@ -1167,7 +1283,7 @@ static void App_ConnectionCallback (deviceId_t peerDeviceId, gapConnectionEvent_
     }
 
     /* Put message in the Host Stack to App queue */
-    MSG_Queue(&mHostAppInputQueue, pMsgIn);
+    MSG_MpscPush(&mHostAppInputQueue, pMsgIn);
 
     /* Signal application */
     OSA_EventSet(mAppEvent, gAppEvtMsgFromHostStack_c);  
@@ -1187,7 +1303,7 @@ static void App_AdvertisingCallback (gapAdvertisingEvent_t* pAdvertisingEvent)
     pMsgIn->msgData.advMsg.eventData = pAdvertisingEvent->eventData;
 
     /* Put message in the Host Stack to App queue */
-    MSG_Queue(&mHostAppInputQueue, pMsgIn);
+    MSG_MpscPush(&mHostAppInputQueue, pMsgIn);
 
     /* Signal application */
     OSA_EventSet(mAppEvent, gAppEvtMsgFromHostStack_c);  
@@ -1201,13 +1317,31 @@ static void App_ScanningCallback (gapScanningEvent_t* pScanningEvent)
     
     if (pScanningEvent->eventType == gDeviceScanned_c)
     {
+        mScanStats.reportsReceived++;
+
+#if gAppScanDedupWindowMs_c
+        if (App_ScanIsDuplicate(&pScanningEvent->eventData.scannedDevice))
+        {
+            mScanStats.duplicatesFiltered++;
+            return;
+        }
+#endif
+
+#if gAppScanReportRing_d
+        App_ScanReportPush(&pScanningEvent->eventData.scannedDevice);
+        return;
+#else
         msgLen += pScanningEvent->eventData.scannedDevice.dataLength;
+#endif
     }
     
     pMsgIn = MSG_Alloc(msgLen);
           
     if (!pMsgIn)
-      return;
+    {
+        mScanStats.allocFailures++;
+        return;
+    }
     
     pMsgIn->msgType = gAppGapScanMsg_c;
     pMsgIn->msgData.scanMsg.eventType = pScanningEvent->eventType;
@@ -1231,12 +1365,121 @@ static void App_ScanningCallback (gapScanningEvent_t* pScanningEvent)
     }
 
     /* Put message in the Host Stack to App queue */
-    MSG_Queue(&mHostAppInputQueue, pMsgIn);
+    MSG_MpscPush(&mHostAppInputQueue, pMsgIn);
 
     /* Signal application */
     OSA_EventSet(mAppEvent, gAppEvtMsgFromHostStack_c);  
 }
 
+#if gAppScanDedupWindowMs_c
+/* Returns TRUE if the same advertiser sent the same data within the filter
+   window. Otherwise the report is recorded, replacing the oldest entry. */
+static bool_t App_ScanIsDuplicate (gapScannedDevice_t* pDevice)
+{
+    appScanDedupEntry_t *pEntry = NULL;
+    uint32_t nowMs = (uint32_t)(TMR_GetTimestamp() / 1000);
+    uint32_t hash = 2166136261U;
+    uint8_t i;
+
+    /* FNV-1a over the report type and the advertising data */
+    hash = (hash ^ (uint8_t)pDevice->advEventType) * 16777619U;
+    for (i = 0; i < pDevice->dataLength; i++)
+    {
+        hash = (hash ^ pDevice->data[i]) * 16777619U;
+    }
+
+    for (i = 0; i < gAppScanDedupEntries_c; i++)
+    {
+        if ((maScanDedup[i].addressType == pDevice->addressType) &&
+            FLib_MemCmp(maScanDedup[i].aAddress, pDevice->aAddress, sizeof(bleDeviceAddress_t)))
+        {
+            pEntry = &maScanDedup[i];
+            break;
+        }
+
+        if ((pEntry == NULL) || (maScanDedup[i].lastSeenMs < pEntry->lastSeenMs))
+        {
+            pEntry = &maScanDedup[i];
+        }
+    }
+
+    if ((i < gAppScanDedupEntries_c) && (pEntry->dataHash == hash) &&
+        (nowMs - pEntry->lastSeenMs < gAppScanDedupWindowMs_c))
+    {
+        return TRUE;
+    }
+
+    pEntry->addressType = pDevice->addressType;
+    FLib_MemCpy(pEntry->aAddress, pDevice->aAddress, sizeof(bleDeviceAddress_t));
+    pEntry->dataHash = hash;
+    pEntry->lastSeenMs = nowMs;
+
+    return FALSE;
+}
+#endif
+
+#if gAppScanReportRing_d
+/* Called from the Host Stack context. Copies the report into the next free
+   slot and wakes up the Application Task only if it is not already pending. */
+static void App_ScanReportPush (gapScannedDevice_t* pDevice)
+{
+    appScanSlot_t *pSlot;
+    uint8_t used = (uint8_t)(mScanRingHead - mScanRingTail);
+    uint8_t length = pDevice->dataLength;
+
+    if (used >= gAppScanRingSize_c)
+    {
+        mScanStats.ringFullDrops++;
+        return;
+    }
+
+    if (length > gcGapMaxAdvertisingDataLength_c)
+    {
+        length = gcGapMaxAdvertisingDataLength_c;
+    }
+
+    pSlot = &maScanRing[mScanRingHead & (gAppScanRingSize_c - 1)];
+    pSlot->event.eventType = gDeviceScanned_c;
+    FLib_MemCpy(&pSlot->event.eventData.scannedDevice, pDevice, sizeof(gapScannedDevice_t));
+    pSlot->event.eventData.scannedDevice.dataLength = length;
+    pSlot->event.eventData.scannedDevice.data = pSlot->aData;
+    FLib_MemCpy(pSlot->aData, pDevice->data, length);
+
+    /* Publish the slot */
+    mScanRingHead++;
+
+    if (used + 1 > mScanStats.peakRingOccupancy)
+    {
+        mScanStats.peakRingOccupancy = used + 1;
+    }
+
+    if (!mScanWakeupPending)
+    {
+        mScanWakeupPending = TRUE;
+        OSA_EventSet(mAppEvent, gAppEvtScanReport_c);
+    }
+}
+
+/* Called from the Application Task. The reports are passed to the application
+   in place and the slots are released when the callback returns. */
+static void App_ScanReportDrain (void)
+{
+    /* Cleared before draining: a report pushed from now on sets the event again */
+    mScanWakeupPending = FALSE;
+
+    while (mScanRingTail != mScanRingHead)
+    {
+        if (pfScanCallback)
+        {
+            pfScanCallback(&maScanRing[mScanRingTail & (gAppScanRingSize_c - 1)].event);
+        }
+
+        mScanStats.reportsDelivered++;
+        mScanRingTail++;
+    }
+}
+#endif
+
 static void App_GattServerCallback
 (
     deviceId_t          deviceId,
@@ -1273,7 +1516,7 @@ static void App_GattServerCallback
     }
     
     /* Put message in the Host Stack to App queue */
-    MSG_Queue(&mHostAppInputQueue, pMsgIn);
+    MSG_MpscPush(&mHostAppInputQueue, pMsgIn);
 
     /* Signal application */
     OSA_EventSet(mAppEvent, gAppEvtMsgFromHostStack_c);  
@@ -1300,7 +1543,7 @@ static void App_GattClientProcedureCallback
     pMsgIn->msgData.gattClientProcMsg.procedureResult = procedureResult;
 
     /* Put message in the Host Stack to App queue */
-    MSG_Queue(&mHostAppInputQueue, pMsgIn);
+    MSG_MpscPush(&mHostAppInputQueue, pMsgIn);
 
     /* Signal application */
     OSA_EventSet(mAppEvent, gAppEvtMsgFromHostStack_c);
@@ -1333,7 +1576,7 @@ static void App_GattClientNotificationCallback
     FLib_MemCpy(pMsgIn->msgData.gattClientNotifIndMsg.aValue, aValue, valueLength);
 
     /* Put message in the Host Stack to App queue */
-    MSG_Queue(&mHostAppInputQueue, pMsgIn);
+    MSG_MpscPush(&mHostAppInputQueue, pMsgIn);
 
     /* Signal application */
     OSA_EventSet(mAppEvent, gAppEvtMsgFromHostStack_c);
@@ -1366,7 +1609,7 @@ static void App_GattClientIndicationCallback
     FLib_MemCpy(pMsgIn->msgData.gattClientNotifIndMsg.aValue, aValue, valueLength);
 
     /* Put message in the Host Stack to App queue */
-    MSG_Queue(&mHostAppInputQueue, pMsgIn);
+    MSG_MpscPush(&mHostAppInputQueue, pMsgIn);
 
     /* Signal application */
     OSA_EventSet(mAppEvent, gAppEvtMsgFromHostStack_c);
@@ -1399,7 +1642,7 @@ static void App_L2caLeDataCallback
     FLib_MemCpy(pMsgIn->msgData.l2caLeCbDataMsg.aPacket, pPacket, packetLength);
 
     /* Put message in the Host Stack to App queue */
-    MSG_Queue(&mHostAppInputQueue, pMsgIn);
+    MSG_MpscPush(&mHostAppInputQueue, pMsgIn);
 
     /* Signal application */
     OSA_EventSet(mAppEvent, gAppEvtMsgFromHostStack_c);
@@ -1459,7 +1702,7 @@ static void App_L2caLeControlCallback
     FLib_MemCpy(pMsgIn->msgData.l2caLeCbControlMsg.aMessage, pMessage, messageLength);
 
     /* Put message in the Host Stack to App queue */
-    MSG_Queue(&mHostAppInputQueue, pMsgIn);
+    MSG_MpscPush(&mHostAppInputQueue, pMsgIn);
 
     /* Signal application */
     OSA_EventSet(mAppEvent, gAppEvtMsgFromHostStack_c);
@@ -29,6 +29,18 @@
 typedef void* appCallbackParam_t;
 typedef void (*appCallbackHandler_t)(appCallbackParam_t param);
 
+/*! Scan report path statistics, reset by App_StartScanning() */
+typedef struct appScanStatistics_tag
+{
+    uint32_t    reportsReceived;        /*!< Advertising reports received from the host stack. */
+    uint32_t    reportsDelivered;       /*!< Advertising reports passed to the application callback. */
+    uint32_t    duplicatesFiltered;     /*!< Reports dropped by the duplicate filter. */
+    uint32_t    ringFullDrops;          /*!< Reports dropped because the scan report ring was full. */
+    uint32_t    allocFailures;          /*!< Scan events dropped because no message could be allocated. */
+    uint32_t    deliveredPerSecond;     /*!< Sustained delivery rate since scanning was started. */
+    uint8_t     peakRingOccupancy;      /*!< Highest number of reports waiting in the ring. */
+} appScanStatistics_t;
+
 /*! *********************************************************************************
 *************************************************************************************
 * Public macros
@@ -62,6 +74,28 @@ typedef void (*appCallbackHandler_t)(appCallbackParam_t param);
 #define gAppIdleTaskPriority_c  (8)
 #endif
 
+/*! Deliver advertising reports through a fixed ring of report slots, drained in
+    batches by the Application Task, instead of allocating one message per report */
+#ifndef gAppScanReportRing_d
+#define gAppScanReportRing_d        (0)
+#endif
+
+/*! Number of slots in the scan report ring. Must be a power of 2, up to 128. */
+#ifndef gAppScanRingSize_c
+#define gAppScanRingSize_c          (8)
+#endif
+
+/*! Reports with the same address and advertising data received within this
+    window are dropped. 0 disables the duplicate filter. */
+#ifndef gAppScanDedupWindowMs_c
+#define gAppScanDedupWindowMs_c     (0)
+#endif
+
+/*! Number of advertisers tracked by the duplicate filter */
+#ifndef gAppScanDedupEntries_c
+#define gAppScanDedupEntries_c      (16)
+#endif
+
 /*! *********************************************************************************
 *************************************************************************************
 * Public memory declarations
@@ -130,6 +164,16 @@ bleResult_t App_StartScanning(
     bool_t                      enableFilterDuplicates
 );
 
+/*! *********************************************************************************
+* \brief  Returns the statistics of the scan report path.
+*
+* \param[out] pStats   Pointer to the statistics structure.
+*
+********************************************************************************** */
+void App_GetScanStatistics(
+    appScanStatistics_t*    pStats
+);
+
 /*! *********************************************************************************
 * \brief  Application wrapper function for GattClient_RegisterNotificationCallback.
 *
@@ -17,9 +17,12 @@
 *************************************************************************************
 ************************************************************************************/
 #include "MemManager.h"
+#include "FunctionLib.h"
+#include "TimersManager.h"
 #include "Panic.h"
 
 #include "ble_general.h"
+#include "ble_sig_defines.h"
 #include "gap_types.h"
 #include "gap_interface.h"
 #include "gatt_client_interface.h"
@@ -30,6 +33,24 @@
 
 #include "ApplMain.h"
 
+#if gServDiscCacheEnabled_d && gAppUseNvm_d
+#include "NVM_Interface.h"
+#endif
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+/* Marker of a valid cache entry (ASCII = SD) */
+#define mServDiscCacheMarker_c      0x5344U
+
+#define mServDiscInvalidSlot_c      0xFFU
+
+/* Tags saved in the custom information of bonds without cache entry */
+#define mServDiscNoTag_c            0x00000000U
+#define mServDiscErasedTag_c        0xFFFFFFFFU
+
 /************************************************************************************
 *************************************************************************************
 * Private type definitions
@@ -53,8 +74,65 @@ typedef struct servDiscInfo_tag
     uint8_t mcPrimaryServices;
     bool_t  mServDiscInProgress;
 
+    /* Characteristics of all services are discovered with one procedure */
+    bool_t  mBatchCharDiscovery;
+    bool_t  mBatchPending;
+    gattService_t mBatchRange;
+
+    /* Timing */
+    uint64_t mStartTs;
+    uint32_t mDurationMs;
+
+#if gServDiscCacheEnabled_d
+    /* Cache entry being filled by the discovery in progress, or being replayed */
+    uint8_t mCacheSlot;
+    bool_t  mCacheReplay;
+#endif
 }servDiscInfo_t;
 
+#if gServDiscCacheEnabled_d
+typedef struct servDiscCachedAttr_tag
+{
+    uint16_t        handle;
+    bleUuidType_t   uuidType;
+    bleUuid_t       uuid;
+}servDiscCachedAttr_t;
+
+typedef struct servDiscCachedChar_tag
+{
+    servDiscCachedAttr_t    value;
+    uint8_t                 properties;
+    uint8_t                 cNumDescriptors;
+}servDiscCachedChar_t;
+
+typedef struct servDiscCachedService_tag
+{
+    uint16_t        startHandle;
+    uint16_t        endHandle;
+    bleUuidType_t   uuidType;
+    bleUuid_t       uuid;
+    uint8_t         cNumCharacteristics;
+}servDiscCachedService_t;
+
+/* Discovery results of one bonded peer. The entry is found through its tag,
+   which is saved in the custom information of the bond, so it follows the
+   bond whatever address the peer uses. Characteristics and descriptors are
+   stored back to back, in the order of the services. */
+typedef struct servDiscCacheEntry_tag
+{
+    uint32_t                tag;
+    uint16_t                marker;
+    uint16_t                serviceChangedHandle;
+    uint8_t                 cServices;
+    uint8_t                 cChars;
+    uint8_t                 cDescriptors;
+    bool_t                  overflow;
+    servDiscCachedService_t aServices[gMaxServicesCount_d];
+    servDiscCachedChar_t    aChars[gServDiscCacheMaxCharCount_c];
+    servDiscCachedAttr_t    aDescriptors[gServDiscCacheMaxDescriptorsCount_c];
+}servDiscCacheEntry_t;
+#endif
+
 /************************************************************************************
 *************************************************************************************
 * Public memory declarations
@@ -69,6 +147,17 @@ typedef struct servDiscInfo_tag
 static void BleServDisc_Reset(deviceId_t peerDeviceId);
 static void BleServDisc_Finished(deviceId_t peerDeviceId, bool_t result);
 static void BleServDisc_NewService(deviceId_t peerDeviceId, gattService_t *pService);
+static void BleServDisc_DiscoverCharacteristics(deviceId_t peerDeviceId);
+static void BleServDisc_DistributeCharacteristics(servDiscInfo_t *pInfo);
+static void BleServDisc_Continue(deviceId_t peerDeviceId);
+#if gServDiscCacheEnabled_d
+static servDiscCacheEntry_t* BleServDisc_CacheFind(deviceId_t peerDeviceId);
+static void BleServDisc_CacheBegin(deviceId_t peerDeviceId);
+static void BleServDisc_CacheAddService(servDiscInfo_t *pInfo, gattService_t *pService);
+static void BleServDisc_CacheCommit(deviceId_t peerDeviceId);
+static void BleServDisc_CacheReplay(appCallbackParam_t param);
+static void BleServDisc_CacheSave(servDiscCacheEntry_t *pEntry);
+#endif
 /************************************************************************************
 *************************************************************************************
 * Private memory declarations
@@ -78,6 +167,15 @@ static servDiscCallback_t pfServDiscCallback = NULL;
 
 servDiscInfo_t maServDiscInfo[gAppMaxConnections_c];
 
+#if gServDiscCacheEnabled_d
+static servDiscCacheEntry_t maServDiscCache[gServDiscCacheEntries_c];
+static uint8_t mServDiscCacheVictim;
+
+#if gAppUseNvm_d
+NVM_RegisterDataSet(maServDiscCache, gServDiscCacheEntries_c, sizeof(servDiscCacheEntry_t), nvmId_ServDiscCacheId_c, gNVM_MirroredInRam_c);
+#endif
+#endif
+
 /************************************************************************************
 *************************************************************************************
 * Public functions
@@ -92,29 +190,72 @@ void BleServDisc_RegisterCallback(servDiscCallback_t pServDiscCallback)
 bleResult_t BleServDisc_Start(deviceId_t peerDeviceId)
 {
     bleResult_t result = gBleSuccess_c;
+    servDiscInfo_t *pInfo = &maServDiscInfo[peerDeviceId];
+    uint8_t cChars = gMaxServiceCharCount_d;
 
-    if (!maServDiscInfo[peerDeviceId].mServDiscInProgress)
+    if (!pInfo->mServDiscInProgress)
     {
+        pInfo->mStartTs = TMR_GetTimestamp();
+        pInfo->mBatchCharDiscovery = FALSE;
+
         /* Allocate memory for Service Discovery */
-        maServDiscInfo[peerDeviceId].mpServiceDiscoveryBuffer = MEM_BufferAlloc(sizeof(gattService_t) * gMaxServicesCount_d);
-        maServDiscInfo[peerDeviceId].mpCharDiscoveryBuffer = MEM_BufferAlloc(sizeof(gattCharacteristic_t) * gMaxServiceCharCount_d);
-        maServDiscInfo[peerDeviceId].mpCharDescriptorBuffer = MEM_BufferAlloc(sizeof(gattAttribute_t) * gMaxCharDescriptorsCount_d);
+        pInfo->mpServiceDiscoveryBuffer = MEM_BufferAlloc(sizeof(gattService_t) * gMaxServicesCount_d);
+#if gServDiscBatchCharDiscovery_d
+        pInfo->mpCharDiscoveryBuffer = MEM_BufferAlloc(sizeof(gattCharacteristic_t) * gServDiscMaxTotalCharCount_d);
 
-        if (maServDiscInfo[peerDeviceId].mpServiceDiscoveryBuffer != NULL &&
-            maServDiscInfo[peerDeviceId].mpCharDiscoveryBuffer != NULL &&
-            maServDiscInfo[peerDeviceId].mpCharDescriptorBuffer != NULL)
+        if (pInfo->mpCharDiscoveryBuffer != NULL)
+        {
+            pInfo->mBatchCharDiscovery = TRUE;
+            cChars = gServDiscMaxTotalCharCount_d;
+        }
+        else
+#endif
         {
-            maServDiscInfo[peerDeviceId].mServDiscInProgress = TRUE;
+            pInfo->mpCharDiscoveryBuffer = MEM_BufferAlloc(sizeof(gattCharacteristic_t) * gMaxServiceCharCount_d);
+        }
+        pInfo->mpCharDescriptorBuffer = MEM_BufferAlloc(sizeof(gattAttribute_t) * gMaxCharDescriptorsCount_d);
+
+        if (pInfo->mpServiceDiscoveryBuffer != NULL &&
+            pInfo->mpCharDiscoveryBuffer != NULL &&
+            pInfo->mpCharDescriptorBuffer != NULL)
+        {
+            FLib_MemSet(pInfo->mpCharDiscoveryBuffer, 0, sizeof(gattCharacteristic_t) * cChars);
+            FLib_MemSet(pInfo->mpCharDescriptorBuffer, 0, sizeof(gattAttribute_t) * gMaxCharDescriptorsCount_d);
+            pInfo->mServDiscInProgress = TRUE;
+
+#if gServDiscCacheEnabled_d
+            {
+                servDiscCacheEntry_t *pEntry = BleServDisc_CacheFind(peerDeviceId);
+
+                /* The results are reported from the application task, as a discovery would */
+                if (pEntry != NULL)
+                {
+                    pInfo->mCacheSlot = (uint8_t)(pEntry - maServDiscCache);
+                    pInfo->mCacheReplay = TRUE;
+
+                    if (App_PostCallbackMessage(BleServDisc_CacheReplay,
+                                                (appCallbackParam_t)(uint32_t)peerDeviceId) == gBleSuccess_c)
+                    {
+                        return gBleSuccess_c;
+                    }
+
+                    pInfo->mCacheReplay = FALSE;
+                }
+
+                BleServDisc_CacheBegin(peerDeviceId);
+            }
+#endif
 
             /* Start Service Discovery*/
             result = GattClient_DiscoverAllPrimaryServices(
                                         peerDeviceId,
-                                        maServDiscInfo[peerDeviceId].mpServiceDiscoveryBuffer,
+                                        pInfo->mpServiceDiscoveryBuffer,
                                         gMaxServicesCount_d,
-                                        &maServDiscInfo[peerDeviceId].mcPrimaryServices);
+                                        &pInfo->mcPrimaryServices);
         }
         else
         {
+            BleServDisc_Reset(peerDeviceId);
             result = gBleOutOfMemory_c;
         }
     }
@@ -131,6 +272,14 @@ bleResult_t BleServDisc_FindService(deviceId_t peerDeviceId, bleUuidType_t uuidT
 
 	if (!maServDiscInfo[peerDeviceId].mServDiscInProgress)
 	{
+		maServDiscInfo[peerDeviceId].mStartTs = TMR_GetTimestamp();
+		maServDiscInfo[peerDeviceId].mBatchCharDiscovery = FALSE;
+#if gServDiscCacheEnabled_d
+		/* Partial results are not cached */
+		maServDiscInfo[peerDeviceId].mCacheSlot = mServDiscInvalidSlot_c;
+		maServDiscInfo[peerDeviceId].mCacheReplay = FALSE;
+#endif
+
 		/* Allocate memory for Service Discovery */
 		maServDiscInfo[peerDeviceId].mpServiceDiscoveryBuffer = MEM_BufferAlloc(sizeof(gattService_t));
 		maServDiscInfo[peerDeviceId].mpCharDiscoveryBuffer = MEM_BufferAlloc(sizeof(gattCharacteristic_t) * gMaxServiceCharCount_d);
@@ -153,6 +302,7 @@ bleResult_t BleServDisc_FindService(deviceId_t peerDeviceId, bleUuidType_t uuidT
 		}
 		else
 		{
+			BleServDisc_Reset(peerDeviceId);
 			result = gBleOutOfMemory_c;
 		}
 	}
@@ -201,13 +351,25 @@ void BleServDisc_SignalGattClientEvent(
                         pInfo->mCurrentCharInDiscoveryIndex = 0;
                         pInfo->mCurrentDescInDiscoveryIndex = 0;
 
-                        pInfo->mpServiceDiscoveryBuffer->aCharacteristics = pInfo->mpCharDiscoveryBuffer;
-
-                        /* Start Characteristic Discovery for current service */
-                        GattClient_DiscoverAllCharacteristicsOfService(
-                                                    peerDeviceId,
-                                                    pInfo->mpServiceDiscoveryBuffer,
-                                                    gMaxServiceCharCount_d);
+                        if (pInfo->mBatchCharDiscovery)
+                        {
+                            /* Services are discovered in handle order: a single
+                               read-by-type chain covers all of them */
+                            FLib_MemSet(&pInfo->mBatchRange, 0, sizeof(gattService_t));
+                            pInfo->mBatchRange.startHandle = pInfo->mpServiceDiscoveryBuffer->startHandle;
+                            pInfo->mBatchRange.endHandle = (pInfo->mpServiceDiscoveryBuffer + pInfo->mcPrimaryServices - 1)->endHandle;
+                            pInfo->mBatchRange.aCharacteristics = pInfo->mpCharDiscoveryBuffer;
+                            pInfo->mBatchPending = TRUE;
+
+                            GattClient_DiscoverAllCharacteristicsOfService(
+                                                        peerDeviceId,
+                                                        &pInfo->mBatchRange,
+                                                        gServDiscMaxTotalCharCount_d);
+                        }
+                        else
+                        {
+                            BleServDisc_DiscoverCharacteristics(peerDeviceId);
+                        }
                     }
                 }
                 break;
@@ -222,80 +384,31 @@ void BleServDisc_SignalGattClientEvent(
                     /* Move on to the next characteristic */
                     pInfo->mCurrentCharInDiscoveryIndex++; 
                     
-                    /* Fall through */
+                    BleServDisc_Continue(peerDeviceId);
                 }    
+                break;
+
                 case gGattProcDiscoverAllCharacteristics_c:
                 {
-                    gattService_t        *pCurrentService = pInfo->mpServiceDiscoveryBuffer + pInfo->mCurrentServiceInDiscoveryIndex;
-                    
-                    if (pInfo->mCurrentCharInDiscoveryIndex < pCurrentService->cNumCharacteristics)
+                    if (pInfo->mBatchPending)
                     {
-                        gattCharacteristic_t *pCurrentChar = pCurrentService->aCharacteristics + pInfo->mCurrentCharInDiscoveryIndex;
-                        
-                        /* Find next characteristic with descriptors*/
-                        while (pInfo->mCurrentCharInDiscoveryIndex < pCurrentService->cNumCharacteristics - 1)
+                        pInfo->mBatchPending = FALSE;
+
+                        if (pInfo->mBatchRange.cNumCharacteristics < gServDiscMaxTotalCharCount_d)
                         {
-                            /* Check if we have handles available between adjacent characteristics */
-                            if (pCurrentChar->value.handle + 2 < (pCurrentChar + 1)->value.handle)
-                            {
-                                if (pInfo->mCurrentDescInDiscoveryIndex < gMaxCharDescriptorsCount_d)
-                                {
-                                    pCurrentChar->aDescriptors = pInfo->mpCharDescriptorBuffer + pInfo->mCurrentDescInDiscoveryIndex;
-                                    GattClient_DiscoverAllCharacteristicDescriptors(peerDeviceId,
-                                                            pCurrentChar,
-                                                            (pCurrentChar + 1)->value.handle,
-                                                            gMaxCharDescriptorsCount_d - pInfo->mCurrentDescInDiscoveryIndex);
-                                    return;
-                                }
-                            }
-
-                            pInfo->mCurrentCharInDiscoveryIndex++;
-                            pCurrentChar = pCurrentService->aCharacteristics + pInfo->mCurrentCharInDiscoveryIndex;
+                            BleServDisc_DistributeCharacteristics(pInfo);
                         }
-
-                        /* Made it to the last characteristic. Check against service end handle*/
-                        if (pCurrentChar->value.handle < pCurrentService->endHandle)
+                        else
                         {
-                            if (pInfo->mCurrentDescInDiscoveryIndex < gMaxCharDescriptorsCount_d)
-                            {
-                                pCurrentChar->aDescriptors = pInfo->mpCharDescriptorBuffer + pInfo->mCurrentDescInDiscoveryIndex;
-                                GattClient_DiscoverAllCharacteristicDescriptors(peerDeviceId,
-                                                        pCurrentChar,
-                                                        pCurrentService->endHandle,
-                                                        gMaxCharDescriptorsCount_d - pInfo->mCurrentDescInDiscoveryIndex);
-                                return;
-                            }
-
+                            /* The buffer may have been too small: go on one service at a time */
+                            pInfo->mBatchCharDiscovery = FALSE;
+                            FLib_MemSet(pInfo->mpCharDiscoveryBuffer, 0, sizeof(gattCharacteristic_t) * gMaxServiceCharCount_d);
+                            BleServDisc_DiscoverCharacteristics(peerDeviceId);
+                            break;
                         }
                     }
 
-                    /* Signal Discovery of Service */
-                    BleServDisc_NewService(peerDeviceId, pCurrentService);
-
-                    /* Move on to the next service */
-                    pInfo->mCurrentServiceInDiscoveryIndex++;
-
-                    /* Reset characteristic discovery */
-                    pInfo->mCurrentCharInDiscoveryIndex = 0;
-                    pInfo->mCurrentDescInDiscoveryIndex = 0;
-                    FLib_MemSet(pInfo->mpCharDescriptorBuffer, 0, sizeof(gattAttribute_t) * gMaxCharDescriptorsCount_d);
-                    FLib_MemSet(pInfo->mpCharDiscoveryBuffer, 0, sizeof(gattCharacteristic_t) * gMaxServiceCharCount_d);
-
-                    if (pInfo->mCurrentServiceInDiscoveryIndex < pInfo->mcPrimaryServices)
-                    {
-                        /* Allocate memory for Char Discovery */
-                        (pInfo->mpServiceDiscoveryBuffer + pInfo->mCurrentServiceInDiscoveryIndex)->aCharacteristics = pInfo->mpCharDiscoveryBuffer;
-
-                         /* Start Characteristic Discovery for current service */
-                        GattClient_DiscoverAllCharacteristicsOfService(peerDeviceId,
-                                pInfo->mpServiceDiscoveryBuffer + pInfo->mCurrentServiceInDiscoveryIndex,
-                                                    gMaxServiceCharCount_d);
-                    }
-                    else
-                    {
-                        BleServDisc_Finished(peerDeviceId, TRUE);
-                    }
-
+                    BleServDisc_Continue(peerDeviceId);
                 }
                 break;
 
@@ -306,6 +419,31 @@ void BleServDisc_SignalGattClientEvent(
     }
 }
 
+void BleServDisc_SignalGattClientIndication(
+    deviceId_t              peerDeviceId,
+    uint16_t                characteristicValueHandle
+)
+{
+#if gServDiscCacheEnabled_d
+    servDiscCacheEntry_t *pEntry = BleServDisc_CacheFind(peerDeviceId);
+
+    if ((pEntry != NULL) && (pEntry->serviceChangedHandle != 0) &&
+        (pEntry->serviceChangedHandle == characteristicValueHandle))
+    {
+        pEntry->marker = 0;
+        BleServDisc_CacheSave(pEntry);
+    }
+#else
+    (void)peerDeviceId;
+    (void)characteristicValueHandle;
+#endif
+}
+
+uint32_t BleServDisc_GetDiscoveryTime(deviceId_t peerDeviceId)
+{
+    return maServDiscInfo[peerDeviceId].mDurationMs;
+}
+
 /************************************************************************************
 *************************************************************************************
 * Private functions
@@ -335,9 +473,18 @@ static void BleServDisc_Reset(deviceId_t peerDeviceId)
 static void BleServDisc_Finished(deviceId_t peerDeviceId, bool_t result)
 {
     servDiscEvent_t event;
-    
+
+#if gServDiscCacheEnabled_d
+    if (result)
+    {
+        BleServDisc_CacheCommit(peerDeviceId);
+    }
+#endif
+
+    maServDiscInfo[peerDeviceId].mDurationMs = (uint32_t)((TMR_GetTimestamp() - maServDiscInfo[peerDeviceId].mStartTs) / 1000);
+
     BleServDisc_Stop(peerDeviceId);
-    
+
     event.eventType = gDiscoveryFinished_c;
     event.eventData.success = result;
     pfServDiscCallback(peerDeviceId, &event);
@@ -347,11 +494,418 @@ static void BleServDisc_NewService(deviceId_t peerDeviceId, gattService_t *pServ
 {
     servDiscEvent_t event;
 
+#if gServDiscCacheEnabled_d
+    BleServDisc_CacheAddService(&maServDiscInfo[peerDeviceId], pService);
+#endif
+
     event.eventType = gServiceDiscovered_c;
     event.eventData.pService = pService;
     pfServDiscCallback(peerDeviceId, &event);
 }
 
+/* Starts the Characteristic Discovery of the current service */
+static void BleServDisc_DiscoverCharacteristics(deviceId_t peerDeviceId)
+{
+    servDiscInfo_t *pInfo = &maServDiscInfo[peerDeviceId];
+    gattService_t  *pCurrentService = pInfo->mpServiceDiscoveryBuffer + pInfo->mCurrentServiceInDiscoveryIndex;
+
+    pCurrentService->aCharacteristics = pInfo->mpCharDiscoveryBuffer;
+
+    GattClient_DiscoverAllCharacteristicsOfService(peerDeviceId,
+                                                   pCurrentService,
+                                                   gMaxServiceCharCount_d);
+}
+
+/* Assigns the characteristics found by a batched discovery to their services */
+static void BleServDisc_DistributeCharacteristics(servDiscInfo_t *pInfo)
+{
+    gattService_t        *pService;
+    gattCharacteristic_t *pChar = pInfo->mBatchRange.aCharacteristics;
+    gattCharacteristic_t *pEnd = pChar + pInfo->mBatchRange.cNumCharacteristics;
+    uint8_t i;
+
+    for (i = 0; i < pInfo->mcPrimaryServices; i++)
+    {
+        pService = pInfo->mpServiceDiscoveryBuffer + i;
+
+        /* Skip characteristics of secondary services between the primary ones */
+        while ((pChar < pEnd) && (pChar->value.handle <= pService->startHandle))
+        {
+            pChar++;
+        }
+
+        pService->aCharacteristics = pChar;
+        pService->cNumCharacteristics = 0;
+
+        while ((pChar < pEnd) && (pChar->value.handle <= pService->endHandle))
+        {
+            pService->cNumCharacteristics++;
+            pChar++;
+        }
+    }
+}
+
+/* Discovers the descriptors of the current service, then moves on to the next
+   service until all are reported */
+static void BleServDisc_Continue(deviceId_t peerDeviceId)
+{
+    servDiscInfo_t *pInfo = &maServDiscInfo[peerDeviceId];
+
+    for (;;)
+    {
+        gattService_t *pCurrentService = pInfo->mpServiceDiscoveryBuffer + pInfo->mCurrentServiceInDiscoveryIndex;
+
+        if (pInfo->mCurrentCharInDiscoveryIndex < pCurrentService->cNumCharacteristics)
+        {
+            gattCharacteristic_t *pCurrentChar = pCurrentService->aCharacteristics + pInfo->mCurrentCharInDiscoveryIndex;
+
+            /* Find next characteristic with descriptors*/
+            while (pInfo->mCurrentCharInDiscoveryIndex < pCurrentService->cNumCharacteristics - 1)
+            {
+                /* Check if we have handles available between adjacent characteristics */
+                if (pCurrentChar->value.handle + 2 < (pCurrentChar + 1)->value.handle)
+                {
+                    if (pInfo->mCurrentDescInDiscoveryIndex < gMaxCharDescriptorsCount_d)
+                    {
+                        pCurrentChar->aDescriptors = pInfo->mpCharDescriptorBuffer + pInfo->mCurrentDescInDiscoveryIndex;
+                        GattClient_DiscoverAllCharacteristicDescriptors(peerDeviceId,
+                                                pCurrentChar,
+                                                (pCurrentChar + 1)->value.handle,
+                                                gMaxCharDescriptorsCount_d - pInfo->mCurrentDescInDiscoveryIndex);
+                        return;
+                    }
+                }
+
+                pInfo->mCurrentCharInDiscoveryIndex++;
+                pCurrentChar = pCurrentService->aCharacteristics + pInfo->mCurrentCharInDiscoveryIndex;
+            }
+
+            /* Made it to the last characteristic. Check against service end handle*/
+            if (pCurrentChar->value.handle < pCurrentService->endHandle)
+            {
+                if (pInfo->mCurrentDescInDiscoveryIndex < gMaxCharDescriptorsCount_d)
+                {
+                    pCurrentChar->aDescriptors = pInfo->mpCharDescriptorBuffer + pInfo->mCurrentDescInDiscoveryIndex;
+                    GattClient_DiscoverAllCharacteristicDescriptors(peerDeviceId,
+                                            pCurrentChar,
+                                            pCurrentService->endHandle,
+                                            gMaxCharDescriptorsCount_d - pInfo->mCurrentDescInDiscoveryIndex);
+                    return;
+                }
+            }
+        }
+
+        /* Signal Discovery of Service */
+        BleServDisc_NewService(peerDeviceId, pCurrentService);
+
+        /* Move on to the next service */
+        pInfo->mCurrentServiceInDiscoveryIndex++;
+
+        /* Reset characteristic discovery */
+        pInfo->mCurrentCharInDiscoveryIndex = 0;
+        pInfo->mCurrentDescInDiscoveryIndex = 0;
+        FLib_MemSet(pInfo->mpCharDescriptorBuffer, 0, sizeof(gattAttribute_t) * gMaxCharDescriptorsCount_d);
+
+        if (pInfo->mCurrentServiceInDiscoveryIndex >= pInfo->mcPrimaryServices)
+        {
+            BleServDisc_Finished(peerDeviceId, TRUE);
+            return;
+        }
+
+        /* With batched discovery, the characteristics are already known */
+        if (!pInfo->mBatchCharDiscovery)
+        {
+            FLib_MemSet(pInfo->mpCharDiscoveryBuffer, 0, sizeof(gattCharacteristic_t) * gMaxServiceCharCount_d);
+
+            /* Start Characteristic Discovery for current service */
+            BleServDisc_DiscoverCharacteristics(peerDeviceId);
+            return;
+        }
+    }
+}
+
+#if gServDiscCacheEnabled_d
+/* Returns the valid cache entry of a bonded peer, if any */
+static servDiscCacheEntry_t* BleServDisc_CacheFind(deviceId_t peerDeviceId)
+{
+    bool_t isBonded = FALSE;
+    uint32_t tag;
+    uint8_t i;
+
+    if ((Gap_CheckIfBonded(peerDeviceId, &isBonded) != gBleSuccess_c) || !isBonded ||
+        (Gap_LoadCustomPeerInformation(peerDeviceId, &tag, gServDiscCacheCustomInfoOffset_c,
+                                       sizeof(tag)) != gBleSuccess_c))
+    {
+        return NULL;
+    }
+
+    /* Bonds saved without a cache entry hold no tag, or an erased one */
+    if ((tag == mServDiscNoTag_c) || (tag == mServDiscErasedTag_c))
+    {
+        return NULL;
+    }
+
+    for (i = 0; i < gServDiscCacheEntries_c; i++)
+    {
+        if ((maServDiscCache[i].marker == mServDiscCacheMarker_c) &&
+            (maServDiscCache[i].tag == tag))
+        {
+            return &maServDiscCache[i];
+        }
+    }
+
+    return NULL;
+}
+
+/* Selects the cache entry to be filled by a full discovery */
+static void BleServDisc_CacheBegin(deviceId_t peerDeviceId)
+{
+    servDiscInfo_t *pInfo = &maServDiscInfo[peerDeviceId];
+    servDiscCacheEntry_t *pEntry;
+    uint32_t tag = mServDiscNoTag_c;
+    uint8_t slot = mServDiscInvalidSlot_c;
+    uint8_t i, j;
+
+    pInfo->mCacheSlot = mServDiscInvalidSlot_c;
+
+    /* The bond may still be created during this connection: it is checked
+       when the results are committed. Prefer a free entry, then evict in round-robin order. Entries being
+       filled by other connections are skipped. */
+    for (i = 0; (i < gServDiscCacheEntries_c) && (slot == mServDiscInvalidSlot_c); i++)
+    {
+        if (maServDiscCache[i].marker != mServDiscCacheMarker_c)
+        {
+            slot = i;
+        }
+    }
+
+    for (i = 0; (i < gServDiscCacheEntries_c) && (slot == mServDiscInvalidSlot_c); i++)
+    {
+        slot = (mServDiscCacheVictim + i) % gServDiscCacheEntries_c;
+
+        for (j = 0; j < gAppMaxConnections_c; j++)
+        {
+            if ((j != peerDeviceId) && maServDiscInfo[j].mServDiscInProgress &&
+                (maServDiscInfo[j].mCacheSlot == slot))
+            {
+                slot = mServDiscInvalidSlot_c;
+                break;
+            }
+        }
+    }
+
+    if (slot == mServDiscInvalidSlot_c)
+    {
+        return;
+    }
+
+    mServDiscCacheVictim = (slot + 1) % gServDiscCacheEntries_c;
+    pInfo->mCacheSlot = slot;
+
+    /* A new tag, so that bonds pointing to the evicted results no longer match */
+    for (i = 0; i < gServDiscCacheEntries_c; i++)
+    {
+        if ((maServDiscCache[i].tag > tag) && (maServDiscCache[i].tag != mServDiscErasedTag_c))
+        {
+            tag = maServDiscCache[i].tag;
+        }
+    }
+
+    tag++;
+
+    if (tag == mServDiscErasedTag_c)
+    {
+        tag = mServDiscNoTag_c + 1;
+    }
+
+    pEntry = &maServDiscCache[slot];
+    FLib_MemSet(pEntry, 0, sizeof(servDiscCacheEntry_t));
+    pEntry->tag = tag;
+}
+
+static void BleServDisc_CacheAddService(servDiscInfo_t *pInfo, gattService_t *pService)
+{
+    servDiscCacheEntry_t    *pEntry;
+    servDiscCachedService_t *pCachedService;
+    servDiscCachedChar_t    *pCachedChar;
+    gattCharacteristic_t    *pChar;
+    uint8_t i, j;
+
+    if ((pInfo->mCacheSlot == mServDiscInvalidSlot_c) || pInfo->mCacheReplay)
+    {
+        return;
+    }
+
+    pEntry = &maServDiscCache[pInfo->mCacheSlot];
+
+    if ((pEntry->overflow) || (pEntry->cServices >= gMaxServicesCount_d) ||
+        (pService->cNumCharacteristics > gMaxServiceCharCount_d) ||
+        (pEntry->cChars + pService->cNumCharacteristics > gServDiscCacheMaxCharCount_c))
+    {
+        pEntry->overflow = TRUE;
+        return;
+    }
+
+    pCachedService = &pEntry->aServices[pEntry->cServices++];
+    pCachedService->startHandle = pService->startHandle;
+    pCachedService->endHandle = pService->endHandle;
+    pCachedService->uuidType = pService->uuidType;
+    pCachedService->uuid = pService->uuid;
+    pCachedService->cNumCharacteristics = pService->cNumCharacteristics;
+
+    for (i = 0; i < pService->cNumCharacteristics; i++)
+    {
+        pChar = pService->aCharacteristics + i;
+        pCachedChar = &pEntry->aChars[pEntry->cChars++];
+
+        pCachedChar->properties = (uint8_t)pChar->properties;
+        pCachedChar->value.handle = pChar->value.handle;
+        pCachedChar->value.uuidType = pChar->value.uuidType;
+        pCachedChar->value.uuid = pChar->value.uuid;
+        pCachedChar->cNumDescriptors = pChar->cNumDescriptors;
+
+        if ((pChar->value.uuidType == gBleUuidType16_c) &&
+            (pChar->value.uuid.uuid16 == gBleSig_GattServiceChanged_d))
+        {
+            pEntry->serviceChangedHandle = pChar->value.handle;
+        }
+
+        if (pEntry->cDescriptors + pChar->cNumDescriptors > gServDiscCacheMaxDescriptorsCount_c)
+        {
+            pEntry->overflow = TRUE;
+            return;
+        }
+
+        for (j = 0; j < pChar->cNumDescriptors; j++)
+        {
+            pEntry->aDescriptors[pEntry->cDescriptors].handle = pChar->aDescriptors[j].handle;
+            pEntry->aDescriptors[pEntry->cDescriptors].uuidType = pChar->aDescriptors[j].uuidType;
+            pEntry->aDescriptors[pEntry->cDescriptors].uuid = pChar->aDescriptors[j].uuid;
+            pEntry->cDescriptors++;
+        }
+    }
+}
+
+static void BleServDisc_CacheCommit(deviceId_t peerDeviceId)
+{
+    servDiscInfo_t *pInfo = &maServDiscInfo[peerDeviceId];
+    servDiscCacheEntry_t *pEntry;
+    bool_t isBonded = FALSE;
+
+    if ((pInfo->mCacheSlot == mServDiscInvalidSlot_c) || pInfo->mCacheReplay)
+    {
+        pInfo->mCacheSlot = mServDiscInvalidSlot_c;
+        pInfo->mCacheReplay = FALSE;
+        return;
+    }
+
+    pEntry = &maServDiscCache[pInfo->mCacheSlot];
+    pInfo->mCacheSlot = mServDiscInvalidSlot_c;
+
+    (void)Gap_CheckIfBonded(peerDeviceId, &isBonded);
+
+    /* Incomplete results would hide services on the next connection */
+    if (isBonded && !pEntry->overflow &&
+        (Gap_SaveCustomPeerInformation(peerDeviceId, &pEntry->tag, gServDiscCacheCustomInfoOffset_c,
+                                       sizeof(pEntry->tag)) == gBleSuccess_c))
+    {
+        pEntry->marker = mServDiscCacheMarker_c;
+        BleServDisc_CacheSave(pEntry);
+    }
+}
+
+/* Reports the cached services as if they were just discovered. Runs in the
+   application task, posted by BleServDisc_Start() */
+static void BleServDisc_CacheReplay(appCallbackParam_t param)
+{
+    deviceId_t               peerDeviceId = (deviceId_t)(uint32_t)param;
+    servDiscInfo_t          *pInfo = &maServDiscInfo[peerDeviceId];
+    servDiscCacheEntry_t    *pEntry;
+    servDiscCachedService_t *pCachedService;
+    servDiscCachedChar_t    *pCachedChar;
+    servDiscCachedAttr_t    *pCachedDesc;
+    gattService_t           *pService;
+    gattCharacteristic_t    *pChar;
+    uint8_t cDescriptors;
+    uint8_t i, j, k;
+
+    /* Stopped in the meantime */
+    if (!pInfo->mServDiscInProgress || !pInfo->mCacheReplay)
+    {
+        return;
+    }
+
+    pEntry = &maServDiscCache[pInfo->mCacheSlot];
+
+    /* Invalidated by a Service Changed indication in the meantime */
+    if (pEntry->marker != mServDiscCacheMarker_c)
+    {
+        BleServDisc_Finished(peerDeviceId, FALSE);
+        return;
+    }
+
+    pCachedChar = pEntry->aChars;
+    pCachedDesc = pEntry->aDescriptors;
+    pInfo->mcPrimaryServices = pEntry->cServices;
+
+    for (i = 0; i < pEntry->cServices; i++)
+    {
+        pCachedService = &pEntry->aServices[i];
+        pService = pInfo->mpServiceDiscoveryBuffer + i;
+
+        FLib_MemSet(pInfo->mpCharDiscoveryBuffer, 0, sizeof(gattCharacteristic_t) * gMaxServiceCharCount_d);
+        FLib_MemSet(pInfo->mpCharDescriptorBuffer, 0, sizeof(gattAttribute_t) * gMaxCharDescriptorsCount_d);
+
+        pService->startHandle = pCachedService->startHandle;
+        pService->endHandle = pCachedService->endHandle;
+        pService->uuidType = pCachedService->uuidType;
+        pService->uuid = pCachedService->uuid;
+        pService->cNumCharacteristics = pCachedService->cNumCharacteristics;
+        pService->aCharacteristics = pInfo->mpCharDiscoveryBuffer;
+        pService->cNumIncludedServices = 0;
+        pService->aIncludedServices = NULL;
+
+        cDescriptors = 0;
+
+        for (j = 0; j < pCachedService->cNumCharacteristics; j++, pCachedChar++)
+        {
+            pChar = pService->aCharacteristics + j;
+
+            pChar->properties = (gattCharacteristicPropertiesBitFields_t)pCachedChar->properties;
+            pChar->value.handle = pCachedChar->value.handle;
+            pChar->value.uuidType = pCachedChar->value.uuidType;
+            pChar->value.uuid = pCachedChar->value.uuid;
+            pChar->aDescriptors = pInfo->mpCharDescriptorBuffer + cDescriptors;
+
+            for (k = 0; k < pCachedChar->cNumDescriptors; k++, pCachedDesc++)
+            {
+                if (cDescriptors < gMaxCharDescriptorsCount_d)
+                {
+                    pInfo->mpCharDescriptorBuffer[cDescriptors].handle = pCachedDesc->handle;
+                    pInfo->mpCharDescriptorBuffer[cDescriptors].uuidType = pCachedDesc->uuidType;
+                    pInfo->mpCharDescriptorBuffer[cDescriptors].uuid = pCachedDesc->uuid;
+                    cDescriptors++;
+                    pChar->cNumDescriptors++;
+                }
+            }
+        }
+
+        BleServDisc_NewService(peerDeviceId, pService);
+    }
+
+    BleServDisc_Finished(peerDeviceId, TRUE);
+}
+
+static void BleServDisc_CacheSave(servDiscCacheEntry_t *pEntry)
+{
+#if gAppUseNvm_d
+    (void)NvSaveOnIdle(pEntry, FALSE);
+#else
+    (void)pEntry;
+#endif
+}
+#endif /* gServDiscCacheEnabled_d */
+
 /*! *********************************************************************************
 * @}
 ********************************************************************************** */
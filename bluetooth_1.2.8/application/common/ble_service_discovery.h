@@ -42,6 +42,47 @@
 #define gMaxCharDescriptorsCount_d      4
 #endif
 
+/*! Discovers the characteristics of all services with a single procedure
+    spanning the whole discovered handle range, instead of one per service */
+#ifndef gServDiscBatchCharDiscovery_d
+#define gServDiscBatchCharDiscovery_d   0
+#endif
+
+/*! Maximum Number of Characteristics stored during a batched Characteristic Discovery */
+#ifndef gServDiscMaxTotalCharCount_d
+#define gServDiscMaxTotalCharCount_d    (2 * gMaxServiceCharCount_d)
+#endif
+
+/*! Caches the discovery results of bonded peers, so that reconnections skip discovery */
+#ifndef gServDiscCacheEnabled_d
+#define gServDiscCacheEnabled_d         0
+#endif
+
+/*! Number of bonded peers whose discovery results are cached */
+#ifndef gServDiscCacheEntries_c
+#define gServDiscCacheEntries_c         2
+#endif
+
+/*! Maximum Number of Characteristics cached per peer */
+#ifndef gServDiscCacheMaxCharCount_c
+#define gServDiscCacheMaxCharCount_c    24
+#endif
+
+/*! Maximum Number of Descriptors cached per peer */
+#ifndef gServDiscCacheMaxDescriptorsCount_c
+#define gServDiscCacheMaxDescriptorsCount_c 16
+#endif
+
+/*! Offset, in the custom information of a bond, of the tag of its cache entry */
+#ifndef gServDiscCacheCustomInfoOffset_c
+#define gServDiscCacheCustomInfoOffset_c 0
+#endif
+
+/*! NVM data set identifier of the discovery cache */
+#ifndef nvmId_ServDiscCacheId_c
+#define nvmId_ServDiscCacheId_c         0x4B10
+#endif
+
 /************************************************************************************
 *************************************************************************************
 * Public type definitions
@@ -94,6 +135,9 @@ void BleServDisc_RegisterCallback(servDiscCallback_t pServDiscCallback);
 *
 * \return  gBleSuccess_c or error.
 *
+* \remarks When the results of a bonded peer are cached, the events are
+*          delivered from the application task, without any ATT procedure.
+*
 ********************************************************************************** */
 bleResult_t BleServDisc_Start(deviceId_t peerDeviceId);
 
@@ -140,6 +184,30 @@ void BleServDisc_SignalGattClientEvent(
     bleResult_t             error
 );
 
+/*! *********************************************************************************
+* \brief        Signals the module a GATT client indication, so that Service Changed
+*               indications invalidate the cache. Called by ApplMain.
+*
+* \param[in]    peerDeviceId                GATT Server device ID.
+* \param[in]    characteristicValueHandle   Handle of the indicated characteristic.
+*
+********************************************************************************** */
+void BleServDisc_SignalGattClientIndication(
+    deviceId_t              peerDeviceId,
+    uint16_t                characteristicValueHandle
+);
+
+/*! *********************************************************************************
+* \brief        Returns the duration of the last Service Discovery with the peer,
+*               from start to the gDiscoveryFinished_c event.
+*
+* \param[in]    peerDeviceId        The GAP peer Id.
+*
+* \return       Duration in milliseconds.
+*
+********************************************************************************** */
+uint32_t BleServDisc_GetDiscoveryTime(deviceId_t peerDeviceId);
+
 #endif /* _BLE_SERVICE_DISCOVERY_H_ */
 
 /*! *********************************************************************************
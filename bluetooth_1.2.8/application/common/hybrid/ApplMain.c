@@ -28,6 +28,7 @@
 #include "Flash_Adapter.h"
 #include "SecLib.h"
 #include "Panic.h"
+#include "Profiler.h"
 
 #if gFsciIncluded_c    
 #include "FsciInterface.h"
@@ -62,6 +63,7 @@
 #endif
 
 #include "ApplMain.h"
+#include "ble_service_discovery.h"
 #include "fsl_xcvr.h"
 #include "MWS.h"
 
@@ -69,6 +71,10 @@
 /* include NVM interface */
 #include "NVM_Interface.h"
 #endif
+
+#if gNtfFanout_Enabled_d
+#include "notification_fanout_interface.h"
+#endif
 /************************************************************************************
 *************************************************************************************
 * Private macros
@@ -438,6 +444,8 @@ void App_Thread (uint32_t param)
     { 
         OSA_EventWait(mAppEvent, osaEventFlagsAll_c, FALSE, osaWaitForever_c , &event);
         
+        PROFILER_PROBE_START(mAppThreadProbe, "App_Thread");
+
         /* Dequeue the host to app message */
         if (event & gAppEvtMsgFromHostStack_c)
         {
@@ -487,6 +495,8 @@ void App_Thread (uint32_t param)
             }
         }
 
+        PROFILER_PROBE_STOP(mAppThreadProbe);
+
         /* For BareMetal break the while(1) after 1 run */
         if( gUseRtos_c == 0 )
         {
@@ -1007,12 +1017,26 @@ static void App_HandleHostMessageInput(appMsgFromHost_t* pMsg)
         }
         case gAppGapConnectionMsg_c:
         {
+#if gNtfFanout_Enabled_d
+            /* Keep the notification subscriber masks in sync with the links */
+            if (pMsg->msgData.connMsg.connEvent.eventType == gConnEvtConnected_c)
+            {
+                NtfFanout_AddClient(pMsg->msgData.connMsg.deviceId);
+            }
+            else if (pMsg->msgData.connMsg.connEvent.eventType == gConnEvtDisconnected_c)
+            {
+                NtfFanout_RemoveClient(pMsg->msgData.connMsg.deviceId);
+            }
+#endif
             if (pfConnCallback)
                 pfConnCallback(pMsg->msgData.connMsg.deviceId, &pMsg->msgData.connMsg.connEvent);
             break;
         }
         case gAppGattServerMsg_c:
         {
+#if gNtfFanout_Enabled_d
+            NtfFanout_HandleGattServerEvent(pMsg->msgData.gattServerMsg.deviceId, &pMsg->msgData.gattServerMsg.serverEvent);
+#endif
             if (pfGattServerCallback)
                 pfGattServerCallback(pMsg->msgData.gattServerMsg.deviceId, &pMsg->msgData.gattServerMsg.serverEvent);
             break;
@@ -1039,6 +1063,11 @@ static void App_HandleHostMessageInput(appMsgFromHost_t* pMsg)
         }
         case gAppGattClientIndicationMsg_c:
         {
+#if gServDiscCacheEnabled_d
+            BleServDisc_SignalGattClientIndication(
+                pMsg->msgData.gattClientNotifIndMsg.deviceId,
+                pMsg->msgData.gattClientNotifIndMsg.characteristicValueHandle);
+#endif
             if (pfGattClientIndCallback)
                 pfGattClientIndCallback(
                     pMsg->msgData.gattClientNotifIndMsg.deviceId,
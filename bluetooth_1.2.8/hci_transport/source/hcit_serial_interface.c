@@ -18,6 +18,7 @@
 *************************************************************************************
 ************************************************************************************/
 #include "MemManager.h"
+#include "Profiler.h"
 
 #include "ble_general.h"
 #include "hci_transport.h"
@@ -313,6 +314,8 @@ void Hcit_RxCallBack(void *pData)
         return;
     }
 
+    PROFILER_PROBE_START(mHcitRxProbe, "Hcit_RxCallBack");
+
     while( count )
     {
         switch( mPacketDetectStep )
@@ -413,9 +416,11 @@ void Hcit_RxCallBack(void *pData)
 
         if( Serial_GetByteFromRxBuffer( gHcitSerMgrIf, &recvChar, &count) != gSerial_Success_c )
         {
-            return;
+            break;
         }
     }
+
+    PROFILER_PROBE_STOP(mHcitRxProbe);
 }
 
 /*! *********************************************************************************
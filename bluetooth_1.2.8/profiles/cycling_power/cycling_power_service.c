@@ -26,6 +26,7 @@
 #include "gap_interface.h"
 
 #include "cycling_power_interface.h"
+#include "notification_fanout_interface.h"
 
 /************************************************************************************
 *************************************************************************************
@@ -128,6 +129,13 @@ bleResult_t Cps_Start (cpsConfig_t *pServiceConfig)
     if (result != gBleSuccess_c)
         return result;
 
+#if gNtfFanout_Enabled_d
+    NtfFanout_RegisterServiceCharacteristic(pServiceConfig->serviceHandle, gBleSig_CpMeasurement_d,
+                                            gNtfFanout_DefaultCoalesceIntervalMs_c);
+    NtfFanout_RegisterServiceCharacteristic(pServiceConfig->serviceHandle, gBleSig_CpVector_d,
+                                            gNtfFanout_DefaultCoalesceIntervalMs_c);
+#endif
+
     return gBleSuccess_c;
 
 }
@@ -397,6 +405,12 @@ static void Cps_SendNotification
     uint16_t  hCccd;
     bool_t isNotificationActive;
 
+#if gNtfFanout_Enabled_d
+    /* Notify all subscribed clients */
+    if (NtfFanout_Notify(handle) != gBleInvalidParameter_c)
+        return;
+#endif
+
     /* Get handle of CCCD */
     if (GattDb_FindCccdHandleForCharValueHandle(handle, &hCccd) != gBleSuccess_c)
         return;
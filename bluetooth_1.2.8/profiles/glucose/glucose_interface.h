@@ -21,6 +21,7 @@
 *************************************************************************************
 ************************************************************************************/
 #include "ieee11073.h"
+#include "record_store_interface.h"
 
 /************************************************************************************
 *************************************************************************************
@@ -33,6 +34,17 @@
 #define gGls_MaxNumOfStoredMeasurements_c       3
 #endif
 
+/*! Glucose Service - Keep the stored measurements in a NVM data set owned by the
+*   service, used when the application does not provide pStoredMeasurements */
+#ifndef gGls_UseNvmStorage_d
+#define gGls_UseNvmStorage_d                    gRecStore_UseNvm_d
+#endif
+
+/*! Glucose Service - NVM data set identifier of the stored measurements */
+#ifndef nvmId_GlsStoredMeasurementsId_c
+#define nvmId_GlsStoredMeasurementsId_c         0x4B20
+#endif
+
 
 /*! Glucose Service - All Features Macro */
 #define Gls_AllFeatures     (gGls_LowBatteryDetectionSupported_c | gGls_SensorMalfunctionDetectionSupported_c |\
@@ -365,12 +377,19 @@ typedef PACKED_STRUCT glsProcedure_tag {
     } operand;
 } glsProcedure_t;
 
+/*! Glucose Service - Stored Measurement. An array of gGls_MaxNumOfStoredMeasurements_c
+*   elements can be registered as a NVM data set to keep the records across resets. */
+typedef struct glsStoredMeasurement_tag
+{
+    recStoreHeader_t            header;
+    glsFullMeasurement_t        measurement;
+}glsStoredMeasurement_t;
+
 /*! Glucose Service - User Data */
 typedef struct glsUserData_tag
 {
-    glsFullMeasurement_t       *pStoredMeasurements;
-    uint8_t                     cMeasurements;
-    uint8_t                     measurementCursor;
+    glsStoredMeasurement_t     *pStoredMeasurements;
+    recStore_t                  measurementStore;
     uint16_t                    lastSeqNumber;    
 }glsUserData_t;
 
@@ -395,6 +414,9 @@ enum
 * Public memory declarations
 *************************************************************************************
 ************************************************************************************/
+#if gGls_UseNvmStorage_d
+extern glsStoredMeasurement_t gaGlsStoredMeasurements[gGls_MaxNumOfStoredMeasurements_c];
+#endif
 
 
 /************************************************************************************
@@ -28,6 +28,10 @@
 
 #include "current_time_interface.h"
 #include "glucose_interface.h"
+
+#if gGls_UseNvmStorage_d
+#include "NVM_Interface.h"
+#endif
 /************************************************************************************
 *************************************************************************************
 * Private constants & macros
@@ -36,11 +40,23 @@
 #define gGls_MeasurementMaxLen 18
 #define gGls_MeasurementContextMaxLen 17
 
+/* Width of the sequence numbers, which wrap */
+#define gGls_SeqNumberBits_c            16
+/* Size of the user facing time operand: year, month, day, hours, minutes, seconds */
+#define gGls_UserFacingTimeLen_c        7
+
 /***********************************************************************************
 *************************************************************************************
 * Private type definitions
 *************************************************************************************
 ********************************************************************************** */
+/* Records selected by a RACP operator: the keys of the record store in [minKey, maxKey] */
+typedef struct glsRecordRange_tag
+{
+    recStoreKey_t   key;
+    uint32_t        minKey;
+    uint32_t        maxKey;
+}glsRecordRange_t;
 
 /***********************************************************************************
 *************************************************************************************
@@ -53,9 +69,18 @@ deviceId_t mGls_ClientDeviceId = gInvalidDeviceId_c;
 static glsConfig_t      *mpServiceConfig;
 static glsProcedure_t   mProcedure; 
 static uint16_t         mHandle;
-static uint8_t          mMeasurementIndex;
+static glsRecordRange_t mRecordRange;
+static uint32_t         mRecordCursor;
+static uint16_t         mRecordsCount;
 
 static tmrTimerID_t     mReportTimerId;
+
+#if gGls_UseNvmStorage_d
+/*! Glucose Service - Stored measurements, used when the application provides none */
+glsStoredMeasurement_t gaGlsStoredMeasurements[gGls_MaxNumOfStoredMeasurements_c];
+
+NVM_RegisterDataSet(gaGlsStoredMeasurements, gGls_MaxNumOfStoredMeasurements_c, sizeof(glsStoredMeasurement_t), nvmId_GlsStoredMeasurementsId_c, gNVM_MirroredInRam_c);
+#endif
 /***********************************************************************************
 *************************************************************************************
 * Private functions prototypes
@@ -96,7 +121,8 @@ static bleResult_t Gls_StoreGlucoseMeasurement
 
 static glsRspCodeValue_t Gls_ValidateProcedure(glsProcedure_t* pProcedure, uint8_t procDataLength);
 static void Gls_ExecuteProcedure(glsConfig_t *pServiceConfig, glsProcedure_t* pProcedure, uint16_t handle);
-static bool_t Gls_MatchMeasurement(glsFullMeasurement_t *pMeasurement, glsProcedure_t* pProcedure);
+static uint16_t Gls_FindRecords(glsUserData_t *pUserData, glsProcedure_t* pProcedure, glsRecordRange_t *pRange);
+static uint32_t Gls_GetFilterKey(recStore_t *pStore, glsFilterTypeValue_t filter, uint8_t *pParameter);
 static void ReportTimerCallback(void * pParam);
 /***********************************************************************************
 *************************************************************************************
@@ -106,16 +132,31 @@ static void ReportTimerCallback(void * pParam);
 
 bleResult_t Gls_Start (glsConfig_t *pServiceConfig)
 {
-    uint8_t i;
-    
-    if(pServiceConfig->pUserData)
-    {
-        pServiceConfig->pUserData->lastSeqNumber = 0x0000;
-    }
-    
-    for (i = 0; i < gGls_MaxNumOfStoredMeasurements_c; i++)
+    glsUserData_t *pUserData = pServiceConfig->pUserData;
+    uint16_t count;
+
+    if(pUserData)
     {
-        pServiceConfig->pUserData->pStoredMeasurements[i].seqNumber = 0xFFFF;
+        pUserData->lastSeqNumber = 0x0000;
+
+#if gGls_UseNvmStorage_d
+        if (pUserData->pStoredMeasurements == NULL)
+        {
+            pUserData->pStoredMeasurements = gaGlsStoredMeasurements;
+        }
+#endif
+
+        /* Rebuild the index of the records restored from NVM */
+        if (RecStore_Init(&pUserData->measurementStore, pUserData->pStoredMeasurements,
+                          sizeof(glsStoredMeasurement_t), gGls_MaxNumOfStoredMeasurements_c) == gBleSuccess_c)
+        {
+            count = RecStore_GetCount(&pUserData->measurementStore);
+
+            if (count)
+            {
+                pUserData->lastSeqNumber = (uint16_t)RecStore_GetHeader(&pUserData->measurementStore, count - 1)->seqKey;
+            }
+        }
     }
     
     mReportTimerId = TMR_AllocateTimer();
@@ -146,6 +187,7 @@ bleResult_t Gls_RecordGlucoseMeasurement (glsConfig_t *pServiceConfig, glsFullMe
 {
     uint16_t  handle;
     bleResult_t result;
+    bleResult_t storeResult;
     uint16_t uuid = gBleSig_GlucoseMeasurement_d;
 
     /* Glucose Measurement */
@@ -156,8 +198,8 @@ bleResult_t Gls_RecordGlucoseMeasurement (glsConfig_t *pServiceConfig, glsFullMe
     if (result != gBleSuccess_c)
         return result;
 
-    /* Store measurements */
-    Gls_StoreGlucoseMeasurement(pServiceConfig->pUserData, pMeasurement);
+    /* Store measurements. The measurement is still notified if it cannot be stored */
+    storeResult = Gls_StoreGlucoseMeasurement(pServiceConfig->pUserData, pMeasurement);
 
     /* Update characteristic value and send notification */
     if (!Gls_UpdateGlucoseMeasCharacteristic(handle, pMeasurement))
@@ -182,7 +224,7 @@ bleResult_t Gls_RecordGlucoseMeasurement (glsConfig_t *pServiceConfig, glsFullMe
             Gls_SendNotification(handle);
         }
     }
-    return gBleSuccess_c;
+    return storeResult;
 }
 
 void Gls_ControlPointHandler (glsConfig_t *pServiceConfig, gattServerAttributeWrittenEvent_t *pEvent)
@@ -383,12 +425,17 @@ static bleResult_t Gls_SetGlucoseFeature
     return GattDb_WriteAttribute(hValueGlFeature, sizeof(glsFeatureFlags_t), (uint8_t*)&feature);
 }
 
-static void Gls_SendStoredGlucoseMeasurement(glsConfig_t *pServiceConfig, uint8_t index)
+static void Gls_SendStoredGlucoseMeasurement(glsConfig_t *pServiceConfig, uint16_t position)
 {
     uint16_t  handle;
     bleResult_t result;
     uint16_t uuid = gBleSig_GlucoseMeasurement_d;
-    glsFullMeasurement_t *pMeasurement = pServiceConfig->pUserData->pStoredMeasurements + index;
+    glsFullMeasurement_t *pMeasurement = RecStore_GetRecord(&pServiceConfig->pUserData->measurementStore, position);
+
+    if (pMeasurement == NULL)
+    {
+        return;
+    }
       
     /* Glucose Measurement */
     /* Get handle of characteristic */
@@ -452,60 +499,30 @@ static void Gls_SendProcedureResponse
     }
 }
 
-static bool_t Gls_CheckFilterCondition(glsProcedure_t* pProcedure, glsFullMeasurement_t *pMeasurement)
-{
-  if ( pProcedure->glsOperator == gGls_AllRecords_c )
-  {
-      return TRUE;
-  }
-  
-  if(( pProcedure->glsOperator == gGls_GreaterThanOrEqualTo_c )
-      &&( pProcedure->operand.filter.filter == gGls_FtvSeqNumber_c ))
-  {
-      if (pMeasurement->seqNumber >= pProcedure->operand.filter.filterParameter)
-      {
-        return TRUE;
-      }
-  }
-
-  return FALSE;
-}
-
 static void Gls_ReportStoredRecords(glsConfig_t *pServiceConfig, glsProcedure_t* pProcedure, uint16_t handle)
 {
-    glsFullMeasurement_t *pMeasurement;
     glsProcedure_t      response;
-    uint8_t             index;
     bool_t isIndicationActive;
     uint16_t  hCccd;
+    uint16_t  position;
     
     if (!pServiceConfig->procInProgress)
     {
       return;
     }
     
-    while ( mMeasurementIndex < gGls_MaxNumOfStoredMeasurements_c)
+    /* The records are walked by sequence key: measurements stored during the report
+       shift the positions, and the time keys decrease when the time offset does */
+    position = RecStore_FindNext(&pServiceConfig->pUserData->measurementStore, mRecordRange.key,
+                                 mRecordRange.minKey, mRecordRange.maxKey, &mRecordCursor);
+
+    if (position != gRecStore_InvalidIndex_c)
     {
-        index = (pServiceConfig->pUserData->measurementCursor + mMeasurementIndex) % gGls_MaxNumOfStoredMeasurements_c;
-        pMeasurement = pServiceConfig->pUserData->pStoredMeasurements + index;
-        
-        if (pMeasurement->seqNumber == 0xFFFF)
-        {
-            mMeasurementIndex++;
-            continue;
-        }
-        
-        if (Gls_CheckFilterCondition(pProcedure, pMeasurement))
-        {
-            Gls_SendStoredGlucoseMeasurement(pServiceConfig, index);
-            mMeasurementIndex++;
-                /* Start advertising timer */
-            TMR_StartLowPowerTimer(mReportTimerId, gTmrLowPowerSecondTimer_c,
-                       500, ReportTimerCallback, NULL);
-            return;
-        }
-        
-        mMeasurementIndex++;
+        Gls_SendStoredGlucoseMeasurement(pServiceConfig, position);
+            /* Start advertising timer */
+        TMR_StartLowPowerTimer(mReportTimerId, gTmrLowPowerSecondTimer_c,
+                   500, ReportTimerCallback, NULL);
+        return;
     }
     
     /* Get handle of CCCD */
@@ -516,7 +533,7 @@ static void Gls_ReportStoredRecords(glsConfig_t *pServiceConfig, glsProcedure_t*
     response.glsOperator = gGls_Null_c;
     response.operand.responseCode.reqOpCode = gGls_ReportStoredRecords_c;
     response.operand.responseCode.rspCodeValue = 
-      (pServiceConfig->pUserData->cMeasurements == 0) ? 
+      (mRecordsCount == 0) ? 
         gGls_RspNoRecordsFound_c : gGls_RspSuccess_c;
         
     /* Indicate value to client */     
@@ -533,27 +550,11 @@ static void Gls_ReportStoredRecords(glsConfig_t *pServiceConfig, glsProcedure_t*
 static void Gls_ReportNumOfStoredRecords(glsConfig_t *pServiceConfig, glsProcedure_t* pProcedure, uint16_t handle)
 {
     glsProcedure_t      response;
-    uint8_t             i;
+    glsRecordRange_t    range;
 
     response.opCode = gGls_NumOfStoredRecordsRsp_c;
     response.glsOperator = gGls_Null_c;
-        
-    if (pProcedure->glsOperator == gGls_AllRecords_c)
-    {
-        response.operand.numberOfRecords = pServiceConfig->pUserData->cMeasurements;
-    }
-    else
-    {
-        response.operand.numberOfRecords = 0;
-        
-        for (i = 0; i < gGls_MaxNumOfStoredMeasurements_c; i++)
-        {
-            if (Gls_MatchMeasurement(&pServiceConfig->pUserData->pStoredMeasurements[i], pProcedure))
-            {
-                response.operand.numberOfRecords++;
-            }
-        }
-    }
+    response.operand.numberOfRecords = Gls_FindRecords(pServiceConfig->pUserData, pProcedure, &range);
 
     /* Write response in characteristic */
     GattDb_WriteAttribute(handle, sizeof(glsProcedure_t) - 2, (uint8_t*) &response);
@@ -562,42 +563,79 @@ static void Gls_ReportNumOfStoredRecords(glsConfig_t *pServiceConfig, glsProcedu
     GattServer_SendIndication(mGls_ClientDeviceId, handle);    
 }
 
-static bool_t Gls_MatchMeasurement(glsFullMeasurement_t *pMeasurement, glsProcedure_t* pProcedure)
+static uint16_t Gls_FindRecords(glsUserData_t *pUserData, glsProcedure_t* pProcedure, glsRecordRange_t *pRange)
 {
+    recStore_t *pStore = &pUserData->measurementStore;
+    uint16_t    count = RecStore_GetCount(pStore);
+    /* The operand is parsed from the written value, since it may be longer than glsFilter_t */
+    uint8_t    *pOperand = (uint8_t*)&pProcedure->operand.filter;
+    glsFilterTypeValue_t filter = pOperand[0];
+    uint8_t     paramLen = (filter == gGls_FtvSeqNumber_c) ? sizeof(uint16_t) : gGls_UserFacingTimeLen_c;
+    uint16_t    first;
+
+    pRange->key = (filter == gGls_FtvSeqNumber_c) ? gRecStore_SeqKey_c : gRecStore_TimeKey_c;
+    pRange->minKey = 0;
+    pRange->maxKey = 0xFFFFFFFFU;
+
     switch(pProcedure->glsOperator)
     {
         case gGls_AllRecords_c:
         {
-            return TRUE;
-            break;
+            pRange->key = gRecStore_SeqKey_c;
+            return count;
         }
-        case gGls_GreaterThanOrEqualTo_c:
+        case gGls_FirstRecord_c:
+        case gGls_LastRecord_c:
         {
-            switch(pProcedure->operand.filter.filter)
+            if (count == 0)
             {
-                case gGls_FtvSeqNumber_c:
-                {
-                    return (pMeasurement->seqNumber >= pProcedure->operand.filter.filterParameter);
-                    break;
-                }
-                case gGls_FtvUserFacingTime_c:
-                default:
-                {
-                    return FALSE;
-                }
+                return 0;
             }
-            break;
+
+            /* Select the record by its sequence key, which does not move */
+            pRange->key = gRecStore_SeqKey_c;
+            first = (pProcedure->glsOperator == gGls_FirstRecord_c) ? 0 : count - 1;
+            pRange->minKey = RecStore_GetHeader(pStore, first)->seqKey;
+            pRange->maxKey = pRange->minKey;
+            return 1;
         }
-        case gGls_FirstRecord_c:
-        case gGls_LastRecord_c:
         case gGls_LessThanOrEqualTo_c:
+        {
+            pRange->maxKey = Gls_GetFilterKey(pStore, filter, &pOperand[1]);
+            break;
+        }
+        case gGls_GreaterThanOrEqualTo_c:
+        {
+            pRange->minKey = Gls_GetFilterKey(pStore, filter, &pOperand[1]);
+            break;
+        }
         case gGls_WithinRangeOf_c:
+        {
+            pRange->minKey = Gls_GetFilterKey(pStore, filter, &pOperand[1]);
+            pRange->maxKey = Gls_GetFilterKey(pStore, filter, &pOperand[1 + paramLen]);
+            break;
+        }
         default:
         {
-            return FALSE;
+            pRange->minKey = 0xFFFFFFFFU;
+            pRange->maxKey = 0;
+            return 0;
         }
-        break;  
     }
+
+    return RecStore_FindRange(pStore, pRange->key, pRange->minKey, pRange->maxKey, &first);
+}
+
+static uint32_t Gls_GetFilterKey(recStore_t *pStore, glsFilterTypeValue_t filter, uint8_t *pParameter)
+{
+    if (filter == gGls_FtvSeqNumber_c)
+    {
+        return RecStore_SeqNumberToKey(pStore, Utils_ExtractTwoByteValue(pParameter), gGls_SeqNumberBits_c);
+    }
+
+    /* User facing time: compared with the base time plus the time offset of the records */
+    return RecStore_TimeKey(Utils_ExtractTwoByteValue(pParameter), pParameter[2], pParameter[3],
+                            pParameter[4], pParameter[5], pParameter[6]);
 }
 
 static void Gls_AbortOperation(glsConfig_t *pServiceConfig, uint16_t handle)
@@ -627,7 +665,8 @@ static void Gls_ExecuteProcedure(glsConfig_t *pServiceConfig, glsProcedure_t* pP
             mpServiceConfig = pServiceConfig;
             FLib_MemCpy(&mProcedure, pProcedure, sizeof(glsProcedure_t));
             mHandle = handle;
-            mMeasurementIndex = 0;
+            mRecordCursor = 0;
+            mRecordsCount = Gls_FindRecords(pServiceConfig->pUserData, pProcedure, &mRecordRange);
             Gls_ReportStoredRecords(pServiceConfig, pProcedure, handle);
             break;
         }
@@ -653,6 +692,8 @@ static void Gls_ExecuteProcedure(glsConfig_t *pServiceConfig, glsProcedure_t* pP
 static glsRspCodeValue_t Gls_ValidateProcedure(glsProcedure_t* pProcedure, uint8_t procDataLength)
 {
 
+    uint8_t paramLen;
+
     if( pProcedure->glsOperator > gGls_LastRecord_c )
     {
         return gGls_RspOperatorNotSupported_c;
@@ -673,35 +714,58 @@ static glsRspCodeValue_t Gls_ValidateProcedure(glsProcedure_t* pProcedure, uint8
                     }
                     break;
                 }
+                case gGls_FirstRecord_c:
+                case gGls_LastRecord_c:
+                {
+                    if (procDataLength != 0)
+                    {
+                        return gGls_RspInvalidOperand_c;
+                    }
+                    break;
+                }
+                case gGls_LessThanOrEqualTo_c:
                 case gGls_GreaterThanOrEqualTo_c:
+                case gGls_WithinRangeOf_c:
                 {
+                    if (procDataLength == 0)
+                    {
+                        return gGls_RspInvalidOperand_c;
+                    }
+
                     switch(pProcedure->operand.filter.filter)
                     {
                         case gGls_FtvSeqNumber_c:
                         {
-                            if ( procDataLength != sizeof(glsFilter_t))
-                            {
-                                return gGls_RspInvalidOperand_c;
-                            }
+                            paramLen = sizeof(uint16_t);
                             break;
                         }
                         case gGls_FtvUserFacingTime_c:
+                        {
+                            paramLen = gGls_UserFacingTimeLen_c;
+                            break;
+                        }
                         default:
                         {
                             return gGls_RspOperandNotSupported_c;
                         }
                     }
+
+                    /* Filter type, followed by one parameter, or by the two ends of the range */
+                    if (pProcedure->glsOperator == gGls_WithinRangeOf_c)
+                    {
+                        paramLen *= 2;
+                    }
+
+                    if (procDataLength != sizeof(glsFilterTypeValue_t) + paramLen)
+                    {
+                        return gGls_RspInvalidOperand_c;
+                    }
                     break;
                 }
-                case gGls_FirstRecord_c:
-                case gGls_LastRecord_c:
-                case gGls_LessThanOrEqualTo_c:
-                case gGls_WithinRangeOf_c:
                 default:
                 {
                     return gGls_RspInvalidOperator_c;
                 }
-                break;
 
             }
             break;
@@ -731,20 +795,36 @@ static glsRspCodeValue_t Gls_ValidateProcedure(glsProcedure_t* pProcedure, uint8
 
 static bleResult_t Gls_StoreGlucoseMeasurement(glsUserData_t *pUserData, glsFullMeasurement_t *pMeasurement)
 {
+    uint32_t timeKey;
+    int32_t  offset = (int32_t)pMeasurement->timeOffset * 60;
+
     if (pUserData->pStoredMeasurements == NULL)
     {
         return gBleOutOfMemory_c;
     }
 
-    /* Store measurement */
-    FLib_MemCpy(&pUserData->pStoredMeasurements[pUserData->measurementCursor],
-                pMeasurement,
-                sizeof(glsFullMeasurement_t));
+    /* User facing time: base time plus the time offset, in minutes */
+    timeKey = RecStore_TimeKey(pMeasurement->dateTime.year, pMeasurement->dateTime.month,
+                               pMeasurement->dateTime.day, pMeasurement->dateTime.hours,
+                               pMeasurement->dateTime.minutes, pMeasurement->dateTime.seconds);
 
-    /* Update cursor and count */
-    pUserData->measurementCursor = (pUserData->measurementCursor + 1) % gGls_MaxNumOfStoredMeasurements_c;
-    pUserData->cMeasurements = MIN(pUserData->cMeasurements + 1, gGls_MaxNumOfStoredMeasurements_c);
-    return gBleSuccess_c;
+    if ((offset < 0) && ((uint32_t)(-offset) > timeKey))
+    {
+        timeKey = 0;
+    }
+    else
+    {
+        timeKey += (uint32_t)offset;
+    }
+
+    /* Append measurement. The 16 bit sequence number is extended past the newest
+       record, so the keys keep increasing when it wraps; a repeated number is rejected */
+    return RecStore_Append(&pUserData->measurementStore,
+                           RecStore_SeqKey(&pUserData->measurementStore, pMeasurement->seqNumber,
+                                           gGls_SeqNumberBits_c),
+                           timeKey,
+                           pMeasurement,
+                           sizeof(glsFullMeasurement_t));
 }
 
 static void ReportTimerCallback(void * pParam)
@@ -25,6 +25,7 @@
 #include "gatt_server_interface.h"
 #include "gap_interface.h"
 #include "heart_rate_interface.h"
+#include "notification_fanout_interface.h"
 /************************************************************************************
 *************************************************************************************
 * Private constants & macros
@@ -131,6 +132,10 @@ bleResult_t Hrs_Start (hrsConfig_t *pServiceConfig)
     Hrs_SetHrmFlags(hValueHrMeasurement, flags);
     
     Hrs_SetBodyLocation(hValueBodyLocation, pServiceConfig->bodySensorLocation);
+
+#if gNtfFanout_Enabled_d
+    NtfFanout_RegisterCharacteristic(hValueHrMeasurement, gNtfFanout_DefaultCoalesceIntervalMs_c);
+#endif
     
     mHrs_SubscribedClientId = gInvalidDeviceId_c;
 
@@ -367,6 +372,12 @@ static void Hrs_SendNotifications
 {
     uint16_t  hCccdHrMeasurement;
     bool_t isNotifActive;
+
+#if gNtfFanout_Enabled_d
+    /* Notify all subscribed clients */
+    if (NtfFanout_Notify(handle) != gBleInvalidParameter_c)
+        return;
+#endif
    
     /* Get handle of Heart Rate Measurement CCCD */
     if (GattDb_FindCccdHandleForCharValueHandle(handle, &hCccdHrMeasurement) != gBleSuccess_c)
@@ -0,0 +1,345 @@
+/*! *********************************************************************************
+* \addtogroup Notification Fan-out
+* @{
+ ********************************************************************************** */
+/*!
+* Copyright 2016-2017 NXP
+* All rights reserved.
+*
+* file
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "TimersManager.h"
+
+#include "ble_general.h"
+#include "gatt_db_app_interface.h"
+#include "gatt_server_interface.h"
+#include "gap_interface.h"
+
+#include "notification_fanout_interface.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+************************************************************************************/
+typedef struct ntfCharacteristic_tag
+{
+    uint16_t            valueHandle;
+    uint16_t            cccdHandle;
+    ntfSubscriberMask_t subscribers;
+    uint16_t            coalesceIntervalMs;
+    bool_t              pending;
+    uint64_t            lastSentTs;
+}ntfCharacteristic_t;
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static ntfCharacteristic_t maNtfCharacteristics[gNtfFanout_MaxCharacteristics_c];
+static uint8_t             mcNtfCharacteristics;
+static tmrTimerID_t        mNtfCoalesceTimerId = gTmrInvalidTimerID_c;
+
+/************************************************************************************
+*************************************************************************************
+* Private functions prototypes
+*************************************************************************************
+************************************************************************************/
+static ntfCharacteristic_t* NtfFanout_FindByValueHandle(uint16_t valueHandle);
+static ntfCharacteristic_t* NtfFanout_FindByCccdHandle(uint16_t cccdHandle);
+static bleResult_t NtfFanout_Send(ntfCharacteristic_t *pChar);
+static void NtfFanout_CoalesceTimerCallback(void *pParam);
+
+/***********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+
+bleResult_t NtfFanout_RegisterCharacteristic
+(
+    uint16_t    valueHandle,
+    uint16_t    coalesceIntervalMs
+)
+{
+    ntfCharacteristic_t *pChar = NtfFanout_FindByValueHandle(valueHandle);
+    uint16_t cccdHandle;
+
+    if (pChar == NULL)
+    {
+        if (mcNtfCharacteristics >= gNtfFanout_MaxCharacteristics_c)
+        {
+            return gBleOverflow_c;
+        }
+
+        if (GattDb_FindCccdHandleForCharValueHandle(valueHandle, &cccdHandle) != gBleSuccess_c)
+        {
+            return gBleInvalidParameter_c;
+        }
+
+        pChar = &maNtfCharacteristics[mcNtfCharacteristics++];
+        pChar->valueHandle = valueHandle;
+        pChar->cccdHandle = cccdHandle;
+        pChar->subscribers = 0;
+        pChar->pending = FALSE;
+        pChar->lastSentTs = 0;
+    }
+
+    pChar->coalesceIntervalMs = coalesceIntervalMs;
+
+    if ((coalesceIntervalMs != 0) && (mNtfCoalesceTimerId == gTmrInvalidTimerID_c))
+    {
+        mNtfCoalesceTimerId = TMR_AllocateTimer();
+    }
+
+    return gBleSuccess_c;
+}
+
+bleResult_t NtfFanout_RegisterServiceCharacteristic
+(
+    uint16_t    serviceHandle,
+    uint16_t    uuid16,
+    uint16_t    coalesceIntervalMs
+)
+{
+    uint16_t    valueHandle;
+    bleResult_t result;
+    bleUuid_t   uuid = Uuid16(uuid16);
+
+    result = GattDb_FindCharValueHandleInService(serviceHandle,
+        gBleUuidType16_c, &uuid, &valueHandle);
+
+    if (result != gBleSuccess_c)
+        return result;
+
+    return NtfFanout_RegisterCharacteristic(valueHandle, coalesceIntervalMs);
+}
+
+void NtfFanout_AddClient(deviceId_t deviceId)
+{
+    bool_t isNotifActive;
+    uint8_t i;
+
+    if (deviceId >= gNtfFanout_MaxDevices_c)
+    {
+        return;
+    }
+
+    for (i = 0; i < mcNtfCharacteristics; i++)
+    {
+        if ((gBleSuccess_c == Gap_CheckNotificationStatus(deviceId, maNtfCharacteristics[i].cccdHandle, &isNotifActive)) &&
+            (TRUE == isNotifActive))
+        {
+            maNtfCharacteristics[i].subscribers |= (ntfSubscriberMask_t)1 << deviceId;
+        }
+    }
+}
+
+void NtfFanout_RemoveClient(deviceId_t deviceId)
+{
+    uint8_t i;
+
+    if (deviceId >= gNtfFanout_MaxDevices_c)
+    {
+        return;
+    }
+
+    for (i = 0; i < mcNtfCharacteristics; i++)
+    {
+        maNtfCharacteristics[i].subscribers &= ~((ntfSubscriberMask_t)1 << deviceId);
+    }
+}
+
+void NtfFanout_HandleGattServerEvent(deviceId_t deviceId, gattServerEvent_t *pEvent)
+{
+    ntfCharacteristic_t *pChar;
+
+    if ((pEvent->eventType != gEvtCharacteristicCccdWritten_c) ||
+        (deviceId >= gNtfFanout_MaxDevices_c))
+    {
+        return;
+    }
+
+    pChar = NtfFanout_FindByCccdHandle(pEvent->eventData.charCccdWrittenEvent.handle);
+
+    if (pChar == NULL)
+    {
+        return;
+    }
+
+    if (pEvent->eventData.charCccdWrittenEvent.newCccd & gCccdNotification_c)
+    {
+        pChar->subscribers |= (ntfSubscriberMask_t)1 << deviceId;
+    }
+    else
+    {
+        pChar->subscribers &= ~((ntfSubscriberMask_t)1 << deviceId);
+    }
+}
+
+bleResult_t NtfFanout_Notify(uint16_t valueHandle)
+{
+    ntfCharacteristic_t *pChar = NtfFanout_FindByValueHandle(valueHandle);
+    uint64_t elapsedMs;
+
+    if (pChar == NULL)
+    {
+        return gBleInvalidParameter_c;
+    }
+
+    if (pChar->subscribers == 0)
+    {
+        return gBleSuccess_c;
+    }
+
+    if ((pChar->coalesceIntervalMs != 0) && (mNtfCoalesceTimerId != gTmrInvalidTimerID_c))
+    {
+        /* A notification is already scheduled and will carry the latest value */
+        if (pChar->pending)
+        {
+            return gBleSuccess_c;
+        }
+
+        elapsedMs = (TMR_GetTimestamp() - pChar->lastSentTs) / 1000;
+
+        if (elapsedMs < pChar->coalesceIntervalMs)
+        {
+            pChar->pending = TRUE;
+
+            if (!TMR_IsTimerActive(mNtfCoalesceTimerId) ||
+                (TMR_GetRemainingTime(mNtfCoalesceTimerId) > pChar->coalesceIntervalMs - (uint32_t)elapsedMs))
+            {
+                TMR_StartSingleShotTimer(mNtfCoalesceTimerId,
+                                         pChar->coalesceIntervalMs - (uint32_t)elapsedMs,
+                                         NtfFanout_CoalesceTimerCallback, NULL);
+            }
+            return gBleSuccess_c;
+        }
+    }
+
+    return NtfFanout_Send(pChar);
+}
+
+ntfSubscriberMask_t NtfFanout_GetSubscribers(uint16_t valueHandle)
+{
+    ntfCharacteristic_t *pChar = NtfFanout_FindByValueHandle(valueHandle);
+
+    return (pChar != NULL) ? pChar->subscribers : 0;
+}
+
+/***********************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+********************************************************************************** */
+static ntfCharacteristic_t* NtfFanout_FindByValueHandle(uint16_t valueHandle)
+{
+    uint8_t i;
+
+    for (i = 0; i < mcNtfCharacteristics; i++)
+    {
+        if (maNtfCharacteristics[i].valueHandle == valueHandle)
+        {
+            return &maNtfCharacteristics[i];
+        }
+    }
+
+    return NULL;
+}
+
+static ntfCharacteristic_t* NtfFanout_FindByCccdHandle(uint16_t cccdHandle)
+{
+    uint8_t i;
+
+    for (i = 0; i < mcNtfCharacteristics; i++)
+    {
+        if (maNtfCharacteristics[i].cccdHandle == cccdHandle)
+        {
+            return &maNtfCharacteristics[i];
+        }
+    }
+
+    return NULL;
+}
+
+static bleResult_t NtfFanout_Send(ntfCharacteristic_t *pChar)
+{
+    ntfSubscriberMask_t mask = pChar->subscribers;
+    bleResult_t result = gBleSuccess_c;
+    bleResult_t status;
+    deviceId_t deviceId = 0;
+
+    pChar->pending = FALSE;
+    pChar->lastSentTs = TMR_GetTimestamp();
+
+    /* Walk only the set bits of the subscriber mask */
+    while (mask)
+    {
+        if (mask & 1)
+        {
+            status = GattServer_SendNotification(deviceId, pChar->valueHandle);
+
+            if (status != gBleSuccess_c)
+            {
+                result = status;
+            }
+        }
+
+        mask >>= 1;
+        deviceId++;
+    }
+
+    return result;
+}
+
+static void NtfFanout_CoalesceTimerCallback(void *pParam)
+{
+    uint64_t now = TMR_GetTimestamp();
+    uint32_t nextMs = 0;
+    uint32_t remainingMs;
+    uint64_t elapsedMs;
+    uint8_t i;
+
+    for (i = 0; i < mcNtfCharacteristics; i++)
+    {
+        if (!maNtfCharacteristics[i].pending)
+        {
+            continue;
+        }
+
+        elapsedMs = (now - maNtfCharacteristics[i].lastSentTs) / 1000;
+
+        if (elapsedMs >= maNtfCharacteristics[i].coalesceIntervalMs)
+        {
+            NtfFanout_Send(&maNtfCharacteristics[i]);
+        }
+        else
+        {
+            /* Characteristics with different intervals share the timer */
+            remainingMs = maNtfCharacteristics[i].coalesceIntervalMs - (uint32_t)elapsedMs;
+
+            if ((nextMs == 0) || (remainingMs < nextMs))
+            {
+                nextMs = remainingMs;
+            }
+        }
+    }
+
+    if (nextMs)
+    {
+        TMR_StartSingleShotTimer(mNtfCoalesceTimerId, nextMs, NtfFanout_CoalesceTimerCallback, NULL);
+    }
+}
+
+/*! *********************************************************************************
+* @}
+********************************************************************************** */
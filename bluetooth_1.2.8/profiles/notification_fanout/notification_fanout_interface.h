@@ -0,0 +1,158 @@
+/*! *********************************************************************************
+* \defgroup Notification Fan-out
+* @{
+********************************************************************************** */
+/*!
+* Copyright 2016-2017 NXP
+* All rights reserved.
+*
+* file
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef _NOTIFICATION_FANOUT_INTERFACE_H_
+#define _NOTIFICATION_FANOUT_INTERFACE_H_
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "ble_general.h"
+#include "gap_interface.h"
+#include "gatt_server_interface.h"
+
+/************************************************************************************
+*************************************************************************************
+* Public constants & macros
+*************************************************************************************
+************************************************************************************/
+
+/*! Notification Fan-out - Enables the module. When disabled, the profiles
+*   notify their single subscribed client directly. */
+#ifndef gNtfFanout_Enabled_d
+#define gNtfFanout_Enabled_d                0
+#endif
+
+/*! Notification Fan-out - Maximum number of tracked characteristics */
+#ifndef gNtfFanout_MaxCharacteristics_c
+#define gNtfFanout_MaxCharacteristics_c     8
+#endif
+
+/*! Notification Fan-out - Coalescing interval used by the profiles, in milliseconds.
+*   Should be set close to the connection interval; 0 sends every sample. */
+#ifndef gNtfFanout_DefaultCoalesceIntervalMs_c
+#define gNtfFanout_DefaultCoalesceIntervalMs_c  0
+#endif
+
+/*! Notification Fan-out - Maximum device id that can be tracked in a subscriber mask */
+#define gNtfFanout_MaxDevices_c             32
+
+/************************************************************************************
+*************************************************************************************
+* Public type definitions
+*************************************************************************************
+************************************************************************************/
+
+/*! Notification Fan-out - One bit per device id */
+typedef uint32_t ntfSubscriberMask_t;
+
+/************************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+************************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!**********************************************************************************
+* \brief        Starts tracking the subscribers of a characteristic. Registering
+*               an already tracked characteristic only updates its interval.
+*
+* \param[in]    valueHandle         Handle of the characteristic value.
+* \param[in]    coalesceIntervalMs  Minimum time between two notifications, in
+*                                   milliseconds. Samples written in between are
+*                                   coalesced and only the latest value is sent.
+*                                   Use 0 to send every sample.
+*
+* \return       gBleSuccess_c or error.
+************************************************************************************/
+bleResult_t NtfFanout_RegisterCharacteristic
+(
+    uint16_t    valueHandle,
+    uint16_t    coalesceIntervalMs
+);
+
+/*!**********************************************************************************
+* \brief        Starts tracking the subscribers of a characteristic identified by
+*               its 16-bit UUID inside a service.
+*
+* \param[in]    serviceHandle       Handle of the service declaration.
+* \param[in]    uuid16              16-bit UUID of the characteristic.
+* \param[in]    coalesceIntervalMs  See NtfFanout_RegisterCharacteristic().
+*
+* \return       gBleSuccess_c or error.
+************************************************************************************/
+bleResult_t NtfFanout_RegisterServiceCharacteristic
+(
+    uint16_t    serviceHandle,
+    uint16_t    uuid16,
+    uint16_t    coalesceIntervalMs
+);
+
+/*!**********************************************************************************
+* \brief        Reads the CCCDs of a newly connected client, so that bonded
+*               clients are tracked without writing their CCCDs again.
+*
+* \param[in]    deviceId    Client Id in Device DB.
+************************************************************************************/
+void NtfFanout_AddClient(deviceId_t deviceId);
+
+/*!**********************************************************************************
+* \brief        Removes a client from all the subscriber masks.
+*
+* \param[in]    deviceId    Client Id in Device DB.
+************************************************************************************/
+void NtfFanout_RemoveClient(deviceId_t deviceId);
+
+/*!**********************************************************************************
+* \brief        Updates the subscriber masks from GATT Server events. Must be
+*               called for every gEvtCharacteristicCccdWritten_c event.
+*
+* \param[in]    deviceId    Client Id in Device DB.
+* \param[in]    pEvent      Pointer to the GATT Server event.
+************************************************************************************/
+void NtfFanout_HandleGattServerEvent(deviceId_t deviceId, gattServerEvent_t *pEvent);
+
+/*!**********************************************************************************
+* \brief        Notifies the current value of a characteristic to all of its
+*               subscribers.
+*
+* \param[in]    valueHandle Handle of the characteristic value.
+*
+* \return       gBleSuccess_c, gBleInvalidParameter_c if the characteristic is not
+*               tracked, or the error of the last failed notification.
+************************************************************************************/
+bleResult_t NtfFanout_Notify(uint16_t valueHandle);
+
+/*!**********************************************************************************
+* \brief        Returns the clients subscribed to notifications of a characteristic.
+*
+* \param[in]    valueHandle Handle of the characteristic value.
+*
+* \return       Subscriber mask, 0 if the characteristic is not tracked.
+************************************************************************************/
+ntfSubscriberMask_t NtfFanout_GetSubscribers(uint16_t valueHandle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _NOTIFICATION_FANOUT_INTERFACE_H_ */
+
+/*! *********************************************************************************
+* @}
+********************************************************************************** */
@@ -21,6 +21,7 @@
 *************************************************************************************
 ************************************************************************************/
 #include "ieee11073.h"
+#include "record_store_interface.h"
 
 /************************************************************************************
 *************************************************************************************
@@ -33,6 +34,17 @@
 #define gPlx_MaxNumOfStoredMeasurements_c       30
 #endif
 
+/*! Pulse Oximeter Service - Keep the stored measurements in a NVM data set owned
+*   by the service, used when the application does not provide pStoredMeasurements */
+#ifndef gPlx_UseNvmStorage_d
+#define gPlx_UseNvmStorage_d                    gRecStore_UseNvm_d
+#endif
+
+/*! Pulse Oximeter Service - NVM data set identifier of the stored measurements */
+#ifndef nvmId_PlxStoredMeasurementsId_c
+#define nvmId_PlxStoredMeasurementsId_c         0x4B21
+#endif
+
 /*! Pulse Oximeter Service - Default Init structures */
 #define gPlx_DefaultSupportedFeatures           ( gPlx_MeasurementStatusSupported_c             |\
                                                 gPlx_DeviceAndSensorStatusSupported_c           |\
@@ -207,12 +219,19 @@ typedef struct plxSpotCheckMeasurement_tag
     uint8_t                            seqNumber;
 }plxSpotCheckMeasurement_t;
 
+/*! Pulse Oximeter Service - Stored Measurement. An array of gPlx_MaxNumOfStoredMeasurements_c
+*   elements can be registered as a NVM data set to keep the records across resets. */
+typedef struct plxStoredMeasurement_tag
+{
+    recStoreHeader_t            header;
+    plxSpotCheckMeasurement_t   measurement;
+}plxStoredMeasurement_t;
+
 /*! Pulse Oximeter Service - User Data */
 typedef struct plxUserData_tag
 {
-    plxSpotCheckMeasurement_t   *pStoredMeasurements;
-    uint8_t                     cMeasurements;
-    uint8_t                     measurementCursor;
+    plxStoredMeasurement_t      *pStoredMeasurements;
+    recStore_t                  measurementStore;
     uint8_t                     lastSeqNumber;    
     uint8_t                     cReportedRecords;
 }plxUserData_t;
@@ -369,6 +388,9 @@ typedef PACKED_STRUCT plxProcedure_tag {
 * Public memory declarations
 *************************************************************************************
 ************************************************************************************/
+#if gPlx_UseNvmStorage_d
+extern plxStoredMeasurement_t gaPlxStoredMeasurements[gPlx_MaxNumOfStoredMeasurements_c];
+#endif
 
 
 /************************************************************************************
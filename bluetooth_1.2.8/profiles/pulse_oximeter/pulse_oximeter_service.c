@@ -27,6 +27,10 @@
 
 #include "current_time_interface.h"
 #include "pulse_oximeter_interface.h"
+
+#if gPlx_UseNvmStorage_d
+#include "NVM_Interface.h"
+#endif
 /************************************************************************************
 *************************************************************************************
 * Private constants & macros
@@ -52,9 +56,16 @@ deviceId_t mPlx_ClientDeviceId = gInvalidDeviceId_c;
 static plxConfig_t      *mpServiceConfig;
 static plxProcedure_t   mProcedure; 
 static uint16_t         mHandle;
-static uint8_t          mMeasurementIndex;
+static uint16_t         mMeasurementIndex;
 
 static tmrTimerID_t     mReportTimerId;
+
+#if gPlx_UseNvmStorage_d
+/*! Pulse Oximeter Service - Stored measurements, used when the application provides none */
+plxStoredMeasurement_t gaPlxStoredMeasurements[gPlx_MaxNumOfStoredMeasurements_c];
+
+NVM_RegisterDataSet(gaPlxStoredMeasurements, gPlx_MaxNumOfStoredMeasurements_c, sizeof(plxStoredMeasurement_t), nvmId_PlxStoredMeasurementsId_c, gNVM_MirroredInRam_c);
+#endif
 /***********************************************************************************
 *************************************************************************************
 * Private functions prototypes
@@ -114,16 +125,31 @@ bleResult_t Plx_Start (plxConfig_t *pServiceConfig)
     bleResult_t result;
     uint16_t  handle;
     bleUuid_t uuidPlxFeature = Uuid16(gBleSig_PulseOximeterFeature_d);
-    uint8_t i;
+    plxUserData_t *pUserData = pServiceConfig->pUserData;
+    uint16_t count;
 
-    if(pServiceConfig->pUserData)
-    {
-        pServiceConfig->pUserData->lastSeqNumber = 0x00;
-    }
-    
-    for (i = 0; i < gPlx_MaxNumOfStoredMeasurements_c; i++)
+    if(pUserData)
     {
-        pServiceConfig->pUserData->pStoredMeasurements[i].seqNumber = 0xFF;
+        pUserData->lastSeqNumber = 0x00;
+
+#if gPlx_UseNvmStorage_d
+        if (pUserData->pStoredMeasurements == NULL)
+        {
+            pUserData->pStoredMeasurements = gaPlxStoredMeasurements;
+        }
+#endif
+
+        /* Rebuild the index of the records restored from NVM */
+        if (RecStore_Init(&pUserData->measurementStore, pUserData->pStoredMeasurements,
+                          sizeof(plxStoredMeasurement_t), gPlx_MaxNumOfStoredMeasurements_c) == gBleSuccess_c)
+        {
+            count = RecStore_GetCount(&pUserData->measurementStore);
+
+            if (count)
+            {
+                pUserData->lastSeqNumber = ((plxSpotCheckMeasurement_t*)RecStore_GetRecord(&pUserData->measurementStore, count - 1))->seqNumber;
+            }
+        }
     }
     
     /* Get handle of characteristic */
@@ -424,12 +450,15 @@ static bleResult_t Plx_SetPulseOximeterFeature
     return result;
 }
 
-static void Plx_SendStoredMeasurement(plxConfig_t *pServiceConfig, uint8_t index)
+static void Plx_SendStoredMeasurement(plxConfig_t *pServiceConfig, uint16_t position)
 {
     uint16_t  handle;
     bleResult_t result;
     bleUuid_t uuid = Uuid16(gBleSig_PlxSCMeasurement_d);
-    plxSpotCheckMeasurement_t *pMeasurement = pServiceConfig->pUserData->pStoredMeasurements + index;
+    plxSpotCheckMeasurement_t *pMeasurement = RecStore_GetRecord(&pServiceConfig->pUserData->measurementStore, position);
+
+    if (pMeasurement == NULL)
+        return;
       
     /* SpO2PR Measurement */
     /* Get handle of characteristic */
@@ -477,9 +506,7 @@ static void Plx_SendProcedureResponse
 
 static void Plx_ReportStoredRecords(plxConfig_t *pServiceConfig, plxProcedure_t* pProcedure, uint16_t handle)
 {
-    plxSpotCheckMeasurement_t *pMeasurement;
     plxProcedure_t      response;
-    uint8_t             index;
     bool_t isIndicationActive;
     uint16_t  hCccd;
     
@@ -488,18 +515,9 @@ static void Plx_ReportStoredRecords(plxConfig_t *pServiceConfig, plxProcedure_t*
       return;
     }
     
-    while ( mMeasurementIndex < gPlx_MaxNumOfStoredMeasurements_c)
+    if ( mMeasurementIndex < RecStore_GetCount(&pServiceConfig->pUserData->measurementStore))
     {
-        index = (pServiceConfig->pUserData->measurementCursor + mMeasurementIndex) % gPlx_MaxNumOfStoredMeasurements_c;
-        pMeasurement = pServiceConfig->pUserData->pStoredMeasurements + index;
-        
-        if (pMeasurement->seqNumber == 0xFF)
-        {
-            mMeasurementIndex++;
-            continue;
-        }
-        
-        Plx_SendStoredMeasurement(pServiceConfig, index);
+        Plx_SendStoredMeasurement(pServiceConfig, mMeasurementIndex);
         mMeasurementIndex++;
         pServiceConfig->pUserData->cReportedRecords++;
             /* Start advertising timer */
@@ -516,7 +534,7 @@ static void Plx_ReportStoredRecords(plxConfig_t *pServiceConfig, plxProcedure_t*
     response.plxOperator = gPlx_Null_c;
     response.operand.responseCode.reqOpCode = gPlx_ReportStoredRecords_c;
     response.operand.responseCode.rspCodeValue = 
-      (pServiceConfig->pUserData->cMeasurements == 0) ? 
+      (RecStore_GetCount(&pServiceConfig->pUserData->measurementStore) == 0) ? 
         gPlx_RspNoRecordsFound_c : gPlx_RspSuccess_c;
         
     /* Indicate value to client */     
@@ -534,7 +552,6 @@ static void Plx_DeleteStoredRecords(plxConfig_t *pServiceConfig, uint16_t handle
     plxProcedure_t      response;
     bool_t isIndicationActive;
     uint16_t  hCccd;
-    uint8_t i;
     
     response.opCode = gPlx_RspCode_c;
     response.plxOperator = gPlx_Null_c;
@@ -544,17 +561,9 @@ static void Plx_DeleteStoredRecords(plxConfig_t *pServiceConfig, uint16_t handle
     if(pServiceConfig->pUserData)
     {
         pServiceConfig->pUserData->lastSeqNumber = 0x00;
+        RecStore_Clear(&pServiceConfig->pUserData->measurementStore);
     }
     
-    for (i = 0; i < gPlx_MaxNumOfStoredMeasurements_c; i++)
-    {
-        pServiceConfig->pUserData->pStoredMeasurements[i].seqNumber = 0xFF;
-    }
-    
-    /* Update cursor and count */
-    pServiceConfig->pUserData->measurementCursor = 0x00;
-    pServiceConfig->pUserData->cMeasurements = 0x00;
-    
     /* Get handle of CCCD */
     if (GattDb_FindCccdHandleForCharValueHandle(handle, &hCccd) != gBleSuccess_c)
         return;
@@ -576,7 +585,7 @@ static void Plx_ReportNumOfStoredRecords(plxConfig_t *pServiceConfig, plxProcedu
     response.opCode = gPlx_NumOfStoredRecordsRsp_c;
     response.plxOperator = gPlx_Null_c;
         
-    response.operand.numberOfRecords = pServiceConfig->pUserData->cMeasurements;
+    response.operand.numberOfRecords = RecStore_GetCount(&pServiceConfig->pUserData->measurementStore);
 
     /* Write response in characteristic */
     GattDb_WriteAttribute(handle, sizeof(plxProcedure_t), (uint8_t*) &response);
@@ -701,20 +710,29 @@ static plxRspCodeValue_t Plx_ValidateProcedure(plxProcedure_t* pProcedure, uint8
 
 static bleResult_t Plx_StoreMeasurement(plxUserData_t *pUserData, plxSpotCheckMeasurement_t *pMeasurement)
 {
+    recStore_t *pStore = &pUserData->measurementStore;
+    uint16_t    count;
+    uint32_t    seqKey = 0;
+
     if (pUserData->pStoredMeasurements == NULL)
     {
         return gBleOutOfMemory_c;
     }
 
-    /* Store measurement */
-    FLib_MemCpy(&pUserData->pStoredMeasurements[pUserData->measurementCursor],
-                pMeasurement,
-                sizeof(plxSpotCheckMeasurement_t));
+    /* The 8-bit sequence number wraps, so the store is keyed on an append counter */
+    count = RecStore_GetCount(pStore);
 
-    /* Update cursor and count */
-    pUserData->measurementCursor = (pUserData->measurementCursor + 1) % gPlx_MaxNumOfStoredMeasurements_c;
-    pUserData->cMeasurements = MIN(pUserData->cMeasurements + 1, gPlx_MaxNumOfStoredMeasurements_c);
-    return gBleSuccess_c;
+    if (count)
+    {
+        seqKey = RecStore_GetHeader(pStore, count - 1)->seqKey + 1;
+    }
+
+    return RecStore_Append(pStore, seqKey,
+                           RecStore_TimeKey(pMeasurement->timeStamp.year, pMeasurement->timeStamp.month,
+                                            pMeasurement->timeStamp.day, pMeasurement->timeStamp.hours,
+                                            pMeasurement->timeStamp.minutes, pMeasurement->timeStamp.seconds),
+                           pMeasurement,
+                           sizeof(plxSpotCheckMeasurement_t));
 }
 
 static void ReportTimerCallback(void * pParam)
@@ -0,0 +1,452 @@
+/*! *********************************************************************************
+* \addtogroup Record Store
+* @{
+ ********************************************************************************** */
+/*!
+* Copyright 2016-2017 NXP
+* All rights reserved.
+*
+* file
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "FunctionLib.h"
+#include "NVM_Interface.h"
+
+#include "ble_general.h"
+
+#include "record_store_interface.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private functions prototypes
+*************************************************************************************
+************************************************************************************/
+static recStoreHeader_t* RecStore_SlotAt(recStore_t *pStore, uint16_t position);
+static uint32_t RecStore_KeyAt(recStore_t *pStore, recStoreKey_t key, uint16_t position);
+static uint16_t RecStore_LowerBound(recStore_t *pStore, recStoreKey_t key, uint32_t value);
+static bool_t RecStore_IsSorted(recStore_t *pStore, recStoreKey_t key);
+static void RecStore_Persist(void *pData, bool_t saveAll);
+
+/***********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+
+bleResult_t RecStore_Init
+(
+    recStore_t *pStore,
+    void       *pSlots,
+    uint16_t    slotSize,
+    uint16_t    capacity
+)
+{
+    recStoreHeader_t *pHeader;
+    uint32_t maxKey = 0;
+    uint16_t newest = 0;
+    uint16_t i;
+
+    if ((pStore == NULL) || (pSlots == NULL) || (capacity == 0) ||
+        (slotSize < sizeof(recStoreHeader_t)))
+    {
+        return gBleInvalidParameter_c;
+    }
+
+    pStore->pSlots = (uint8_t*)pSlots;
+    pStore->slotSize = slotSize;
+    pStore->capacity = capacity;
+    pStore->head = 0;
+    pStore->count = 0;
+    pStore->timeDescents = 0;
+
+    /* Slots are filled in order and only wrap when the store is full, so the
+       restored buffer is either a prefix of valid slots or a full ring whose
+       oldest entry follows the one with the highest sequence key. */
+    for (i = 0; i < capacity; i++)
+    {
+        pHeader = (recStoreHeader_t*)(pStore->pSlots + (uint32_t)i * slotSize);
+
+        if (pHeader->marker != gRecStore_SlotMarker_c)
+        {
+            continue;
+        }
+
+        pStore->count++;
+
+        if ((pStore->count == 1) || (pHeader->seqKey > maxKey))
+        {
+            maxKey = pHeader->seqKey;
+            newest = i;
+        }
+    }
+
+    if (pStore->count == capacity)
+    {
+        pStore->head = (newest + 1) % capacity;
+    }
+
+    pStore->timeDescents = 0;
+
+    for (i = 1; i < pStore->count; i++)
+    {
+        if (RecStore_KeyAt(pStore, gRecStore_TimeKey_c, i) <
+            RecStore_KeyAt(pStore, gRecStore_TimeKey_c, i - 1))
+        {
+            pStore->timeDescents++;
+        }
+    }
+
+    return gBleSuccess_c;
+}
+
+bleResult_t RecStore_Append
+(
+    recStore_t *pStore,
+    uint32_t    seqKey,
+    uint32_t    timeKey,
+    const void *pRecord,
+    uint16_t    length
+)
+{
+    recStoreHeader_t *pHeader;
+    uint16_t slot;
+
+    if ((pStore == NULL) || (pStore->pSlots == NULL) ||
+        (length > pStore->slotSize - sizeof(recStoreHeader_t)))
+    {
+        return gBleInvalidParameter_c;
+    }
+
+    /* Keep the ring sorted by sequence key */
+    if ((pStore->count != 0) &&
+        (seqKey <= RecStore_KeyAt(pStore, gRecStore_SeqKey_c, pStore->count - 1)))
+    {
+        return gBleInvalidParameter_c;
+    }
+
+    /* Count the time key descents of the ring: the one to the new record, less
+       the one from the evicted record to its successor */
+    if ((pStore->count != 0) && (pStore->capacity > 1) &&
+        (timeKey < RecStore_KeyAt(pStore, gRecStore_TimeKey_c, pStore->count - 1)))
+    {
+        pStore->timeDescents++;
+    }
+
+    if ((pStore->count == pStore->capacity) && (pStore->capacity > 1) &&
+        (RecStore_KeyAt(pStore, gRecStore_TimeKey_c, 1) < RecStore_KeyAt(pStore, gRecStore_TimeKey_c, 0)))
+    {
+        pStore->timeDescents--;
+    }
+
+    slot = (pStore->head + pStore->count) % pStore->capacity;
+    pHeader = (recStoreHeader_t*)(pStore->pSlots + (uint32_t)slot * pStore->slotSize);
+
+    pHeader->seqKey = seqKey;
+    pHeader->timeKey = timeKey;
+    pHeader->marker = gRecStore_SlotMarker_c;
+    pHeader->reserved = 0;
+    FLib_MemCpy(pHeader + 1, (void*)pRecord, length);
+
+    if (pStore->count < pStore->capacity)
+    {
+        pStore->count++;
+    }
+    else
+    {
+        pStore->head = (pStore->head + 1) % pStore->capacity;
+    }
+
+    /* Only the written slot is appended to flash */
+    RecStore_Persist(pHeader, FALSE);
+
+    return gBleSuccess_c;
+}
+
+void RecStore_Clear(recStore_t *pStore)
+{
+    uint16_t i;
+
+    for (i = 0; i < pStore->capacity; i++)
+    {
+        ((recStoreHeader_t*)(pStore->pSlots + (uint32_t)i * pStore->slotSize))->marker = 0;
+    }
+
+    pStore->head = 0;
+    pStore->count = 0;
+    pStore->timeDescents = 0;
+
+    RecStore_Persist(pStore->pSlots, TRUE);
+}
+
+uint16_t RecStore_GetCount(recStore_t *pStore)
+{
+    return pStore->count;
+}
+
+recStoreHeader_t* RecStore_GetHeader(recStore_t *pStore, uint16_t position)
+{
+    if (position >= pStore->count)
+    {
+        return NULL;
+    }
+
+    return RecStore_SlotAt(pStore, position);
+}
+
+void* RecStore_GetRecord(recStore_t *pStore, uint16_t position)
+{
+    recStoreHeader_t *pHeader = RecStore_GetHeader(pStore, position);
+
+    if (pHeader == NULL)
+    {
+        return NULL;
+    }
+
+    return pHeader + 1;
+}
+
+uint16_t RecStore_FindRange
+(
+    recStore_t     *pStore,
+    recStoreKey_t   key,
+    uint32_t        minKey,
+    uint32_t        maxKey,
+    uint16_t       *pFirst
+)
+{
+    uint16_t first;
+    uint16_t last;
+    uint16_t count = 0;
+    uint32_t value;
+    uint16_t i;
+
+    *pFirst = gRecStore_InvalidIndex_c;
+
+    if ((pStore->count == 0) || (minKey > maxKey))
+    {
+        return 0;
+    }
+
+    if (!RecStore_IsSorted(pStore, key))
+    {
+        for (i = 0; i < pStore->count; i++)
+        {
+            value = RecStore_KeyAt(pStore, key, i);
+
+            if ((value >= minKey) && (value <= maxKey))
+            {
+                if (count == 0)
+                {
+                    *pFirst = i;
+                }
+
+                count++;
+            }
+        }
+
+        return count;
+    }
+
+    first = RecStore_LowerBound(pStore, key, minKey);
+
+    if (maxKey == 0xFFFFFFFFU)
+    {
+        last = pStore->count;
+    }
+    else
+    {
+        last = RecStore_LowerBound(pStore, key, maxKey + 1);
+    }
+
+    if (first >= last)
+    {
+        return 0;
+    }
+
+    *pFirst = first;
+    return last - first;
+}
+
+uint16_t RecStore_FindNext
+(
+    recStore_t     *pStore,
+    recStoreKey_t   key,
+    uint32_t        minKey,
+    uint32_t        maxKey,
+    uint32_t       *pCursor
+)
+{
+    bool_t   sorted = RecStore_IsSorted(pStore, key);
+    uint16_t position = RecStore_LowerBound(pStore, gRecStore_SeqKey_c, *pCursor);
+    uint16_t first;
+    uint32_t value;
+
+    if (sorted)
+    {
+        first = RecStore_LowerBound(pStore, key, minKey);
+
+        if (first > position)
+        {
+            position = first;
+        }
+    }
+
+    for (; position < pStore->count; position++)
+    {
+        value = RecStore_KeyAt(pStore, key, position);
+
+        if ((value >= minKey) && (value <= maxKey))
+        {
+            *pCursor = RecStore_KeyAt(pStore, gRecStore_SeqKey_c, position) + 1;
+            return position;
+        }
+
+        if (sorted && (value > maxKey))
+        {
+            break;
+        }
+    }
+
+    return gRecStore_InvalidIndex_c;
+}
+
+uint32_t RecStore_SeqKey(recStore_t *pStore, uint32_t seqNumber, uint8_t seqBits)
+{
+    uint32_t mask = (1UL << seqBits) - 1;
+    uint32_t newest;
+
+    if (pStore->count == 0)
+    {
+        return seqNumber & mask;
+    }
+
+    /* Step forward from the newest key by the distance between the numbers */
+    newest = RecStore_KeyAt(pStore, gRecStore_SeqKey_c, pStore->count - 1);
+
+    return newest + ((seqNumber - newest) & mask);
+}
+
+uint32_t RecStore_SeqNumberToKey(recStore_t *pStore, uint32_t seqNumber, uint8_t seqBits)
+{
+    uint32_t mask = (1UL << seqBits) - 1;
+    uint32_t oldest;
+
+    if (pStore->count == 0)
+    {
+        return seqNumber & mask;
+    }
+
+    oldest = RecStore_KeyAt(pStore, gRecStore_SeqKey_c, 0);
+
+    return oldest + ((seqNumber - oldest) & mask);
+}
+
+uint32_t RecStore_TimeKey
+(
+    uint16_t    year,
+    uint8_t     month,
+    uint8_t     day,
+    uint8_t     hours,
+    uint8_t     minutes,
+    uint8_t     seconds
+)
+{
+    /* Days before each month, in a common year */
+    static const uint16_t aDaysBeforeMonth[12] =
+        {0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334};
+    uint32_t years;
+    uint32_t days;
+
+    if ((year < 2000) || (month > 12))
+    {
+        return 0;
+    }
+
+    /* 2000 is a leap year: count the leap days of the years before this one */
+    years = year - 2000U;
+    days = years * 365U + (years + 3U) / 4U - (years + 99U) / 100U + (years + 399U) / 400U;
+
+    if (month)
+    {
+        days += aDaysBeforeMonth[month - 1];
+
+        if ((month > 2) && ((year % 4U) == 0) && (((year % 100U) != 0) || ((year % 400U) == 0)))
+        {
+            days++;
+        }
+    }
+
+    days += (day ? day - 1U : 0);
+
+    return ((days * 24U + hours) * 60U + minutes) * 60U + seconds;
+}
+
+/***********************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+********************************************************************************** */
+static recStoreHeader_t* RecStore_SlotAt(recStore_t *pStore, uint16_t position)
+{
+    uint16_t slot = (pStore->head + position) % pStore->capacity;
+
+    return (recStoreHeader_t*)(pStore->pSlots + (uint32_t)slot * pStore->slotSize);
+}
+
+static uint32_t RecStore_KeyAt(recStore_t *pStore, recStoreKey_t key, uint16_t position)
+{
+    recStoreHeader_t *pHeader = RecStore_SlotAt(pStore, position);
+
+    return (key == gRecStore_SeqKey_c) ? pHeader->seqKey : pHeader->timeKey;
+}
+
+/* Returns the position of the first record whose key is not less than value */
+static uint16_t RecStore_LowerBound(recStore_t *pStore, recStoreKey_t key, uint32_t value)
+{
+    uint16_t low = 0;
+    uint16_t high = pStore->count;
+    uint16_t mid;
+
+    while (low < high)
+    {
+        mid = low + ((high - low) >> 1);
+
+        if (RecStore_KeyAt(pStore, key, mid) < value)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+/* The sequence keys always increase; the time keys do unless a descent was stored */
+static bool_t RecStore_IsSorted(recStore_t *pStore, recStoreKey_t key)
+{
+    return (key == gRecStore_SeqKey_c) || (pStore->timeDescents == 0);
+}
+
+static void RecStore_Persist(void *pData, bool_t saveAll)
+{
+#if gRecStore_UseNvm_d
+    (void)NvSaveOnIdle(pData, saveAll);
+#else
+    (void)pData;
+    (void)saveAll;
+#endif
+}
+
+/*! *********************************************************************************
+* @}
+********************************************************************************** */
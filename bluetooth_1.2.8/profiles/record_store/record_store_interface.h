@@ -0,0 +1,278 @@
+/*! *********************************************************************************
+* \defgroup Record Store
+* @{
+********************************************************************************** */
+/*!
+* Copyright 2016-2017 NXP
+* All rights reserved.
+*
+* file
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef _RECORD_STORE_INTERFACE_H_
+#define _RECORD_STORE_INTERFACE_H_
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "ble_general.h"
+
+/************************************************************************************
+*************************************************************************************
+* Public constants & macros
+*************************************************************************************
+************************************************************************************/
+
+/*! Record Store - Persist appended records through the NVM module */
+#ifndef gRecStore_UseNvm_d
+#define gRecStore_UseNvm_d                  gNvStorageIncluded_d
+#endif
+
+/*! Record Store - Marker of a written slot (ASCII = RS). Zeroed RAM and
+*   erased flash are both seen as empty slots. */
+#define gRecStore_SlotMarker_c              0x5253U
+
+/*! Record Store - Returned by the search functions when no record matches */
+#define gRecStore_InvalidIndex_c            0xFFFFU
+
+/*! Record Store - Size of a slot holding a record of the given size */
+#define RecStore_SlotSize(recordSize)       (sizeof(recStoreHeader_t) + (recordSize))
+
+/************************************************************************************
+*************************************************************************************
+* Public type definitions
+*************************************************************************************
+************************************************************************************/
+
+/*! Record Store - Header stored in front of each record. The sequence key must
+*   strictly increase with each append. The time key may decrease, for instance
+*   when the user facing time offset of a profile is changed: time range queries
+*   are answered by bisection while the time keys are non-decreasing, and by a
+*   linear scan otherwise. Profiles whose sequence numbers wrap build the keys
+*   with RecStore_SeqKey(). */
+typedef struct recStoreHeader_tag
+{
+    uint32_t    seqKey;
+    uint32_t    timeKey;
+    uint16_t    marker;
+    uint16_t    reserved;
+}recStoreHeader_t;
+
+/*! Record Store - Key used by the range queries */
+typedef enum
+{
+    gRecStore_SeqKey_c = 0x00,
+    gRecStore_TimeKey_c
+}recStoreKey_t;
+
+/*! Record Store - Instance. The slots buffer is owned by the application and
+*   is normally registered as a NVM data set with one element per slot, so
+*   that every append is written to flash as a single element record. */
+typedef struct recStore_tag
+{
+    uint8_t    *pSlots;
+    uint16_t    slotSize;
+    uint16_t    capacity;
+    uint16_t    head;
+    uint16_t    count;
+    uint16_t    timeDescents;   /*!< Adjacent records whose time key decreases */
+}recStore_t;
+
+/************************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+************************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!**********************************************************************************
+* \brief        Initializes a record store and rebuilds its index from the slots
+*               buffer. Must be called after the NVM data set was restored.
+*
+* \param[in]    pStore      Pointer to the record store.
+* \param[in]    pSlots      Pointer to the slots buffer.
+* \param[in]    slotSize    Size of one slot. See RecStore_SlotSize().
+* \param[in]    capacity    Number of slots in the buffer.
+*
+* \return       gBleSuccess_c or error.
+************************************************************************************/
+bleResult_t RecStore_Init
+(
+    recStore_t *pStore,
+    void       *pSlots,
+    uint16_t    slotSize,
+    uint16_t    capacity
+);
+
+/*!**********************************************************************************
+* \brief        Appends a record, overwriting the oldest one when the store is full.
+*
+* \param[in]    pStore      Pointer to the record store.
+* \param[in]    seqKey      Sequence key of the record. Must be greater than the
+*                           key of the last stored record.
+* \param[in]    timeKey     Time key of the record.
+* \param[in]    pRecord     Pointer to the record payload.
+* \param[in]    length      Payload length. Must fit in the slot.
+*
+* \return       gBleSuccess_c or error.
+************************************************************************************/
+bleResult_t RecStore_Append
+(
+    recStore_t *pStore,
+    uint32_t    seqKey,
+    uint32_t    timeKey,
+    const void *pRecord,
+    uint16_t    length
+);
+
+/*!**********************************************************************************
+* \brief        Removes all records from the store.
+*
+* \param[in]    pStore      Pointer to the record store.
+************************************************************************************/
+void RecStore_Clear(recStore_t *pStore);
+
+/*!**********************************************************************************
+* \brief        Returns the number of stored records.
+*
+* \param[in]    pStore      Pointer to the record store.
+*
+* \return       Number of records.
+************************************************************************************/
+uint16_t RecStore_GetCount(recStore_t *pStore);
+
+/*!**********************************************************************************
+* \brief        Returns the header of a record, by position. Position 0 is the
+*               oldest record.
+*
+* \param[in]    pStore      Pointer to the record store.
+* \param[in]    position    Position of the record.
+*
+* \return       Pointer to the header or NULL if the position is out of range.
+************************************************************************************/
+recStoreHeader_t* RecStore_GetHeader(recStore_t *pStore, uint16_t position);
+
+/*!**********************************************************************************
+* \brief        Returns the payload of a record, by position. Position 0 is the
+*               oldest record.
+*
+* \param[in]    pStore      Pointer to the record store.
+* \param[in]    position    Position of the record.
+*
+* \return       Pointer to the payload or NULL if the position is out of range.
+************************************************************************************/
+void* RecStore_GetRecord(recStore_t *pStore, uint16_t position);
+
+/*!**********************************************************************************
+* \brief        Extends a sequence number which wraps after seqBits bits into a
+*               sequence key. The sequence number is taken as the one following
+*               the newest record, so the key is always greater than the key of
+*               the newest record, unless the number repeats it.
+*
+* \param[in]    pStore      Pointer to the record store.
+* \param[in]    seqNumber   Sequence number of the new record.
+* \param[in]    seqBits     Width of the sequence number, 1 to 31 bits.
+*
+* \return       Sequence key, to be passed to RecStore_Append().
+************************************************************************************/
+uint32_t RecStore_SeqKey(recStore_t *pStore, uint32_t seqNumber, uint8_t seqBits);
+
+/*!**********************************************************************************
+* \brief        Converts a sequence number which wraps after seqBits bits into the
+*               key of the stored record with that number. The number is taken
+*               from the window of 2^seqBits numbers which starts at the oldest
+*               record, so the keys of all stored records can be reached.
+*
+* \param[in]    pStore      Pointer to the record store.
+* \param[in]    seqNumber   Sequence number, for instance a RACP operand.
+* \param[in]    seqBits     Width of the sequence number, 1 to 31 bits.
+*
+* \return       Sequence key, to be passed to RecStore_FindRange().
+************************************************************************************/
+uint32_t RecStore_SeqNumberToKey(recStore_t *pStore, uint32_t seqNumber, uint8_t seqBits);
+
+/*!**********************************************************************************
+* \brief        Builds a time key from a calendar date and time: the number of
+*               seconds since 2000-01-01 00:00:00.
+*
+* \param[in]    year        Year, 2000 or later.
+* \param[in]    month       Month of the year, 1 to 12.
+* \param[in]    day         Day of the month, 1 to 31.
+* \param[in]    hours       Hours, 0 to 23.
+* \param[in]    minutes     Minutes, 0 to 59.
+* \param[in]    seconds     Seconds, 0 to 59.
+*
+* \return       Time key.
+************************************************************************************/
+uint32_t RecStore_TimeKey
+(
+    uint16_t    year,
+    uint8_t     month,
+    uint8_t     day,
+    uint8_t     hours,
+    uint8_t     minutes,
+    uint8_t     seconds
+);
+
+/*!**********************************************************************************
+* \brief        Finds the records with keys in the [minKey, maxKey] interval. The
+*               matching records are contiguous, unless the time keys decrease.
+*
+* \param[in]    pStore      Pointer to the record store.
+* \param[in]    key         Key used for the search.
+* \param[in]    minKey      Lower bound, inclusive.
+* \param[in]    maxKey      Upper bound, inclusive.
+* \param[out]   pFirst      Position of the first matching record.
+*
+* \return       Number of matching records. *pFirst is gRecStore_InvalidIndex_c
+*               when none match.
+************************************************************************************/
+uint16_t RecStore_FindRange
+(
+    recStore_t     *pStore,
+    recStoreKey_t   key,
+    uint32_t        minKey,
+    uint32_t        maxKey,
+    uint16_t       *pFirst
+);
+
+/*!**********************************************************************************
+* \brief        Finds the next record with a key in the [minKey, maxKey] interval.
+*               The cursor is a sequence key, so a report which spans several
+*               calls is not disturbed by the appends and evictions in between.
+*
+* \param[in]    pStore      Pointer to the record store.
+* \param[in]    key         Key used for the search.
+* \param[in]    minKey      Lower bound, inclusive.
+* \param[in]    maxKey      Upper bound, inclusive.
+* \param[inout] pCursor     Lowest sequence key to look at. Set to 0 for the first
+*                           call; advanced past the returned record.
+*
+* \return       Position of the record, or gRecStore_InvalidIndex_c when no
+*               further record matches.
+************************************************************************************/
+uint16_t RecStore_FindNext
+(
+    recStore_t     *pStore,
+    recStoreKey_t   key,
+    uint32_t        minKey,
+    uint32_t        maxKey,
+    uint32_t       *pCursor
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RECORD_STORE_INTERFACE_H_ */
+
+/*! *********************************************************************************
+* @}
+********************************************************************************** */
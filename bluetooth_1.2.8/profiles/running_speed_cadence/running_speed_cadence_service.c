@@ -26,6 +26,7 @@
 #include "gap_interface.h"
 
 #include "running_speed_cadence_interface.h"
+#include "notification_fanout_interface.h"
 
 /************************************************************************************
 *************************************************************************************
@@ -116,6 +117,11 @@ bleResult_t Rscs_Start (rscsConfig_t *pServiceConfig)
     if (result != gBleSuccess_c)
         return result;
 
+#if gNtfFanout_Enabled_d
+    NtfFanout_RegisterServiceCharacteristic(pServiceConfig->serviceHandle, gBleSig_RscMeasurement_d,
+                                            gNtfFanout_DefaultCoalesceIntervalMs_c);
+#endif
+
     return gBleSuccess_c;
 
 }
@@ -283,6 +289,12 @@ static void Rscs_SendMeasurementNotification
     uint16_t  hCccd;
     bool_t isNotificationActive;
 
+#if gNtfFanout_Enabled_d
+    /* Notify all subscribed clients */
+    if (NtfFanout_Notify(handle) != gBleInvalidParameter_c)
+        return;
+#endif
+
     /* Get handle of CCCD */
     if (GattDb_FindCccdHandleForCharValueHandle(handle, &hCccd) != gBleSuccess_c)
         return;
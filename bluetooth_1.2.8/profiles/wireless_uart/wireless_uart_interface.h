@@ -29,6 +29,36 @@
 *************************************************************************************
 ************************************************************************************/
 
+/*! Wireless UART - Size of the UART to BLE ring buffer. Must be a power of 2. */
+#ifndef gWus_TxBufferSize_c
+#define gWus_TxBufferSize_c                 1024
+#endif
+
+/*! Wireless UART - Size of the BLE to UART ring buffer. Must be a power of 2. */
+#ifndef gWus_RxBufferSize_c
+#define gWus_RxBufferSize_c                 512
+#endif
+
+/*! Wireless UART - Packets that may be handed to the host in one credit period */
+#ifndef gWus_MaxCredits_c
+#define gWus_MaxCredits_c                   4
+#endif
+
+/*! Wireless UART - Credit period, in milliseconds. Should match the connection interval. */
+#ifndef gWus_CreditPeriodMs_c
+#define gWus_CreditPeriodMs_c               10
+#endif
+
+/*! Wireless UART - The UART side is asked to pause above this TX buffer fill level */
+#ifndef gWus_TxHighWatermark_c
+#define gWus_TxHighWatermark_c              ((gWus_TxBufferSize_c * 3) / 4)
+#endif
+
+/*! Wireless UART - The UART side is allowed to resume below this TX buffer fill level */
+#ifndef gWus_TxLowWatermark_c
+#define gWus_TxLowWatermark_c               (gWus_TxBufferSize_c / 4)
+#endif
+
 /************************************************************************************
 *************************************************************************************
 * Public type definitions
@@ -46,6 +76,30 @@ typedef struct wucConfig_tag
     uint16_t    hService;
     uint16_t    hUartStream;
 } wucConfig_t;
+
+/*! Wireless UART - Stream configuration */
+typedef struct wusStreamConfig_tag
+{
+    uint8_t     serialInterfaceId;  /*!< SerialManager interface bridged to the stream. */
+    uint16_t    hUartStream;        /*!< Value handle of the UART Stream characteristic. */
+    bool_t      isGattClient;       /*!< TRUE: send with Write Without Response, FALSE: send with notifications. */
+} wusStreamConfig_t;
+
+/*! Wireless UART - Stream statistics */
+typedef struct wusStreamStats_tag
+{
+    uint32_t    txBytes;            /*!< Bytes sent over the air. */
+    uint32_t    txPackets;          /*!< Packets sent over the air. */
+    uint32_t    txRetries;          /*!< Packets rejected by the host and sent again later. */
+    uint32_t    rxBytes;            /*!< Bytes received over the air and written to the UART. */
+    uint32_t    rxDroppedBytes;     /*!< Bytes received over the air that did not fit in the RX buffer. */
+    uint32_t    txThroughput;       /*!< Sustained over-the-air TX throughput, in bytes per second. */
+    uint32_t    rxThroughput;       /*!< Sustained over-the-air RX throughput, in bytes per second. */
+} wusStreamStats_t;
+
+/*! Wireless UART - Flow control callback. Called with FALSE when the UART side
+*   should pause, and with TRUE when it can resume. */
+typedef void (*wusFlowControlCallback_t)(bool_t resume);
 /************************************************************************************
 *************************************************************************************
 * Public memory declarations
@@ -98,6 +152,45 @@ bleResult_t Wus_Subscribe(deviceId_t clientDeviceId);
 ************************************************************************************/
 bleResult_t Wus_Unsubscribe();
 
+/*!**********************************************************************************
+* \brief        Opens the data stream between a serial interface and a peer.
+*
+* \param[in]    peerDeviceId    Peer Id in Device DB.
+* \param[in]    pConfig         Pointer to the stream configuration.
+*
+* \return       gBleSuccess_c or error.
+************************************************************************************/
+bleResult_t Wus_StreamOpen(deviceId_t peerDeviceId, wusStreamConfig_t *pConfig);
+
+/*!**********************************************************************************
+* \brief        Closes the data stream. Buffered data is discarded.
+************************************************************************************/
+void Wus_StreamClose(void);
+
+/*!**********************************************************************************
+* \brief        Forwards data received over the air to the serial interface. Must be
+*               called for writes to the UART Stream characteristic (server) or for
+*               its notifications (client).
+*
+* \param[in]    aValue          Received data.
+* \param[in]    valueLength     Length of the received data.
+************************************************************************************/
+void Wus_StreamReceive(uint8_t *aValue, uint16_t valueLength);
+
+/*!**********************************************************************************
+* \brief        Installs the flow control callback of the UART side.
+*
+* \param[in]    pfCallback      Flow control callback, or NULL.
+************************************************************************************/
+void Wus_SetFlowControlCallback(wusFlowControlCallback_t pfCallback);
+
+/*!**********************************************************************************
+* \brief        Returns the stream statistics since it was opened.
+*
+* \param[out]   pStats          Pointer to the statistics structure.
+************************************************************************************/
+void Wus_GetStreamStatistics(wusStreamStats_t *pStats);
+
 #ifdef __cplusplus
 }
 #endif
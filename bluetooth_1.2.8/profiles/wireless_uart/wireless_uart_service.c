@@ -18,8 +18,13 @@
 *************************************************************************************
 ************************************************************************************/
 #include "FunctionLib.h"
+#include "fsl_os_abstraction.h"
+#include "SerialManager.h"
+#include "TimersManager.h"
 #include "ble_general.h"
 #include "gatt_db_app_interface.h"
+#include "gatt_interface.h"
+#include "gatt_client_interface.h"
 #include "gatt_server_interface.h"
 #include "gap_interface.h"
 #include "wireless_uart_interface.h"
@@ -28,12 +33,43 @@
 * Private constants & macros
 *************************************************************************************
 ************************************************************************************/
+#if (gWus_TxBufferSize_c & (gWus_TxBufferSize_c - 1)) || (gWus_RxBufferSize_c & (gWus_RxBufferSize_c - 1))
+#error "Wireless UART buffer sizes must be powers of 2"
+#endif
+
+/* Largest payload of a notification or a Write Without Response */
+#define mWusMaxPayload_c        (gAttMaxDataSize_d(gAttMaxMtu_c) - gAttHandleSize_d)
+
+/* The ring indexes run freely and are masked on access */
+#define mWusTxUsed()            ((uint16_t)(mWusTxHead - mWusTxTail))
+#define mWusRxUsed()            ((uint16_t)(mWusRxHead - mWusRxTail))
+
+/* Work requested from the TX pump, see Wus_TxPump() */
+#define mWusPumpPull_c          (1U << 0)   /* Move the serial RX bytes into the TX ring */
+#define mWusPumpSend_c          (1U << 1)   /* Send the TX ring while credits are available */
+#define mWusPumpCredits_c       (1U << 2)   /* Grant a new set of credits */
 
 /************************************************************************************
 *************************************************************************************
 * Private type definitions
 *************************************************************************************
 ************************************************************************************/
+typedef struct wusStream_tag
+{
+    wusStreamConfig_t           config;
+    deviceId_t                  peerDeviceId;
+    bool_t                      isOpen;
+    bool_t                      isPaused;
+    bool_t                      isSerialTxBusy;
+    bool_t                      isTxPumpBusy;
+    volatile uint8_t            txPumpRequests;
+    uint8_t                     credits;
+    uint16_t                    serialTxLength;
+    tmrTimerID_t                creditTimerId;
+    uint64_t                    openTs;
+    wusFlowControlCallback_t    pfFlowControl;
+    wusStreamStats_t            stats;
+}wusStream_t;
 
 /************************************************************************************
 *************************************************************************************
@@ -44,11 +80,35 @@
 /*! wireless_uart Service - Subscribed Client*/
 static deviceId_t mWus_SubscribedClientId;
 
+/*! wireless_uart Service - Stream state */
+static wusStream_t mWusStream = {.creditTimerId = gTmrInvalidTimerID_c};
+
+/*! wireless_uart Service - UART to BLE ring. While the stream is open, only
+*   accessed by Wus_TxPump(), for the serial RX callback and the credit timer. */
+static uint8_t maWusTxBuffer[gWus_TxBufferSize_c];
+static volatile uint16_t mWusTxHead;
+static volatile uint16_t mWusTxTail;
+
+/*! wireless_uart Service - BLE to UART ring. Written by the host callbacks,
+*   read by the serial TX completion. */
+static uint8_t maWusRxBuffer[gWus_RxBufferSize_c];
+static volatile uint16_t mWusRxHead;
+static volatile uint16_t mWusRxTail;
+
 /************************************************************************************
 *************************************************************************************
 * Private functions prototypes
 *************************************************************************************
 ************************************************************************************/
+static void Wus_SerialRxCallback(void *pParam);
+static void Wus_SerialPull(void);
+static void Wus_SerialTxCallback(void *pParam);
+static void Wus_CreditTimerCallback(void *pParam);
+static void Wus_TxPump(uint8_t requests);
+static void Wus_TxSend(void);
+static void Wus_RxPump(void);
+static uint16_t Wus_GetPayloadSize(void);
+static uint32_t Wus_Throughput(uint32_t bytes);
 
 /************************************************************************************
 *************************************************************************************
@@ -69,8 +129,13 @@ bleResult_t Wus_Stop (wusConfig_t *pServiceConfig)
 
 bleResult_t Wus_Subscribe(deviceId_t deviceId)
 {
-    if (mWus_SubscribedClientId != gInvalidDeviceId_c)
-        mWus_SubscribedClientId = deviceId;
+    mWus_SubscribedClientId = deviceId;
+
+    /* Data may have been buffered while no client was subscribed */
+    if (mWusStream.isOpen)
+    {
+        Wus_TxPump(mWusPumpSend_c);
+    }
 
     return gBleSuccess_c;
 }
@@ -81,11 +146,425 @@ bleResult_t Wus_Unsubscribe()
     return gBleSuccess_c;
 }
 
+bleResult_t Wus_StreamOpen(deviceId_t peerDeviceId, wusStreamConfig_t *pConfig)
+{
+    if ((pConfig == NULL) || (peerDeviceId == gInvalidDeviceId_c))
+    {
+        return gBleInvalidParameter_c;
+    }
+
+    if (mWusStream.creditTimerId == gTmrInvalidTimerID_c)
+    {
+        mWusStream.creditTimerId = TMR_AllocateTimer();
+
+        if (mWusStream.creditTimerId == gTmrInvalidTimerID_c)
+        {
+            return gBleOutOfMemory_c;
+        }
+    }
+
+    mWusStream.config = *pConfig;
+    mWusStream.peerDeviceId = peerDeviceId;
+    mWusStream.isPaused = FALSE;
+    mWusStream.credits = gWus_MaxCredits_c;
+    mWusStream.openTs = TMR_GetTimestamp();
+    FLib_MemSet(&mWusStream.stats, 0, sizeof(mWusStream.stats));
+
+    OSA_InterruptDisable();
+    mWusTxHead = mWusTxTail = 0;
+    if (!mWusStream.isSerialTxBusy)
+    {
+        mWusRxHead = mWusRxTail = 0;
+    }
+    mWusStream.isOpen = TRUE;
+    OSA_InterruptEnable();
+
+    if (Serial_SetRxCallBack(pConfig->serialInterfaceId, Wus_SerialRxCallback, NULL) != gSerial_Success_c)
+    {
+        mWusStream.isOpen = FALSE;
+        return gBleUnexpectedError_c;
+    }
+
+    /* Bytes received before the stream was opened */
+    Wus_TxPump(mWusPumpPull_c | mWusPumpSend_c);
+
+    return gBleSuccess_c;
+}
+
+void Wus_StreamClose(void)
+{
+    if (!mWusStream.isOpen)
+    {
+        return;
+    }
+
+    (void)Serial_SetRxCallBack(mWusStream.config.serialInterfaceId, NULL, NULL);
+    (void)TMR_StopTimer(mWusStream.creditTimerId);
+
+    OSA_InterruptDisable();
+    mWusStream.isOpen = FALSE;
+    mWusTxTail = mWusTxHead;
+    /* A serial write in progress completes; what follows it is discarded */
+    mWusRxHead = mWusRxTail + (mWusStream.isSerialTxBusy ? mWusStream.serialTxLength : 0);
+    OSA_InterruptEnable();
+
+    if (mWusStream.isPaused && (mWusStream.pfFlowControl != NULL))
+    {
+        mWusStream.isPaused = FALSE;
+        mWusStream.pfFlowControl(TRUE);
+    }
+}
+
+void Wus_StreamReceive(uint8_t *aValue, uint16_t valueLength)
+{
+    uint16_t length;
+    uint16_t offset;
+    uint16_t chunk;
+
+    if (!mWusStream.isOpen)
+    {
+        return;
+    }
+
+    length = gWus_RxBufferSize_c - mWusRxUsed();
+
+    if (valueLength < length)
+    {
+        length = valueLength;
+    }
+
+    /* The peer does not wait for the UART: excess data cannot be held back */
+    mWusStream.stats.rxDroppedBytes += valueLength - length;
+    mWusStream.stats.rxBytes += length;
+
+    offset = mWusRxHead & (gWus_RxBufferSize_c - 1);
+    chunk = gWus_RxBufferSize_c - offset;
+
+    if (chunk > length)
+    {
+        chunk = length;
+    }
+
+    FLib_MemCpy(&maWusRxBuffer[offset], aValue, chunk);
+    FLib_MemCpy(maWusRxBuffer, aValue + chunk, length - chunk);
+    mWusRxHead += length;
+
+    Wus_RxPump();
+}
+
+void Wus_SetFlowControlCallback(wusFlowControlCallback_t pfCallback)
+{
+    mWusStream.pfFlowControl = pfCallback;
+}
+
+void Wus_GetStreamStatistics(wusStreamStats_t *pStats)
+{
+    *pStats = mWusStream.stats;
+    pStats->txThroughput = Wus_Throughput(mWusStream.stats.txBytes);
+    pStats->rxThroughput = Wus_Throughput(mWusStream.stats.rxBytes);
+}
+
 /************************************************************************************
 *************************************************************************************
 * Private functions
 *************************************************************************************
 ************************************************************************************/
+
+static void Wus_SerialRxCallback(void *pParam)
+{
+    if (!mWusStream.isOpen)
+    {
+        return;
+    }
+
+    /* While the timer runs, the data is sent when credits are granted */
+    Wus_TxPump(TMR_IsTimerActive(mWusStream.creditTimerId) ? mWusPumpPull_c : (mWusPumpPull_c | mWusPumpSend_c));
+}
+
+/*! *********************************************************************************
+* \brief        Moves bytes from the serial interface into the TX ring, no more than
+*               the ring can hold. The rest is left in the SerialManager buffer
+*               until the credit timer frees space.
+********************************************************************************** */
+static void Wus_SerialPull(void)
+{
+    uint16_t space;
+    uint16_t offset;
+    uint16_t bytesRead;
+
+    while ((space = gWus_TxBufferSize_c - mWusTxUsed()) != 0)
+    {
+        offset = mWusTxHead & (gWus_TxBufferSize_c - 1);
+
+        if (space > gWus_TxBufferSize_c - offset)
+        {
+            space = gWus_TxBufferSize_c - offset;
+        }
+
+        if ((Serial_Read(mWusStream.config.serialInterfaceId, &maWusTxBuffer[offset], space, &bytesRead) != gSerial_Success_c) ||
+            (bytesRead == 0))
+        {
+            break;
+        }
+
+        mWusTxHead += bytesRead;
+    }
+
+    if (!mWusStream.isPaused && (mWusTxUsed() >= gWus_TxHighWatermark_c))
+    {
+        mWusStream.isPaused = TRUE;
+
+        if (mWusStream.pfFlowControl != NULL)
+        {
+            mWusStream.pfFlowControl(FALSE);
+        }
+    }
+}
+
+/*! *********************************************************************************
+* \brief        Releases the bytes written to the serial interface and starts the
+*               next write.
+********************************************************************************** */
+static void Wus_SerialTxCallback(void *pParam)
+{
+    OSA_InterruptDisable();
+    mWusRxTail += mWusStream.serialTxLength;
+    mWusStream.isSerialTxBusy = FALSE;
+    OSA_InterruptEnable();
+
+    Wus_RxPump();
+}
+
+/*! *********************************************************************************
+* \brief        Grants a new set of credits once per credit period.
+********************************************************************************** */
+static void Wus_CreditTimerCallback(void *pParam)
+{
+    Wus_TxPump(mWusPumpCredits_c | mWusPumpSend_c);
+}
+
+/*! *********************************************************************************
+* \brief        Runs the TX side of the stream. It is entered from the serial RX
+*               callback and from the credit timer, which may preempt each other:
+*               a caller which finds the pump running leaves its requests to it,
+*               so the TX ring and the credits only change in one context.
+*
+* \param[in]    requests    Work to do, mWusPump*_c flags.
+********************************************************************************** */
+static void Wus_TxPump(uint8_t requests)
+{
+    OSA_InterruptDisable();
+    mWusStream.txPumpRequests |= requests;
+
+    if (mWusStream.isTxPumpBusy)
+    {
+        OSA_InterruptEnable();
+        return;
+    }
+
+    mWusStream.isTxPumpBusy = TRUE;
+    OSA_InterruptEnable();
+
+    for (;;)
+    {
+        OSA_InterruptDisable();
+        requests = mWusStream.txPumpRequests;
+        mWusStream.txPumpRequests = 0;
+
+        if (requests == 0)
+        {
+            mWusStream.isTxPumpBusy = FALSE;
+        }
+        OSA_InterruptEnable();
+
+        if (requests == 0)
+        {
+            break;
+        }
+
+        if (requests & mWusPumpCredits_c)
+        {
+            mWusStream.credits = gWus_MaxCredits_c;
+        }
+
+        if (requests & mWusPumpPull_c)
+        {
+            Wus_SerialPull();
+        }
+
+        if (requests & mWusPumpSend_c)
+        {
+            Wus_TxSend();
+        }
+    }
+}
+
+/*! *********************************************************************************
+* \brief        Sends the TX ring content in full sized packets while credits are
+*               available. A packet rejected by the host stays in the ring and is
+*               sent again in the next credit period. Only called by Wus_TxPump().
+********************************************************************************** */
+static void Wus_TxSend(void)
+{
+    uint8_t     aPacket[mWusMaxPayload_c];
+    gattCharacteristic_t streamChar;
+    uint16_t    payloadSize;
+    uint16_t    length;
+    uint16_t    offset;
+    uint16_t    chunk;
+    bleResult_t result;
+
+    if (!mWusStream.isOpen)
+    {
+        return;
+    }
+
+    /* Notifications only go to a subscribed peer */
+    if (!mWusStream.config.isGattClient && (mWus_SubscribedClientId != mWusStream.peerDeviceId))
+    {
+        (void)TMR_StopTimer(mWusStream.creditTimerId);
+        return;
+    }
+
+    payloadSize = Wus_GetPayloadSize();
+    streamChar.value.handle = mWusStream.config.hUartStream;
+
+    while ((mWusStream.credits != 0) && (mWusTxUsed() != 0))
+    {
+        length = mWusTxUsed();
+
+        if (length > payloadSize)
+        {
+            length = payloadSize;
+        }
+
+        offset = mWusTxTail & (gWus_TxBufferSize_c - 1);
+        chunk = gWus_TxBufferSize_c - offset;
+
+        if (chunk > length)
+        {
+            chunk = length;
+        }
+
+        FLib_MemCpy(aPacket, &maWusTxBuffer[offset], chunk);
+        FLib_MemCpy(&aPacket[chunk], maWusTxBuffer, length - chunk);
+
+        if (mWusStream.config.isGattClient)
+        {
+            result = GattClient_CharacteristicWriteWithoutResponse(mWusStream.peerDeviceId, &streamChar, length, aPacket);
+        }
+        else
+        {
+            result = GattServer_SendInstantValueNotification(mWusStream.peerDeviceId,
+                                                             mWusStream.config.hUartStream, length, aPacket);
+        }
+
+        if (result != gBleSuccess_c)
+        {
+            mWusStream.stats.txRetries++;
+            break;
+        }
+
+        mWusTxTail += length;
+        mWusStream.credits--;
+        mWusStream.stats.txPackets++;
+        mWusStream.stats.txBytes += length;
+
+        /* Pull the bytes the full ring left in the SerialManager buffer */
+        if (mWusStream.isPaused)
+        {
+            Wus_SerialPull();
+        }
+    }
+
+    if (mWusStream.isPaused && (mWusTxUsed() <= gWus_TxLowWatermark_c))
+    {
+        mWusStream.isPaused = FALSE;
+
+        if (mWusStream.pfFlowControl != NULL)
+        {
+            mWusStream.pfFlowControl(TRUE);
+        }
+    }
+
+    /* The timer only runs while there is data waiting for credits */
+    if (mWusTxUsed() != 0)
+    {
+        if (!TMR_IsTimerActive(mWusStream.creditTimerId))
+        {
+            (void)TMR_StartIntervalTimer(mWusStream.creditTimerId, gWus_CreditPeriodMs_c,
+                                         Wus_CreditTimerCallback, NULL);
+        }
+    }
+    else if (mWusStream.credits == gWus_MaxCredits_c)
+    {
+        (void)TMR_StopTimer(mWusStream.creditTimerId);
+    }
+}
+
+/*! *********************************************************************************
+* \brief        Starts a serial write of the contiguous part of the RX ring, if no
+*               write is in progress.
+********************************************************************************** */
+static void Wus_RxPump(void)
+{
+    uint16_t offset;
+    uint16_t length;
+
+    OSA_InterruptDisable();
+
+    if (mWusStream.isSerialTxBusy || (mWusRxUsed() == 0))
+    {
+        OSA_InterruptEnable();
+        return;
+    }
+
+    offset = mWusRxTail & (gWus_RxBufferSize_c - 1);
+    length = gWus_RxBufferSize_c - offset;
+
+    if (length > mWusRxUsed())
+    {
+        length = mWusRxUsed();
+    }
+
+    mWusStream.isSerialTxBusy = TRUE;
+    mWusStream.serialTxLength = length;
+    OSA_InterruptEnable();
+
+    if (Serial_AsyncWrite(mWusStream.config.serialInterfaceId, &maWusRxBuffer[offset], length,
+                          Wus_SerialTxCallback, NULL) != gSerial_Success_c)
+    {
+        /* Retried on the next received packet */
+        mWusStream.isSerialTxBusy = FALSE;
+    }
+}
+
+static uint16_t Wus_GetPayloadSize(void)
+{
+    uint16_t mtu = gAttDefaultMtu_c;
+
+    (void)Gatt_GetMtu(mWusStream.peerDeviceId, &mtu);
+
+    if (mtu > gAttMaxMtu_c)
+    {
+        mtu = gAttMaxMtu_c;
+    }
+
+    return gAttMaxDataSize_d(mtu) - gAttHandleSize_d;
+}
+
+static uint32_t Wus_Throughput(uint32_t bytes)
+{
+    uint64_t elapsedUs = TMR_GetTimestamp() - mWusStream.openTs;
+
+    if (elapsedUs == 0)
+    {
+        return 0;
+    }
+
+    return (uint32_t)(((uint64_t)bytes * 1000000) / elapsedUs);
+}
+
 /*! *********************************************************************************
  * @}
  ********************************************************************************** */
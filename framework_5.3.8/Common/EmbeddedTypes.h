@@ -57,6 +57,13 @@ typedef uint8_t   index_t;
 #define PACKED_UNION union
 #endif
 
+/* 32-bit word which may alias any other type, used to access byte buffers word by word */
+#if defined(__GNUC__)
+typedef uint32_t __attribute__ ((__may_alias__)) uint32_alias_t;
+#else
+typedef uint32_t uint32_alias_t;
+#endif
+
 typedef unsigned char uintn8_t;
 typedef unsigned long uintn32_t;
 
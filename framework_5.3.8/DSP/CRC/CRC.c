@@ -7,10 +7,64 @@
 
 #include "CRC.h"
 
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+static uint32_t CRC_Reflect(uint32_t value, uint8_t bits);
+static uint32_t CRC_Seed(const CRC_config_t *crcConfig, bool_t reflected);
+static uint32_t CRC_Final(const CRC_config_t *crcConfig, bool_t reflected, uint32_t crc);
+
 /*******************************************************************************
  * Code
  ******************************************************************************/
 uint32_t CRC_Compute(CRC_config_t crcConfig, uint8_t *dataIn, uint16_t length)
+{
+    uint8_t crcBits = 8 * crcConfig.crcSize;
+    /* Same register as CRC_Init(), see there */
+    bool_t reflected = (crcConfig.crcRefIn != gCrcRefInput);
+    uint32_t crcPoly;
+    uint32_t crc;
+    uint32_t i, j;
+
+    /* Size 0 will bypass CRC calculation. */
+    if (crcBits == 0)
+    {
+        return 0;
+    }
+
+    crc = CRC_Seed(&crcConfig, reflected);
+
+    if (reflected)
+    {
+        crcPoly = CRC_Reflect(crcConfig.crcPoly, crcBits);
+
+        for (i = crcConfig.crcStartByte; i < length; i++)
+        {
+            crc ^= dataIn[i];
+            for (j = 0; j < 8; j++)
+            {
+                crc = (crc & 1) ? ((crc >> 1) ^ crcPoly) : (crc >> 1);
+            }
+        }
+    }
+    else
+    {
+        crcPoly = crcConfig.crcPoly << (32 - crcBits);
+
+        for (i = crcConfig.crcStartByte; i < length; i++)
+        {
+            crc ^= (uint32_t)dataIn[i] << 24;
+            for (j = 0; j < 8; j++)
+            {
+                crc = (crc & 0x80000000U) ? ((crc << 1) ^ crcPoly) : (crc << 1);
+            }
+        }
+    }
+
+    return CRC_Final(&crcConfig, reflected, crc);
+}
+
+uint32_t CRC_ComputeBitwise(CRC_config_t crcConfig, uint8_t *dataIn, uint16_t length)
 {
     uint32_t shiftReg = crcConfig.crcSeed << ((4 - crcConfig.crcSize) << 3);
     uint32_t crcPoly = crcConfig.crcPoly << ((4 - crcConfig.crcSize) << 3);
@@ -90,3 +144,221 @@ uint32_t CRC_Compute(CRC_config_t crcConfig, uint8_t *dataIn, uint16_t length)
     
     return computedCRC;
 }
+
+void CRC_Init(CRC_handle_t *handle, const CRC_config_t *crcConfig)
+{
+    uint8_t crcBits = 8 * crcConfig->crcSize;
+    uint32_t crcPoly;
+    uint32_t entry;
+    uint32_t i, j;
+
+    handle->config = *crcConfig;
+
+    /* Size 0 will bypass CRC calculation. */
+    if (crcBits == 0)
+    {
+        return;
+    }
+
+    /* CRC_ComputeBitwise() reflects the input bytes when crcRefIn is gCrcInputNoRef,
+     * which is the same as running a reflected register over the bytes as they are. */
+    handle->reflected = (crcConfig->crcRefIn != gCrcRefInput);
+
+    if (handle->reflected)
+    {
+        crcPoly = CRC_Reflect(crcConfig->crcPoly, crcBits);
+
+        for (i = 0; i < 256; i++)
+        {
+            entry = i;
+            for (j = 0; j < 8; j++)
+            {
+                entry = (entry & 1) ? ((entry >> 1) ^ crcPoly) : (entry >> 1);
+            }
+            handle->table[0][i] = entry;
+        }
+    }
+    else
+    {
+        /* The register is kept left aligned on 32 bits */
+        crcPoly = crcConfig->crcPoly << (32 - crcBits);
+
+        for (i = 0; i < 256; i++)
+        {
+            entry = i << 24;
+            for (j = 0; j < 8; j++)
+            {
+                entry = (entry & 0x80000000U) ? ((entry << 1) ^ crcPoly) : (entry << 1);
+            }
+            handle->table[0][i] = entry;
+        }
+    }
+
+#if (gCrcTableSlices_c > 1)
+    /* table[j][i] is the CRC of byte i followed by j zero bytes */
+    for (j = 1; j < gCrcTableSlices_c; j++)
+    {
+        for (i = 0; i < 256; i++)
+        {
+            entry = handle->table[j - 1][i];
+
+            if (handle->reflected)
+            {
+                handle->table[j][i] = (entry >> 8) ^ handle->table[0][entry & 0xFF];
+            }
+            else
+            {
+                handle->table[j][i] = (entry << 8) ^ handle->table[0][entry >> 24];
+            }
+        }
+    }
+#endif
+}
+
+uint32_t CRC_ComputeWithTable(const CRC_handle_t *handle, const uint8_t *dataIn, uint16_t length)
+{
+    uint16_t startOffset = handle->config.crcStartByte;
+    uint32_t crc;
+
+    /* Size 0 will bypass CRC calculation. */
+    if (handle->config.crcSize == 0)
+    {
+        return 0;
+    }
+
+    crc = CRC_Begin(handle);
+
+    if (startOffset < length)
+    {
+        crc = CRC_Update(handle, crc, &dataIn[startOffset], length - startOffset);
+    }
+
+    return CRC_End(handle, crc);
+}
+
+uint32_t CRC_Begin(const CRC_handle_t *handle)
+{
+    if (handle->config.crcSize == 0)
+    {
+        return 0;
+    }
+
+    return CRC_Seed(&handle->config, handle->reflected);
+}
+
+uint32_t CRC_Update(const CRC_handle_t *handle, uint32_t crc, const uint8_t *dataIn, uint32_t length)
+{
+    if (handle->config.crcSize == 0)
+    {
+        return crc;
+    }
+
+    if (handle->reflected)
+    {
+#if (gCrcTableSlices_c == 4)
+        while (length >= 4)
+        {
+            crc ^= (uint32_t)dataIn[0] | ((uint32_t)dataIn[1] << 8) |
+                   ((uint32_t)dataIn[2] << 16) | ((uint32_t)dataIn[3] << 24);
+            crc = handle->table[3][crc & 0xFF] ^ handle->table[2][(crc >> 8) & 0xFF] ^
+                  handle->table[1][(crc >> 16) & 0xFF] ^ handle->table[0][crc >> 24];
+            dataIn += 4;
+            length -= 4;
+        }
+#endif
+        while (length--)
+        {
+            crc = (crc >> 8) ^ handle->table[0][(crc ^ *dataIn++) & 0xFF];
+        }
+    }
+    else
+    {
+#if (gCrcTableSlices_c == 4)
+        while (length >= 4)
+        {
+            crc ^= ((uint32_t)dataIn[0] << 24) | ((uint32_t)dataIn[1] << 16) |
+                   ((uint32_t)dataIn[2] << 8) | (uint32_t)dataIn[3];
+            crc = handle->table[3][crc >> 24] ^ handle->table[2][(crc >> 16) & 0xFF] ^
+                  handle->table[1][(crc >> 8) & 0xFF] ^ handle->table[0][crc & 0xFF];
+            dataIn += 4;
+            length -= 4;
+        }
+#endif
+        while (length--)
+        {
+            crc = (crc << 8) ^ handle->table[0][(crc >> 24) ^ *dataIn++];
+        }
+    }
+
+    return crc;
+}
+
+uint32_t CRC_End(const CRC_handle_t *handle, uint32_t crc)
+{
+    if (handle->config.crcSize == 0)
+    {
+        return 0;
+    }
+
+    return CRC_Final(&handle->config, handle->reflected, crc);
+}
+
+/*! @brief Reverses the order of the low bits of a value, the other bits are cleared. */
+static uint32_t CRC_Reflect(uint32_t value, uint8_t bits)
+{
+    uint32_t reflected = 0;
+    uint8_t i;
+
+    for (i = 0; i < bits; i++)
+    {
+        reflected = (reflected << 1) | (value & 1);
+        value >>= 1;
+    }
+
+    return reflected;
+}
+
+/*! @brief Initial CRC register: the seed, reflected or left aligned on 32 bits. */
+static uint32_t CRC_Seed(const CRC_config_t *crcConfig, bool_t reflected)
+{
+    uint8_t crcBits = 8 * crcConfig->crcSize;
+
+    if (reflected)
+    {
+        return CRC_Reflect(crcConfig->crcSeed, crcBits);
+    }
+
+    return crcConfig->crcSeed << (32 - crcBits);
+}
+
+/*! @brief Applies the XOR mask and the byte order to a CRC register. */
+static uint32_t CRC_Final(const CRC_config_t *crcConfig, bool_t reflected, uint32_t crc)
+{
+    uint8_t crcBits = 8 * crcConfig->crcSize;
+
+    if (reflected)
+    {
+        /* The register already holds the CRC with its bits reversed */
+        crc ^= CRC_Reflect(crcConfig->crcXorOut, crcBits);
+
+        if (crcConfig->crcByteOrder == gCrcMSByteFirst)
+        {
+            crc = CRC_Reflect(crc, crcBits);
+        }
+    }
+    else
+    {
+        crc ^= crcConfig->crcXorOut << (32 - crcBits);
+
+        if (crcConfig->crcByteOrder == gCrcMSByteFirst)
+        {
+            crc = crc >> (32 - crcBits);
+        }
+        else
+        {
+            crc = CRC_Reflect(crc, 32);
+        }
+    }
+
+    return crc;
+}
@@ -20,6 +20,18 @@
 /*******************************************************************************
  * Definitions
  ******************************************************************************/
+
+/*! @brief Number of 256-entry tables used by the table-driven CRC, 1 or 4.
+ *  With 4 tables (slicing-by-4) four input bytes are processed per step, at the
+ *  cost of 3KB more RAM per handle. The handles are owned by the callers of
+ *  CRC_Init(), CRC_Compute() uses no table. */
+#ifndef gCrcTableSlices_c
+#define gCrcTableSlices_c 1
+#endif
+
+#if (gCrcTableSlices_c != 1) && (gCrcTableSlices_c != 4)
+#error "gCrcTableSlices_c must be 1 or 4"
+#endif
  
 /*! @brief crcRefIn bit definitions. */
 typedef enum _crcCfgCrcRefIn
@@ -54,6 +66,14 @@ typedef struct _CRC_config
     uint32_t crcPoly;  /*!< CRC Polynomial value. */
     uint32_t crcXorOut;  /*!< XOR mask for CRC result (for no mask, should be 0). */
 } CRC_config_t;
+
+/*! @brief Table-driven CRC handle, built from a CRC_config_t by CRC_Init(). */
+typedef struct _CRC_handle
+{
+    CRC_config_t config;  /*!< Configuration the tables were built for. */
+    bool_t reflected;  /*!< The register is processed LSB first. */
+    uint32_t table[gCrcTableSlices_c][256];  /*!< CRC of each byte value, then of each byte followed by 1..3 zero bytes. */
+} CRC_handle_t;
  
 /*******************************************************************************
  * API
@@ -71,7 +91,9 @@ extern "C" {
 /*!
  * @brief Software CRC function.
  *
- * The function computes the CRC.
+ * The function computes the CRC one byte at a time, without lookup tables, and
+ * is reentrant. Frequent or long computations should use a handle owned by the
+ * caller, see CRC_Init() and CRC_ComputeWithTable().
  *
  * @note The settings for software CRC are taken from the passed CRC_config_t structure.
  *
@@ -83,6 +105,80 @@ extern "C" {
  */
 uint32_t CRC_Compute(CRC_config_t crcConfig, uint8_t *dataIn, uint16_t length);
 
+/*!
+ * @brief Bitwise software CRC function.
+ *
+ * Reference implementation processing one bit at a time, without tables.
+ * Gives the same result as CRC_Compute().
+ *
+ * @param crcConfig configuration structure.
+ * @param dataIn input data buffer.
+ * @param length input data buffer size.
+ * 
+ * @retval computed CRC value.
+ */
+uint32_t CRC_ComputeBitwise(CRC_config_t crcConfig, uint8_t *dataIn, uint16_t length);
+
+/*!
+ * @brief Builds the lookup tables of a CRC handle.
+ *
+ * The input reflection is handled by building the tables for a register
+ * processed LSB first, so the input bytes are never reflected.
+ *
+ * @param handle CRC handle.
+ * @param crcConfig configuration structure.
+ */
+void CRC_Init(CRC_handle_t *handle, const CRC_config_t *crcConfig);
+
+/*!
+ * @brief Table-driven CRC function.
+ *
+ * Computes the CRC of a buffer, starting with the crcStartByte position.
+ *
+ * @param handle CRC handle, see CRC_Init().
+ * @param dataIn input data buffer.
+ * @param length input data buffer size.
+ * 
+ * @retval computed CRC value.
+ */
+uint32_t CRC_ComputeWithTable(const CRC_handle_t *handle, const uint8_t *dataIn, uint16_t length);
+
+/*!
+ * @brief Starts an incremental CRC computation.
+ *
+ * @param handle CRC handle, see CRC_Init().
+ * 
+ * @retval initial CRC register, to be passed to CRC_Update().
+ */
+uint32_t CRC_Begin(const CRC_handle_t *handle);
+
+/*!
+ * @brief Adds a segment of data to an incremental CRC computation.
+ *
+ * The crcStartByte setting is not applied, the caller passes only the bytes
+ * to be covered by the CRC.
+ *
+ * @param handle CRC handle, see CRC_Init().
+ * @param crc CRC register returned by CRC_Begin() or by the previous CRC_Update().
+ * @param dataIn input data segment.
+ * @param length input data segment size.
+ * 
+ * @retval updated CRC register.
+ */
+uint32_t CRC_Update(const CRC_handle_t *handle, uint32_t crc, const uint8_t *dataIn, uint32_t length);
+
+/*!
+ * @brief Ends an incremental CRC computation.
+ *
+ * Applies the XOR mask and the byte order to the CRC register.
+ *
+ * @param handle CRC handle, see CRC_Init().
+ * @param crc CRC register returned by the last CRC_Update().
+ * 
+ * @retval computed CRC value.
+ */
+uint32_t CRC_End(const CRC_handle_t *handle, uint32_t crc);
+
 /*! @} */
 
 #if defined(__cplusplus)
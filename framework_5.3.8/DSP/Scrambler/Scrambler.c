@@ -48,4 +48,113 @@ void Whiten(Whitener_config_t *whitenerConfig, uint8_t *pBuff, uint8_t buffLengt
             
         pBuff[i] = currentValue;
         }    
-}
\ No newline at end of file
+}
+
+whitenStatus_t Whiten_Init(Whitener_handle_t *handle, const Whitener_config_t *whitenerConfig)
+{
+    uint32_t size = whitenerConfig->whitenSize;
+    uint32_t mask = (1U << size) - 1;
+    uint32_t poly = whitenerConfig->whitenPoly & mask;
+    uint32_t state;
+    uint32_t key;
+    uint32_t i, j;
+
+    /* The tables hold gWhitenMaxStates_c states */
+    if (size > gWhitenMaxSize_c)
+    {
+        return gWhitenInvalidSize_c;
+    }
+
+    handle->config = *whitenerConfig;
+
+    for (i = 0; i <= mask; i++)
+    {
+        state = i;
+        key = 0;
+
+        /* Only the Galois LFSR whitens the data, see Whiten() */
+        if ((whitenerConfig->whitenPolyType == gGaloisPolyType) && (size != 0))
+        {
+            for (j = 0; j < 8; j++)
+            {
+                if (state & (1U << (size - 1)))
+                {
+                    state = ((state << 1) & mask) ^ poly;
+                    key |= (whitenerConfig->whitenRefIn == gWhitenRefInput) ? (0x80U >> j) : (0x1U << j);
+                }
+                else
+                {
+                    state = (state << 1) & mask;
+                }
+            }
+        }
+
+        handle->nextState[i] = (uint16_t)state;
+        handle->keyStream[i] = (uint8_t)key;
+    }
+
+    Whiten_SetSeed(handle, whitenerConfig->whitenInit);
+
+    return gWhitenSuccess_c;
+}
+
+void Whiten_SetSeed(Whitener_handle_t *handle, uint16_t seed)
+{
+    handle->seed = seed & ((1U << handle->config.whitenSize) - 1);
+    handle->state = handle->seed;
+}
+
+void Whiten_Frame(Whitener_handle_t *handle, uint8_t *pBuff, uint32_t buffLength)
+{
+    uint32_t start = handle->config.whitenStartOffset;
+    uint32_t end = handle->config.whitenEndOffset;
+
+    handle->state = handle->seed;
+
+    if (buffLength > start + end)
+    {
+        Whiten_Update(handle, &pBuff[start], buffLength - start - end);
+    }
+}
+
+void Whiten_Update(Whitener_handle_t *handle, uint8_t *pBuff, uint32_t length)
+{
+    uint32_t state = handle->state;
+    union
+    {
+        uint32_t word;
+        uint8_t bytes[4];
+    } key;
+
+    /* Byte by byte until the buffer is word aligned */
+    while (length && ((uintptr_t)pBuff & 0x03))
+    {
+        *pBuff++ ^= handle->keyStream[state];
+        state = handle->nextState[state];
+        length--;
+    }
+
+    while (length >= 4)
+    {
+        key.bytes[0] = handle->keyStream[state];
+        state = handle->nextState[state];
+        key.bytes[1] = handle->keyStream[state];
+        state = handle->nextState[state];
+        key.bytes[2] = handle->keyStream[state];
+        state = handle->nextState[state];
+        key.bytes[3] = handle->keyStream[state];
+        state = handle->nextState[state];
+
+        *(uint32_alias_t *)pBuff ^= key.word;
+        pBuff += 4;
+        length -= 4;
+    }
+
+    while (length--)
+    {
+        *pBuff++ ^= handle->keyStream[state];
+        state = handle->nextState[state];
+    }
+
+    handle->state = (uint16_t)state;
+}
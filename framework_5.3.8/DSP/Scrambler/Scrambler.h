@@ -21,6 +21,19 @@
  * Definitions
  ******************************************************************************/
 
+/*! @brief Maximum length of the whitener LFSR, in bits. */
+#define gWhitenMaxSize_c 9
+
+/*! @brief Number of states of the longest whitener LFSR. */
+#define gWhitenMaxStates_c (1U << gWhitenMaxSize_c)
+
+/*! @brief Whitener status. */
+typedef enum _whitenStatus
+{
+    gWhitenSuccess_c = 0U,  /*!< The handle was built. */
+    gWhitenInvalidSize_c = 1U  /*!< whitenSize is larger than gWhitenMaxSize_c. */
+} whitenStatus_t;
+
 /*! @brief whitenPolyType bit definitions. */
 typedef enum _whitenPolyType
 {
@@ -52,6 +65,16 @@ typedef struct _Whitener_config
     uint16_t whitenInit;  /*!< Initialization value for Whitening/De-whitening. Maximum 9 bits. */
     uint16_t whitenPoly;  /*!< Whitener polynomial. The polynomial value must be right-justified if smaller than 9-bits. Maximum 9 bits. */    
 } Whitener_config_t;
+
+/*! @brief Table-driven whitener handle, built from a Whitener_config_t by Whiten_Init(). */
+typedef struct _Whitener_handle
+{
+    Whitener_config_t config;  /*!< Configuration the tables were built for. */
+    uint16_t seed;  /*!< LFSR state at the start of a frame, right-justified. */
+    uint16_t state;  /*!< Current LFSR state, right-justified. */
+    uint16_t nextState[gWhitenMaxStates_c];  /*!< LFSR state 8 steps after each state. */
+    uint8_t keyStream[gWhitenMaxStates_c];  /*!< Whitening byte generated from each state. */
+} Whitener_handle_t;
  
 /*******************************************************************************
  * API
@@ -79,6 +102,58 @@ extern "C" {
  */
 void Whiten(Whitener_config_t *whitenerConfig, uint8_t *pBuff, uint8_t buffLength);
 
+/*!
+ * @brief Builds the whitening tables of a handle.
+ *
+ * Precomputes, for every LFSR state, the whitening byte it generates and the
+ * state 8 steps later, with the input reflection applied. The seed is set to
+ * whitenInit.
+ *
+ * @param handle whitener handle.
+ * @param whitenerConfig whitener configuration structure pointer. See "Whitener_config_t".
+ *
+ * @retval gWhitenSuccess_c, or gWhitenInvalidSize_c if whitenSize is larger than
+ *         gWhitenMaxSize_c, the handle is then not modified.
+ */
+whitenStatus_t Whiten_Init(Whitener_handle_t *handle, const Whitener_config_t *whitenerConfig);
+
+/*!
+ * @brief Sets the LFSR seed, for example from the channel number.
+ *
+ * @param handle whitener handle, see Whiten_Init().
+ * @param seed initial LFSR value, right-justified.
+ */
+void Whiten_SetSeed(Whitener_handle_t *handle, uint16_t seed);
+
+/*!
+ * @brief Table-driven whitening function.
+ *
+ * Whitens/de-whitens a frame, from whitenStartOffset to whitenEndOffset bytes
+ * before its end, starting the LFSR from the seed. Gives the same result as Whiten().
+ *
+ * @note This function will store the result in the input buffer.
+ *
+ * @param handle whitener handle, see Whiten_Init().
+ * @param pBuff buffer pointer.
+ * @param buffLength buffer length.
+ */
+void Whiten_Frame(Whitener_handle_t *handle, uint8_t *pBuff, uint32_t buffLength);
+
+/*!
+ * @brief Whitens/de-whitens the next fragment of a frame.
+ *
+ * All the bytes of the fragment are processed, 4 at a time when the buffer is
+ * word aligned. The LFSR state is kept in the handle for the next fragment.
+ * Call Whiten_SetSeed() before the first fragment of a frame.
+ *
+ * @note This function will store the result in the input buffer.
+ *
+ * @param handle whitener handle, see Whiten_Init().
+ * @param pBuff fragment pointer.
+ * @param length fragment length.
+ */
+void Whiten_Update(Whitener_handle_t *handle, uint8_t *pBuff, uint32_t length);
+
 /*! @} */
 
 #if defined(__cplusplus)
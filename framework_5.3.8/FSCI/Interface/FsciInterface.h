@@ -68,6 +68,30 @@
 #define gFsciUseFileDataLog_c     0 /* boolean */
 #endif
 
+#ifndef gFsciUseBinLog_c
+#define gFsciUseBinLog_c          0 /* boolean */
+#endif
+
+#ifndef gFsciBinLogRingSize_c
+#define gFsciBinLogRingSize_c     256 /* 32-bit words, power of 2 */
+#endif
+
+#ifndef gFsciBinLogMaxArgs_c
+#define gFsciBinLogMaxArgs_c      8 /* [0..16] */
+#endif
+
+#ifndef gFsciBinLogMeasureCost_c
+#define gFsciBinLogMeasureCost_c  0 /* boolean */
+#endif
+
+#ifndef gFsciBinLogTaskPriority_c
+#define gFsciBinLogTaskPriority_c 7
+#endif
+
+#ifndef gFsciBinLogTaskStackSize_c
+#define gFsciBinLogTaskStackSize_c 300
+#endif
+
 #ifndef gFsciTimestampSize_c
 #define gFsciTimestampSize_c      0 /* bytes */
 #endif
@@ -225,6 +249,18 @@ typedef struct{
     uint8_t               virtualInterface;
 } gFsciSerialConfig_t;
 
+/* Binary log statistics */
+typedef struct fsciBinLogStats_tag
+{
+    uint32_t records;      /* Records written to the ring */
+    uint32_t dropped;      /* Records lost: ring full, or no buffer for the frame */
+    uint32_t frames;       /* FSCI frames sent by the drain task */
+#if gFsciBinLogMeasureCost_c
+    uint32_t totalCycles;  /* Core clock cycles spent by the writers, all records */
+    uint32_t maxCycles;    /* Longest writer call, in core clock cycles */
+#endif
+} fsciBinLogStats_t;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -279,6 +315,43 @@ void FSCI_LogFormatedText (const char *fmt, ...);
 void FSCI_LogToFile (char *fileName, uint8_t *pData, uint16_t dataSize, uint8_t mode);
 #endif
 
+/*
+ * Binary logging. A record holds the address of the format string, the low 32 bits
+ * of TMR_GetTimestamp() and up to gFsciBinLogMaxArgs_c raw 32-bit arguments. Records
+ * are stored in a RAM ring and sent later by a low priority task, so no formatting
+ * is done on the target and interrupts are only masked to reserve ring space.
+ *
+ * Frames use opGroup gFSCI_LoggingOpcodeGroup_c, opCode 0x10. The payload starts with
+ * the total number of dropped records, followed by the records. All words are little
+ * endian:
+ *   word 0    : 0xB1000000 | number of arguments
+ *   word 1    : format string address, looked up by the host in the ELF file
+ *   word 2    : timestamp [us], low 32 bits
+ *   word 3... : arguments
+ * FSCI_LogFormatedText() records the formats whose arguments are all integers or
+ * pointers of at most 32 bits, the length modifiers being honored. The formats with
+ * %s, a floating point or a 64-bit argument are formatted on the target and sent as
+ * a text frame, opCode 0x01.
+ */
+#if gFsciUseBinLog_c
+void FSCI_BinLogInit(void);
+void FSCI_BinLogWrite(const char *fmt, uint32_t nArgs, uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3);
+void FSCI_BinLogDrain(void);
+void FSCI_BinLogGetStats(fsciBinLogStats_t *pStats);
+
+#define FSCI_BinLog0(fmt)                 FSCI_BinLogWrite((fmt), 0, 0, 0, 0, 0)
+#define FSCI_BinLog1(fmt, a0)             FSCI_BinLogWrite((fmt), 1, (uint32_t)(a0), 0, 0, 0)
+#define FSCI_BinLog2(fmt, a0, a1)         FSCI_BinLogWrite((fmt), 2, (uint32_t)(a0), (uint32_t)(a1), 0, 0)
+#define FSCI_BinLog3(fmt, a0, a1, a2)     FSCI_BinLogWrite((fmt), 3, (uint32_t)(a0), (uint32_t)(a1), (uint32_t)(a2), 0)
+#define FSCI_BinLog4(fmt, a0, a1, a2, a3) FSCI_BinLogWrite((fmt), 4, (uint32_t)(a0), (uint32_t)(a1), (uint32_t)(a2), (uint32_t)(a3))
+#else
+#define FSCI_BinLog0(fmt)
+#define FSCI_BinLog1(fmt, a0)
+#define FSCI_BinLog2(fmt, a0, a1)
+#define FSCI_BinLog3(fmt, a0, a1, a2)
+#define FSCI_BinLog4(fmt, a0, a1, a2, a3)
+#endif
+
 #ifdef __cplusplus
 }
 #endif
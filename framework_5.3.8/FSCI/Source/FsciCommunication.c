@@ -24,6 +24,7 @@
 #include "MemManager.h"
 #include "Panic.h"
 #include "TimersManager.h"
+#include "Profiler.h"
 
 #include "fsl_os_abstraction.h"
 
@@ -308,6 +309,8 @@ void FSCI_receivePacket( void* param )
         return;
     }
 
+    PROFILER_PROBE_START(mFsciRxProbe, "FSCI_receivePacket");
+
     while( readBytes )
     {
 #if gFsciRxTimeout_c
@@ -517,6 +520,8 @@ void FSCI_receivePacket( void* param )
 #endif        
     }
 #endif
+
+    PROFILER_PROBE_STOP(mFsciRxProbe);
 }
 
 /*! *********************************************************************************
@@ -24,8 +24,18 @@
 #include "MemManager.h"
 #include "SerialManager.h"
 
+#if gFsciUseBinLog_c
+#include "fsl_os_abstraction.h"
+#include "TimersManager.h"
+#include "Panic.h"
+#if gFsciBinLogMeasureCost_c
+#include "fsl_device_registers.h"
+#endif
+#endif
+
 #include <stdio.h>
 #include <stdarg.h>
+#include <stddef.h>
 #include <string.h>
 
 #if gFsciIncluded_c
@@ -39,6 +49,34 @@
                             gFsciTimestampSize_c - 1)
 #define gFsciFileLogSize_c 220
 
+#if gFsciUseBinLog_c
+#define mFsciBinLogOpCode_c       (0x10)
+#define mFsciBinLogMask_c         (gFsciBinLogRingSize_c - 1)
+#define mFsciBinLogHdrWords_c     (3) /* header, format string, timestamp */
+#define mFsciBinLogCommit_c       (0xB1000000) /* header of a written record */
+#define mFsciBinLogCommitMask_c   (0xFF000000)
+#define mFsciBinLogArgsMask_c     (0x000000FF)
+#define mFsciBinLogEvent_c        (1 << 0)
+/* Returned by FSCI_BinLogGetArgs() when the text is formatted on the target */
+#define mFsciBinLogUseText_c      (gFsciBinLogMaxArgs_c + 1)
+
+#if (gFsciBinLogRingSize_c & mFsciBinLogMask_c) || (gFsciBinLogRingSize_c == 0)
+#error "gFsciBinLogRingSize_c must be a power of 2"
+#endif
+
+#if (gFsciBinLogMaxArgs_c > 16) || \
+    (gFsciBinLogRingSize_c < (mFsciBinLogHdrWords_c + gFsciBinLogMaxArgs_c))
+#error "gFsciBinLogMaxArgs_c is too large"
+#endif
+
+#if gFsciBinLogMeasureCost_c
+/* SysTick counts core clock cycles down to 0, then reloads */
+#define mFsciBinLogCycles_d()     (SysTick->VAL)
+#define mFsciBinLogElapsed_d(start, end) \
+    (((start) >= (end)) ? ((start) - (end)) : ((start) + SysTick->LOAD + 1 - (end)))
+#endif
+#endif /* gFsciUseBinLog_c */
+
 
 /************************************************************************************
 *************************************************************************************
@@ -48,6 +86,30 @@
 
 extern uint8_t gFsciTxDisable;
 
+#if gFsciUseFmtLog_c
+static void FSCI_LogText(const char *fmt, va_list argp);
+#endif
+
+#if gFsciUseBinLog_c
+extern const uint8_t gUseRtos_c;
+
+/* Records are reserved at mFsciBinLogHead and sent from mFsciBinLogTail. Both are
+   free running word counters. */
+static volatile uint32_t mFsciBinLogRing[gFsciBinLogRingSize_c];
+static volatile uint32_t mFsciBinLogHead;
+static volatile uint32_t mFsciBinLogTail;
+static fsciBinLogStats_t mFsciBinLogStats;
+static osaEventId_t mFsciBinLogEventId;
+
+static void FSCI_BinLogPut(const char *fmt, uint32_t nArgs, const uint32_t *pArgs);
+#if gFsciUseFmtLog_c
+static uint32_t FSCI_BinLogGetArgs(const char *fmt, va_list argp, uint32_t *pArgs);
+#endif
+static void FSCI_BinLogSend(clientPacket_t *pPacket, uint16_t len);
+static void FSCI_BinLogTask(osaTaskParam_t param);
+OSA_TASK_DEFINE(FSCI_BinLogTask, gFsciBinLogTaskPriority_c, 1, gFsciBinLogTaskStackSize_c, FALSE);
+#endif
+
 
 /************************************************************************************
 *************************************************************************************
@@ -120,53 +182,40 @@ void FSCI_Print (uint8_t readyToSend, void *pSrc, fsciLen_t len)
 * \param[in] const char *fmt - The string and format specifiers to output to the datalog.
 * \param[in] ... - The variable number of parameters to output to the datalog.
 *
-* \remarks Behaves like printf
+* \remarks Behaves like printf. With gFsciUseBinLog_c enabled, the arguments are
+*          stored in the binary log and the text is formatted by the host, if they
+*          are all integers of at most 32 bits. The formats with a string, a floating
+*          point or a 64-bit argument, or more than gFsciBinLogMaxArgs_c arguments,
+*          are formatted on the target and sent at once, before the pending records.
 *
 ********************************************************************************** */
 #if gFsciUseFmtLog_c
 void FSCI_LogFormatedText (const char *fmt, ...)
 {
-    clientPacket_t *pFsciData;
-    uint16_t length;
+#if gFsciUseBinLog_c
+    uint32_t args[gFsciBinLogMaxArgs_c];
+    uint32_t nArgs;
+#endif
     va_list argp;
 
     if (gFsciTxDisable)
         return;
 
-    pFsciData = MEM_BufferAlloc(sizeof(clientPacket_t));
-    if (NULL == pFsciData) {
-        FSCI_Error(gFsciOutOfMessages_c, gFsciLoggingInterface_c);
-        return;
-    }
-
-    pFsciData->structured.header.opGroup = gFSCI_LoggingOpcodeGroup_c;
-    pFsciData->structured.header.opCode = 0x01;
-
-#if gFsciTimestampSize_c
-    *((uint64_t*)pFsciData->structured.payload) = TimerGetAbsoluteTime();
-#endif
-
-    OSA_InterruptDisable();
+#if gFsciUseBinLog_c
     va_start(argp, fmt);
-    length = vsnprintf((char*)(&pFsciData->structured.payload[gFsciTimestampSize_c]), gFsciTextLogSize_c, fmt, argp);
+    nArgs = FSCI_BinLogGetArgs(fmt, argp, args);
     va_end(argp);
-    OSA_InterruptEnable();
 
-    if(length >= gFsciTextLogSize_c)
+    if( nArgs != mFsciBinLogUseText_c )
     {
-        pFsciData->structured.payload[gFsciTextLogSize_c-6] = '.';
-        pFsciData->structured.payload[gFsciTextLogSize_c-5] = '.';
-        pFsciData->structured.payload[gFsciTextLogSize_c-4] = '.';
-        pFsciData->structured.payload[gFsciTextLogSize_c-3] = '\n';
-        pFsciData->structured.payload[gFsciTextLogSize_c-2] = '\r';
-        pFsciData->structured.payload[gFsciTextLogSize_c-1] = '\0';
-        length = gFsciTextLogSize_c-1;
+        FSCI_BinLogPut(fmt, nArgs, args);
+        return;
     }
+#endif
 
-    /* Compute total payload len */
-    pFsciData->structured.header.len = length + gFsciTimestampSize_c;
-
-    FSCI_transmitFormatedPacket( pFsciData, gFsciLoggingInterface_c );
+    va_start(argp, fmt);
+    FSCI_LogText(fmt, argp);
+    va_end(argp);
 }
 #endif /* gFsciUseFmtLog_c */
 
@@ -260,4 +309,434 @@ void FSCI_LogToFile (char *fileName, uint8_t *pData, uint16_t dataSize, uint8_t
 }
 #endif /* gFsciUseFileDataLog_c */
 
+#if gFsciUseBinLog_c
+/*! *********************************************************************************
+* \brief   Creates the task which sends the binary log records to the host.
+*
+********************************************************************************** */
+void FSCI_BinLogInit(void)
+{
+    if( NULL != mFsciBinLogEventId )
+    {
+        return;
+    }
+
+    mFsciBinLogEventId = OSA_EventCreate(TRUE);
+    if( NULL == mFsciBinLogEventId )
+    {
+        panic(0, (uint32_t)FSCI_BinLogInit, 0, 0);
+        return;
+    }
+
+    if( NULL == OSA_TaskCreate(OSA_TASK(FSCI_BinLogTask), NULL) )
+    {
+        panic(0, (uint32_t)FSCI_BinLogInit, 0, 0);
+    }
+}
+
+/*! *********************************************************************************
+* \brief   Adds a record to the binary log. Can be called from any context,
+*          including interrupts. Use the FSCI_BinLogN() macros instead.
+*
+* \param[in] fmt - The format string. Must be a constant, only its address is stored.
+* \param[in] nArgs - The number of arguments, [0..4].
+* \param[in] a0..a3 - The arguments.
+*
+********************************************************************************** */
+void FSCI_BinLogWrite(const char *fmt, uint32_t nArgs, uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3)
+{
+    uint32_t args[4];
+
+    args[0] = a0;
+    args[1] = a1;
+    args[2] = a2;
+    args[3] = a3;
+
+    FSCI_BinLogPut(fmt, (nArgs > 4) ? 4 : nArgs, args);
+}
+
+/*! *********************************************************************************
+* \brief   Sends the records of the binary log to the host, in as few FSCI frames
+*          as possible. Called by the binary log task, but can also be called
+*          directly, for example before a reset. Must not run in more than one
+*          context at the same time.
+*
+********************************************************************************** */
+void FSCI_BinLogDrain(void)
+{
+    clientPacket_t *pPacket = NULL;
+    uint32_t tail = mFsciBinLogTail;
+    uint32_t header;
+    uint32_t word;
+    uint32_t nWords;
+    uint32_t i;
+    uint16_t len = 0;
+
+    while( tail != mFsciBinLogHead )
+    {
+        header = mFsciBinLogRing[tail & mFsciBinLogMask_c];
+
+        /* The record was reserved, but its writer was interrupted. It will signal
+           the task when it is done. */
+        if( (header & mFsciBinLogCommitMask_c) != mFsciBinLogCommit_c )
+        {
+            break;
+        }
+
+        nWords = mFsciBinLogHdrWords_c + (header & mFsciBinLogArgsMask_c);
+
+        if( (NULL != pPacket) && (len + nWords * sizeof(uint32_t) > gFsciMaxPayloadLen_c) )
+        {
+            FSCI_BinLogSend(pPacket, len);
+            pPacket = NULL;
+        }
+
+        if( NULL == pPacket )
+        {
+            pPacket = MEM_BufferAlloc(sizeof(clientPacket_t));
+
+            if( NULL == pPacket )
+            {
+                /* Discard the record, so that the writers can continue */
+                OSA_InterruptDisable();
+                mFsciBinLogStats.dropped++;
+                OSA_InterruptEnable();
+
+                tail += nWords;
+                mFsciBinLogTail = tail;
+                continue;
+            }
+
+            pPacket->structured.header.opGroup = gFSCI_LoggingOpcodeGroup_c;
+            pPacket->structured.header.opCode = mFsciBinLogOpCode_c;
+            /* The number of dropped records is written when the frame is sent */
+            len = sizeof(uint32_t);
+        }
+
+        for( i = 0; i < nWords; i++ )
+        {
+            word = mFsciBinLogRing[(tail + i) & mFsciBinLogMask_c];
+            FLib_MemCpy(&pPacket->structured.payload[len], &word, sizeof(word));
+            len += sizeof(word);
+        }
+
+        /* Release the ring space */
+        tail += nWords;
+        mFsciBinLogTail = tail;
+    }
+
+    if( NULL != pPacket )
+    {
+        FSCI_BinLogSend(pPacket, len);
+    }
+}
+
+/*! *********************************************************************************
+* \brief   Returns the binary log statistics.
+*
+* \param[out] pStats - Pointer to the location where the statistics are copied.
+*
+********************************************************************************** */
+void FSCI_BinLogGetStats(fsciBinLogStats_t *pStats)
+{
+    OSA_InterruptDisable();
+    FLib_MemCpy(pStats, &mFsciBinLogStats, sizeof(fsciBinLogStats_t));
+    OSA_InterruptEnable();
+}
+#endif /* gFsciUseBinLog_c */
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+
+#if gFsciUseFmtLog_c
+/*! *********************************************************************************
+* \brief   Formats a text log on the target, and sends it to the host.
+*
+* \param[in] fmt - The string and format specifiers.
+* \param[in] argp - The arguments.
+*
+********************************************************************************** */
+static void FSCI_LogText(const char *fmt, va_list argp)
+{
+    clientPacket_t *pFsciData;
+    uint16_t length;
+
+    pFsciData = MEM_BufferAlloc(sizeof(clientPacket_t));
+    if (NULL == pFsciData) {
+        FSCI_Error(gFsciOutOfMessages_c, gFsciLoggingInterface_c);
+        return;
+    }
+
+    pFsciData->structured.header.opGroup = gFSCI_LoggingOpcodeGroup_c;
+    pFsciData->structured.header.opCode = 0x01;
+
+#if gFsciTimestampSize_c
+    *((uint64_t*)pFsciData->structured.payload) = TimerGetAbsoluteTime();
+#endif
+
+    OSA_InterruptDisable();
+    length = vsnprintf((char*)(&pFsciData->structured.payload[gFsciTimestampSize_c]), gFsciTextLogSize_c, fmt, argp);
+    OSA_InterruptEnable();
+
+    if(length >= gFsciTextLogSize_c)
+    {
+        pFsciData->structured.payload[gFsciTextLogSize_c-6] = '.';
+        pFsciData->structured.payload[gFsciTextLogSize_c-5] = '.';
+        pFsciData->structured.payload[gFsciTextLogSize_c-4] = '.';
+        pFsciData->structured.payload[gFsciTextLogSize_c-3] = '\n';
+        pFsciData->structured.payload[gFsciTextLogSize_c-2] = '\r';
+        pFsciData->structured.payload[gFsciTextLogSize_c-1] = '\0';
+        length = gFsciTextLogSize_c-1;
+    }
+
+    /* Compute total payload len */
+    pFsciData->structured.header.len = length + gFsciTimestampSize_c;
+
+    FSCI_transmitFormatedPacket( pFsciData, gFsciLoggingInterface_c );
+}
+#endif /* gFsciUseFmtLog_c */
+
+#if gFsciUseBinLog_c
+/*! *********************************************************************************
+* \brief   Stores a record in the binary log ring. Interrupts are only disabled while
+*          the space is reserved. The header is written last, so the drain task never
+*          sends a record which is still being written by an interrupted context.
+*
+* \param[in] fmt - The format string.
+* \param[in] nArgs - The number of arguments.
+* \param[in] pArgs - The arguments.
+*
+********************************************************************************** */
+static void FSCI_BinLogPut(const char *fmt, uint32_t nArgs, const uint32_t *pArgs)
+{
+#if gFsciBinLogMeasureCost_c
+    uint32_t start = mFsciBinLogCycles_d();
+    uint32_t cycles;
+#endif
+    uint32_t timestamp = (uint32_t)TMR_GetTimestamp();
+    uint32_t nWords = mFsciBinLogHdrWords_c + nArgs;
+    uint32_t idx;
+    uint32_t i;
+
+    OSA_InterruptDisable();
+
+    if( (mFsciBinLogHead - mFsciBinLogTail) > (gFsciBinLogRingSize_c - nWords) )
+    {
+        mFsciBinLogStats.dropped++;
+        OSA_InterruptEnable();
+        return;
+    }
+
+    idx = mFsciBinLogHead;
+    mFsciBinLogRing[idx & mFsciBinLogMask_c] = 0;
+    mFsciBinLogHead = idx + nWords;
+    mFsciBinLogStats.records++;
+
+    OSA_InterruptEnable();
+
+    mFsciBinLogRing[(idx + 1) & mFsciBinLogMask_c] = (uint32_t)fmt;
+    mFsciBinLogRing[(idx + 2) & mFsciBinLogMask_c] = timestamp;
+
+    for( i = 0; i < nArgs; i++ )
+    {
+        mFsciBinLogRing[(idx + mFsciBinLogHdrWords_c + i) & mFsciBinLogMask_c] = pArgs[i];
+    }
+
+    mFsciBinLogRing[idx & mFsciBinLogMask_c] = mFsciBinLogCommit_c | nArgs;
+
+    /* The task has sent all the records before this one, and may be waiting for it */
+    if( (mFsciBinLogTail == idx) && (NULL != mFsciBinLogEventId) )
+    {
+        (void)OSA_EventSet(mFsciBinLogEventId, mFsciBinLogEvent_c);
+    }
+
+#if gFsciBinLogMeasureCost_c
+    cycles = mFsciBinLogElapsed_d(start, mFsciBinLogCycles_d());
+
+    OSA_InterruptDisable();
+    mFsciBinLogStats.totalCycles += cycles;
+    if( cycles > mFsciBinLogStats.maxCycles )
+    {
+        mFsciBinLogStats.maxCycles = cycles;
+    }
+    OSA_InterruptEnable();
+#endif
+}
+
+#if gFsciUseFmtLog_c
+/*! *********************************************************************************
+* \brief   Reads the arguments of a printf format into the words of a record. The
+*          length modifiers select the type read, so that the next arguments are
+*          found, also in the formats which cannot be recorded.
+*
+* \param[in] fmt - The format string.
+* \param[in] argp - The arguments.
+* \param[out] pArgs - The arguments, one word each.
+*
+* \return  The number of arguments, or mFsciBinLogUseText_c if an argument is a
+*          string, a floating point or does not fit 32 bits, or if there are more than
+*          gFsciBinLogMaxArgs_c: the text must then be formatted on the target.
+*
+********************************************************************************** */
+static uint32_t FSCI_BinLogGetArgs(const char *fmt, va_list argp, uint32_t *pArgs)
+{
+    uint32_t nArgs = 0;
+    uint32_t size;
+    char length;
+
+    while( *fmt )
+    {
+        if( '%' != *fmt++ )
+        {
+            continue;
+        }
+
+        if( '%' == *fmt )
+        {
+            fmt++;
+            continue;
+        }
+
+        /* Flags, width and precision. A '*' takes an int argument. */
+        while( (*fmt != '\0') && (NULL != strchr("-+ #0123456789.*", *fmt)) )
+        {
+            if( '*' == *fmt )
+            {
+                if( nArgs == gFsciBinLogMaxArgs_c )
+                {
+                    return mFsciBinLogUseText_c;
+                }
+                pArgs[nArgs++] = (uint32_t)va_arg(argp, int);
+            }
+            fmt++;
+        }
+
+        /* Length modifier. The char and short arguments are promoted to int. */
+        length = *fmt;
+        switch( length )
+        {
+        case 'h':
+            fmt += ('h' == fmt[1]) ? 2 : 1;
+            size = sizeof(int);
+            break;
+        case 'l':
+            if( 'l' == fmt[1] )
+            {
+                return mFsciBinLogUseText_c;
+            }
+            fmt++;
+            size = sizeof(long);
+            break;
+        case 'z':
+            fmt++;
+            size = sizeof(size_t);
+            break;
+        case 't':
+            fmt++;
+            size = sizeof(ptrdiff_t);
+            break;
+        case 'j':
+        case 'L':
+            return mFsciBinLogUseText_c;
+        default:
+            size = sizeof(int);
+            break;
+        }
+
+        switch( *fmt++ )
+        {
+        case 'd':
+        case 'i':
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+        case 'c':
+            break;
+        case 'p':
+            length = 'p';
+            size = sizeof(void*);
+            break;
+        default:
+            /* A string, a floating point, %n or an invalid conversion */
+            return mFsciBinLogUseText_c;
+        }
+
+        if( (size > sizeof(uint32_t)) || (nArgs == gFsciBinLogMaxArgs_c) )
+        {
+            return mFsciBinLogUseText_c;
+        }
+
+        switch( length )
+        {
+        case 'l':
+            pArgs[nArgs++] = (uint32_t)va_arg(argp, long);
+            break;
+        case 'z':
+            pArgs[nArgs++] = (uint32_t)va_arg(argp, size_t);
+            break;
+        case 't':
+            pArgs[nArgs++] = (uint32_t)va_arg(argp, ptrdiff_t);
+            break;
+        case 'p':
+            pArgs[nArgs++] = (uint32_t)(uintptr_t)va_arg(argp, void*);
+            break;
+        default:
+            pArgs[nArgs++] = (uint32_t)va_arg(argp, int);
+            break;
+        }
+    }
+
+    return nArgs;
+}
+#endif /* gFsciUseFmtLog_c */
+
+/*! *********************************************************************************
+* \brief   Sends a binary log frame.
+*
+* \param[in] pPacket - The frame, with the records already copied.
+* \param[in] len - The payload length.
+*
+********************************************************************************** */
+static void FSCI_BinLogSend(clientPacket_t *pPacket, uint16_t len)
+{
+    uint32_t dropped = mFsciBinLogStats.dropped;
+
+    FLib_MemCpy(pPacket->structured.payload, &dropped, sizeof(dropped));
+    pPacket->structured.header.len = len;
+    mFsciBinLogStats.frames++;
+
+    FSCI_transmitFormatedPacket(pPacket, gFsciLoggingInterface_c);
+}
+
+/*! *********************************************************************************
+* \brief   Binary log task. Sends the records when signaled by a writer.
+*
+* \param[in] param - Not used.
+*
+********************************************************************************** */
+static void FSCI_BinLogTask(osaTaskParam_t param)
+{
+    osaEventFlags_t ev;
+
+    (void)param;
+
+    while(1)
+    {
+        (void)OSA_EventWait(mFsciBinLogEventId, osaEventFlagsAll_c, FALSE, osaWaitForever_c, &ev);
+
+        FSCI_BinLogDrain();
+
+        /* For BareMetal break the while(1) after 1 run */
+        if (gUseRtos_c == 0)
+        {
+            break;
+        }
+    }
+}
+#endif /* gFsciUseBinLog_c */
+
 #endif /* gFsciIncluded_c */
@@ -71,6 +71,10 @@ void FSCI_Init( void* argument  )
 {
     /* Initialize the communication interface */
     FSCI_commInit( argument );
+
+#if gFsciUseBinLog_c
+    FSCI_BinLogInit();
+#endif
 }
 
 /*! *********************************************************************************
@@ -25,12 +25,17 @@
 * Private macros
 *************************************************************************************
 ********************************************************************************** */
+/* Buffers shorter than this are processed byte by byte */
+#define mFLibWordThreshold_c    (8)
+
+#define mFLibAlignOffset_d(p)   ((uintptr_t)(p) & 0x03U)
 
 /*! *********************************************************************************
 *************************************************************************************
 * Private prototypes
 *************************************************************************************
 ********************************************************************************** */
+static void FLib_CopyForward(uint8_t* pDst, const uint8_t* pSrc, uint32_t cBytes);
 
 /*! *********************************************************************************
 *************************************************************************************
@@ -81,6 +86,8 @@ void FLib_MemCpy (void* pDst,
     
 #if gUseToolchainMemFunc_d
     memcpy(pDst, pSrc, cBytes);
+#elif gFLib_WordAccess_d
+    FLib_CopyForward((uint8_t*)pDst, (uint8_t*)pSrc, cBytes);
 #else
     while (cBytes)
     {
@@ -114,75 +121,11 @@ void FLib_MemCpyAligned32bit (void* to_ptr,
                               void* from_ptr,                              
                               register uint32_t number_of_bytes)
 {
-    uint8_t*    from8_ptr = (uint8_t*)from_ptr;
-    uint8_t*    to8_ptr = (uint8_t*)to_ptr;
-    uint16_t*   from16_ptr = (uint16_t*)from_ptr;
-    uint16_t*   to16_ptr = (uint16_t*)to_ptr;
-    register    uint32_t* from32_ptr = (uint32_t*)from_ptr;
-    register    uint32_t* to32_ptr = (uint32_t*)to_ptr;
-
-    register    uint32_t loops;
-    
 #if gFLib_CheckBufferOverflow_d && defined(MEM_TRACKING)
     (void)MEM_BufferCheck(to_ptr, number_of_bytes);
 #endif
 
-    if (number_of_bytes > 3)
-    {
-        /* Try to align source on word */
-        if ((uint32_t)from_ptr & 1)
-        {
-            from8_ptr = (uint8_t*)from_ptr;
-            to8_ptr = (uint8_t*)to_ptr;
-
-            *to8_ptr++ = *from8_ptr++;
-
-            from_ptr = from8_ptr;
-            to_ptr = to8_ptr;
-            --number_of_bytes;
-        }
-
-        /* Try to align source on longword */
-        if ((uint32_t)from_ptr & 2)
-        {
-            from16_ptr = (uint16_t*)from_ptr;
-            to16_ptr = (uint16_t*)to_ptr;
-
-            *to16_ptr++ = *from16_ptr++;
-
-            from_ptr = from16_ptr;
-            to_ptr = to16_ptr;
-            number_of_bytes -= 2;
-        }
-
-        from32_ptr = (uint32_t*)from_ptr;
-        to32_ptr = (uint32_t*)to_ptr;
-
-        for (loops = number_of_bytes >> 2; loops != 0; loops--)
-        {
-            *to32_ptr++ = *from32_ptr++;
-        }
-
-        from_ptr = from32_ptr;
-        to_ptr = to32_ptr;
-    }
-
-    /* Copy all remaining bytes */
-    if (number_of_bytes & 2)
-    {
-        from16_ptr = (uint16_t*)from_ptr;
-        to16_ptr = (uint16_t*)to_ptr;
-
-        *to16_ptr++ = *from16_ptr++;
-
-        from_ptr = from16_ptr;
-        to_ptr = to16_ptr;
-    }
-
-    if (number_of_bytes & 1)
-    {
-        *(uint8_t*)to_ptr = *(uint8_t*)from_ptr;
-    }
+    FLib_CopyForward((uint8_t*)to_ptr, (uint8_t*)from_ptr, number_of_bytes);
 }
 
 
@@ -240,9 +183,33 @@ void FLib_MemCpyReverseOrder (void* pDst,
                               void* pSrc,
                               uint32_t cBytes)
 {
+#if gFLib_WordAccess_d
+    uint8_t* pTo = (uint8_t*)pDst + cBytes;
+    uint8_t* pFrom = (uint8_t*)pSrc;
+#endif
+
 #if gFLib_CheckBufferOverflow_d && defined(MEM_TRACKING)
     (void)MEM_BufferCheck(pDst, cBytes);
 #endif
+#if gFLib_WordAccess_d
+    /* Four bytes per iteration, for addresses and keys */
+    while (cBytes >= 4)
+    {
+        pTo -= 4;
+        pTo[3] = pFrom[0];
+        pTo[2] = pFrom[1];
+        pTo[1] = pFrom[2];
+        pTo[0] = pFrom[3];
+        pFrom += 4;
+        cBytes -= 4;
+    }
+
+    while (cBytes)
+    {
+        *--pTo = *pFrom++;
+        cBytes--;
+    }
+#else
     if(cBytes)
     {
         pDst = (uint8_t*)pDst + (uint32_t)(cBytes-1);
@@ -254,6 +221,7 @@ void FLib_MemCpyReverseOrder (void* pDst,
             cBytes--;
         }
     }
+#endif
 }
 
 
@@ -285,6 +253,37 @@ bool_t FLib_MemCmp (void* pData1,    /* IN: First memory block to compare */
         status = FALSE;
     }
 #else
+#if gFLib_WordAccess_d
+    if ((cBytes >= mFLibWordThreshold_c) &&
+        (mFLibAlignOffset_d(pData1) == mFLibAlignOffset_d(pData2)))
+    {
+        while (mFLibAlignOffset_d(pData1))
+        {
+            if ( *((uint8_t *)pData1) != *((uint8_t *)pData2))
+            {
+                return FALSE;
+            }
+
+            pData2 = (uint8_t* )pData2+1;
+            pData1 = (uint8_t* )pData1+1;
+            cBytes--;
+        }
+
+        /* Stop at the first word which differs */
+        while (cBytes >= 4)
+        {
+            if ( *((uint32_alias_t *)pData1) != *((uint32_alias_t *)pData2))
+            {
+                return FALSE;
+            }
+
+            pData2 = (uint8_t* )pData2+4;
+            pData1 = (uint8_t* )pData1+4;
+            cBytes -= 4;
+        }
+    }
+
+#endif
     while (cBytes)
     {
         if ( *((uint8_t *)pData1) != *((uint8_t *)pData2))
@@ -324,6 +323,35 @@ bool_t FLib_MemCmpToVal
     uint32_t len
 )
 {
+#if gFLib_WordAccess_d
+    uint32_t val32 = val * 0x01010101U;
+
+    if (len >= mFLibWordThreshold_c)
+    {
+        while (mFLibAlignOffset_d(pAddr))
+        {
+            if (*((uint8_t *)pAddr) != val)
+            {
+                return FALSE;
+            }
+
+            pAddr = (uint8_t *)pAddr + 1;
+            len--;
+        }
+
+        while (len >= 4)
+        {
+            if (*((uint32_alias_t *)pAddr) != val32)
+            {
+                return FALSE;
+            }
+
+            pAddr = (uint8_t *)pAddr + 4;
+            len -= 4;
+        }
+    }
+
+#endif
     while(len)
     {
         len--;
@@ -361,6 +389,42 @@ void FLib_MemSet (void* pData,
 #if gUseToolchainMemFunc_d
     memset(pData, value, cBytes);
 #else
+#if gFLib_WordAccess_d
+    if (cBytes >= mFLibWordThreshold_c)
+    {
+        uint32_alias_t* pData32;
+        uint32_t value32;
+
+        while (mFLibAlignOffset_d(pData))
+        {
+            *((uint8_t* )pData) = value;
+            pData = (uint8_t* )pData + 1;
+            cBytes--;
+        }
+
+        value32 = value * 0x01010101U;
+        pData32 = (uint32_alias_t* )pData;
+
+        while (cBytes >= 16)
+        {
+            pData32[0] = value32;
+            pData32[1] = value32;
+            pData32[2] = value32;
+            pData32[3] = value32;
+            pData32 += 4;
+            cBytes -= 16;
+        }
+
+        while (cBytes >= 4)
+        {
+            *pData32++ = value32;
+            cBytes -= 4;
+        }
+
+        pData = pData32;
+    }
+
+#endif
     while (cBytes)
     {
         ((uint8_t* )pData)[--cBytes] = value;
@@ -532,3 +596,91 @@ uint32_t FLib_StrLen(char *str)
     return len;
 #endif
 }
+
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+********************************************************************************** */
+
+/*! *********************************************************************************
+* \brief  Copies bytes forward using 32-bit accesses. The destination is aligned
+*         first. If the source has a different alignment, each destination word is
+*         built from two aligned source words, since the Cortex-M0+ does not support
+*         unaligned accesses. This assumes a little endian core.
+*
+* \param[in, out]  pDst Pointer to the destination buffer.
+*
+* \param[in]  pSrc Pointer to the source buffer.
+*
+* \param[in]  cBytes Number of bytes to copy.
+*
+********************************************************************************** */
+static void FLib_CopyForward(uint8_t* pDst, const uint8_t* pSrc, uint32_t cBytes)
+{
+    uint32_alias_t* pDst32;
+    const uint32_alias_t* pSrc32;
+    uint32_t shift;
+    uint32_t prev;
+    uint32_t next;
+
+    if (cBytes >= mFLibWordThreshold_c)
+    {
+        while (mFLibAlignOffset_d(pDst))
+        {
+            *pDst++ = *pSrc++;
+            cBytes--;
+        }
+
+        pDst32 = (uint32_alias_t*)pDst;
+        shift = mFLibAlignOffset_d(pSrc) * 8;
+
+        if (shift == 0)
+        {
+            pSrc32 = (const uint32_alias_t*)pSrc;
+
+            while (cBytes >= 16)
+            {
+                pDst32[0] = pSrc32[0];
+                pDst32[1] = pSrc32[1];
+                pDst32[2] = pSrc32[2];
+                pDst32[3] = pSrc32[3];
+                pDst32 += 4;
+                pSrc32 += 4;
+                cBytes -= 16;
+            }
+
+            while (cBytes >= 4)
+            {
+                *pDst32++ = *pSrc32++;
+                cBytes -= 4;
+            }
+
+            pSrc = (const uint8_t*)pSrc32;
+        }
+        else
+        {
+            /* Only the words holding source bytes are read */
+            pSrc32 = (const uint32_alias_t*)(pSrc - mFLibAlignOffset_d(pSrc));
+            prev = *pSrc32++;
+
+            while (cBytes >= 4)
+            {
+                next = *pSrc32++;
+                *pDst32++ = (prev >> shift) | (next << (32 - shift));
+                prev = next;
+                pSrc += 4;
+                cBytes -= 4;
+            }
+        }
+
+        pDst = (uint8_t*)pDst32;
+    }
+
+    while (cBytes)
+    {
+        *pDst++ = *pSrc++;
+        cBytes--;
+    }
+}
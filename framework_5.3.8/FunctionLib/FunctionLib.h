@@ -29,6 +29,11 @@
 #define gFLib_CheckBufferOverflow_d 0
 #endif
 
+/* Use 32-bit accesses in the memory functions when the toolchain functions are not used */
+#ifndef gFLib_WordAccess_d
+#define gFLib_WordAccess_d 1
+#endif
+
 #define FLib_MemSet16 FLib_MemSet
 
 /*! *********************************************************************************
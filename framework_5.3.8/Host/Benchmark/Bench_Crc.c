@@ -0,0 +1,117 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Host benchmarks of the CRC engine: the bitwise reference, CRC_Compute(), which
+* uses no table, and the table-driven functions with a handle owned by the caller,
+* for a 16 and a 32 bit CRC. framework_crc4_bench runs them with the slicing-by-4
+* tables.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include "HostBench.h"
+#include "CRC.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+********************************************************************************** */
+#define mBenchCrcDataSize_c     (256)
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+********************************************************************************** */
+typedef struct benchCrc_tag
+{
+    CRC_config_t config;
+    CRC_handle_t handle;
+} benchCrc_t;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+********************************************************************************** */
+static void Bench_CrcBitwise(void* param);
+static void Bench_CrcCompute(void* param);
+static void Bench_CrcTable(void* param);
+static void Bench_CrcInit(void* param);
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+********************************************************************************** */
+static uint8_t mBenchCrcData[mBenchCrcDataSize_c];
+static volatile uint32_t mBenchCrcResult;
+
+static benchCrc_t mBenchCrc32 =
+{
+    .config = {4, 0, gCrcInputNoRef, gCrcOutputNoRef, gCrcLSByteFirst, 0xFFFFFFFF, 0x04C11DB7, 0xFFFFFFFF}
+};
+
+static benchCrc_t mBenchCrc16 =
+{
+    .config = {2, 0, gCrcRefInput, gCrcOutputNoRef, gCrcMSByteFirst, 0xFFFF, 0x1021, 0x0000}
+};
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+void Bench_Crc(void)
+{
+    uint32_t i;
+
+    for( i = 0; i < mBenchCrcDataSize_c; i++ )
+    {
+        mBenchCrcData[i] = (uint8_t)i;
+    }
+    CRC_Init(&mBenchCrc32.handle, &mBenchCrc32.config);
+    CRC_Init(&mBenchCrc16.handle, &mBenchCrc16.config);
+
+    (void)HostBench_Run("CRC-32 bitwise, 256 B",       Bench_CrcBitwise, &mBenchCrc32, mBenchCrcDataSize_c);
+    (void)HostBench_Run("CRC-32 CRC_Compute, 256 B",   Bench_CrcCompute, &mBenchCrc32, mBenchCrcDataSize_c);
+    (void)HostBench_Run("CRC-32 with table, 256 B",    Bench_CrcTable,   &mBenchCrc32, mBenchCrcDataSize_c);
+    (void)HostBench_Run("CRC-32 CRC_Init",             Bench_CrcInit,    &mBenchCrc32, 0);
+    (void)HostBench_Run("CRC-16 bitwise, 256 B",       Bench_CrcBitwise, &mBenchCrc16, mBenchCrcDataSize_c);
+    (void)HostBench_Run("CRC-16 CRC_Compute, 256 B",   Bench_CrcCompute, &mBenchCrc16, mBenchCrcDataSize_c);
+    (void)HostBench_Run("CRC-16 with table, 256 B",    Bench_CrcTable,   &mBenchCrc16, mBenchCrcDataSize_c);
+}
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+********************************************************************************** */
+static void Bench_CrcBitwise(void* param)
+{
+    mBenchCrcResult = CRC_ComputeBitwise(((benchCrc_t*)param)->config, mBenchCrcData, mBenchCrcDataSize_c);
+}
+
+static void Bench_CrcCompute(void* param)
+{
+    mBenchCrcResult = CRC_Compute(((benchCrc_t*)param)->config, mBenchCrcData, mBenchCrcDataSize_c);
+}
+
+static void Bench_CrcTable(void* param)
+{
+    mBenchCrcResult = CRC_ComputeWithTable(&((benchCrc_t*)param)->handle, mBenchCrcData, mBenchCrcDataSize_c);
+}
+
+static void Bench_CrcInit(void* param)
+{
+    CRC_Init(&((benchCrc_t*)param)->handle, &((benchCrc_t*)param)->config);
+}
@@ -0,0 +1,156 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Host benchmarks of FunctionLib: FLib_MemCpy(), FLib_MemSet() and FLib_MemCmp()
+* against the C library, on word aligned and unaligned buffers, for a short and a
+* long block
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include <stdio.h>
+#include <string.h>
+
+#include "HostBench.h"
+#include "FunctionLib.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+********************************************************************************** */
+#define mBenchFLibShortLen_c       (16)
+#define mBenchFLibLongLen_c        (256)
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+********************************************************************************** */
+typedef struct benchFLib_tag
+{
+    uint8_t* pSrc;
+    uint8_t* pDst;
+    uint32_t length;
+} benchFLib_t;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+********************************************************************************** */
+static void Bench_FLibRun(const char* pName, uint32_t length, uint32_t srcAlign, uint32_t dstAlign);
+static void Bench_FLibMemCpy(void* param);
+static void Bench_FLibLibcMemcpy(void* param);
+static void Bench_FLibMemSet(void* param);
+static void Bench_FLibLibcMemset(void* param);
+static void Bench_FLibMemCmp(void* param);
+static void Bench_FLibLibcMemcmp(void* param);
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+********************************************************************************** */
+static uint32_t mBenchFLibSrc[mBenchFLibLongLen_c / 4 + 1];
+static uint32_t mBenchFLibDst[mBenchFLibLongLen_c / 4 + 1];
+
+/* Keeps the compilers from dropping the compares */
+static volatile uint32_t mBenchFLibResult;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+void Bench_FunctionLib(void)
+{
+    Bench_FLibRun("16 B, aligned",     mBenchFLibShortLen_c, 0, 0);
+    Bench_FLibRun("16 B, unaligned",   mBenchFLibShortLen_c, 1, 3);
+    Bench_FLibRun("256 B, aligned",    mBenchFLibLongLen_c,  0, 0);
+    Bench_FLibRun("256 B, offset 1",   mBenchFLibLongLen_c,  1, 1);
+    Bench_FLibRun("256 B, unaligned",  mBenchFLibLongLen_c,  1, 3);
+}
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+********************************************************************************** */
+static void Bench_FLibRun(const char* pName, uint32_t length, uint32_t srcAlign, uint32_t dstAlign)
+{
+    benchFLib_t bench;
+    char name[64];
+
+    bench.pSrc = (uint8_t*)mBenchFLibSrc + srcAlign;
+    bench.pDst = (uint8_t*)mBenchFLibDst + dstAlign;
+    bench.length = length;
+    memset(mBenchFLibSrc, 0x5A, sizeof(mBenchFLibSrc));
+    memset(mBenchFLibDst, 0x5A, sizeof(mBenchFLibDst));
+
+    (void)snprintf(name, sizeof(name), "FLib_MemCpy, %s", pName);
+    (void)HostBench_Run(name, Bench_FLibMemCpy, &bench, length);
+    (void)snprintf(name, sizeof(name), "memcpy, %s", pName);
+    (void)HostBench_Run(name, Bench_FLibLibcMemcpy, &bench, length);
+    (void)snprintf(name, sizeof(name), "FLib_MemSet, %s", pName);
+    (void)HostBench_Run(name, Bench_FLibMemSet, &bench, length);
+    (void)snprintf(name, sizeof(name), "memset, %s", pName);
+    (void)HostBench_Run(name, Bench_FLibLibcMemset, &bench, length);
+
+    /* Equal blocks, compared to the end */
+    memset(mBenchFLibDst, 0x5A, sizeof(mBenchFLibDst));
+    (void)snprintf(name, sizeof(name), "FLib_MemCmp, %s", pName);
+    (void)HostBench_Run(name, Bench_FLibMemCmp, &bench, length);
+    (void)snprintf(name, sizeof(name), "memcmp, %s", pName);
+    (void)HostBench_Run(name, Bench_FLibLibcMemcmp, &bench, length);
+}
+
+static void Bench_FLibMemCpy(void* param)
+{
+    benchFLib_t* pBench = (benchFLib_t*)param;
+
+    FLib_MemCpy(pBench->pDst, pBench->pSrc, pBench->length);
+}
+
+static void Bench_FLibLibcMemcpy(void* param)
+{
+    benchFLib_t* pBench = (benchFLib_t*)param;
+
+    memcpy(pBench->pDst, pBench->pSrc, pBench->length);
+}
+
+static void Bench_FLibMemSet(void* param)
+{
+    benchFLib_t* pBench = (benchFLib_t*)param;
+
+    FLib_MemSet(pBench->pDst, 0x5A, pBench->length);
+}
+
+static void Bench_FLibLibcMemset(void* param)
+{
+    benchFLib_t* pBench = (benchFLib_t*)param;
+
+    memset(pBench->pDst, 0x5A, pBench->length);
+}
+
+static void Bench_FLibMemCmp(void* param)
+{
+    benchFLib_t* pBench = (benchFLib_t*)param;
+
+    mBenchFLibResult = FLib_MemCmp(pBench->pSrc, pBench->pDst, pBench->length);
+}
+
+static void Bench_FLibLibcMemcmp(void* param)
+{
+    benchFLib_t* pBench = (benchFLib_t*)param;
+
+    mBenchFLibResult = (uint32_t)memcmp(pBench->pSrc, pBench->pDst, pBench->length);
+}
@@ -0,0 +1,168 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Host benchmarks of the lists and of the messaging: the cost of queuing and
+* dequeuing one element in each kind of queue
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include "HostBench.h"
+#include "GenericList.h"
+#include "MemManager.h"
+#include "Messaging.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+********************************************************************************** */
+#define mBenchListElements_c    (16)
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+********************************************************************************** */
+static void Bench_List(void* param);
+static void Bench_ListSpsc(void* param);
+static void Bench_ListMpsc(void* param);
+static void Bench_MsgQueue(void* param);
+static void Bench_MsgMpsc(void* param);
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+********************************************************************************** */
+static listElement_t       mBenchListElements[mBenchListElements_c];
+static list_t              mBenchList;
+static listSpsc_t          mBenchSpsc;
+static listElementHandle_t mBenchSpscSlots[mBenchListElements_c];
+static listMpsc_t          mBenchMpsc;
+static anchor_t            mBenchMsgQueue;
+static msgMpscQueue_t      mBenchMsgMpsc;
+static void*               mBenchMsgs[mBenchListElements_c];
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+void Bench_Lists(void)
+{
+    uint32_t i;
+
+    ListInit(&mBenchList, 0);
+    (void)ListSpscInit(&mBenchSpsc, mBenchSpscSlots, mBenchListElements_c);
+    ListMpscInit(&mBenchMpsc);
+    MSG_InitQueue(&mBenchMsgQueue);
+    MSG_MpscInit(&mBenchMsgMpsc);
+    for( i = 0; i < mBenchListElements_c; i++ )
+    {
+        mBenchMsgs[i] = MSG_Alloc(16);
+    }
+
+    /* Each operation queues and dequeues mBenchListElements_c elements */
+    (void)HostBench_Run("ListAddTail/RemoveHead x 16",   Bench_List,     NULL, 0);
+    (void)HostBench_Run("ListSpscPush/Pop x 16",         Bench_ListSpsc, NULL, 0);
+    (void)HostBench_Run("ListMpscPush/Pop x 16",         Bench_ListMpsc, NULL, 0);
+    (void)HostBench_Run("MSG_Queue/DeQueue x 16",        Bench_MsgQueue, NULL, 0);
+    (void)HostBench_Run("MSG_MpscPush/PopAll x 16",      Bench_MsgMpsc,  NULL, 0);
+
+    for( i = 0; i < mBenchListElements_c; i++ )
+    {
+        if( mBenchMsgs[i] )
+        {
+            (void)MSG_Free(mBenchMsgs[i]);
+        }
+    }
+}
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+********************************************************************************** */
+static void Bench_List(void* param)
+{
+    uint32_t i;
+
+    (void)param;
+    for( i = 0; i < mBenchListElements_c; i++ )
+    {
+        (void)ListAddTail(&mBenchList, &mBenchListElements[i]);
+    }
+    for( i = 0; i < mBenchListElements_c; i++ )
+    {
+        (void)ListRemoveHead(&mBenchList);
+    }
+}
+
+static void Bench_ListSpsc(void* param)
+{
+    uint32_t i;
+
+    (void)param;
+    for( i = 0; i < mBenchListElements_c; i++ )
+    {
+        (void)ListSpscPush(&mBenchSpsc, &mBenchListElements[i]);
+    }
+    for( i = 0; i < mBenchListElements_c; i++ )
+    {
+        (void)ListSpscPop(&mBenchSpsc);
+    }
+}
+
+static void Bench_ListMpsc(void* param)
+{
+    uint32_t i;
+
+    (void)param;
+    for( i = 0; i < mBenchListElements_c; i++ )
+    {
+        ListMpscPush(&mBenchMpsc, &mBenchListElements[i]);
+    }
+    for( i = 0; i < mBenchListElements_c; i++ )
+    {
+        (void)ListMpscPop(&mBenchMpsc);
+    }
+}
+
+static void Bench_MsgQueue(void* param)
+{
+    uint32_t i;
+
+    (void)param;
+    for( i = 0; i < mBenchListElements_c; i++ )
+    {
+        (void)MSG_Queue(&mBenchMsgQueue, mBenchMsgs[i]);
+    }
+    for( i = 0; i < mBenchListElements_c; i++ )
+    {
+        (void)MSG_DeQueue(&mBenchMsgQueue);
+    }
+}
+
+static void Bench_MsgMpsc(void* param)
+{
+    void* pMsg;
+    uint32_t i;
+
+    (void)param;
+    for( i = 0; i < mBenchListElements_c; i++ )
+    {
+        MSG_MpscPush(&mBenchMsgMpsc, mBenchMsgs[i]);
+    }
+    for( pMsg = MSG_MpscPopAll(&mBenchMsgMpsc); pMsg != NULL; pMsg = MSG_MpscNext(pMsg) )
+    {
+    }
+}
@@ -0,0 +1,100 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Host benchmarks of the memory manager: allocation and release in each pool,
+* and the fall through to a larger pool
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include "HostBench.h"
+#include "MemManager.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+********************************************************************************** */
+#define mBenchMemBurst_c        (8)
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+********************************************************************************** */
+static void Bench_MemAllocFree(void* param);
+static void Bench_MemBurst(void* param);
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+void Bench_MemManager(void)
+{
+    static uint32_t sizes[] = {16, 64, 128, 256};
+    static uint32_t burst = 64;
+    void* pBlocks[mBenchMemBurst_c];
+    uint32_t i;
+
+    (void)HostBench_Run("MEM_BufferAlloc/Free 16 B",  Bench_MemAllocFree, &sizes[0], 0);
+    (void)HostBench_Run("MEM_BufferAlloc/Free 64 B",  Bench_MemAllocFree, &sizes[1], 0);
+    (void)HostBench_Run("MEM_BufferAlloc/Free 128 B", Bench_MemAllocFree, &sizes[2], 0);
+    (void)HostBench_Run("MEM_BufferAlloc/Free 256 B", Bench_MemAllocFree, &sizes[3], 0);
+    (void)HostBench_Run("MEM_BufferAlloc/Free 8 x 64 B", Bench_MemBurst, &burst, 0);
+
+    /* The 64 bytes pool is empty: the allocations fall through to the next pool */
+    for( i = 0; i < mBenchMemBurst_c; i++ )
+    {
+        pBlocks[i] = MEM_BufferAlloc(64);
+    }
+    (void)HostBench_Run("MEM_BufferAlloc/Free 64 B, pool empty", Bench_MemAllocFree, &sizes[1], 0);
+    for( i = 0; i < mBenchMemBurst_c; i++ )
+    {
+        if( pBlocks[i] )
+        {
+            (void)MEM_BufferFree(pBlocks[i]);
+        }
+    }
+}
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+********************************************************************************** */
+static void Bench_MemAllocFree(void* param)
+{
+    void* pBlock = MEM_BufferAlloc(*(uint32_t*)param);
+
+    if( pBlock )
+    {
+        (void)MEM_BufferFree(pBlock);
+    }
+}
+
+static void Bench_MemBurst(void* param)
+{
+    void* pBlocks[mBenchMemBurst_c];
+    uint32_t i;
+
+    for( i = 0; i < mBenchMemBurst_c; i++ )
+    {
+        pBlocks[i] = MEM_BufferAlloc(*(uint32_t*)param);
+    }
+    for( i = 0; i < mBenchMemBurst_c; i++ )
+    {
+        if( pBlocks[i] )
+        {
+            (void)MEM_BufferFree(pBlocks[i]);
+        }
+    }
+}
@@ -0,0 +1,93 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Host benchmark of OtaSupport: throughput of a 16 KB image pushed in 128 byte
+* chunks and committed, on the data flash model of Host_Eeprom.c. The framework_bench
+* build writes each chunk and waits for the memory, the framework_ota_bench build
+* stages the chunks with gOtaPipelinedWrite_d and retries them while busy.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include "HostBench.h"
+#include "FunctionLib.h"
+#include "OtaSupport.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+********************************************************************************** */
+#define mBenchOtaImageLength_c     (16 * 1024)
+#define mBenchOtaChunk_c           (128)
+
+#if gOtaPipelinedWrite_d
+#define mBenchOtaName_c            "OTA pipelined, 16 KB in 128 B chunks"
+#else
+#define mBenchOtaName_c            "OTA sync, 16 KB in 128 B chunks"
+#endif
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+********************************************************************************** */
+static void Bench_OtaImage(void* param);
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+********************************************************************************** */
+static uint8_t mBenchOtaImage[mBenchOtaImageLength_c];
+static uint8_t mBenchOtaBitmap[gBootData_SectorsBitmap_Size_c];
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+void Bench_Ota(void)
+{
+    uint32_t i;
+
+    for( i = 0; i < mBenchOtaImageLength_c; i++ )
+    {
+        mBenchOtaImage[i] = (uint8_t)(i * 7);
+    }
+    FLib_MemSet(mBenchOtaBitmap, 0xFF, sizeof(mBenchOtaBitmap));
+
+    (void)HostBench_Run(mBenchOtaName_c, Bench_OtaImage, NULL, mBenchOtaImageLength_c);
+}
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+********************************************************************************** */
+static void Bench_OtaImage(void* param)
+{
+    uint32_t offset;
+
+    (void)param;
+    (void)OTA_StartImage(mBenchOtaImageLength_c);
+
+    for( offset = 0; offset < mBenchOtaImageLength_c; offset += mBenchOtaChunk_c )
+    {
+        while( gOtaBusy_c == OTA_PushImageChunk(&mBenchOtaImage[offset], mBenchOtaChunk_c, NULL, NULL) )
+        {
+        }
+    }
+
+    while( gOtaBusy_c == OTA_CommitImage(mBenchOtaBitmap) )
+    {
+    }
+}
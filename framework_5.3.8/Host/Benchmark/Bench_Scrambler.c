@@ -0,0 +1,108 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Host benchmarks of the whitener: the bitwise Whiten() against the table-driven
+* Whiten_Frame(), on a 255 byte frame, for a 7 and a 9 bit LFSR
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include "HostBench.h"
+#include "Scrambler.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+********************************************************************************** */
+#define mBenchWhitenDataSize_c     (255)
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+********************************************************************************** */
+typedef struct benchWhiten_tag
+{
+    Whitener_config_t config;
+    Whitener_handle_t handle;
+} benchWhiten_t;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+********************************************************************************** */
+static void Bench_WhitenBitwise(void* param);
+static void Bench_WhitenFrame(void* param);
+static void Bench_WhitenInit(void* param);
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+********************************************************************************** */
+static uint8_t mBenchWhitenData[mBenchWhitenDataSize_c];
+
+/* BLE data channel whitening, and PN9 */
+static benchWhiten_t mBenchWhiten7 =
+{
+    .config = {gGaloisPolyType, gWhitenRefInput, 0, 0, 7, 0x53, 0x11}
+};
+
+static benchWhiten_t mBenchWhiten9 =
+{
+    .config = {gGaloisPolyType, gWhitenInputNoRef, 0, 0, 9, 0x1FF, 0x21}
+};
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+void Bench_Scrambler(void)
+{
+    uint32_t i;
+
+    for( i = 0; i < mBenchWhitenDataSize_c; i++ )
+    {
+        mBenchWhitenData[i] = (uint8_t)i;
+    }
+    (void)Whiten_Init(&mBenchWhiten7.handle, &mBenchWhiten7.config);
+    (void)Whiten_Init(&mBenchWhiten9.handle, &mBenchWhiten9.config);
+
+    (void)HostBench_Run("7 bit Whiten, 255 B",         Bench_WhitenBitwise, &mBenchWhiten7, mBenchWhitenDataSize_c);
+    (void)HostBench_Run("7 bit Whiten_Frame, 255 B",   Bench_WhitenFrame,   &mBenchWhiten7, mBenchWhitenDataSize_c);
+    (void)HostBench_Run("7 bit Whiten_Init",           Bench_WhitenInit,    &mBenchWhiten7, 0);
+    (void)HostBench_Run("9 bit Whiten, 255 B",         Bench_WhitenBitwise, &mBenchWhiten9, mBenchWhitenDataSize_c);
+    (void)HostBench_Run("9 bit Whiten_Frame, 255 B",   Bench_WhitenFrame,   &mBenchWhiten9, mBenchWhitenDataSize_c);
+    (void)HostBench_Run("9 bit Whiten_Init",           Bench_WhitenInit,    &mBenchWhiten9, 0);
+}
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+********************************************************************************** */
+static void Bench_WhitenBitwise(void* param)
+{
+    Whiten(&((benchWhiten_t*)param)->config, mBenchWhitenData, mBenchWhitenDataSize_c);
+}
+
+static void Bench_WhitenFrame(void* param)
+{
+    Whiten_Frame(&((benchWhiten_t*)param)->handle, mBenchWhitenData, mBenchWhitenDataSize_c);
+}
+
+static void Bench_WhitenInit(void* param)
+{
+    (void)Whiten_Init(&((benchWhiten_t*)param)->handle, &((benchWhiten_t*)param)->config);
+}
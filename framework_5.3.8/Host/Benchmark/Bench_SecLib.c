@@ -0,0 +1,255 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Host benchmarks of the security library: the AES block functions with and
+* without an expanded key, the AES modes, SHA and HMAC. On the host the AES
+* core is the portable stand-in of Host_Crypto.c: the figures compare the
+* SecLib paths, not the Cortex-M library. sw_Aes128 decrypt is the path the
+* software decryption used before the T-table implementation. The P-256 figures
+* are those of the SecLib implementation, and the cost of one ECDH_P256_Continue()
+* slice bounds the time taken from the other tasks.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include "HostBench.h"
+#include "SecLib.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+********************************************************************************** */
+#define mBenchSecLibDataSize_c     (256)
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+********************************************************************************** */
+static void Bench_AesEncrypt(void* param);
+static void Bench_AesDecrypt(void* param);
+static void Bench_AesEncryptWithCtx(void* param);
+static void Bench_AesDecryptWithCtx(void* param);
+static void Bench_AesDecryptLib(void* param);
+static void Bench_AesSetKey(void* param);
+static void Bench_AesCbc(void* param);
+static void Bench_AesCbcWithCtx(void* param);
+static void Bench_AesCtr(void* param);
+static void Bench_AesCtrWithCtx(void* param);
+static void Bench_AesCmac(void* param);
+static void Bench_AesCmacWithCtx(void* param);
+static void Bench_AesCcm(void* param);
+static void Bench_Sha1(void* param);
+static void Bench_Sha256(void* param);
+static void Bench_HmacSha256(void* param);
+#if gSecLibSwEcP256_d
+static void Bench_EcdhGenerateKeys(void* param);
+static void Bench_EcdhComputeDhKey(void* param);
+static void Bench_EcdhSlice(void* param);
+#endif
+
+/* Byte oriented AES of the library */
+void sw_Aes128(const uint8_t *pData, const uint8_t *pKey, uint8_t enc, uint8_t *pReturnData);
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+********************************************************************************** */
+static uint8_t mBenchKey[16] = {0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+                                0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c};
+static uint8_t mBenchIv[16];
+static uint8_t mBenchNonce[13];
+static uint8_t mBenchMac[16];
+static uint8_t mBenchIn[mBenchSecLibDataSize_c];
+static uint8_t mBenchOut[mBenchSecLibDataSize_c];
+static AES_128_Ctx_t mBenchAesCtx;
+static sha1Context_t mBenchSha1Ctx;
+static sha256Context_t mBenchSha256Ctx;
+static HMAC_SHA256_context_t mBenchHmacCtx;
+#if gSecLibSwEcP256_d
+static ecP256Context_t mBenchEcCtx;
+static ecdhPrivateKey_t mBenchPrivateKey;
+static ecdhPublicKey_t mBenchPublicKey;
+static ecdhDhKey_t mBenchDhKey;
+static bool_t mBenchEcPending;
+#endif
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+void Bench_SecLib(void)
+{
+    uint32_t i;
+
+    for( i = 0; i < mBenchSecLibDataSize_c; i++ )
+    {
+        mBenchIn[i] = (uint8_t)(i * 13);
+    }
+    AES_128_SetKey(&mBenchAesCtx, mBenchKey);
+
+    (void)HostBench_Run("AES_128_Encrypt",                 Bench_AesEncrypt,        NULL, 16);
+    (void)HostBench_Run("AES_128_Encrypt_WithCtx",         Bench_AesEncryptWithCtx, NULL, 16);
+    (void)HostBench_Run("AES_128_Decrypt",                 Bench_AesDecrypt,        NULL, 16);
+    (void)HostBench_Run("AES_128_Decrypt_WithCtx",         Bench_AesDecryptWithCtx, NULL, 16);
+    (void)HostBench_Run("sw_Aes128 decrypt",               Bench_AesDecryptLib,     NULL, 16);
+    (void)HostBench_Run("AES_128_SetKey",                  Bench_AesSetKey,         NULL, 0);
+    (void)HostBench_Run("AES_128_CBC_Encrypt, 256 B",      Bench_AesCbc,            NULL, mBenchSecLibDataSize_c);
+    (void)HostBench_Run("AES_128_CBC_Encrypt_WithCtx",     Bench_AesCbcWithCtx,     NULL, mBenchSecLibDataSize_c);
+    (void)HostBench_Run("AES_128_CTR, 256 B",              Bench_AesCtr,            NULL, mBenchSecLibDataSize_c);
+    (void)HostBench_Run("AES_128_CTR_WithCtx, 256 B",      Bench_AesCtrWithCtx,     NULL, mBenchSecLibDataSize_c);
+    (void)HostBench_Run("AES_128_CMAC, 256 B",             Bench_AesCmac,           NULL, mBenchSecLibDataSize_c);
+    (void)HostBench_Run("AES_128_CMAC_WithCtx, 256 B",     Bench_AesCmacWithCtx,    NULL, mBenchSecLibDataSize_c);
+    (void)HostBench_Run("AES_128_CCM encrypt, 256 B",      Bench_AesCcm,            NULL, mBenchSecLibDataSize_c);
+    (void)HostBench_Run("SHA1_Hash, 256 B",                Bench_Sha1,              NULL, mBenchSecLibDataSize_c);
+    (void)HostBench_Run("SHA256_Hash, 256 B",              Bench_Sha256,            NULL, mBenchSecLibDataSize_c);
+    (void)HostBench_Run("HMAC_SHA256, 256 B",              Bench_HmacSha256,        NULL, mBenchSecLibDataSize_c);
+#if gSecLibSwEcP256_d
+    (void)ECDH_P256_GenerateKeys(&mBenchPublicKey, &mBenchPrivateKey);
+    (void)HostBench_Run("ECDH_P256_GenerateKeys",          Bench_EcdhGenerateKeys,  NULL, 0);
+    (void)HostBench_Run("ECDH_P256_ComputeDhKey",          Bench_EcdhComputeDhKey,  NULL, 0);
+    (void)HostBench_Run("ECDH_P256_Continue, one slice",   Bench_EcdhSlice,         NULL, 0);
+#endif
+}
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+********************************************************************************** */
+static void Bench_AesEncrypt(void* param)
+{
+    (void)param;
+    AES_128_Encrypt(mBenchIn, mBenchKey, mBenchOut);
+}
+
+static void Bench_AesDecrypt(void* param)
+{
+    (void)param;
+    AES_128_Decrypt(mBenchIn, mBenchKey, mBenchOut);
+}
+
+static void Bench_AesEncryptWithCtx(void* param)
+{
+    (void)param;
+    AES_128_Encrypt_WithCtx(&mBenchAesCtx, mBenchIn, mBenchOut);
+}
+
+static void Bench_AesDecryptWithCtx(void* param)
+{
+    (void)param;
+    AES_128_Decrypt_WithCtx(&mBenchAesCtx, mBenchIn, mBenchOut);
+}
+
+static void Bench_AesDecryptLib(void* param)
+{
+    (void)param;
+    sw_Aes128(mBenchIn, mBenchKey, 0, mBenchOut);
+}
+
+static void Bench_AesSetKey(void* param)
+{
+    (void)param;
+    AES_128_SetKey(&mBenchAesCtx, mBenchKey);
+}
+
+static void Bench_AesCbc(void* param)
+{
+    (void)param;
+    AES_128_CBC_Encrypt(mBenchIn, mBenchSecLibDataSize_c, mBenchIv, mBenchKey, mBenchOut);
+}
+
+static void Bench_AesCbcWithCtx(void* param)
+{
+    (void)param;
+    AES_128_CBC_Encrypt_WithCtx(&mBenchAesCtx, mBenchIn, mBenchSecLibDataSize_c, mBenchIv, mBenchOut);
+}
+
+static void Bench_AesCtr(void* param)
+{
+    (void)param;
+    AES_128_CTR(mBenchIn, mBenchSecLibDataSize_c, mBenchIv, mBenchKey, mBenchOut);
+}
+
+static void Bench_AesCtrWithCtx(void* param)
+{
+    (void)param;
+    AES_128_CTR_WithCtx(&mBenchAesCtx, mBenchIn, mBenchSecLibDataSize_c, mBenchIv, mBenchOut);
+}
+
+static void Bench_AesCmac(void* param)
+{
+    (void)param;
+    AES_128_CMAC(mBenchIn, mBenchSecLibDataSize_c, mBenchKey, mBenchMac);
+}
+
+static void Bench_AesCmacWithCtx(void* param)
+{
+    (void)param;
+    AES_128_CMAC_WithCtx(&mBenchAesCtx, mBenchIn, mBenchSecLibDataSize_c, mBenchMac);
+}
+
+static void Bench_AesCcm(void* param)
+{
+    (void)param;
+    (void)AES_128_CCM(mBenchIn, mBenchSecLibDataSize_c, mBenchIv, 16, mBenchNonce, sizeof(mBenchNonce),
+                      mBenchKey, mBenchOut, mBenchMac, 8, gSecLib_CCM_Encrypt_c);
+}
+
+static void Bench_Sha1(void* param)
+{
+    (void)param;
+    SHA1_Hash(&mBenchSha1Ctx, mBenchIn, mBenchSecLibDataSize_c);
+}
+
+static void Bench_Sha256(void* param)
+{
+    (void)param;
+    SHA256_Hash(&mBenchSha256Ctx, mBenchIn, mBenchSecLibDataSize_c);
+}
+
+static void Bench_HmacSha256(void* param)
+{
+    (void)param;
+    HMAC_SHA256(&mBenchHmacCtx, mBenchKey, sizeof(mBenchKey), mBenchIn, mBenchSecLibDataSize_c);
+}
+
+#if gSecLibSwEcP256_d
+static void Bench_EcdhGenerateKeys(void* param)
+{
+    ecdhPrivateKey_t privateKey;
+    ecdhPublicKey_t publicKey;
+
+    (void)param;
+    (void)ECDH_P256_GenerateKeys(&publicKey, &privateKey);
+}
+
+static void Bench_EcdhComputeDhKey(void* param)
+{
+    (void)param;
+    (void)ECDH_P256_ComputeDhKey(&mBenchPrivateKey, &mBenchPublicKey, &mBenchDhKey);
+}
+
+static void Bench_EcdhSlice(void* param)
+{
+    (void)param;
+
+    /* Restarts the Diffie-Hellman key when the previous one is done */
+    if( !mBenchEcPending )
+    {
+        (void)ECDH_P256_ComputeDhKeyStart(&mBenchEcCtx, &mBenchPrivateKey, &mBenchPublicKey, &mBenchDhKey);
+    }
+    mBenchEcPending = (gSecResultPending_c == ECDH_P256_Continue(&mBenchEcCtx)) ? TRUE : FALSE;
+}
+#endif /* gSecLibSwEcP256_d */
@@ -0,0 +1,167 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* This is the source file of the host benchmark runner, see HostBench.h
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "HostBench.h"
+#include "fsl_os_abstraction.h"
+#include "MemManager.h"
+#include "TimersManager.h"
+#include "RNG_Interface.h"
+#include "SecLib.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+********************************************************************************** */
+#define mHostBenchDefaultMs_c     (50)
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+********************************************************************************** */
+static uint64_t HostBench_GetTimeNs(void);
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+********************************************************************************** */
+static const hostBenchSuite_t mHostBenchSuites[] =
+{
+#if (gCrcTableSlices_c == 4)
+    /* CRC engine with the slicing-by-4 tables */
+    {"crc",        Bench_Crc},
+#elif gOtaPipelinedWrite_d
+    /* OtaSupport with the pipelined writes */
+    {"ota",        Bench_Ota},
+#else
+    {"memmanager", Bench_MemManager},
+    {"functionlib", Bench_FunctionLib},
+    {"lists",      Bench_Lists},
+    {"crc",        Bench_Crc},
+    {"ota",        Bench_Ota},
+    {"scrambler",  Bench_Scrambler},
+    {"seclib",     Bench_SecLib},
+#endif
+};
+
+static uint64_t mHostBenchDurationNs;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+
+/*! *********************************************************************************
+* \brief  Initializes the framework, and runs the selected suites
+*
+********************************************************************************** */
+void main_task(void const *argument)
+{
+    const char* pSelected = getenv("HOST_BENCH_SUITE");
+    const char* pDuration = getenv("HOST_BENCH_MS");
+    uint32_t ran = 0;
+    uint32_t i;
+
+    (void)argument;
+
+    MEM_Init();
+    TMR_Init();
+    (void)RNG_Init();
+    SecLib_Init();
+
+    mHostBenchDurationNs = 1000000ULL * (pDuration ? strtoul(pDuration, NULL, 0) : mHostBenchDefaultMs_c);
+
+    for( i = 0; i < NumberOfElements(mHostBenchSuites); i++ )
+    {
+        if( pSelected && strcmp(pSelected, mHostBenchSuites[i].pName) )
+        {
+            continue;
+        }
+
+        printf("--- %s\n", mHostBenchSuites[i].pName);
+        mHostBenchSuites[i].pfRun();
+        ran++;
+    }
+
+    if( 0 == ran )
+    {
+        printf("no benchmark suite named %s\n", pSelected);
+    }
+
+    fflush(stdout);
+    exit(ran ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+double HostBench_Run(const char* pName, hostBenchOp_t pfOp, void* param, uint32_t bytes)
+{
+    uint64_t iterations = 1;
+    uint64_t elapsed;
+    uint64_t start;
+    uint64_t i;
+    double ns;
+
+    /* Warm up, then double the iterations until the measurement lasts long enough */
+    pfOp(param);
+    for( ;; )
+    {
+        start = HostBench_GetTimeNs();
+        for( i = 0; i < iterations; i++ )
+        {
+            pfOp(param);
+        }
+        elapsed = HostBench_GetTimeNs() - start;
+
+        if( (elapsed >= mHostBenchDurationNs) || (iterations >= (1ULL << 40)) )
+        {
+            break;
+        }
+        iterations *= 2;
+    }
+
+    ns = (double)elapsed / (double)iterations;
+    if( bytes )
+    {
+        printf("%-40s %12.1f ns/op %10.2f MB/s\n", pName, ns, (double)bytes * 1000.0 / ns);
+    }
+    else
+    {
+        printf("%-40s %12.1f ns/op\n", pName, ns);
+    }
+    fflush(stdout);
+
+    return ns;
+}
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+********************************************************************************** */
+static uint64_t HostBench_GetTimeNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
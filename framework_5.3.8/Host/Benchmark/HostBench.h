@@ -0,0 +1,68 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* This is the header file of the host benchmark runner. Each suite times the
+* operations of one framework module with HostBench_Run(), which repeats an
+* operation until the measurement lasts long enough and prints its cost.
+* The HOST_BENCH_SUITE environment variable selects one suite, HOST_BENCH_MS
+* sets the duration of a measurement.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef _HOST_BENCH_H_
+#define _HOST_BENCH_H_
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include "EmbeddedTypes.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public type definitions
+*************************************************************************************
+********************************************************************************** */
+typedef void (*hostBenchOp_t)(void* param);
+
+typedef struct hostBenchSuite_tag
+{
+    const char* pName;      /* Value of HOST_BENCH_SUITE which selects the suite */
+    void      (*pfRun)(void);
+} hostBenchSuite_t;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+********************************************************************************** */
+
+/*! *********************************************************************************
+* \brief  Times an operation, and prints its cost in ns. If bytes is not 0, the
+*         operation processes that many bytes, and the throughput is also printed.
+*
+* \param[in] pName   name of the measurement
+* \param[in] pfOp    the operation
+* \param[in] param   parameter of the operation
+* \param[in] bytes   bytes processed by one operation, or 0
+*
+* \return  the cost of one operation, in ns
+*
+********************************************************************************** */
+double HostBench_Run(const char* pName, hostBenchOp_t pfOp, void* param, uint32_t bytes);
+
+/* Suites */
+void Bench_Crc(void);
+void Bench_FunctionLib(void);
+void Bench_Lists(void);
+void Bench_MemManager(void);
+void Bench_Ota(void);
+void Bench_Scrambler(void);
+void Bench_SecLib(void);
+
+#endif /* _HOST_BENCH_H_ */
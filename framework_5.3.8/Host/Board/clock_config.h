@@ -0,0 +1,35 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Host stand-in for the clock configuration of the board. The frequencies are the
+* ones of the default run configuration, so the framework computes the same values
+* as on target.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef _CLOCK_CONFIG_H_
+#define _CLOCK_CONFIG_H_
+
+#include <stdint.h>
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public macros
+*************************************************************************************
+********************************************************************************** */
+#define BOARD_XTAL0_CLK_HZ             32000000U
+#define BOARD_XTAL32K_CLK_HZ           32768U
+#define BOARD_BOOTCLOCKRUN_CORE_CLOCK  40000000U
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+********************************************************************************** */
+void BOARD_BootClockRUN(void);
+
+#endif /* _CLOCK_CONFIG_H_ */
@@ -0,0 +1,56 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Host stand-in for the clock driver of the SDK. The peripheral models are always
+* clocked, so gating a clock has no effect.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef _FSL_CLOCK_H_
+#define _FSL_CLOCK_H_
+
+#include "fsl_common.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public type definitions
+*************************************************************************************
+********************************************************************************** */
+typedef enum _clock_ip_name
+{
+    kCLOCK_IpInvalid = 0U,
+    kCLOCK_Rtc0,
+    kCLOCK_Pit0,
+    kCLOCK_Tpm0,
+    kCLOCK_Tpm1,
+    kCLOCK_Tpm2,
+    kCLOCK_Lpuart0,
+    kCLOCK_Ftf0,
+} clock_ip_name_t;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+static inline void CLOCK_EnableClock(clock_ip_name_t name)
+{
+    (void)name;
+}
+
+static inline void CLOCK_DisableClock(clock_ip_name_t name)
+{
+    (void)name;
+}
+
+/* Bus clock of the default run configuration */
+static inline uint32_t CLOCK_GetBusClkFreq(void)
+{
+    return 20000000U;
+}
+
+#endif /* _FSL_CLOCK_H_ */
@@ -0,0 +1,95 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Host stand-in for the common driver header of the SDK: the status codes and the
+* interrupt helpers used by the framework.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef _FSL_COMMON_H_
+#define _FSL_COMMON_H_
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "fsl_device_registers.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public macros
+*************************************************************************************
+********************************************************************************** */
+#define MAKE_STATUS(group, code) ((((group)*100) + (code)))
+
+#define MAKE_VERSION(major, minor, bugfix) (((major) << 16) | ((minor) << 8) | (bugfix))
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public type definitions
+*************************************************************************************
+********************************************************************************** */
+enum _status_groups
+{
+    kStatusGroup_Generic = 0,
+    kStatusGroup_FLASH = 1,
+};
+
+enum _generic_status
+{
+    kStatus_Success = MAKE_STATUS(kStatusGroup_Generic, 0),
+    kStatus_Fail = MAKE_STATUS(kStatusGroup_Generic, 1),
+    kStatus_ReadOnly = MAKE_STATUS(kStatusGroup_Generic, 2),
+    kStatus_OutOfRange = MAKE_STATUS(kStatusGroup_Generic, 3),
+    kStatus_InvalidArgument = MAKE_STATUS(kStatusGroup_Generic, 4),
+    kStatus_Timeout = MAKE_STATUS(kStatusGroup_Generic, 5),
+    kStatus_NoTransferInProgress = MAKE_STATUS(kStatusGroup_Generic, 6),
+};
+
+typedef int32_t status_t;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+static inline void EnableIRQ(IRQn_Type interrupt)
+{
+    Host_NvicEnableIrq(interrupt);
+}
+
+static inline void DisableIRQ(IRQn_Type interrupt)
+{
+    Host_NvicDisableIrq(interrupt);
+}
+
+static inline uint32_t DisableGlobalIRQ(void)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    return primask;
+}
+
+static inline void EnableGlobalIRQ(uint32_t primask)
+{
+    if( !primask )
+    {
+        __enable_irq();
+    }
+}
+
+/* The handler address is kept in 32 bits, so the program must be linked below
+   4 GB (-no-pie) */
+static inline uint32_t InstallIRQHandler(IRQn_Type irq, uint32_t irqHandler)
+{
+    Host_InstallIrqHandler(irq, (void (*)(void))(uintptr_t)irqHandler);
+    return 0;
+}
+
+#endif /* _FSL_COMMON_H_ */
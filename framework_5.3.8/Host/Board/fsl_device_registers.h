@@ -0,0 +1,266 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Host stand-in for the device header: the interrupt numbers, the core functions,
+* the peripherals modelled by the Host platform and the features of the device.
+* Peripherals which are not modelled are absent, so their use fails to compile.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef __FSL_DEVICE_REGISTERS_H__
+#define __FSL_DEVICE_REGISTERS_H__
+
+#if !defined(CPU_HOST)
+#error "The Host/Board headers are for a host build only"
+#endif
+
+#include <stdint.h>
+#include "Host.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Interrupts
+*************************************************************************************
+********************************************************************************** */
+typedef enum IRQn {
+  NotAvail_IRQn                = -128,
+  NonMaskableInt_IRQn          = -14,
+  HardFault_IRQn               = -13,
+  SVCall_IRQn                  = -5,
+  PendSV_IRQn                  = -2,
+  SysTick_IRQn                 = -1,
+  DMA0_IRQn                    = 0,
+  DMA1_IRQn                    = 1,
+  DMA2_IRQn                    = 2,
+  DMA3_IRQn                    = 3,
+  Reserved20_IRQn              = 4,
+  FTFA_IRQn                    = 5,
+  LVD_LVW_DCDC_IRQn            = 6,
+  LLWU_IRQn                    = 7,
+  I2C0_IRQn                    = 8,
+  I2C1_IRQn                    = 9,
+  SPI0_IRQn                    = 10,
+  TSI0_IRQn                    = 11,
+  LPUART0_IRQn                 = 12,
+  TRNG0_IRQn                   = 13,
+  CMT_IRQn                     = 14,
+  ADC0_IRQn                    = 15,
+  CMP0_IRQn                    = 16,
+  TPM0_IRQn                    = 17,
+  TPM1_IRQn                    = 18,
+  TPM2_IRQn                    = 19,
+  RTC_IRQn                     = 20,
+  RTC_Seconds_IRQn             = 21,
+  PIT_IRQn                     = 22,
+  LTC0_IRQn                    = 23,
+  Radio_0_IRQn                 = 24,
+  DAC0_IRQn                    = 25,
+  Radio_1_IRQn                 = 26,
+  MCG_IRQn                     = 27,
+  LPTMR0_IRQn                  = 28,
+  SPI1_IRQn                    = 29,
+  PORTA_IRQn                   = 30,
+  PORTB_PORTC_IRQn             = 31
+} IRQn_Type;
+
+#define __NVIC_PRIO_BITS               2
+
+/*! *********************************************************************************
+*************************************************************************************
+* Core
+*************************************************************************************
+********************************************************************************** */
+#define __I     volatile const
+#define __O     volatile
+#define __IO    volatile
+
+#define __disable_irq()                Host_DisableIrq()
+#define __enable_irq()                 Host_EnableIrq()
+#define __get_PRIMASK()                Host_GetPrimask()
+#define __get_IPSR()                   Host_GetIpsr()
+#define __WFI()                        Host_WaitForInterrupt()
+#define __WFE()                        Host_WaitForInterrupt()
+#define __NOP()                        __asm__ volatile ("nop")
+#define __DSB()                        __sync_synchronize()
+#define __DMB()                        __sync_synchronize()
+#define __ISB()                        __sync_synchronize()
+#define __get_LR()                     __builtin_return_address(0)
+
+#define NVIC_EnableIRQ(irq)            Host_NvicEnableIrq(irq)
+#define NVIC_DisableIRQ(irq)           Host_NvicDisableIrq(irq)
+#define NVIC_SetPendingIRQ(irq)        Host_NvicSetPendingIrq(irq)
+#define NVIC_ClearPendingIRQ(irq)      Host_NvicClearPendingIrq(irq)
+#define NVIC_GetPendingIRQ(irq)        Host_NvicGetPendingIrq(irq)
+#define NVIC_SetPriority(irq, prio)    ((void)(irq), (void)(prio))
+#define NVIC_SystemReset()             Host_SystemReset()
+
+/* SysTick: read by cost measurements only. It does not count on the host, except
+   on the simulated core of Test_OsaBm.c. */
+typedef struct {
+  __IO uint32_t CTRL;
+  __IO uint32_t LOAD;
+  __IO uint32_t VAL;
+  __I  uint32_t CALIB;
+} SysTick_Type;
+
+#define SysTick_CTRL_ENABLE_Msk        (0x1U)
+#define SysTick_CTRL_TICKINT_Msk       (0x2U)
+#define SysTick_CTRL_CLKSOURCE_Msk     (0x4U)
+#define SysTick_LOAD_RELOAD_Msk        (0xFFFFFFU)
+
+extern SysTick_Type gHostSysTick;
+#define SysTick                        (&gHostSysTick)
+
+/* Core clock, in Hz */
+extern uint32_t SystemCoreClock;
+
+/* SCB: the pending SysTick bit, set by the simulated core of Test_OsaBm.c only */
+typedef struct {
+  __IO uint32_t ICSR;
+} SCB_Type;
+
+#define SCB_ICSR_PENDSTSET_Msk         (0x4000000U)
+
+extern SCB_Type gHostScb;
+#define SCB                            (&gHostScb)
+
+/*! *********************************************************************************
+*************************************************************************************
+* RTC, modelled by Host_Rtc.c: TSR and TPR count at 32768 Hz while SR[TCE] is set,
+* and the alarm is raised when TSR reaches TAR.
+*************************************************************************************
+********************************************************************************** */
+typedef struct {
+  __IO uint32_t TSR;
+  __IO uint32_t TPR;
+  __IO uint32_t TAR;
+  __IO uint32_t TCR;
+  __IO uint32_t CR;
+  __IO uint32_t SR;
+  __IO uint32_t LR;
+  __IO uint32_t IER;
+} RTC_Type;
+
+#define RTC_CR_SWR_MASK                (0x1U)
+#define RTC_CR_SUP_MASK                (0x4U)
+#define RTC_CR_UM_MASK                 (0x8U)
+#define RTC_CR_OSCE_MASK               (0x100U)
+#define RTC_SR_TIF_MASK                (0x1U)
+#define RTC_SR_TOF_MASK                (0x2U)
+#define RTC_SR_TAF_MASK                (0x4U)
+#define RTC_SR_TCE_MASK                (0x10U)
+#define RTC_IER_TIIE_MASK              (0x1U)
+#define RTC_IER_TOIE_MASK              (0x2U)
+#define RTC_IER_TAIE_MASK              (0x4U)
+#define RTC_IER_TSIE_MASK              (0x10U)
+
+extern RTC_Type gHostRtc;
+#define RTC                            (&gHostRtc)
+
+/*! *********************************************************************************
+*************************************************************************************
+* SIM: the identification registers only. The unique id is derived from the host
+* name by Host_Init(), so that it is stable across runs.
+*************************************************************************************
+********************************************************************************** */
+typedef struct {
+  __I  uint32_t SDID;
+  __I  uint32_t UIDMH;
+  __I  uint32_t UIDML;
+  __I  uint32_t UIDL;
+} SIM_Type;
+
+extern SIM_Type gHostSim;
+#define SIM                            (&gHostSim)
+
+/*! *********************************************************************************
+*************************************************************************************
+* LTC, eDMA and DMAMUX, modelled by Host_Ltc.c in the builds which set
+* gHostLtcModel_d. STA[AB] is set while the LTC processes an eDMA transfer, and the
+* INT bit of a channel is set when its transfer completes.
+*************************************************************************************
+********************************************************************************** */
+#if gHostLtcModel_d
+typedef struct {
+  __IO uint32_t STA;
+} LTC_Type;
+
+#define LTC_STA_AB_MASK                (0x2U)
+
+extern LTC_Type gHostLtc;
+#define LTC0                           (&gHostLtc)
+
+typedef struct {
+  __IO uint32_t CR;
+  __IO uint32_t ERQ;
+  __IO uint32_t INT;
+} DMA_Type;
+
+extern DMA_Type gHostDma;
+#define DMA0                           (&gHostDma)
+
+typedef struct {
+  __IO uint8_t CHCFG[4];
+} DMAMUX_Type;
+
+#define DMAMUX_CHCFG_SOURCE_MASK       (0x3FU)
+#define DMAMUX_CHCFG_ENBL_MASK         (0x80U)
+
+extern DMAMUX_Type gHostDmaMux;
+#define DMAMUX0                        (&gHostDmaMux)
+
+typedef enum _dma_request_source
+{
+  kDmaRequestMux0LTC0InputFIFO  = 20|0x100U,
+  kDmaRequestMux0LTC0OutputFIFO = 21|0x100U,
+} dma_request_source_t;
+#endif /* gHostLtcModel_d */
+
+/*! *********************************************************************************
+*************************************************************************************
+* Features
+*************************************************************************************
+********************************************************************************** */
+/* No hardware accelerator, DMA, timer or serial peripheral: the framework uses its
+   software implementations and the Host adapters. The LTC and the eDMA are present
+   in the builds of the LTC model only. */
+#define FSL_FEATURE_SOC_LTC_COUNT                      (gHostLtcModel_d)
+#define FSL_FEATURE_SOC_MMCAU_COUNT                    (0)
+#define FSL_FEATURE_SOC_TRNG_COUNT                     (0)
+#define FSL_FEATURE_SOC_RNG_COUNT                      (0)
+#define FSL_FEATURE_SOC_EDMA_COUNT                     (gHostLtcModel_d)
+#define FSL_FEATURE_EDMA_MODULE_CHANNEL                (4)
+#define FSL_FEATURE_SOC_MPU_COUNT                      (0)
+#define FSL_FEATURE_SOC_SCG_COUNT                      (0)
+#define FSL_FEATURE_SOC_FTM_COUNT                      (0)
+#define FSL_FEATURE_SOC_UART_COUNT                     (0)
+#define FSL_FEATURE_SOC_LPUART_COUNT                   (0)
+#define FSL_FEATURE_SOC_LPSCI_COUNT                    (0)
+#define FSL_FEATURE_SOC_DSPI_COUNT                     (0)
+#define FSL_FEATURE_SOC_SPI_COUNT                      (0)
+#define FSL_FEATURE_SOC_I2C_COUNT                      (0)
+#define FSL_FEATURE_SOC_GPIO_COUNT                     (0)
+#define FSL_FEATURE_PIT_TIMER_COUNT                    (0)
+#define FSL_FEATURE_PIT_HAS_CHAIN_MODE                 (0)
+
+/* Program flash of the MKW41Z512, modelled by Host_Flash.c */
+#define FSL_FEATURE_FLASH_IS_FTFA                      (1)
+#define FSL_FEATURE_FLASH_IS_FTFE                      (0)
+#define FSL_FEATURE_FLASH_IS_FTFL                      (0)
+#define FSL_FEATURE_FLASH_PFLASH_BLOCK_COUNT           (2)
+#define FSL_FEATURE_FLASH_PFLASH_BLOCK_SIZE            (262144)
+#define FSL_FEATURE_FLASH_PFLASH_BLOCK_SECTOR_SIZE     (2048)
+#define FSL_FEATURE_FLASH_PFLASH_BLOCK_WRITE_UNIT_SIZE (4)
+#define FSL_FEATURE_FLASH_PAGE_SIZE_BYTES              (2048)
+#define FSL_FEATURE_FLASH_FLEX_NVM_START_ADDRESS       (0x00000000)
+#define FSL_FEATURE_FLASH_FLEX_NVM_BLOCK_COUNT         (0)
+#define FSL_FEATURE_FLASH_FLEX_NVM_BLOCK_SIZE          (0)
+#define FSL_FEATURE_FLASH_FLEX_NVM_BLOCK_SECTOR_SIZE   (0)
+#define FSL_FEATURE_FLASH_FLEX_RAM_START_ADDRESS       (0x00000000)
+#define FSL_FEATURE_FLASH_FLEX_RAM_SIZE                (0)
+
+#endif /* __FSL_DEVICE_REGISTERS_H__ */
@@ -0,0 +1,63 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Host stand-in for the eDMA driver of the SDK, implemented by Host_Ltc.c. The
+* channels are programmed by the LTC model only, so the transfer functions are not
+* provided.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef _FSL_EDMA_H_
+#define _FSL_EDMA_H_
+
+#include "fsl_common.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public type definitions
+*************************************************************************************
+********************************************************************************** */
+enum _edma_channel_status_flags
+{
+    kEDMA_DoneFlag = 0x1U,
+    kEDMA_ErrorFlag = 0x2U,
+    kEDMA_InterruptFlag = 0x4U,
+};
+
+typedef struct _edma_config
+{
+    bool enableContinuousLinkMode;
+    bool enableHaltOnError;
+    bool enableRoundRobinArbitration;
+    bool enableDebugMode;
+} edma_config_t;
+
+struct _edma_handle;
+
+typedef void (*edma_callback)(struct _edma_handle *handle, void *userData, bool transferDone, uint32_t tcds);
+
+typedef struct _edma_handle
+{
+    edma_callback callback;
+    void *userData;
+    DMA_Type *base;
+    uint8_t channel;
+} edma_handle_t;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+********************************************************************************** */
+void EDMA_Init(DMA_Type *base, const edma_config_t *config);
+void EDMA_GetDefaultConfig(edma_config_t *config);
+uint32_t EDMA_GetChannelStatusFlags(DMA_Type *base, uint32_t channel);
+void EDMA_CreateHandle(edma_handle_t *handle, DMA_Type *base, uint32_t channel);
+void EDMA_SetCallback(edma_handle_t *handle, edma_callback callback, void *userData);
+void EDMA_HandleIRQ(edma_handle_t *handle);
+
+#endif /* _FSL_EDMA_H_ */
@@ -0,0 +1,106 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Host stand-in for the flash driver of the SDK, implemented by Host_Flash.c over a
+* memory mapped file. Only the program flash functions used by the framework are
+* provided.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef _FSL_FLASH_H_
+#define _FSL_FLASH_H_
+
+#include "fsl_common.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public macros
+*************************************************************************************
+********************************************************************************** */
+#if !defined(FOUR_CHAR_CODE)
+#define FOUR_CHAR_CODE(a, b, c, d) (((d) << 24) | ((c) << 16) | ((b) << 8) | ((a)))
+#endif
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public type definitions
+*************************************************************************************
+********************************************************************************** */
+enum _flash_status
+{
+    kStatus_FLASH_Success = MAKE_STATUS(kStatusGroup_Generic, 0),
+    kStatus_FLASH_InvalidArgument = MAKE_STATUS(kStatusGroup_Generic, 4),
+    kStatus_FLASH_SizeError = MAKE_STATUS(kStatusGroup_FLASH, 0),
+    kStatus_FLASH_AlignmentError = MAKE_STATUS(kStatusGroup_FLASH, 1),
+    kStatus_FLASH_AddressError = MAKE_STATUS(kStatusGroup_FLASH, 2),
+    kStatus_FLASH_AccessError = MAKE_STATUS(kStatusGroup_FLASH, 3),
+    kStatus_FLASH_ProtectionViolation = MAKE_STATUS(kStatusGroup_FLASH, 4),
+    kStatus_FLASH_CommandFailure = MAKE_STATUS(kStatusGroup_FLASH, 5),
+    kStatus_FLASH_EraseKeyError = MAKE_STATUS(kStatusGroup_FLASH, 7),
+};
+
+enum _flash_driver_api_keys
+{
+    kFLASH_ApiEraseKey = FOUR_CHAR_CODE('k', 'f', 'e', 'k')
+};
+
+typedef enum _flash_margin_value
+{
+    kFLASH_MarginValueNormal,
+    kFLASH_MarginValueUser,
+    kFLASH_MarginValueFactory,
+    kFLASH_MarginValueInvalid
+} flash_margin_value_t;
+
+typedef struct _flash_config
+{
+    uint32_t PFlashBlockBase;   /*!< Address of the flash image */
+    uint32_t PFlashTotalSize;   /*!< Size of the flash image */
+    uint8_t  PFlashBlockCount;
+    uint32_t PFlashSectorSize;
+} flash_config_t;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+********************************************************************************** */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! *********************************************************************************
+* \brief  Maps the flash image file, creating it erased if missing, and fills the
+*         configuration
+*
+********************************************************************************** */
+status_t FLASH_Init(flash_config_t *config);
+
+/*! *********************************************************************************
+* \brief  Programs whole write units. Like on the MCU, programming can only clear
+*         bits, so data written over non erased flash is corrupted.
+*
+********************************************************************************** */
+status_t FLASH_Program(flash_config_t *config, uint32_t start, uint32_t *src, uint32_t lengthInBytes);
+
+/*! *********************************************************************************
+* \brief  Erases whole sectors
+*
+********************************************************************************** */
+status_t FLASH_Erase(flash_config_t *config, uint32_t start, uint32_t lengthInBytes, uint32_t key);
+
+/*! *********************************************************************************
+* \brief  Checks that a range of whole write units is erased
+*
+********************************************************************************** */
+status_t FLASH_VerifyErase(flash_config_t *config, uint32_t start, uint32_t lengthInBytes, flash_margin_value_t margin);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _FSL_FLASH_H_ */
@@ -0,0 +1,75 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Host stand-in for the LTC driver of the SDK, implemented by Host_Ltc.c. Only the
+* AES functions used by SecLib are provided, for 128-bit encryption keys.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef _FSL_LTC_H_
+#define _FSL_LTC_H_
+
+#include "fsl_common.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public macros
+*************************************************************************************
+********************************************************************************** */
+#define LTC_AES_BLOCK_SIZE 16
+#define LTC_AES_IV_SIZE    16
+
+#define LTC_AES_EncryptCtr(base, input, output, size, counter, key, keySize, counterlast, szLeft) \
+    LTC_AES_CryptCtr(base, input, output, size, counter, key, keySize, counterlast, szLeft)
+
+#define LTC_AES_DecryptCtr(base, input, output, size, counter, key, keySize, counterlast, szLeft) \
+    LTC_AES_CryptCtr(base, input, output, size, counter, key, keySize, counterlast, szLeft)
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public type definitions
+*************************************************************************************
+********************************************************************************** */
+typedef enum _ltc_aes_key_t
+{
+    kLTC_EncryptKey = 0U,
+    kLTC_DecryptKey = 1U, /* not modelled: the functions fail with this key type */
+} ltc_aes_key_t;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+********************************************************************************** */
+void LTC_Init(LTC_Type *base);
+
+status_t LTC_AES_EncryptEcb(LTC_Type *base, const uint8_t *plaintext, uint8_t *ciphertext, uint32_t size,
+                            const uint8_t *key, uint32_t keySize);
+
+status_t LTC_AES_DecryptEcb(LTC_Type *base, const uint8_t *ciphertext, uint8_t *plaintext, uint32_t size,
+                            const uint8_t *key, uint32_t keySize, ltc_aes_key_t keyType);
+
+status_t LTC_AES_EncryptCbc(LTC_Type *base, const uint8_t *plaintext, uint8_t *ciphertext, uint32_t size,
+                            const uint8_t iv[LTC_AES_IV_SIZE], const uint8_t *key, uint32_t keySize);
+
+status_t LTC_AES_DecryptCbc(LTC_Type *base, const uint8_t *ciphertext, uint8_t *plaintext, uint32_t size,
+                            const uint8_t iv[LTC_AES_IV_SIZE], const uint8_t *key, uint32_t keySize,
+                            ltc_aes_key_t keyType);
+
+status_t LTC_AES_CryptCtr(LTC_Type *base, const uint8_t *input, uint8_t *output, uint32_t size,
+                          uint8_t counter[LTC_AES_BLOCK_SIZE], const uint8_t *key, uint32_t keySize,
+                          uint8_t counterlast[LTC_AES_BLOCK_SIZE], uint32_t *szLeft);
+
+status_t LTC_AES_EncryptTagCcm(LTC_Type *base, const uint8_t *plaintext, uint8_t *ciphertext, uint32_t size,
+                               const uint8_t *iv, uint32_t ivSize, const uint8_t *aad, uint32_t aadSize,
+                               const uint8_t *key, uint32_t keySize, uint8_t *tag, uint32_t tagSize);
+
+status_t LTC_AES_DecryptTagCcm(LTC_Type *base, const uint8_t *ciphertext, uint8_t *plaintext, uint32_t size,
+                               const uint8_t *iv, uint32_t ivSize, const uint8_t *aad, uint32_t aadSize,
+                               const uint8_t *key, uint32_t keySize, const uint8_t *tag, uint32_t tagSize);
+
+#endif /* _FSL_LTC_H_ */
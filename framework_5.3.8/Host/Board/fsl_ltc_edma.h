@@ -0,0 +1,68 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Host stand-in for the LTC eDMA driver of the SDK, implemented by Host_Ltc.c. The
+* model processes the transfer on its own thread, then raises the interrupts of
+* the two eDMA channels; the completion callback is called from the output one.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef _FSL_LTC_EDMA_H_
+#define _FSL_LTC_EDMA_H_
+
+#include "fsl_ltc.h"
+#include "fsl_edma.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public macros
+*************************************************************************************
+********************************************************************************** */
+#define LTC_AES_EncryptCtrEDMA(base, handle, input, output, size, counter, key, keySize, counterlast, szLeft) \
+    LTC_AES_CryptCtrEDMA(base, handle, input, output, size, counter, key, keySize, counterlast, szLeft)
+
+#define LTC_AES_DecryptCtrEDMA(base, handle, input, output, size, counter, key, keySize, counterlast, szLeft) \
+    LTC_AES_CryptCtrEDMA(base, handle, input, output, size, counter, key, keySize, counterlast, szLeft)
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public type definitions
+*************************************************************************************
+********************************************************************************** */
+typedef struct _ltc_edma_handle ltc_edma_handle_t;
+
+typedef void (*ltc_edma_callback_t)(LTC_Type *base, ltc_edma_handle_t *handle, status_t status, void *userData);
+
+struct _ltc_edma_handle
+{
+    ltc_edma_callback_t callback;
+    void *userData;
+    edma_handle_t *inputFifoEdmaHandle;
+    edma_handle_t *outputFifoEdmaHandle;
+};
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+********************************************************************************** */
+void LTC_CreateHandleEDMA(LTC_Type *base, ltc_edma_handle_t *handle, ltc_edma_callback_t callback, void *userData,
+                          edma_handle_t *inputFifoEdmaHandle, edma_handle_t *outputFifoEdmaHandle);
+
+status_t LTC_AES_EncryptCbcEDMA(LTC_Type *base, ltc_edma_handle_t *handle, const uint8_t *plaintext,
+                                uint8_t *ciphertext, uint32_t size, const uint8_t iv[LTC_AES_IV_SIZE],
+                                const uint8_t *key, uint32_t keySize);
+
+status_t LTC_AES_DecryptCbcEDMA(LTC_Type *base, ltc_edma_handle_t *handle, const uint8_t *ciphertext,
+                                uint8_t *plaintext, uint32_t size, const uint8_t iv[LTC_AES_IV_SIZE],
+                                const uint8_t *key, uint32_t keySize, ltc_aes_key_t keyType);
+
+status_t LTC_AES_CryptCtrEDMA(LTC_Type *base, ltc_edma_handle_t *handle, const uint8_t *input, uint8_t *output,
+                              uint32_t size, uint8_t counter[LTC_AES_BLOCK_SIZE], const uint8_t *key,
+                              uint32_t keySize, uint8_t counterlast[LTC_AES_BLOCK_SIZE], uint32_t *szLeft);
+
+#endif /* _FSL_LTC_EDMA_H_ */
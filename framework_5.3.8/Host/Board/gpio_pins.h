@@ -0,0 +1,18 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Host stand-in for the GPIO pin definitions of the board. The Host platform has
+* no switches or LEDs.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef _GPIO_PINS_H_
+#define _GPIO_PINS_H_
+
+#include "GPIO_Adapter.h"
+
+#endif /* _GPIO_PINS_H_ */
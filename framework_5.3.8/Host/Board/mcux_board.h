@@ -0,0 +1,52 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Host stand-in for the board header: the board name, the debug console and the
+* clocks of the timers.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef _MCUX_BOARD_H_
+#define _MCUX_BOARD_H_
+
+#include "clock_config.h"
+#include "fsl_common.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public macros
+*************************************************************************************
+********************************************************************************** */
+#define BOARD_NAME                     "HOST"
+
+/* The debug console is the standard output of the process */
+#define BOARD_DEBUG_UART_INSTANCE      0
+#define BOARD_DEBUG_UART_BAUDRATE      115200
+
+/* Serial interface of the application: the pipe or pseudo terminal of Pipe_Adapter */
+#ifndef APP_SERIAL_INTERFACE_TYPE
+#define APP_SERIAL_INTERFACE_TYPE      (gSerialMgrCustom_c)
+#endif
+
+#ifndef APP_SERIAL_INTERFACE_INSTANCE
+#define APP_SERIAL_INTERFACE_INSTANCE  (0)
+#endif
+
+#ifndef APP_SERIAL_INTERFACE_SPEED
+#define APP_SERIAL_INTERFACE_SPEED     (115200)
+#endif
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+********************************************************************************** */
+void     hardware_init(void);
+void     BOARD_InitDebugConsole(void);
+uint32_t BOARD_GetTpmClock(uint32_t instance);
+
+#endif /* _MCUX_BOARD_H_ */
@@ -0,0 +1,23 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Host stand-in for the pin configuration of the board. There are no pins to
+* configure.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef _PIN_MUX_H_
+#define _PIN_MUX_H_
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+********************************************************************************** */
+void BOARD_InitPins(void);
+
+#endif /* _PIN_MUX_H_ */
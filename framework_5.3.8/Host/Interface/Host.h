@@ -0,0 +1,263 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* This is the header file for the Host platform. It models on a Linux host the
+* parts of the MCU used by the framework: PRIMASK and the NVIC, the RTC and the
+* program flash, so that the framework runs unchanged in a host process.
+*
+* A host build:
+*   - defines CPU_HOST and FSL_RTOS_HOST, see Host_Preinclude.h,
+*   - uses Host/Board instead of the device and driver directories of the SDK,
+*   - compiles fsl_os_abstraction_host.c, TMR_Adapter_Host.c and Host/Source
+*     instead of the OSA port, TMR_Adapter.c and the SDK drivers,
+*   - builds SecLib with Host_Crypto.c, a portable stand-in for the prebuilt
+*     Cortex-M crypto library, and replaces RNG.c by Host_Rng.c. SecLib is also
+*     built on the LTC and eDMA model of Host_Ltc.c, with asynchronous jobs,
+*     for the seclib_ltc suite,
+*   - uses a gSerialMgrCustom_c interface, connected by Pipe_Initialize() to the
+*     standard streams, to a pseudo terminal or to a FIFO,
+*   - links with -lpthread, and with -no-pie on a 64 bit host, since the framework
+*     keeps addresses in 32 bit variables.
+*
+* Host/CMakeLists.txt builds the framework this way, with the unit tests of
+* Host/Test and the benchmarks of Host/Benchmark. ctest runs both; the check
+* target runs the tests, then prints the benchmark figures.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef _HOST_H_
+#define _HOST_H_
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include "EmbeddedTypes.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public macros
+*************************************************************************************
+********************************************************************************** */
+
+/* Number of device interrupt vectors, as on the MCU */
+#define gHostIrqCount_c               (32)
+
+/* Minimum stack size of the threads, since the C library of the host needs more
+   stack than the framework tasks are configured with */
+#ifndef gHostMinStackSize_c
+#define gHostMinStackSize_c           (64 * 1024)
+#endif
+
+/* Period of the peripheral thread, which advances the RTC */
+#ifndef gHostTickPeriodUs_c
+#define gHostTickPeriodUs_c           (1000)
+#endif
+
+/* Models the LTC and the eDMA, see Host_Ltc.c. The framework is built without
+   them; the seclib_ltc suite builds SecLib a second time on the model. */
+#ifndef gHostLtcModel_d
+#define gHostLtcModel_d               (0)
+#endif
+
+/* Time taken by the LTC model to process one AES block of an eDMA transfer */
+#ifndef gHostLtcBlockUs_c
+#define gHostLtcBlockUs_c             (10)
+#endif
+
+/* Built with RNG.c and its CTR_DRBG, unseeded since the host has no TRNG, instead
+   of Host_Rng.c, which reads the kernel generator. Only the rng suite sets it. */
+#ifndef gHostRngDrbg_d
+#define gHostRngDrbg_d                (0)
+#endif
+
+/* Models an external data flash behind the EEPROM API, see Host_Eeprom.c. The
+   framework is built without it; the ota suites build OtaSupport on the model. */
+#ifndef gHostEepromModel_d
+#define gHostEepromModel_d            (0)
+#endif
+
+/* Time taken by the data flash model to program a page, and to erase */
+#ifndef gHostEepromPageProgramUs_c
+#define gHostEepromPageProgramUs_c    (500)
+#endif
+
+#ifndef gHostEepromEraseUs_c
+#define gHostEepromEraseUs_c          (1000)
+#endif
+
+/* Flash image file, created if missing. The HOST_FLASH_FILE environment variable
+   overrides it. */
+#ifndef gHostFlashFileName_c
+#define gHostFlashFileName_c          "flash.bin"
+#endif
+
+/* Address of the flash image. It must be below 4 GB. No suffix: it is also used
+   in assembler expressions. */
+#ifndef gHostFlashBaseAddress_c
+#define gHostFlashBaseAddress_c       0x10000000
+#endif
+
+/* NVM storage, placed below the production data sector at the end of the flash */
+#ifndef gHostNvmSectors_c
+#define gHostNvmSectors_c             8
+#endif
+
+/* Cost of flash operations, to keep the timing of the NVM realistic. 0 disables. */
+#ifndef gHostFlashProgramUs_c
+#define gHostFlashProgramUs_c         (0)
+#endif
+
+#ifndef gHostFlashEraseUs_c
+#define gHostFlashEraseUs_c           (0)
+#endif
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public type definitions
+*************************************************************************************
+********************************************************************************** */
+#if gHostEepromModel_d
+/* Operations of the data flash model, see Host_EepromGetStats() */
+typedef struct hostEepromStats_tag
+{
+    uint32_t writes;            /* EEPROM_WriteData() calls */
+    uint32_t pagePrograms;      /* pages programmed by them */
+    uint32_t programmedBytes;
+    uint32_t reprogrammedBytes; /* bytes programmed again without an erase */
+    uint32_t busyWaits;         /* accesses which waited for the previous operation */
+} hostEepromStats_t;
+#endif
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+********************************************************************************** */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! *********************************************************************************
+* \brief  Maps the flash image, and starts the interrupt controller and the
+*         peripheral threads. Called by hardware_init().
+*
+********************************************************************************** */
+void Host_Init(void);
+
+/*! *********************************************************************************
+* \brief  Returns the time elapsed since the start of the process, in microseconds,
+*         from CLOCK_MONOTONIC
+*
+********************************************************************************** */
+uint64_t Host_GetTimeUs(void);
+
+/*! *********************************************************************************
+* \brief  Sets PRIMASK: waits for the running interrupt, if any, and keeps the
+*         interrupts from being served until Host_EnableIrq(). Used by __disable_irq().
+*
+* \remarks PRIMASK is kept per thread, like on the MCU it is kept per context: it is
+*          not a counter, and it has no effect in an interrupt handler, since the
+*          handlers do not preempt each other.
+*
+********************************************************************************** */
+void Host_DisableIrq(void);
+
+/*! *********************************************************************************
+* \brief  Clears PRIMASK. Used by __enable_irq().
+*
+********************************************************************************** */
+void Host_EnableIrq(void);
+
+/*! *********************************************************************************
+* \brief  Returns 1 if PRIMASK is set by the calling thread, 0 otherwise
+*
+********************************************************************************** */
+uint32_t Host_GetPrimask(void);
+
+/*! *********************************************************************************
+* \brief  Returns the exception number of the running handler, 0 in thread mode.
+*         Used by __get_IPSR().
+*
+********************************************************************************** */
+uint32_t Host_GetIpsr(void);
+
+/*! *********************************************************************************
+* \brief  Waits until an interrupt is served, or for one tick at most. Used by
+*         __WFI().
+*
+********************************************************************************** */
+void Host_WaitForInterrupt(void);
+
+/*! *********************************************************************************
+* \brief  Installs the handler of a device interrupt
+*
+* \param[in]  irq     - device interrupt number
+* \param[in]  handler - the handler
+*
+********************************************************************************** */
+void Host_InstallIrqHandler(int32_t irq, void (*handler)(void));
+
+/*! *********************************************************************************
+* \brief  NVIC stand-ins: enable, disable, pend and unpend a device interrupt.
+*         Pending an interrupt is how a peripheral model raises it.
+*
+* \param[in]  irq - device interrupt number
+*
+********************************************************************************** */
+void     Host_NvicEnableIrq(int32_t irq);
+void     Host_NvicDisableIrq(int32_t irq);
+void     Host_NvicSetPendingIrq(int32_t irq);
+void     Host_NvicClearPendingIrq(int32_t irq);
+uint32_t Host_NvicGetPendingIrq(int32_t irq);
+
+/*! *********************************************************************************
+* \brief  Restarts the process, with the same arguments. Used by NVIC_SystemReset().
+*
+********************************************************************************** */
+void Host_SystemReset(void);
+
+/*! *********************************************************************************
+* \brief  Creates a thread which runs framework code: a task, or a peripheral model.
+*         The stack is mapped below 4 GB, since the framework keeps addresses in
+*         32 bit variables.
+*
+* \param[in]  pFunc     - thread function
+* \param[in]  pParam    - parameter of the thread function
+* \param[in]  stackSize - stack size in bytes, raised to gHostMinStackSize_c
+*
+* \return  TRUE if the thread is created, FALSE otherwise
+*
+********************************************************************************** */
+bool_t Host_ThreadCreate(void* (*pFunc)(void*), void *pParam, uint32_t stackSize);
+
+#if gHostLtcModel_d
+/*! *********************************************************************************
+* \brief  Returns the number of LTC operations started while the LTC model was
+*         processing an eDMA transfer. Any of them would corrupt the transfer.
+*
+********************************************************************************** */
+uint32_t Host_LtcGetConflicts(void);
+#endif
+
+#if gHostEepromModel_d
+/*! *********************************************************************************
+* \brief  Returns the operations of the data flash model since the last call to
+*         Host_EepromResetStats(). An OTA pipeline which never waits for the memory
+*         has no busyWaits.
+*
+********************************************************************************** */
+void Host_EepromGetStats(hostEepromStats_t *pStats);
+void Host_EepromResetStats(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HOST_H_ */
@@ -0,0 +1,55 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Configuration of a host build, included first in every translation unit
+* (-include Host_Preinclude.h). The application may define its own configuration
+* before, or instead of, the defaults below.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef _HOST_PREINCLUDE_H_
+#define _HOST_PREINCLUDE_H_
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public macros
+*************************************************************************************
+********************************************************************************** */
+
+/* Selects the Host stand-ins and the Host OSA port */
+#define CPU_HOST
+#define FSL_RTOS_HOST
+
+/* The serial interfaces are pipes or pseudo terminals, see Pipe_Adapter.h */
+#ifndef gSerialMgrUseUart_c
+#define gSerialMgrUseUart_c             (0)
+#endif
+
+#ifndef gSerialMgrUseCustomInterface_c
+#define gSerialMgrUseCustomInterface_c  (1)
+#endif
+
+/* No low power mode: the host process never sleeps */
+#ifndef cPWR_UsePowerDownMode
+#define cPWR_UsePowerDownMode           (0)
+#endif
+
+/* The random seed is taken from the unique id modelled in SIM */
+#ifndef gRNG_UsePhyRngForInitialSeed_d
+#define gRNG_UsePhyRngForInitialSeed_d  (0)
+#endif
+
+/* The default pools, and one block for the context of the SecLib P-256 operations */
+#if gSecLibSwEcP256_d && !defined(PoolsDetails_c)
+#define PoolsDetails_c \
+         _block_size_  64  _number_of_blocks_    8 _pool_id_(0) _eol_  \
+         _block_size_ 128  _number_of_blocks_    2 _pool_id_(0) _eol_  \
+         _block_size_ 256  _number_of_blocks_    6 _pool_id_(0) _eol_  \
+         _block_size_ 1024 _number_of_blocks_    1 _pool_id_(0) _eol_
+#endif
+
+#endif /* _HOST_PREINCLUDE_H_ */
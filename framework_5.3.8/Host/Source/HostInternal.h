@@ -0,0 +1,42 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* This is the private header file for the Host platform.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef _HOST_INTERNAL_H_
+#define _HOST_INTERNAL_H_
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include "EmbeddedTypes.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+********************************************************************************** */
+
+/*! *********************************************************************************
+* \brief  Advances the RTC model to the current time. Called by the peripheral
+*         thread every gHostTickPeriodUs_c, with PRIMASK set.
+*
+********************************************************************************** */
+void Host_RtcUpdate(void);
+
+/*! *********************************************************************************
+* \brief  Maps the flash image file at gHostFlashBaseAddress_c. Called by Host_Init()
+*         and by FLASH_Init().
+*
+********************************************************************************** */
+void Host_FlashInit(void);
+
+#endif /* _HOST_INTERNAL_H_ */
@@ -0,0 +1,86 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* This is the source file for the board stand-ins of the Host platform: the
+* functions of the board files of an application, which the framework calls.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include "Host.h"
+#include "mcux_board.h"
+#include "pin_mux.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+********************************************************************************** */
+
+/* The TPM runs from the 32 MHz oscillator, as on the MCU */
+#define mHostTpmClockHz_c    (BOARD_XTAL0_CLK_HZ)
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+
+/*! *********************************************************************************
+* \brief  Initializes the platform. Called by main(), before the first task starts.
+*
+********************************************************************************** */
+void hardware_init(void)
+{
+    Host_Init();
+    BOARD_InitPins();
+    BOARD_BootClockRUN();
+    BOARD_InitDebugConsole();
+}
+
+/*! *********************************************************************************
+* \brief  The clocks and the pins need no configuration
+*
+********************************************************************************** */
+void BOARD_BootClockRUN(void)
+{
+}
+
+void BOARD_InitPins(void)
+{
+}
+
+/*! *********************************************************************************
+* \brief  The debug console is the standard output of the process
+*
+********************************************************************************** */
+void BOARD_InitDebugConsole(void)
+{
+}
+
+/*! *********************************************************************************
+* \brief  Returns the input clock of a TPM instance
+*
+********************************************************************************** */
+uint32_t BOARD_GetTpmClock(uint32_t instance)
+{
+    (void)instance;
+    return mHostTpmClockHz_c;
+}
+
+/*! *********************************************************************************
+* \brief  There is no radio: the LQI requested through FSCI is always 0
+*
+********************************************************************************** */
+uint8_t PhyGetLastRxLqiValue(void)
+{
+    return 0;
+}
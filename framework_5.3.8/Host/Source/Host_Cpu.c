@@ -0,0 +1,483 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* This is the source file for the core model of the Host platform: PRIMASK, the
+* NVIC, the interrupt handlers and the peripheral thread.
+*
+* PRIMASK is a mutex. A thread which sets PRIMASK holds it, and the NVIC thread
+* holds it while a handler runs, so a handler never runs inside a critical section
+* and the critical sections of all the threads exclude each other. The handlers
+* run one at a time, in the NVIC thread, the lowest interrupt number first.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#define _GNU_SOURCE
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "Host.h"
+#include "HostInternal.h"
+#include "fsl_device_registers.h"
+#include "clock_config.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+********************************************************************************** */
+
+/* Exception number of the first device interrupt, as read from IPSR */
+#define mHostIrqExceptionBase_c   (16)
+
+#if !defined(MAP_32BIT)
+#define MAP_32BIT                 (0)
+#endif
+
+#define mHostCmdLineSize_c        (4096)
+#define mHostMaxArgs_c            (64)
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+********************************************************************************** */
+static void* Host_NvicThread(void *pParam);
+static void* Host_PeripheralThread(void *pParam);
+static void  Host_TimeAddUs(struct timespec *pTime, uint32_t us);
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public memory declarations
+*************************************************************************************
+********************************************************************************** */
+SysTick_Type gHostSysTick;
+SCB_Type     gHostScb;
+SIM_Type     gHostSim;
+uint32_t     SystemCoreClock = BOARD_BOOTCLOCKRUN_CORE_CLOCK;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+********************************************************************************** */
+static pthread_mutex_t mPrimaskLock = PTHREAD_MUTEX_INITIALIZER;
+static __thread uint8_t mPrimask;
+static __thread uint8_t mIpsr;
+
+/* NVIC state, and the number of handlers run, for WFI */
+static pthread_mutex_t mNvicLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  mNvicCond = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t  mWfiCond;
+static uint32_t        mIrqEnabled;
+static uint32_t        mIrqPending;
+static uint32_t        mIrqServed;
+static void          (*mVectors[gHostIrqCount_c])(void);
+
+static struct timespec mStartTime;
+static uint8_t         mHostInitialized;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+
+/*! *********************************************************************************
+* \brief  Maps the flash, and starts the interrupt controller and the peripheral
+*         threads
+*
+********************************************************************************** */
+void Host_Init(void)
+{
+    pthread_condattr_t attr;
+    char name[64] = {0};
+    uint32_t hash = 2166136261U;
+    uint32_t i;
+
+    if( mHostInitialized )
+    {
+        return;
+    }
+    mHostInitialized = TRUE;
+
+    (void)Host_GetTimeUs();
+
+    /* The framework reads the production data before the NVM initializes the flash */
+    Host_FlashInit();
+
+    /* The unique id is derived from the host name: stable across runs, and
+       different between machines */
+    (void)gethostname(name, sizeof(name) - 1);
+    for( i = 0; name[i]; i++ )
+    {
+        hash = (hash ^ (uint8_t)name[i]) * 16777619U;
+    }
+    *(uint32_t*)&gHostSim.SDID  = 0x00005000U;
+    *(uint32_t*)&gHostSim.UIDMH = 0x00004857U; /* "HW" */
+    *(uint32_t*)&gHostSim.UIDML = (uint32_t)gethostid();
+    *(uint32_t*)&gHostSim.UIDL  = hash;
+
+    (void)pthread_condattr_init(&attr);
+    (void)pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    (void)pthread_cond_init(&mWfiCond, &attr);
+    (void)pthread_condattr_destroy(&attr);
+
+    if( !Host_ThreadCreate(Host_NvicThread, NULL, 0) ||
+        !Host_ThreadCreate(Host_PeripheralThread, NULL, 0) )
+    {
+        fprintf(stderr, "Host: cannot start the core threads\n");
+        abort();
+    }
+}
+
+/*! *********************************************************************************
+* \brief  Returns the time elapsed since the start of the process, in microseconds
+*
+********************************************************************************** */
+uint64_t Host_GetTimeUs(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    if( (mStartTime.tv_sec == 0) && (mStartTime.tv_nsec == 0) )
+    {
+        mStartTime = now;
+    }
+
+    /* The nanoseconds difference may be negative */
+    return (uint64_t)((int64_t)(now.tv_sec - mStartTime.tv_sec) * 1000000 +
+                      (int64_t)(now.tv_nsec - mStartTime.tv_nsec) / 1000);
+}
+
+/*! *********************************************************************************
+* \brief  Sets PRIMASK
+*
+********************************************************************************** */
+void Host_DisableIrq(void)
+{
+    if( !mPrimask && !mIpsr )
+    {
+        (void)pthread_mutex_lock(&mPrimaskLock);
+        mPrimask = 1;
+    }
+}
+
+/*! *********************************************************************************
+* \brief  Clears PRIMASK
+*
+********************************************************************************** */
+void Host_EnableIrq(void)
+{
+    if( mPrimask )
+    {
+        mPrimask = 0;
+        (void)pthread_mutex_unlock(&mPrimaskLock);
+    }
+}
+
+/*! *********************************************************************************
+* \brief  Returns PRIMASK of the calling thread
+*
+********************************************************************************** */
+uint32_t Host_GetPrimask(void)
+{
+    return mPrimask;
+}
+
+/*! *********************************************************************************
+* \brief  Returns the exception number of the running handler, 0 in thread mode
+*
+********************************************************************************** */
+uint32_t Host_GetIpsr(void)
+{
+    return mIpsr;
+}
+
+/*! *********************************************************************************
+* \brief  Waits until an interrupt is served, or for one tick at most
+*
+********************************************************************************** */
+void Host_WaitForInterrupt(void)
+{
+    struct timespec deadline;
+    uint32_t served;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &deadline);
+    Host_TimeAddUs(&deadline, gHostTickPeriodUs_c);
+
+    (void)pthread_mutex_lock(&mNvicLock);
+    served = mIrqServed;
+    while( served == mIrqServed )
+    {
+        if( ETIMEDOUT == pthread_cond_timedwait(&mWfiCond, &mNvicLock, &deadline) )
+        {
+            break;
+        }
+    }
+    (void)pthread_mutex_unlock(&mNvicLock);
+}
+
+/*! *********************************************************************************
+* \brief  Installs the handler of a device interrupt
+*
+********************************************************************************** */
+void Host_InstallIrqHandler(int32_t irq, void (*handler)(void))
+{
+    if( (irq >= 0) && (irq < gHostIrqCount_c) )
+    {
+        (void)pthread_mutex_lock(&mNvicLock);
+        mVectors[irq] = handler;
+        (void)pthread_mutex_unlock(&mNvicLock);
+    }
+}
+
+/*! *********************************************************************************
+* \brief  NVIC stand-ins. Core interrupts (negative numbers) are ignored.
+*
+********************************************************************************** */
+void Host_NvicEnableIrq(int32_t irq)
+{
+    if( (irq >= 0) && (irq < gHostIrqCount_c) )
+    {
+        (void)pthread_mutex_lock(&mNvicLock);
+        mIrqEnabled |= 1U << irq;
+        (void)pthread_cond_signal(&mNvicCond);
+        (void)pthread_mutex_unlock(&mNvicLock);
+    }
+}
+
+void Host_NvicDisableIrq(int32_t irq)
+{
+    if( (irq >= 0) && (irq < gHostIrqCount_c) )
+    {
+        (void)pthread_mutex_lock(&mNvicLock);
+        mIrqEnabled &= ~(1U << irq);
+        (void)pthread_mutex_unlock(&mNvicLock);
+    }
+}
+
+void Host_NvicSetPendingIrq(int32_t irq)
+{
+    if( (irq >= 0) && (irq < gHostIrqCount_c) )
+    {
+        (void)pthread_mutex_lock(&mNvicLock);
+        mIrqPending |= 1U << irq;
+        (void)pthread_cond_signal(&mNvicCond);
+        (void)pthread_mutex_unlock(&mNvicLock);
+    }
+}
+
+void Host_NvicClearPendingIrq(int32_t irq)
+{
+    if( (irq >= 0) && (irq < gHostIrqCount_c) )
+    {
+        (void)pthread_mutex_lock(&mNvicLock);
+        mIrqPending &= ~(1U << irq);
+        (void)pthread_mutex_unlock(&mNvicLock);
+    }
+}
+
+uint32_t Host_NvicGetPendingIrq(int32_t irq)
+{
+    uint32_t pending = 0;
+
+    if( (irq >= 0) && (irq < gHostIrqCount_c) )
+    {
+        (void)pthread_mutex_lock(&mNvicLock);
+        pending = (mIrqPending >> irq) & 1U;
+        (void)pthread_mutex_unlock(&mNvicLock);
+    }
+
+    return pending;
+}
+
+/*! *********************************************************************************
+* \brief  Restarts the process with the same arguments. The flash image is a
+*         shared mapping of a file, so its content is kept.
+*
+********************************************************************************** */
+void Host_SystemReset(void)
+{
+    static char cmdLine[mHostCmdLineSize_c];
+    char *argv[mHostMaxArgs_c + 1];
+    FILE *pFile;
+    size_t size = 0;
+    size_t i = 0;
+    uint32_t argc = 0;
+
+    pFile = fopen("/proc/self/cmdline", "rb");
+    if( pFile )
+    {
+        size = fread(cmdLine, 1, sizeof(cmdLine) - 1, pFile);
+        (void)fclose(pFile);
+    }
+
+    while( (i < size) && (argc < mHostMaxArgs_c) )
+    {
+        argv[argc++] = &cmdLine[i];
+        i += strlen(&cmdLine[i]) + 1;
+    }
+    argv[argc] = NULL;
+
+    (void)fflush(NULL);
+    if( argc )
+    {
+        (void)execv("/proc/self/exe", argv);
+    }
+
+    fprintf(stderr, "Host: reset failed\n");
+    exit(EXIT_FAILURE);
+}
+
+/*! *********************************************************************************
+* \brief  Creates a detached thread, with its stack mapped below 4 GB
+*
+********************************************************************************** */
+bool_t Host_ThreadCreate(void* (*pFunc)(void*), void *pParam, uint32_t stackSize)
+{
+    pthread_attr_t attr;
+    pthread_t thread;
+    void *pStack;
+    bool_t status = FALSE;
+
+    if( stackSize < gHostMinStackSize_c )
+    {
+        stackSize = gHostMinStackSize_c;
+    }
+
+    pStack = mmap(NULL, stackSize, PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK | MAP_32BIT, -1, 0);
+
+    if( pStack != MAP_FAILED )
+    {
+        (void)pthread_attr_init(&attr);
+        (void)pthread_attr_setstack(&attr, pStack, stackSize);
+        (void)pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+
+        if( 0 == pthread_create(&thread, &attr, pFunc, pParam) )
+        {
+            status = TRUE;
+        }
+        else
+        {
+            (void)munmap(pStack, stackSize);
+        }
+        (void)pthread_attr_destroy(&attr);
+    }
+
+    return status;
+}
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+********************************************************************************** */
+
+/*! *********************************************************************************
+* \brief  Runs the handlers of the pending and enabled interrupts, with PRIMASK
+*         held on behalf of the interrupted threads
+*
+********************************************************************************** */
+static void* Host_NvicThread(void *pParam)
+{
+    void (*handler)(void);
+    uint32_t active;
+    int32_t irq;
+
+    (void)pParam;
+    (void)pthread_mutex_lock(&mNvicLock);
+
+    while( 1 )
+    {
+        active = mIrqPending & mIrqEnabled;
+
+        if( !active )
+        {
+            (void)pthread_cond_wait(&mNvicCond, &mNvicLock);
+            continue;
+        }
+
+        irq = __builtin_ctz(active);
+        mIrqPending &= ~(1U << irq);
+        handler = mVectors[irq];
+        (void)pthread_mutex_unlock(&mNvicLock);
+
+        if( !handler )
+        {
+            fprintf(stderr, "Host: no handler for interrupt %d\n", (int)irq);
+            abort();
+        }
+
+        (void)pthread_mutex_lock(&mPrimaskLock);
+        mIpsr = (uint8_t)(irq + mHostIrqExceptionBase_c);
+        handler();
+        mIpsr = 0;
+        (void)pthread_mutex_unlock(&mPrimaskLock);
+
+        (void)pthread_mutex_lock(&mNvicLock);
+        mIrqServed++;
+        (void)pthread_cond_broadcast(&mWfiCond);
+    }
+
+    return NULL;
+}
+
+/*! *********************************************************************************
+* \brief  Advances the peripheral models every gHostTickPeriodUs_c
+*
+********************************************************************************** */
+static void* Host_PeripheralThread(void *pParam)
+{
+    struct timespec next;
+
+    (void)pParam;
+    (void)clock_gettime(CLOCK_MONOTONIC, &next);
+
+    while( 1 )
+    {
+        Host_TimeAddUs(&next, gHostTickPeriodUs_c);
+        while( EINTR == clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL) )
+        {
+        }
+
+        Host_DisableIrq();
+        Host_RtcUpdate();
+        Host_EnableIrq();
+    }
+
+    return NULL;
+}
+
+/*! *********************************************************************************
+* \brief  Adds a number of microseconds to a time
+*
+********************************************************************************** */
+static void Host_TimeAddUs(struct timespec *pTime, uint32_t us)
+{
+    pTime->tv_sec  += us / 1000000U;
+    pTime->tv_nsec += (long)(us % 1000000U) * 1000;
+
+    if( pTime->tv_nsec >= 1000000000L )
+    {
+        pTime->tv_nsec -= 1000000000L;
+        pTime->tv_sec++;
+    }
+}
@@ -0,0 +1,624 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* This is the source file for the crypto library stand-ins of the Host platform.
+* The software crypto of SecLib is the prebuilt Cortex-M library lib_crypto, which
+* cannot be linked in a host process. This file implements the functions of the
+* library which SecLib calls, from the standards, so that SecLib builds unchanged:
+*   - sw_Aes128(), a byte oriented AES-128 which expands the key on every call,
+*     like the library does,
+*   - sw_AES128_CCM(), AES-CCM as specified by RFC 3610,
+*   - the SHA-1 and SHA-256 block functions, as specified by FIPS 180-4,
+*   - SecLib_set_rng_seed() and SecLib_get_random(), which RNG.c calls, with an
+*     xorshift32 generator: the library one is not documented.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include <string.h>
+
+#include "EmbeddedTypes.h"
+#include "SecLib.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+********************************************************************************** */
+#define mAesRounds_c         (10)
+#define mAesKeyScheduleSize_c (AES_BLOCK_SIZE * (mAesRounds_c + 1))
+
+#define mSha1Words_c         (5)
+#define mSha256Words_c       (8)
+#define mShaBlockSize_c      (64)
+
+#define mRol32(x, n)         (((x) << (n)) | ((x) >> (32 - (n))))
+#define mRor32(x, n)         (((x) >> (n)) | ((x) << (32 - (n))))
+#define mLoadBe32(p)         (((uint32_t)(p)[0] << 24) | ((uint32_t)(p)[1] << 16) | \
+                              ((uint32_t)(p)[2] <<  8) |  (uint32_t)(p)[3])
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+********************************************************************************** */
+/* The library has no header: the prototypes are those declared by SecLib.c */
+void sw_Aes128(const uint8_t *pData, const uint8_t *pKey, uint8_t enc, uint8_t *pReturnData);
+uint8_t sw_AES128_CCM(uint8_t* pInput,   uint16_t inputLen,
+                      uint8_t* pAuthData, uint16_t authDataLen,
+                      uint8_t* pNonce,    uint8_t  nonceSize,
+                      uint8_t* pKey,      uint8_t* pOutput,
+                      uint8_t* pCbcMac,   uint8_t  macSize,
+                      uint32_t flags);
+void sw_sha1_initialize_output (uint32_t *sha1_state);
+void sw_sha1_hash_n (uint8_t *msg_data, int32_t num_blks, uint32_t *sha1_state);
+void sw_sha1_hash   (uint8_t *msg_data, uint32_t *sha1_state);
+void sw_sha1_update (uint8_t *msg_data, int32_t num_blks, uint32_t *sha1_state);
+void sw_sha256_initialize_output (uint32_t *sha256_state);
+void sw_sha256_hash_n (uint8_t *msg_data, int32_t num_blks, uint32_t *sha256_state);
+void sw_sha256_hash   (uint8_t *msg_data, uint32_t *sha256_state);
+void sw_sha256_update (uint8_t *msg_data, int32_t num_blks, uint32_t *sha256_state);
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+********************************************************************************** */
+static uint8_t HostCrypto_Xtime(uint8_t x);
+static uint8_t HostCrypto_Mul(uint8_t x, uint8_t y);
+static void HostCrypto_CcmBlock(uint8_t* pBlock, uint8_t flags, const uint8_t* pNonce,
+                                uint8_t nonceSize, uint32_t value);
+static void HostCrypto_CcmMac(const uint8_t* pKey, uint8_t* pMac,
+                              const uint8_t* pData, uint32_t dataLen);
+static void HostCrypto_Sha1Block(const uint8_t* pData, uint32_t* pState);
+static void HostCrypto_Sha256Block(const uint8_t* pData, uint32_t* pState);
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+********************************************************************************** */
+static const uint8_t mHostAesSbox[256] =
+{
+    0x63, 0x7C, 0x77, 0x7B, 0xF2, 0x6B, 0x6F, 0xC5, 0x30, 0x01, 0x67, 0x2B, 0xFE, 0xD7, 0xAB, 0x76,
+    0xCA, 0x82, 0xC9, 0x7D, 0xFA, 0x59, 0x47, 0xF0, 0xAD, 0xD4, 0xA2, 0xAF, 0x9C, 0xA4, 0x72, 0xC0,
+    0xB7, 0xFD, 0x93, 0x26, 0x36, 0x3F, 0xF7, 0xCC, 0x34, 0xA5, 0xE5, 0xF1, 0x71, 0xD8, 0x31, 0x15,
+    0x04, 0xC7, 0x23, 0xC3, 0x18, 0x96, 0x05, 0x9A, 0x07, 0x12, 0x80, 0xE2, 0xEB, 0x27, 0xB2, 0x75,
+    0x09, 0x83, 0x2C, 0x1A, 0x1B, 0x6E, 0x5A, 0xA0, 0x52, 0x3B, 0xD6, 0xB3, 0x29, 0xE3, 0x2F, 0x84,
+    0x53, 0xD1, 0x00, 0xED, 0x20, 0xFC, 0xB1, 0x5B, 0x6A, 0xCB, 0xBE, 0x39, 0x4A, 0x4C, 0x58, 0xCF,
+    0xD0, 0xEF, 0xAA, 0xFB, 0x43, 0x4D, 0x33, 0x85, 0x45, 0xF9, 0x02, 0x7F, 0x50, 0x3C, 0x9F, 0xA8,
+    0x51, 0xA3, 0x40, 0x8F, 0x92, 0x9D, 0x38, 0xF5, 0xBC, 0xB6, 0xDA, 0x21, 0x10, 0xFF, 0xF3, 0xD2,
+    0xCD, 0x0C, 0x13, 0xEC, 0x5F, 0x97, 0x44, 0x17, 0xC4, 0xA7, 0x7E, 0x3D, 0x64, 0x5D, 0x19, 0x73,
+    0x60, 0x81, 0x4F, 0xDC, 0x22, 0x2A, 0x90, 0x88, 0x46, 0xEE, 0xB8, 0x14, 0xDE, 0x5E, 0x0B, 0xDB,
+    0xE0, 0x32, 0x3A, 0x0A, 0x49, 0x06, 0x24, 0x5C, 0xC2, 0xD3, 0xAC, 0x62, 0x91, 0x95, 0xE4, 0x79,
+    0xE7, 0xC8, 0x37, 0x6D, 0x8D, 0xD5, 0x4E, 0xA9, 0x6C, 0x56, 0xF4, 0xEA, 0x65, 0x7A, 0xAE, 0x08,
+    0xBA, 0x78, 0x25, 0x2E, 0x1C, 0xA6, 0xB4, 0xC6, 0xE8, 0xDD, 0x74, 0x1F, 0x4B, 0xBD, 0x8B, 0x8A,
+    0x70, 0x3E, 0xB5, 0x66, 0x48, 0x03, 0xF6, 0x0E, 0x61, 0x35, 0x57, 0xB9, 0x86, 0xC1, 0x1D, 0x9E,
+    0xE1, 0xF8, 0x98, 0x11, 0x69, 0xD9, 0x8E, 0x94, 0x9B, 0x1E, 0x87, 0xE9, 0xCE, 0x55, 0x28, 0xDF,
+    0x8C, 0xA1, 0x89, 0x0D, 0xBF, 0xE6, 0x42, 0x68, 0x41, 0x99, 0x2D, 0x0F, 0xB0, 0x54, 0xBB, 0x16
+};
+
+static const uint8_t mHostAesInvSbox[256] =
+{
+    0x52, 0x09, 0x6A, 0xD5, 0x30, 0x36, 0xA5, 0x38, 0xBF, 0x40, 0xA3, 0x9E, 0x81, 0xF3, 0xD7, 0xFB,
+    0x7C, 0xE3, 0x39, 0x82, 0x9B, 0x2F, 0xFF, 0x87, 0x34, 0x8E, 0x43, 0x44, 0xC4, 0xDE, 0xE9, 0xCB,
+    0x54, 0x7B, 0x94, 0x32, 0xA6, 0xC2, 0x23, 0x3D, 0xEE, 0x4C, 0x95, 0x0B, 0x42, 0xFA, 0xC3, 0x4E,
+    0x08, 0x2E, 0xA1, 0x66, 0x28, 0xD9, 0x24, 0xB2, 0x76, 0x5B, 0xA2, 0x49, 0x6D, 0x8B, 0xD1, 0x25,
+    0x72, 0xF8, 0xF6, 0x64, 0x86, 0x68, 0x98, 0x16, 0xD4, 0xA4, 0x5C, 0xCC, 0x5D, 0x65, 0xB6, 0x92,
+    0x6C, 0x70, 0x48, 0x50, 0xFD, 0xED, 0xB9, 0xDA, 0x5E, 0x15, 0x46, 0x57, 0xA7, 0x8D, 0x9D, 0x84,
+    0x90, 0xD8, 0xAB, 0x00, 0x8C, 0xBC, 0xD3, 0x0A, 0xF7, 0xE4, 0x58, 0x05, 0xB8, 0xB3, 0x45, 0x06,
+    0xD0, 0x2C, 0x1E, 0x8F, 0xCA, 0x3F, 0x0F, 0x02, 0xC1, 0xAF, 0xBD, 0x03, 0x01, 0x13, 0x8A, 0x6B,
+    0x3A, 0x91, 0x11, 0x41, 0x4F, 0x67, 0xDC, 0xEA, 0x97, 0xF2, 0xCF, 0xCE, 0xF0, 0xB4, 0xE6, 0x73,
+    0x96, 0xAC, 0x74, 0x22, 0xE7, 0xAD, 0x35, 0x85, 0xE2, 0xF9, 0x37, 0xE8, 0x1C, 0x75, 0xDF, 0x6E,
+    0x47, 0xF1, 0x1A, 0x71, 0x1D, 0x29, 0xC5, 0x89, 0x6F, 0xB7, 0x62, 0x0E, 0xAA, 0x18, 0xBE, 0x1B,
+    0xFC, 0x56, 0x3E, 0x4B, 0xC6, 0xD2, 0x79, 0x20, 0x9A, 0xDB, 0xC0, 0xFE, 0x78, 0xCD, 0x5A, 0xF4,
+    0x1F, 0xDD, 0xA8, 0x33, 0x88, 0x07, 0xC7, 0x31, 0xB1, 0x12, 0x10, 0x59, 0x27, 0x80, 0xEC, 0x5F,
+    0x60, 0x51, 0x7F, 0xA9, 0x19, 0xB5, 0x4A, 0x0D, 0x2D, 0xE5, 0x7A, 0x9F, 0x93, 0xC9, 0x9C, 0xEF,
+    0xA0, 0xE0, 0x3B, 0x4D, 0xAE, 0x2A, 0xF5, 0xB0, 0xC8, 0xEB, 0xBB, 0x3C, 0x83, 0x53, 0x99, 0x61,
+    0x17, 0x2B, 0x04, 0x7E, 0xBA, 0x77, 0xD6, 0x26, 0xE1, 0x69, 0x14, 0x63, 0x55, 0x21, 0x0C, 0x7D
+};
+
+static const uint32_t mHostSha256K[64] =
+{
+    0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+    0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3, 0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+    0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+    0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+    0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13, 0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+    0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+    0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+    0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208, 0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2
+};
+
+static uint32_t mHostRngState = 1;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+
+/*! *********************************************************************************
+* \brief  Encrypts or decrypts one block with AES-128. The key is expanded on every
+*         call.
+*
+* \param[in]  pData       - 16-byte input block
+* \param[in]  pKey        - 128-bit key
+* \param[in]  enc         - 1 to encrypt, 0 to decrypt
+* \param[out] pReturnData - 16-byte output block. May be the same as pData.
+*
+********************************************************************************** */
+void sw_Aes128(const uint8_t *pData, const uint8_t *pKey, uint8_t enc, uint8_t *pReturnData)
+{
+    uint8_t w[mAesKeyScheduleSize_c];
+    uint8_t s[AES_BLOCK_SIZE];
+    uint8_t t[AES_BLOCK_SIZE];
+    uint8_t rcon = 0x01;
+    uint32_t round;
+    uint32_t i;
+    uint32_t c;
+
+    /* Key expansion */
+    memcpy(w, pKey, AES_BLOCK_SIZE);
+    for( i = AES_BLOCK_SIZE; i < mAesKeyScheduleSize_c; i += 4 )
+    {
+        if( 0 == (i % AES_BLOCK_SIZE) )
+        {
+            w[i]     = w[i - 16] ^ mHostAesSbox[w[i - 3]] ^ rcon;
+            w[i + 1] = w[i - 15] ^ mHostAesSbox[w[i - 2]];
+            w[i + 2] = w[i - 14] ^ mHostAesSbox[w[i - 1]];
+            w[i + 3] = w[i - 13] ^ mHostAesSbox[w[i - 4]];
+            rcon = HostCrypto_Xtime(rcon);
+        }
+        else
+        {
+            w[i]     = w[i - 16] ^ w[i - 4];
+            w[i + 1] = w[i - 15] ^ w[i - 3];
+            w[i + 2] = w[i - 14] ^ w[i - 2];
+            w[i + 3] = w[i - 13] ^ w[i - 1];
+        }
+    }
+
+    memcpy(s, pData, AES_BLOCK_SIZE);
+
+    if( enc )
+    {
+        for( i = 0; i < AES_BLOCK_SIZE; i++ )
+        {
+            s[i] ^= w[i];
+        }
+
+        for( round = 1; round <= mAesRounds_c; round++ )
+        {
+            /* SubBytes and ShiftRows: byte i of column c comes from column c + i */
+            for( c = 0; c < 4; c++ )
+            {
+                for( i = 0; i < 4; i++ )
+                {
+                    t[4 * c + i] = mHostAesSbox[s[(4 * (c + i) + i) % AES_BLOCK_SIZE]];
+                }
+            }
+
+            /* MixColumns, except in the last round */
+            for( c = 0; c < 4; c++ )
+            {
+                uint8_t* p = &t[4 * c];
+
+                if( round != mAesRounds_c )
+                {
+                    uint8_t a0 = p[0], a1 = p[1], a2 = p[2], a3 = p[3];
+                    uint8_t all = a0 ^ a1 ^ a2 ^ a3;
+
+                    p[0] ^= all ^ HostCrypto_Xtime(a0 ^ a1);
+                    p[1] ^= all ^ HostCrypto_Xtime(a1 ^ a2);
+                    p[2] ^= all ^ HostCrypto_Xtime(a2 ^ a3);
+                    p[3] ^= all ^ HostCrypto_Xtime(a3 ^ a0);
+                }
+
+                for( i = 0; i < 4; i++ )
+                {
+                    s[4 * c + i] = p[i] ^ w[AES_BLOCK_SIZE * round + 4 * c + i];
+                }
+            }
+        }
+    }
+    else
+    {
+        for( i = 0; i < AES_BLOCK_SIZE; i++ )
+        {
+            s[i] ^= w[AES_BLOCK_SIZE * mAesRounds_c + i];
+        }
+
+        for( round = mAesRounds_c; round > 0; round-- )
+        {
+            /* InvShiftRows and InvSubBytes: byte i of column c goes to column c + i */
+            for( c = 0; c < 4; c++ )
+            {
+                for( i = 0; i < 4; i++ )
+                {
+                    t[(4 * (c + i) + i) % AES_BLOCK_SIZE] = mHostAesInvSbox[s[4 * c + i]];
+                }
+            }
+
+            for( i = 0; i < AES_BLOCK_SIZE; i++ )
+            {
+                s[i] = t[i] ^ w[AES_BLOCK_SIZE * (round - 1) + i];
+            }
+
+            /* InvMixColumns, except after the last round */
+            if( round != 1 )
+            {
+                for( c = 0; c < 4; c++ )
+                {
+                    uint8_t* p = &s[4 * c];
+                    uint8_t a0 = p[0], a1 = p[1], a2 = p[2], a3 = p[3];
+
+                    p[0] = HostCrypto_Mul(a0, 14) ^ HostCrypto_Mul(a1, 11) ^ HostCrypto_Mul(a2, 13) ^ HostCrypto_Mul(a3, 9);
+                    p[1] = HostCrypto_Mul(a0, 9)  ^ HostCrypto_Mul(a1, 14) ^ HostCrypto_Mul(a2, 11) ^ HostCrypto_Mul(a3, 13);
+                    p[2] = HostCrypto_Mul(a0, 13) ^ HostCrypto_Mul(a1, 9)  ^ HostCrypto_Mul(a2, 14) ^ HostCrypto_Mul(a3, 11);
+                    p[3] = HostCrypto_Mul(a0, 11) ^ HostCrypto_Mul(a1, 13) ^ HostCrypto_Mul(a2, 9)  ^ HostCrypto_Mul(a3, 14);
+                }
+            }
+        }
+    }
+
+    memcpy(pReturnData, s, AES_BLOCK_SIZE);
+}
+
+/*! *********************************************************************************
+* \brief  Encrypts and authenticates, or decrypts and verifies, a message with
+*         AES-128-CCM (RFC 3610)
+*
+* \return  0 on success, 1 if the parameters are invalid or the MAC does not match
+*
+********************************************************************************** */
+uint8_t sw_AES128_CCM(uint8_t* pInput,   uint16_t inputLen,
+                      uint8_t* pAuthData, uint16_t authDataLen,
+                      uint8_t* pNonce,    uint8_t  nonceSize,
+                      uint8_t* pKey,      uint8_t* pOutput,
+                      uint8_t* pCbcMac,   uint8_t  macSize,
+                      uint32_t flags)
+{
+    uint8_t mac[AES_BLOCK_SIZE];
+    uint8_t block[AES_BLOCK_SIZE];
+    uint8_t stream[AES_BLOCK_SIZE];
+    uint8_t lengthSize = 15 - nonceSize;
+    uint8_t diff = 0;
+    uint32_t offset;
+    uint32_t size;
+    uint32_t i;
+
+    if( (nonceSize < 7) || (nonceSize > 13) || (macSize < 4) || (macSize > 16) || (macSize & 1) )
+    {
+        return 1;
+    }
+
+    /* B0: flags, nonce and message length */
+    HostCrypto_CcmBlock(block, (uint8_t)(((authDataLen ? 1 : 0) << 6) | (((macSize - 2) / 2) << 3) | (lengthSize - 1)),
+                        pNonce, nonceSize, inputLen);
+    sw_Aes128(block, pKey, 1, mac);
+
+    /* Authenticated data, prefixed by its length. authDataLen is lower than 0xFF00. */
+    if( authDataLen )
+    {
+        memset(block, 0, AES_BLOCK_SIZE);
+        block[0] = (uint8_t)(authDataLen >> 8);
+        block[1] = (uint8_t)authDataLen;
+        size = (authDataLen < AES_BLOCK_SIZE - 2) ? authDataLen : AES_BLOCK_SIZE - 2;
+        memcpy(&block[2], pAuthData, size);
+        HostCrypto_CcmMac(pKey, mac, block, AES_BLOCK_SIZE);
+        HostCrypto_CcmMac(pKey, mac, pAuthData + size, authDataLen - size);
+    }
+
+    /* Plain text: the input when encrypting, the output when decrypting */
+    for( offset = 0; offset < inputLen; offset += AES_BLOCK_SIZE )
+    {
+        size = inputLen - offset;
+        if( size > AES_BLOCK_SIZE )
+        {
+            size = AES_BLOCK_SIZE;
+        }
+
+        HostCrypto_CcmBlock(block, lengthSize - 1, pNonce, nonceSize, offset / AES_BLOCK_SIZE + 1);
+        sw_Aes128(block, pKey, 1, stream);
+
+        for( i = 0; i < size; i++ )
+        {
+            pOutput[offset + i] = pInput[offset + i] ^ stream[i];
+        }
+
+        HostCrypto_CcmMac(pKey, mac, (flags & gSecLib_CCM_Decrypt_c) ? &pOutput[offset] : &pInput[offset], size);
+    }
+
+    /* The MAC is encrypted with the counter block 0 */
+    HostCrypto_CcmBlock(block, lengthSize - 1, pNonce, nonceSize, 0);
+    sw_Aes128(block, pKey, 1, stream);
+
+    for( i = 0; i < macSize; i++ )
+    {
+        if( flags & gSecLib_CCM_Decrypt_c )
+        {
+            diff |= pCbcMac[i] ^ mac[i] ^ stream[i];
+        }
+        else
+        {
+            pCbcMac[i] = mac[i] ^ stream[i];
+        }
+    }
+
+    return (diff != 0) ? 1 : 0;
+}
+
+/*! *********************************************************************************
+* \brief  SHA-1 initial hash value, and block functions
+*
+********************************************************************************** */
+void sw_sha1_initialize_output(uint32_t *sha1_state)
+{
+    sha1_state[0] = 0x67452301;
+    sha1_state[1] = 0xEFCDAB89;
+    sha1_state[2] = 0x98BADCFE;
+    sha1_state[3] = 0x10325476;
+    sha1_state[4] = 0xC3D2E1F0;
+}
+
+void sw_sha1_hash_n(uint8_t *msg_data, int32_t num_blks, uint32_t *sha1_state)
+{
+    while( num_blks-- > 0 )
+    {
+        HostCrypto_Sha1Block(msg_data, sha1_state);
+        msg_data += mShaBlockSize_c;
+    }
+}
+
+void sw_sha1_hash(uint8_t *msg_data, uint32_t *sha1_state)
+{
+    sw_sha1_hash_n(msg_data, 1, sha1_state);
+}
+
+void sw_sha1_update(uint8_t *msg_data, int32_t num_blks, uint32_t *sha1_state)
+{
+    sw_sha1_initialize_output(sha1_state);
+    sw_sha1_hash_n(msg_data, num_blks, sha1_state);
+}
+
+/*! *********************************************************************************
+* \brief  SHA-256 initial hash value, and block functions
+*
+********************************************************************************** */
+void sw_sha256_initialize_output(uint32_t *sha256_state)
+{
+    sha256_state[0] = 0x6A09E667;
+    sha256_state[1] = 0xBB67AE85;
+    sha256_state[2] = 0x3C6EF372;
+    sha256_state[3] = 0xA54FF53A;
+    sha256_state[4] = 0x510E527F;
+    sha256_state[5] = 0x9B05688C;
+    sha256_state[6] = 0x1F83D9AB;
+    sha256_state[7] = 0x5BE0CD19;
+}
+
+void sw_sha256_hash_n(uint8_t *msg_data, int32_t num_blks, uint32_t *sha256_state)
+{
+    while( num_blks-- > 0 )
+    {
+        HostCrypto_Sha256Block(msg_data, sha256_state);
+        msg_data += mShaBlockSize_c;
+    }
+}
+
+void sw_sha256_hash(uint8_t *msg_data, uint32_t *sha256_state)
+{
+    sw_sha256_hash_n(msg_data, 1, sha256_state);
+}
+
+void sw_sha256_update(uint8_t *msg_data, int32_t num_blks, uint32_t *sha256_state)
+{
+    sw_sha256_initialize_output(sha256_state);
+    sw_sha256_hash_n(msg_data, num_blks, sha256_state);
+}
+
+/*! *********************************************************************************
+* \brief  Seeds the generator of SecLib_get_random(). A zero seed is not used, it
+*         would stop the generator.
+*
+* \return  0
+*
+********************************************************************************** */
+uint32_t SecLib_set_rng_seed(uint32_t seed)
+{
+    mHostRngState = seed ? seed : 1;
+
+    return 0;
+}
+
+uint32_t SecLib_get_random(void)
+{
+    mHostRngState ^= mHostRngState << 13;
+    mHostRngState ^= mHostRngState >> 17;
+    mHostRngState ^= mHostRngState << 5;
+
+    return mHostRngState;
+}
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+********************************************************************************** */
+
+/*! *********************************************************************************
+* \brief  Multiplication by x, and by any byte, in GF(2^8)
+*
+********************************************************************************** */
+static uint8_t HostCrypto_Xtime(uint8_t x)
+{
+    return (uint8_t)((x << 1) ^ ((x & 0x80) ? 0x1B : 0x00));
+}
+
+static uint8_t HostCrypto_Mul(uint8_t x, uint8_t y)
+{
+    uint8_t r = 0;
+
+    while( y )
+    {
+        if( y & 1 )
+        {
+            r ^= x;
+        }
+        x = HostCrypto_Xtime(x);
+        y >>= 1;
+    }
+
+    return r;
+}
+
+/*! *********************************************************************************
+* \brief  Builds a CCM block: flags, nonce, and a big endian value in the remaining
+*         bytes (message length for B0, counter for A0..An)
+*
+********************************************************************************** */
+static void HostCrypto_CcmBlock(uint8_t* pBlock, uint8_t flags, const uint8_t* pNonce,
+                                uint8_t nonceSize, uint32_t value)
+{
+    uint32_t i;
+
+    pBlock[0] = flags;
+    memcpy(&pBlock[1], pNonce, nonceSize);
+
+    for( i = AES_BLOCK_SIZE - 1; i > nonceSize; i-- )
+    {
+        pBlock[i] = (uint8_t)value;
+        value >>= 8;
+    }
+}
+
+/*! *********************************************************************************
+* \brief  Adds data to the CBC-MAC of CCM, zero padded to a whole number of blocks
+*
+********************************************************************************** */
+static void HostCrypto_CcmMac(const uint8_t* pKey, uint8_t* pMac,
+                              const uint8_t* pData, uint32_t dataLen)
+{
+    uint32_t i;
+
+    while( dataLen )
+    {
+        for( i = 0; (i < AES_BLOCK_SIZE) && dataLen; i++, dataLen-- )
+        {
+            pMac[i] ^= *pData++;
+        }
+        sw_Aes128(pMac, pKey, 1, pMac);
+    }
+}
+
+/*! *********************************************************************************
+* \brief  SHA-1 compression of one 64-byte block
+*
+********************************************************************************** */
+static void HostCrypto_Sha1Block(const uint8_t* pData, uint32_t* pState)
+{
+    uint32_t w[80];
+    uint32_t a = pState[0], b = pState[1], c = pState[2], d = pState[3], e = pState[4];
+    uint32_t f, k, t;
+    uint32_t i;
+
+    for( i = 0; i < 16; i++ )
+    {
+        w[i] = mLoadBe32(pData + 4 * i);
+    }
+    for( ; i < 80; i++ )
+    {
+        w[i] = mRol32(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+    }
+
+    for( i = 0; i < 80; i++ )
+    {
+        if( i < 20 )
+        {
+            f = (b & c) | (~b & d);
+            k = 0x5A827999;
+        }
+        else if( i < 40 )
+        {
+            f = b ^ c ^ d;
+            k = 0x6ED9EBA1;
+        }
+        else if( i < 60 )
+        {
+            f = (b & c) | (b & d) | (c & d);
+            k = 0x8F1BBCDC;
+        }
+        else
+        {
+            f = b ^ c ^ d;
+            k = 0xCA62C1D6;
+        }
+
+        t = mRol32(a, 5) + f + e + k + w[i];
+        e = d;
+        d = c;
+        c = mRol32(b, 30);
+        b = a;
+        a = t;
+    }
+
+    pState[0] += a;
+    pState[1] += b;
+    pState[2] += c;
+    pState[3] += d;
+    pState[4] += e;
+}
+
+/*! *********************************************************************************
+* \brief  SHA-256 compression of one 64-byte block
+*
+********************************************************************************** */
+static void HostCrypto_Sha256Block(const uint8_t* pData, uint32_t* pState)
+{
+    uint32_t w[64];
+    uint32_t v[mSha256Words_c];
+    uint32_t t1, t2;
+    uint32_t i;
+
+    for( i = 0; i < 16; i++ )
+    {
+        w[i] = mLoadBe32(pData + 4 * i);
+    }
+    for( ; i < 64; i++ )
+    {
+        w[i] = (mRor32(w[i - 2], 17) ^ mRor32(w[i - 2], 19) ^ (w[i - 2] >> 10)) + w[i - 7] +
+               (mRor32(w[i - 15], 7) ^ mRor32(w[i - 15], 18) ^ (w[i - 15] >> 3)) + w[i - 16];
+    }
+
+    memcpy(v, pState, sizeof(v));
+
+    for( i = 0; i < 64; i++ )
+    {
+        t1 = v[7] + (mRor32(v[4], 6) ^ mRor32(v[4], 11) ^ mRor32(v[4], 25)) +
+             ((v[4] & v[5]) ^ (~v[4] & v[6])) + mHostSha256K[i] + w[i];
+        t2 = (mRor32(v[0], 2) ^ mRor32(v[0], 13) ^ mRor32(v[0], 22)) +
+             ((v[0] & v[1]) ^ (v[0] & v[2]) ^ (v[1] & v[2]));
+        v[7] = v[6];
+        v[6] = v[5];
+        v[5] = v[4];
+        v[4] = v[3] + t1;
+        v[3] = v[2];
+        v[2] = v[1];
+        v[1] = v[0];
+        v[0] = t1 + t2;
+    }
+
+    for( i = 0; i < mSha256Words_c; i++ )
+    {
+        pState[i] += v[i];
+    }
+}
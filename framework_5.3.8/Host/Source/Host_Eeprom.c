@@ -0,0 +1,192 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* This is the source file for the external data flash model of the Host platform,
+* built with gHostEepromModel_d. It implements the EEPROM API of Eeprom.h on a RAM
+* array, for the OtaSupport suites.
+*
+* Like the AT45DB devices, a write programs whole pages: the memory stays busy for
+* gHostEepromPageProgramUs_c per page written, and an erase for gHostEepromEraseUs_c.
+* The functions wait for the end of the previous operation, as the drivers do with
+* EEPROM_isBusy(); such waits are counted, and so are the bytes programmed twice
+* without an erase, see Host_EepromGetStats(). The model is not thread safe, like
+* the drivers, which are only called from the OTA task.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include <string.h>
+
+#include "Host.h"
+#include "Eeprom.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+********************************************************************************** */
+#define mHostEepromSize_c         gEepromParams_TotalSize_c
+#define mHostEepromPageSize_c     (256)
+#define mHostEepromErased_c       (0xFF)
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+********************************************************************************** */
+static void HostEeprom_WaitForReady(void);
+static void HostEeprom_Erase(uint32_t address, uint32_t size);
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+********************************************************************************** */
+static uint8_t           mHostEeprom[mHostEepromSize_c];
+/* Bytes programmed since the last erase, one bit each */
+static uint8_t           mHostEepromProgrammed[mHostEepromSize_c / 8];
+static bool_t            mHostEepromInitialized;
+static uint64_t          mHostEepromBusyUntilUs;
+static hostEepromStats_t mHostEepromStats;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+
+/*! *********************************************************************************
+* \brief  Erases the memory the first time, like a new device. The content is then
+*         kept, as in the device.
+*
+********************************************************************************** */
+ee_err_t EEPROM_Init(void)
+{
+    if( !mHostEepromInitialized )
+    {
+        HostEeprom_Erase(0, mHostEepromSize_c);
+        mHostEepromInitialized = TRUE;
+    }
+
+    return ee_ok;
+}
+
+ee_err_t EEPROM_ReadData(uint16_t NoOfBytes, uint32_t Addr, uint8_t *inbuf)
+{
+    if( ((uint64_t)Addr + NoOfBytes) > mHostEepromSize_c )
+    {
+        return ee_too_big;
+    }
+
+    HostEeprom_WaitForReady();
+    memcpy(inbuf, &mHostEeprom[Addr], NoOfBytes);
+
+    return ee_ok;
+}
+
+ee_err_t EEPROM_WriteData(uint32_t NoOfBytes, uint32_t Addr, uint8_t *Outbuf)
+{
+    uint32_t pages;
+    uint32_t i;
+
+    if( ((uint64_t)Addr + NoOfBytes) > mHostEepromSize_c )
+    {
+        return ee_too_big;
+    }
+
+    if( 0 == NoOfBytes )
+    {
+        return ee_ok;
+    }
+
+    HostEeprom_WaitForReady();
+
+    for( i = Addr; i < Addr + NoOfBytes; i++ )
+    {
+        if( mHostEepromProgrammed[i >> 3] & (1U << (i & 0x07)) )
+        {
+            mHostEepromStats.reprogrammedBytes++;
+        }
+        mHostEepromProgrammed[i >> 3] |= (uint8_t)(1U << (i & 0x07));
+    }
+    memcpy(&mHostEeprom[Addr], Outbuf, NoOfBytes);
+
+    pages = ((Addr + NoOfBytes - 1) / mHostEepromPageSize_c) - (Addr / mHostEepromPageSize_c) + 1;
+    mHostEepromStats.writes++;
+    mHostEepromStats.pagePrograms += pages;
+    mHostEepromStats.programmedBytes += NoOfBytes;
+    mHostEepromBusyUntilUs = Host_GetTimeUs() + (uint64_t)pages * gHostEepromPageProgramUs_c;
+
+    return ee_ok;
+}
+
+uint8_t EEPROM_isBusy(void)
+{
+    return (Host_GetTimeUs() < mHostEepromBusyUntilUs) ? TRUE : FALSE;
+}
+
+ee_err_t EEPROM_EraseBlock(uint32_t Addr, uint32_t size)
+{
+    uint32_t start = Addr & ~((uint32_t)gEepromParams_SectorSize_c - 1);
+
+    if( ((uint64_t)Addr + size) > mHostEepromSize_c )
+    {
+        return ee_too_big;
+    }
+
+    HostEeprom_WaitForReady();
+    HostEeprom_Erase(start, (((Addr + size - start) + gEepromParams_SectorSize_c - 1) /
+                             gEepromParams_SectorSize_c) * gEepromParams_SectorSize_c);
+
+    return ee_ok;
+}
+
+ee_err_t EEPROM_ChipErase(void)
+{
+    HostEeprom_WaitForReady();
+    HostEeprom_Erase(0, mHostEepromSize_c);
+
+    return ee_ok;
+}
+
+void Host_EepromGetStats(hostEepromStats_t *pStats)
+{
+    *pStats = mHostEepromStats;
+}
+
+void Host_EepromResetStats(void)
+{
+    memset(&mHostEepromStats, 0, sizeof(mHostEepromStats));
+}
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+********************************************************************************** */
+static void HostEeprom_WaitForReady(void)
+{
+    if( EEPROM_isBusy() )
+    {
+        mHostEepromStats.busyWaits++;
+
+        while( EEPROM_isBusy() )
+        {
+        }
+    }
+}
+
+static void HostEeprom_Erase(uint32_t address, uint32_t size)
+{
+    memset(&mHostEeprom[address], mHostEepromErased_c, size);
+    memset(&mHostEepromProgrammed[address / 8], 0, size / 8);
+    mHostEepromBusyUntilUs = Host_GetTimeUs() + gHostEepromEraseUs_c;
+}
@@ -0,0 +1,319 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* This is the source file for the program flash model of the Host platform. The
+* flash is a file mapped at gHostFlashBaseAddress_c, so the framework reads it in
+* place, like on the MCU, and its content is kept across runs and resets. The
+* symbols of the linker command file which describe the flash are defined here.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#define _GNU_SOURCE
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "Host.h"
+#include "HostInternal.h"
+#include "fsl_flash.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+********************************************************************************** */
+#define mHostFlashSize_c        (FSL_FEATURE_FLASH_PFLASH_BLOCK_COUNT * FSL_FEATURE_FLASH_PFLASH_BLOCK_SIZE)
+#define mHostFlashSectorSize_c  FSL_FEATURE_FLASH_PFLASH_BLOCK_SECTOR_SIZE
+#define mHostFlashWriteUnit_c   FSL_FEATURE_FLASH_PFLASH_BLOCK_WRITE_UNIT_SIZE
+#define mHostFlashErased_c      (0xFF)
+
+#define mHostStr_d(x)           #x
+#define mHostXStr_d(x)          mHostStr_d(x)
+
+/*
+ * Symbols of the linker command file. The production data sector is the last one,
+ * and the NVM storage is placed just below it. The NVM_TABLE section is declared
+ * here too, so that its bounds exist in a program which registers no data set.
+ */
+__asm__(
+    ".globl NV_STORAGE_SECTOR_SIZE\n"
+    ".set NV_STORAGE_SECTOR_SIZE, " mHostXStr_d(mHostFlashSectorSize_c) "\n"
+    ".globl NV_STORAGE_MAX_SECTORS\n"
+    ".set NV_STORAGE_MAX_SECTORS, " mHostXStr_d(gHostNvmSectors_c) "\n"
+    ".globl NV_STORAGE_END_ADDRESS\n"
+    ".set NV_STORAGE_END_ADDRESS, " mHostXStr_d(gHostFlashBaseAddress_c) " + "
+        mHostXStr_d(mHostFlashSize_c) " - " mHostXStr_d(mHostFlashSectorSize_c)
+        " * (1 + " mHostXStr_d(gHostNvmSectors_c) ")\n"
+    ".globl FREESCALE_PROD_DATA_BASE_ADDR\n"
+    ".set FREESCALE_PROD_DATA_BASE_ADDR, " mHostXStr_d(gHostFlashBaseAddress_c) " + "
+        mHostXStr_d(mHostFlashSize_c) " - " mHostXStr_d(mHostFlashSectorSize_c) "\n"
+    ".section NVM_TABLE, \"aw\"\n"
+    ".previous\n"
+);
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+********************************************************************************** */
+static status_t Host_FlashCheckRange(uint32_t start, uint32_t lengthInBytes, uint32_t alignment);
+static void     Host_FlashDelay(uint32_t us);
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+********************************************************************************** */
+static uint8_t *mpFlash;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+
+/*! *********************************************************************************
+* \brief  Maps the flash image file, creating it erased if missing. Called by
+*         Host_Init(), since the framework may read the flash before FLASH_Init().
+*
+********************************************************************************** */
+void Host_FlashInit(void)
+{
+    const char *pFileName = getenv("HOST_FLASH_FILE");
+    struct stat fileStat;
+    off_t oldSize = 0;
+    void *pMap;
+    int fd;
+
+    if( mpFlash )
+    {
+        return;
+    }
+
+    if( !pFileName )
+    {
+        pFileName = gHostFlashFileName_c;
+    }
+
+    fd = open(pFileName, O_RDWR | O_CREAT, 0644);
+    if( fd >= 0 )
+    {
+        if( 0 == fstat(fd, &fileStat) )
+        {
+            oldSize = fileStat.st_size;
+        }
+
+        if( (oldSize < mHostFlashSize_c) && (0 != ftruncate(fd, mHostFlashSize_c)) )
+        {
+            (void)close(fd);
+            fd = -1;
+        }
+    }
+
+    if( fd < 0 )
+    {
+        fprintf(stderr, "Host: cannot open the flash image %s\n", pFileName);
+        abort();
+    }
+
+    /* Without MAP_FIXED, an address already in use is reported instead of replaced */
+    pMap = mmap((void*)gHostFlashBaseAddress_c, mHostFlashSize_c, PROT_READ | PROT_WRITE,
+                MAP_SHARED, fd, 0);
+    (void)close(fd);
+
+    if( pMap != (void*)gHostFlashBaseAddress_c )
+    {
+        fprintf(stderr, "Host: cannot map the flash image at 0x%08X\n", gHostFlashBaseAddress_c);
+        abort();
+    }
+
+    mpFlash = (uint8_t*)pMap;
+
+    /* A new file, or the part added to a smaller one, is erased flash */
+    if( oldSize < mHostFlashSize_c )
+    {
+        memset(&mpFlash[oldSize], mHostFlashErased_c, mHostFlashSize_c - oldSize);
+    }
+}
+
+/*! *********************************************************************************
+* \brief  Maps the flash image, if not done yet, and fills the configuration
+*
+********************************************************************************** */
+status_t FLASH_Init(flash_config_t *config)
+{
+    if( !config )
+    {
+        return kStatus_FLASH_InvalidArgument;
+    }
+
+    Host_FlashInit();
+
+    config->PFlashBlockBase  = gHostFlashBaseAddress_c;
+    config->PFlashTotalSize  = mHostFlashSize_c;
+    config->PFlashBlockCount = FSL_FEATURE_FLASH_PFLASH_BLOCK_COUNT;
+    config->PFlashSectorSize = mHostFlashSectorSize_c;
+
+    return kStatus_FLASH_Success;
+}
+
+/*! *********************************************************************************
+* \brief  Programs whole write units. Programming can only clear bits.
+*
+********************************************************************************** */
+status_t FLASH_Program(flash_config_t *config, uint32_t start, uint32_t *src, uint32_t lengthInBytes)
+{
+    status_t status;
+    uint8_t *pSrc = (uint8_t*)src;
+    uint8_t *pDst;
+    uint32_t i;
+
+    if( !config || !src )
+    {
+        return kStatus_FLASH_InvalidArgument;
+    }
+
+    status = Host_FlashCheckRange(start, lengthInBytes, mHostFlashWriteUnit_c);
+
+    if( kStatus_FLASH_Success == status )
+    {
+        pDst = &mpFlash[start - gHostFlashBaseAddress_c];
+
+        for( i = 0; i < lengthInBytes; i++ )
+        {
+            pDst[i] &= pSrc[i];
+        }
+
+        Host_FlashDelay((lengthInBytes / mHostFlashWriteUnit_c) * gHostFlashProgramUs_c);
+    }
+
+    return status;
+}
+
+/*! *********************************************************************************
+* \brief  Erases whole sectors
+*
+********************************************************************************** */
+status_t FLASH_Erase(flash_config_t *config, uint32_t start, uint32_t lengthInBytes, uint32_t key)
+{
+    status_t status;
+
+    if( !config )
+    {
+        return kStatus_FLASH_InvalidArgument;
+    }
+
+    if( key != (uint32_t)kFLASH_ApiEraseKey )
+    {
+        return kStatus_FLASH_EraseKeyError;
+    }
+
+    status = Host_FlashCheckRange(start, lengthInBytes, mHostFlashSectorSize_c);
+
+    if( kStatus_FLASH_Success == status )
+    {
+        memset(&mpFlash[start - gHostFlashBaseAddress_c], mHostFlashErased_c, lengthInBytes);
+        Host_FlashDelay((lengthInBytes / mHostFlashSectorSize_c) * gHostFlashEraseUs_c);
+    }
+
+    return status;
+}
+
+/*! *********************************************************************************
+* \brief  Checks that a range of whole write units is erased
+*
+********************************************************************************** */
+status_t FLASH_VerifyErase(flash_config_t *config, uint32_t start, uint32_t lengthInBytes, flash_margin_value_t margin)
+{
+    status_t status;
+    const uint8_t *pData;
+    uint32_t i;
+
+    (void)margin;
+
+    if( !config )
+    {
+        return kStatus_FLASH_InvalidArgument;
+    }
+
+    status = Host_FlashCheckRange(start, lengthInBytes, mHostFlashWriteUnit_c);
+
+    if( kStatus_FLASH_Success == status )
+    {
+        pData = &mpFlash[start - gHostFlashBaseAddress_c];
+
+        for( i = 0; i < lengthInBytes; i++ )
+        {
+            if( pData[i] != mHostFlashErased_c )
+            {
+                status = kStatus_FLASH_CommandFailure;
+                break;
+            }
+        }
+    }
+
+    return status;
+}
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+********************************************************************************** */
+
+/*! *********************************************************************************
+* \brief  Checks the alignment and the bounds of a flash range
+*
+********************************************************************************** */
+static status_t Host_FlashCheckRange(uint32_t start, uint32_t lengthInBytes, uint32_t alignment)
+{
+    if( !mpFlash )
+    {
+        return kStatus_FLASH_AccessError;
+    }
+
+    if( (start % alignment) || (lengthInBytes % alignment) )
+    {
+        return kStatus_FLASH_AlignmentError;
+    }
+
+    if( (start < gHostFlashBaseAddress_c) ||
+        ((start - gHostFlashBaseAddress_c) > mHostFlashSize_c) ||
+        (lengthInBytes > mHostFlashSize_c - (start - gHostFlashBaseAddress_c)) )
+    {
+        return kStatus_FLASH_AddressError;
+    }
+
+    return kStatus_FLASH_Success;
+}
+
+/*! *********************************************************************************
+* \brief  Models the duration of a flash command
+*
+********************************************************************************** */
+static void Host_FlashDelay(uint32_t us)
+{
+    struct timespec delay;
+
+    if( us )
+    {
+        delay.tv_sec = us / 1000000U;
+        delay.tv_nsec = (long)(us % 1000000U) * 1000;
+        (void)nanosleep(&delay, NULL);
+    }
+}
@@ -0,0 +1,636 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* This is the source file for the LTC and eDMA model of the Host platform, built
+* with gHostLtcModel_d. The AES operations are computed by sw_Aes128() and
+* sw_AES128_CCM() of Host_Crypto.c.
+*
+* The synchronous functions complete before they return. An eDMA transfer sets
+* LTC STA[AB], and is processed by the model thread in gHostLtcBlockUs_c per block,
+* independently of PRIMASK, like the eDMA engine. Then STA[AB] is cleared, the INT
+* bits of the input and output channels are set and their interrupts are pended.
+* EDMA_HandleIRQ() of the output channel calls the LTC eDMA callback.
+*
+* An LTC operation started while an eDMA transfer runs is a conflict: it would
+* corrupt the transfer on the MCU. The model counts it, see Host_LtcGetConflicts().
+* An eDMA transfer also fails if the DMAMUX does not route the LTC requests to its
+* channels, or if the eDMA is not initialized.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include <pthread.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "Host.h"
+#include "fsl_ltc_edma.h"
+#include "fsl_dmamux.h"
+#include "SecLib.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+********************************************************************************** */
+#define mHostDmaInitialized_c     (1U << 31)
+#define mHostIrqExceptionBase_c   (16)
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+********************************************************************************** */
+typedef enum hostLtcMode_tag
+{
+    mHostLtcCtr_c,
+    mHostLtcCbcEncrypt_c,
+    mHostLtcCbcDecrypt_c
+} hostLtcMode_t;
+
+/* eDMA transfer run by the model thread */
+typedef struct hostLtcTransfer_tag
+{
+    hostLtcMode_t      mode;
+    ltc_edma_handle_t* pHandle;
+    const uint8_t*     pInput;
+    uint8_t*           pOutput;
+    uint32_t           size;
+    uint8_t*           pCounter;
+    uint8_t            key[LTC_AES_BLOCK_SIZE];
+    uint8_t            iv[LTC_AES_BLOCK_SIZE];
+} hostLtcTransfer_t;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+********************************************************************************** */
+/* Host_Crypto.c */
+void sw_Aes128(const uint8_t *pData, const uint8_t *pKey, uint8_t enc, uint8_t *pReturnData);
+uint8_t sw_AES128_CCM(uint8_t* pInput,   uint16_t inputLen,
+                      uint8_t* pAuthData, uint16_t authDataLen,
+                      uint8_t* pNonce,    uint8_t  nonceSize,
+                      uint8_t* pKey,      uint8_t* pOutput,
+                      uint8_t* pCbcMac,   uint8_t  macSize,
+                      uint32_t flags);
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+********************************************************************************** */
+static void* HostLtc_Thread(void *pParam);
+static void  HostLtc_CheckIdle(void);
+static status_t HostLtc_StartTransfer(ltc_edma_handle_t *handle, hostLtcMode_t mode, const uint8_t *input,
+                                      uint8_t *output, uint32_t size, uint8_t *iv, const uint8_t *key,
+                                      uint32_t keySize);
+static void  HostLtc_Cbc(const uint8_t *key, const uint8_t *iv, const uint8_t *input, uint8_t *output,
+                         uint32_t size, uint8_t enc);
+static void  HostLtc_Ctr(const uint8_t *key, uint8_t *counter, const uint8_t *input, uint8_t *output,
+                         uint32_t size);
+static void  HostLtc_OutputCallback(edma_handle_t *handle, void *userData, bool transferDone, uint32_t tcds);
+static void  HostDma_IrqHandler(void);
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public memory declarations
+*************************************************************************************
+********************************************************************************** */
+LTC_Type    gHostLtc;
+DMA_Type    gHostDma;
+DMAMUX_Type gHostDmaMux;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+********************************************************************************** */
+static pthread_mutex_t   mLtcLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t    mLtcCond = PTHREAD_COND_INITIALIZER;
+static hostLtcTransfer_t mLtcTransfer;
+static bool_t            mLtcThreadStarted;
+static uint32_t          mLtcConflicts;
+static edma_handle_t*    mDmaHandles[FSL_FEATURE_EDMA_MODULE_CHANNEL];
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+
+/*! *********************************************************************************
+* \brief  Returns the number of LTC operations started while an eDMA transfer ran
+*
+********************************************************************************** */
+uint32_t Host_LtcGetConflicts(void)
+{
+    return __atomic_load_n(&mLtcConflicts, __ATOMIC_SEQ_CST);
+}
+
+/*! *********************************************************************************
+* \brief  LTC driver stand-ins
+*
+********************************************************************************** */
+void LTC_Init(LTC_Type *base)
+{
+    (void)base;
+
+    (void)pthread_mutex_lock(&mLtcLock);
+    if( !mLtcThreadStarted )
+    {
+        mLtcThreadStarted = Host_ThreadCreate(HostLtc_Thread, NULL, 0);
+    }
+    (void)pthread_mutex_unlock(&mLtcLock);
+}
+
+status_t LTC_AES_EncryptEcb(LTC_Type *base, const uint8_t *plaintext, uint8_t *ciphertext, uint32_t size,
+                            const uint8_t *key, uint32_t keySize)
+{
+    uint32_t i;
+
+    (void)base;
+    HostLtc_CheckIdle();
+
+    if( (keySize != LTC_AES_BLOCK_SIZE) || (size & (LTC_AES_BLOCK_SIZE - 1)) )
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    for( i = 0; i < size; i += LTC_AES_BLOCK_SIZE )
+    {
+        sw_Aes128(&plaintext[i], key, 1, &ciphertext[i]);
+    }
+
+    return kStatus_Success;
+}
+
+status_t LTC_AES_DecryptEcb(LTC_Type *base, const uint8_t *ciphertext, uint8_t *plaintext, uint32_t size,
+                            const uint8_t *key, uint32_t keySize, ltc_aes_key_t keyType)
+{
+    uint32_t i;
+
+    (void)base;
+    HostLtc_CheckIdle();
+
+    if( (keySize != LTC_AES_BLOCK_SIZE) || (keyType != kLTC_EncryptKey) || (size & (LTC_AES_BLOCK_SIZE - 1)) )
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    for( i = 0; i < size; i += LTC_AES_BLOCK_SIZE )
+    {
+        sw_Aes128(&ciphertext[i], key, 0, &plaintext[i]);
+    }
+
+    return kStatus_Success;
+}
+
+status_t LTC_AES_EncryptCbc(LTC_Type *base, const uint8_t *plaintext, uint8_t *ciphertext, uint32_t size,
+                            const uint8_t iv[LTC_AES_IV_SIZE], const uint8_t *key, uint32_t keySize)
+{
+    (void)base;
+    HostLtc_CheckIdle();
+
+    if( (keySize != LTC_AES_BLOCK_SIZE) || (size & (LTC_AES_BLOCK_SIZE - 1)) )
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    HostLtc_Cbc(key, iv, plaintext, ciphertext, size, 1);
+    return kStatus_Success;
+}
+
+status_t LTC_AES_DecryptCbc(LTC_Type *base, const uint8_t *ciphertext, uint8_t *plaintext, uint32_t size,
+                            const uint8_t iv[LTC_AES_IV_SIZE], const uint8_t *key, uint32_t keySize,
+                            ltc_aes_key_t keyType)
+{
+    (void)base;
+    HostLtc_CheckIdle();
+
+    if( (keySize != LTC_AES_BLOCK_SIZE) || (keyType != kLTC_EncryptKey) || (size & (LTC_AES_BLOCK_SIZE - 1)) )
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    HostLtc_Cbc(key, iv, ciphertext, plaintext, size, 0);
+    return kStatus_Success;
+}
+
+status_t LTC_AES_CryptCtr(LTC_Type *base, const uint8_t *input, uint8_t *output, uint32_t size,
+                          uint8_t counter[LTC_AES_BLOCK_SIZE], const uint8_t *key, uint32_t keySize,
+                          uint8_t counterlast[LTC_AES_BLOCK_SIZE], uint32_t *szLeft)
+{
+    (void)base;
+    (void)counterlast;
+    HostLtc_CheckIdle();
+
+    if( keySize != LTC_AES_BLOCK_SIZE )
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    HostLtc_Ctr(key, counter, input, output, size);
+
+    if( szLeft != NULL )
+    {
+        *szLeft = 0;
+    }
+
+    return kStatus_Success;
+}
+
+status_t LTC_AES_EncryptTagCcm(LTC_Type *base, const uint8_t *plaintext, uint8_t *ciphertext, uint32_t size,
+                               const uint8_t *iv, uint32_t ivSize, const uint8_t *aad, uint32_t aadSize,
+                               const uint8_t *key, uint32_t keySize, uint8_t *tag, uint32_t tagSize)
+{
+    (void)base;
+    HostLtc_CheckIdle();
+
+    if( (keySize != LTC_AES_BLOCK_SIZE) || (size > 0xFFFF) || (aadSize >= 0xFF00) ||
+        sw_AES128_CCM((uint8_t*)plaintext, (uint16_t)size, (uint8_t*)aad, (uint16_t)aadSize,
+                      (uint8_t*)iv, (uint8_t)ivSize, (uint8_t*)key, ciphertext, tag, (uint8_t)tagSize,
+                      gSecLib_CCM_Encrypt_c) )
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    return kStatus_Success;
+}
+
+status_t LTC_AES_DecryptTagCcm(LTC_Type *base, const uint8_t *ciphertext, uint8_t *plaintext, uint32_t size,
+                               const uint8_t *iv, uint32_t ivSize, const uint8_t *aad, uint32_t aadSize,
+                               const uint8_t *key, uint32_t keySize, const uint8_t *tag, uint32_t tagSize)
+{
+    (void)base;
+    HostLtc_CheckIdle();
+
+    if( (keySize != LTC_AES_BLOCK_SIZE) || (size > 0xFFFF) || (aadSize >= 0xFF00) ||
+        sw_AES128_CCM((uint8_t*)ciphertext, (uint16_t)size, (uint8_t*)aad, (uint16_t)aadSize,
+                      (uint8_t*)iv, (uint8_t)ivSize, (uint8_t*)key, plaintext, (uint8_t*)tag, (uint8_t)tagSize,
+                      gSecLib_CCM_Decrypt_c) )
+    {
+        return kStatus_Fail;
+    }
+
+    return kStatus_Success;
+}
+
+/*! *********************************************************************************
+* \brief  LTC eDMA driver stand-ins
+*
+********************************************************************************** */
+void LTC_CreateHandleEDMA(LTC_Type *base, ltc_edma_handle_t *handle, ltc_edma_callback_t callback, void *userData,
+                          edma_handle_t *inputFifoEdmaHandle, edma_handle_t *outputFifoEdmaHandle)
+{
+    (void)base;
+
+    handle->callback = callback;
+    handle->userData = userData;
+    handle->inputFifoEdmaHandle = inputFifoEdmaHandle;
+    handle->outputFifoEdmaHandle = outputFifoEdmaHandle;
+
+    EDMA_SetCallback(inputFifoEdmaHandle, NULL, NULL);
+    EDMA_SetCallback(outputFifoEdmaHandle, HostLtc_OutputCallback, handle);
+}
+
+status_t LTC_AES_EncryptCbcEDMA(LTC_Type *base, ltc_edma_handle_t *handle, const uint8_t *plaintext,
+                                uint8_t *ciphertext, uint32_t size, const uint8_t iv[LTC_AES_IV_SIZE],
+                                const uint8_t *key, uint32_t keySize)
+{
+    (void)base;
+
+    if( size & (LTC_AES_BLOCK_SIZE - 1) )
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    return HostLtc_StartTransfer(handle, mHostLtcCbcEncrypt_c, plaintext, ciphertext, size,
+                                 (uint8_t*)iv, key, keySize);
+}
+
+status_t LTC_AES_DecryptCbcEDMA(LTC_Type *base, ltc_edma_handle_t *handle, const uint8_t *ciphertext,
+                                uint8_t *plaintext, uint32_t size, const uint8_t iv[LTC_AES_IV_SIZE],
+                                const uint8_t *key, uint32_t keySize, ltc_aes_key_t keyType)
+{
+    (void)base;
+
+    if( (keyType != kLTC_EncryptKey) || (size & (LTC_AES_BLOCK_SIZE - 1)) )
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    return HostLtc_StartTransfer(handle, mHostLtcCbcDecrypt_c, ciphertext, plaintext, size,
+                                 (uint8_t*)iv, key, keySize);
+}
+
+status_t LTC_AES_CryptCtrEDMA(LTC_Type *base, ltc_edma_handle_t *handle, const uint8_t *input, uint8_t *output,
+                              uint32_t size, uint8_t counter[LTC_AES_BLOCK_SIZE], const uint8_t *key,
+                              uint32_t keySize, uint8_t counterlast[LTC_AES_BLOCK_SIZE], uint32_t *szLeft)
+{
+    (void)base;
+    (void)counterlast;
+
+    if( szLeft != NULL )
+    {
+        *szLeft = 0;
+    }
+
+    return HostLtc_StartTransfer(handle, mHostLtcCtr_c, input, output, size, counter, key, keySize);
+}
+
+/*! *********************************************************************************
+* \brief  eDMA and DMAMUX driver stand-ins
+*
+********************************************************************************** */
+void EDMA_GetDefaultConfig(edma_config_t *config)
+{
+    memset(config, 0, sizeof(*config));
+    config->enableHaltOnError = true;
+}
+
+void EDMA_Init(DMA_Type *base, const edma_config_t *config)
+{
+    (void)config;
+    base->CR |= mHostDmaInitialized_c;
+}
+
+uint32_t EDMA_GetChannelStatusFlags(DMA_Type *base, uint32_t channel)
+{
+    return (__atomic_load_n(&base->INT, __ATOMIC_SEQ_CST) & (1U << channel)) ?
+           (kEDMA_DoneFlag | kEDMA_InterruptFlag) : 0;
+}
+
+void EDMA_CreateHandle(edma_handle_t *handle, DMA_Type *base, uint32_t channel)
+{
+    memset(handle, 0, sizeof(*handle));
+    handle->base = base;
+    handle->channel = (uint8_t)channel;
+    mDmaHandles[channel] = handle;
+
+    Host_InstallIrqHandler(DMA0_IRQn + (int32_t)channel, HostDma_IrqHandler);
+    Host_NvicEnableIrq(DMA0_IRQn + (int32_t)channel);
+}
+
+void EDMA_SetCallback(edma_handle_t *handle, edma_callback callback, void *userData)
+{
+    handle->callback = callback;
+    handle->userData = userData;
+}
+
+void EDMA_HandleIRQ(edma_handle_t *handle)
+{
+    (void)__atomic_fetch_and(&handle->base->INT, ~(1U << handle->channel), __ATOMIC_SEQ_CST);
+
+    if( handle->callback != NULL )
+    {
+        handle->callback(handle, handle->userData, true, 0);
+    }
+}
+
+void DMAMUX_Init(DMAMUX_Type *base)
+{
+    (void)base;
+}
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+********************************************************************************** */
+
+/*! *********************************************************************************
+* \brief  Processes the eDMA transfers
+*
+********************************************************************************** */
+static void* HostLtc_Thread(void *pParam)
+{
+    hostLtcTransfer_t* pTransfer = &mLtcTransfer;
+    uint32_t channels;
+
+    (void)pParam;
+    (void)pthread_mutex_lock(&mLtcLock);
+
+    while( 1 )
+    {
+        if( !(gHostLtc.STA & LTC_STA_AB_MASK) )
+        {
+            (void)pthread_cond_wait(&mLtcCond, &mLtcLock);
+            continue;
+        }
+
+        (void)pthread_mutex_unlock(&mLtcLock);
+
+        if( gHostLtcBlockUs_c )
+        {
+            (void)usleep(gHostLtcBlockUs_c * ((pTransfer->size + LTC_AES_BLOCK_SIZE - 1) / LTC_AES_BLOCK_SIZE));
+        }
+
+        switch( pTransfer->mode )
+        {
+        case mHostLtcCtr_c:
+            HostLtc_Ctr(pTransfer->key, pTransfer->iv, pTransfer->pInput, pTransfer->pOutput, pTransfer->size);
+            /* The counter is written back at the end of the transfer */
+            memcpy(pTransfer->pCounter, pTransfer->iv, LTC_AES_BLOCK_SIZE);
+            break;
+        case mHostLtcCbcEncrypt_c:
+            HostLtc_Cbc(pTransfer->key, pTransfer->iv, pTransfer->pInput, pTransfer->pOutput, pTransfer->size, 1);
+            break;
+        default:
+            HostLtc_Cbc(pTransfer->key, pTransfer->iv, pTransfer->pInput, pTransfer->pOutput, pTransfer->size, 0);
+            break;
+        }
+
+        channels = (1U << pTransfer->pHandle->inputFifoEdmaHandle->channel) |
+                   (1U << pTransfer->pHandle->outputFifoEdmaHandle->channel);
+
+        (void)pthread_mutex_lock(&mLtcLock);
+        gHostLtc.STA &= ~LTC_STA_AB_MASK;
+        gHostDma.ERQ &= ~channels;
+        (void)__atomic_fetch_or(&gHostDma.INT, channels, __ATOMIC_SEQ_CST);
+
+        Host_NvicSetPendingIrq(DMA0_IRQn + pTransfer->pHandle->inputFifoEdmaHandle->channel);
+        Host_NvicSetPendingIrq(DMA0_IRQn + pTransfer->pHandle->outputFifoEdmaHandle->channel);
+    }
+
+    return NULL;
+}
+
+/*! *********************************************************************************
+* \brief  Counts a synchronous operation started while an eDMA transfer runs
+*
+********************************************************************************** */
+static void HostLtc_CheckIdle(void)
+{
+    if( gHostLtc.STA & LTC_STA_AB_MASK )
+    {
+        (void)__atomic_fetch_add(&mLtcConflicts, 1, __ATOMIC_SEQ_CST);
+    }
+}
+
+/*! *********************************************************************************
+* \brief  Starts an eDMA transfer on the model thread. The key and the IV are loaded
+*         in the LTC context, the counter is updated at the end of the transfer.
+*
+********************************************************************************** */
+static status_t HostLtc_StartTransfer(ltc_edma_handle_t *handle, hostLtcMode_t mode, const uint8_t *input,
+                                      uint8_t *output, uint32_t size, uint8_t *iv, const uint8_t *key,
+                                      uint32_t keySize)
+{
+    uint8_t inputChannel = handle->inputFifoEdmaHandle->channel;
+    uint8_t outputChannel = handle->outputFifoEdmaHandle->channel;
+    status_t status = kStatus_Success;
+
+    if( (keySize != LTC_AES_BLOCK_SIZE) || (size == 0) )
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    /* The requests of the LTC FIFOs must reach the channels */
+    if( !(gHostDma.CR & mHostDmaInitialized_c) ||
+        (gHostDmaMux.CHCFG[inputChannel] != (DMAMUX_CHCFG_ENBL_MASK |
+                                             (kDmaRequestMux0LTC0InputFIFO & DMAMUX_CHCFG_SOURCE_MASK))) ||
+        (gHostDmaMux.CHCFG[outputChannel] != (DMAMUX_CHCFG_ENBL_MASK |
+                                              (kDmaRequestMux0LTC0OutputFIFO & DMAMUX_CHCFG_SOURCE_MASK))) )
+    {
+        return kStatus_Fail;
+    }
+
+    (void)pthread_mutex_lock(&mLtcLock);
+
+    if( gHostLtc.STA & LTC_STA_AB_MASK )
+    {
+        (void)__atomic_fetch_add(&mLtcConflicts, 1, __ATOMIC_SEQ_CST);
+        status = kStatus_Fail;
+    }
+    else
+    {
+        mLtcTransfer.mode = mode;
+        mLtcTransfer.pHandle = handle;
+        mLtcTransfer.pInput = input;
+        mLtcTransfer.pOutput = output;
+        mLtcTransfer.size = size;
+        mLtcTransfer.pCounter = iv;
+        memcpy(mLtcTransfer.key, key, LTC_AES_BLOCK_SIZE);
+        memcpy(mLtcTransfer.iv, iv, LTC_AES_BLOCK_SIZE);
+
+        gHostLtc.STA |= LTC_STA_AB_MASK;
+        gHostDma.ERQ |= (1U << inputChannel) | (1U << outputChannel);
+        (void)pthread_cond_signal(&mLtcCond);
+    }
+
+    (void)pthread_mutex_unlock(&mLtcLock);
+
+    return status;
+}
+
+/*! *********************************************************************************
+* \brief  AES-128-CBC. The output may be the input.
+*
+********************************************************************************** */
+static void HostLtc_Cbc(const uint8_t *key, const uint8_t *iv, const uint8_t *input, uint8_t *output,
+                        uint32_t size, uint8_t enc)
+{
+    uint8_t chain[LTC_AES_BLOCK_SIZE];
+    uint8_t block[LTC_AES_BLOCK_SIZE];
+    uint32_t offset;
+    uint32_t i;
+
+    memcpy(chain, iv, LTC_AES_BLOCK_SIZE);
+
+    for( offset = 0; offset < size; offset += LTC_AES_BLOCK_SIZE )
+    {
+        memcpy(block, &input[offset], LTC_AES_BLOCK_SIZE);
+
+        if( enc )
+        {
+            for( i = 0; i < LTC_AES_BLOCK_SIZE; i++ )
+            {
+                block[i] ^= chain[i];
+            }
+            sw_Aes128(block, key, 1, &output[offset]);
+            memcpy(chain, &output[offset], LTC_AES_BLOCK_SIZE);
+        }
+        else
+        {
+            sw_Aes128(block, key, 0, &output[offset]);
+            for( i = 0; i < LTC_AES_BLOCK_SIZE; i++ )
+            {
+                output[offset + i] ^= chain[i];
+            }
+            memcpy(chain, block, LTC_AES_BLOCK_SIZE);
+        }
+    }
+}
+
+/*! *********************************************************************************
+* \brief  AES-128-CTR. The counter is incremented once per block, the last one
+*         included.
+*
+********************************************************************************** */
+static void HostLtc_Ctr(const uint8_t *key, uint8_t *counter, const uint8_t *input, uint8_t *output,
+                        uint32_t size)
+{
+    uint8_t stream[LTC_AES_BLOCK_SIZE];
+    uint32_t offset;
+    uint32_t i;
+
+    for( offset = 0; offset < size; offset += LTC_AES_BLOCK_SIZE )
+    {
+        sw_Aes128(counter, key, 1, stream);
+
+        for( i = 0; (i < LTC_AES_BLOCK_SIZE) && (offset + i < size); i++ )
+        {
+            output[offset + i] = input[offset + i] ^ stream[i];
+        }
+
+        for( i = LTC_AES_BLOCK_SIZE; i > 0; i-- )
+        {
+            if( ++counter[i - 1] != 0 )
+            {
+                break;
+            }
+        }
+    }
+}
+
+/*! *********************************************************************************
+* \brief  Completion of the output channel: the transfer is done
+*
+********************************************************************************** */
+static void HostLtc_OutputCallback(edma_handle_t *handle, void *userData, bool transferDone, uint32_t tcds)
+{
+    ltc_edma_handle_t* pLtcHandle = (ltc_edma_handle_t*)userData;
+
+    (void)handle;
+    (void)transferDone;
+    (void)tcds;
+
+    if( pLtcHandle->callback != NULL )
+    {
+        pLtcHandle->callback(LTC0, pLtcHandle, kStatus_Success, pLtcHandle->userData);
+    }
+}
+
+/*! *********************************************************************************
+* \brief  Interrupt of an eDMA channel, as served by the SDK driver
+*
+********************************************************************************** */
+static void HostDma_IrqHandler(void)
+{
+    uint32_t channel = __get_IPSR() - mHostIrqExceptionBase_c - DMA0_IRQn;
+
+    if( (mDmaHandles[channel] != NULL) &&
+        (EDMA_GetChannelStatusFlags(DMA0, channel) & kEDMA_InterruptFlag) )
+    {
+        EDMA_HandleIRQ(mDmaHandles[channel]);
+    }
+}
@@ -0,0 +1,189 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* This is the source file for the RNG module of the Host platform. RNG.c seeds
+* its DRBG from the TRNG or RNGA of the MCU, which the host does not model, so a
+* host build replaces RNG.c by this file. All the numbers are read from the
+* random generator of the kernel.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include <errno.h>
+#include <sys/random.h>
+
+#include "EmbeddedTypes.h"
+#include "RNG_Interface.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+********************************************************************************** */
+/* Maximum number of bytes returned by RNG_GetPseudoRandomNo() */
+#define mPRNG_NoOfBytes_c (32)
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+
+/*! *********************************************************************************
+* \brief  Initialize the RNG module
+*
+* \return  gRngSuccess_d, or gRngInternalError_d if the kernel generator fails
+*
+********************************************************************************** */
+uint8_t RNG_Init(void)
+{
+    uint32_t n;
+
+    return RNG_HwGetRandomNo(&n);
+}
+
+/*! *********************************************************************************
+* \brief  Returns a 32-bit random number
+*
+* \param[out]  pRandomNo - pointer to location where the RN will be stored
+*
+********************************************************************************** */
+void RNG_GetRandomNo(uint32_t* pRandomNo)
+{
+    (void)RNG_HwGetRandomNo(pRandomNo);
+}
+
+/*! *********************************************************************************
+* \brief  Reads a 32-bit random number from the kernel generator
+*
+* \param[out]  pRandomNo - pointer to location where the RN will be stored
+*
+* \return  gRngSuccess_d, gRngNullPointer_d or gRngInternalError_d
+*
+********************************************************************************** */
+uint8_t RNG_HwGetRandomNo(uint32_t* pRandomNo)
+{
+    if( !pRandomNo )
+    {
+        return gRngNullPointer_d;
+    }
+
+    return RNG_GetBytes((uint8_t*)pRandomNo, sizeof(uint32_t));
+}
+
+/*! *********************************************************************************
+* \brief  The kernel generator seeds itself, so the seed is not used
+*
+* \param[in]  pSeed - pointer to a buffer containing 32 bytes (256 bits)
+*
+********************************************************************************** */
+void RNG_SetPseudoRandomNoSeed(uint8_t* pSeed)
+{
+    (void)pSeed;
+}
+
+/*! *********************************************************************************
+* \brief  Returns up to 32 random bytes
+*
+* \param[out]  pOut - pointer to the output buffer
+* \param[in]   outBytes - the number of bytes to be copyed (1-32)
+* \param[in]   pXSEED - optional user SEED, not used
+*
+* \return  The number of bytes copied, or -1 on error
+*
+********************************************************************************** */
+int16_t RNG_GetPseudoRandomNo(uint8_t* pOut, uint8_t outBytes, uint8_t* pXSEED)
+{
+    (void)pXSEED;
+
+    if (outBytes > mPRNG_NoOfBytes_c)
+    {
+        outBytes = mPRNG_NoOfBytes_c;
+    }
+
+    if( gRngSuccess_d != RNG_GetBytes(pOut, outBytes) )
+    {
+        return -1;
+    }
+
+    return outBytes;
+}
+
+/*! *********************************************************************************
+* \brief  Fills a buffer of any length with random bytes
+*
+* \param[out]  pOut - pointer to the output buffer
+* \param[in]   length - the number of bytes to be generated
+*
+* \return  gRngSuccess_d, gRngNullPointer_d or gRngInternalError_d
+*
+********************************************************************************** */
+uint8_t RNG_GetBytes(uint8_t* pOut, uint32_t length)
+{
+    ssize_t count;
+
+    if( (NULL == pOut) && length )
+    {
+        return gRngNullPointer_d;
+    }
+
+    while( length )
+    {
+        count = getrandom(pOut, length, 0);
+
+        if( count < 0 )
+        {
+            if( errno == EINTR )
+            {
+                continue;
+            }
+            return gRngInternalError_d;
+        }
+
+        pOut += count;
+        length -= (uint32_t)count;
+    }
+
+    return gRngSuccess_d;
+}
+
+/*! *********************************************************************************
+* \brief  Returns a random number beween 0 and 256
+*
+* \return random number
+*
+********************************************************************************** */
+uint32_t RND_u32GetRand256(void)
+{
+    uint32_t n;
+
+    RNG_GetRandomNo(&n);
+
+    return n & 0xFF;
+}
+
+/*! *********************************************************************************
+* \brief  Returns a random number beween the specified minum and maximum values
+*
+* \param[in] u32Min  minimum value
+* \param[in] u32Max  maximum value
+*
+* \return random number
+*
+********************************************************************************** */
+uint32_t RND_u32GetRand(uint32_t u32Min, uint32_t u32Max)
+{
+    uint32_t n;
+
+    RNG_GetRandomNo(&n);
+
+    return n % (u32Max - u32Min) + u32Min;
+}
@@ -0,0 +1,97 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* This is the source file for the RTC model of the Host platform. TSR and TPR
+* count at 32768 Hz while SR[TCE] is set. When TSR increments from TAR, SR[TAF] is
+* set, and the RTC interrupt is pended if IER[TAIE] is set.
+*
+* The registers are plain memory, so writes have no side effect: writing TSR does
+* not clear SR[TIF] or SR[TOF], and writing TAR does not clear SR[TAF]. The
+* interrupt is pended on the alarm event only, so a flag left set is harmless.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include "Host.h"
+#include "HostInternal.h"
+#include "fsl_device_registers.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+********************************************************************************** */
+#define mHostRtcFrequency_c       (32768U)
+#define mHostRtcPrescalerBits_c   (15)
+#define mHostRtcPrescalerMask_c   ((1U << mHostRtcPrescalerBits_c) - 1)
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public memory declarations
+*************************************************************************************
+********************************************************************************** */
+RTC_Type gHostRtc = { .CR = RTC_CR_OSCE_MASK };
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+********************************************************************************** */
+
+/* Number of 32768 Hz periods counted since the start of the process */
+static uint64_t mRtcTicks;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+
+/*! *********************************************************************************
+* \brief  Advances the RTC model to the current time
+*
+********************************************************************************** */
+void Host_RtcUpdate(void)
+{
+    uint64_t ticks = Host_GetTimeUs() * mHostRtcFrequency_c / 1000000U;
+    uint32_t elapsed = (uint32_t)(ticks - mRtcTicks);
+    uint32_t prescaler;
+    uint32_t seconds;
+
+    mRtcTicks = ticks;
+
+    if( !(gHostRtc.SR & RTC_SR_TCE_MASK) || !elapsed )
+    {
+        return;
+    }
+
+    prescaler = (gHostRtc.TPR & mHostRtcPrescalerMask_c) + elapsed;
+    seconds = prescaler >> mHostRtcPrescalerBits_c;
+    gHostRtc.TPR = prescaler & mHostRtcPrescalerMask_c;
+
+    while( seconds-- )
+    {
+        if( gHostRtc.TSR == gHostRtc.TAR )
+        {
+            gHostRtc.SR |= RTC_SR_TAF_MASK;
+
+            if( gHostRtc.IER & RTC_IER_TAIE_MASK )
+            {
+                Host_NvicSetPendingIrq(RTC_IRQn);
+            }
+        }
+
+        if( ++gHostRtc.TSR == 0 )
+        {
+            gHostRtc.SR |= RTC_SR_TOF_MASK;
+        }
+    }
+}
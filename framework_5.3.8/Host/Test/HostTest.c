@@ -0,0 +1,230 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* This is the source file of the host test runner, see HostTest.h
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "HostTest.h"
+#include "Host.h"
+#include "fsl_os_abstraction.h"
+#include "MemManager.h"
+#include "TimersManager.h"
+#include "SerialManager.h"
+#include "RNG_Interface.h"
+#include "SecLib.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+********************************************************************************** */
+static const hostTestSuite_t mHostTestSuites[] =
+{
+#if gHostLtcModel_d
+    /* SecLib built on the LTC model, see Host_Ltc.c */
+    {"seclib_ltc", Test_SecLibLtc,  FALSE},
+#elif (gCrcTableSlices_c == 4)
+    /* CRC engine with the slicing-by-4 tables */
+    {"crc",        Test_Crc,        FALSE},
+#elif gHostRngDrbg_d
+    /* RNG.c and its CTR_DRBG */
+    {"rng",        Test_Rng,        FALSE},
+#elif gOtaPipelinedWrite_d
+    /* OtaSupport with the pipelined writes */
+    {"ota",        Test_Ota,        FALSE},
+#else
+    {"osa",        Test_Osa,        FALSE},
+    {"memmanager", Test_MemManager, FALSE},
+    {"functionlib", Test_FunctionLib, FALSE},
+    {"lists",      Test_Lists,      FALSE},
+    {"messaging",  Test_Messaging,  FALSE},
+    {"timers",     Test_Timers,     FALSE},
+    {"nvm",        Test_Nvm,        FALSE},
+    {"seclib",     Test_SecLib,     FALSE},
+    {"crc",        Test_Crc,        FALSE},
+    {"scrambler",  Test_Scrambler,  FALSE},
+    {"recstore",   Test_RecStore,   FALSE},
+    {"ota",        Test_Ota,        FALSE},
+    {"profiler",   Test_Profiler,   FALSE},
+    {"serial",     Test_Serial,     TRUE},
+    {"shell",      Test_Shell,      TRUE},
+    {"fsci",       Test_Fsci,       TRUE},
+#endif
+};
+
+static uint32_t mHostTestChecks;
+static uint32_t mHostTestFailures;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+
+/*! *********************************************************************************
+* \brief  Initializes the framework, and runs the selected suites
+*
+********************************************************************************** */
+void main_task(void const *argument)
+{
+    const char* pSelected = getenv("HOST_TEST_SUITE");
+    uint32_t ran = 0;
+    uint32_t i;
+
+    (void)argument;
+
+    MEM_Init();
+    TMR_Init();
+    SerialManager_Init();
+    (void)RNG_Init();
+    SecLib_Init();
+
+    for( i = 0; i < NumberOfElements(mHostTestSuites); i++ )
+    {
+        const hostTestSuite_t* pSuite = &mHostTestSuites[i];
+        uint32_t failures = mHostTestFailures;
+
+        if( pSelected ? strcmp(pSelected, pSuite->pName) : pSuite->exclusive )
+        {
+            continue;
+        }
+
+        printf("[ RUN  ] %s\n", pSuite->pName);
+        pSuite->pfRun();
+        printf("[ %s ] %s\n", (failures == mHostTestFailures) ? " OK " : "FAIL", pSuite->pName);
+        ran++;
+    }
+
+    if( 0 == ran )
+    {
+        printf("no test suite named %s\n", pSelected);
+        mHostTestFailures++;
+    }
+
+    printf("%u checks, %u failures\n", (unsigned)mHostTestChecks, (unsigned)mHostTestFailures);
+    fflush(stdout);
+    exit(mHostTestFailures ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+bool_t HostTest_Check(bool_t cond, const char* pExpr, const char* pFile, uint32_t line)
+{
+    mHostTestChecks++;
+
+    if( !cond )
+    {
+        mHostTestFailures++;
+        printf("%s:%u: check failed: %s\n", pFile, (unsigned)line, pExpr);
+        fflush(stdout);
+    }
+
+    return cond;
+}
+
+bool_t HostTest_CheckBuffer(const void* pActual, const void* pExpected, uint32_t size,
+                            const char* pFile, uint32_t line)
+{
+    bool_t equal = (0 == memcmp(pActual, pExpected, size)) ? TRUE : FALSE;
+    uint32_t i;
+
+    if( !HostTest_Check(equal, "buffers are equal", pFile, line) )
+    {
+        printf("    actual:  ");
+        for( i = 0; i < size; i++ )
+        {
+            printf("%02x", ((const uint8_t*)pActual)[i]);
+        }
+        printf("\n    expected:");
+        for( i = 0; i < size; i++ )
+        {
+            printf("%02x", ((const uint8_t*)pExpected)[i]);
+        }
+        printf("\n");
+    }
+
+    return equal;
+}
+
+uint32_t HostTest_Hex(uint8_t* pOut, const char* pHex)
+{
+    uint32_t count = 0;
+    unsigned int byte;
+
+    while( pHex[0] && pHex[1] && (1 == sscanf(pHex, "%2x", &byte)) )
+    {
+        pOut[count++] = (uint8_t)byte;
+        pHex += 2;
+    }
+
+    return count;
+}
+
+uint32_t HostTest_Read(int fd, uint8_t* pBuff, uint32_t size, uint32_t timeoutMs)
+{
+    uint64_t end = Host_GetTimeUs() + (uint64_t)timeoutMs * 1000;
+    uint32_t count = 0;
+    struct pollfd pfd = { fd, POLLIN, 0 };
+
+    while( count < size )
+    {
+        uint64_t now = Host_GetTimeUs();
+        ssize_t n;
+
+        if( (now >= end) || (poll(&pfd, 1, (int)((end - now + 999) / 1000)) <= 0) )
+        {
+            break;
+        }
+
+        n = read(fd, pBuff + count, size - count);
+        if( n <= 0 )
+        {
+            break;
+        }
+        count += (uint32_t)n;
+    }
+
+    return count;
+}
+
+bool_t HostTest_ReadUntil(int fd, const char* pString, uint32_t timeoutMs)
+{
+    uint64_t end = Host_GetTimeUs() + (uint64_t)timeoutMs * 1000;
+    char buff[1024];
+    uint32_t count = 0;
+
+    while( Host_GetTimeUs() < end )
+    {
+        if( count == sizeof(buff) - 1 )
+        {
+            /* Keep the end, where the string may have started */
+            memmove(buff, &buff[count / 2], count - count / 2);
+            count -= count / 2;
+        }
+
+        count += HostTest_Read(fd, (uint8_t*)&buff[count], 1, 10);
+        buff[count] = '\0';
+
+        if( strstr(buff, pString) )
+        {
+            return TRUE;
+        }
+    }
+
+    printf("    received: %s\n", buff);
+    return FALSE;
+}
@@ -0,0 +1,119 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* This is the header file of the host test runner. Each suite is a function which
+* checks one framework module with HOST_TEST_CHECK(). The runner initializes the
+* framework in main_task(), runs the suites selected by the HOST_TEST_SUITE
+* environment variable, or all of them, and exits with the number of failures.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef _HOST_TEST_H_
+#define _HOST_TEST_H_
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include "EmbeddedTypes.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public macros
+*************************************************************************************
+********************************************************************************** */
+
+/* Records a failure, with its location, if the condition is false. The suite
+   goes on, so that one run reports every failure. */
+#define HOST_TEST_CHECK(cond) \
+    HostTest_Check((cond) ? TRUE : FALSE, #cond, __FILE__, __LINE__)
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public type definitions
+*************************************************************************************
+********************************************************************************** */
+typedef struct hostTestSuite_tag
+{
+    const char* pName;      /* Value of HOST_TEST_SUITE which selects the suite */
+    void      (*pfRun)(void);
+    bool_t      exclusive;  /* Uses the serial interface: only run when selected */
+} hostTestSuite_t;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+********************************************************************************** */
+
+/*! *********************************************************************************
+* \brief  Records the result of a check. Prints the failed ones.
+*
+* \return  the condition
+*
+********************************************************************************** */
+bool_t HostTest_Check(bool_t cond, const char* pExpr, const char* pFile, uint32_t line);
+
+/*! *********************************************************************************
+* \brief  Compares two buffers, and prints both if they differ
+*
+* \return  TRUE if they are equal
+*
+********************************************************************************** */
+bool_t HostTest_CheckBuffer(const void* pActual, const void* pExpected, uint32_t size,
+                            const char* pFile, uint32_t line);
+
+#define HOST_TEST_CHECK_BUFFER(actual, expected, size) \
+    HostTest_CheckBuffer((actual), (expected), (size), __FILE__, __LINE__)
+
+/*! *********************************************************************************
+* \brief  Converts a hexadecimal string to bytes, for the test vectors
+*
+* \return  the number of bytes written
+*
+********************************************************************************** */
+uint32_t HostTest_Hex(uint8_t* pOut, const char* pHex);
+
+/*! *********************************************************************************
+* \brief  Reads from a file descriptor until the string is received, or the timeout
+*         expires. Used to check what the framework writes to a pseudo terminal.
+*
+* \return  TRUE if the string was received
+*
+********************************************************************************** */
+bool_t HostTest_ReadUntil(int fd, const char* pString, uint32_t timeoutMs);
+
+/*! *********************************************************************************
+* \brief  Reads up to size bytes from a file descriptor, until the timeout expires
+*
+* \return  the number of bytes read
+*
+********************************************************************************** */
+uint32_t HostTest_Read(int fd, uint8_t* pBuff, uint32_t size, uint32_t timeoutMs);
+
+/* Suites */
+void Test_Crc(void);
+void Test_Fsci(void);
+void Test_FunctionLib(void);
+void Test_Lists(void);
+void Test_MemManager(void);
+void Test_Messaging(void);
+void Test_Nvm(void);
+void Test_Osa(void);
+void Test_Ota(void);
+void Test_Profiler(void);
+void Test_RecStore(void);
+void Test_Rng(void);
+void Test_Scrambler(void);
+void Test_SecLib(void);
+void Test_SecLibLtc(void);
+void Test_Serial(void);
+void Test_Shell(void);
+void Test_Timers(void);
+
+#endif /* _HOST_TEST_H_ */
@@ -0,0 +1,163 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Host tests of the CRC engine: the check values of CRC-32 and CRC-16/CCITT-FALSE
+* over "123456789", and the table-driven and incremental functions against the
+* bitwise reference for every input and output ordering. CRC_Compute() is run
+* from two tasks at once, with different configurations. The suite is also built
+* with gCrcTableSlices_c set to 4, see framework_crc4_tests.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include "HostTest.h"
+#include "fsl_os_abstraction.h"
+#include "CRC.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+********************************************************************************** */
+#define mTestCrcIterations_c   (2000)
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+********************************************************************************** */
+static void Test_CrcTask(osaTaskParam_t param);
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+********************************************************************************** */
+static uint8_t mTestCrcCheck[] = "123456789";
+static uint8_t mTestCrcData[300];
+static CRC_handle_t mTestCrcHandle;
+
+OSA_TASK_DEFINE(Test_CrcTask, 3, 2, 1024, 0);
+
+/* CRC-32 and CRC-16/CCITT-FALSE */
+static CRC_config_t mTestCrcConfigs[2] =
+{
+    {4, 0, gCrcInputNoRef, gCrcOutputNoRef, gCrcLSByteFirst, 0xFFFFFFFF, 0x04C11DB7, 0xFFFFFFFF},
+    {2, 0, gCrcRefInput, gCrcOutputNoRef, gCrcMSByteFirst, 0xFFFF, 0x1021, 0x0000},
+};
+static uint32_t mTestCrcExpected[2] = {0xCBF43926, 0x29B1};
+
+static osaSemaphoreId_t  mTestCrcDone;
+static volatile uint32_t mTestCrcErrors;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+void Test_Crc(void)
+{
+    /* The register is reflected when crcRefIn is gCrcInputNoRef, see CRC_Init() */
+    CRC_config_t crc32 = mTestCrcConfigs[0];
+    CRC_config_t crc16 = mTestCrcConfigs[1];
+    CRC_config_t config;
+    uint32_t crc;
+    uint32_t i;
+
+    for( i = 0; i < sizeof(mTestCrcData); i++ )
+    {
+        mTestCrcData[i] = (uint8_t)(i * 7 + 3);
+    }
+
+    HOST_TEST_CHECK(0xCBF43926 == CRC_ComputeBitwise(crc32, mTestCrcCheck, 9));
+    HOST_TEST_CHECK(0xCBF43926 == CRC_Compute(crc32, mTestCrcCheck, 9));
+    HOST_TEST_CHECK(0x29B1 == CRC_ComputeBitwise(crc16, mTestCrcCheck, 9));
+    HOST_TEST_CHECK(0x29B1 == CRC_Compute(crc16, mTestCrcCheck, 9));
+
+    /* Every size and ordering, with a start offset, against the bitwise reference */
+    for( i = 0; i < 16; i++ )
+    {
+        config = crc32;
+        config.crcSize      = (uint8_t)(1 + (i & 3));
+        config.crcRefIn     = (i & 4) ? gCrcRefInput : gCrcInputNoRef;
+        config.crcByteOrder = (i & 8) ? gCrcMSByteFirst : gCrcLSByteFirst;
+        config.crcStartByte = 3;
+        config.crcPoly      = (config.crcSize == 1) ? 0x07 : (config.crcSize == 2) ? 0x8005 :
+                              (config.crcSize == 3) ? 0x864CFB : 0x1EDC6F41;
+        config.crcSeed      = 0x5A5A5A5A >> (8 * (4 - config.crcSize));
+        config.crcXorOut    = 0x0F0F0F0F >> (8 * (4 - config.crcSize));
+
+        crc = CRC_ComputeBitwise(config, mTestCrcData, sizeof(mTestCrcData));
+        HOST_TEST_CHECK(crc == CRC_Compute(config, mTestCrcData, sizeof(mTestCrcData)));
+
+        CRC_Init(&mTestCrcHandle, &config);
+        HOST_TEST_CHECK(crc == CRC_ComputeWithTable(&mTestCrcHandle, mTestCrcData, sizeof(mTestCrcData)));
+
+        /* Incremental, in uneven chunks */
+        {
+            uint32_t reg = CRC_Begin(&mTestCrcHandle);
+
+            reg = CRC_Update(&mTestCrcHandle, reg, &mTestCrcData[3], 1);
+            reg = CRC_Update(&mTestCrcHandle, reg, &mTestCrcData[4], 150);
+            reg = CRC_Update(&mTestCrcHandle, reg, &mTestCrcData[154], sizeof(mTestCrcData) - 154);
+            HOST_TEST_CHECK(crc == CRC_End(&mTestCrcHandle, reg));
+        }
+    }
+
+    /* The table-driven functions against CRC_Compute(), for every start alignment
+       and the lengths which leave each tail after the slicing-by-4 loop */
+    for( i = 0; i < 2 * 4 * 72; i++ )
+    {
+        uint32_t offset = i & 3;
+        uint32_t length = (i >> 2) % 72;
+
+        config = (i < 4 * 72) ? crc32 : crc16;
+        CRC_Init(&mTestCrcHandle, &config);
+        HOST_TEST_CHECK(CRC_Compute(config, &mTestCrcData[offset], length) ==
+                        CRC_ComputeWithTable(&mTestCrcHandle, &mTestCrcData[offset], length));
+    }
+
+    /* Size 0 bypasses the CRC */
+    config = crc32;
+    config.crcSize = 0;
+    HOST_TEST_CHECK(0 == CRC_Compute(config, mTestCrcData, sizeof(mTestCrcData)));
+
+    /* Concurrent computations with different configurations */
+    mTestCrcDone = OSA_SemaphoreCreate(0);
+    HOST_TEST_CHECK(NULL != mTestCrcDone);
+    HOST_TEST_CHECK(NULL != OSA_TaskCreate(OSA_TASK(Test_CrcTask), (osaTaskParam_t)0));
+    HOST_TEST_CHECK(NULL != OSA_TaskCreate(OSA_TASK(Test_CrcTask), (osaTaskParam_t)1));
+    HOST_TEST_CHECK(osaStatus_Success == OSA_SemaphoreWait(mTestCrcDone, 10000));
+    HOST_TEST_CHECK(osaStatus_Success == OSA_SemaphoreWait(mTestCrcDone, 10000));
+    HOST_TEST_CHECK(0 == mTestCrcErrors);
+    (void)OSA_SemaphoreDestroy(mTestCrcDone);
+}
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+********************************************************************************** */
+static void Test_CrcTask(osaTaskParam_t param)
+{
+    uint32_t index = (uint32_t)(uintptr_t)param;
+    uint32_t i;
+
+    for( i = 0; i < mTestCrcIterations_c; i++ )
+    {
+        if( mTestCrcExpected[index] != CRC_Compute(mTestCrcConfigs[index], mTestCrcCheck, 9) )
+        {
+            mTestCrcErrors++;
+        }
+    }
+
+    (void)OSA_SemaphorePost(mTestCrcDone);
+}
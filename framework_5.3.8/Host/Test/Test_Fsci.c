@@ -0,0 +1,295 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Host tests of FSCI, on a pseudo terminal: a registered operation group receives
+* the packets sent by the peer and answers them. The logs of FSCI_LogFormatedText()
+* come back as binary log records, or as text when the format has arguments which
+* the records cannot hold.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "HostTest.h"
+#include "fsl_os_abstraction.h"
+#include "MemManager.h"
+#include "FsciInterface.h"
+#include "TimersManager.h"
+#include "Pipe_Adapter.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+********************************************************************************** */
+#define mTestFsciStartMarker_c    (0x02)
+#define mTestFsciOpGroup_c        (0x7A)
+#define mTestFsciEchoOpCode_c     (0x01)
+#define mTestFsciPayloadLen_c     (20)
+#define mTestFsciFrameLen_c       (sizeof(clientPacketHdr_t) + mTestFsciPayloadLen_c + 1)
+#define mTestFsciTextOpCode_c     (0x01)
+#define mTestFsciBinLogOpCode_c   (0x10)
+#define mTestFsciBinLogHeader_c   (0xB1000000)
+#define mTestFsciLogFrameLen_c    (sizeof(clientPacketHdr_t) + gFsciMaxPayloadLen_c + 1)
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+********************************************************************************** */
+static void Test_FsciHandler(void* pData, void* param, uint32_t fsciInterface);
+static uint32_t Test_FsciFrame(uint8_t* pFrame, uint8_t opCode, uint8_t* pPayload, uint8_t len);
+#if gFsciUseBinLog_c
+static void Test_FsciBinLog(int peer);
+static void Test_FsciTextLog(int peer, const char* pExpected);
+static uint32_t Test_FsciReadLog(int peer, uint8_t* pFrame);
+#endif
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+********************************************************************************** */
+extern uint8_t gFsciSerialInterfaces[];
+
+static const gFsciSerialConfig_t mTestFsciConfig[] =
+{
+    {
+        .baudrate         = gUARTBaudRate115200_c,
+        .interfaceType    = gSerialMgrCustom_c,
+        .interfaceChannel = 0,
+        .virtualInterface = 0
+    }
+};
+
+static volatile uint32_t mTestFsciPackets;
+
+#if gFsciUseBinLog_c
+static const char mTestFsciBinLogFmt[] = "bin %d %u %hx %hhu %c %*d %%";
+static const char mTestFsciBinLog2Fmt[] = "bin %x %x";
+#endif
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+void Test_Fsci(void)
+{
+    uint8_t payload[mTestFsciPayloadLen_c];
+    uint8_t frame[mTestFsciFrameLen_c];
+    uint8_t answer[mTestFsciFrameLen_c];
+    uint32_t frameLen;
+    uint32_t i;
+    int peer;
+
+    FSCI_Init((void*)mTestFsciConfig);
+    HOST_TEST_CHECK(gPipeSuccess_c == Pipe_Initialize(gFsciSerialInterfaces[0], gPipePtyDevice_c));
+    HOST_TEST_CHECK(gFsciSuccess_c == FSCI_RegisterOpGroup(mTestFsciOpGroup_c, gFsciMonitorMode_c,
+                                                           Test_FsciHandler, NULL, 0));
+    /* An operation group is registered only once */
+    HOST_TEST_CHECK(gFsciSuccess_c != FSCI_RegisterOpGroup(mTestFsciOpGroup_c, gFsciMonitorMode_c,
+                                                           Test_FsciHandler, NULL, 0));
+
+    peer = open(Pipe_GetDeviceName(), O_RDWR | O_NOCTTY);
+    if( !HOST_TEST_CHECK(peer >= 0) )
+    {
+        return;
+    }
+
+    for( i = 0; i < mTestFsciPayloadLen_c; i++ )
+    {
+        payload[i] = (uint8_t)(0x30 + i);
+    }
+
+    /* The echo comes back with the next operation code and the same payload */
+    frameLen = Test_FsciFrame(frame, mTestFsciEchoOpCode_c, payload, mTestFsciPayloadLen_c);
+    HOST_TEST_CHECK((ssize_t)frameLen == write(peer, frame, frameLen));
+    HOST_TEST_CHECK(frameLen == HostTest_Read(peer, answer, frameLen, 1000));
+    frameLen = Test_FsciFrame(frame, mTestFsciEchoOpCode_c + 1, payload, mTestFsciPayloadLen_c);
+    HOST_TEST_CHECK_BUFFER(answer, frame, frameLen);
+
+    /* A packet with a bad checksum is dropped */
+    frameLen = Test_FsciFrame(frame, mTestFsciEchoOpCode_c, payload, mTestFsciPayloadLen_c);
+    frame[frameLen - 1] ^= 0xFF;
+    HOST_TEST_CHECK((ssize_t)frameLen == write(peer, frame, frameLen));
+    OSA_TimeDelay(100);
+    HOST_TEST_CHECK(1 == mTestFsciPackets);
+
+    /* Back to back packets, with an empty payload */
+    frameLen = Test_FsciFrame(frame, mTestFsciEchoOpCode_c, payload, 0);
+    for( i = 0; i < 10; i++ )
+    {
+        HOST_TEST_CHECK((ssize_t)frameLen == write(peer, frame, frameLen));
+    }
+    for( i = 0; i < 10; i++ )
+    {
+        HOST_TEST_CHECK(frameLen == HostTest_Read(peer, answer, frameLen, 1000));
+        HOST_TEST_CHECK(mTestFsciEchoOpCode_c + 1 == answer[2]);
+    }
+    HOST_TEST_CHECK(11 == mTestFsciPackets);
+
+#if gFsciUseBinLog_c
+    Test_FsciBinLog(peer);
+#endif
+
+    (void)close(peer);
+}
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+********************************************************************************** */
+static void Test_FsciHandler(void* pData, void* param, uint32_t fsciInterface)
+{
+    clientPacket_t *pPacket = (clientPacket_t*)pData;
+
+    (void)param;
+    mTestFsciPackets++;
+    FSCI_transmitPayload(pPacket->structured.header.opGroup,
+                         pPacket->structured.header.opCode + 1,
+                         pPacket->structured.payload,
+                         pPacket->structured.header.len,
+                         fsciInterface);
+    (void)MEM_BufferFree(pData);
+}
+
+#if gFsciUseBinLog_c
+static void Test_FsciBinLog(int peer)
+{
+    fsciBinLogStats_t before;
+    fsciBinLogStats_t after;
+    uint8_t frame[mTestFsciLogFrameLen_c];
+    uint32_t words[4 + 7];
+    uint32_t start;
+    uint32_t end;
+    uint32_t len;
+
+    FSCI_BinLogGetStats(&before);
+
+    /* Each argument is read with its type, the char and short being promoted to
+       int. The width given by '*' is an argument too. */
+    start = (uint32_t)TMR_GetTimestamp();
+    FSCI_LogFormatedText(mTestFsciBinLogFmt, -5, 7u, (unsigned short)0x1234, (unsigned char)200, 'z', 3, 42);
+    len = Test_FsciReadLog(peer, frame);
+    end = (uint32_t)TMR_GetTimestamp();
+
+    HOST_TEST_CHECK(mTestFsciBinLogOpCode_c == frame[2]);
+    HOST_TEST_CHECK(sizeof(words) == len);
+    memcpy(words, &frame[sizeof(clientPacketHdr_t)], sizeof(words));
+    HOST_TEST_CHECK(before.dropped == words[0]);
+    HOST_TEST_CHECK((mTestFsciBinLogHeader_c | 7) == words[1]);
+    HOST_TEST_CHECK((uint32_t)(uintptr_t)mTestFsciBinLogFmt == words[2]);
+    HOST_TEST_CHECK((words[3] - start) <= (end - start));
+    HOST_TEST_CHECK((uint32_t)-5 == words[4]);
+    HOST_TEST_CHECK(7 == words[5]);
+    HOST_TEST_CHECK(0x1234 == words[6]);
+    HOST_TEST_CHECK(200 == words[7]);
+    HOST_TEST_CHECK('z' == words[8]);
+    HOST_TEST_CHECK(3 == words[9]);
+    HOST_TEST_CHECK(42 == words[10]);
+
+    /* The records of fixed arity take the same path */
+    FSCI_BinLog2(mTestFsciBinLog2Fmt, 0xDEADBEEF, 1);
+    len = Test_FsciReadLog(peer, frame);
+    HOST_TEST_CHECK(mTestFsciBinLogOpCode_c == frame[2]);
+    HOST_TEST_CHECK(6 * sizeof(uint32_t) == len);
+    memcpy(words, &frame[sizeof(clientPacketHdr_t)], 6 * sizeof(uint32_t));
+    HOST_TEST_CHECK((mTestFsciBinLogHeader_c | 2) == words[1]);
+    HOST_TEST_CHECK((uint32_t)(uintptr_t)mTestFsciBinLog2Fmt == words[2]);
+    HOST_TEST_CHECK(0xDEADBEEF == words[4]);
+    HOST_TEST_CHECK(1 == words[5]);
+
+    /* The strings, floating points and 64-bit arguments are formatted on the target.
+       A long has 64 bits on the host. */
+    FSCI_LogFormatedText("text %s %d", "abc", -1);
+    Test_FsciTextLog(peer, "text abc -1");
+    FSCI_LogFormatedText("text %llu %hd", 12345678901234ULL, -2);
+    Test_FsciTextLog(peer, "text 12345678901234 -2");
+    FSCI_LogFormatedText("text %.2f %c", 1.5, 'x');
+    Test_FsciTextLog(peer, "text 1.50 x");
+    FSCI_LogFormatedText("text %lu", 4000000000UL);
+    Test_FsciTextLog(peer, "text 4000000000");
+    FSCI_LogFormatedText("text %d %d %d %d %d %d %d %d %d", 1, 2, 3, 4, 5, 6, 7, 8, 9);
+    Test_FsciTextLog(peer, "text 1 2 3 4 5 6 7 8 9");
+
+    FSCI_BinLogGetStats(&after);
+    HOST_TEST_CHECK(before.records + 2 == after.records);
+    HOST_TEST_CHECK(before.frames + 2 == after.frames);
+    HOST_TEST_CHECK(before.dropped == after.dropped);
+}
+
+/* Reads a text log frame, and compares its payload */
+static void Test_FsciTextLog(int peer, const char* pExpected)
+{
+    uint8_t frame[mTestFsciLogFrameLen_c];
+    uint32_t len;
+
+    len = Test_FsciReadLog(peer, frame);
+    HOST_TEST_CHECK(mTestFsciTextOpCode_c == frame[2]);
+    HOST_TEST_CHECK(strlen(pExpected) == len);
+    HOST_TEST_CHECK_BUFFER(&frame[sizeof(clientPacketHdr_t)], pExpected, strlen(pExpected));
+}
+
+/* Reads a frame of the logging operation group, checks its checksum, and returns
+   the payload length */
+static uint32_t Test_FsciReadLog(int peer, uint8_t* pFrame)
+{
+    uint8_t checksum = 0;
+    uint32_t len;
+    uint32_t i;
+
+    memset(pFrame, 0, mTestFsciLogFrameLen_c);
+    if( !HOST_TEST_CHECK(sizeof(clientPacketHdr_t) == HostTest_Read(peer, pFrame, sizeof(clientPacketHdr_t), 1000)) )
+    {
+        return 0;
+    }
+    HOST_TEST_CHECK(mTestFsciStartMarker_c == pFrame[0]);
+    HOST_TEST_CHECK(gFSCI_LoggingOpcodeGroup_c == pFrame[1]);
+
+    len = pFrame[3];
+    if( !HOST_TEST_CHECK(len + 1 == HostTest_Read(peer, &pFrame[sizeof(clientPacketHdr_t)], len + 1, 1000)) )
+    {
+        return 0;
+    }
+
+    for( i = 1; i < sizeof(clientPacketHdr_t) + len + 1; i++ )
+    {
+        checksum ^= pFrame[i];
+    }
+    HOST_TEST_CHECK(0 == checksum);
+
+    return len;
+}
+#endif /* gFsciUseBinLog_c */
+
+static uint32_t Test_FsciFrame(uint8_t* pFrame, uint8_t opCode, uint8_t* pPayload, uint8_t len)
+{
+    uint8_t checksum = 0;
+    uint32_t i;
+
+    pFrame[0] = mTestFsciStartMarker_c;
+    pFrame[1] = mTestFsciOpGroup_c;
+    pFrame[2] = opCode;
+    pFrame[3] = len;
+    memcpy(&pFrame[4], pPayload, len);
+    for( i = 1; i < 4 + (uint32_t)len; i++ )
+    {
+        checksum ^= pFrame[i];
+    }
+    pFrame[4 + len] = checksum;
+
+    return 5 + (uint32_t)len;
+}
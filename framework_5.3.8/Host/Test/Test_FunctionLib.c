@@ -0,0 +1,169 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Host tests of FunctionLib: the word access copies, fills and compares against
+* the C library, for every source and destination alignment and every length up
+* to 64 + 3 bytes, on random data. The bytes around the destination must be left.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include <string.h>
+
+#include "HostTest.h"
+#include "FunctionLib.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+********************************************************************************** */
+#define mTestFLibMaxLen_c          (64 + 3)
+#define mTestFLibAlignments_c      (4)
+/* Guard bytes before and after the destination */
+#define mTestFLibGuard_c           (8)
+#define mTestFLibBufferSize_c      (mTestFLibGuard_c + mTestFLibAlignments_c + mTestFLibMaxLen_c + mTestFLibGuard_c)
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+********************************************************************************** */
+static uint32_t Test_FLibRandom(void);
+static void Test_FLibFill(uint8_t *pBuff, uint32_t length);
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+********************************************************************************** */
+static uint32_t mTestFLibSeed = 0x9E3779B9;
+
+static uint32_t mTestFLibSrc[mTestFLibBufferSize_c / 4 + 1];
+static uint32_t mTestFLibDst[mTestFLibBufferSize_c / 4 + 1];
+static uint32_t mTestFLibExpected[mTestFLibBufferSize_c / 4 + 1];
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+void Test_FunctionLib(void)
+{
+    uint8_t *pSrc;
+    uint8_t *pDst;
+    uint8_t *pExpected = (uint8_t*)mTestFLibExpected;
+    uint32_t errors[6] = {0};
+    uint32_t srcAlign;
+    uint32_t dstAlign;
+    uint32_t length;
+    uint32_t i;
+    uint8_t value;
+
+    for( srcAlign = 0; srcAlign < mTestFLibAlignments_c; srcAlign++ )
+    {
+        for( dstAlign = 0; dstAlign < mTestFLibAlignments_c; dstAlign++ )
+        {
+            pSrc = (uint8_t*)mTestFLibSrc + mTestFLibGuard_c + srcAlign;
+            pDst = (uint8_t*)mTestFLibDst + mTestFLibGuard_c + dstAlign;
+
+            for( length = 0; length <= mTestFLibMaxLen_c; length++ )
+            {
+                /* FLib_MemCpy() against memcpy() */
+                Test_FLibFill((uint8_t*)mTestFLibSrc, sizeof(mTestFLibSrc));
+                Test_FLibFill((uint8_t*)mTestFLibDst, sizeof(mTestFLibDst));
+                memcpy(mTestFLibExpected, mTestFLibDst, sizeof(mTestFLibDst));
+                memcpy(pExpected + mTestFLibGuard_c + dstAlign, pSrc, length);
+                FLib_MemCpy(pDst, pSrc, length);
+                errors[0] += memcmp(mTestFLibDst, mTestFLibExpected, sizeof(mTestFLibDst)) ? 1 : 0;
+
+                /* FLib_MemCpyReverseOrder() against a byte loop */
+                Test_FLibFill((uint8_t*)mTestFLibDst, sizeof(mTestFLibDst));
+                memcpy(mTestFLibExpected, mTestFLibDst, sizeof(mTestFLibDst));
+                for( i = 0; i < length; i++ )
+                {
+                    pExpected[mTestFLibGuard_c + dstAlign + i] = pSrc[length - 1 - i];
+                }
+                FLib_MemCpyReverseOrder(pDst, pSrc, length);
+                errors[1] += memcmp(mTestFLibDst, mTestFLibExpected, sizeof(mTestFLibDst)) ? 1 : 0;
+
+                /* FLib_MemSet() against memset() */
+                value = (uint8_t)Test_FLibRandom();
+                memset(pExpected + mTestFLibGuard_c + dstAlign, value, length);
+                FLib_MemSet(pDst, value, length);
+                errors[2] += memcmp(mTestFLibDst, mTestFLibExpected, sizeof(mTestFLibDst)) ? 1 : 0;
+
+                /* FLib_MemCmpToVal(), on the filled block, then with one byte changed */
+                errors[3] += FLib_MemCmpToVal(pDst, value, length) ? 0 : 1;
+                if( length )
+                {
+                    i = Test_FLibRandom() % length;
+                    pDst[i] ^= (uint8_t)(1U << (Test_FLibRandom() & 7));
+                    errors[3] += FLib_MemCmpToVal(pDst, value, length) ? 1 : 0;
+                }
+
+                /* FLib_MemCmp() against memcmp(), equal, then with one byte changed */
+                memcpy(pDst, pSrc, length);
+                errors[4] += FLib_MemCmp(pSrc, pDst, length) ? 0 : 1;
+                if( length )
+                {
+                    i = Test_FLibRandom() % length;
+                    pDst[i] ^= (uint8_t)(1U << (Test_FLibRandom() & 7));
+                    errors[4] += FLib_MemCmp(pSrc, pDst, length) ? 1 : 0;
+
+                    /* The last byte, which the word loop leaves to the tail */
+                    memcpy(pDst, pSrc, length);
+                    pDst[length - 1] ^= 0x80;
+                    errors[4] += FLib_MemCmp(pSrc, pDst, length) ? 1 : 0;
+                }
+
+                /* FLib_MemInPlaceCpy() against memmove(), within one buffer */
+                Test_FLibFill((uint8_t*)mTestFLibDst, sizeof(mTestFLibDst));
+                memcpy(mTestFLibExpected, mTestFLibDst, sizeof(mTestFLibDst));
+                i = mTestFLibGuard_c + srcAlign;
+                memmove(pExpected + mTestFLibGuard_c + dstAlign, pExpected + i, length);
+                FLib_MemInPlaceCpy(pDst, (uint8_t*)mTestFLibDst + i, length);
+                errors[5] += memcmp(mTestFLibDst, mTestFLibExpected, sizeof(mTestFLibDst)) ? 1 : 0;
+            }
+        }
+    }
+
+    HOST_TEST_CHECK(0 == errors[0]);
+    HOST_TEST_CHECK(0 == errors[1]);
+    HOST_TEST_CHECK(0 == errors[2]);
+    HOST_TEST_CHECK(0 == errors[3]);
+    HOST_TEST_CHECK(0 == errors[4]);
+    HOST_TEST_CHECK(0 == errors[5]);
+}
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+********************************************************************************** */
+
+/* xorshift32, so that every run checks the same data */
+static uint32_t Test_FLibRandom(void)
+{
+    mTestFLibSeed ^= mTestFLibSeed << 13;
+    mTestFLibSeed ^= mTestFLibSeed >> 17;
+    mTestFLibSeed ^= mTestFLibSeed << 5;
+
+    return mTestFLibSeed;
+}
+
+static void Test_FLibFill(uint8_t *pBuff, uint32_t length)
+{
+    while( length-- )
+    {
+        *pBuff++ = (uint8_t)Test_FLibRandom();
+    }
+}
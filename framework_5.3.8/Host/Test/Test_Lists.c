@@ -0,0 +1,211 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Host tests of the generic lists: the doubly linked list, the single producer
+* single consumer ring and the multiple producer single consumer queue
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include "HostTest.h"
+#include "fsl_os_abstraction.h"
+#include "GenericList.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+********************************************************************************** */
+#define mTestListElements_c    (8)
+#define mTestListSlots_c       (4)
+#define mTestListProducers_c   (2)
+#define mTestListItems_c       (20000)
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+********************************************************************************** */
+typedef struct testListItem_tag
+{
+    listElement_t element;   /* First, so that an element handle is an item */
+    uint32_t      producer;
+    uint32_t      sequence;
+} testListItem_t;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+********************************************************************************** */
+static void Test_ListSpscProducerTask(osaTaskParam_t param);
+static void Test_ListMpscProducerTask(osaTaskParam_t param);
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+********************************************************************************** */
+OSA_TASK_DEFINE(Test_ListSpscProducerTask, 3, 1, 1024, 0);
+OSA_TASK_DEFINE(Test_ListMpscProducerTask, 3, mTestListProducers_c, 1024, 0);
+
+static listSpsc_t          mTestSpsc;
+static listElementHandle_t mTestSpscSlots[mTestListSlots_c];
+static testListItem_t      mTestSpscItems[mTestListSlots_c * 2];
+
+static listMpsc_t          mTestMpsc;
+static testListItem_t      mTestMpscItems[mTestListProducers_c][mTestListItems_c];
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+void Test_Lists(void)
+{
+    list_t list;
+    listElement_t elements[mTestListElements_c];
+    uint32_t next[mTestListProducers_c] = {0};
+    uint32_t received;
+    uint32_t i;
+
+    /* Doubly linked list, bounded */
+    ListInit(&list, mTestListElements_c - 1);
+    HOST_TEST_CHECK(gListOk_c == ListTest());
+    HOST_TEST_CHECK(NULL == ListRemoveHead(&list));
+
+    for( i = 0; i < mTestListElements_c - 1; i++ )
+    {
+        HOST_TEST_CHECK(gListOk_c == ListAddTail(&list, &elements[i]));
+    }
+    HOST_TEST_CHECK(gListFull_c == ListAddTail(&list, &elements[i]));
+    HOST_TEST_CHECK(mTestListElements_c - 1 == ListGetSize(&list));
+    HOST_TEST_CHECK(0 == ListGetAvailable(&list));
+    HOST_TEST_CHECK(&list == ListGetList(&elements[3]));
+
+    HOST_TEST_CHECK(gListOk_c == ListRemoveElement(&elements[3]));
+    HOST_TEST_CHECK(gOrphanElement_c == ListRemoveElement(&elements[3]));
+    HOST_TEST_CHECK(&elements[4] == ListGetNext(&elements[2]));
+    HOST_TEST_CHECK(gListOk_c == ListAddHead(&list, &elements[3]));
+    HOST_TEST_CHECK(&elements[3] == ListGetHead(&list));
+    HOST_TEST_CHECK(gListFull_c == ListAddPrevElement(&elements[0], &elements[mTestListElements_c - 1]));
+
+    HOST_TEST_CHECK(&elements[3] == ListRemoveHead(&list));
+    HOST_TEST_CHECK(&elements[0] == ListRemoveHead(&list));
+    HOST_TEST_CHECK(&elements[1] == ListGetHead(&list));
+
+    /* SPSC ring */
+    HOST_TEST_CHECK(gListFull_c == ListSpscInit(&mTestSpsc, mTestSpscSlots, 3));
+    HOST_TEST_CHECK(gListOk_c == ListSpscInit(&mTestSpsc, mTestSpscSlots, mTestListSlots_c));
+    HOST_TEST_CHECK(NULL == ListSpscPop(&mTestSpsc));
+    for( i = 0; i < mTestListSlots_c; i++ )
+    {
+        HOST_TEST_CHECK(gListOk_c == ListSpscPush(&mTestSpsc, &mTestSpscItems[i].element));
+    }
+    HOST_TEST_CHECK(gListFull_c == ListSpscPush(&mTestSpsc, &mTestSpscItems[i].element));
+    HOST_TEST_CHECK(mTestListSlots_c == ListSpscGetSize(&mTestSpsc));
+    for( i = 0; i < mTestListSlots_c; i++ )
+    {
+        HOST_TEST_CHECK(&mTestSpscItems[i].element == ListSpscPop(&mTestSpsc));
+    }
+
+    /* SPSC ring between two tasks: the items arrive in order */
+    HOST_TEST_CHECK(NULL != OSA_TaskCreate(OSA_TASK(Test_ListSpscProducerTask), NULL));
+    for( received = 0; received < mTestListItems_c; )
+    {
+        testListItem_t* pItem = (testListItem_t*)ListSpscPop(&mTestSpsc);
+
+        if( NULL == pItem )
+        {
+            (void)OSA_TaskYield();
+            continue;
+        }
+
+        if( !HOST_TEST_CHECK(pItem->sequence == received) )
+        {
+            break;
+        }
+        received++;
+    }
+
+    /* MPSC queue fed by two tasks: the items of each producer arrive in order */
+    ListMpscInit(&mTestMpsc);
+    HOST_TEST_CHECK(ListMpscIsEmpty(&mTestMpsc));
+    HOST_TEST_CHECK(NULL == ListMpscPop(&mTestMpsc));
+    for( i = 0; i < mTestListProducers_c; i++ )
+    {
+        HOST_TEST_CHECK(NULL != OSA_TaskCreate(OSA_TASK(Test_ListMpscProducerTask), (osaTaskParam_t)(uintptr_t)i));
+    }
+
+    for( received = 0; received < mTestListProducers_c * mTestListItems_c; )
+    {
+        testListItem_t* pItem = (testListItem_t*)ListMpscPop(&mTestMpsc);
+
+        if( NULL == pItem )
+        {
+            (void)OSA_TaskYield();
+            continue;
+        }
+
+        if( !HOST_TEST_CHECK(pItem->sequence == next[pItem->producer]) )
+        {
+            break;
+        }
+        next[pItem->producer]++;
+        received++;
+    }
+    HOST_TEST_CHECK(NULL == ListMpscPop(&mTestMpsc));
+    HOST_TEST_CHECK(ListMpscIsEmpty(&mTestMpsc));
+}
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+********************************************************************************** */
+static void Test_ListSpscProducerTask(osaTaskParam_t param)
+{
+    uint32_t i;
+
+    (void)param;
+
+    for( i = 0; i < mTestListItems_c; i++ )
+    {
+        /* An item is reused once the ring has been drained past it */
+        testListItem_t* pItem = &mTestSpscItems[i % NumberOfElements(mTestSpscItems)];
+
+        while( ListSpscGetSize(&mTestSpsc) >= mTestListSlots_c )
+        {
+            (void)OSA_TaskYield();
+        }
+
+        pItem->sequence = i;
+        while( gListOk_c != ListSpscPush(&mTestSpsc, &pItem->element) )
+        {
+            (void)OSA_TaskYield();
+        }
+    }
+}
+
+static void Test_ListMpscProducerTask(osaTaskParam_t param)
+{
+    uint32_t producer = (uint32_t)(uintptr_t)param;
+    uint32_t i;
+
+    for( i = 0; i < mTestListItems_c; i++ )
+    {
+        testListItem_t* pItem = &mTestMpscItems[producer][i];
+
+        pItem->producer = producer;
+        pItem->sequence = i;
+        ListMpscPush(&mTestMpsc, &pItem->element);
+    }
+}
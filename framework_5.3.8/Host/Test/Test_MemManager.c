@@ -0,0 +1,140 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Host tests of the memory manager, with the host pools: 8 x 64, 2 x 128 and
+* 6 x 256 bytes, and 1 x 1024 bytes for the SecLib P-256 context
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include <string.h>
+
+#include "HostTest.h"
+#include "fsl_os_abstraction.h"
+#include "MemManager.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+********************************************************************************** */
+#define mTestMemBlocks_c       (17)
+#define mTestMemIterations_c   (20000)
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+********************************************************************************** */
+static void Test_MemStressTask(osaTaskParam_t param);
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+********************************************************************************** */
+OSA_TASK_DEFINE(Test_MemStressTask, 3, 2, 1024, 0);
+
+static osaSemaphoreId_t  mTestMemDone;
+static volatile uint32_t mTestMemErrors;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+void Test_MemManager(void)
+{
+    void* pBlocks[mTestMemBlocks_c];
+    uint32_t freeAll = MEM_GetAvailableBlocks(1);
+    /* The count includes the blocks of the larger pools */
+    uint32_t free64 = freeAll - MEM_GetAvailableBlocks(65);
+    uint32_t i;
+
+    HOST_TEST_CHECK(mTestMemBlocks_c == freeAll);
+    HOST_TEST_CHECK(MEM_WriteReadTest() == 0);
+
+    /* A request is served by the smallest pool which fits it */
+    pBlocks[0] = MEM_BufferAlloc(10);
+    pBlocks[1] = MEM_BufferAlloc(100);
+    pBlocks[2] = MEM_BufferAlloc(200);
+    pBlocks[3] = MEM_BufferAlloc(257);
+    HOST_TEST_CHECK(pBlocks[0] && pBlocks[1] && pBlocks[2] && pBlocks[3]);
+    HOST_TEST_CHECK(64   == MEM_BufferGetSize(pBlocks[0]));
+    HOST_TEST_CHECK(128  == MEM_BufferGetSize(pBlocks[1]));
+    HOST_TEST_CHECK(256  == MEM_BufferGetSize(pBlocks[2]));
+    HOST_TEST_CHECK(1024 == MEM_BufferGetSize(pBlocks[3]));
+    HOST_TEST_CHECK(NULL == MEM_BufferAlloc(1025));
+
+    for( i = 0; i < 4; i++ )
+    {
+        HOST_TEST_CHECK(MEM_SUCCESS_c == MEM_BufferFree(pBlocks[i]));
+    }
+    HOST_TEST_CHECK(freeAll == MEM_GetAvailableBlocks(1));
+
+    /* When a pool is empty, the next pools are used, until all are empty */
+    for( i = 0; i < mTestMemBlocks_c; i++ )
+    {
+        pBlocks[i] = MEM_BufferAlloc(64);
+        HOST_TEST_CHECK(NULL != pBlocks[i]);
+        memset(pBlocks[i], (int)i, 64);
+    }
+    HOST_TEST_CHECK(128 == MEM_BufferGetSize(pBlocks[free64]));
+    HOST_TEST_CHECK(NULL == MEM_BufferAlloc(1));
+
+    for( i = 0; i < mTestMemBlocks_c; i++ )
+    {
+        HOST_TEST_CHECK(((uint8_t*)pBlocks[i])[63] == (uint8_t)i);
+        HOST_TEST_CHECK(MEM_SUCCESS_c == MEM_BufferFree(pBlocks[i]));
+    }
+    HOST_TEST_CHECK(freeAll == MEM_GetAvailableBlocks(1));
+
+    /* Concurrent allocations from two tasks */
+    mTestMemDone = OSA_SemaphoreCreate(0);
+    HOST_TEST_CHECK(NULL != mTestMemDone);
+    HOST_TEST_CHECK(NULL != OSA_TaskCreate(OSA_TASK(Test_MemStressTask), (osaTaskParam_t)1));
+    HOST_TEST_CHECK(NULL != OSA_TaskCreate(OSA_TASK(Test_MemStressTask), (osaTaskParam_t)2));
+    HOST_TEST_CHECK(osaStatus_Success == OSA_SemaphoreWait(mTestMemDone, 10000));
+    HOST_TEST_CHECK(osaStatus_Success == OSA_SemaphoreWait(mTestMemDone, 10000));
+    HOST_TEST_CHECK(0 == mTestMemErrors);
+    HOST_TEST_CHECK(freeAll == MEM_GetAvailableBlocks(1));
+    (void)OSA_SemaphoreDestroy(mTestMemDone);
+}
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+********************************************************************************** */
+static void Test_MemStressTask(osaTaskParam_t param)
+{
+    uint8_t pattern = (uint8_t)(uintptr_t)param;
+    uint8_t* pBlock;
+    uint32_t i;
+
+    for( i = 0; i < mTestMemIterations_c; i++ )
+    {
+        pBlock = MEM_BufferAlloc(32 + (i % 4) * 64);
+        if( NULL == pBlock )
+        {
+            continue;
+        }
+
+        memset(pBlock, pattern, 32);
+        if( (pBlock[0] != pattern) || (pBlock[31] != pattern) ||
+            (MEM_SUCCESS_c != MEM_BufferFree(pBlock)) )
+        {
+            mTestMemErrors++;
+        }
+    }
+
+    (void)OSA_SemaphorePost(mTestMemDone);
+}
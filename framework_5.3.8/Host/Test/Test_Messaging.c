@@ -0,0 +1,169 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Host tests of the messaging: the message queues and the multiple producer,
+* single consumer queue, fed by concurrent tasks
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include "HostTest.h"
+#include "fsl_os_abstraction.h"
+#include "Messaging.h"
+#include "MemManager.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+********************************************************************************** */
+#define mTestMsgProducers_c    (2)
+#define mTestMsgCount_c        (5000)
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+********************************************************************************** */
+typedef struct testMsg_tag
+{
+    uint32_t producer;
+    uint32_t sequence;
+} testMsg_t;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+********************************************************************************** */
+static void Test_MsgProducerTask(osaTaskParam_t param);
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+********************************************************************************** */
+OSA_TASK_DEFINE(Test_MsgProducerTask, 3, mTestMsgProducers_c, 1024, 0);
+
+static msgMpscQueue_t mTestMsgMpsc;
+static osaEventId_t   mTestMsgEvent;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+void Test_Messaging(void)
+{
+    anchor_t queue;
+    testMsg_t* pMsg;
+    uint32_t next[mTestMsgProducers_c] = {0};
+    uint32_t freeBlocks = MEM_GetAvailableBlocks(1);
+    uint32_t received = 0;
+    bool_t inOrder = TRUE;
+    uint32_t i;
+
+    /* FIFO of messages */
+    MSG_InitQueue(&queue);
+    HOST_TEST_CHECK(!MSG_Pending(&queue));
+    for( i = 0; i < 3; i++ )
+    {
+        pMsg = MSG_AllocType(testMsg_t);
+        HOST_TEST_CHECK(NULL != pMsg);
+        pMsg->sequence = i;
+        HOST_TEST_CHECK(gListOk_c == MSG_Queue(&queue, pMsg));
+    }
+    pMsg = MSG_AllocType(testMsg_t);
+    pMsg->sequence = 100;
+    HOST_TEST_CHECK(gListOk_c == MSG_QueueHead(&queue, pMsg));
+
+    HOST_TEST_CHECK(MSG_Pending(&queue));
+    pMsg = MSG_DeQueue(&queue);
+    HOST_TEST_CHECK((NULL != pMsg) && (100 == pMsg->sequence));
+    MSG_Free(pMsg);
+    for( i = 0; i < 3; i++ )
+    {
+        pMsg = MSG_DeQueue(&queue);
+        HOST_TEST_CHECK((NULL != pMsg) && (i == pMsg->sequence));
+        MSG_Free(pMsg);
+    }
+    HOST_TEST_CHECK(NULL == MSG_DeQueue(&queue));
+
+    /* MPSC queue: each batch holds the messages in the order of arrival */
+    MSG_MpscInit(&mTestMsgMpsc);
+    HOST_TEST_CHECK(NULL == MSG_MpscPopAll(&mTestMsgMpsc));
+    mTestMsgEvent = OSA_EventCreate(TRUE);
+    HOST_TEST_CHECK(NULL != mTestMsgEvent);
+
+    for( i = 0; i < mTestMsgProducers_c; i++ )
+    {
+        HOST_TEST_CHECK(NULL != OSA_TaskCreate(OSA_TASK(Test_MsgProducerTask), (osaTaskParam_t)(uintptr_t)i));
+    }
+
+    while( received < mTestMsgProducers_c * mTestMsgCount_c )
+    {
+        osaEventFlags_t flags;
+
+        if( !MSG_MpscPending(&mTestMsgMpsc) &&
+            (osaStatus_Success != OSA_EventWait(mTestMsgEvent, 1, FALSE, 5000, &flags)) )
+        {
+            break;
+        }
+
+        pMsg = MSG_MpscPopAll(&mTestMsgMpsc);
+        while( pMsg )
+        {
+            testMsg_t* pNext = MSG_MpscNext(pMsg);
+
+            if( pMsg->sequence != next[pMsg->producer] )
+            {
+                inOrder = FALSE;
+            }
+            next[pMsg->producer] = pMsg->sequence + 1;
+            received++;
+            MSG_Free(pMsg);
+            pMsg = pNext;
+        }
+    }
+
+    HOST_TEST_CHECK(inOrder);
+    HOST_TEST_CHECK(mTestMsgProducers_c * mTestMsgCount_c == received);
+    HOST_TEST_CHECK(!MSG_MpscPending(&mTestMsgMpsc));
+    HOST_TEST_CHECK(freeBlocks == MEM_GetAvailableBlocks(1));
+    (void)OSA_EventDestroy(mTestMsgEvent);
+}
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+********************************************************************************** */
+static void Test_MsgProducerTask(osaTaskParam_t param)
+{
+    uint32_t producer = (uint32_t)(uintptr_t)param;
+    uint32_t i;
+
+    for( i = 0; i < mTestMsgCount_c; i++ )
+    {
+        testMsg_t* pMsg;
+
+        /* The pools are small: wait for the consumer to free messages */
+        while( NULL == (pMsg = MSG_AllocType(testMsg_t)) )
+        {
+            (void)OSA_TaskYield();
+        }
+
+        pMsg->producer = producer;
+        pMsg->sequence = i;
+        MSG_MpscPush(&mTestMsgMpsc, pMsg);
+        (void)OSA_EventSet(mTestMsgEvent, 1);
+    }
+}
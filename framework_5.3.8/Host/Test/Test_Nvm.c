@@ -0,0 +1,96 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Host tests of the NVM, on the flash image of the process
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include <string.h>
+
+#include "HostTest.h"
+#include "NVM_Interface.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+********************************************************************************** */
+#define mTestNvmDataSetId_c     0x4242      /* Pasted in a symbol name: no parentheses */
+#define mTestNvmElements_c      (4)
+#define mTestNvmMagic_c         (0x4E564D54)   /* "NVMT" */
+#define mTestNvmSaves_c         (200)
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+********************************************************************************** */
+typedef struct testNvmRecord_tag
+{
+    uint32_t magic;
+    uint32_t value;
+    uint8_t  data[24];
+} testNvmRecord_t;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+********************************************************************************** */
+static testNvmRecord_t mTestNvmRecords[mTestNvmElements_c];
+NVM_RegisterDataSet(mTestNvmRecords, mTestNvmElements_c, sizeof(testNvmRecord_t),
+                    mTestNvmDataSetId_c, gNVM_MirroredInRam_c);
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+void Test_Nvm(void)
+{
+    testNvmRecord_t saved[mTestNvmElements_c];
+    uint32_t i;
+
+    HOST_TEST_CHECK(gNVM_OK_c == NvModuleInit());
+
+    /* A record saved by a previous run is restored */
+    (void)NvRestoreDataSet(mTestNvmRecords, TRUE);
+    HOST_TEST_CHECK((0 == mTestNvmRecords[0].magic) || (mTestNvmMagic_c == mTestNvmRecords[0].magic));
+
+    for( i = 0; i < mTestNvmElements_c; i++ )
+    {
+        mTestNvmRecords[i].magic = mTestNvmMagic_c;
+        mTestNvmRecords[i].value = i;
+        memset(mTestNvmRecords[i].data, (int)i, sizeof(mTestNvmRecords[i].data));
+    }
+    HOST_TEST_CHECK(gNVM_OK_c == NvSyncSave(mTestNvmRecords, TRUE));
+    memcpy(saved, mTestNvmRecords, sizeof(saved));
+
+    /* The RAM copy is restored from the flash */
+    memset(mTestNvmRecords, 0xA5, sizeof(mTestNvmRecords));
+    HOST_TEST_CHECK(gNVM_OK_c == NvRestoreDataSet(mTestNvmRecords, TRUE));
+    HOST_TEST_CHECK_BUFFER(mTestNvmRecords, saved, sizeof(saved));
+
+    /* Many saves: the pages are copied and erased, the data set survives */
+    for( i = 0; i < mTestNvmSaves_c; i++ )
+    {
+        mTestNvmRecords[i % mTestNvmElements_c].value += mTestNvmElements_c;
+        if( !HOST_TEST_CHECK(gNVM_OK_c == NvSyncSave(&mTestNvmRecords[i % mTestNvmElements_c], FALSE)) )
+        {
+            break;
+        }
+    }
+    memcpy(saved, mTestNvmRecords, sizeof(saved));
+    memset(mTestNvmRecords, 0, sizeof(mTestNvmRecords));
+    HOST_TEST_CHECK(gNVM_OK_c == NvRestoreDataSet(mTestNvmRecords, TRUE));
+    HOST_TEST_CHECK_BUFFER(mTestNvmRecords, saved, sizeof(saved));
+}
@@ -0,0 +1,140 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Host tests of the OS abstraction: tasks, semaphores, mutexes, events, message
+* queues and time
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include "HostTest.h"
+#include "fsl_os_abstraction.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+********************************************************************************** */
+#define mTestOsaIncrements_c   (10000)
+#define mTestOsaMessages_c     (8)
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+********************************************************************************** */
+static void Test_OsaWorkerTask(osaTaskParam_t param);
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+********************************************************************************** */
+OSA_TASK_DEFINE(Test_OsaWorkerTask, 3, 2, 1024, 0);
+
+static osaSemaphoreId_t mTestOsaSem;
+static osaMutexId_t     mTestOsaMutex;
+static osaEventId_t     mTestOsaEvent;
+static osaMsgQId_t      mTestOsaMsgQ;
+static volatile uint32_t mTestOsaCounter;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+void Test_Osa(void)
+{
+    osaEventFlags_t flags = 0;
+    uint32_t start;
+    uint32_t msg;
+    uint32_t i;
+
+    mTestOsaSem   = OSA_SemaphoreCreate(0);
+    mTestOsaMutex = OSA_MutexCreate();
+    mTestOsaEvent = OSA_EventCreate(TRUE);
+    mTestOsaMsgQ  = OSA_MsgQCreate(mTestOsaMessages_c);
+    HOST_TEST_CHECK(mTestOsaSem && mTestOsaMutex && mTestOsaEvent && mTestOsaMsgQ);
+
+    /* Time and timeouts */
+    start = OSA_TimeGetMsec();
+    OSA_TimeDelay(20);
+    HOST_TEST_CHECK(OSA_TimeGetMsec() - start >= 20);
+    HOST_TEST_CHECK(osaStatus_Timeout == OSA_SemaphoreWait(mTestOsaSem, 10));
+    HOST_TEST_CHECK(osaStatus_Timeout == OSA_EventWait(mTestOsaEvent, 1, FALSE, 10, &flags));
+
+    /* Two instances of a task increment a counter under the mutex, then report
+       through the semaphore, the event and the message queue */
+    HOST_TEST_CHECK(NULL != OSA_TaskCreate(OSA_TASK(Test_OsaWorkerTask), (osaTaskParam_t)1));
+    HOST_TEST_CHECK(NULL != OSA_TaskCreate(OSA_TASK(Test_OsaWorkerTask), (osaTaskParam_t)2));
+
+    HOST_TEST_CHECK(osaStatus_Success == OSA_SemaphoreWait(mTestOsaSem, 5000));
+    HOST_TEST_CHECK(osaStatus_Success == OSA_SemaphoreWait(mTestOsaSem, 5000));
+    HOST_TEST_CHECK(2 * mTestOsaIncrements_c == mTestOsaCounter);
+
+    flags = 0;
+    for( i = 0; (i < 2) && (flags != 3); i++ )
+    {
+        osaEventFlags_t set = 0;
+
+        HOST_TEST_CHECK(osaStatus_Success == OSA_EventWait(mTestOsaEvent, 3, FALSE, 5000, &set));
+        flags |= set;
+    }
+    HOST_TEST_CHECK(3 == flags);
+
+    flags = 0;
+    for( i = 0; i < 2; i++ )
+    {
+        msg = 0;
+        HOST_TEST_CHECK(osaStatus_Success == OSA_MsgQGet(mTestOsaMsgQ, &msg, 5000));
+        flags |= msg;
+    }
+    HOST_TEST_CHECK(3 == flags);
+    HOST_TEST_CHECK(osaStatus_Timeout == OSA_MsgQGet(mTestOsaMsgQ, &msg, 10));
+
+    /* The message queue is bounded */
+    for( i = 0; i < mTestOsaMessages_c; i++ )
+    {
+        HOST_TEST_CHECK(osaStatus_Success == OSA_MsgQPut(mTestOsaMsgQ, &i));
+    }
+    HOST_TEST_CHECK(osaStatus_Success != OSA_MsgQPut(mTestOsaMsgQ, &i));
+    for( i = 0; i < mTestOsaMessages_c; i++ )
+    {
+        HOST_TEST_CHECK((osaStatus_Success == OSA_MsgQGet(mTestOsaMsgQ, &msg, 0)) && (msg == i));
+    }
+
+    HOST_TEST_CHECK(osaStatus_Success == OSA_MsgQDestroy(mTestOsaMsgQ));
+    HOST_TEST_CHECK(osaStatus_Success == OSA_EventDestroy(mTestOsaEvent));
+    HOST_TEST_CHECK(osaStatus_Success == OSA_MutexDestroy(mTestOsaMutex));
+    HOST_TEST_CHECK(osaStatus_Success == OSA_SemaphoreDestroy(mTestOsaSem));
+}
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+********************************************************************************** */
+static void Test_OsaWorkerTask(osaTaskParam_t param)
+{
+    uint32_t id = (uint32_t)(uintptr_t)param;
+    uint32_t i;
+
+    for( i = 0; i < mTestOsaIncrements_c; i++ )
+    {
+        (void)OSA_MutexLock(mTestOsaMutex, osaWaitForever_c);
+        mTestOsaCounter = mTestOsaCounter + 1;
+        (void)OSA_MutexUnlock(mTestOsaMutex);
+    }
+
+    (void)OSA_EventSet(mTestOsaEvent, id);
+    (void)OSA_MsgQPut(mTestOsaMsgQ, &id);
+    (void)OSA_SemaphorePost(mTestOsaSem);
+}
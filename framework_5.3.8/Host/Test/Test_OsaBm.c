@@ -0,0 +1,693 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Host tests of the bare metal OSA, on a simulated core. The file includes
+* fsl_os_abstraction_bm.c, so that the state of the scheduler can be checked, and
+* replaces the CPU primitives of Host_Cpu.c: the core runs one thread, and each WFI
+* of the idle scheduler is a SysTick interrupt, which also runs the simulated ISRs
+* of the scenario under test. The main task of the OSA runs the scenarios in turn,
+* each one when the tasks of the previous one wait. The tasks burn a fixed number of
+* SysTick cycles per run, which the task statistics must account exactly. The
+* SysTick interrupt is held pending while the interrupts are masked, and the RTC
+* counts the burnt cycles, so that the Profiler traces the masked windows of any
+* length exactly.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "HostTest.h"
+#include "clock_config.h"
+#include "fsl_os_abstraction_bm.c"
+#include "Profiler.c"
+
+#if !mProfilerIrqRtc_d
+#error "The masked windows are not timed on the RTC"
+#endif
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+********************************************************************************** */
+/* A scenario whose tasks never settle fails instead of running forever */
+#define mTestOsaBmMaxTicks_c       (100000)
+
+/* Exception number of the SysTick, as read from IPSR */
+#define mTestOsaBmSysTickIpsr_c    (15)
+
+#define mTestOsaBmWaiters_c        (2)
+
+/* The RTC counts at 32768 Hz */
+#define mTestOsaBmRtcBits_c        (15)
+
+/* The semaphore allocation bitmap spans two words */
+#if osNumberOfSemaphores <= 32
+#error "The handles scenario needs more than 32 semaphores"
+#endif
+
+/* Tasks of the scheduler scenarios: one of high priority, two of the same medium
+   priority, which run in turns, and one of low priority */
+#define mTestOsaBmHigh_c           (0)
+#define mTestOsaBmMid1_c           (1)
+#define mTestOsaBmMid2_c           (2)
+#define mTestOsaBmLow_c            (3)
+#define mTestOsaBmLoadTasks_c      (4)
+
+/* Runs of the medium priority tasks while they stay ready */
+#define mTestOsaBmRoundRobinRuns_c (1000)
+#define mTestOsaBmStarvationTicks_c (100)
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+********************************************************************************** */
+typedef struct testOsaBmScenario_tag
+{
+    const char* pName;
+    void      (*pfStart)(void);             /* Called by the main task               */
+    bool_t    (*pfTick)(uint32_t tick);     /* SysTick ISR, TRUE when the scenario ends */
+} testOsaBmScenario_t;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+********************************************************************************** */
+static void Test_OsaBmNext(void);
+static void Test_OsaBmBurn(uint32_t cycles);
+static void Test_OsaBmReload(void);
+static void Test_OsaBmRtcCount(uint32_t cycles);
+static void Test_OsaBmFfsStart(void);
+static void Test_OsaBmHandlesStart(void);
+static void Test_OsaBmIrqTraceStart(void);
+static bool_t Test_OsaBmEndTick(uint32_t tick);
+static void Test_OsaBmSemStart(void);
+static bool_t Test_OsaBmSemTick(uint32_t tick);
+static void Test_OsaBmRoundRobinStart(void);
+static bool_t Test_OsaBmRoundRobinTick(uint32_t tick);
+static void Test_OsaBmStarvationStart(void);
+static bool_t Test_OsaBmStarvationTick(uint32_t tick);
+static void Test_OsaBmWaiterTask(osaTaskParam_t param);
+static void Test_OsaBmHighTask(osaTaskParam_t param);
+static void Test_OsaBmMidTask(osaTaskParam_t param);
+static void Test_OsaBmLowTask(osaTaskParam_t param);
+static void Test_OsaBmLoad(uint32_t id);
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public memory declarations
+*************************************************************************************
+********************************************************************************** */
+SysTick_Type gHostSysTick;
+SCB_Type     gHostScb;
+RTC_Type     gHostRtc;
+uint32_t     SystemCoreClock = BOARD_BOOTCLOCKRUN_CORE_CLOCK;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+********************************************************************************** */
+OSA_TASK_DEFINE(Test_OsaBmWaiterTask, 2, mTestOsaBmWaiters_c, 0, 0);
+OSA_TASK_DEFINE(Test_OsaBmHighTask, 1, 1, 0, 0);
+OSA_TASK_DEFINE(Test_OsaBmMidTask, 3, 2, 0, 0);
+OSA_TASK_DEFINE(Test_OsaBmLowTask, 5, 1, 0, 0);
+
+static const testOsaBmScenario_t mTestOsaBmScenarios[] =
+{
+    {"findfirstset", Test_OsaBmFfsStart,        Test_OsaBmEndTick},
+    {"handles",      Test_OsaBmHandlesStart,    Test_OsaBmEndTick},
+    {"irqtrace",     Test_OsaBmIrqTraceStart,   Test_OsaBmEndTick},
+    {"semaphore",    Test_OsaBmSemStart,        Test_OsaBmSemTick},
+    {"roundrobin",   Test_OsaBmRoundRobinStart, Test_OsaBmRoundRobinTick},
+    {"starvation",   Test_OsaBmStarvationStart, Test_OsaBmStarvationTick},
+};
+
+static const testOsaBmScenario_t* mpTestOsaBmScenario;
+static uint32_t     mTestOsaBmNextScenario;
+static uint32_t     mTestOsaBmScenarioFailures;
+static uint32_t     mTestOsaBmTick;
+static uint32_t     mTestOsaBmTicks;
+static osaEventId_t mTestOsaBmDone;
+
+static uint32_t mTestOsaBmChecks;
+static uint32_t mTestOsaBmFailures;
+
+/* Simulated core */
+static uint8_t  mTestOsaBmPrimask;
+static uint8_t  mTestOsaBmIpsr;
+static uint64_t mTestOsaBmCoreCycles;
+
+/* semaphore scenario */
+static osaSemaphoreId_t mTestOsaBmSem;
+static uint32_t         mTestOsaBmSemTaken[mTestOsaBmWaiters_c];
+
+/* Scheduler scenarios. The cycles are below a tick, and differ per task. */
+static const uint32_t mTestOsaBmCycles[mTestOsaBmLoadTasks_c] = {1000, 3000, 5000, 7000};
+static osaTaskId_t    mTestOsaBmTasks[mTestOsaBmLoadTasks_c];
+static osaEventId_t   mTestOsaBmEvents[mTestOsaBmLoadTasks_c];
+static uint32_t       mTestOsaBmRuns[mTestOsaBmLoadTasks_c];
+static uint32_t       mTestOsaBmRoundRobinLeft;
+static uint32_t       mTestOsaBmLastMid;
+static uint32_t       mTestOsaBmMidRepeats;
+/* Tasks signaled since the last tick, in the order they ran */
+static uint8_t        mTestOsaBmOrder[mTestOsaBmLoadTasks_c + 1];
+static uint32_t       mTestOsaBmOrderCount;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+
+/*! *********************************************************************************
+* \brief  Runs the scenarios in turn, then exits with the number of failures
+*
+********************************************************************************** */
+void main_task(void *argument)
+{
+    osaEventFlags_t flags = 0;
+
+    (void)argument;
+
+    if( NULL == mTestOsaBmDone )
+    {
+        mTestOsaBmDone = OSA_EventCreate(TRUE);
+        HOST_TEST_CHECK(NULL != mTestOsaBmDone);
+        Test_OsaBmNext();
+    }
+    else if( osaStatus_Success == OSA_EventWait(mTestOsaBmDone, 1, FALSE, osaWaitForever_c, &flags) )
+    {
+        Test_OsaBmNext();
+    }
+}
+
+void hardware_init(void)
+{
+}
+
+bool_t HostTest_Check(bool_t cond, const char* pExpr, const char* pFile, uint32_t line)
+{
+    mTestOsaBmChecks++;
+
+    if( !cond )
+    {
+        mTestOsaBmFailures++;
+        printf("%s:%u: check failed: %s\n", pFile, (unsigned)line, pExpr);
+        fflush(stdout);
+    }
+
+    return cond;
+}
+
+/*! *********************************************************************************
+* \brief  Simulated core: PRIMASK, IPSR and the interrupts, in one thread
+*
+********************************************************************************** */
+void Host_DisableIrq(void)
+{
+    mTestOsaBmPrimask = 1;
+}
+
+void Host_EnableIrq(void)
+{
+    mTestOsaBmPrimask = 0;
+
+    if( SCB->ICSR & SCB_ICSR_PENDSTSET_Msk )
+    {
+        SCB->ICSR &= ~SCB_ICSR_PENDSTSET_Msk;
+        SysTick_Handler();
+    }
+}
+
+uint32_t Host_GetPrimask(void)
+{
+    return mTestOsaBmPrimask;
+}
+
+uint32_t Host_GetIpsr(void)
+{
+    return mTestOsaBmIpsr;
+}
+
+void Host_InstallIrqHandler(int32_t irq, void (*handler)(void))
+{
+    (void)irq;
+    (void)handler;
+}
+
+/*! *********************************************************************************
+* \brief  WFI of the idle scheduler: the next interrupt is the SysTick, which reloads
+*         the counter, counts the tick and runs the ISRs of the scenario
+*
+********************************************************************************** */
+void Host_WaitForInterrupt(void)
+{
+    /* The scheduler sleeps when no task is ready, with the interrupts masked, so
+       that none is missed */
+    HOST_TEST_CHECK(1 == mTestOsaBmPrimask);
+    HOST_TEST_CHECK(0 == g_readyTasks);
+
+    if( ++mTestOsaBmTicks > mTestOsaBmMaxTicks_c )
+    {
+        printf("the scenario %s does not end\n", mpTestOsaBmScenario ? mpTestOsaBmScenario->pName : "");
+        exit(EXIT_FAILURE);
+    }
+
+    /* A pending SysTick wakes the core at once */
+    mTestOsaBmIpsr = mTestOsaBmSysTickIpsr_c;
+    if( SCB->ICSR & SCB_ICSR_PENDSTSET_Msk )
+    {
+        SCB->ICSR &= ~SCB_ICSR_PENDSTSET_Msk;
+    }
+    else
+    {
+        Test_OsaBmRtcCount(SysTick->VAL + 1U);
+        SysTick->VAL = SysTick->LOAD;
+    }
+    SysTick_Handler();
+
+    if( (NULL != mpTestOsaBmScenario) && mpTestOsaBmScenario->pfTick(++mTestOsaBmTick) )
+    {
+        mpTestOsaBmScenario = NULL;
+        (void)OSA_EventSet(mTestOsaBmDone, 1);
+    }
+    mTestOsaBmIpsr = 0;
+}
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+********************************************************************************** */
+
+/* Reports the scenario which ended, and starts the next one */
+static void Test_OsaBmNext(void)
+{
+    const testOsaBmScenario_t* pScenario;
+
+    if( mTestOsaBmNextScenario > 0 )
+    {
+        pScenario = &mTestOsaBmScenarios[mTestOsaBmNextScenario - 1];
+        printf("[ %s ] %s\n", (mTestOsaBmScenarioFailures == mTestOsaBmFailures) ? " OK " : "FAIL",
+               pScenario->pName);
+    }
+
+    if( mTestOsaBmNextScenario == NumberOfElements(mTestOsaBmScenarios) )
+    {
+        printf("%u checks, %u failures\n", (unsigned)mTestOsaBmChecks, (unsigned)mTestOsaBmFailures);
+        fflush(stdout);
+        exit(mTestOsaBmFailures ? EXIT_FAILURE : EXIT_SUCCESS);
+    }
+
+    pScenario = &mTestOsaBmScenarios[mTestOsaBmNextScenario++];
+    printf("[ RUN  ] %s\n", pScenario->pName);
+    mTestOsaBmScenarioFailures = mTestOsaBmFailures;
+    mTestOsaBmTick = 0;
+    pScenario->pfStart();
+    mpTestOsaBmScenario = pScenario;
+}
+
+/* Runs the core for a number of cycles: the SysTick counts down, and reloads with
+   an interrupt which counts the tick */
+static void Test_OsaBmBurn(uint32_t cycles)
+{
+    Test_OsaBmRtcCount(cycles);
+
+    while( cycles > SysTick->VAL )
+    {
+        cycles -= SysTick->VAL + 1U;
+        SysTick->VAL = SysTick->LOAD;
+        Test_OsaBmReload();
+    }
+    SysTick->VAL -= cycles;
+}
+
+/* The SysTick interrupt is held pending while the interrupts are masked, and the
+   reloads which follow are lost */
+static void Test_OsaBmReload(void)
+{
+    if( mTestOsaBmPrimask )
+    {
+        SCB->ICSR |= SCB_ICSR_PENDSTSET_Msk;
+    }
+    else
+    {
+        SysTick_Handler();
+    }
+}
+
+/* The RTC counts the cycles of the core, while it is enabled */
+static void Test_OsaBmRtcCount(uint32_t cycles)
+{
+    uint64_t ticks;
+
+    mTestOsaBmCoreCycles += cycles;
+
+    if( RTC->SR & RTC_SR_TCE_MASK )
+    {
+        ticks = (mTestOsaBmCoreCycles << mTestOsaBmRtcBits_c) / SystemCoreClock;
+        RTC->TSR = (uint32_t)(ticks >> mTestOsaBmRtcBits_c);
+        RTC->TPR = (uint32_t)ticks & ((1U << mTestOsaBmRtcBits_c) - 1U);
+    }
+}
+
+/* The de Bruijn lookup, on each bit with all the combinations of the bits above */
+static void Test_OsaBmFfsStart(void)
+{
+    uint32_t seed = 0x2545F491;
+    uint32_t errors = 0;
+    uint32_t i;
+    uint32_t j;
+
+    for( i = 0; i < 32; i++ )
+    {
+        errors += (i == OSA_FindFirstSet(1U << i)) ? 0 : 1;
+        errors += (i == OSA_FindFirstSet(0xFFFFFFFFU << i)) ? 0 : 1;
+
+        for( j = 0; j < 1000; j++ )
+        {
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            errors += (i == OSA_FindFirstSet((seed | 1U) << i)) ? 0 : 1;
+        }
+    }
+    HOST_TEST_CHECK(0 == errors);
+}
+
+/* Allocation and validation of the object handles: only the handles returned by the
+   create functions, and not yet destroyed, are accepted */
+static void Test_OsaBmHandlesStart(void)
+{
+    static osaSemaphoreId_t sems[osNumberOfSemaphores];
+    osaEventId_t event;
+    uint32_t errors = 0;
+    uint32_t i;
+
+    for( i = 0; i < osNumberOfSemaphores; i++ )
+    {
+        sems[i] = OSA_SemaphoreCreate(1);
+        errors += (NULL == sems[i]) ? 1 : 0;
+    }
+    HOST_TEST_CHECK(0 == errors);
+    HOST_TEST_CHECK(NULL == OSA_SemaphoreCreate(1));
+
+    for( i = 0; i < osNumberOfSemaphores; i++ )
+    {
+        errors += (osaStatus_Success == OSA_SemaphoreWait(sems[i], 0)) ? 0 : 1;
+        errors += (osaStatus_Error == OSA_SemaphoreWait((uint8_t*)sems[i] + 1, 0)) ? 0 : 1;
+        errors += (osaStatus_Error == OSA_SemaphoreWait((uint8_t*)sems[i] - 1, 0)) ? 0 : 1;
+    }
+    HOST_TEST_CHECK(0 == errors);
+    HOST_TEST_CHECK(osaStatus_Error == OSA_SemaphorePost((uint8_t*)sems[osNumberOfSemaphores - 1] +
+                                                         sizeof(osSemaphoreStruct_t)));
+
+    /* A handle of another type */
+    event = OSA_EventCreate(TRUE);
+    HOST_TEST_CHECK(NULL != event);
+    HOST_TEST_CHECK(osaStatus_Error == OSA_SemaphorePost(event));
+    HOST_TEST_CHECK(osaStatus_Error == OSA_EventSet(sems[0], 1));
+    HOST_TEST_CHECK(osaStatus_Success == OSA_EventDestroy(event));
+
+    /* Destroyed handles are rejected, and reused lowest first, across the words */
+    HOST_TEST_CHECK(osaStatus_Success == OSA_SemaphoreDestroy(sems[osNumberOfSemaphores - 2]));
+    HOST_TEST_CHECK(osaStatus_Success == OSA_SemaphoreDestroy(sems[3]));
+    HOST_TEST_CHECK(osaStatus_Error == OSA_SemaphoreDestroy(sems[3]));
+    HOST_TEST_CHECK(osaStatus_Error == OSA_SemaphorePost(sems[3]));
+    HOST_TEST_CHECK(sems[3] == OSA_SemaphoreCreate(0));
+    HOST_TEST_CHECK(sems[osNumberOfSemaphores - 2] == OSA_SemaphoreCreate(0));
+    HOST_TEST_CHECK(NULL == OSA_SemaphoreCreate(0));
+
+    for( i = 0; i < osNumberOfSemaphores; i++ )
+    {
+        errors += (osaStatus_Success == OSA_SemaphoreDestroy(sems[i])) ? 0 : 1;
+    }
+    HOST_TEST_CHECK(0 == errors);
+}
+
+/* Masked windows of a part of a tick, and of several ticks, from four callers: the
+   trace lists them exactly, the longest first, although the OSA tick counts at most
+   one reload per window */
+static void Test_OsaBmIrqTraceStart(void)
+{
+    uint32_t period = SysTick->LOAD + 1U;
+    uint32_t durations[4];
+    profilerIrqTrace_t entries[4];
+    uint32_t ticks = OSA_TimeGetMsec();
+    uint32_t i;
+
+    durations[0] = 20U * period + 7U;
+    durations[1] = 5U * period + 123U;
+    durations[2] = period + period / 4U;
+    durations[3] = period / 2U;
+
+    RTC->SR = RTC_SR_TCE_MASK;
+    Test_OsaBmRtcCount(0);
+    Profiler_Init();
+    Profiler_Reset();
+    HOST_TEST_CHECK(0 == mProfilerOverhead);
+
+    OSA_InterruptDisable();
+    Test_OsaBmBurn(durations[3]);
+    OSA_InterruptEnable();
+
+    OSA_InterruptDisable();
+    Test_OsaBmBurn(durations[1]);
+    OSA_InterruptEnable();
+
+    OSA_InterruptDisable();
+    Test_OsaBmBurn(durations[0]);
+    OSA_InterruptEnable();
+
+    OSA_InterruptDisable();
+    Test_OsaBmBurn(durations[2]);
+    OSA_InterruptEnable();
+
+    /* The OSA tick lost the reloads of the long windows */
+    HOST_TEST_CHECK(OSA_TimeGetMsec() - ticks < 26U);
+
+    for( i = 0; i < NumberOfElements(entries); i++ )
+    {
+        HOST_TEST_CHECK(Profiler_GetIrqTrace((uint8_t)i, &entries[i]));
+        HOST_TEST_CHECK(durations[i] == entries[i].duration);
+    }
+    HOST_TEST_CHECK((entries[0].caller != entries[1].caller) && (entries[0].caller != entries[2].caller) &&
+                    (entries[0].caller != entries[3].caller) && (entries[1].caller != entries[2].caller) &&
+                    (entries[1].caller != entries[3].caller) && (entries[2].caller != entries[3].caller));
+
+    /* Without the RTC, the reloads are lost from the trace too */
+    RTC->SR = 0;
+    Profiler_Reset();
+    OSA_InterruptDisable();
+    Test_OsaBmBurn(durations[1]);
+    OSA_InterruptEnable();
+    HOST_TEST_CHECK(Profiler_GetIrqTrace(0, &entries[0]));
+    HOST_TEST_CHECK(entries[0].duration < durations[1]);
+    HOST_TEST_CHECK(0 == (durations[1] - entries[0].duration) % period);
+}
+
+/* Ends a scenario without tasks */
+static bool_t Test_OsaBmEndTick(uint32_t tick)
+{
+    (void)tick;
+    return TRUE;
+}
+
+/* Two tasks wait forever on the same semaphore */
+static void Test_OsaBmSemStart(void)
+{
+    uint32_t i;
+
+    mTestOsaBmSem = OSA_SemaphoreCreate(0);
+    HOST_TEST_CHECK(NULL != mTestOsaBmSem);
+
+    for( i = 0; i < mTestOsaBmWaiters_c; i++ )
+    {
+        HOST_TEST_CHECK(NULL != OSA_TaskCreate(OSA_TASK(Test_OsaBmWaiterTask), (osaTaskParam_t)(uintptr_t)i));
+    }
+}
+
+/* The first tick posts the semaphore for both waiters, the next two for one of them.
+   Each post must be taken before the core sleeps again, by a waiter which was run. */
+static bool_t Test_OsaBmSemTick(uint32_t tick)
+{
+    osSemaphoreStruct_t* pSem = (osSemaphoreStruct_t*)mTestOsaBmSem;
+
+    HOST_TEST_CHECK(0 == pSem->semaphore.semCount);
+    HOST_TEST_CHECK(2 == __builtin_popcount(pSem->semaphore.waitingTasks));
+
+    switch( tick )
+    {
+    case 1:
+        HOST_TEST_CHECK((0 == mTestOsaBmSemTaken[0]) && (0 == mTestOsaBmSemTaken[1]));
+        (void)OSA_SemaphorePost(mTestOsaBmSem);
+        (void)OSA_SemaphorePost(mTestOsaBmSem);
+        break;
+
+    case 2:
+        HOST_TEST_CHECK((1 == mTestOsaBmSemTaken[0]) && (1 == mTestOsaBmSemTaken[1]));
+        (void)OSA_SemaphorePost(mTestOsaBmSem);
+        break;
+
+    case 3:
+        HOST_TEST_CHECK(3 == mTestOsaBmSemTaken[0] + mTestOsaBmSemTaken[1]);
+        (void)OSA_SemaphorePost(mTestOsaBmSem);
+        break;
+
+    default:
+        HOST_TEST_CHECK(4 == mTestOsaBmSemTaken[0] + mTestOsaBmSemTaken[1]);
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
+/* The tasks of medium priority stay ready for mTestOsaBmRoundRobinRuns_c runs: they
+   must run in turns, before the low priority task, and without a sleep of the core */
+static void Test_OsaBmRoundRobinStart(void)
+{
+    uint32_t i;
+
+    mTestOsaBmRoundRobinLeft = mTestOsaBmRoundRobinRuns_c;
+    mTestOsaBmLastMid = mTestOsaBmLoadTasks_c;
+
+    for( i = 0; i < mTestOsaBmLoadTasks_c; i++ )
+    {
+        mTestOsaBmEvents[i] = OSA_EventCreate(TRUE);
+        HOST_TEST_CHECK(NULL != mTestOsaBmEvents[i]);
+    }
+
+    mTestOsaBmTasks[mTestOsaBmHigh_c] = OSA_TaskCreate(OSA_TASK(Test_OsaBmHighTask), NULL);
+    mTestOsaBmTasks[mTestOsaBmMid1_c] = OSA_TaskCreate(OSA_TASK(Test_OsaBmMidTask),
+                                                       (osaTaskParam_t)mTestOsaBmMid1_c);
+    mTestOsaBmTasks[mTestOsaBmMid2_c] = OSA_TaskCreate(OSA_TASK(Test_OsaBmMidTask),
+                                                       (osaTaskParam_t)mTestOsaBmMid2_c);
+    mTestOsaBmTasks[mTestOsaBmLow_c] = OSA_TaskCreate(OSA_TASK(Test_OsaBmLowTask), NULL);
+
+    for( i = 0; i < mTestOsaBmLoadTasks_c; i++ )
+    {
+        HOST_TEST_CHECK(NULL != mTestOsaBmTasks[i]);
+    }
+}
+
+static bool_t Test_OsaBmRoundRobinTick(uint32_t tick)
+{
+    (void)tick;
+
+    HOST_TEST_CHECK(0 == mTestOsaBmRoundRobinLeft);
+    HOST_TEST_CHECK(0 == mTestOsaBmMidRepeats);
+    /* The last run of each one waits */
+    HOST_TEST_CHECK(mTestOsaBmRoundRobinRuns_c / 2 + 1 == mTestOsaBmRuns[mTestOsaBmMid1_c]);
+    HOST_TEST_CHECK(mTestOsaBmRoundRobinRuns_c / 2 + 1 == mTestOsaBmRuns[mTestOsaBmMid2_c]);
+    HOST_TEST_CHECK(1 == mTestOsaBmRuns[mTestOsaBmLow_c]);
+
+    return TRUE;
+}
+
+/* Each tick signals all the tasks, the highest priority one included: the core must
+   run them all, in the order of their priorities, before it sleeps again */
+static void Test_OsaBmStarvationStart(void)
+{
+    mTestOsaBmOrderCount = 0;
+}
+
+static bool_t Test_OsaBmStarvationTick(uint32_t tick)
+{
+    uint32_t count = 0;
+    uint32_t time = 0;
+    uint32_t i;
+
+    if( tick > 1 )
+    {
+        HOST_TEST_CHECK(mTestOsaBmLoadTasks_c == mTestOsaBmOrderCount);
+        HOST_TEST_CHECK((mTestOsaBmHigh_c == mTestOsaBmOrder[0]) && (mTestOsaBmLow_c == mTestOsaBmOrder[3]));
+    }
+    mTestOsaBmOrderCount = 0;
+
+    if( tick <= mTestOsaBmStarvationTicks_c )
+    {
+        for( i = 0; i < mTestOsaBmLoadTasks_c; i++ )
+        {
+            (void)OSA_EventSet(mTestOsaBmEvents[i], 1);
+        }
+
+        return FALSE;
+    }
+
+    /* Every run was counted, with the cycles it burnt */
+    for( i = 0; i < mTestOsaBmLoadTasks_c; i++ )
+    {
+        HOST_TEST_CHECK(osaStatus_Success == OSA_TaskGetStats(mTestOsaBmTasks[i], &count, &time));
+        HOST_TEST_CHECK(mTestOsaBmRuns[i] == count);
+        HOST_TEST_CHECK(mTestOsaBmRuns[i] * mTestOsaBmCycles[i] == time);
+    }
+    HOST_TEST_CHECK(mTestOsaBmTicks == OSA_SchedulerGetIdleCount());
+    HOST_TEST_CHECK(osaStatus_Error == OSA_TaskGetStats(NULL, &count, &time));
+
+    return TRUE;
+}
+
+static void Test_OsaBmWaiterTask(osaTaskParam_t param)
+{
+    if( osaStatus_Success == OSA_SemaphoreWait(mTestOsaBmSem, osaWaitForever_c) )
+    {
+        mTestOsaBmSemTaken[(uintptr_t)param]++;
+    }
+}
+
+static void Test_OsaBmHighTask(osaTaskParam_t param)
+{
+    (void)param;
+    Test_OsaBmLoad(mTestOsaBmHigh_c);
+}
+
+static void Test_OsaBmMidTask(osaTaskParam_t param)
+{
+    Test_OsaBmLoad((uint32_t)(uintptr_t)param);
+}
+
+static void Test_OsaBmLowTask(osaTaskParam_t param)
+{
+    (void)param;
+    Test_OsaBmLoad(mTestOsaBmLow_c);
+}
+
+/* Body of the scheduler scenario tasks */
+static void Test_OsaBmLoad(uint32_t id)
+{
+    uint32_t rank = OSA_FindFirstSet(g_curTask->readyMask);
+    osaEventFlags_t flags = 0;
+
+    /* No task of a higher priority is ready */
+    HOST_TEST_CHECK(0 == (g_readyTasks & (g_curTask->readyMask - 1U) & ~g_rankGroup[rank]));
+
+    Test_OsaBmBurn(mTestOsaBmCycles[id]);
+    mTestOsaBmRuns[id]++;
+
+    if( (mTestOsaBmRoundRobinLeft > 0) && ((mTestOsaBmMid1_c == id) || (mTestOsaBmMid2_c == id)) )
+    {
+        mTestOsaBmMidRepeats += (id == mTestOsaBmLastMid) ? 1 : 0;
+        mTestOsaBmLastMid = id;
+        mTestOsaBmRoundRobinLeft--;
+        return;
+    }
+
+    if( (osaStatus_Success == OSA_EventWait(mTestOsaBmEvents[id], 1, FALSE, osaWaitForever_c, &flags)) &&
+        (mTestOsaBmOrderCount < NumberOfElements(mTestOsaBmOrder)) )
+    {
+        mTestOsaBmOrder[mTestOsaBmOrderCount++] = (uint8_t)id;
+    }
+}
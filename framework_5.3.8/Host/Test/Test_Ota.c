@@ -0,0 +1,253 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Host tests of OtaSupport, on the data flash model of Host_Eeprom.c. An image is
+* pushed, committed and read back. Built with gOtaPipelinedWrite_d, the chunks
+* arrive out of order and some twice, and the pushes which return gOtaBusy_c are
+* retried: the pipeline must never wait for the memory, nor program a byte twice.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include "HostTest.h"
+#include "Host.h"
+#include "FunctionLib.h"
+#include "OtaSupport.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+********************************************************************************** */
+#define mTestOtaImageLength_c      (20000)
+#define mTestOtaMaxChunks_c        (mTestOtaImageLength_c / mTestOtaMinChunk_c + 1)
+#define mTestOtaMinChunk_c         (80)
+#define mTestOtaMaxChunk_c         (200)
+/* Chunks are shuffled within windows which span less than gOtaPipelinePages_d pages */
+#define mTestOtaWindow_c           (6)
+#define mTestOtaReadChunk_c        (1000)
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+********************************************************************************** */
+typedef struct testOtaChunk_tag
+{
+    uint32_t offset;
+    uint16_t length;
+} testOtaChunk_t;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+********************************************************************************** */
+static uint32_t Test_OtaRandom(void);
+static uint32_t Test_OtaMakeChunks(void);
+static otaResult_t Test_OtaPush(const testOtaChunk_t *pChunk, uint32_t *pBusy);
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+********************************************************************************** */
+static uint8_t        mTestOtaImage[mTestOtaImageLength_c];
+static uint8_t        mTestOtaRead[mTestOtaReadChunk_c];
+static uint8_t        mTestOtaBitmap[gBootData_SectorsBitmap_Size_c];
+static testOtaChunk_t mTestOtaChunks[mTestOtaMaxChunks_c];
+static uint32_t       mTestOtaSeed = 0x2545F491;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+void Test_Ota(void)
+{
+    hostEepromStats_t stats;
+    otaResult_t status;
+    uint32_t imageLength;
+    uint32_t chunks;
+    uint32_t busy = 0;
+    uint32_t errors = 0;
+    uint32_t i;
+    uint32_t j;
+
+    for( i = 0; i < mTestOtaImageLength_c; i++ )
+    {
+        mTestOtaImage[i] = (uint8_t)Test_OtaRandom();
+    }
+    FLib_MemSet(mTestOtaBitmap, 0xFF, sizeof(mTestOtaBitmap));
+    chunks = Test_OtaMakeChunks();
+
+    HOST_TEST_CHECK(gOtaInvalidOperation_c == OTA_PushImageChunk(mTestOtaImage, 16, NULL, NULL));
+    HOST_TEST_CHECK(gOtaInvalidOperation_c == OTA_CommitImage(mTestOtaBitmap));
+    HOST_TEST_CHECK(gOtaImageTooLarge_c == OTA_StartImage(gEepromParams_TotalSize_c));
+
+    HOST_TEST_CHECK(gOtaSucess_c == OTA_StartImage(mTestOtaImageLength_c));
+    HOST_TEST_CHECK(gOtaInvalidOperation_c == OTA_StartImage(mTestOtaImageLength_c));
+    HOST_TEST_CHECK(gOtaSucess_c == OTA_EraseExternalMemory());
+    Host_EepromResetStats();
+
+    /* Invalid chunks */
+    HOST_TEST_CHECK(gOtaInvalidParam_c == OTA_PushImageChunk(NULL, 16, NULL, NULL));
+    HOST_TEST_CHECK(gOtaInvalidParam_c == OTA_PushImageChunk(mTestOtaImage, 0, NULL, NULL));
+#if gOtaPipelinedWrite_d
+    /* Only the pipeline bounds the chunks by their offset */
+    imageLength = mTestOtaImageLength_c - 8;
+    HOST_TEST_CHECK(gOtaInvalidParam_c == OTA_PushImageChunk(mTestOtaImage, 16, NULL, &imageLength));
+#endif
+
+    for( i = 0; i < chunks; i++ )
+    {
+        status = Test_OtaPush(&mTestOtaChunks[i], &busy);
+#if gOtaPipelinedWrite_d
+        /* Some chunks are received again */
+        if( (gOtaSucess_c == status) && (0 == Test_OtaRandom() % 10) )
+        {
+            status = Test_OtaPush(&mTestOtaChunks[i], &busy);
+        }
+#endif
+        errors += (gOtaSucess_c == status) ? 0 : 1;
+    }
+    HOST_TEST_CHECK(0 == errors);
+
+    Host_EepromGetStats(&stats);
+#if gOtaPipelinedWrite_d
+    /* The pushes returned gOtaBusy_c instead of waiting for the memory */
+    HOST_TEST_CHECK(busy > 0);
+    HOST_TEST_CHECK(0 == stats.busyWaits);
+#else
+    HOST_TEST_CHECK(0 == busy);
+    HOST_TEST_CHECK(chunks == stats.writes);
+#endif
+
+    /* Commit once the staged pages are written */
+    do
+    {
+        status = OTA_CommitImage(mTestOtaBitmap);
+    } while( gOtaBusy_c == status );
+    HOST_TEST_CHECK(gOtaSucess_c == status);
+    HOST_TEST_CHECK(gOtaInvalidOperation_c == OTA_CommitImage(mTestOtaBitmap));
+
+    Host_EepromGetStats(&stats);
+    HOST_TEST_CHECK(0 == stats.reprogrammedBytes);
+    HOST_TEST_CHECK((mTestOtaImageLength_c + sizeof(uint32_t) + gBootData_SectorsBitmap_Size_c) ==
+                    stats.programmedBytes);
+
+    /* The image, its length and the bitmap are in the memory */
+    for( i = 0; i < mTestOtaImageLength_c; i += j )
+    {
+        j = mTestOtaImageLength_c - i;
+        if( j > mTestOtaReadChunk_c )
+        {
+            j = mTestOtaReadChunk_c;
+        }
+
+        HOST_TEST_CHECK(gOtaSucess_c == OTA_ReadExternalMemory(mTestOtaRead, (uint16_t)j, gBootData_Image_Offset_c + i));
+        errors += FLib_MemCmp(mTestOtaRead, &mTestOtaImage[i], j) ? 0 : 1;
+    }
+    HOST_TEST_CHECK(0 == errors);
+
+    HOST_TEST_CHECK(gOtaSucess_c == OTA_ReadExternalMemory((uint8_t*)&imageLength, sizeof(imageLength),
+                                                           gBootData_ImageLength_Offset_c));
+    HOST_TEST_CHECK(mTestOtaImageLength_c == imageLength);
+    HOST_TEST_CHECK(gOtaSucess_c == OTA_ReadExternalMemory(mTestOtaRead, gBootData_SectorsBitmap_Size_c,
+                                                           gBootData_SectorsBitmap_Offset_c));
+    HOST_TEST_CHECK_BUFFER(mTestOtaRead, mTestOtaBitmap, gBootData_SectorsBitmap_Size_c);
+
+    /* A cancelled image can be started again */
+    HOST_TEST_CHECK(gOtaSucess_c == OTA_StartImage(mTestOtaImageLength_c));
+    HOST_TEST_CHECK(gOtaSucess_c == Test_OtaPush(&mTestOtaChunks[0], &busy));
+    OTA_CancelImage();
+    HOST_TEST_CHECK(gOtaInvalidOperation_c == OTA_PushImageChunk(mTestOtaImage, 16, NULL, NULL));
+    HOST_TEST_CHECK(gOtaSucess_c == OTA_StartImage(mTestOtaImageLength_c));
+    OTA_CancelImage();
+}
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+********************************************************************************** */
+
+/* xorshift32, so that every run pushes the same chunks */
+static uint32_t Test_OtaRandom(void)
+{
+    mTestOtaSeed ^= mTestOtaSeed << 13;
+    mTestOtaSeed ^= mTestOtaSeed >> 17;
+    mTestOtaSeed ^= mTestOtaSeed << 5;
+
+    return mTestOtaSeed;
+}
+
+/* Cuts the image in chunks, shuffled within windows with gOtaPipelinedWrite_d */
+static uint32_t Test_OtaMakeChunks(void)
+{
+    testOtaChunk_t chunk;
+    uint32_t offset = 0;
+    uint32_t count = 0;
+    uint32_t i;
+    uint32_t j;
+
+    while( offset < mTestOtaImageLength_c )
+    {
+        chunk.offset = offset;
+        chunk.length = (uint16_t)(mTestOtaMinChunk_c + Test_OtaRandom() % (mTestOtaMaxChunk_c - mTestOtaMinChunk_c + 1));
+
+        if( chunk.length > mTestOtaImageLength_c - offset )
+        {
+            chunk.length = (uint16_t)(mTestOtaImageLength_c - offset);
+        }
+
+        mTestOtaChunks[count++] = chunk;
+        offset += chunk.length;
+    }
+
+#if gOtaPipelinedWrite_d
+    for( i = 0; i + mTestOtaWindow_c <= count; i += mTestOtaWindow_c )
+    {
+        for( j = 0; j < mTestOtaWindow_c; j++ )
+        {
+            chunk = mTestOtaChunks[i + j];
+            offset = i + Test_OtaRandom() % mTestOtaWindow_c;
+            mTestOtaChunks[i + j] = mTestOtaChunks[offset];
+            mTestOtaChunks[offset] = chunk;
+        }
+    }
+#else
+    (void)i;
+    (void)j;
+#endif
+
+    return count;
+}
+
+/* Pushes a chunk, again while the pipeline is busy */
+static otaResult_t Test_OtaPush(const testOtaChunk_t *pChunk, uint32_t *pBusy)
+{
+    uint32_t offset;
+    otaResult_t status;
+
+    for( ;; )
+    {
+        offset = pChunk->offset;
+        status = OTA_PushImageChunk(&mTestOtaImage[pChunk->offset], pChunk->length, NULL, &offset);
+
+        if( gOtaBusy_c != status )
+        {
+            return status;
+        }
+
+        (*pBusy)++;
+    }
+}
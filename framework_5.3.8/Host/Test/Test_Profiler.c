@@ -0,0 +1,167 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Host tests of the Profiler probes, timed by clock_gettime(): nested sections of
+* known minimum durations, the order of the probes, and the statistics after a
+* reset.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include <string.h>
+
+#include "HostTest.h"
+#include "Profiler.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+********************************************************************************** */
+#define mTestProfilerNsPerUs_c     (1000U)
+#define mTestProfilerRuns_c        (3)
+/* The inner section of run i waits (i + 1) times this */
+#define mTestProfilerWaitUs_c      (200)
+/* Scheduling delays of the host, above which a run is not expected */
+#define mTestProfilerSlackUs_c     (20000)
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+********************************************************************************** */
+static void Test_ProfilerSection(uint32_t us);
+static void Test_ProfilerEmpty(void);
+static void Test_ProfilerWait(uint32_t us);
+static int32_t Test_ProfilerFind(const char* pName, profilerStats_t* pStats);
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+void Test_Profiler(void)
+{
+    profilerStats_t outer;
+    profilerStats_t inner;
+    profilerStats_t empty;
+    int32_t outerIndex;
+    int32_t innerIndex;
+    uint32_t i;
+
+    Profiler_Init();
+    HOST_TEST_CHECK(1000000000U == Profiler_GetTimeFrequency());
+    HOST_TEST_CHECK(FALSE == Profiler_GetStats(0xFF, &outer));
+
+    /* A probe is listed from its first stop on */
+    HOST_TEST_CHECK(-1 == Test_ProfilerFind("test_inner", &inner));
+
+    for( i = 0; i < mTestProfilerRuns_c; i++ )
+    {
+        Test_ProfilerSection((i + 1) * mTestProfilerWaitUs_c);
+    }
+
+    /* The inner probe stops first, so it is listed first */
+    innerIndex = Test_ProfilerFind("test_inner", &inner);
+    outerIndex = Test_ProfilerFind("test_outer", &outer);
+    HOST_TEST_CHECK(innerIndex >= 0);
+    HOST_TEST_CHECK(outerIndex > innerIndex);
+
+    HOST_TEST_CHECK(mTestProfilerRuns_c == inner.count);
+    HOST_TEST_CHECK(mTestProfilerRuns_c == outer.count);
+    HOST_TEST_CHECK(inner.min >= mTestProfilerWaitUs_c * mTestProfilerNsPerUs_c);
+    HOST_TEST_CHECK(inner.min < (mTestProfilerWaitUs_c + mTestProfilerSlackUs_c) * mTestProfilerNsPerUs_c);
+    HOST_TEST_CHECK(inner.max >= mTestProfilerRuns_c * mTestProfilerWaitUs_c * mTestProfilerNsPerUs_c);
+    HOST_TEST_CHECK((inner.min <= inner.average) && (inner.average <= inner.max));
+    HOST_TEST_CHECK(inner.average >= 2 * mTestProfilerWaitUs_c * mTestProfilerNsPerUs_c);
+
+    /* The outer section waits as long as the inner one, and contains it */
+    HOST_TEST_CHECK(outer.min >= inner.min + mTestProfilerWaitUs_c * mTestProfilerNsPerUs_c);
+    HOST_TEST_CHECK(outer.max >= 2 * mTestProfilerRuns_c * mTestProfilerWaitUs_c * mTestProfilerNsPerUs_c);
+    HOST_TEST_CHECK(outer.average >= inner.average + 2 * mTestProfilerWaitUs_c * mTestProfilerNsPerUs_c);
+
+    /* The cost of the probe itself is not accounted */
+    Test_ProfilerEmpty();
+    HOST_TEST_CHECK(Test_ProfilerFind("test_empty", &empty) > outerIndex);
+    HOST_TEST_CHECK(1 == empty.count);
+    HOST_TEST_CHECK(empty.max < mTestProfilerSlackUs_c * mTestProfilerNsPerUs_c);
+
+    /* A reset clears the statistics, the probes stay listed */
+    Profiler_Reset();
+    HOST_TEST_CHECK(innerIndex == Test_ProfilerFind("test_inner", &inner));
+    HOST_TEST_CHECK(0 == inner.count);
+    HOST_TEST_CHECK(0 == inner.min);
+    HOST_TEST_CHECK(0 == inner.max);
+    HOST_TEST_CHECK(0 == inner.average);
+
+    Test_ProfilerSection(mTestProfilerWaitUs_c);
+    HOST_TEST_CHECK(innerIndex == Test_ProfilerFind("test_inner", &inner));
+    HOST_TEST_CHECK(outerIndex == Test_ProfilerFind("test_outer", &outer));
+    HOST_TEST_CHECK(1 == inner.count);
+    HOST_TEST_CHECK((inner.min == inner.max) && (inner.max == inner.average));
+    HOST_TEST_CHECK(inner.min >= mTestProfilerWaitUs_c * mTestProfilerNsPerUs_c);
+    HOST_TEST_CHECK(1 == outer.count);
+    HOST_TEST_CHECK(outer.min >= inner.min + mTestProfilerWaitUs_c * mTestProfilerNsPerUs_c);
+}
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+********************************************************************************** */
+
+/* Waits, then runs a nested section which waits as long */
+static void Test_ProfilerSection(uint32_t us)
+{
+    PROFILER_PROBE_START(mTestProfilerOuter, "test_outer");
+
+    Test_ProfilerWait(us);
+    {
+        PROFILER_PROBE_START(mTestProfilerInner, "test_inner");
+        Test_ProfilerWait(us);
+        PROFILER_PROBE_STOP(mTestProfilerInner);
+    }
+
+    PROFILER_PROBE_STOP(mTestProfilerOuter);
+}
+
+static void Test_ProfilerEmpty(void)
+{
+    PROFILER_PROBE_START(mTestProfilerEmpty, "test_empty");
+    PROFILER_PROBE_STOP(mTestProfilerEmpty);
+}
+
+/* Busy waits, on the time base of the Profiler */
+static void Test_ProfilerWait(uint32_t us)
+{
+    uint32_t start = Profiler_GetTime();
+
+    while( (Profiler_GetTime() - start) < us * mTestProfilerNsPerUs_c )
+    {
+    }
+}
+
+/* Returns the index of a probe and its statistics, or -1. The framework has probes
+   of its own. */
+static int32_t Test_ProfilerFind(const char* pName, profilerStats_t* pStats)
+{
+    uint8_t i;
+
+    for( i = 0; Profiler_GetStats(i, pStats); i++ )
+    {
+        if( 0 == strcmp(pName, pStats->pName) )
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
@@ -0,0 +1,173 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Host tests of the Profiler time base of a bare metal target without the OSA timer:
+* the free running 24 bit SysTick. The file includes Profiler.c, built for the target
+* time base, and sets the simulated counter between the start and the stop of the
+* probes, so that the durations across the reload of the counter are exact.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "HostTest.h"
+#include "clock_config.h"
+#include "Profiler.c"
+
+#if !mProfilerFreeRunning_d
+#error "The free running SysTick time base is not selected"
+#endif
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+********************************************************************************** */
+/* SysTick values at the start and at the stop of a section, and its duration */
+typedef struct testProfilerSysTickSection_tag
+{
+    uint32_t startVal;
+    uint32_t stopVal;
+    uint32_t cycles;
+} testProfilerSysTickSection_t;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+********************************************************************************** */
+static uint32_t Test_ProfilerSysTickRun(const testProfilerSysTickSection_t* pSection);
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public memory declarations
+*************************************************************************************
+********************************************************************************** */
+SysTick_Type gHostSysTick;
+uint32_t     SystemCoreClock = BOARD_BOOTCLOCKRUN_CORE_CLOCK;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+********************************************************************************** */
+static const testProfilerSysTickSection_t mTestProfilerSysTickSections[] =
+{
+    /* The counter counts down */
+    {0x800000, 0x7FFF00, 0x000100},
+    /* It reaches 0, and reloads with 0xFFFFFF */
+    {0x000010, 0xFFFFF0, 0x000020},
+    {0x000000, 0xFFFFFF, 0x000001},
+    /* The longest section measured, one cycle short of a period */
+    {0x000001, 0x000002, 0xFFFFFF},
+};
+
+static uint32_t mTestProfilerSysTickChecks;
+static uint32_t mTestProfilerSysTickFailures;
+static int32_t  mTestProfilerSysTickMasked;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+int main(void)
+{
+    profilerStats_t stats;
+    uint64_t total = 0;
+    uint32_t i;
+
+    printf("[ RUN  ] profiler_systick\n");
+
+    /* The SysTick runs from the core clock, without interrupt */
+    Profiler_Init();
+    HOST_TEST_CHECK(SysTick_LOAD_RELOAD_Msk == SysTick->LOAD);
+    HOST_TEST_CHECK((SysTick_CTRL_ENABLE_Msk | SysTick_CTRL_CLKSOURCE_Msk) == SysTick->CTRL);
+    HOST_TEST_CHECK(SystemCoreClock == Profiler_GetTimeFrequency());
+    HOST_TEST_CHECK(0 == mProfilerOverhead);
+
+    /* The time counts up */
+    SysTick->VAL = 0x123456;
+    HOST_TEST_CHECK((SysTick_LOAD_RELOAD_Msk - 0x123456) == Profiler_GetTime());
+
+    for( i = 0; i < NumberOfElements(mTestProfilerSysTickSections); i++ )
+    {
+        HOST_TEST_CHECK(mTestProfilerSysTickSections[i].cycles ==
+                        Test_ProfilerSysTickRun(&mTestProfilerSysTickSections[i]));
+        total += mTestProfilerSysTickSections[i].cycles;
+    }
+
+    HOST_TEST_CHECK(Profiler_GetStats(0, &stats));
+    HOST_TEST_CHECK(NumberOfElements(mTestProfilerSysTickSections) == stats.count);
+    HOST_TEST_CHECK(0x000001 == stats.min);
+    HOST_TEST_CHECK(0xFFFFFF == stats.max);
+    HOST_TEST_CHECK((uint32_t)(total / NumberOfElements(mTestProfilerSysTickSections)) == stats.average);
+    HOST_TEST_CHECK(FALSE == Profiler_GetStats(1, &stats));
+    HOST_TEST_CHECK(0 == mTestProfilerSysTickMasked);
+
+    printf("[ %s ] profiler_systick\n", mTestProfilerSysTickFailures ? "FAIL" : " OK ");
+    printf("%u checks, %u failures\n", (unsigned)mTestProfilerSysTickChecks, (unsigned)mTestProfilerSysTickFailures);
+
+    return mTestProfilerSysTickFailures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+bool_t HostTest_Check(bool_t cond, const char* pExpr, const char* pFile, uint32_t line)
+{
+    mTestProfilerSysTickChecks++;
+
+    if( !cond )
+    {
+        mTestProfilerSysTickFailures++;
+        printf("%s:%u: check failed: %s\n", pFile, (unsigned)line, pExpr);
+        fflush(stdout);
+    }
+
+    return cond;
+}
+
+/* The sections of the Profiler must be balanced */
+void OSA_InterruptDisable(void)
+{
+    mTestProfilerSysTickMasked++;
+}
+
+void OSA_InterruptEnable(void)
+{
+    mTestProfilerSysTickMasked--;
+}
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+********************************************************************************** */
+
+/* Profiles one section, and returns the duration added to the probe */
+static uint32_t Test_ProfilerSysTickRun(const testProfilerSysTickSection_t* pSection)
+{
+    uint64_t total = (NULL != mpProfilerHead) ? mpProfilerHead->total : 0;
+
+    SysTick->VAL = pSection->startVal;
+    {
+        PROFILER_PROBE_START(mTestProfilerSysTickProbe, "systick");
+        SysTick->VAL = pSection->stopVal;
+        PROFILER_PROBE_STOP(mTestProfilerSysTickProbe);
+    }
+
+    if( !HOST_TEST_CHECK(NULL != mpProfilerHead) )
+    {
+        return 0;
+    }
+
+    return (uint32_t)(mpProfilerHead->total - total);
+}
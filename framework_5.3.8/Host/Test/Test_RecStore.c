@@ -0,0 +1,182 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Host tests of the record store of the RACP profiles: range queries by sequence
+* and by time key, with time keys which decrease when the user facing time offset
+* is changed, and report walks which go on while records are appended and evicted
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include "HostTest.h"
+#include "record_store_interface.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+********************************************************************************** */
+#define mTestRecStoreCapacity_c    (6)
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+********************************************************************************** */
+typedef struct testRecStoreSlot_tag
+{
+    recStoreHeader_t header;
+    uint32_t         value;
+} testRecStoreSlot_t;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+********************************************************************************** */
+static void Test_RecStoreAppend(uint32_t seqKey, uint32_t timeKey);
+static uint32_t Test_RecStoreWalk(recStoreKey_t key, uint32_t minKey, uint32_t maxKey, uint32_t *pSeqKeys);
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+********************************************************************************** */
+static recStore_t         mTestRecStore;
+static testRecStoreSlot_t mTestRecStoreSlots[mTestRecStoreCapacity_c];
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+void Test_RecStore(void)
+{
+    uint32_t seqKeys[mTestRecStoreCapacity_c];
+    uint32_t cursor;
+    uint16_t first;
+    uint16_t position;
+
+    FLib_MemSet(mTestRecStoreSlots, 0, sizeof(mTestRecStoreSlots));
+    HOST_TEST_CHECK(gBleSuccess_c == RecStore_Init(&mTestRecStore, mTestRecStoreSlots,
+                                                   sizeof(testRecStoreSlot_t), mTestRecStoreCapacity_c));
+    HOST_TEST_CHECK(0 == RecStore_FindRange(&mTestRecStore, gRecStore_TimeKey_c, 0, 0xFFFFFFFFU, &first));
+    HOST_TEST_CHECK(gRecStore_InvalidIndex_c == first);
+
+    /* Non-decreasing time keys: the matches are contiguous */
+    Test_RecStoreAppend(10, 100);
+    Test_RecStoreAppend(11, 200);
+    Test_RecStoreAppend(12, 200);
+    Test_RecStoreAppend(13, 300);
+    HOST_TEST_CHECK(0 == mTestRecStore.timeDescents);
+    HOST_TEST_CHECK(2 == RecStore_FindRange(&mTestRecStore, gRecStore_TimeKey_c, 150, 250, &first));
+    HOST_TEST_CHECK(1 == first);
+    HOST_TEST_CHECK(3 == RecStore_FindRange(&mTestRecStore, gRecStore_SeqKey_c, 11, 0xFFFFFFFFU, &first));
+    HOST_TEST_CHECK(1 == first);
+    HOST_TEST_CHECK(0 == RecStore_FindRange(&mTestRecStore, gRecStore_TimeKey_c, 301, 0xFFFFFFFFU, &first));
+
+    /* The time offset goes back: the newer records have smaller time keys */
+    Test_RecStoreAppend(14, 250);
+    Test_RecStoreAppend(15, 260);
+    HOST_TEST_CHECK(1 == mTestRecStore.timeDescents);
+
+    HOST_TEST_CHECK(3 == RecStore_FindRange(&mTestRecStore, gRecStore_TimeKey_c, 240, 300, &first));
+    HOST_TEST_CHECK(3 == first);
+    HOST_TEST_CHECK(3 == Test_RecStoreWalk(gRecStore_TimeKey_c, 240, 300, seqKeys));
+    HOST_TEST_CHECK((13 == seqKeys[0]) && (14 == seqKeys[1]) && (15 == seqKeys[2]));
+
+    HOST_TEST_CHECK(5 == RecStore_FindRange(&mTestRecStore, gRecStore_TimeKey_c, 200, 0xFFFFFFFFU, &first));
+    HOST_TEST_CHECK(1 == first);
+    HOST_TEST_CHECK(4 == RecStore_FindRange(&mTestRecStore, gRecStore_TimeKey_c, 0, 250, &first));
+    HOST_TEST_CHECK(0 == first);
+    HOST_TEST_CHECK(4 == Test_RecStoreWalk(gRecStore_TimeKey_c, 0, 250, seqKeys));
+    HOST_TEST_CHECK((10 == seqKeys[0]) && (11 == seqKeys[1]) && (12 == seqKeys[2]) && (14 == seqKeys[3]));
+
+    /* The index is rebuilt from the slots, as after a reset */
+    HOST_TEST_CHECK(gBleSuccess_c == RecStore_Init(&mTestRecStore, mTestRecStoreSlots,
+                                                   sizeof(testRecStoreSlot_t), mTestRecStoreCapacity_c));
+    HOST_TEST_CHECK(6 == RecStore_GetCount(&mTestRecStore));
+    HOST_TEST_CHECK(1 == mTestRecStore.timeDescents);
+
+    /* A walk goes on by sequence key while the oldest records are evicted */
+    cursor = 0;
+    position = RecStore_FindNext(&mTestRecStore, gRecStore_TimeKey_c, 200, 260, &cursor);
+    HOST_TEST_CHECK(1 == position);
+    HOST_TEST_CHECK(11 == RecStore_GetHeader(&mTestRecStore, position)->seqKey);
+
+    Test_RecStoreAppend(16, 500);
+    Test_RecStoreAppend(17, 210);
+    HOST_TEST_CHECK(6 == RecStore_GetCount(&mTestRecStore));
+    HOST_TEST_CHECK(2 == mTestRecStore.timeDescents);
+
+    position = RecStore_FindNext(&mTestRecStore, gRecStore_TimeKey_c, 200, 260, &cursor);
+    HOST_TEST_CHECK(0 == position);
+    HOST_TEST_CHECK(12 == RecStore_GetHeader(&mTestRecStore, position)->seqKey);
+    position = RecStore_FindNext(&mTestRecStore, gRecStore_TimeKey_c, 200, 260, &cursor);
+    HOST_TEST_CHECK(14 == RecStore_GetHeader(&mTestRecStore, position)->seqKey);
+    position = RecStore_FindNext(&mTestRecStore, gRecStore_TimeKey_c, 200, 260, &cursor);
+    HOST_TEST_CHECK(15 == RecStore_GetHeader(&mTestRecStore, position)->seqKey);
+    position = RecStore_FindNext(&mTestRecStore, gRecStore_TimeKey_c, 200, 260, &cursor);
+    HOST_TEST_CHECK(17 == RecStore_GetHeader(&mTestRecStore, position)->seqKey);
+    HOST_TEST_CHECK(gRecStore_InvalidIndex_c ==
+                    RecStore_FindNext(&mTestRecStore, gRecStore_TimeKey_c, 200, 260, &cursor));
+
+    /* Once the descents are evicted, the time keys are sorted again */
+    Test_RecStoreAppend(18, 600);
+    Test_RecStoreAppend(19, 700);
+    Test_RecStoreAppend(20, 800);
+    Test_RecStoreAppend(21, 900);
+    HOST_TEST_CHECK(1 == mTestRecStore.timeDescents);
+    Test_RecStoreAppend(22, 1000);
+    HOST_TEST_CHECK(0 == mTestRecStore.timeDescents);
+    HOST_TEST_CHECK(3 == RecStore_FindRange(&mTestRecStore, gRecStore_TimeKey_c, 650, 950, &first));
+    HOST_TEST_CHECK(2 == first);
+
+    /* The sequence keys must increase */
+    HOST_TEST_CHECK(gBleInvalidParameter_c == RecStore_Append(&mTestRecStore, 22, 0, NULL, 0));
+
+    RecStore_Clear(&mTestRecStore);
+    HOST_TEST_CHECK(0 == RecStore_GetCount(&mTestRecStore));
+    HOST_TEST_CHECK(0 == mTestRecStore.timeDescents);
+}
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+********************************************************************************** */
+static void Test_RecStoreAppend(uint32_t seqKey, uint32_t timeKey)
+{
+    HOST_TEST_CHECK(gBleSuccess_c == RecStore_Append(&mTestRecStore, seqKey, timeKey,
+                                                     &timeKey, sizeof(timeKey)));
+}
+
+/* Walks the matching records as a RACP report does, and returns their number */
+static uint32_t Test_RecStoreWalk(recStoreKey_t key, uint32_t minKey, uint32_t maxKey, uint32_t *pSeqKeys)
+{
+    uint32_t cursor = 0;
+    uint32_t count = 0;
+    uint16_t position;
+
+    while( count < mTestRecStoreCapacity_c )
+    {
+        position = RecStore_FindNext(&mTestRecStore, key, minKey, maxKey, &cursor);
+
+        if( position == gRecStore_InvalidIndex_c )
+        {
+            break;
+        }
+
+        pSeqKeys[count++] = RecStore_GetHeader(&mTestRecStore, position)->seqKey;
+    }
+
+    return count;
+}
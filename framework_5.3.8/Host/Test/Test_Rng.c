@@ -0,0 +1,163 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Host tests of the CTR_DRBG of RNG.c, built with gHostRngDrbg_d: the NIST CAVP
+* known answer for AES-128 without derivation function, the output read in
+* fragments across the buffer refills, and two tasks which read concurrently and
+* must never get the same bytes.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include <stdlib.h>
+#include <string.h>
+
+#include "HostTest.h"
+#include "fsl_os_abstraction.h"
+#include "RNG_Interface.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+********************************************************************************** */
+#define mTestRngBlockSize_c        (16)
+#define mTestRngReads_c            (2000)
+#define mTestRngTasks_c            (2)
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+********************************************************************************** */
+static void Test_RngReaderTask(osaTaskParam_t param);
+static int Test_RngCompareBlocks(const void *pA, const void *pB);
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+********************************************************************************** */
+OSA_TASK_DEFINE(Test_RngReaderTask, 3, mTestRngTasks_c, 1024, 0);
+
+/* CTR_DRBG.rsp, [AES-128 no df], [PredictionResistance = False],
+   [EntropyInputLen = 256], [ReturnedBitsLen = 512], COUNT = 0: instantiate,
+   reseed, generate twice and return the second output */
+static const char mTestRngEntropy[] =
+    "ed1e7f21ef66ea5d8e2a85b9337245445b71d6393a4eecb0e63c193d0f72f9a9";
+static const char mTestRngEntropyReseed[] =
+    "303fb519f0a4e17d6df0b6426aa0ecb2a36079bd48be47ad2a8dbfe48da3efad";
+static const char mTestRngReturnedBits[] =
+    "f80111d08e874672f32f42997133a5210f7a9375e22cea70587f9cfafebe0f6a"
+    "6aa2eb68e7dd9164536d53fa020fcab20f54caddfab7d6d91e5ffec1dfd8deaa";
+
+/* The entropy of COUNT = 0 of [PredictionResistance = False] without reseed, mixed
+   into the state left by the known answer test, and the next two generate outputs */
+static const char mTestRngSeed[] =
+    "ce50f33da5d4c1d3d4004eb35244b7f2cd7f2e5076fbf6780a7ff634b249a5fc";
+static const char mTestRngStream[] =
+    "4c74babc7a5f50e10feeafa2be358b15d7d75c725e5a6fed27674393d528db57"
+    "649099b30ebf4d24d596562a12817b37f9cec74b9e8ce7c55b95b93b264be4d7"
+    "112f87512ac1d94c93fa8c7284ae1f65547ae6b4032e879a32f13dea9ff8dfd3"
+    "f24c6fea3d27e5d591b7c7753e7905ac68808bb70c001cd1d69d2776164d9ff3";
+
+static osaSemaphoreId_t mTestRngDone;
+static uint8_t mTestRngBlocks[mTestRngTasks_c * mTestRngReads_c][mTestRngBlockSize_c];
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+void Test_Rng(void)
+{
+    uint8_t seed[32];
+    uint8_t expected[128];
+    uint8_t actual[128];
+    uint32_t errors = 0;
+    uint32_t length;
+    uint32_t i;
+
+    /* Not seeded yet: the host has no TRNG */
+    HOST_TEST_CHECK(gRngInternalError_d == RNG_GetBytes(actual, 1));
+    HOST_TEST_CHECK(gRngNullPointer_d == RNG_GetBytes(NULL, 1));
+    HOST_TEST_CHECK(gRngSuccess_d == RNG_GetBytes(NULL, 0));
+
+    /* Instantiate and reseed are the update function, with the entropy as seed */
+    (void)HostTest_Hex(seed, mTestRngEntropy);
+    RNG_SetPseudoRandomNoSeed(seed);
+    (void)HostTest_Hex(seed, mTestRngEntropyReseed);
+    RNG_SetPseudoRandomNoSeed(seed);
+
+    /* A generate operation of 512 bits refills the 64 byte buffer */
+    length = HostTest_Hex(expected, mTestRngReturnedBits);
+    HOST_TEST_CHECK(gRngSuccess_d == RNG_GetBytes(actual, length));
+    HOST_TEST_CHECK(gRngSuccess_d == RNG_GetBytes(actual, length));
+    HOST_TEST_CHECK_BUFFER(actual, expected, length);
+
+    /* The same output, read in fragments which straddle the refills */
+    (void)HostTest_Hex(seed, mTestRngSeed);
+    RNG_SetPseudoRandomNoSeed(seed);
+    length = HostTest_Hex(expected, mTestRngStream);
+    for( i = 0; i < length; i += 7 )
+    {
+        HOST_TEST_CHECK(gRngSuccess_d == RNG_GetBytes(&actual[i], (length - i < 7) ? (length - i) : 7));
+    }
+    HOST_TEST_CHECK_BUFFER(actual, expected, length);
+
+    /* Each block read by the tasks is an AES block of the output, they all differ */
+    mTestRngDone = OSA_SemaphoreCreate(0);
+    HOST_TEST_CHECK(NULL != mTestRngDone);
+
+    for( i = 0; i < mTestRngTasks_c; i++ )
+    {
+        HOST_TEST_CHECK(NULL != OSA_TaskCreate(OSA_TASK(Test_RngReaderTask), (osaTaskParam_t)(uintptr_t)i));
+    }
+    for( i = 0; i < mTestRngTasks_c; i++ )
+    {
+        HOST_TEST_CHECK(osaStatus_Success == OSA_SemaphoreWait(mTestRngDone, 10000));
+    }
+
+    qsort(mTestRngBlocks, NumberOfElements(mTestRngBlocks), mTestRngBlockSize_c, Test_RngCompareBlocks);
+    for( i = 1; i < NumberOfElements(mTestRngBlocks); i++ )
+    {
+        errors += (0 == memcmp(mTestRngBlocks[i - 1], mTestRngBlocks[i], mTestRngBlockSize_c)) ? 1 : 0;
+    }
+    HOST_TEST_CHECK(0 == errors);
+
+    HOST_TEST_CHECK(osaStatus_Success == OSA_SemaphoreDestroy(mTestRngDone));
+}
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+********************************************************************************** */
+static void Test_RngReaderTask(osaTaskParam_t param)
+{
+    uint32_t first = (uint32_t)(uintptr_t)param * mTestRngReads_c;
+    uint32_t i;
+
+    for( i = first; i < first + mTestRngReads_c; i++ )
+    {
+        if( gRngSuccess_d != RNG_GetBytes(mTestRngBlocks[i], mTestRngBlockSize_c) )
+        {
+            break;
+        }
+    }
+
+    (void)OSA_SemaphorePost(mTestRngDone);
+}
+
+static int Test_RngCompareBlocks(const void *pA, const void *pB)
+{
+    return memcmp(pA, pB, mTestRngBlockSize_c);
+}
@@ -0,0 +1,193 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Host tests of the whitener: Whiten_Frame() and Whiten_Update(), on fragments of
+* every alignment, against the bitwise Whiten() for every seed of a 7 bit and a
+* 9 bit LFSR. Frames longer than the 255 bytes of Whiten() are checked against a
+* copy of its loop with a 32 bit length.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include "HostTest.h"
+#include "FunctionLib.h"
+#include "Scrambler.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+********************************************************************************** */
+#define mTestWhitenShortLen_c      (255)
+#define mTestWhitenLongLen_c       (700)
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+********************************************************************************** */
+static void Test_WhitenReference(const Whitener_config_t *pConfig, uint8_t *pBuff, uint32_t buffLength);
+static void Test_WhitenFragments(Whitener_handle_t *pHandle, uint8_t *pBuff, uint32_t buffLength, uint32_t seed);
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+********************************************************************************** */
+/* BLE data channel whitening, x^7 + x^4 + 1, and PN9, x^9 + x^5 + 1, with offsets.
+   Whiten() only whitens with a Galois LFSR: the Fibonacci one must leave the data. */
+static const Whitener_config_t mTestWhitenConfigs[] =
+{
+    {gGaloisPolyType,    gWhitenRefInput,   0, 0, 7, 0x53,  0x11},
+    {gGaloisPolyType,    gWhitenInputNoRef, 2, 3, 9, 0x1FF, 0x21},
+    {gFibonnaciPolyType, gWhitenInputNoRef, 1, 1, 7, 0x01,  0x11},
+};
+
+static Whitener_handle_t mTestWhitenHandle;
+static uint8_t mTestWhitenData[mTestWhitenLongLen_c];
+static uint8_t mTestWhitenExpected[mTestWhitenLongLen_c];
+static uint8_t mTestWhitenActual[mTestWhitenLongLen_c + 4];
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+void Test_Scrambler(void)
+{
+    Whitener_config_t config;
+    uint32_t errors;
+    uint32_t seed;
+    uint32_t i;
+    uint32_t c;
+
+    for( i = 0; i < mTestWhitenLongLen_c; i++ )
+    {
+        mTestWhitenData[i] = (uint8_t)(i * 13 + 5);
+    }
+
+    config = mTestWhitenConfigs[0];
+    config.whitenSize = gWhitenMaxSize_c + 1;
+    HOST_TEST_CHECK(gWhitenInvalidSize_c == Whiten_Init(&mTestWhitenHandle, &config));
+
+    for( c = 0; c < NumberOfElements(mTestWhitenConfigs); c++ )
+    {
+        config = mTestWhitenConfigs[c];
+        HOST_TEST_CHECK(gWhitenSuccess_c == Whiten_Init(&mTestWhitenHandle, &config));
+
+        /* The seed set by Whiten_Init() */
+        FLib_MemCpy(mTestWhitenExpected, mTestWhitenData, mTestWhitenShortLen_c);
+        Whiten(&config, mTestWhitenExpected, mTestWhitenShortLen_c);
+        FLib_MemCpy(mTestWhitenActual, mTestWhitenData, mTestWhitenShortLen_c);
+        Whiten_Frame(&mTestWhitenHandle, mTestWhitenActual, mTestWhitenShortLen_c);
+        HOST_TEST_CHECK_BUFFER(mTestWhitenActual, mTestWhitenExpected, mTestWhitenShortLen_c);
+
+        /* Every seed, counting the mismatches so that a failure is reported once */
+        errors = 0;
+        for( seed = 0; seed < (1U << config.whitenSize); seed++ )
+        {
+            config.whitenInit = (uint16_t)seed;
+            Whiten_SetSeed(&mTestWhitenHandle, (uint16_t)seed);
+
+            /* Short frame, against Whiten() and its 32 bit length copy */
+            FLib_MemCpy(mTestWhitenExpected, mTestWhitenData, mTestWhitenShortLen_c);
+            Whiten(&config, mTestWhitenExpected, mTestWhitenShortLen_c);
+            FLib_MemCpy(mTestWhitenActual, mTestWhitenData, mTestWhitenShortLen_c);
+            Test_WhitenReference(&config, mTestWhitenActual, mTestWhitenShortLen_c);
+            errors += FLib_MemCmp(mTestWhitenActual, mTestWhitenExpected, mTestWhitenShortLen_c) ? 0 : 1;
+
+            FLib_MemCpy(mTestWhitenActual, mTestWhitenData, mTestWhitenShortLen_c);
+            Whiten_Frame(&mTestWhitenHandle, mTestWhitenActual, mTestWhitenShortLen_c);
+            errors += FLib_MemCmp(mTestWhitenActual, mTestWhitenExpected, mTestWhitenShortLen_c) ? 0 : 1;
+
+            /* Long frame, word aligned and not */
+            FLib_MemCpy(mTestWhitenExpected, mTestWhitenData, mTestWhitenLongLen_c);
+            Test_WhitenReference(&config, mTestWhitenExpected, mTestWhitenLongLen_c);
+
+            for( i = 0; i < 4; i++ )
+            {
+                FLib_MemCpy(&mTestWhitenActual[i], mTestWhitenData, mTestWhitenLongLen_c);
+                Whiten_Frame(&mTestWhitenHandle, &mTestWhitenActual[i], mTestWhitenLongLen_c);
+                errors += FLib_MemCmp(&mTestWhitenActual[i], mTestWhitenExpected, mTestWhitenLongLen_c) ? 0 : 1;
+            }
+
+            /* Long frame, in fragments */
+            Test_WhitenFragments(&mTestWhitenHandle, &mTestWhitenActual[seed & 3], mTestWhitenLongLen_c, seed);
+            errors += FLib_MemCmp(&mTestWhitenActual[seed & 3], mTestWhitenExpected, mTestWhitenLongLen_c) ? 0 : 1;
+        }
+        HOST_TEST_CHECK(0 == errors);
+
+        /* Frames no longer than the offsets are left as they are */
+        FLib_MemCpy(mTestWhitenActual, mTestWhitenData, 8);
+        Whiten_Frame(&mTestWhitenHandle, mTestWhitenActual, config.whitenStartOffset + config.whitenEndOffset);
+        HOST_TEST_CHECK_BUFFER(mTestWhitenActual, mTestWhitenData, 8);
+    }
+}
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+********************************************************************************** */
+
+/* Whiten(), with a 32 bit length */
+static void Test_WhitenReference(const Whitener_config_t *pConfig, uint8_t *pBuff, uint32_t buffLength)
+{
+    uint32_t state = (uint32_t)pConfig->whitenInit << (32 - pConfig->whitenSize);
+    uint32_t poly = (uint32_t)pConfig->whitenPoly << (32 - pConfig->whitenSize);
+    uint32_t i;
+    uint32_t j;
+
+    if( pConfig->whitenPolyType != gGaloisPolyType )
+    {
+        return;
+    }
+
+    for( i = pConfig->whitenStartOffset; i + pConfig->whitenEndOffset < buffLength; i++ )
+    {
+        for( j = 0; j < 8; j++ )
+        {
+            if( state & 0x80000000U )
+            {
+                state = (state << 1) ^ poly;
+                pBuff[i] ^= (pConfig->whitenRefIn == gWhitenRefInput) ? (0x80U >> j) : (0x1U << j);
+            }
+            else
+            {
+                state <<= 1;
+            }
+        }
+    }
+}
+
+/* Whitens a frame with Whiten_Update(), in fragments whose sizes depend on the seed */
+static void Test_WhitenFragments(Whitener_handle_t *pHandle, uint8_t *pBuff, uint32_t buffLength, uint32_t seed)
+{
+    uint32_t offset = pHandle->config.whitenStartOffset;
+    uint32_t end = buffLength - pHandle->config.whitenEndOffset;
+    uint32_t length;
+
+    FLib_MemCpy(pBuff, mTestWhitenData, buffLength);
+    Whiten_SetSeed(pHandle, (uint16_t)seed);
+
+    while( offset < end )
+    {
+        length = 1 + ((seed + offset) * 7) % 67;
+
+        if( length > end - offset )
+        {
+            length = end - offset;
+        }
+
+        Whiten_Update(pHandle, &pBuff[offset], length);
+        offset += length;
+    }
+}
@@ -0,0 +1,481 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Host tests of SecLib, with the vectors of the standards:
+*   - AES-128: FIPS-197 appendix C.1,
+*   - ECB, CBC, CTR and OFB modes: NIST SP 800-38A, F.1.1 to F.5.1,
+*   - CMAC: RFC 4493,
+*   - CCM: RFC 3610, packet vector #1,
+*   - SHA-1 and SHA-256: FIPS 180-2 examples,
+*   - HMAC-SHA256: RFC 4231, test cases 1 and 2,
+*   - P-256 ECDH: RFC 5903 section 8.1 and NIST CAVS 14.1 ECC CDH, P-256 count 0.
+* The streaming and context functions are checked against the one-shot ones,
+* and the T-table decryption against the byte oriented sw_Aes128().
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include <string.h>
+
+#include "HostTest.h"
+#include "MemManager.h"
+#include "SecLib.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+********************************************************************************** */
+#define mTestSecBuffSize_c   (128)
+
+/* Key and plain text of the SP 800-38A and RFC 4493 vectors */
+#define mTestSecSp800Key_c   "2b7e151628aed2a6abf7158809cf4f3c"
+#define mTestSecSp800Text_c  "6bc1bee22e409f96e93d7e117393172a" "ae2d8a571e03ac9c9eb76fac45af8e51" \
+                             "30c81c46a35ce411e5fbc1191a0a52ef" "f69f2445df4f9b17ad2b417be66c3710"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+********************************************************************************** */
+static void Test_SecAes(void);
+static void Test_SecModes(void);
+static void Test_SecCmac(void);
+static void Test_SecCcm(void);
+static void Test_SecSha(void);
+static void Test_SecJob(void);
+static void Test_SecJobCallback(secLibJob_t* pJob, secResultType_t status);
+#if gSecLibSwEcP256_d
+static void Test_SecEcdh(void);
+static void Test_SecHexLe(uint8_t* pOut, const char* pHex);
+#endif
+
+/* Byte oriented AES of the library */
+void sw_Aes128(const uint8_t *pData, const uint8_t *pKey, uint8_t enc, uint8_t *pReturnData);
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+********************************************************************************** */
+static uint8_t mTestSecKey[AES_BLOCK_SIZE];
+static uint8_t mTestSecText[64];
+static uint8_t mTestSecIv[AES_BLOCK_SIZE];
+static uint8_t mTestSecOut[mTestSecBuffSize_c];
+static uint8_t mTestSecOut2[mTestSecBuffSize_c];
+static uint8_t mTestSecExpected[mTestSecBuffSize_c];
+
+static volatile secResultType_t mTestSecJobStatus;
+static volatile uint32_t        mTestSecJobDone;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+void Test_SecLib(void)
+{
+    Test_SecAes();
+    Test_SecModes();
+    Test_SecCmac();
+    Test_SecCcm();
+    Test_SecSha();
+    Test_SecJob();
+#if gSecLibSwEcP256_d
+    Test_SecEcdh();
+#endif
+}
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+********************************************************************************** */
+static void Test_SecAes(void)
+{
+    AES_128_Ctx_t ctx;
+    uint8_t plain[AES_BLOCK_SIZE];
+    uint32_t i, j;
+
+    (void)HostTest_Hex(mTestSecKey, "000102030405060708090a0b0c0d0e0f");
+    (void)HostTest_Hex(plain, "00112233445566778899aabbccddeeff");
+    (void)HostTest_Hex(mTestSecExpected, "69c4e0d86a7b0430d8cdb78070b4c55a");
+
+    AES_128_Encrypt(plain, mTestSecKey, mTestSecOut);
+    HOST_TEST_CHECK_BUFFER(mTestSecOut, mTestSecExpected, AES_BLOCK_SIZE);
+    AES_128_Decrypt(mTestSecOut, mTestSecKey, mTestSecOut2);
+    HOST_TEST_CHECK_BUFFER(mTestSecOut2, plain, AES_BLOCK_SIZE);
+
+    AES_128_SetKey(&ctx, mTestSecKey);
+    AES_128_Encrypt_WithCtx(&ctx, plain, mTestSecOut);
+    HOST_TEST_CHECK_BUFFER(mTestSecOut, mTestSecExpected, AES_BLOCK_SIZE);
+    AES_128_Decrypt_WithCtx(&ctx, mTestSecOut, mTestSecOut2);
+    HOST_TEST_CHECK_BUFFER(mTestSecOut2, plain, AES_BLOCK_SIZE);
+
+    /* SP 800-38A F.1.2, first block */
+    (void)HostTest_Hex(mTestSecKey, mTestSecSp800Key_c);
+    (void)HostTest_Hex(mTestSecText, "3ad77bb40d7a3660a89ecaf32466ef97");
+    (void)HostTest_Hex(mTestSecExpected, "6bc1bee22e409f96e93d7e117393172a");
+    AES_128_Decrypt(mTestSecText, mTestSecKey, mTestSecOut);
+    HOST_TEST_CHECK_BUFFER(mTestSecOut, mTestSecExpected, AES_BLOCK_SIZE);
+
+    /* Other keys and blocks, in place */
+    for( i = 0; i < 64; i++ )
+    {
+        for( j = 0; j < AES_BLOCK_SIZE; j++ )
+        {
+            mTestSecKey[j] = (uint8_t)(i * 37 + j * 11);
+            plain[j] = (uint8_t)(i * 101 + j * 7);
+        }
+
+        sw_Aes128(plain, mTestSecKey, 0, mTestSecExpected);
+        AES_128_SetKey(&ctx, mTestSecKey);
+        AES_128_Decrypt_WithCtx(&ctx, plain, plain);
+        HOST_TEST_CHECK_BUFFER(plain, mTestSecExpected, AES_BLOCK_SIZE);
+    }
+}
+
+static void Test_SecModes(void)
+{
+    AES_128_Ctx_t ctx;
+    AES_128_CTR_Ctx_t ctrCtx;
+    uint8_t counter[AES_BLOCK_SIZE];
+    uint32_t size;
+
+    (void)HostTest_Hex(mTestSecKey, mTestSecSp800Key_c);
+    (void)HostTest_Hex(mTestSecText, mTestSecSp800Text_c);
+    AES_128_SetKey(&ctx, mTestSecKey);
+
+    /* ECB */
+    (void)HostTest_Hex(mTestSecExpected, "3ad77bb40d7a3660a89ecaf32466ef97" "f5d3d58503b9699de785895a96fdbaaf"
+                                         "43b1cd7f598ece23881b00e3ed030688" "7b0c785e27e8ad3f8223207104725dd4");
+    AES_128_ECB_Encrypt(mTestSecText, sizeof(mTestSecText), mTestSecKey, mTestSecOut);
+    HOST_TEST_CHECK_BUFFER(mTestSecOut, mTestSecExpected, sizeof(mTestSecText));
+    AES_128_ECB_Block_Encrypt_WithCtx(&ctx, mTestSecText, 4, mTestSecOut2);
+    HOST_TEST_CHECK_BUFFER(mTestSecOut2, mTestSecExpected, sizeof(mTestSecText));
+
+    /* CBC */
+    (void)HostTest_Hex(mTestSecExpected, "7649abac8119b246cee98e9b12e9197d" "5086cb9b507219ee95db113a917678b2"
+                                         "73bed6b8e3c1743b7116e69e22229516" "3ff1caa1681fac09120eca307586e1a7");
+    (void)HostTest_Hex(mTestSecIv, "000102030405060708090a0b0c0d0e0f");
+    AES_128_CBC_Encrypt(mTestSecText, sizeof(mTestSecText), mTestSecIv, mTestSecKey, mTestSecOut);
+    HOST_TEST_CHECK_BUFFER(mTestSecOut, mTestSecExpected, sizeof(mTestSecText));
+    (void)HostTest_Hex(mTestSecIv, "000102030405060708090a0b0c0d0e0f");
+    AES_128_CBC_Encrypt_WithCtx(&ctx, mTestSecText, sizeof(mTestSecText), mTestSecIv, mTestSecOut2);
+    HOST_TEST_CHECK_BUFFER(mTestSecOut2, mTestSecExpected, sizeof(mTestSecText));
+
+    /* CBC with padding: 37 bytes are padded to 48 */
+    (void)HostTest_Hex(mTestSecIv, "000102030405060708090a0b0c0d0e0f");
+    memcpy(mTestSecOut, mTestSecText, sizeof(mTestSecText));
+    size = AES_128_CBC_Encrypt_And_Pad(mTestSecOut, 37, mTestSecIv, mTestSecKey, mTestSecOut2);
+    HOST_TEST_CHECK(48 == size);
+    (void)HostTest_Hex(mTestSecIv, "000102030405060708090a0b0c0d0e0f");
+    size = AES_128_CBC_Decrypt_And_Depad(mTestSecOut2, size, mTestSecIv, mTestSecKey, mTestSecOut);
+    HOST_TEST_CHECK(37 == size);
+    HOST_TEST_CHECK_BUFFER(mTestSecOut, mTestSecText, 37);
+
+    /* CTR, one-shot and streamed in uneven chunks */
+    (void)HostTest_Hex(mTestSecExpected, "874d6191b620e3261bef6864990db6ce" "9806f66b7970fdff8617187bb9fffdff"
+                                         "5ae4df3edbd5d35e5b4f09020db03eab" "1e031dda2fbe03d1792170a0f3009cee");
+    (void)HostTest_Hex(counter, "f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff");
+    AES_128_CTR(mTestSecText, sizeof(mTestSecText), counter, mTestSecKey, mTestSecOut);
+    HOST_TEST_CHECK_BUFFER(mTestSecOut, mTestSecExpected, sizeof(mTestSecText));
+
+    (void)HostTest_Hex(counter, "f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff");
+    AES_128_CTR_Init(&ctrCtx, mTestSecKey, counter);
+    AES_128_CTR_Update(&ctrCtx, mTestSecText, 5, mTestSecOut2);
+    AES_128_CTR_Update(&ctrCtx, &mTestSecText[5], 30, &mTestSecOut2[5]);
+    AES_128_CTR_Update(&ctrCtx, &mTestSecText[35], 29, &mTestSecOut2[35]);
+    HOST_TEST_CHECK_BUFFER(mTestSecOut2, mTestSecExpected, sizeof(mTestSecText));
+
+    /* OFB */
+    (void)HostTest_Hex(mTestSecExpected, "3b3fd92eb72dad20333449f8e83cfb4a" "7789508d16918f03f53c52dac54ed825"
+                                         "9740051e9c5fecf64344f7a82260edcc" "304c6528f659c77866a510d9c1d6ae5e");
+    (void)HostTest_Hex(mTestSecIv, "000102030405060708090a0b0c0d0e0f");
+    AES_128_OFB(mTestSecText, sizeof(mTestSecText), mTestSecIv, mTestSecKey, mTestSecOut);
+    HOST_TEST_CHECK_BUFFER(mTestSecOut, mTestSecExpected, sizeof(mTestSecText));
+}
+
+static void Test_SecCmac(void)
+{
+    static const struct
+    {
+        uint32_t    length;
+        const char* pMac;
+    } vectors[] =
+    {
+        { 0,  "bb1d6929e95937287fa37d129b756746"},
+        { 16, "070a16b46b4d4144f79bdd9dd04a287c"},
+        { 40, "dfa66747de9ae63030ca32611497c827"},
+        { 64, "51f0bebf7e3b9d92fc49741779363cfe"},
+    };
+    AES_128_CMAC_Ctx_t ctx;
+    uint32_t i;
+
+    (void)HostTest_Hex(mTestSecKey, mTestSecSp800Key_c);
+    (void)HostTest_Hex(mTestSecText, mTestSecSp800Text_c);
+
+    for( i = 0; i < NumberOfElements(vectors); i++ )
+    {
+        (void)HostTest_Hex(mTestSecExpected, vectors[i].pMac);
+
+        AES_128_CMAC(mTestSecText, vectors[i].length, mTestSecKey, mTestSecOut);
+        HOST_TEST_CHECK_BUFFER(mTestSecOut, mTestSecExpected, AES_BLOCK_SIZE);
+
+        /* Streamed one byte, then the rest */
+        AES_128_CMAC_Init(&ctx, mTestSecKey);
+        if( vectors[i].length )
+        {
+            AES_128_CMAC_Update(&ctx, mTestSecText, 1);
+            AES_128_CMAC_Update(&ctx, &mTestSecText[1], vectors[i].length - 1);
+        }
+        AES_128_CMAC_Finish(&ctx, mTestSecOut2);
+        HOST_TEST_CHECK_BUFFER(mTestSecOut2, mTestSecExpected, AES_BLOCK_SIZE);
+    }
+}
+
+static void Test_SecCcm(void)
+{
+    AES_128_CCM_Ctx_t ctx;
+    uint8_t nonce[13];
+    uint8_t header[8];
+    uint8_t payload[23];
+    uint8_t mac[8];
+
+    (void)HostTest_Hex(mTestSecKey, "c0c1c2c3c4c5c6c7c8c9cacbcccdcecf");
+    (void)HostTest_Hex(nonce, "00000003020100a0a1a2a3a4a5");
+    (void)HostTest_Hex(header, "0001020304050607");
+    (void)HostTest_Hex(payload, "08090a0b0c0d0e0f101112131415161718191a1b1c1d1e");
+    (void)HostTest_Hex(mTestSecExpected, "588c979a61c663d2f066d0c2c0f989806d5f6b61dac384" "17e8d12cfdf926e0");
+
+    /* One-shot */
+    HOST_TEST_CHECK(0 == AES_128_CCM(payload, sizeof(payload), header, sizeof(header), nonce, sizeof(nonce),
+                                     mTestSecKey, mTestSecOut, mac, sizeof(mac), gSecLib_CCM_Encrypt_c));
+    HOST_TEST_CHECK_BUFFER(mTestSecOut, mTestSecExpected, sizeof(payload));
+    HOST_TEST_CHECK_BUFFER(mac, &mTestSecExpected[sizeof(payload)], sizeof(mac));
+
+    HOST_TEST_CHECK(0 == AES_128_CCM(mTestSecOut, sizeof(payload), header, sizeof(header), nonce, sizeof(nonce),
+                                     mTestSecKey, mTestSecOut2, mac, sizeof(mac), gSecLib_CCM_Decrypt_c));
+    HOST_TEST_CHECK_BUFFER(mTestSecOut2, payload, sizeof(payload));
+
+    /* A modified cipher text is rejected */
+    mTestSecOut[3] ^= 0x01;
+    HOST_TEST_CHECK(0 != AES_128_CCM(mTestSecOut, sizeof(payload), header, sizeof(header), nonce, sizeof(nonce),
+                                     mTestSecKey, mTestSecOut2, mac, sizeof(mac), gSecLib_CCM_Decrypt_c));
+    mTestSecOut[3] ^= 0x01;
+
+    /* Streamed */
+    memset(mac, 0, sizeof(mac));
+    HOST_TEST_CHECK(gSecSuccess_c == AES_128_CCM_Init(&ctx, mTestSecKey, nonce, sizeof(nonce), sizeof(header),
+                                                      sizeof(payload), sizeof(mac), gSecLib_CCM_Encrypt_c));
+    HOST_TEST_CHECK(gSecSuccess_c == AES_128_CCM_UpdateAuthData(&ctx, header, 3));
+    HOST_TEST_CHECK(gSecSuccess_c == AES_128_CCM_UpdateAuthData(&ctx, &header[3], 5));
+    HOST_TEST_CHECK(gSecSuccess_c == AES_128_CCM_Update(&ctx, payload, 17, mTestSecOut2));
+    HOST_TEST_CHECK(gSecSuccess_c == AES_128_CCM_Update(&ctx, &payload[17], 6, &mTestSecOut2[17]));
+    HOST_TEST_CHECK(gSecSuccess_c == AES_128_CCM_Finish(&ctx, mac));
+    HOST_TEST_CHECK_BUFFER(mTestSecOut2, mTestSecExpected, sizeof(payload));
+    HOST_TEST_CHECK_BUFFER(mac, &mTestSecExpected[sizeof(payload)], sizeof(mac));
+
+    HOST_TEST_CHECK(gSecSuccess_c == AES_128_CCM_Init(&ctx, mTestSecKey, nonce, sizeof(nonce), sizeof(header),
+                                                      sizeof(payload), sizeof(mac), gSecLib_CCM_Decrypt_c));
+    HOST_TEST_CHECK(gSecSuccess_c == AES_128_CCM_UpdateAuthData(&ctx, header, sizeof(header)));
+    HOST_TEST_CHECK(gSecSuccess_c == AES_128_CCM_Update(&ctx, mTestSecOut2, sizeof(payload), mTestSecOut2));
+    HOST_TEST_CHECK(gSecSuccess_c == AES_128_CCM_Finish(&ctx, mac));
+    HOST_TEST_CHECK_BUFFER(mTestSecOut2, payload, sizeof(payload));
+}
+
+static void Test_SecSha(void)
+{
+    static char abc[] = "abc";
+    static char abc448[] = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    static char jefe[] = "Jefe";
+    static char what[] = "what do ya want for nothing?";
+    static char hiThere[] = "Hi There";
+    sha1Context_t sha1;
+    sha256Context_t sha256;
+    HMAC_SHA256_context_t hmac;
+    uint8_t key[20];
+
+    (void)HostTest_Hex(mTestSecExpected, "a9993e364706816aba3e25717850c26c9cd0d89d");
+    SHA1_Hash(&sha1, (uint8_t*)abc, 3);
+    HOST_TEST_CHECK_BUFFER(sha1.hash, mTestSecExpected, SHA1_HASH_SIZE);
+
+    (void)HostTest_Hex(mTestSecExpected, "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    SHA256_Hash(&sha256, (uint8_t*)abc, 3);
+    HOST_TEST_CHECK_BUFFER(sha256.hash, mTestSecExpected, SHA256_HASH_SIZE);
+
+    (void)HostTest_Hex(mTestSecExpected, "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+    SHA256_Hash(&sha256, (uint8_t*)abc448, 56);
+    HOST_TEST_CHECK_BUFFER(sha256.hash, mTestSecExpected, SHA256_HASH_SIZE);
+
+    SHA256_Init(&sha256);
+    SHA256_HashUpdate(&sha256, (uint8_t*)abc448, 7);
+    SHA256_HashUpdate(&sha256, (uint8_t*)&abc448[7], 40);
+    SHA256_HashFinish(&sha256, (uint8_t*)&abc448[47], 9);
+    HOST_TEST_CHECK_BUFFER(sha256.hash, mTestSecExpected, SHA256_HASH_SIZE);
+
+    memset(key, 0x0b, sizeof(key));
+    (void)HostTest_Hex(mTestSecExpected, "b0344c61d8db38535ca8afceaf0bf12b881dc200c9833da726e9376c2e32cff7");
+    HMAC_SHA256(&hmac, key, sizeof(key), (uint8_t*)hiThere, 8);
+    HOST_TEST_CHECK_BUFFER(hmac.shaCtx.hash, mTestSecExpected, SHA256_HASH_SIZE);
+
+    (void)HostTest_Hex(mTestSecExpected, "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843");
+    HMAC_SHA256(&hmac, (uint8_t*)jefe, 4, (uint8_t*)what, 28);
+    HOST_TEST_CHECK_BUFFER(hmac.shaCtx.hash, mTestSecExpected, SHA256_HASH_SIZE);
+}
+
+static void Test_SecJob(void)
+{
+    secLibJob_t job;
+    uint8_t counter[AES_BLOCK_SIZE];
+
+    (void)HostTest_Hex(mTestSecKey, mTestSecSp800Key_c);
+    (void)HostTest_Hex(mTestSecText, mTestSecSp800Text_c);
+    (void)HostTest_Hex(counter, "f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff");
+    (void)HostTest_Hex(mTestSecExpected, "874d6191b620e3261bef6864990db6ce" "9806f66b7970fdff8617187bb9fffdff");
+
+    memset(&job, 0, sizeof(job));
+    job.type     = gSecLibJobCtr_c;
+    job.pKey     = mTestSecKey;
+    job.pInput   = mTestSecText;
+    job.pOutput  = mTestSecOut;
+    job.length   = 32;
+    job.pIv      = counter;
+    job.callback = Test_SecJobCallback;
+
+    mTestSecJobDone = 0;
+    HOST_TEST_CHECK(gSecSuccess_c == SecLib_SubmitJob(&job));
+    HOST_TEST_CHECK(1 == mTestSecJobDone);
+    HOST_TEST_CHECK(gSecSuccess_c == mTestSecJobStatus);
+    HOST_TEST_CHECK_BUFFER(mTestSecOut, mTestSecExpected, 32);
+
+    /* CBC jobs take whole blocks only */
+    job.type = gSecLibJobCbcEncrypt_c;
+    job.length = 20;
+    HOST_TEST_CHECK(gSecError_c == SecLib_SubmitJob(&job));
+}
+
+static void Test_SecJobCallback(secLibJob_t* pJob, secResultType_t status)
+{
+    (void)pJob;
+    mTestSecJobStatus = status;
+    mTestSecJobDone++;
+}
+
+#if gSecLibSwEcP256_d
+static void Test_SecEcdh(void)
+{
+    static const struct
+    {
+        const char* pPrivateKey;
+        const char* pPeerX;
+        const char* pPeerY;
+        const char* pDhX;
+        const char* pDhY;   /* NULL if not given by the standard */
+    } vectors[] =
+    {
+        /* RFC 5903, 8.1: i with gr, and r with gi */
+        {"c88f01f510d9ac3f70a292daa2316de544e9aab8afe84049c62a9c57862d1433",
+         "d12dfb5289c8d4f81208b70270398c342296970a0bccb74c736fc7554494bf63",
+         "56fbf3ca366cc23e8157854c13c58d6aac23f046ada30f8353e74f33039872ab",
+         "d6840f6b42f6edafd13116e0e12565202fef8e9ece7dce03812464d04b9442de",
+         "522bde0af0d8585b8def9c183b5ae38f50235206a8674ecb5d98edb20eb153a2"},
+        {"c6ef9c5d78ae012a011164acb397ce2088685d8f06bf9be0b283ab46476bee53",
+         "dad0b65394221cf9b051e1feca5787d098dfe637fc90b9ef945d0c3772581180",
+         "5271a0461cdb8252d61f1c456fa3e59ab1f45b33accf5f58389e0577b8990bb3",
+         "d6840f6b42f6edafd13116e0e12565202fef8e9ece7dce03812464d04b9442de",
+         "522bde0af0d8585b8def9c183b5ae38f50235206a8674ecb5d98edb20eb153a2"},
+        /* RFC 5903, 8.1: gi is i times the generator */
+        {"c88f01f510d9ac3f70a292daa2316de544e9aab8afe84049c62a9c57862d1433",
+         "6b17d1f2e12c4247f8bce6e563a440f277037d812deb33a0f4a13945d898c296",
+         "4fe342e2fe1a7f9b8ee7eb4a7c0f9e162bce33576b315ececbb6406837bf51f5",
+         "dad0b65394221cf9b051e1feca5787d098dfe637fc90b9ef945d0c3772581180",
+         "5271a0461cdb8252d61f1c456fa3e59ab1f45b33accf5f58389e0577b8990bb3"},
+        /* NIST CAVS ECC CDH, P-256 count 0: only the x coordinate is given */
+        {"7d7dc5f71eb29ddaf80d6214632eeae03d9058af1fb6d22ed80badb62bc1a534",
+         "700c48f77f56584c5cc632ca65640db91b6bacce3a4df6b42ce7cc838833d287",
+         "db71e509e3fd9b060ddb20ba5c51dcc5948d46fbf640dfe0441782cab85fa4ac",
+         "46fc62106420ff012e54a434fbdd2d25ccc5852060561e68040dd7778997bd7b",
+         NULL},
+    };
+    static ecP256Context_t ctx;
+    ecdhPrivateKey_t privateKey, privateKey2;
+    ecdhPublicKey_t publicKey, publicKey2;
+    ecdhDhKey_t dhKey, dhKey2;
+    uint8_t expected[32];
+    secResultType_t result;
+    uint32_t slices;
+    uint32_t i;
+    void* pBuffer;
+
+    /* The blocking functions allocate their context from a memory pool */
+    pBuffer = MEM_BufferAlloc(gEcP256_MultiplicationBufferSize_c);
+    HOST_TEST_CHECK(NULL != pBuffer);
+    (void)MEM_BufferFree(pBuffer);
+
+    for( i = 0; i < NumberOfElements(vectors); i++ )
+    {
+        Test_SecHexLe(privateKey.raw_8bit, vectors[i].pPrivateKey);
+        Test_SecHexLe(publicKey.components_8bit.x, vectors[i].pPeerX);
+        Test_SecHexLe(publicKey.components_8bit.y, vectors[i].pPeerY);
+
+        HOST_TEST_CHECK(gSecSuccess_c == ECDH_P256_ComputeDhKey(&privateKey, &publicKey, &dhKey));
+        Test_SecHexLe(expected, vectors[i].pDhX);
+        HOST_TEST_CHECK_BUFFER(dhKey.components_8bit.x, expected, 32);
+        if( vectors[i].pDhY )
+        {
+            Test_SecHexLe(expected, vectors[i].pDhY);
+            HOST_TEST_CHECK_BUFFER(dhKey.components_8bit.y, expected, 32);
+        }
+    }
+
+    /* The same key in slices */
+    result = ECDH_P256_ComputeDhKeyStart(&ctx, &privateKey, &publicKey, &dhKey2);
+    for( slices = 0; gSecResultPending_c == result; slices++ )
+    {
+        result = ECDH_P256_Continue(&ctx);
+    }
+    HOST_TEST_CHECK(gSecSuccess_c == result);
+    HOST_TEST_CHECK(slices > 1);
+    HOST_TEST_CHECK_BUFFER(dhKey2.raw, dhKey.raw, sizeof(dhKey.raw));
+
+    /* A peer key which is not on the curve is rejected */
+    publicKey.components_8bit.y[0] ^= 0x01;
+    HOST_TEST_CHECK(gSecInvalidPublicKey_c == ECDH_P256_ComputeDhKey(&privateKey, &publicKey, &dhKey));
+
+    /* The comb of the key generation agrees with the window of the Diffie-Hellman key:
+       both sides of a key exchange get the same key */
+    HOST_TEST_CHECK(gSecSuccess_c == ECDH_P256_GenerateKeys(&publicKey, &privateKey));
+    HOST_TEST_CHECK(gSecSuccess_c == ECDH_P256_GenerateKeys(&publicKey2, &privateKey2));
+    HOST_TEST_CHECK(gSecSuccess_c == ECDH_P256_ComputeDhKey(&privateKey, &publicKey2, &dhKey));
+    HOST_TEST_CHECK(gSecSuccess_c == ECDH_P256_ComputeDhKey(&privateKey2, &publicKey, &dhKey2));
+    HOST_TEST_CHECK_BUFFER(dhKey2.raw, dhKey.raw, sizeof(dhKey.raw));
+}
+
+/*! *********************************************************************************
+* \brief  Converts a big endian hex string of the standards to the little endian
+*         keys and coordinates of SecLib
+*
+********************************************************************************** */
+static void Test_SecHexLe(uint8_t* pOut, const char* pHex)
+{
+    uint32_t size = HostTest_Hex(pOut, pHex);
+    uint32_t i;
+    uint8_t byte;
+
+    for( i = 0; i < size / 2; i++ )
+    {
+        byte = pOut[i];
+        pOut[i] = pOut[size - 1 - i];
+        pOut[size - 1 - i] = byte;
+    }
+}
+#endif /* gSecLibSwEcP256_d */
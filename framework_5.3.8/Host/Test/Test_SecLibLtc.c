@@ -0,0 +1,371 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Host tests of the SecLib asynchronous jobs, on the LTC and eDMA model of
+* Host_Ltc.c: CTR, CBC and CCM jobs with the SP 800-38A and RFC 3610 vectors, the
+* order of the queued jobs, and the synchronous operations started while a job
+* runs, from a task, with the interrupts masked and from an interrupt handler.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include <string.h>
+
+#include "HostTest.h"
+#include "Host.h"
+#include "fsl_device_registers.h"
+#include "fsl_os_abstraction.h"
+#include "SecLib.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+********************************************************************************** */
+#define mTestLtcJobs_c        (4)
+#define mTestLtcLongSize_c    (16384)
+#define mTestLtcTimeoutMs_c   (2000)
+#define mTestLtcIrq_c         (Reserved20_IRQn)
+
+#define mTestLtcSp800Key_c    "2b7e151628aed2a6abf7158809cf4f3c"
+#define mTestLtcSp800Text_c   "6bc1bee22e409f96e93d7e117393172a" "ae2d8a571e03ac9c9eb76fac45af8e51" \
+                              "30c81c46a35ce411e5fbc1191a0a52ef" "f69f2445df4f9b17ad2b417be66c3710"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+********************************************************************************** */
+static void Test_SecLtcModes(void);
+static void Test_SecLtcCcm(void);
+static void Test_SecLtcQueue(void);
+static void Test_SecLtcSync(void);
+static void Test_SecLtcCallback(secLibJob_t* pJob, secResultType_t status);
+static void Test_SecLtcIrqHandler(void);
+static bool_t Test_SecLtcWait(volatile uint32_t* pCount, uint32_t count);
+static bool_t Test_SecLtcStartLong(void);
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+********************************************************************************** */
+static uint8_t mTestLtcKey[AES_BLOCK_SIZE];
+static uint8_t mTestLtcText[64];
+static uint8_t mTestLtcIv[AES_BLOCK_SIZE];
+static uint8_t mTestLtcOut[64];
+static uint8_t mTestLtcExpected[64];
+static uint8_t mTestLtcLongIn[mTestLtcLongSize_c];
+static uint8_t mTestLtcLongOut[mTestLtcLongSize_c];
+
+static secLibJob_t mTestLtcJobs[mTestLtcJobs_c];
+static secLibJob_t* volatile mTestLtcOrder[mTestLtcJobs_c];
+static volatile secResultType_t mTestLtcStatus[mTestLtcJobs_c];
+static volatile uint32_t mTestLtcIpsr[mTestLtcJobs_c];
+static volatile uint32_t mTestLtcDone;
+
+/* Results of the synchronous operation run by the interrupt handler */
+static volatile uint32_t mTestLtcIrqDone;
+static volatile uint32_t mTestLtcIrqJobsDone;
+static uint8_t mTestLtcIrqOut[AES_BLOCK_SIZE];
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+void Test_SecLibLtc(void)
+{
+    /* SecLib_Init() routed the LTC requests to its channels */
+    HOST_TEST_CHECK(0 == (LTC0->STA & LTC_STA_AB_MASK));
+    HOST_TEST_CHECK(DMAMUX0->CHCFG[gSecLibLtcInputDmaChannel_c] & DMAMUX_CHCFG_ENBL_MASK);
+    HOST_TEST_CHECK(DMAMUX0->CHCFG[gSecLibLtcOutputDmaChannel_c] & DMAMUX_CHCFG_ENBL_MASK);
+
+    Test_SecLtcModes();
+    Test_SecLtcCcm();
+    Test_SecLtcQueue();
+    Test_SecLtcSync();
+
+    HOST_TEST_CHECK(0 == Host_LtcGetConflicts());
+}
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+********************************************************************************** */
+static void Test_SecLtcModes(void)
+{
+    secLibJob_t* pJob = &mTestLtcJobs[0];
+    uint8_t counter[AES_BLOCK_SIZE];
+
+    (void)HostTest_Hex(mTestLtcKey, mTestLtcSp800Key_c);
+    (void)HostTest_Hex(mTestLtcText, mTestLtcSp800Text_c);
+
+    /* SP 800-38A F.5.1: the job completes in the eDMA interrupt, and updates the counter */
+    (void)HostTest_Hex(counter, "f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff");
+    (void)HostTest_Hex(mTestLtcExpected, "874d6191b620e3261bef6864990db6ce" "9806f66b7970fdff8617187bb9fffdff"
+                                         "5ae4df3edbd5d35e5b4f09020db03eab" "1e031dda2fbe03d1792170a0f3009cee");
+    memset(pJob, 0, sizeof(*pJob));
+    pJob->type     = gSecLibJobCtr_c;
+    pJob->pKey     = mTestLtcKey;
+    pJob->pInput   = mTestLtcText;
+    pJob->pOutput  = mTestLtcOut;
+    pJob->length   = sizeof(mTestLtcText);
+    pJob->pIv      = counter;
+    pJob->callback = Test_SecLtcCallback;
+
+    mTestLtcDone = 0;
+    HOST_TEST_CHECK(gSecSuccess_c == SecLib_SubmitJob(pJob));
+    HOST_TEST_CHECK(Test_SecLtcWait(&mTestLtcDone, 1));
+    HOST_TEST_CHECK(gSecSuccess_c == mTestLtcStatus[0]);
+    HOST_TEST_CHECK(0 != mTestLtcIpsr[0]);
+    HOST_TEST_CHECK_BUFFER(mTestLtcOut, mTestLtcExpected, sizeof(mTestLtcText));
+    HOST_TEST_CHECK(0x03 == counter[AES_BLOCK_SIZE - 1]);
+
+    /* SP 800-38A F.2.1 and F.2.2 */
+    (void)HostTest_Hex(mTestLtcIv, "000102030405060708090a0b0c0d0e0f");
+    (void)HostTest_Hex(mTestLtcExpected, "7649abac8119b246cee98e9b12e9197d" "5086cb9b507219ee95db113a917678b2"
+                                         "73bed6b8e3c1743b7116e69e22229516" "3ff1caa1681fac09120eca307586e1a7");
+    pJob->type = gSecLibJobCbcEncrypt_c;
+    pJob->pIv  = mTestLtcIv;
+
+    mTestLtcDone = 0;
+    HOST_TEST_CHECK(gSecSuccess_c == SecLib_SubmitJob(pJob));
+    HOST_TEST_CHECK(Test_SecLtcWait(&mTestLtcDone, 1));
+    HOST_TEST_CHECK(gSecSuccess_c == mTestLtcStatus[0]);
+    HOST_TEST_CHECK_BUFFER(mTestLtcOut, mTestLtcExpected, sizeof(mTestLtcText));
+
+    /* In place */
+    pJob->type    = gSecLibJobCbcDecrypt_c;
+    pJob->pInput  = mTestLtcOut;
+
+    mTestLtcDone = 0;
+    HOST_TEST_CHECK(gSecSuccess_c == SecLib_SubmitJob(pJob));
+    HOST_TEST_CHECK(Test_SecLtcWait(&mTestLtcDone, 1));
+    HOST_TEST_CHECK(gSecSuccess_c == mTestLtcStatus[0]);
+    HOST_TEST_CHECK_BUFFER(mTestLtcOut, mTestLtcText, sizeof(mTestLtcText));
+}
+
+static void Test_SecLtcCcm(void)
+{
+    secLibJob_t* pJob = &mTestLtcJobs[0];
+    uint8_t nonce[13];
+    uint8_t header[8];
+    uint8_t payload[23];
+    uint8_t mac[8];
+
+    /* RFC 3610 packet vector #1 */
+    (void)HostTest_Hex(mTestLtcKey, "c0c1c2c3c4c5c6c7c8c9cacbcccdcecf");
+    (void)HostTest_Hex(nonce, "00000003020100a0a1a2a3a4a5");
+    (void)HostTest_Hex(header, "0001020304050607");
+    (void)HostTest_Hex(payload, "08090a0b0c0d0e0f101112131415161718191a1b1c1d1e");
+    (void)HostTest_Hex(mTestLtcExpected, "588c979a61c663d2f066d0c2c0f989806d5f6b61dac384" "17e8d12cfdf926e0");
+
+    memset(pJob, 0, sizeof(*pJob));
+    pJob->type        = gSecLibJobCcm_c;
+    pJob->pKey        = mTestLtcKey;
+    pJob->pInput      = payload;
+    pJob->pOutput     = mTestLtcOut;
+    pJob->length      = sizeof(payload);
+    pJob->pAuthData   = header;
+    pJob->authDataLen = sizeof(header);
+    pJob->pNonce      = nonce;
+    pJob->nonceSize   = sizeof(nonce);
+    pJob->pMac        = mac;
+    pJob->macSize     = sizeof(mac);
+    pJob->flags       = gSecLib_CCM_Encrypt_c;
+    pJob->callback    = Test_SecLtcCallback;
+
+    /* CCM jobs run in the SecLib task */
+    mTestLtcDone = 0;
+    HOST_TEST_CHECK(gSecSuccess_c == SecLib_SubmitJob(pJob));
+    HOST_TEST_CHECK(Test_SecLtcWait(&mTestLtcDone, 1));
+    HOST_TEST_CHECK(gSecSuccess_c == mTestLtcStatus[0]);
+    HOST_TEST_CHECK(0 == mTestLtcIpsr[0]);
+    HOST_TEST_CHECK_BUFFER(mTestLtcOut, mTestLtcExpected, sizeof(payload));
+    HOST_TEST_CHECK_BUFFER(mac, &mTestLtcExpected[sizeof(payload)], sizeof(mac));
+
+    /* A modified MAC is rejected */
+    memcpy(payload, mTestLtcOut, sizeof(payload));
+    mac[0] ^= 0x01;
+    pJob->flags = gSecLib_CCM_Decrypt_c;
+
+    mTestLtcDone = 0;
+    HOST_TEST_CHECK(gSecSuccess_c == SecLib_SubmitJob(pJob));
+    HOST_TEST_CHECK(Test_SecLtcWait(&mTestLtcDone, 1));
+    HOST_TEST_CHECK(gSecError_c == mTestLtcStatus[0]);
+}
+
+static void Test_SecLtcQueue(void)
+{
+    uint8_t counter[AES_BLOCK_SIZE] = {0};
+    uint8_t nonce[13] = {0};
+    uint8_t mac[8];
+    uint32_t i;
+
+    (void)HostTest_Hex(mTestLtcKey, mTestLtcSp800Key_c);
+
+    /* The jobs complete in the order they were submitted, CCM included */
+    for( i = 0; i < mTestLtcJobs_c; i++ )
+    {
+        secLibJob_t* pJob = &mTestLtcJobs[i];
+
+        memset(pJob, 0, sizeof(*pJob));
+        pJob->type     = (i == 2) ? gSecLibJobCcm_c : gSecLibJobCtr_c;
+        pJob->pKey     = mTestLtcKey;
+        pJob->pInput   = mTestLtcLongIn;
+        pJob->pOutput  = &mTestLtcLongOut[i * (mTestLtcLongSize_c / mTestLtcJobs_c)];
+        pJob->length   = (i == 2) ? 64 : mTestLtcLongSize_c / mTestLtcJobs_c;
+        pJob->pIv      = counter;
+        pJob->pNonce   = nonce;
+        pJob->nonceSize = sizeof(nonce);
+        pJob->pMac     = mac;
+        pJob->macSize  = sizeof(mac);
+        pJob->callback = Test_SecLtcCallback;
+    }
+
+    mTestLtcDone = 0;
+    for( i = 0; i < mTestLtcJobs_c; i++ )
+    {
+        HOST_TEST_CHECK(gSecSuccess_c == SecLib_SubmitJob(&mTestLtcJobs[i]));
+    }
+
+    HOST_TEST_CHECK(Test_SecLtcWait(&mTestLtcDone, mTestLtcJobs_c));
+    for( i = 0; i < mTestLtcJobs_c; i++ )
+    {
+        HOST_TEST_CHECK(&mTestLtcJobs[i] == mTestLtcOrder[i]);
+        HOST_TEST_CHECK(gSecSuccess_c == mTestLtcStatus[i]);
+    }
+}
+
+static void Test_SecLtcSync(void)
+{
+    uint8_t plain[AES_BLOCK_SIZE];
+    uint32_t i;
+
+    (void)HostTest_Hex(mTestLtcKey, "000102030405060708090a0b0c0d0e0f");
+    (void)HostTest_Hex(plain, "00112233445566778899aabbccddeeff");
+    (void)HostTest_Hex(mTestLtcExpected, "69c4e0d86a7b0430d8cdb78070b4c55a");
+
+    /* From a task: waits for the running job, the model counts any overlap */
+    if( HOST_TEST_CHECK(Test_SecLtcStartLong()) )
+    {
+        AES_128_Encrypt(plain, mTestLtcKey, mTestLtcOut);
+        HOST_TEST_CHECK(0 == (LTC0->STA & LTC_STA_AB_MASK));
+        HOST_TEST_CHECK(0 == Host_LtcGetConflicts());
+        HOST_TEST_CHECK_BUFFER(mTestLtcOut, mTestLtcExpected, AES_BLOCK_SIZE);
+        HOST_TEST_CHECK(Test_SecLtcWait(&mTestLtcDone, 1));
+    }
+
+    /* With the interrupts masked: serves the eDMA channels, so the job completes
+       before the operation */
+    if( HOST_TEST_CHECK(Test_SecLtcStartLong()) )
+    {
+        OSA_InterruptDisable();
+        AES_128_Encrypt(plain, mTestLtcKey, mTestLtcOut);
+        i = mTestLtcDone;
+        OSA_InterruptEnable();
+        HOST_TEST_CHECK(1 == i);
+        HOST_TEST_CHECK_BUFFER(mTestLtcOut, mTestLtcExpected, AES_BLOCK_SIZE);
+    }
+
+    /* From an interrupt handler, which the eDMA interrupt cannot preempt */
+    Host_InstallIrqHandler(mTestLtcIrq_c, Test_SecLtcIrqHandler);
+    NVIC_EnableIRQ(mTestLtcIrq_c);
+    if( HOST_TEST_CHECK(Test_SecLtcStartLong()) )
+    {
+        mTestLtcIrqDone = 0;
+        NVIC_SetPendingIRQ(mTestLtcIrq_c);
+        HOST_TEST_CHECK(Test_SecLtcWait(&mTestLtcIrqDone, 1));
+        HOST_TEST_CHECK(1 == mTestLtcIrqJobsDone);
+        HOST_TEST_CHECK_BUFFER(mTestLtcIrqOut, mTestLtcExpected, AES_BLOCK_SIZE);
+    }
+    NVIC_DisableIRQ(mTestLtcIrq_c);
+
+    /* The queue restarts after a synchronous operation */
+    HOST_TEST_CHECK(Test_SecLtcStartLong());
+    HOST_TEST_CHECK(Test_SecLtcWait(&mTestLtcDone, 1));
+}
+
+/*! *********************************************************************************
+* \brief  Submits a job long enough for a synchronous operation to start while it
+*         runs, and waits until the LTC is busy with it
+*
+********************************************************************************** */
+static bool_t Test_SecLtcStartLong(void)
+{
+    static uint8_t counter[AES_BLOCK_SIZE];
+    secLibJob_t* pJob = &mTestLtcJobs[0];
+    uint32_t i;
+
+    memset(pJob, 0, sizeof(*pJob));
+    pJob->type     = gSecLibJobCtr_c;
+    pJob->pKey     = mTestLtcKey;
+    pJob->pInput   = mTestLtcLongIn;
+    pJob->pOutput  = mTestLtcLongOut;
+    pJob->length   = mTestLtcLongSize_c;
+    pJob->pIv      = counter;
+    pJob->callback = Test_SecLtcCallback;
+
+    mTestLtcDone = 0;
+    if( gSecSuccess_c != SecLib_SubmitJob(pJob) )
+    {
+        return FALSE;
+    }
+
+    for( i = 0; i < mTestLtcTimeoutMs_c; i++ )
+    {
+        if( LTC0->STA & LTC_STA_AB_MASK )
+        {
+            return TRUE;
+        }
+        OSA_TimeDelay(1);
+    }
+
+    return FALSE;
+}
+
+static void Test_SecLtcCallback(secLibJob_t* pJob, secResultType_t status)
+{
+    uint32_t i = mTestLtcDone;
+
+    if( i < mTestLtcJobs_c )
+    {
+        mTestLtcOrder[i] = pJob;
+        mTestLtcStatus[i] = status;
+        mTestLtcIpsr[i] = __get_IPSR();
+    }
+
+    mTestLtcDone = i + 1;
+}
+
+static void Test_SecLtcIrqHandler(void)
+{
+    uint8_t plain[AES_BLOCK_SIZE];
+
+    (void)HostTest_Hex(plain, "00112233445566778899aabbccddeeff");
+    AES_128_Encrypt(plain, mTestLtcKey, mTestLtcIrqOut);
+    mTestLtcIrqJobsDone = mTestLtcDone;
+    mTestLtcIrqDone = 1;
+}
+
+static bool_t Test_SecLtcWait(volatile uint32_t* pCount, uint32_t count)
+{
+    uint32_t i;
+
+    for( i = 0; (i < mTestLtcTimeoutMs_c) && (*pCount < count); i++ )
+    {
+        OSA_TimeDelay(1);
+    }
+
+    return (*pCount >= count) ? TRUE : FALSE;
+}
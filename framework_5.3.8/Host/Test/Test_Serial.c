@@ -0,0 +1,138 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Host tests of the serial manager, on a custom interface connected to a pseudo
+* terminal. The test is the peer on the other side of the terminal.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "HostTest.h"
+#include "fsl_os_abstraction.h"
+#include "SerialManager.h"
+#include "Pipe_Adapter.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+********************************************************************************** */
+#define mTestSerialRxEvent_c     (1 << 0)
+#define mTestSerialTxEvent_c     (1 << 1)
+#define mTestSerialLargeSize_c   (1000)
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+********************************************************************************** */
+static void Test_SerialRxCallback(void* param);
+static void Test_SerialTxCallback(void* param);
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+********************************************************************************** */
+static osaEventId_t mTestSerialEvent;
+static uint8_t      mTestSerialBuff[mTestSerialLargeSize_c];
+static uint8_t      mTestSerialPeerBuff[mTestSerialLargeSize_c];
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+void Test_Serial(void)
+{
+    osaEventFlags_t flags;
+    uint8_t interfaceId;
+    uint16_t count;
+    uint16_t total;
+    int peer;
+    uint32_t i;
+
+    mTestSerialEvent = OSA_EventCreate(TRUE);
+    HOST_TEST_CHECK(NULL != mTestSerialEvent);
+
+    HOST_TEST_CHECK(gSerial_Success_c == Serial_InitInterface(&interfaceId, gSerialMgrCustom_c, 0));
+    HOST_TEST_CHECK(gPipeSuccess_c == Pipe_Initialize(interfaceId, gPipePtyDevice_c));
+    HOST_TEST_CHECK(gSerial_Success_c == Serial_SetRxCallBack(interfaceId, Test_SerialRxCallback, NULL));
+
+    peer = open(Pipe_GetDeviceName(), O_RDWR | O_NOCTTY);
+    if( !HOST_TEST_CHECK(peer >= 0) )
+    {
+        return;
+    }
+
+    /* Peer to framework: the callback runs, the data is read */
+    HOST_TEST_CHECK(5 == write(peer, "hello", 5));
+    HOST_TEST_CHECK(osaStatus_Success == OSA_EventWait(mTestSerialEvent, mTestSerialRxEvent_c,
+                                                       FALSE, 1000, &flags));
+    OSA_TimeDelay(10);
+    count = 0;
+    HOST_TEST_CHECK(gSerial_Success_c == Serial_Read(interfaceId, mTestSerialBuff, sizeof(mTestSerialBuff), &count));
+    HOST_TEST_CHECK((5 == count) && (0 == memcmp(mTestSerialBuff, "hello", 5)));
+
+    /* Framework to peer, synchronous */
+    HOST_TEST_CHECK(gSerial_Success_c == Serial_SyncWrite(interfaceId, (uint8_t*)"world", 5));
+    HOST_TEST_CHECK(5 == HostTest_Read(peer, mTestSerialPeerBuff, 5, 1000));
+    HOST_TEST_CHECK(0 == memcmp(mTestSerialPeerBuff, "world", 5));
+
+    /* Framework to peer, asynchronous, larger than the pipe buffers */
+    for( i = 0; i < mTestSerialLargeSize_c; i++ )
+    {
+        mTestSerialBuff[i] = (uint8_t)i;
+    }
+    HOST_TEST_CHECK(gSerial_Success_c == Serial_AsyncWrite(interfaceId, mTestSerialBuff, mTestSerialLargeSize_c,
+                                                           Test_SerialTxCallback, NULL));
+    HOST_TEST_CHECK(mTestSerialLargeSize_c == HostTest_Read(peer, mTestSerialPeerBuff, mTestSerialLargeSize_c, 2000));
+    HOST_TEST_CHECK_BUFFER(mTestSerialPeerBuff, mTestSerialBuff, mTestSerialLargeSize_c);
+    HOST_TEST_CHECK(osaStatus_Success == OSA_EventWait(mTestSerialEvent, mTestSerialTxEvent_c,
+                                                       FALSE, 1000, &flags));
+
+    /* Peer to framework, more than the receive buffer of the adapter */
+    HOST_TEST_CHECK(200 == write(peer, mTestSerialPeerBuff, 200));
+    total = 0;
+    for( i = 0; (i < 100) && (total < 200); i++ )
+    {
+        OSA_TimeDelay(5);
+        count = 0;
+        (void)Serial_Read(interfaceId, &mTestSerialBuff[total], sizeof(mTestSerialBuff) - total, &count);
+        total += count;
+    }
+    HOST_TEST_CHECK(200 == total);
+    HOST_TEST_CHECK_BUFFER(mTestSerialBuff, mTestSerialPeerBuff, 200);
+
+    (void)close(peer);
+    (void)OSA_EventDestroy(mTestSerialEvent);
+}
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+********************************************************************************** */
+static void Test_SerialRxCallback(void* param)
+{
+    (void)param;
+    (void)OSA_EventSet(mTestSerialEvent, mTestSerialRxEvent_c);
+}
+
+static void Test_SerialTxCallback(void* param)
+{
+    (void)param;
+    (void)OSA_EventSet(mTestSerialEvent, mTestSerialTxEvent_c);
+}
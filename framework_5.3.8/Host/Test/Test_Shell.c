@@ -0,0 +1,156 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Host tests of the shell, on a pseudo terminal: command lookup and arguments,
+* help, unknown commands, and an output larger than the transmit ring
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "HostTest.h"
+#include "fsl_os_abstraction.h"
+#include "shell.h"
+#include "Pipe_Adapter.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+********************************************************************************** */
+#define mTestShellLines_c      (40)
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+********************************************************************************** */
+static int8_t Test_ShellEcho(uint8_t argc, char * argv[]);
+static int8_t Test_ShellDump(uint8_t argc, char * argv[]);
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+********************************************************************************** */
+extern uint8_t gShellSerMgrIf;
+
+static cmd_tbl_t mTestShellEchoCmd =
+{
+    .name = "echo",
+    .maxargs = SHELL_MAX_ARGS,
+    .repeatable = 0,
+    .cmd = Test_ShellEcho,
+#if SHELL_USE_HELP
+    .usage = "echo <words>",
+    .help = "Writes its arguments",
+#endif
+};
+
+static cmd_tbl_t mTestShellDumpCmd =
+{
+    .name = "dump",
+    .maxargs = 1,
+    .repeatable = 0,
+    .cmd = Test_ShellDump,
+#if SHELL_USE_HELP
+    .usage = "dump",
+    .help = "Writes more than the transmit ring holds",
+#endif
+};
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+void Test_Shell(void)
+{
+    int peer;
+
+    shell_init("host> ");
+    HOST_TEST_CHECK(gPipeSuccess_c == Pipe_Initialize(gShellSerMgrIf, gPipePtyDevice_c));
+    HOST_TEST_CHECK(0 == shell_register_function(&mTestShellEchoCmd));
+    HOST_TEST_CHECK(0 == shell_register_function(&mTestShellDumpCmd));
+    HOST_TEST_CHECK(&mTestShellEchoCmd == shell_find_command("echo"));
+    HOST_TEST_CHECK(NULL == shell_find_command("ech"));
+
+    peer = open(Pipe_GetDeviceName(), O_RDWR | O_NOCTTY);
+    if( !HOST_TEST_CHECK(peer >= 0) )
+    {
+        return;
+    }
+
+    /* Arguments are split on spaces */
+    HOST_TEST_CHECK(19 == write(peer, "echo one two three\r", 19));
+    HOST_TEST_CHECK(HostTest_ReadUntil(peer, "argc=4 one|two|three|", 1000));
+    HOST_TEST_CHECK(HostTest_ReadUntil(peer, "host> ", 1000));
+
+    HOST_TEST_CHECK(7 == write(peer, "nosuch\r", 7));
+    HOST_TEST_CHECK(HostTest_ReadUntil(peer, "Unknown command", 1000));
+
+#if SHELL_USE_HELP
+    HOST_TEST_CHECK(5 == write(peer, "help\r", 5));
+    HOST_TEST_CHECK(HostTest_ReadUntil(peer, "dump", 1000));
+#endif
+
+    /* No line of a long output is lost */
+    HOST_TEST_CHECK(5 == write(peer, "dump\r", 5));
+    HOST_TEST_CHECK(HostTest_ReadUntil(peer, "line 0 ", 1000));
+    HOST_TEST_CHECK(HostTest_ReadUntil(peer, "line 39 end", 2000));
+    HOST_TEST_CHECK(0 == shell_get_tx_dropped());
+
+    (void)close(peer);
+}
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+********************************************************************************** */
+static int8_t Test_ShellEcho(uint8_t argc, char * argv[])
+{
+    uint32_t i;
+
+    shell_write("argc=");
+    shell_writeDec(argc);
+    shell_write(" ");
+    for( i = 1; i < argc; i++ )
+    {
+        shell_write(argv[i]);
+        shell_write("|");
+    }
+    SHELL_NEWLINE();
+
+    return CMD_RET_SUCCESS;
+}
+
+static int8_t Test_ShellDump(uint8_t argc, char * argv[])
+{
+    char line[48];
+    uint32_t i;
+
+    (void)argc;
+    (void)argv;
+
+    for( i = 0; i < mTestShellLines_c; i++ )
+    {
+        (void)snprintf(line, sizeof(line), "line %u %s\r\n", (unsigned)i,
+                       (i == mTestShellLines_c - 1) ? "end" : "of the output of the dump command");
+        shell_write(line);
+    }
+
+    return CMD_RET_SUCCESS;
+}
@@ -0,0 +1,143 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* Host tests of the timers manager: single shot and interval timers, the time
+* stamp and the RTC alarm
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include "HostTest.h"
+#include "Host.h"
+#include "fsl_os_abstraction.h"
+#include "TimersManager.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+********************************************************************************** */
+#define mTestTmrSingleShotEvent_c   (1 << 0)
+#define mTestTmrIntervalEvent_c     (1 << 1)
+#define mTestTmrRtcEvent_c          (1 << 2)
+
+/* Scheduling of the host threads adds to the expiry time */
+#define mTestTmrToleranceMs_c       (50)
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+********************************************************************************** */
+static void Test_TmrCallback(void* param);
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+********************************************************************************** */
+static osaEventId_t      mTestTmrEvent;
+static volatile uint32_t mTestTmrIntervalCount;
+static volatile uint32_t mTestTmrSingleShotTime;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+void Test_Timers(void)
+{
+    osaEventFlags_t flags;
+    tmrTimerID_t singleShot;
+    tmrTimerID_t interval;
+    uint64_t stamp;
+    uint32_t start;
+    uint32_t count;
+
+    mTestTmrEvent = OSA_EventCreate(TRUE);
+    HOST_TEST_CHECK(NULL != mTestTmrEvent);
+
+    singleShot = TMR_AllocateTimer();
+    interval   = TMR_AllocateTimer();
+    HOST_TEST_CHECK((gTmrInvalidTimerID_c != singleShot) && (gTmrInvalidTimerID_c != interval));
+
+    /* Single shot timer */
+    start = OSA_TimeGetMsec();
+    HOST_TEST_CHECK(gTmrSuccess_c == TMR_StartSingleShotTimer(singleShot, 100, Test_TmrCallback,
+                                                               (void*)mTestTmrSingleShotEvent_c));
+    /* The timer task activates the timers it finds ready */
+    HOST_TEST_CHECK(TMR_IsTimerReady(singleShot) || TMR_IsTimerActive(singleShot));
+    HOST_TEST_CHECK(osaStatus_Success == OSA_EventWait(mTestTmrEvent, mTestTmrSingleShotEvent_c,
+                                                       FALSE, 1000, &flags));
+    HOST_TEST_CHECK(mTestTmrSingleShotTime - start >= 100);
+    HOST_TEST_CHECK(mTestTmrSingleShotTime - start <= 100 + mTestTmrToleranceMs_c);
+    HOST_TEST_CHECK(!TMR_IsTimerActive(singleShot));
+
+    /* Interval timer, stopped after a few periods */
+    HOST_TEST_CHECK(gTmrSuccess_c == TMR_StartIntervalTimer(interval, 20, Test_TmrCallback,
+                                                             (void*)mTestTmrIntervalEvent_c));
+    OSA_TimeDelay(210);
+    HOST_TEST_CHECK(gTmrSuccess_c == TMR_StopTimer(interval));
+    count = mTestTmrIntervalCount;
+    HOST_TEST_CHECK((count >= 8) && (count <= 11));
+    OSA_TimeDelay(60);
+    HOST_TEST_CHECK(count == mTestTmrIntervalCount);
+
+    /* A stopped timer does not expire */
+    HOST_TEST_CHECK(gTmrSuccess_c == TMR_StartSingleShotTimer(singleShot, 30, Test_TmrCallback,
+                                                               (void*)mTestTmrSingleShotEvent_c));
+    HOST_TEST_CHECK(gTmrSuccess_c == TMR_StopTimer(singleShot));
+    HOST_TEST_CHECK(osaStatus_Timeout == OSA_EventWait(mTestTmrEvent, mTestTmrSingleShotEvent_c,
+                                                       FALSE, 100, &flags));
+
+    HOST_TEST_CHECK(gTmrSuccess_c == TMR_FreeTimer(singleShot));
+    HOST_TEST_CHECK(gTmrSuccess_c == TMR_FreeTimer(interval));
+
+    /* Time stamp, in microseconds. The RTC registers advance every host tick,
+       so each reading may be late by up to one tick. */
+    TMR_TimeStampInit();
+    stamp = TMR_GetTimestamp();
+    OSA_TimeDelay(50);
+    stamp = TMR_GetTimestamp() - stamp;
+    HOST_TEST_CHECK((stamp + 2 * gHostTickPeriodUs_c >= 50000) &&
+                    (stamp <= 50000 + mTestTmrToleranceMs_c * 1000));
+
+    /* RTC alarm */
+    TMR_RTCInit();
+    start = OSA_TimeGetMsec();
+    TMR_RTCSetAlarmRelative(1, Test_TmrCallback, (void*)mTestTmrRtcEvent_c);
+    HOST_TEST_CHECK(osaStatus_Success == OSA_EventWait(mTestTmrEvent, mTestTmrRtcEvent_c,
+                                                       FALSE, 3000, &flags));
+    HOST_TEST_CHECK(OSA_TimeGetMsec() - start <= 1000 + mTestTmrToleranceMs_c);
+
+    (void)OSA_EventDestroy(mTestTmrEvent);
+}
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+********************************************************************************** */
+static void Test_TmrCallback(void* param)
+{
+    uint32_t event = (uint32_t)(uintptr_t)param;
+
+    if( mTestTmrSingleShotEvent_c == event )
+    {
+        mTestTmrSingleShotTime = OSA_TimeGetMsec();
+    }
+    else if( mTestTmrIntervalEvent_c == event )
+    {
+        mTestTmrIntervalCount++;
+    }
+
+    (void)OSA_EventSet(mTestTmrEvent, event);
+}
@@ -18,6 +18,23 @@
 #include "GenericList.h"
 #include "fsl_os_abstraction.h"
 
+/*! *********************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+********************************************************************************** */
+#if gListUseAtomics_d
+#define mListLoadAcquire(p)       atomic_load_explicit((p), memory_order_acquire)
+#define mListStoreRelease(p, v)   atomic_store_explicit((p), (v), memory_order_release)
+/* The next field of an element is not declared atomic */
+#define mListNext(element)        ((LIST_ATOMIC(listElementHandle_t)*)&(element)->next)
+#else
+/* Volatile accesses keep their order on a single core */
+#define mListLoadAcquire(p)       (*(p))
+#define mListStoreRelease(p, v)   (*(p) = (v))
+#define mListNext(element)        ((listElementHandle_t volatile *)&(element)->next)
+#endif
+
 
 /*! *********************************************************************************
 *************************************************************************************
@@ -394,6 +411,258 @@ uint32_t ListGetAvailable(listHandle_t list)
   return (list->max - list->size);
 }
 
+/*! *********************************************************************************
+* \brief     Initialises a single producer, single consumer ring.
+*
+* \param[in] ring - Ring handle to init.
+*            pSlots - Storage for the element handles.
+*            slots - Number of slots, a power of 2 not greater than 32768.
+*
+* \return gListFull_c if the number of slots is not valid.
+*         gListOk_c otherwise.
+*
+* \pre
+*
+* \post
+*
+* \remarks
+*
+********************************************************************************** */
+listStatus_t ListSpscInit(listSpscHandle_t ring, listElementHandle_t *pSlots, uint32_t slots)
+{
+  if( (slots == 0) || (slots > 0x8000) || (slots & (slots - 1)) )
+  {
+    return gListFull_c;
+  }
+
+  ring->pSlots = pSlots;
+  ring->mask = slots - 1;
+  ring->head = 0;
+  ring->tail = 0;
+  return gListOk_c;
+}
+
+/*! *********************************************************************************
+* \brief     Adds an element to a single producer, single consumer ring. 
+*
+* \param[in] ring - Ring to insert into.
+*            element - element to add
+*
+* \return gListFull_c if the ring is full.
+*         gListOk_c if insertion was successful.
+*
+* \pre
+*
+* \post
+*
+* \remarks Must be called by the producer only. Interrupts are not disabled.
+*
+********************************************************************************** */
+listStatus_t ListSpscPush(listSpscHandle_t ring, listElementHandle_t element)
+{
+  uint16_t tail = ring->tail;
+
+  if( (uint16_t)(tail - mListLoadAcquire(&ring->head)) > ring->mask )
+  {
+    return gListFull_c;
+  }
+
+  ring->pSlots[tail & ring->mask] = element;
+  /* Publish the slot after it was written */
+  mListStoreRelease(&ring->tail, (uint16_t)(tail + 1));
+  return gListOk_c;
+}
+
+/*! *********************************************************************************
+* \brief     Removes the oldest element of a single producer, single consumer ring. 
+*
+* \param[in] ring - Ring to remove from.
+*
+* \return NULL if the ring is empty.
+*         handle of the removed element otherwise.
+*
+* \pre
+*
+* \post
+*
+* \remarks Must be called by the consumer only. Interrupts are not disabled.
+*
+********************************************************************************** */
+listElementHandle_t ListSpscPop(listSpscHandle_t ring)
+{
+  listElementHandle_t element;
+  uint16_t head = ring->head;
+
+  if( head == mListLoadAcquire(&ring->tail) )
+  {
+    return NULL;
+  }
+
+  element = ring->pSlots[head & ring->mask];
+  /* Release the slot after it was read */
+  mListStoreRelease(&ring->head, (uint16_t)(head + 1));
+  return element;
+}
+
+/*! *********************************************************************************
+* \brief     Gets the number of elements in a single producer, single consumer ring. 
+*
+* \param[in] ring - ID of the ring.
+*
+* \return Number of elements. The value may be outdated when used by a
+*         context other than the producer or the consumer.
+*
+* \pre
+*
+* \post
+*
+* \remarks
+*
+********************************************************************************** */
+uint32_t ListSpscGetSize(listSpscHandle_t ring)
+{
+  return (uint16_t)(mListLoadAcquire(&ring->tail) - mListLoadAcquire(&ring->head));
+}
+
+/*! *********************************************************************************
+* \brief     Initialises a multiple producer, single consumer queue.
+*
+* \param[in] queue - Queue handle to init.
+*
+* \return void.
+*
+* \pre
+*
+* \post
+*
+* \remarks
+*
+********************************************************************************** */
+void ListMpscInit(listMpscHandle_t queue)
+{
+  queue->stub.next = NULL;
+  queue->stub.prev = NULL;
+  queue->stub.list = NULL;
+  queue->head = &queue->stub;
+  queue->tail = &queue->stub;
+}
+
+/*! *********************************************************************************
+* \brief     Adds an element to a multiple producer, single consumer queue. 
+*
+* \param[in] queue - Queue to insert into.
+*            element - element to add
+*
+* \return void.
+*
+* \pre The element must not be in another list or queue.
+*
+* \post
+*
+* \remarks Can be called from any context. With atomics, the tail is
+* exchanged without locking. Otherwise interrupts are disabled for three
+* stores.
+*
+********************************************************************************** */
+void ListMpscPush(listMpscHandle_t queue, listElementHandle_t element)
+{
+  listElementHandle_t prev;
+
+  element->next = NULL;
+#if gListUseAtomics_d
+  prev = atomic_exchange_explicit(&queue->tail, element, memory_order_acq_rel);
+  /* Until this store, the consumer sees the queue ending at prev */
+  mListStoreRelease(mListNext(prev), element);
+#else
+  OSA_InterruptDisable();
+  prev = queue->tail;
+  queue->tail = element;
+  *mListNext(prev) = element;
+  OSA_InterruptEnable();
+#endif
+}
+
+/*! *********************************************************************************
+* \brief     Removes the oldest element of a multiple producer, single consumer
+*            queue. 
+*
+* \param[in] queue - Queue to remove from.
+*
+* \return NULL if the queue is empty, or if a producer has not yet linked
+*         the next element.
+*         handle of the removed element otherwise.
+*
+* \pre
+*
+* \post
+*
+* \remarks Must be called by the consumer only. Interrupts are disabled only
+* when the last element is removed, to put the stub back.
+*
+********************************************************************************** */
+listElementHandle_t ListMpscPop(listMpscHandle_t queue)
+{
+  listElementHandle_t head = queue->head;
+  listElementHandle_t next = mListLoadAcquire(mListNext(head));
+
+  if( head == &queue->stub )
+  {
+    if( next == NULL )
+    {
+      return NULL;
+    }
+    /* Skip the stub */
+    queue->head = next;
+    head = next;
+    next = mListLoadAcquire(mListNext(head));
+  }
+
+  if( next != NULL )
+  {
+    queue->head = next;
+    return head;
+  }
+
+  if( head != mListLoadAcquire(&queue->tail) )
+  {
+    /* A producer is between the exchange and the link */
+    return NULL;
+  }
+
+  /* head is the last element: put the stub behind it, so it can be removed */
+  ListMpscPush(queue, &queue->stub);
+  next = mListLoadAcquire(mListNext(head));
+
+  if( next != NULL )
+  {
+    queue->head = next;
+    return head;
+  }
+
+  return NULL;
+}
+
+/*! *********************************************************************************
+* \brief     Checks if a multiple producer, single consumer queue is empty. 
+*
+* \param[in] queue - ID of the queue.
+*
+* \return TRUE if no element is queued, FALSE otherwise.
+*
+* \pre
+*
+* \post
+*
+* \remarks The result may be outdated when used by a context other than the
+* consumer. The queue is empty when both ends are on the stub.
+*
+********************************************************************************** */
+bool_t ListMpscIsEmpty(listMpscHandle_t queue)
+{
+  return (queue->head == &queue->stub) &&
+         (mListLoadAcquire(&queue->tail) == &queue->stub);
+}
+
 /*! *********************************************************************************
 * \brief     Creates, tests and deletes a list. Any error that occurs will trap the 
 *            CPU in a while(1) loop.
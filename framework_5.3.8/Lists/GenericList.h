@@ -22,6 +22,25 @@
 
 #include "EmbeddedTypes.h"
 
+/* The SPSC and MPSC queues use C11 atomics when the core has exclusive access
+   instructions. ARMv6-M cores, like the Cortex-M0+, do not, so the MPSC queue
+   uses a short critical section on them instead. */
+#ifndef gListUseAtomics_d
+#if defined(__ARM_ARCH_6M__) || defined(__ARM6M__) || defined(__TARGET_ARCH_6S_M) || \
+    !defined(__STDC_VERSION__) || (__STDC_VERSION__ < 201112L) || defined(__STDC_NO_ATOMICS__)
+#define gListUseAtomics_d 0
+#else
+#define gListUseAtomics_d 1
+#endif
+#endif
+
+#if gListUseAtomics_d
+#include <stdatomic.h>
+#define LIST_ATOMIC(type) _Atomic(type)
+#else
+#define LIST_ATOMIC(type) volatile type
+#endif
+
 
 /*! *********************************************************************************
 *************************************************************************************
@@ -57,6 +76,25 @@ typedef struct listElement_tag
   struct list_tag *list;
 }listElement_t, *listElementHandle_t;
 
+/* Single producer, single consumer ring of element handles. The producer and
+   the consumer may run in different contexts without any locking. */
+typedef struct listSpsc_tag
+{
+  listElementHandle_t volatile *pSlots;   /* Storage, a power of 2 of slots */
+  uint16_t mask;                          /* Number of slots - 1 */
+  LIST_ATOMIC(uint16_t) head;             /* Next slot to read, written by the consumer */
+  LIST_ATOMIC(uint16_t) tail;             /* Next slot to write, written by the producer */
+}listSpsc_t, *listSpscHandle_t;
+
+/* Multiple producer, single consumer intrusive FIFO. Elements are linked
+   through their next field; prev and list are not used. */
+typedef struct listMpsc_tag
+{
+  LIST_ATOMIC(listElementHandle_t) tail;  /* Last element pushed, shared by the producers */
+  listElementHandle_t head;               /* Next element to pop, owned by the consumer */
+  listElement_t stub;                     /* Keeps the queue non-empty */
+}listMpsc_t, *listMpscHandle_t;
+
 /*! *********************************************************************************
 *************************************************************************************
 * Public prototypes
@@ -76,6 +114,16 @@ uint32_t ListGetSize(listHandle_t list);
 uint32_t ListGetAvailable(listHandle_t list);
 listStatus_t ListTest(void);
 
+listStatus_t ListSpscInit(listSpscHandle_t ring, listElementHandle_t *pSlots, uint32_t slots);
+listStatus_t ListSpscPush(listSpscHandle_t ring, listElementHandle_t element);
+listElementHandle_t ListSpscPop(listSpscHandle_t ring);
+uint32_t ListSpscGetSize(listSpscHandle_t ring);
+
+void ListMpscInit(listMpscHandle_t queue);
+void ListMpscPush(listMpscHandle_t queue, listElementHandle_t element);
+listElementHandle_t ListMpscPop(listMpscHandle_t queue);
+bool_t ListMpscIsEmpty(listMpscHandle_t queue);
+
 /*! *********************************************************************************
 *************************************************************************************
 * Private macros
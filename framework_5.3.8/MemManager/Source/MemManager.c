@@ -21,6 +21,7 @@
 #include "Panic.h"
 #include "MemManager.h"
 #include "FunctionLib.h"
+#include "Profiler.h"
 
 /*! *********************************************************************************
 *************************************************************************************
@@ -277,6 +278,7 @@ void *pCaller
     
     pools_t *pPools = memPools;
     listHeader_t *pBlock;
+    PROFILER_PROBE_START(mMemAllocProbe, "MEM_BufferAllocWithId");
 
     OSA_InterruptDisable();
     
@@ -310,6 +312,7 @@ void *pCaller
                 MEM_Track(pBlock, MEM_TRACKING_ALLOC_c, savedLR, requestedSize, pCaller);
 #endif /*MEM_TRACKING*/
                 OSA_InterruptEnable();
+                PROFILER_PROBE_STOP(mMemAllocProbe);
                 return pBlock;
             }
             else
@@ -348,6 +351,7 @@ void *pCaller
 #endif
     
     OSA_InterruptEnable();
+    PROFILER_PROBE_STOP(mMemAllocProbe);
     return NULL;
 }
 
@@ -32,6 +32,12 @@
 #define  anchor_t        list_t
 #define  msgQueue_t      list_t
 
+/* Multiple producer, single consumer message queue. This is the MPSC queue of
+   GenericList, chaining the messages through the list header placed by the
+   MemManager before each buffer, so a message is queued in place, without
+   being copied. */
+typedef listMpsc_t msgMpscQueue_t;
+
 /************************************************************************************
 *************************************************************************************
 * Public macros
@@ -57,6 +63,12 @@
 #define  MSG_Free(element)          MEM_BufferFree(element)
 #define  MSG_FreeQueue(anchor)      while(MSG_Pending(anchor)) { MSG_Free(MSG_DeQueue(anchor)); }
 
+/* Multiple producer, single consumer queue. MSG_MpscPush() may be called from
+   any task or interrupt. MSG_MpscPopAll() returns every queued message at once,
+   in the order of arrival; the batch is walked with MSG_MpscNext(). */
+#define MSG_MpscInit(pQueue)        ListMpscInit(pQueue)
+#define MSG_MpscPending(pQueue)     (!ListMpscIsEmpty(pQueue))
+
 /************************************************************************************
 *************************************************************************************
 * Public prototypes
@@ -71,6 +83,10 @@ void *ListRemoveHeadMsg( listHandle_t list );
 void *ListGetHeadMsg   ( listHandle_t list );
 void *ListGetNextMsg   ( void* pMsg );
 
+void  MSG_MpscPush     ( msgMpscQueue_t* pQueue, void* pMsg );
+void *MSG_MpscPopAll   ( msgMpscQueue_t* pQueue );
+void *MSG_MpscNext     ( void* pMsg );
+
 /*================================================================================================*/
 
 #endif  /* _MESSAGING_H */
@@ -231,3 +231,83 @@ listStatus_t ListRemoveMsg( void* pMsg )
 
     return ListRemoveElement( (listElementHandle_t)p );
 }
+
+/*! *********************************************************************************
+* \brief     Queues a message in a multiple producer, single consumer queue.
+*
+* \param[in] pQueue - pointer to the queue.
+*            pMsg - message to queue. The ownership passes to the consumer.
+*
+* \return None.
+*
+* \pre Buffer must be allocated using MemManager, and must not be in a list.
+*
+* \post
+*
+* \remarks The list element of the message header is pushed with ListMpscPush().
+* Can be called from interrupt context.
+*
+********************************************************************************** */
+void MSG_MpscPush( msgMpscQueue_t* pQueue, void* pMsg )
+{
+    listHeader_t *p = (listHeader_t*)pMsg - 1;
+
+    ListMpscPush( pQueue, &p->link );
+}
+
+/*! *********************************************************************************
+* \brief     Removes all the messages from a multiple producer, single consumer
+*            queue.
+*
+* \param[in] pQueue - pointer to the queue.
+*
+* \return NULL if the queue is empty.
+*         pointer to the data of the oldest message. The next messages are
+*         obtained with MSG_MpscNext().
+*
+* \pre Must be called by the consumer only.
+*
+* \post
+*
+* \remarks The messages are removed with ListMpscPop() until the queue is
+* empty, and chained through their next field, which the queue no longer
+* uses. A message still being linked by a producer is left for the next batch.
+*
+********************************************************************************** */
+void *MSG_MpscPopAll( msgMpscQueue_t* pQueue )
+{
+    listElement_t *pFirst = ListMpscPop( pQueue );
+    listElement_t *pLast = pFirst;
+    listElement_t *pNext;
+
+    while( pLast )
+    {
+        pNext = ListMpscPop( pQueue );
+        pLast->next = pNext;
+        pLast = pNext;
+    }
+
+    return pFirst ? (listHeader_t*)pFirst + 1 : NULL;
+}
+
+/*! *********************************************************************************
+* \brief     Returns the next message of a batch obtained with MSG_MpscPopAll().
+*
+* \param[in] pMsg - pointer to the data of the current message.
+*
+* \return NULL if pMsg is the last message of the batch.
+*         pointer to the data of the next message.
+*
+* \pre
+*
+* \post
+*
+* \remarks Must be called before the current message is freed.
+*
+********************************************************************************** */
+void *MSG_MpscNext( void* pMsg )
+{
+    listHeader_t *p = (listHeader_t*)pMsg - 1;
+
+    return p->link.next ? (listHeader_t*)(p->link.next) + 1 : NULL;
+}
@@ -25,6 +25,14 @@
 * Public macros
 *************************************************************************************
 ************************************************************************************/
+/* Without a linker script (host build), the linker defines __start_ and __stop_
+   only for a section named like a C identifier */
+#if defined(CPU_HOST)
+  #define gVERSION_TAGS_SectionName_d "VERSION_TAGS"
+#else
+  #define gVERSION_TAGS_SectionName_d ".VERSION_TAGS"
+#endif
+
 #if defined(__GNUC__)
 
   extern uint32_t __start_VERSION_TAGS[];
@@ -84,7 +92,7 @@ typedef PACKED_STRUCT moduleInfo_tag {
 #define RegisterModuleInfo(moduleName, moduleNameString, moduleId, versionNoMajor, versionNoMinor, versionNoPatch, buildNo) \
     const moduleInfo_t \
     SET_MODULE_NAME(moduleName) \
-    __attribute__((section (".VERSION_TAGS"), used)) \
+    __attribute__((section (gVERSION_TAGS_SectionName_d), used)) \
     = { &moduleNameString, moduleId, {versionNoMajor, versionNoMinor, versionNoPatch}, buildNo }
 #else
 #define RegisterModuleInfo(moduleName, moduleNameString, moduleId, versionNoMajor, versionNoMinor, versionNoPatch, buildNo)
@@ -243,7 +243,15 @@
 #define gNvmMemPoolId_c                 (0)
 #endif
 
-/* Define section for keeping NVM table datasets */
+/* Define section for keeping NVM table datasets. Without a linker script (host
+   build), the linker defines __start_ and __stop_ only for a section named like a
+   C identifier. */
+#if defined(CPU_HOST)
+  #define gNVM_TABLE_SectionName_c  "NVM_TABLE"
+#else
+  #define gNVM_TABLE_SectionName_c  ".NVM_TABLE"
+#endif
+
 #if defined(__GNUC__)
   extern uint32_t __start_NVM_TABLE[];
   extern uint32_t __stop_NVM_TABLE[];
@@ -286,7 +294,7 @@
   #define NVM_RegisterDataSet(pData, elementsCount, elementSize, dataEntryID, dataEntryType) \
       NVM_DataEntry_t \
       SET_DATASET_STRUCT_NAME(dataEntryID) \
-      __attribute__((section (".NVM_TABLE"), used)) \
+      __attribute__((section (gNVM_TABLE_SectionName_c), used)) \
       = { pData, elementsCount, elementSize, dataEntryID, dataEntryType }
   #elif defined(__CC_ARM)
   #define NVM_RegisterDataSet(pData, elementsCount, elementSize, dataEntryID, dataEntryType) \
@@ -319,7 +327,7 @@
   #define NVM_RegisterDataSet(pData, elementsCount, elementSize, dataEntryID, dataEntryType) \
       const NVM_DataEntry_t \
       SET_DATASET_STRUCT_NAME(dataEntryID) \
-      __attribute__((section (".NVM_TABLE"), used)) \
+      __attribute__((section (gNVM_TABLE_SectionName_c), used)) \
       = { pData, elementsCount, elementSize, dataEntryID, dataEntryType }
   #else
   #define NVM_RegisterDataSet(pData, elementsCount, elementSize, dataEntryID, dataEntryType) \
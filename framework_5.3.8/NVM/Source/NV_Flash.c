@@ -18,6 +18,7 @@
 
 #include "fsl_os_abstraction.h"
 #include "Flash_Adapter.h"
+#include "Profiler.h"
 
 #if (gFsciIncluded_c && (gNvmEnableFSCIRequests_c || gNvmEnableFSCIMonitoring_c))
 #include "NV_FsciCommands.h"
@@ -6235,7 +6236,9 @@ void NvIdle
         mNvIdleTaskId = OSA_TaskGetId();
     }
     (void)OSA_MutexLock(mNVMMutexId, osaWaitForever_c);
+    PROFILER_PROBE_START(mNvIdleProbe, "__NvIdle");
     __NvIdle();
+    PROFILER_PROBE_STOP(mNvIdleProbe);
     (void)OSA_MutexUnlock(mNVMMutexId);
 
 #endif
@@ -105,6 +105,8 @@ typedef enum osaStatus_tag
     #define USE_RTOS 1
 #elif defined (FSL_RTOS_RIOT)
     #define USE_RTOS 1
+#elif defined (FSL_RTOS_HOST)
+    #define USE_RTOS 1
 #else
     #define USE_RTOS 0
 #endif
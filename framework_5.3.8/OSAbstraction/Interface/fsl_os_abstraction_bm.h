@@ -29,6 +29,11 @@
 #define FSL_OSA_BM_TIMER_CONFIG FSL_OSA_BM_TIMER_NONE
 #endif
 
+/*! @brief Count the runs and the run time of each task. */
+#ifndef gOsaBmTaskStats_d
+#define gOsaBmTaskStats_d 0
+#endif
+
 /*! @brief Type for an semaphore */
 typedef struct Semaphore
 {
@@ -36,6 +41,7 @@ typedef struct Semaphore
     volatile uint8_t   semCount;   /*!< The count value of the object                    */
     uint32_t           time_start; /*!< The time to start timeout                        */
     uint32_t           timeout;    /*!< Timeout to wait in milliseconds                  */
+    uint32_t           waitingTasks; /*!< Waiting tasks, one bit per task control block  */
 } semaphore_t;
 
 /*! @brief Type for a mutex */
@@ -61,6 +67,11 @@ typedef struct TaskControlBlock
     bool_t haveToRun;                       /*!< Task was signaled                      */ 
     osaTaskPriority_t priority;             /*!< Task's priority                        */    
     osaTaskParam_t  param;                  /*!< Task's parameter                       */
+    uint32_t readyMask;                     /*!< Task's bit in the ready bitmap         */
+#if gOsaBmTaskStats_d
+    uint32_t runCount;                      /*!< Number of times the task was run       */
+    uint32_t runTime;                       /*!< Cumulative run time of the task        */
+#endif
     struct TaskControlBlock *next;          /*!< Pointer to next task control block     */
     struct TaskControlBlock *prev;          /*!< Pointer to previous task control block */
 } task_control_block_t;
@@ -105,7 +116,7 @@ typedef msg_queue_t*  msg_queue_handler_t;
 /*! @brief Constant to pass as timeout value in order to wait indefinitely. */
 #define OSA_WAIT_FOREVER  0xFFFFFFFFU
 
-/*! @brief How many tasks can the bare metal support. */
+/*! @brief How many tasks can the bare metal support, at most 32. */
 #define TASK_MAX_NUM  7
 
 /*! @brief OSA's time range in millisecond, OSA time wraps if exceeds this value. */
@@ -153,6 +164,42 @@ extern "C" {
  */
 void OSA_PollAllOtherTasks(void);
 
+/*!
+ * @brief Called by the scheduler when no task has to run.
+ *
+ * Interrupts are disabled during the call. The default implementation
+ * executes WFI, which returns when an interrupt is pending. The application
+ * may override this weak function to enter a low power mode.
+ */
+void OSA_SchedulerIdle(void);
+
+#if gOsaBmTaskStats_d
+/*!
+ * @brief Returns the time base of the task statistics.
+ *
+ * The default implementation counts core clock cycles using the SYSTICK,
+ * or returns OSA_TimeGetMsec() if no timer is configured. The application
+ * may override this weak function.
+ */
+uint32_t OSA_TaskStatsTimeGet(void);
+
+/*!
+ * @brief Gets the statistics of a task.
+ *
+ * @param taskId The task handler.
+ * @param pRunCount Number of times the task was run.
+ * @param pRunTime Cumulative run time, in OSA_TaskStatsTimeGet() units.
+ *
+ * @return osaStatus_Success, or osaStatus_Error if the task is not valid.
+ */
+osaStatus_t OSA_TaskGetStats(osaTaskId_t taskId, uint32_t *pRunCount, uint32_t *pRunTime);
+
+/*!
+ * @brief Gets the number of times the scheduler found no task to run.
+ */
+uint32_t OSA_SchedulerGetIdleCount(void);
+#endif
+
 #if defined(__cplusplus)
 }
 #endif /* __cplusplus*/
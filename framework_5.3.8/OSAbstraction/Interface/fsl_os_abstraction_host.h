@@ -0,0 +1,103 @@
+/*
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+#if !defined(__FSL_OS_ABSTRACTION_HOST_H__)
+#define __FSL_OS_ABSTRACTION_HOST_H__
+
+#include <pthread.h>
+
+/*!
+ * @addtogroup os_abstraction_host
+ * @{
+ */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+
+/*
+ * The Host port runs the framework in a Linux process, see Host.h. Each task is a
+ * thread, and the tasks run concurrently: the task priorities are kept, but not
+ * used for scheduling. The critical sections of OSA_InterruptDisable() exclude
+ * each other and the interrupt handlers, as on the MCU.
+ */
+
+/*! @brief Maximum number of tasks. */
+#ifndef gOsaHostMaxTasks_c
+#define gOsaHostMaxTasks_c  16
+#endif
+
+/*! @brief Type for task parameter */
+typedef void* task_param_t;
+
+/*! @brief Type for a task function */
+typedef void (* task_t)(task_param_t param);
+
+/*! @brief Task control block for the host. */
+typedef struct TaskControlBlock
+{
+    volatile bool_t    inUse;               /*!< The task exists                        */
+    osaTaskPtr_t       p_func;              /*!< Task's entry                           */
+    osaTaskParam_t     param;               /*!< Task's parameter                       */
+    osaTaskPriority_t  priority;            /*!< Task's priority, not used to schedule  */
+    osaThreadDef_t    *pThreadDef;          /*!< Definition the task was created from   */
+} task_control_block_t;
+
+/*! @brief Type for a task pointer */
+typedef task_control_block_t* task_handler_t;
+
+/*! @brief Type for an event flags group, bit 32 is reserved */
+typedef uint32_t event_flags_t;
+
+/*! @brief Type for a semaphore */
+typedef struct Semaphore
+{
+    pthread_cond_t     cond;                /*!< Signaled when the semaphore is posted  */
+    uint8_t            semCount;            /*!< The count value of the object          */
+} semaphore_t;
+
+/*! @brief Type for a mutex */
+typedef struct Mutex
+{
+    pthread_cond_t     cond;                /*!< Signaled when the mutex is unlocked    */
+    bool_t             isLocked;            /*!< Is the object locked or not            */
+    pthread_t          owner;               /*!< Thread which locked the object         */
+} mutex_t;
+
+/*! @brief Type for an event object */
+typedef struct Event
+{
+    pthread_cond_t     cond;                /*!< Signaled when flags are set            */
+    event_flags_t      flags;               /*!< The flags status                       */
+    bool_t             autoClear;           /*!< Auto clear or manual clear             */
+} event_t;
+
+/*! @brief Type for a message queue */
+typedef struct MsgQueue
+{
+    pthread_cond_t     cond;                         /*!< Signaled when a message is put       */
+    uint16_t           number;                       /*!< The number of messages in the queue  */
+    uint16_t           max;                          /*!< The max number of queue messages     */
+    uint16_t           head;                         /*!< Index of the next message to be read */
+    uint16_t           tail;                         /*!< Index of the next place to write to  */
+    uint32_t           queueMem[osNumberOfMessages]; /*!< Points to the queue memory           */
+} msg_queue_t;
+
+/*! @brief Type for a message queue handler */
+typedef msg_queue_t*  msg_queue_handler_t;
+
+/*! @brief Constant to pass as timeout value in order to wait indefinitely. */
+#define OSA_WAIT_FOREVER  0xFFFFFFFFU
+
+/*! @brief OSA's time range in millisecond, OSA time wraps if exceeds this value. */
+#define FSL_OSA_TIME_RANGE 0xFFFFFFFFU
+
+/*! @}*/
+
+#endif /* __FSL_OS_ABSTRACTION_HOST_H__ */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -22,6 +22,7 @@
 #include "fsl_common.h"
 #include <string.h>
 #include "GenericList.h"
+#include "Profiler.h"
 
 /*! *********************************************************************************
 *************************************************************************************
@@ -50,6 +51,20 @@
 #define osObjectAlloc_c 0
 #endif
 
+/* Number of words of the allocation bitmap of n objects */
+#define osObjectMapWords_c(n) (((n) + 31U) >> 5)
+
+/* Reciprocal of an object size, in 16.16 fixed point. The index of an object is
+ * computed as (offset * reciprocal) >> 16, which is exact for the offsets of a
+ * heap smaller than 64 KB and avoids the software division of the Cortex-M0+. */
+#define osObjectRecip_c(size) ((0x10000U + (size) - 1U) / (size))
+#define osObjectHeapCheck_c(heap) typedef uint8_t heap##SizeCheck_t[(sizeof(heap) <= 0x10000U) ? 1 : -1]
+
+/* The ready bitmap has one bit for each task */
+#if (TASK_MAX_NUM > 32)
+#error "The bare metal scheduler supports at most 32 tasks"
+#endif
+
 /************************************************************************************
 *************************************************************************************
 * Private type definitions
@@ -91,6 +106,8 @@ typedef struct osObjectInfo_tag
     void* pHeap;
     uint32_t objectStructSize;
     uint32_t objNo;
+    uint32_t* pAllocMap;
+    uint32_t objectStructRecip;
 }osObjectInfo_t;
 
 
@@ -103,6 +120,7 @@ typedef struct osObjectInfo_tag
 static void* osObjectAlloc(const osObjectInfo_t* pOsObjectInfo);
 static bool_t osObjectIsAllocated(const osObjectInfo_t* pOsObjectInfo, void* pObjectStruct);
 static void osObjectFree(const osObjectInfo_t* pOsObjectInfo, void* pObjectStruct);
+static uint32_t osObjectGetIndex(const osObjectInfo_t* pOsObjectInfo, void* pObjectStruct);
 #endif
 
 extern void main_task(void *argument);
@@ -112,6 +130,19 @@ __WEAK_FUNC uint32_t OSA_TimeDiff(uint32_t time_start, uint32_t time_end);
 osaStatus_t OSA_Init(void);
 void OSA_Start(void);
 static void OSA_InsertTaskBefore(task_handler_t newTCB, task_handler_t currentTCB);
+static void OSA_TaskSetReady(task_handler_t handler, bool_t ready);
+#if (TASK_MAX_NUM > 0)
+static void OSA_TaskRankUpdate(void);
+static void OSA_TaskSetWaiting(volatile uint32_t *pWaitingTasks);
+static void OSA_TaskWakeWaiting(volatile uint32_t *pWaitingTasks);
+#endif
+#if (TASK_MAX_NUM > 0) || osObjectAlloc_c
+static uint32_t OSA_FindFirstSet(uint32_t value);
+#endif
+__WEAK_FUNC void OSA_SchedulerIdle(void);
+#if gOsaBmTaskStats_d
+__WEAK_FUNC uint32_t OSA_TaskStatsTimeGet(void);
+#endif
 
 /*! *********************************************************************************
 *************************************************************************************
@@ -132,22 +163,30 @@ list_t threadList;
 
 #if osNumberOfSemaphores
 osSemaphoreStruct_t osSemaphoreHeap[osNumberOfSemaphores];
-const osObjectInfo_t osSemaphoreInfo = {osSemaphoreHeap, sizeof(osSemaphoreStruct_t),osNumberOfSemaphores};
+static uint32_t osSemaphoreAllocMap[osObjectMapWords_c(osNumberOfSemaphores)];
+osObjectHeapCheck_c(osSemaphoreHeap);
+const osObjectInfo_t osSemaphoreInfo = {osSemaphoreHeap, sizeof(osSemaphoreStruct_t),osNumberOfSemaphores, osSemaphoreAllocMap, osObjectRecip_c(sizeof(osSemaphoreStruct_t))};
 #endif
 
 #if osNumberOfMutexes
 osMutexStruct_t osMutexHeap[osNumberOfMutexes];
-const osObjectInfo_t osMutexInfo = {osMutexHeap, sizeof(osMutexStruct_t),osNumberOfMutexes};
+static uint32_t osMutexAllocMap[osObjectMapWords_c(osNumberOfMutexes)];
+osObjectHeapCheck_c(osMutexHeap);
+const osObjectInfo_t osMutexInfo = {osMutexHeap, sizeof(osMutexStruct_t),osNumberOfMutexes, osMutexAllocMap, osObjectRecip_c(sizeof(osMutexStruct_t))};
 #endif
 
 #if osNumberOfEvents
 osEventStruct_t osEventHeap[osNumberOfEvents];
-const osObjectInfo_t osEventInfo = {osEventHeap, sizeof(osEventStruct_t),osNumberOfEvents};
+static uint32_t osEventAllocMap[osObjectMapWords_c(osNumberOfEvents)];
+osObjectHeapCheck_c(osEventHeap);
+const osObjectInfo_t osEventInfo = {osEventHeap, sizeof(osEventStruct_t),osNumberOfEvents, osEventAllocMap, osObjectRecip_c(sizeof(osEventStruct_t))};
 #endif
 
 #if osNumberOfMessageQs
 osMsgQStruct_t osMsgQHeap[osNumberOfMessageQs];
-const osObjectInfo_t osMsgQInfo = {osMsgQHeap, sizeof(osMsgQStruct_t),osNumberOfMessageQs};
+static uint32_t osMsgQAllocMap[osObjectMapWords_c(osNumberOfMessageQs)];
+osObjectHeapCheck_c(osMsgQHeap);
+const osObjectInfo_t osMsgQInfo = {osMsgQHeap, sizeof(osMsgQStruct_t),osNumberOfMessageQs, osMsgQAllocMap, osObjectRecip_c(sizeof(osMsgQStruct_t))};
 #endif
 
 #if (TASK_MAX_NUM > 0)
@@ -169,6 +208,23 @@ static task_control_block_t *g_freeTaskControlBlock;
 
 /* Head node of task list, all tasks will be linked to this head node. */
 static task_control_block_t *p_taskListHead = NULL;
+
+/*
+ * The tasks are ranked by their position in the task list, rank 0 having the
+ * highest priority. Bit n of g_readyTasks is set if the task of rank n has to run.
+ */
+static volatile uint32_t g_readyTasks;
+static task_handler_t g_rankTask[TASK_MAX_NUM];
+
+/* Ranks of the tasks having the same priority as the task of rank n. */
+static uint32_t g_rankGroup[TASK_MAX_NUM];
+
+/* Ranks already run in the current round of each group. */
+static uint32_t g_roundRobinDone;
+
+#if gOsaBmTaskStats_d
+static uint32_t g_idleCount;
+#endif
 #endif
 uint32_t gInterruptDisableCount = 0;
 uint32_t gTickCounter = 0;
@@ -295,6 +351,10 @@ osaStatus_t OSA_TaskSetPriority(osaTaskId_t taskId, osaTaskPriority_t taskPriori
             p = p->next;
         }
     }
+
+    OSA_DisableIRQGlobal();
+    OSA_TaskRankUpdate();
+    OSA_EnableIRQGlobal();
     
     return osaStatus_Success;
 }
@@ -346,6 +406,11 @@ osaTaskId_t OSA_TaskCreate(osaThreadDef_t *thread_def,osaTaskParam_t task_param)
         p_newTaskControlBlock->haveToRun = true;
         p_newTaskControlBlock->priority = PRIORITY_OSA_TO_RTOS(thread_def->tpriority);
         p_newTaskControlBlock->param  = task_param;
+        p_newTaskControlBlock->readyMask = 0;
+#if gOsaBmTaskStats_d
+        p_newTaskControlBlock->runCount = 0;
+        p_newTaskControlBlock->runTime = 0;
+#endif
         p_newTaskControlBlock->next = NULL;
         p_newTaskControlBlock->prev = NULL;                             
         
@@ -379,6 +444,11 @@ osaTaskId_t OSA_TaskCreate(osaThreadDef_t *thread_def,osaTaskParam_t task_param)
             }        
             
         }     
+
+        OSA_DisableIRQGlobal();
+        OSA_TaskRankUpdate();
+        OSA_EnableIRQGlobal();
+
         /* Task handler is pointer of task control block. */
         taskId = (osaTaskId_t)p_newTaskControlBlock;
     }
@@ -404,20 +474,22 @@ osaStatus_t OSA_TaskDestroy(osaTaskId_t taskId)
   }
   handler = (task_handler_t)taskId;
   
+  OSA_DisableIRQGlobal();
   /* Remove task control block from task list. */
   handler->prev->next = handler->next;
   handler->next->prev = handler->prev;
-  
-  /*
-  * If current task is destroyed, then g_curTask will point to the previous
-  * task, so that the subsequent tasks could be called. Check the function
-  * OSA_Start for more details.
-  */
-  if (handler == g_curTask)
+
+  if (handler == p_taskListHead)
   {
-    g_curTask = handler->prev;
+    p_taskListHead = (handler->next == handler) ? NULL : handler->next;
   }
   
+  /* A destroyed task is never signaled again. */
+  handler->haveToRun = false;
+  OSA_TaskRankUpdate();
+  handler->readyMask = 0;
+  OSA_EnableIRQGlobal();
+  
   /* Put task control block back to pool. */
   handler->prev = NULL;
   handler->next = g_freeTaskControlBlock;
@@ -518,6 +590,7 @@ osaSemaphoreId_t OSA_SemaphoreCreate(uint32_t initValue)
   pSemStruct->semaphore.isWaiting = false;
   pSemStruct->semaphore.time_start = 0u;
   pSemStruct->semaphore.timeout = 0u;
+  pSemStruct->semaphore.waitingTasks = 0;
 
   return semId;
 #else 
@@ -613,6 +686,16 @@ osaStatus_t OSA_SemaphoreWait(osaSemaphoreId_t semId, uint32_t millisec)
             pSemStruct->semaphore.timeout = millisec;
         }
 #endif
+        else
+        {
+            /* Run the task again when the semaphore is posted */
+            OSA_DisableIRQGlobal();
+            if (0 == pSemStruct->semaphore.semCount)
+            {
+                OSA_TaskSetWaiting(&pSemStruct->semaphore.waitingTasks);
+            }
+            OSA_EnableIRQGlobal();
+        }
     }
 
     return osaStatus_Idle;
@@ -625,8 +708,9 @@ osaStatus_t OSA_SemaphoreWait(osaSemaphoreId_t semId, uint32_t millisec)
 /*FUNCTION**********************************************************************
  *
  * Function Name : OSA_SemaphorePost
- * Description   : This function is used to wake up one task that wating on the
- * semaphore. If no task is waiting, increase the semaphore. The function returns
+ * Description   : This function increases the semaphore, and runs again all the
+ * tasks waiting on it: each one calls OSA_SemaphoreWait() again, the first ones
+ * take the count and the others wait again. The function returns
  * osaStatus_Success if the semaphre is post successfully, otherwise returns
  * osaStatus_Error.
  *
@@ -647,6 +731,7 @@ osaStatus_t OSA_SemaphorePost(osaSemaphoreId_t semId)
   }
   OSA_DisableIRQGlobal();
   ++pSemStruct->semaphore.semCount;
+  OSA_TaskWakeWaiting(&pSemStruct->semaphore.waitingTasks);
   OSA_EnableIRQGlobal();
   
   return osaStatus_Success;
@@ -858,7 +943,7 @@ osaStatus_t OSA_EventSet(osaEventId_t eventId, osaEventFlags_t flagsToSet)
   pEventStruct->event.flags |= flagsToSet;
   if (pEventStruct->event.waitingTask != NULL)
   {
-    pEventStruct->event.waitingTask->haveToRun = true;
+    OSA_TaskSetReady(pEventStruct->event.waitingTask, true);
   }
   OSA_EnableIRQGlobal();
   
@@ -892,7 +977,7 @@ osaStatus_t OSA_EventClear(osaEventId_t eventId, osaEventFlags_t flagsToClear)
   {
     if (pEventStruct->event.waitingTask != NULL)
     {
-      pEventStruct->event.waitingTask->haveToRun = true;
+      OSA_TaskSetReady(pEventStruct->event.waitingTask, true);
     }
   }
   OSA_EnableIRQGlobal();
@@ -982,7 +1067,7 @@ osaStatus_t OSA_EventWait(osaEventId_t eventId, osaEventFlags_t flagsToWait, boo
 #endif
         else
         {
-            pEventStruct->event.waitingTask->haveToRun = false;
+            OSA_TaskSetReady(pEventStruct->event.waitingTask, false);
         }
     }
 
@@ -1099,7 +1184,7 @@ osaStatus_t OSA_MsgQPut(osaMsgQId_t msgQId, void* pMessage)
 
             if( pQueue->waitingTask )
             {
-                pQueue->waitingTask->haveToRun = 1;
+                OSA_TaskSetReady(pQueue->waitingTask, true);
             }
         }
         OSA_EnableIRQGlobal();
@@ -1185,7 +1270,7 @@ osaStatus_t OSA_MsgQGet(osaMsgQId_t msgQId, void *pMessage, uint32_t millisec)
 #endif
             else
             {
-                pQueue->waitingTask->haveToRun = 0;
+                OSA_TaskSetReady(pQueue->waitingTask, false);
             }
         }
         OSA_EnableIRQGlobal();
@@ -1220,14 +1305,14 @@ osaStatus_t OSA_MsgQDestroy(osaMsgQId_t msgQId)
     else
     {
         pQueue = &((osMsgQStruct_t*)msgQId)->queue;
-        
+
+        OSA_InterruptDisable();
         if( pQueue->waitingTask )
         {
-            pQueue->waitingTask->haveToRun = 1;
+            OSA_TaskSetReady(pQueue->waitingTask, true);
             pQueue->waitingTask = NULL;
         }
 
-        OSA_InterruptDisable();
         osObjectFree(&osMsgQInfo, msgQId);
         OSA_InterruptEnable();      
     }
@@ -1247,6 +1332,7 @@ osaStatus_t OSA_MsgQDestroy(osaMsgQId_t msgQId)
  *END**************************************************************************/
 void OSA_InterruptEnable(void)
 {
+    PROFILER_IRQ_MASK_END();
     OSA_EnableIRQGlobal();
 } 
 /*FUNCTION**********************************************************************
@@ -1258,6 +1344,7 @@ void OSA_InterruptEnable(void)
 void OSA_InterruptDisable(void)
 {
     OSA_DisableIRQGlobal();
+    PROFILER_IRQ_MASK_START();
 }
 
 /*FUNCTION**********************************************************************
@@ -1309,23 +1396,36 @@ int main (void)
 *
 * \post
 *
-* \remarks Function is unprotected from interrupts. 
+* \remarks Function is unprotected from interrupts. The first free object is
+* found in the allocation bitmap, one word at a time.
 *
 ********************************************************************************** */
 #if osObjectAlloc_c
 static void* osObjectAlloc(const osObjectInfo_t* pOsObjectInfo)
 {
   uint32_t i;
-  uint8_t* pObj = (uint8_t*)pOsObjectInfo->pHeap;
-  for( i=0 ; i < pOsObjectInfo->objNo ; i++)
+  uint32_t index;
+  uint32_t freeBits;
+  osObjStruct_t* pObj;
+  
+  for( i=0 ; i < osObjectMapWords_c(pOsObjectInfo->objNo) ; i++)
   {
-      if(((osObjStruct_t*)pObj)->inUse == 0)
+      freeBits = ~pOsObjectInfo->pAllocMap[i];
+      
+      if(freeBits)
       {
-          ((osObjStruct_t*)pObj)->inUse = 1;
+          index = (i << 5) + OSA_FindFirstSet(freeBits);
+          
+          if(index >= pOsObjectInfo->objNo)
+          {
+              break;
+          }
+          
+          pOsObjectInfo->pAllocMap[i] |= 1U << (index & 0x1F);
+          pObj = (osObjStruct_t*)((uint8_t*)pOsObjectInfo->pHeap + index * pOsObjectInfo->objectStructSize);
+          pObj->inUse = 1;
           return (void*)pObj;
       }
-      
-      pObj += pOsObjectInfo->objectStructSize;
   }
   return NULL;
 }
@@ -1341,25 +1441,22 @@ static void* osObjectAlloc(const osObjectInfo_t* pOsObjectInfo)
 *
 * \post
 *
-* \remarks Function is unprotected from interrupts. 
+* \remarks Function is unprotected from interrupts. The handle is checked
+* against the bounds and the stride of the heap, so the cost does not depend
+* on the number of objects.
 *
 ********************************************************************************** */
 #if osObjectAlloc_c
 static bool_t osObjectIsAllocated(const osObjectInfo_t* pOsObjectInfo, void* pObjectStruct)
 {
-    uint32_t i;
-    uint8_t* pObj = (uint8_t*)pOsObjectInfo->pHeap;
-    for( i=0 ; i < pOsObjectInfo->objNo ; i++)
+    if( osObjectGetIndex(pOsObjectInfo, pObjectStruct) >= pOsObjectInfo->objNo )
     {
-        if(pObj == pObjectStruct)
-        {
-            if(((osObjStruct_t*)pObj)->inUse)
-            {
-                return TRUE;
-            }
-            break;
-        }
-        pObj += pOsObjectInfo->objectStructSize;
+        return FALSE;
+    }
+    
+    if(((osObjStruct_t*)pObjectStruct)->inUse)
+    {
+        return TRUE;
     }
     return FALSE;
 }
@@ -1382,21 +1479,54 @@ static bool_t osObjectIsAllocated(const osObjectInfo_t* pOsObjectInfo, void* pOb
 #if osObjectAlloc_c
 static void osObjectFree(const osObjectInfo_t* pOsObjectInfo, void* pObjectStruct)
 {
-    uint32_t i;
-    uint8_t* pObj = (uint8_t*)pOsObjectInfo->pHeap;
-    for( i=0; i < pOsObjectInfo->objNo; i++ )
+    uint32_t index = osObjectGetIndex(pOsObjectInfo, pObjectStruct);
+    
+    if( index < pOsObjectInfo->objNo )
     {
-        if(pObj == pObjectStruct)
-        {
-            ((osObjStruct_t*)pObj)->inUse = 0;
-            break;
-        }
-        
-        pObj += pOsObjectInfo->objectStructSize;
+        ((osObjStruct_t*)pObjectStruct)->inUse = 0;
+        pOsObjectInfo->pAllocMap[index >> 5] &= ~(1U << (index & 0x1F));
     }
 }
 #endif
 
+/*! *********************************************************************************
+* \brief     Computes the index of an object in the osObjectHeap array.
+* \param[in] pointer to the object info struct.
+* \param[in] Pointer to the object struct.
+* \return the index of the object, or objNo if the pointer is not the start of
+* an object of the heap.
+*
+* \pre 
+*
+* \post
+*
+* \remarks The index is computed with the reciprocal of the object size, and
+* checked by multiplying it back, so no division is needed.
+*
+********************************************************************************** */
+#if osObjectAlloc_c
+static uint32_t osObjectGetIndex(const osObjectInfo_t* pOsObjectInfo, void* pObjectStruct)
+{
+    /* Handles below the heap wrap around to a large offset */
+    uintptr_t offset = (uintptr_t)pObjectStruct - (uintptr_t)pOsObjectInfo->pHeap;
+    uint32_t index;
+    
+    if( offset >= pOsObjectInfo->objectStructSize * pOsObjectInfo->objNo )
+    {
+        return pOsObjectInfo->objNo;
+    }
+    
+    index = ((uint32_t)offset * pOsObjectInfo->objectStructRecip) >> 16;
+    
+    if( index * pOsObjectInfo->objectStructSize != (uint32_t)offset )
+    {
+        return pOsObjectInfo->objNo;
+    }
+    
+    return index;
+}
+#endif
+
 /*FUNCTION**********************************************************************
  *
  * Function Name : OSA_Init
@@ -1423,23 +1553,62 @@ osaStatus_t OSA_Init(void)
 void OSA_Start(void)
 {
 #if (TASK_MAX_NUM > 0)
-    g_curTask = p_taskListHead;
+    task_handler_t task;
+    uint32_t ready;
+    uint32_t group;
+    uint32_t rank;
+#if gOsaBmTaskStats_d
+    uint32_t startTime;
+#endif
 
     for(;;)
     {
-        if(g_curTask->haveToRun)
+        OSA_DisableIRQGlobal();
+        ready = g_readyTasks;
+
+        if (0 == ready)
         {
-            if(g_curTask->p_func)
-            {
-                g_curTask->p_func(g_curTask->param);
-            }
-            /* restart from the first task */
-            g_curTask = p_taskListHead;
+            /* Interrupts are still disabled, so a task signaled by an ISR after
+               the check wakes up the core instead of being missed. */
+#if gOsaBmTaskStats_d
+            g_idleCount++;
+#endif
+            OSA_SchedulerIdle();
+            OSA_EnableIRQGlobal();
+            continue;
+        }
+
+        /* Pick the highest priority ready task. Ready tasks of the same priority
+           are run in turns. */
+        rank = OSA_FindFirstSet(ready);
+        group = ready & g_rankGroup[rank];
+
+        if (group & ~g_roundRobinDone)
+        {
+            group &= ~g_roundRobinDone;
         }
         else
         {
-            g_curTask = g_curTask->next;
+            g_roundRobinDone &= ~g_rankGroup[rank];
+        }
+
+        rank = OSA_FindFirstSet(group);
+        g_roundRobinDone |= 1U << rank;
+        task = g_rankTask[rank];
+        g_curTask = task;
+        OSA_EnableIRQGlobal();
+
+#if gOsaBmTaskStats_d
+        startTime = OSA_TaskStatsTimeGet();
+#endif
+        if(task->p_func)
+        {
+            task->p_func(task->param);
         }
+#if gOsaBmTaskStats_d
+        task->runCount++;
+        task->runTime += OSA_TaskStatsTimeGet() - startTime;
+#endif
     }
 #else
     for(;;)
@@ -1463,6 +1632,215 @@ static void OSA_InsertTaskBefore(task_handler_t newTCB, task_handler_t currentTC
     currentTCB->prev = newTCB;
 }
 
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_TaskSetReady
+ * Description   : Signals a task, or marks it as waiting. Must be called with
+ * interrupts disabled.
+ *
+ *END**************************************************************************/
+static void OSA_TaskSetReady(task_handler_t handler, bool_t ready)
+{
+    if (handler == NULL)
+    {
+        return;
+    }
+
+    handler->haveToRun = ready;
+#if (TASK_MAX_NUM > 0)
+    if (ready)
+    {
+        g_readyTasks |= handler->readyMask;
+    }
+    else
+    {
+        g_readyTasks &= ~handler->readyMask;
+    }
+#endif
+}
+
+#if (TASK_MAX_NUM > 0)
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_TaskRankUpdate
+ * Description   : Ranks the tasks by their position in the task list and
+ * rebuilds the ready bitmap. Must be called with interrupts disabled, each
+ * time the task list changes.
+ *
+ *END**************************************************************************/
+static void OSA_TaskRankUpdate(void)
+{
+    task_handler_t p = p_taskListHead;
+    uint32_t count = 0;
+    uint32_t i;
+    uint32_t j;
+
+    g_readyTasks = 0;
+    g_roundRobinDone = 0;
+
+    if (p != NULL)
+    {
+        do
+        {
+            p->readyMask = 1U << count;
+            g_rankTask[count] = p;
+
+            if (p->haveToRun)
+            {
+                g_readyTasks |= p->readyMask;
+            }
+
+            count++;
+            p = p->next;
+        } while (p != p_taskListHead);
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        g_rankGroup[i] = 0;
+
+        for (j = 0; j < count; j++)
+        {
+            if (g_rankTask[j]->priority == g_rankTask[i]->priority)
+            {
+                g_rankGroup[i] |= 1U << j;
+            }
+        }
+    }
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_TaskSetWaiting
+ * Description   : Stops running the current task until OSA_TaskWakeWaiting() is
+ * called on the same set. The set has one bit per task control block, which
+ * unlike the rank does not change when tasks are created. Must be called with
+ * interrupts disabled.
+ *
+ *END**************************************************************************/
+static void OSA_TaskSetWaiting(volatile uint32_t *pWaitingTasks)
+{
+    if (g_curTask != NULL)
+    {
+        *pWaitingTasks |= 1U << (uint32_t)(g_curTask - g_taskControlBlockPool);
+        OSA_TaskSetReady(g_curTask, false);
+    }
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_TaskWakeWaiting
+ * Description   : Runs again every task of the set, and empties it. Must be
+ * called with interrupts disabled.
+ *
+ *END**************************************************************************/
+static void OSA_TaskWakeWaiting(volatile uint32_t *pWaitingTasks)
+{
+    uint32_t waiting = *pWaitingTasks;
+
+    *pWaitingTasks = 0;
+
+    while (waiting)
+    {
+        OSA_TaskSetReady(&g_taskControlBlockPool[OSA_FindFirstSet(waiting)], true);
+        waiting &= waiting - 1U;
+    }
+}
+#endif
+
+#if (TASK_MAX_NUM > 0) || osObjectAlloc_c
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_FindFirstSet
+ * Description   : Returns the index of the least significant bit set. The
+ * Cortex-M0+ has no CLZ instruction, so a de Bruijn sequence is used.
+ *
+ *END**************************************************************************/
+static uint32_t OSA_FindFirstSet(uint32_t value)
+{
+    static const uint8_t deBruijnBitPosition[32] =
+    {
+        0,  1,  28, 2,  29, 14, 24, 3,  30, 22, 20, 15, 25, 17, 4,  8,
+        31, 27, 13, 23, 21, 19, 16, 7,  26, 12, 18, 6,  11, 5,  10, 9
+    };
+
+    return deBruijnBitPosition[((value & (0U - value)) * 0x077CB531U) >> 27];
+}
+#endif
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_SchedulerIdle
+ * Description   : Called with interrupts disabled when no task has to run.
+ * WFI returns as soon as an interrupt is pending.
+ *
+ *END**************************************************************************/
+__WEAK_FUNC void OSA_SchedulerIdle(void)
+{
+    __WFI();
+}
+
+#if gOsaBmTaskStats_d
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_TaskStatsTimeGet
+ * Description   : Returns the time base of the task statistics, in core clock
+ * cycles if the SYSTICK is used.
+ *
+ *END**************************************************************************/
+__WEAK_FUNC uint32_t OSA_TaskStatsTimeGet(void)
+{
+#if (FSL_OSA_BM_TIMER_CONFIG != FSL_OSA_BM_TIMER_NONE)
+    uint32_t ticks;
+    uint32_t count;
+
+    do
+    {
+        ticks = gTickCounter;
+        count = SysTick->VAL;
+    } while (ticks != gTickCounter);
+
+    return ticks * (SysTick->LOAD + 1U) + (SysTick->LOAD - count);
+#else
+    return OSA_TimeGetMsec();
+#endif
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_TaskGetStats
+ * Description   : Gets the number of runs and the cumulative run time of a task.
+ *
+ *END**************************************************************************/
+osaStatus_t OSA_TaskGetStats(osaTaskId_t taskId, uint32_t *pRunCount, uint32_t *pRunTime)
+{
+    task_handler_t handler = (task_handler_t)taskId;
+
+    if ((handler == NULL) || (pRunCount == NULL) || (pRunTime == NULL))
+    {
+        return osaStatus_Error;
+    }
+
+    OSA_DisableIRQGlobal();
+    *pRunCount = handler->runCount;
+    *pRunTime = handler->runTime;
+    OSA_EnableIRQGlobal();
+
+    return osaStatus_Success;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_SchedulerGetIdleCount
+ * Description   : Gets the number of times the scheduler found no task to run.
+ *
+ *END**************************************************************************/
+uint32_t OSA_SchedulerGetIdleCount(void)
+{
+    return g_idleCount;
+}
+#endif
+
 
 /*FUNCTION**********************************************************************
  *
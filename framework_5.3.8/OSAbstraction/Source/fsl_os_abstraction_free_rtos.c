@@ -22,6 +22,7 @@
 #include "GenericList.h"
 #include "fsl_common.h"
 #include "Panic.h"
+#include "Profiler.h"
 /*! *********************************************************************************
 *************************************************************************************
 * Private macros
@@ -908,6 +909,7 @@ osaStatus_t OSA_MsgQDestroy(osaMsgQId_t msgQId)
  *END**************************************************************************/
 void OSA_InterruptEnable(void)
 {
+  PROFILER_IRQ_MASK_END();
   if (__get_IPSR())
   {
     if(g_base_priority_top)
@@ -944,7 +946,7 @@ void OSA_InterruptDisable(void)
   {
     portENTER_CRITICAL();
   }
-  
+  PROFILER_IRQ_MASK_START();
 }
 
 uint32_t gInterruptDisableCount = 0;
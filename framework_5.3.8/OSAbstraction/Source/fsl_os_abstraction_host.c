@@ -0,0 +1,1200 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* This is the source file for the OS Abstraction layer for the Host platform. The
+* tasks are POSIX threads, and the OSA objects are built on one mutex and one
+* condition variable per object.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "EmbeddedTypes.h"
+#include "fsl_os_abstraction.h"
+#include "fsl_os_abstraction_host.h"
+#include "fsl_common.h"
+#include "Host.h"
+#include "Profiler.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+********************************************************************************** */
+
+#if (osNumberOfSemaphores || osNumberOfMutexes || osNumberOfEvents || osNumberOfMessageQs)
+#define osObjectAlloc_c 1
+#else
+#define osObjectAlloc_c 0
+#endif
+
+/* Same limit as the FreeRTOS counting semaphores */
+#define osSemaphoreMaxCount_c (0xFF)
+
+/************************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+************************************************************************************/
+
+typedef struct osSemaphoreStruct_tag
+{
+    uint32_t inUse;
+    semaphore_t semaphore;
+}osSemaphoreStruct_t;
+
+typedef struct osMutexStruct_tag
+{
+    uint32_t inUse;
+    mutex_t mutex;
+}osMutexStruct_t;
+
+typedef struct osEventStruct_tag
+{
+    uint32_t inUse;
+    event_t event;
+}osEventStruct_t;
+
+typedef struct osMsgQStruct_tag
+{
+    uint32_t inUse;
+    msg_queue_t queue;
+}osMsgQStruct_t;
+
+typedef struct osObjStruct_tag
+{
+    uint32_t inUse;
+    uint32_t osObj;
+}osObjStruct_t;
+
+typedef struct osObjectInfo_tag
+{
+    void* pHeap;
+    uint32_t objectStructSize;
+    uint32_t objNo;
+} osObjectInfo_t;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+********************************************************************************** */
+#if osObjectAlloc_c
+static void* osObjectAlloc(const osObjectInfo_t* pOsObjectInfo);
+static bool_t osObjectIsAllocated(const osObjectInfo_t* pOsObjectInfo, void* pObjectStruct);
+static void osObjectFree(const osObjectInfo_t* pOsObjectInfo, void* pObjectStruct);
+static void osCondInit(pthread_cond_t *pCond);
+static void osDeadline(struct timespec *pDeadline, uint32_t millisec);
+static osaStatus_t osWait(pthread_cond_t *pCond, uint32_t millisec, const struct timespec *pDeadline);
+#endif
+static void* osTaskStart(void *pParam);
+extern void main_task(void const *argument);
+extern void hardware_init(void);
+void startup_task(void* argument);
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public memory declarations
+*************************************************************************************
+********************************************************************************** */
+const uint8_t gUseRtos_c = USE_RTOS;  // USE_RTOS = 0 for BareMetal and 1 for OS
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+********************************************************************************** */
+
+/* Protects the tasks and the objects. Taken after PRIMASK, never before. */
+static pthread_mutex_t osLock = PTHREAD_MUTEX_INITIALIZER;
+
+static task_control_block_t osTaskHeap[gOsaHostMaxTasks_c];
+static __thread task_handler_t osCurrentTask;
+
+#if osNumberOfSemaphores
+osSemaphoreStruct_t osSemaphoreHeap[osNumberOfSemaphores];
+const osObjectInfo_t osSemaphoreInfo = {osSemaphoreHeap, sizeof(osSemaphoreStruct_t),osNumberOfSemaphores};
+#endif
+
+#if osNumberOfMutexes
+osMutexStruct_t osMutexHeap[osNumberOfMutexes];
+const osObjectInfo_t osMutexInfo = {osMutexHeap, sizeof(osMutexStruct_t),osNumberOfMutexes};
+#endif
+
+#if osNumberOfEvents
+osEventStruct_t osEventHeap[osNumberOfEvents];
+const osObjectInfo_t osEventInfo = {osEventHeap, sizeof(osEventStruct_t),osNumberOfEvents};
+#endif
+
+#if osNumberOfMessageQs
+osMsgQStruct_t osMsgQHeap[osNumberOfMessageQs];
+const osObjectInfo_t osMsgQInfo = {osMsgQHeap, sizeof(osMsgQStruct_t),osNumberOfMessageQs};
+#endif
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : startup_task
+ * Description   : Wrapper over main_task..
+ *
+ *END**************************************************************************/
+void startup_task(void* argument)
+{
+    main_task(argument);
+    while(1)
+    {
+        (void)pause();
+    }
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_TaskGetId
+ * Description   : This function is used to get current active task's handler.
+ * Threads which are not tasks, like the interrupt handlers, get NULL.
+ *
+ *END**************************************************************************/
+osaTaskId_t OSA_TaskGetId(void)
+{
+    return (osaTaskId_t)osCurrentTask;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_TaskYield
+ * Description   : When a task calls this function, it will give up CPU and put
+ * itself to the tail of ready list.
+ *
+ *END**************************************************************************/
+osaStatus_t OSA_TaskYield(void)
+{
+    (void)sched_yield();
+    return osaStatus_Success;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_TaskGetPriority
+ * Description   : This function returns task's priority by task handler.
+ *
+ *END**************************************************************************/
+osaTaskPriority_t OSA_TaskGetPriority(osaTaskId_t taskId)
+{
+    task_handler_t handler = (task_handler_t)taskId;
+
+    return handler ? handler->priority : 0;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_TaskSetPriority
+ * Description   : This function sets task's priority by task handler. The
+ * priority is kept, but the host scheduler does not use it.
+ *
+ *END**************************************************************************/
+osaStatus_t OSA_TaskSetPriority(osaTaskId_t taskId, osaTaskPriority_t taskPriority)
+{
+    task_handler_t handler = (task_handler_t)taskId;
+
+    if( !handler )
+    {
+        return osaStatus_Error;
+    }
+
+    handler->priority = taskPriority;
+    return osaStatus_Success;
+}
+
+/*FUNCTION**********************************************************************
+*
+* Function Name : OSA_TaskCreate
+* Description   : This function is used to create a task and make it ready.
+* Param[in]     :  threadDef  - Definition of the thread.
+*                  task_param - Parameter to pass to the new thread.
+* Return Thread handle of the new thread, or NULL if failed.
+*
+*END**************************************************************************/
+osaTaskId_t OSA_TaskCreate(osaThreadDef_t *thread_def, osaTaskParam_t task_param)
+{
+    task_handler_t handler = NULL;
+    uint32_t i;
+
+    (void)pthread_mutex_lock(&osLock);
+    for( i = 0; i < gOsaHostMaxTasks_c; i++ )
+    {
+        if( !osTaskHeap[i].inUse )
+        {
+            handler = &osTaskHeap[i];
+            handler->inUse = TRUE;
+            handler->p_func = thread_def->pthread;
+            handler->param = task_param;
+            handler->priority = (osaTaskPriority_t)thread_def->tpriority;
+            handler->pThreadDef = thread_def;
+            break;
+        }
+    }
+    (void)pthread_mutex_unlock(&osLock);
+
+    if( handler && !Host_ThreadCreate(osTaskStart, handler, thread_def->stacksize) )
+    {
+        handler->inUse = FALSE;
+        handler = NULL;
+    }
+
+    return (osaTaskId_t)handler;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_TaskDestroy
+ * Description   : This function destroy a task. A thread cannot be stopped
+ * safely by another one, so a task can only destroy itself.
+ * Param[in]     :taskId - Thread handle.
+ * Return osaStatus_Success if the task is destroied, otherwise return osaStatus_Error.
+ *
+ *END**************************************************************************/
+osaStatus_t OSA_TaskDestroy(osaTaskId_t taskId)
+{
+    task_handler_t handler = (task_handler_t)taskId;
+
+    if( !handler || (handler != osCurrentTask) )
+    {
+        return osaStatus_Error;
+    }
+
+    handler->inUse = FALSE;
+    pthread_exit(NULL);
+
+    return osaStatus_Success;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_TimeDelay
+ * Description   : This function is used to suspend the active thread for the given number of milliseconds.
+ *
+ *END**************************************************************************/
+void OSA_TimeDelay(uint32_t millisec)
+{
+    struct timespec delay;
+
+    delay.tv_sec = millisec / 1000;
+    delay.tv_nsec = (long)(millisec % 1000) * 1000000L;
+
+    while( (nanosleep(&delay, &delay) != 0) && (errno == EINTR) )
+    {
+    }
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_TimeGetMsec
+ * Description   : This function gets current time in milliseconds.
+ *
+ *END**************************************************************************/
+uint32_t OSA_TimeGetMsec(void)
+{
+    return (uint32_t)(Host_GetTimeUs() / 1000U);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_SemaphoreCreate
+ * Description   : This function is used to create a semaphore.
+ * Return         : Semaphore handle of the new semaphore, or NULL if failed.
+ *
+ *END**************************************************************************/
+osaSemaphoreId_t OSA_SemaphoreCreate(uint32_t initValue)
+{
+#if osNumberOfSemaphores
+    osSemaphoreStruct_t* pSemStruct;
+
+    (void)pthread_mutex_lock(&osLock);
+    pSemStruct = osObjectAlloc(&osSemaphoreInfo);
+    (void)pthread_mutex_unlock(&osLock);
+
+    if( pSemStruct )
+    {
+        osCondInit(&pSemStruct->semaphore.cond);
+        pSemStruct->semaphore.semCount = (uint8_t)initValue;
+    }
+
+    return (osaSemaphoreId_t)pSemStruct;
+#else
+    (void)initValue;
+    return NULL;
+#endif
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_SemaphoreDestroy
+ * Description   : This function is used to destroy a semaphore.
+ * Return        : osaStatus_Success if the semaphore is destroyed successfully, otherwise return osaStatus_Error.
+ *
+ *END**************************************************************************/
+osaStatus_t OSA_SemaphoreDestroy(osaSemaphoreId_t semId)
+{
+#if osNumberOfSemaphores
+    osaStatus_t status = osaStatus_Error;
+
+    (void)pthread_mutex_lock(&osLock);
+    if( osObjectIsAllocated(&osSemaphoreInfo, semId) )
+    {
+        (void)pthread_cond_destroy(&((osSemaphoreStruct_t*)semId)->semaphore.cond);
+        osObjectFree(&osSemaphoreInfo, semId);
+        status = osaStatus_Success;
+    }
+    (void)pthread_mutex_unlock(&osLock);
+
+    return status;
+#else
+    (void)semId;
+    return osaStatus_Error;
+#endif
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_SemaphoreWait
+ * Description   : This function checks the semaphore's counting value, if it is
+ * positive, decreases it and returns osaStatus_Success, otherwise, timeout
+ * will be used for wait. The parameter timeout indicates how long should wait
+ * in milliseconds. Pass osaWaitForever_c to wait indefinitely, pass 0 will
+ * return osaStatus_Timeout immediately if semaphore is not positive.
+ * This function returns osaStatus_Success if the semaphore is received, returns
+ * osaStatus_Timeout if the semaphore is not received within the specified
+ * 'timeout', returns osaStatus_Error if any errors occur during waiting.
+ *
+ *END**************************************************************************/
+osaStatus_t OSA_SemaphoreWait(osaSemaphoreId_t semId, uint32_t millisec)
+{
+#if osNumberOfSemaphores
+    osaStatus_t status = osaStatus_Success;
+    semaphore_t* pSem;
+    struct timespec deadline;
+
+    osDeadline(&deadline, millisec);
+    (void)pthread_mutex_lock(&osLock);
+
+    if( !osObjectIsAllocated(&osSemaphoreInfo, semId) )
+    {
+        status = osaStatus_Error;
+    }
+    else
+    {
+        pSem = &((osSemaphoreStruct_t*)semId)->semaphore;
+
+        while( (0 == pSem->semCount) && (osaStatus_Success == status) )
+        {
+            status = osWait(&pSem->cond, millisec, &deadline);
+        }
+
+        if( osaStatus_Success == status )
+        {
+            pSem->semCount--;
+        }
+    }
+
+    (void)pthread_mutex_unlock(&osLock);
+    return status;
+#else
+    (void)semId;
+    (void)millisec;
+    return osaStatus_Error;
+#endif
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_SemaphorePost
+ * Description   : This function is used to wake up one task that wating on the
+ * semaphore. If no task is waiting, increase the semaphore. The function returns
+ * osaStatus_Success if the semaphre is post successfully, otherwise returns
+ * osaStatus_Error.
+ *
+ *END**************************************************************************/
+osaStatus_t OSA_SemaphorePost(osaSemaphoreId_t semId)
+{
+#if osNumberOfSemaphores
+    osaStatus_t status = osaStatus_Error;
+    semaphore_t* pSem;
+
+    (void)pthread_mutex_lock(&osLock);
+    if( osObjectIsAllocated(&osSemaphoreInfo, semId) )
+    {
+        pSem = &((osSemaphoreStruct_t*)semId)->semaphore;
+
+        if( pSem->semCount < osSemaphoreMaxCount_c )
+        {
+            pSem->semCount++;
+            (void)pthread_cond_signal(&pSem->cond);
+            status = osaStatus_Success;
+        }
+    }
+    (void)pthread_mutex_unlock(&osLock);
+
+    return status;
+#else
+    (void)semId;
+    return osaStatus_Error;
+#endif
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_MutexCreate
+ * Description   : This function is used to create a mutex.
+ * Return        : Mutex handle of the new mutex, or NULL if failed.
+ *
+ *END**************************************************************************/
+osaMutexId_t OSA_MutexCreate(void)
+{
+#if osNumberOfMutexes
+    osMutexStruct_t* pMutexStruct;
+
+    (void)pthread_mutex_lock(&osLock);
+    pMutexStruct = osObjectAlloc(&osMutexInfo);
+    (void)pthread_mutex_unlock(&osLock);
+
+    if( pMutexStruct )
+    {
+        osCondInit(&pMutexStruct->mutex.cond);
+        pMutexStruct->mutex.isLocked = FALSE;
+    }
+
+    return (osaMutexId_t)pMutexStruct;
+#else
+    return NULL;
+#endif
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_MutexLock
+ * Description   : This function checks the mutex's status, if it is unlocked,
+ * lock it and returns osaStatus_Success, otherwise, wait for the mutex.
+ * This function returns osaStatus_Success if the mutex is obtained, returns
+ * osaStatus_Error if any errors occur during waiting. If the mutex has been
+ * locked, pass 0 as timeout will return osaStatus_Timeout immediately.
+ *
+ *END**************************************************************************/
+osaStatus_t OSA_MutexLock(osaMutexId_t mutexId, uint32_t millisec)
+{
+#if osNumberOfMutexes
+    osaStatus_t status = osaStatus_Success;
+    mutex_t* pMutex;
+    struct timespec deadline;
+
+    osDeadline(&deadline, millisec);
+    (void)pthread_mutex_lock(&osLock);
+
+    if( !osObjectIsAllocated(&osMutexInfo, mutexId) )
+    {
+        status = osaStatus_Error;
+    }
+    else
+    {
+        pMutex = &((osMutexStruct_t*)mutexId)->mutex;
+
+        /* If pMutex has been locked by current task, return error. */
+        if( pMutex->isLocked && pthread_equal(pMutex->owner, pthread_self()) )
+        {
+            status = osaStatus_Error;
+        }
+
+        while( pMutex->isLocked && (osaStatus_Success == status) )
+        {
+            status = osWait(&pMutex->cond, millisec, &deadline);
+        }
+
+        if( osaStatus_Success == status )
+        {
+            pMutex->isLocked = TRUE;
+            pMutex->owner = pthread_self();
+        }
+    }
+
+    (void)pthread_mutex_unlock(&osLock);
+    return status;
+#else
+    (void)mutexId;
+    (void)millisec;
+    return osaStatus_Error;
+#endif
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_MutexUnlock
+ * Description   : This function is used to unlock a mutex.
+ *
+ *END**************************************************************************/
+osaStatus_t OSA_MutexUnlock(osaMutexId_t mutexId)
+{
+#if osNumberOfMutexes
+    osaStatus_t status = osaStatus_Error;
+    mutex_t* pMutex;
+
+    (void)pthread_mutex_lock(&osLock);
+    if( osObjectIsAllocated(&osMutexInfo, mutexId) )
+    {
+        pMutex = &((osMutexStruct_t*)mutexId)->mutex;
+
+        /* If pMutex is not locked by current task, return error. */
+        if( pMutex->isLocked && pthread_equal(pMutex->owner, pthread_self()) )
+        {
+            pMutex->isLocked = FALSE;
+            (void)pthread_cond_signal(&pMutex->cond);
+            status = osaStatus_Success;
+        }
+    }
+    (void)pthread_mutex_unlock(&osLock);
+
+    return status;
+#else
+    (void)mutexId;
+    return osaStatus_Error;
+#endif
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_MutexDestroy
+ * Description   : This function is used to destroy a mutex.
+ * Return        : osaStatus_Success if the lock object is destroyed successfully, otherwise return osaStatus_Error.
+ *
+ *END**************************************************************************/
+osaStatus_t OSA_MutexDestroy(osaMutexId_t mutexId)
+{
+#if osNumberOfMutexes
+    osaStatus_t status = osaStatus_Error;
+
+    (void)pthread_mutex_lock(&osLock);
+    if( osObjectIsAllocated(&osMutexInfo, mutexId) )
+    {
+        (void)pthread_cond_destroy(&((osMutexStruct_t*)mutexId)->mutex.cond);
+        osObjectFree(&osMutexInfo, mutexId);
+        status = osaStatus_Success;
+    }
+    (void)pthread_mutex_unlock(&osLock);
+
+    return status;
+#else
+    (void)mutexId;
+    return osaStatus_Error;
+#endif
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_EventCreate
+ * Description   : This function is used to create a event object.
+ * Return        : Event handle of the new event, or NULL if failed.
+ *
+ *END**************************************************************************/
+osaEventId_t OSA_EventCreate(bool_t autoClear)
+{
+#if osNumberOfEvents
+    osEventStruct_t* pEventStruct;
+
+    (void)pthread_mutex_lock(&osLock);
+    pEventStruct = osObjectAlloc(&osEventInfo);
+    (void)pthread_mutex_unlock(&osLock);
+
+    if( pEventStruct )
+    {
+        osCondInit(&pEventStruct->event.cond);
+        pEventStruct->event.flags = 0;
+        pEventStruct->event.autoClear = autoClear;
+    }
+
+    return (osaEventId_t)pEventStruct;
+#else
+    (void)autoClear;
+    return NULL;
+#endif
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_EventSet
+ * Description   : Set one or more event flags of an event object.
+ * Return        : osaStatus_Success if set successfully, osaStatus_Error if failed.
+ *
+ *END**************************************************************************/
+osaStatus_t OSA_EventSet(osaEventId_t eventId, osaEventFlags_t flagsToSet)
+{
+#if osNumberOfEvents
+    osaStatus_t status = osaStatus_Error;
+    event_t* pEvent;
+
+    (void)pthread_mutex_lock(&osLock);
+    if( osObjectIsAllocated(&osEventInfo, eventId) )
+    {
+        pEvent = &((osEventStruct_t*)eventId)->event;
+        pEvent->flags |= (event_flags_t)flagsToSet;
+        (void)pthread_cond_broadcast(&pEvent->cond);
+        status = osaStatus_Success;
+    }
+    (void)pthread_mutex_unlock(&osLock);
+
+    return status;
+#else
+    (void)eventId;
+    (void)flagsToSet;
+    return osaStatus_Error;
+#endif
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_EventClear
+ * Description   : Clear one or more event flags of an event object.
+ * Return        :osaStatus_Success if clear successfully, osaStatus_Error if failed.
+ *
+ *END**************************************************************************/
+osaStatus_t OSA_EventClear(osaEventId_t eventId, osaEventFlags_t flagsToClear)
+{
+#if osNumberOfEvents
+    osaStatus_t status = osaStatus_Error;
+
+    (void)pthread_mutex_lock(&osLock);
+    if( osObjectIsAllocated(&osEventInfo, eventId) )
+    {
+        ((osEventStruct_t*)eventId)->event.flags &= ~(event_flags_t)flagsToClear;
+        status = osaStatus_Success;
+    }
+    (void)pthread_mutex_unlock(&osLock);
+
+    return status;
+#else
+    (void)eventId;
+    (void)flagsToClear;
+    return osaStatus_Error;
+#endif
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_EventWait
+ * Description   : This function checks the event's status, if it meets the wait
+ * condition, return osaStatus_Success, otherwise, timeout will be used for
+ * wait. The parameter timeout indicates how long should wait in milliseconds.
+ * Pass osaWaitForever_c to wait indefinitely, pass 0 will return the value
+ * osaStatus_Timeout immediately if wait condition is not met. The event flags
+ * will be cleared if the event is auto clear mode. Flags that wakeup waiting
+ * task could be obtained from the parameter setFlags.
+ * This function returns osaStatus_Success if wait condition is met, returns
+ * osaStatus_Timeout if wait condition is not met within the specified
+ * 'timeout', returns osaStatus_Error if any errors occur during waiting.
+ *
+ *END**************************************************************************/
+osaStatus_t OSA_EventWait(osaEventId_t eventId, osaEventFlags_t flagsToWait, bool_t waitAll, uint32_t millisec, osaEventFlags_t *pSetFlags)
+{
+#if osNumberOfEvents
+    osaStatus_t status = osaStatus_Success;
+    event_t* pEvent;
+    event_flags_t flagsSave = 0;
+    struct timespec deadline;
+
+    /* Same flags as the other ports */
+    flagsToWait = flagsToWait & osaEventFlagsAll_c;
+
+    osDeadline(&deadline, millisec);
+    (void)pthread_mutex_lock(&osLock);
+
+    if( !osObjectIsAllocated(&osEventInfo, eventId) )
+    {
+        status = osaStatus_Error;
+    }
+    else
+    {
+        pEvent = &((osEventStruct_t*)eventId)->event;
+
+        while( osaStatus_Success == status )
+        {
+            flagsSave = pEvent->flags & flagsToWait;
+
+            if( waitAll ? (flagsSave == flagsToWait) : (flagsSave != 0) )
+            {
+                break;
+            }
+
+            status = osWait(&pEvent->cond, millisec, &deadline);
+        }
+
+        if( (osaStatus_Success == status) && pEvent->autoClear )
+        {
+            pEvent->flags &= ~flagsSave;
+        }
+    }
+
+    (void)pthread_mutex_unlock(&osLock);
+
+    if( pSetFlags )
+    {
+        *pSetFlags = (osaEventFlags_t)flagsSave;
+    }
+
+    return status;
+#else
+    (void)eventId;
+    (void)flagsToWait;
+    (void)waitAll;
+    (void)millisec;
+    (void)pSetFlags;
+    return osaStatus_Error;
+#endif
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_EventDestroy
+ * Description   : This function is used to destroy a event object. Return
+ * osaStatus_Success if the event object is destroyed successfully, otherwise
+ * return osaStatus_Error.
+ *
+ *END**************************************************************************/
+osaStatus_t OSA_EventDestroy(osaEventId_t eventId)
+{
+#if osNumberOfEvents
+    osaStatus_t status = osaStatus_Error;
+
+    (void)pthread_mutex_lock(&osLock);
+    if( osObjectIsAllocated(&osEventInfo, eventId) )
+    {
+        (void)pthread_cond_destroy(&((osEventStruct_t*)eventId)->event.cond);
+        osObjectFree(&osEventInfo, eventId);
+        status = osaStatus_Success;
+    }
+    (void)pthread_mutex_unlock(&osLock);
+
+    return status;
+#else
+    (void)eventId;
+    return osaStatus_Error;
+#endif
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_MsgQCreate
+ * Description   : This function is used to create a message queue.
+ * Return        : the handle to the message queue if create successfully, otherwise
+ * return NULL.
+ *
+ *END**************************************************************************/
+osaMsgQId_t OSA_MsgQCreate(uint32_t  msgNo)
+{
+#if osNumberOfMessageQs
+    osMsgQStruct_t* pMsgQStruct = NULL;
+
+    if( msgNo <= osNumberOfMessages )
+    {
+        (void)pthread_mutex_lock(&osLock);
+        pMsgQStruct = osObjectAlloc(&osMsgQInfo);
+        (void)pthread_mutex_unlock(&osLock);
+
+        if( pMsgQStruct )
+        {
+            osCondInit(&pMsgQStruct->queue.cond);
+            pMsgQStruct->queue.max = (uint16_t)msgNo;
+            pMsgQStruct->queue.number = 0;
+            pMsgQStruct->queue.head = 0;
+            pMsgQStruct->queue.tail = 0;
+        }
+    }
+
+    return (osaMsgQId_t)pMsgQStruct;
+#else
+    (void)msgNo;
+    return NULL;
+#endif
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_MsgQPut
+ * Description   : This function is used to put a message to a message queue.
+* Return         : osaStatus_Success if the message is put successfully, otherwise return osaStatus_Error.
+ *
+ *END**************************************************************************/
+osaStatus_t OSA_MsgQPut(osaMsgQId_t msgQId, void* pMessage)
+{
+#if osNumberOfMessageQs
+    osaStatus_t status = osaStatus_Error;
+    msg_queue_t* pQueue;
+
+    (void)pthread_mutex_lock(&osLock);
+    if( osObjectIsAllocated(&osMsgQInfo, msgQId) )
+    {
+        pQueue = &((osMsgQStruct_t*)msgQId)->queue;
+
+        if( pQueue->number < pQueue->max )
+        {
+            pQueue->queueMem[pQueue->tail] = *((uint32_t*)pMessage);
+            pQueue->number++;
+            pQueue->tail++;
+
+            if( pQueue->tail >= pQueue->max )
+            {
+                pQueue->tail = 0;
+            }
+
+            (void)pthread_cond_signal(&pQueue->cond);
+            status = osaStatus_Success;
+        }
+    }
+    (void)pthread_mutex_unlock(&osLock);
+
+    return status;
+#else
+    (void)msgQId;
+    (void)pMessage;
+    return osaStatus_Error;
+#endif
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_MsgQGet
+ * Description   : This function checks the queue's status, if it is not empty,
+ * get message from it and return osaStatus_Success, otherwise, timeout will
+ * be used for wait. The parameter timeout indicates how long should wait in
+ * milliseconds. Pass osaWaitForever_c to wait indefinitely, pass 0 will return
+ * osaStatus_Timeout immediately if queue is empty.
+ * This function returns osaStatus_Success if message is got successfully,
+ * returns osaStatus_Timeout if message queue is empty within the specified
+ * 'timeout', returns osaStatus_Error if any errors occur during waiting.
+ *
+ *END**************************************************************************/
+osaStatus_t OSA_MsgQGet(osaMsgQId_t msgQId, void *pMessage, uint32_t millisec)
+{
+#if osNumberOfMessageQs
+    osaStatus_t status = osaStatus_Success;
+    msg_queue_t* pQueue;
+    struct timespec deadline;
+
+    osDeadline(&deadline, millisec);
+    (void)pthread_mutex_lock(&osLock);
+
+    if( !osObjectIsAllocated(&osMsgQInfo, msgQId) )
+    {
+        status = osaStatus_Error;
+    }
+    else
+    {
+        pQueue = &((osMsgQStruct_t*)msgQId)->queue;
+
+        while( (0 == pQueue->number) && (osaStatus_Success == status) )
+        {
+            status = osWait(&pQueue->cond, millisec, &deadline);
+        }
+
+        if( osaStatus_Success == status )
+        {
+            *((uint32_t*)pMessage) = pQueue->queueMem[pQueue->head];
+            pQueue->number--;
+            pQueue->head++;
+
+            if( pQueue->head >= pQueue->max )
+            {
+                pQueue->head = 0;
+            }
+        }
+    }
+
+    (void)pthread_mutex_unlock(&osLock);
+    return status;
+#else
+    (void)msgQId;
+    (void)pMessage;
+    (void)millisec;
+    return osaStatus_Error;
+#endif
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_MsgQDestroy
+ * Description   : This function is used to destroy the message queue.
+ * Return        : osaStatus_Success if the message queue is destroyed successfully, otherwise return osaStatus_Error.
+ *
+ *END**************************************************************************/
+osaStatus_t OSA_MsgQDestroy(osaMsgQId_t msgQId)
+{
+#if osNumberOfMessageQs
+    osaStatus_t status = osaStatus_Error;
+
+    (void)pthread_mutex_lock(&osLock);
+    if( osObjectIsAllocated(&osMsgQInfo, msgQId) )
+    {
+        (void)pthread_cond_destroy(&((osMsgQStruct_t*)msgQId)->queue.cond);
+        osObjectFree(&osMsgQInfo, msgQId);
+        status = osaStatus_Success;
+    }
+    (void)pthread_mutex_unlock(&osLock);
+
+    return status;
+#else
+    (void)msgQId;
+    return osaStatus_Error;
+#endif
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_InterruptEnable
+ * Description   : self explanatory.
+ *
+ *END**************************************************************************/
+void OSA_InterruptEnable(void)
+{
+    PROFILER_IRQ_MASK_END();
+    OSA_EnableIRQGlobal();
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_InterruptDisable
+ * Description   : self explanatory.
+ *
+ *END**************************************************************************/
+void OSA_InterruptDisable(void)
+{
+    OSA_DisableIRQGlobal();
+    PROFILER_IRQ_MASK_START();
+}
+
+/* Only the thread which holds PRIMASK, or the running handler, changes the count */
+uint32_t gInterruptDisableCount = 0;
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_EnableIRQGlobal
+ * Description   : enable interrupts using PRIMASK register.
+ *
+ *END**************************************************************************/
+void OSA_EnableIRQGlobal(void)
+{
+    if (gInterruptDisableCount > 0)
+    {
+        gInterruptDisableCount--;
+
+        if (gInterruptDisableCount == 0)
+        {
+            __enable_irq();
+        }
+        /* call core API to enable the global interrupt*/
+    }
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_DisableIRQGlobal
+ * Description   : disable interrupts using PRIMASK register.
+ *
+ *END**************************************************************************/
+void OSA_DisableIRQGlobal(void)
+{
+    /* call core API to disable the global interrupt*/
+    __disable_irq();
+
+    /* update counter*/
+    gInterruptDisableCount++;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_InstallIntHandler
+ * Description   : This function is used to install interrupt handler.
+ *
+ *END**************************************************************************/
+void OSA_InstallIntHandler(uint32_t IRQNumber, void (*handler)(void))
+{
+    Host_InstallIrqHandler((int32_t)IRQNumber, handler);
+}
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+********************************************************************************** */
+OSA_TASK_DEFINE(startup_task, gMainThreadPriority_c, 1, gMainThreadStackSize_c, 0)  ;
+int main (void)
+{
+    /* Initialize the platform models */
+    hardware_init();
+    OSA_TaskCreate(OSA_TASK(startup_task), NULL);
+
+    /* The tasks run in their own threads */
+    while(1)
+    {
+        (void)pause();
+    }
+}
+
+/*! *********************************************************************************
+* \brief     Runs a task in its thread
+* \param[in] pointer to the task control block.
+*
+********************************************************************************** */
+static void* osTaskStart(void *pParam)
+{
+    osCurrentTask = (task_handler_t)pParam;
+    osCurrentTask->p_func(osCurrentTask->param);
+    osCurrentTask->inUse = FALSE;
+
+    return NULL;
+}
+
+/*! *********************************************************************************
+* \brief     Allocates a osObjectStruct_t block in the osObjectHeap array.
+* \param[in] pointer to the object info struct.
+* Object can be semaphore, mutex, message Queue, event
+* \return Pointer to the allocated osObjectStruct_t, NULL if failed.
+*
+* \remarks Called with osLock held.
+*
+********************************************************************************** */
+#if osObjectAlloc_c
+static void* osObjectAlloc(const osObjectInfo_t* pOsObjectInfo)
+{
+    uint32_t i;
+    uint8_t* pObj = (uint8_t*)pOsObjectInfo->pHeap;
+    for( i=0 ; i < pOsObjectInfo->objNo ; i++, pObj += pOsObjectInfo->objectStructSize)
+    {
+        if(((osObjStruct_t*)pObj)->inUse == 0)
+        {
+            ((osObjStruct_t*)pObj)->inUse = 1;
+            return (void*)pObj;
+        }
+    }
+    return NULL;
+}
+
+/*! *********************************************************************************
+* \brief     Verifies the object is valid and allocated in the osObjectHeap array.
+* \param[in] the pointer to the object info struct.
+* \param[in] the pointer to the object struct.
+* Object can be semaphore, mutex,  message Queue, event
+* \return TRUE if the object is valid and allocated, FALSE otherwise
+*
+* \remarks Called with osLock held.
+*
+********************************************************************************** */
+static bool_t osObjectIsAllocated(const osObjectInfo_t* pOsObjectInfo, void* pObjectStruct)
+{
+    uint32_t i;
+    uint8_t* pObj = (uint8_t*)pOsObjectInfo->pHeap;
+    for( i=0 ; i < pOsObjectInfo->objNo ; i++ , pObj += pOsObjectInfo->objectStructSize)
+    {
+        if(pObj == pObjectStruct)
+        {
+            if(((osObjStruct_t*)pObj)->inUse)
+            {
+                return TRUE;
+            }
+            break;
+        }
+    }
+    return FALSE;
+}
+
+/*! *********************************************************************************
+* \brief     Frees an osObjectStruct_t block from the osObjectHeap array.
+* \param[in] pointer to the object info struct.
+* \param[in] Pointer to the allocated osObjectStruct_t to free.
+* Object can be semaphore, mutex, message Queue, event
+* \return none.
+*
+* \remarks Called with osLock held.
+*
+********************************************************************************** */
+static void osObjectFree(const osObjectInfo_t* pOsObjectInfo, void* pObjectStruct)
+{
+    uint32_t i;
+    uint8_t* pObj = (uint8_t*)pOsObjectInfo->pHeap;
+    for( i=0; i < pOsObjectInfo->objNo; i++, pObj += pOsObjectInfo->objectStructSize )
+    {
+        if(pObj == pObjectStruct)
+        {
+            ((osObjStruct_t*)pObj)->inUse = 0;
+            break;
+        }
+    }
+}
+
+/*! *********************************************************************************
+* \brief     Initializes the condition variable of an object, on CLOCK_MONOTONIC
+*
+********************************************************************************** */
+static void osCondInit(pthread_cond_t *pCond)
+{
+    pthread_condattr_t attr;
+
+    (void)pthread_condattr_init(&attr);
+    (void)pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    (void)pthread_cond_init(pCond, &attr);
+    (void)pthread_condattr_destroy(&attr);
+}
+
+/*! *********************************************************************************
+* \brief     Computes the end of a wait of millisec milliseconds
+*
+********************************************************************************** */
+static void osDeadline(struct timespec *pDeadline, uint32_t millisec)
+{
+    (void)clock_gettime(CLOCK_MONOTONIC, pDeadline);
+
+    if( (millisec != osaWaitForever_c) && millisec )
+    {
+        pDeadline->tv_sec  += millisec / 1000;
+        pDeadline->tv_nsec += (long)(millisec % 1000) * 1000000L;
+
+        if( pDeadline->tv_nsec >= 1000000000L )
+        {
+            pDeadline->tv_nsec -= 1000000000L;
+            pDeadline->tv_sec++;
+        }
+    }
+}
+
+/*! *********************************************************************************
+* \brief     Waits for an object to be signaled, with osLock held
+* \return osaStatus_Success if signaled, osaStatus_Timeout at the deadline.
+*
+********************************************************************************** */
+static osaStatus_t osWait(pthread_cond_t *pCond, uint32_t millisec, const struct timespec *pDeadline)
+{
+    if( millisec == osaWaitForever_c )
+    {
+        (void)pthread_cond_wait(pCond, &osLock);
+    }
+    else if( (0 == millisec) ||
+             (ETIMEDOUT == pthread_cond_timedwait(pCond, &osLock, pDeadline)) )
+    {
+        return osaStatus_Timeout;
+    }
+
+    return osaStatus_Success;
+}
+#endif
@@ -38,6 +38,45 @@
 #define gOtaVerifyWrite_d                  (1)
 #endif
 
+/* CRC-CCITT implementation used by OTA_CrcCompute() */
+#define gOtaCrcBitwise_c                   (0) /* no table */
+#define gOtaCrcNibbleTable_c               (1) /* 16 entries, 32 bytes of flash */
+#define gOtaCrcByteTable_c                 (2) /* 256 entries, 512 bytes of flash */
+
+#ifndef gOtaCrcType_d
+#define gOtaCrcType_d                      (gOtaCrcByteTable_c)
+#endif
+
+/* Stage image chunks in RAM and program whole pages of the external memory
+   while the next chunks are received. The external memory is never waited for:
+   OTA_PushImageChunk() and OTA_CommitImage() return gOtaBusy_c instead, and must
+   be called again later with the same parameters. */
+#ifndef gOtaPipelinedWrite_d
+#define gOtaPipelinedWrite_d               (0)
+#endif
+
+/* Number of page buffers. When chunks arrive out of order and all buffers hold
+   incomplete pages, the oldest page is written in part. */
+#ifndef gOtaPipelineBuffers_d
+#define gOtaPipelineBuffers_d              (2)
+#endif
+
+/* Number of incomplete pages whose received bytes are tracked. Chunks which arrive
+   out of order must fall within this many pages, or the bytes of the oldest page
+   must be received again. */
+#ifndef gOtaPipelinePages_d
+#define gOtaPipelinePages_d                (8)
+#endif
+
+/* Program page size of the external memory [bytes], must be a power of 2 */
+#ifndef gOtaPipelinePageSize_d
+#if (gEepromType_d == gEepromDevice_AT45DB161E_c)
+#define gOtaPipelinePageSize_d             (512)
+#else
+#define gOtaPipelinePageSize_d             (256)
+#endif
+#endif
+
 #define gBootValueForTRUE_c                (0x00)
 #define gBootValueForFALSE_c               (0xFF)
 
@@ -106,7 +145,8 @@ typedef enum {
   gOtaInvalidOperation_c,
   gOtaExternalFlashError_c,
   gOtaInternalFlashError_c,
-  gOtaImageTooLarge_c
+  gOtaImageTooLarge_c,
+  gOtaBusy_c
 } otaResult_t;
 
 
@@ -182,6 +222,9 @@ otaResult_t OTA_StartImage(uint32_t length);
 
 /*! *********************************************************************************
 * \brief  Places the next image chunk into the external FLASH. The CRC will not be computed.
+*         With gOtaPipelinedWrite_d the chunk is staged in RAM and its page is programmed
+*         when complete, so the data may reach the external FLASH after this call returns.
+*         Chunks may arrive out of order or more than once, each byte is counted once.
 *
 * \param[in] pData          pointer to the data chunk
 * \param[in] length         the length of the data chunk
@@ -193,6 +236,8 @@ otaResult_t OTA_StartImage(uint32_t length);
 *  - gOtaInvalidParam_c: pData is NULL or the resulting image would be bigger than the 
 *       final image length specified with OTA_StartImage()
 *  - gOtaInvalidOperation_c: the process is not started
+*  - gOtaBusy_c: with gOtaPipelinedWrite_d, the external FLASH is busy and no page
+*       buffer is free. Push the same chunk again later.
 *
 ********************************************************************************** */
 otaResult_t OTA_PushImageChunk(uint8_t* pData, uint16_t length, uint32_t* pImageLength, uint32_t *pImageOffset);
@@ -207,6 +252,8 @@ otaResult_t OTA_PushImageChunk(uint8_t* pData, uint16_t length, uint32_t* pImage
 * \return
 *  - gOtaInvalidOperation_c: the process is not started,
 *  - gOtaEepromError_c: error while trying to write the EEPROM 
+*  - gOtaBusy_c: with gOtaPipelinedWrite_d, staged pages are still being written.
+*       Call it again later.
 *
 ********************************************************************************** */
 otaResult_t OTA_CommitImage(uint8_t* pBitmap);
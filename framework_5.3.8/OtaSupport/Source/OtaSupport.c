@@ -53,7 +53,23 @@ while the loading of image from external EEPROM to internal Flash is in progress
 
 #endif /* defined(__CC_ARM) */
 
+#ifndef gOtaVerifyWriteBufferSize_d
 #define gOtaVerifyWriteBufferSize_d (16) /* [bytes] */
+#endif
+
+#define mOtaPipeline_d ((gEepromType_d != gEepromDevice_None_c) && gOtaPipelinedWrite_d && \
+                        (!gEnableOTAServer_d || (gEnableOTAServer_d && gUpgradeImageOnCurrentDevice_d)))
+
+#if mOtaPipeline_d
+/* Number of external memory pages which can hold image data */
+#define mOtaPipelineMaxPages_c      ((gFlashParams_MaxImageLength_c / gOtaPipelinePageSize_d) + 2)
+#define mOtaPageAddress_d(addr)     ((addr) & ~((uint32_t)gOtaPipelinePageSize_d - 1))
+#define mOtaPageIndex_d(addr)       ((mOtaPageAddress_d(addr) - mOtaPageAddress_d(gBootData_Image_Offset_c)) / \
+                                     gOtaPipelinePageSize_d)
+#define mOtaBitIsSet_d(map, bit)    ((map)[(bit) >> 3] & (1U << ((bit) & 0x07)))
+#define mOtaBitSet_d(map, bit)      ((map)[(bit) >> 3] |= (uint8_t)(1U << ((bit) & 0x07)))
+#define mOtaNoBuffer_c              (0xFF)
+#endif
 
 
 /******************************************************************************
@@ -65,11 +81,52 @@ while the loading of image from external EEPROM to internal Flash is in progress
 static bool_t OtaSupportCalback(clientPacket_t* pData);
 #endif
 
+#if (gEepromType_d != gEepromDevice_None_c) && gOtaVerifyWrite_d
+static otaResult_t OTA_VerifyWrite(uint8_t* pData, uint16_t length, uint32_t address);
+#endif
+
+#if mOtaPipeline_d
+static void OTA_PipelineReset(void);
+static otaResult_t OTA_PipelinePush(uint8_t* pData, uint16_t length, uint32_t address);
+static otaResult_t OTA_PipelineService(bool_t flush);
+static otaResult_t OTA_PipelineFlush(void);
+#endif
+
 /******************************************************************************
 *******************************************************************************
 * Private type definitions
 *******************************************************************************
 ******************************************************************************/
+#if mOtaPipeline_d
+typedef enum
+{
+    mOtaBufferFree_c,
+    mOtaBufferFilling_c,     /* the buffer is receiving chunks */
+    mOtaBufferProgramming_c  /* the buffer is being written, the external memory may be busy */
+}otaBufferState_t;
+
+/*! A page of the image which was received in part */
+typedef struct otaPage_tag
+{
+    uint32_t address;        /* page address in the external memory */
+    uint32_t age;            /* order in which the pages were opened */
+    uint16_t covered;        /* bytes of the page received so far */
+    uint16_t required;       /* bytes of the page which belong to the image, 0 if unused */
+    uint8_t  buffer;         /* staging buffer receiving the page, mOtaNoBuffer_c if none */
+    uint8_t  received[gOtaPipelinePageSize_d / 8];
+}otaPage_t;
+
+/*! RAM copy of the bytes of a page which were not written yet */
+typedef struct otaBuffer_tag
+{
+    uint32_t address;        /* page address in the external memory */
+    uint8_t  state;          /* otaBufferState_t */
+    uint8_t  page;           /* index of the page in mOtaPages[] */
+    uint16_t next;           /* page offset of the bytes left to write */
+    uint8_t  pending[gOtaPipelinePageSize_d / 8];
+    uint8_t  data[gOtaPipelinePageSize_d];
+}otaBuffer_t;
+#endif
 
 /******************************************************************************
 *******************************************************************************
@@ -90,6 +147,17 @@ static  uint32_t  mCurrentEepromAddress = 0;
 static  bool_t    mNewImageReady = FALSE;
 #endif
 
+#if mOtaPipeline_d
+/*! Pages of the image received in part */
+static otaPage_t   mOtaPages[gOtaPipelinePages_d];
+/*! Staging buffers */
+static otaBuffer_t mOtaBuffers[gOtaPipelineBuffers_d];
+/*! Pages of the image already programmed. Retransmitted chunks for them are dropped. */
+static uint8_t     mOtaPageDone[(mOtaPipelineMaxPages_c + 7) / 8];
+/*! Number of pages opened so far */
+static uint32_t    mOtaPageAge;
+#endif
+
 #if gEnableOTAServer_d
 /*! The FSCI interface used to download an image */
 static  uint8_t   mOtaFsciInterface = 0;
@@ -133,6 +201,52 @@ volatile const bootInfo_t gBootFlags __attribute__ ((section(".BootloaderFlags")
 static otaServer_AppCB_t *mpOTA_AppCB;
 #endif
 
+#if (gOtaCrcType_d == gOtaCrcNibbleTable_c)
+/*! CRC-CCITT (0x1021) of each nibble value */
+static const uint16_t mOtaCrcTable[16] =
+{
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+#elif (gOtaCrcType_d == gOtaCrcByteTable_c)
+/*! CRC-CCITT (0x1021) of each byte value */
+static const uint16_t mOtaCrcTable[256] =
+{
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+    0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
+    0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
+    0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
+    0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
+    0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
+    0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
+    0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
+    0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
+    0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
+    0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
+    0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
+    0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
+    0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
+    0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
+    0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
+    0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
+    0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
+    0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
+    0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
+    0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+    0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
+    0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
+    0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
+    0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
+    0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
+    0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
+    0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
+    0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
+    0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
+    0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0
+};
+#endif
+
 
 /******************************************************************************
 *******************************************************************************
@@ -215,6 +329,9 @@ otaResult_t OTA_StartImage(uint32_t length)
         mCurrentEepromAddress = gBootData_Image_Offset_c;
         /* Mark that we have started loading an OTA image in EEPROM */
         mLoadOtaImageInEepromInProgress = TRUE;
+#if mOtaPipeline_d
+        OTA_PipelineReset();
+#endif
     }
 
 #if !gEnableOTAServer_d && !gUpgradeImageOnCurrentDevice_d
@@ -242,6 +359,8 @@ otaResult_t OTA_StartImage(uint32_t length)
 *  - gOtaInvalidParam_c: pData is NULL or the resulting image would be bigger than the
 *       final image length specified with OTA_StartImage()
 *  - gOtaInvalidOperation_c: the process is not started
+*  - gOtaBusy_c: with gOtaPipelinedWrite_d, the external FLASH is busy and no page
+*       buffer is free. Push the same chunk again later.
 *
 ********************************************************************************** */
 otaResult_t OTA_PushImageChunk(uint8_t* pData, uint16_t length, uint32_t* pImageLength, uint32_t *pImageOffset)
@@ -259,7 +378,12 @@ otaResult_t OTA_PushImageChunk(uint8_t* pData, uint16_t length, uint32_t* pImage
         status = gOtaInvalidParam_c;
     }
     /* Check if the chunk does not extend over the boundaries of the image */
+#if mOtaPipeline_d
+    else if((((NULL != pImageOffset) ? *pImageOffset : (mCurrentEepromAddress - gBootData_Image_Offset_c)) +
+             length) > mOtaImageTotalLength)
+#else
     else if(mOtaImageCurrentLength + length > mOtaImageTotalLength)
+#endif
     {
         status = gOtaInvalidParam_c;
     }
@@ -271,6 +395,16 @@ otaResult_t OTA_PushImageChunk(uint8_t* pData, uint16_t length, uint32_t* pImage
             mCurrentEepromAddress = gBootData_Image_Offset_c + *pImageOffset;
         }
 
+#if mOtaPipeline_d
+        /* Stage the chunk, mOtaImageCurrentLength counts only the new bytes. When busy,
+           the same chunk is pushed again: the bytes staged so far are skipped. */
+        status = OTA_PipelinePush(pData, length, mCurrentEepromAddress);
+
+        if(status != gOtaBusy_c)
+        {
+            mCurrentEepromAddress += length;
+        }
+#else
         /* Try to write the data chunk into the external EEPROM */
         if(EEPROM_WriteData(length, mCurrentEepromAddress, pData) != ee_ok)
         {
@@ -279,30 +413,7 @@ otaResult_t OTA_PushImageChunk(uint8_t* pData, uint16_t length, uint32_t* pImage
 #if gOtaVerifyWrite_d
         else
         {
-            uint8_t readData[gOtaVerifyWriteBufferSize_d];
-            uint16_t readLen;
-            uint16_t i = 0;
-
-            while(i < length)
-            {
-                readLen = length - i;
-
-                if( readLen > sizeof(readData) )
-                {
-                    readLen = sizeof(readData);
-                }
-
-                EEPROM_ReadData(readLen, mCurrentEepromAddress + i, readData);
-
-                if( !FLib_MemCmp(&pData[i], readData, readLen) )
-                {
-                    status = gOtaExternalFlashError_c;
-                    break;
-                }
-
-                i += readLen;
-            }
-
+            status = OTA_VerifyWrite(pData, length, mCurrentEepromAddress);
         }
 #endif
 
@@ -310,6 +421,7 @@ otaResult_t OTA_PushImageChunk(uint8_t* pData, uint16_t length, uint32_t* pImage
         Update operation parameters */
         mCurrentEepromAddress  += length;
         mOtaImageCurrentLength += length;
+#endif
 
         /* Return the currently written length of the OTA image to the caller */
         if(pImageLength != NULL)
@@ -332,6 +444,8 @@ otaResult_t OTA_PushImageChunk(uint8_t* pData, uint16_t length, uint32_t* pImage
 * \return
 *  - gOtaInvalidOperation_c: the process is not started,
 *  - gOtaEepromError_c: error while trying to write the EEPROM
+*  - gOtaBusy_c: with gOtaPipelinedWrite_d, staged pages are still being written.
+*       Call it again later.
 *
 ********************************************************************************** */
 otaResult_t OTA_CommitImage(uint8_t* pBitmap)
@@ -343,6 +457,16 @@ otaResult_t OTA_CommitImage(uint8_t* pBitmap)
     {
         status = gOtaInvalidOperation_c;
     }
+#if mOtaPipeline_d
+    /* Program the staged pages, until the external memory has written them all */
+    else if((status = OTA_PipelineFlush()) != gOtaSucess_c)
+    {
+        if(status != gOtaBusy_c)
+        {
+            status = gOtaExternalFlashError_c;
+        }
+    }
+#endif
     /* If the currently written image length in EEPROM is not the same with
     the one initially set, commit operation fails */
     else if(mOtaImageCurrentLength != mOtaImageTotalLength)
@@ -452,6 +576,9 @@ void OTA_CancelImage(void)
 #if (gEepromType_d != gEepromDevice_None_c) && (!gEnableOTAServer_d || (gEnableOTAServer_d && gUpgradeImageOnCurrentDevice_d))
     mLoadOtaImageInEepromInProgress = FALSE;
 #endif
+#if mOtaPipeline_d
+    OTA_PipelineReset();
+#endif
 }
 
 /*! *********************************************************************************
@@ -466,6 +593,18 @@ void OTA_CancelImage(void)
 ********************************************************************************** */
 uint16_t OTA_CrcCompute(uint8_t *pData, uint16_t lenData, uint16_t crcValueOld)
 {
+#if (gOtaCrcType_d == gOtaCrcByteTable_c)
+    while(lenData--)
+    {
+        crcValueOld = (uint16_t)(crcValueOld << 8) ^ mOtaCrcTable[(crcValueOld >> 8) ^ *pData++];
+    }
+#elif (gOtaCrcType_d == gOtaCrcNibbleTable_c)
+    while(lenData--)
+    {
+        crcValueOld = (uint16_t)(crcValueOld << 4) ^ mOtaCrcTable[(crcValueOld >> 12) ^ (*pData >> 4)];
+        crcValueOld = (uint16_t)(crcValueOld << 4) ^ mOtaCrcTable[(crcValueOld >> 12) ^ (*pData++ & 0x0F)];
+    }
+#else
     uint8_t i;
 
     while(lenData--)
@@ -483,6 +622,7 @@ uint16_t OTA_CrcCompute(uint8_t *pData, uint16_t lenData, uint16_t crcValueOld)
             }
         }
     }
+#endif
     return crcValueOld;
 }
 
@@ -603,30 +743,7 @@ otaResult_t OTA_WriteExternalMemory(uint8_t* pData, uint16_t length, uint32_t ad
 #if gOtaVerifyWrite_d
     else
     {
-        uint8_t readData[gOtaVerifyWriteBufferSize_d];
-        uint16_t readLen;
-        uint16_t i = 0;
-
-        while(i < length)
-        {
-            readLen = length - i;
-
-            if( readLen > sizeof(readData) )
-            {
-                readLen = sizeof(readData);
-            }
-
-            EEPROM_ReadData(readLen, address + i, readData);
-
-            if( !FLib_MemCmp(&pData[i], readData, readLen) )
-            {
-                status = gOtaExternalFlashError_c;
-                break;
-            }
-
-            i += readLen;
-        }
-
+        status = OTA_VerifyWrite(pData, length, address);
     }
 #endif
     return status;
@@ -755,13 +872,523 @@ void OTA_ClientInfoCnf(uint8_t* pClientAddr, uint32_t offset, uint16_t devId)
 #endif
 
 
-#if gEnableOTAServer_d || gUpgradeImageOnCurrentDevice_d
 /************************************************************************************
 *************************************************************************************
 * Private functions
 *************************************************************************************
 ************************************************************************************/
 
+#if (gEepromType_d != gEepromDevice_None_c) && gOtaVerifyWrite_d
+/*! *********************************************************************************
+* \brief  Checks data written to the external memory. The data is read back in
+*         gOtaVerifyWriteBufferSize_d pieces and a CRC of the read back data is
+*         compared once with the CRC of the source buffer.
+*
+* \param[in] pData    pointer to the data which was written
+* \param[in] length   the length of the data
+* \param[in] address  the external memory address where the data was written
+*
+* \return  gOtaSucess_c if the data matches, gOtaExternalFlashError_c otherwise
+*
+********************************************************************************** */
+static otaResult_t OTA_VerifyWrite(uint8_t* pData, uint16_t length, uint32_t address)
+{
+    uint8_t readData[gOtaVerifyWriteBufferSize_d];
+    uint16_t readLen;
+    uint16_t crcWritten;
+    uint16_t crcRead = 0;
+    uint16_t i = 0;
+
+    crcWritten = OTA_CrcCompute(pData, length, 0);
+
+    while(i < length)
+    {
+        readLen = length - i;
+
+        if( readLen > sizeof(readData) )
+        {
+            readLen = sizeof(readData);
+        }
+
+        EEPROM_ReadData(readLen, address + i, readData);
+        crcRead = OTA_CrcCompute(readData, readLen, crcRead);
+        i += readLen;
+    }
+
+    return (crcRead == crcWritten) ? gOtaSucess_c : gOtaExternalFlashError_c;
+}
+#endif
+
+#if mOtaPipeline_d
+/*! *********************************************************************************
+* \brief  Drops all staged pages and forgets the programmed ones.
+*
+********************************************************************************** */
+static void OTA_PipelineReset(void)
+{
+    FLib_MemSet(mOtaPages, 0, sizeof(mOtaPages));
+    FLib_MemSet(mOtaBuffers, 0, sizeof(mOtaBuffers));
+    FLib_MemSet(mOtaPageDone, 0, sizeof(mOtaPageDone));
+    mOtaPageAge = 0;
+}
+
+/*! *********************************************************************************
+* \brief  Finds the next run of bytes of a staging buffer which must be written.
+*
+* \param[in]     pBuffer  pointer to the staging buffer
+* \param[in,out] pStart   the page offset where the search starts, updated with
+*                         the start of the run
+*
+* \return  the length of the run, 0 if there are no more bytes
+*
+********************************************************************************** */
+static uint16_t OTA_BufferNextRun(otaBuffer_t* pBuffer, uint16_t* pStart)
+{
+    uint16_t start = *pStart;
+    uint16_t end;
+
+    while( (start < gOtaPipelinePageSize_d) && !mOtaBitIsSet_d(pBuffer->pending, start) )
+    {
+        start++;
+    }
+
+    end = start;
+
+    while( (end < gOtaPipelinePageSize_d) && mOtaBitIsSet_d(pBuffer->pending, end) )
+    {
+        end++;
+    }
+
+    *pStart = start;
+    return end - start;
+}
+
+/*! *********************************************************************************
+* \brief  Writes the next runs of pending bytes of a staging buffer, as long as the
+*         external memory is not busy. The memory keeps programming the last run
+*         after this function returns.
+*
+* \param[in] pBuffer  pointer to the staging buffer
+*
+* \return  error code
+*
+********************************************************************************** */
+static otaResult_t OTA_BufferWrite(otaBuffer_t* pBuffer)
+{
+    uint16_t start = pBuffer->next;
+    uint16_t length;
+
+    while( !EEPROM_isBusy() )
+    {
+        length = OTA_BufferNextRun(pBuffer, &start);
+
+        if( length == 0 )
+        {
+            break;
+        }
+
+        if( EEPROM_WriteData(length, pBuffer->address + start, &pBuffer->data[start]) != ee_ok )
+        {
+            pBuffer->next = gOtaPipelinePageSize_d;
+            return gOtaExternalFlashError_c;
+        }
+
+        start += length;
+        pBuffer->next = start;
+    }
+
+    /* Only pending bytes left to search */
+    if( OTA_BufferNextRun(pBuffer, &start) == 0 )
+    {
+        pBuffer->next = gOtaPipelinePageSize_d;
+    }
+
+    return gOtaSucess_c;
+}
+
+/*! *********************************************************************************
+* \brief  Starts writing the pending bytes of a staging buffer, which no longer receives
+*         chunks. A complete page is marked as done, a page received in part keeps its
+*         received bytes map.
+*
+* \param[in] pBuffer  pointer to the staging buffer
+*
+* \return  error code
+*
+********************************************************************************** */
+static otaResult_t OTA_BufferProgram(otaBuffer_t* pBuffer)
+{
+    otaPage_t* pPage = &mOtaPages[pBuffer->page];
+
+    pPage->buffer = mOtaNoBuffer_c;
+
+    if( pPage->covered == pPage->required )
+    {
+        mOtaBitSet_d(mOtaPageDone, mOtaPageIndex_d(pPage->address));
+        pPage->required = 0;
+    }
+
+    pBuffer->state = mOtaBufferProgramming_c;
+    pBuffer->next = 0;
+    return OTA_BufferWrite(pBuffer);
+}
+
+/*! *********************************************************************************
+* \brief  Releases a staging buffer after it was programmed, verifying it if required.
+*
+* \param[in] pBuffer  pointer to the staging buffer
+*
+* \return  error code
+*
+********************************************************************************** */
+static otaResult_t OTA_BufferRetire(otaBuffer_t* pBuffer)
+{
+    otaResult_t status = gOtaSucess_c;
+#if gOtaVerifyWrite_d
+    uint16_t start = 0;
+    uint16_t length;
+
+    while( (length = OTA_BufferNextRun(pBuffer, &start)) != 0 )
+    {
+        status = OTA_VerifyWrite(&pBuffer->data[start], length, pBuffer->address + start);
+
+        if( status != gOtaSucess_c )
+        {
+            break;
+        }
+
+        start += length;
+    }
+#endif
+
+    pBuffer->state = mOtaBufferFree_c;
+    return status;
+}
+
+/*! *********************************************************************************
+* \brief  Returns the page tracking an external memory page, opening it if required.
+*         When all pages are in use, the oldest one is written and dropped. Its bytes
+*         are no longer counted and must be received again.
+*
+* \param[in]  pageAddress  the external memory page address
+* \param[out] pStatus      set to an error code if writing a page failed, or to
+*                          gOtaBusy_c if the external memory is busy
+*
+* \return  pointer to the page, NULL if the external memory is busy
+*
+********************************************************************************** */
+static otaPage_t* OTA_PipelineGetPage(uint32_t pageAddress, otaResult_t* pStatus)
+{
+    otaPage_t* pPage = NULL;
+    uint32_t start;
+    uint32_t end;
+    uint32_t i;
+
+    for( i = 0; i < gOtaPipelinePages_d; i++ )
+    {
+        if( mOtaPages[i].required == 0 )
+        {
+            pPage = &mOtaPages[i];
+        }
+        else if( mOtaPages[i].address == pageAddress )
+        {
+            return &mOtaPages[i];
+        }
+    }
+
+    if( pPage == NULL )
+    {
+        pPage = &mOtaPages[0];
+
+        for( i = 1; i < gOtaPipelinePages_d; i++ )
+        {
+            if( mOtaPages[i].age < pPage->age )
+            {
+                pPage = &mOtaPages[i];
+            }
+        }
+
+        if( pPage->buffer != mOtaNoBuffer_c )
+        {
+            if( EEPROM_isBusy() )
+            {
+                *pStatus = gOtaBusy_c;
+                return NULL;
+            }
+
+            if( OTA_BufferProgram(&mOtaBuffers[pPage->buffer]) != gOtaSucess_c )
+            {
+                *pStatus = gOtaExternalFlashError_c;
+            }
+        }
+
+        /* A complete page was marked as done when programmed */
+        if( pPage->required != 0 )
+        {
+            mOtaImageCurrentLength -= pPage->covered;
+        }
+    }
+
+    /* Only the bytes inside the image must be received */
+    start = gBootData_Image_Offset_c;
+    end = gBootData_Image_Offset_c + mOtaImageTotalLength;
+
+    if( start < pageAddress )
+    {
+        start = pageAddress;
+    }
+
+    if( end > pageAddress + gOtaPipelinePageSize_d )
+    {
+        end = pageAddress + gOtaPipelinePageSize_d;
+    }
+
+    FLib_MemSet(pPage->received, 0, sizeof(pPage->received));
+    pPage->address = pageAddress;
+    pPage->age = mOtaPageAge++;
+    pPage->covered = 0;
+    pPage->required = (uint16_t)(end - start);
+    pPage->buffer = mOtaNoBuffer_c;
+
+    return pPage;
+}
+
+/*! *********************************************************************************
+* \brief  Returns a free staging buffer. When all buffers are in use and none of them
+*         holds a complete page, the oldest one is written in part. The buffers are
+*         released once the external memory is done with them.
+*
+* \param[out] pStatus      set to an error code if writing a page failed, or to
+*                          gOtaBusy_c if no buffer could be released
+*
+* \return  index of the staging buffer, mOtaNoBuffer_c if none is free
+*
+********************************************************************************** */
+static uint8_t OTA_PipelineGetBuffer(otaResult_t* pStatus)
+{
+    otaBuffer_t* pOldest = NULL;
+    bool_t pending = FALSE;
+    uint32_t i;
+
+    for( i = 0; i < gOtaPipelineBuffers_d; i++ )
+    {
+        if( mOtaBuffers[i].state == mOtaBufferFree_c )
+        {
+            return (uint8_t)i;
+        }
+
+        if( (mOtaBuffers[i].state == mOtaBufferProgramming_c) ||
+            (mOtaPages[mOtaBuffers[i].page].covered == mOtaPages[mOtaBuffers[i].page].required) )
+        {
+            pending = TRUE;
+        }
+        else if( (pOldest == NULL) ||
+                 (mOtaPages[mOtaBuffers[i].page].age < mOtaPages[pOldest->page].age) )
+        {
+            pOldest = &mOtaBuffers[i];
+        }
+    }
+
+    if( !pending && !EEPROM_isBusy() && (OTA_BufferProgram(pOldest) != gOtaSucess_c) )
+    {
+        *pStatus = gOtaExternalFlashError_c;
+    }
+
+    if( OTA_PipelineService(FALSE) != gOtaSucess_c )
+    {
+        *pStatus = gOtaExternalFlashError_c;
+    }
+
+    for( i = 0; i < gOtaPipelineBuffers_d; i++ )
+    {
+        if( mOtaBuffers[i].state == mOtaBufferFree_c )
+        {
+            return (uint8_t)i;
+        }
+    }
+
+    if( *pStatus == gOtaSucess_c )
+    {
+        *pStatus = gOtaBusy_c;
+    }
+
+    return mOtaNoBuffer_c;
+}
+
+/*! *********************************************************************************
+* \brief  Stages an image chunk. Each page is programmed once all of its bytes were
+*         received, while the next chunks are being received.
+*
+* \param[in] pData    pointer to the data chunk
+* \param[in] length   the length of the data chunk
+* \param[in] address  the external memory address of the chunk
+*
+* \return  error code, gOtaBusy_c if the chunk must be pushed again
+*
+********************************************************************************** */
+static otaResult_t OTA_PipelinePush(uint8_t* pData, uint16_t length, uint32_t address)
+{
+    otaResult_t status;
+    otaPage_t* pPage;
+    otaBuffer_t* pBuffer;
+    uint32_t pageAddress;
+    uint16_t offset;
+    uint16_t end;
+
+    /* Release the buffers programmed meanwhile and program the complete pages */
+    status = OTA_PipelineService(FALSE);
+
+    while( length )
+    {
+        pageAddress = mOtaPageAddress_d(address);
+        offset = (uint16_t)(address - pageAddress);
+        end = gOtaPipelinePageSize_d;
+
+        if( end - offset > length )
+        {
+            end = offset + length;
+        }
+
+        address += end - offset;
+        length -= end - offset;
+
+        /* Retransmitted chunks of programmed pages are not written again */
+        if( mOtaBitIsSet_d(mOtaPageDone, mOtaPageIndex_d(pageAddress)) )
+        {
+            pData += end - offset;
+            continue;
+        }
+
+        pPage = OTA_PipelineGetPage(pageAddress, &status);
+
+        if( pPage == NULL )
+        {
+            break;
+        }
+
+        if( pPage->buffer == mOtaNoBuffer_c )
+        {
+            pPage->buffer = OTA_PipelineGetBuffer(&status);
+
+            if( pPage->buffer == mOtaNoBuffer_c )
+            {
+                break;
+            }
+
+            pBuffer = &mOtaBuffers[pPage->buffer];
+            FLib_MemSet(pBuffer->pending, 0, sizeof(pBuffer->pending));
+            pBuffer->address = pageAddress;
+            pBuffer->page = (uint8_t)(pPage - mOtaPages);
+            pBuffer->state = mOtaBufferFilling_c;
+        }
+
+        pBuffer = &mOtaBuffers[pPage->buffer];
+
+        for( ; offset < end; offset++ )
+        {
+            /* Bytes already written are not written again */
+            if( !mOtaBitIsSet_d(pPage->received, offset) )
+            {
+                mOtaBitSet_d(pPage->received, offset);
+                mOtaBitSet_d(pBuffer->pending, offset);
+                pBuffer->data[offset] = *pData;
+                pPage->covered++;
+                mOtaImageCurrentLength++;
+            }
+
+            pData++;
+        }
+
+        if( (pPage->covered == pPage->required) && !EEPROM_isBusy() &&
+            (OTA_BufferProgram(pBuffer) != gOtaSucess_c) )
+        {
+            status = gOtaExternalFlashError_c;
+        }
+    }
+
+    return status;
+}
+
+/*! *********************************************************************************
+* \brief  Writes the buffers being programmed and releases them once written, and
+*         programs the complete pages, as far as the external memory is not busy.
+*
+* \param[in] flush   if TRUE, also program the pages which are not complete
+*
+* \return  error code
+*
+********************************************************************************** */
+static otaResult_t OTA_PipelineService(bool_t flush)
+{
+    otaResult_t status = gOtaSucess_c;
+    otaBuffer_t* pBuffer;
+    otaPage_t* pPage;
+    uint32_t i;
+
+    for( i = 0; i < gOtaPipelineBuffers_d; i++ )
+    {
+        pBuffer = &mOtaBuffers[i];
+
+        if( pBuffer->state != mOtaBufferProgramming_c )
+        {
+            continue;
+        }
+
+        if( (pBuffer->next < gOtaPipelinePageSize_d) && (OTA_BufferWrite(pBuffer) != gOtaSucess_c) )
+        {
+            status = gOtaExternalFlashError_c;
+        }
+
+        if( (pBuffer->next == gOtaPipelinePageSize_d) && !EEPROM_isBusy() &&
+            (OTA_BufferRetire(pBuffer) != gOtaSucess_c) )
+        {
+            status = gOtaExternalFlashError_c;
+        }
+    }
+
+    for( i = 0; i < gOtaPipelineBuffers_d; i++ )
+    {
+        pBuffer = &mOtaBuffers[i];
+        pPage = &mOtaPages[pBuffer->page];
+
+        if( (pBuffer->state == mOtaBufferFilling_c) &&
+            (flush || (pPage->covered == pPage->required)) && !EEPROM_isBusy() &&
+            (OTA_BufferProgram(pBuffer) != gOtaSucess_c) )
+        {
+            status = gOtaExternalFlashError_c;
+        }
+    }
+
+    return status;
+}
+
+/*! *********************************************************************************
+* \brief  Programs the staging buffers, one per call while the external memory is busy.
+*
+* \return  error code, gOtaBusy_c until all buffers were written and released
+*
+********************************************************************************** */
+static otaResult_t OTA_PipelineFlush(void)
+{
+    otaResult_t status;
+    uint32_t i;
+
+    status = OTA_PipelineService(TRUE);
+
+    for( i = 0; (status == gOtaSucess_c) && (i < gOtaPipelineBuffers_d); i++ )
+    {
+        if( mOtaBuffers[i].state != mOtaBufferFree_c )
+        {
+            status = gOtaBusy_c;
+        }
+    }
+
+    return status;
+}
+#endif /* mOtaPipeline_d */
+
+#if gEnableOTAServer_d || gUpgradeImageOnCurrentDevice_d
+
 /*! *********************************************************************************
 * \brief  This function handles the FSCI messages for the OTA Server
 *
@@ -856,7 +1483,13 @@ static bool_t OtaSupportCalback( clientPacket_t* pData )
         if( gUpgradeMode == gUpgradeImageOnCurrentDevice_c )
         {
             status = OTA_CommitImage(pData->structured.payload);
-            OTA_SetNewImageFlag();
+#if mOtaPipeline_d
+            /* The host sends the commit again */
+            if( gOtaBusy_c != status )
+#endif
+            {
+                OTA_SetNewImageFlag();
+            }
         }
 #endif
         break;
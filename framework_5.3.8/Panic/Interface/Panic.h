@@ -40,6 +40,9 @@ typedef struct
     uint8_t stack_dump[4];    /* initially just contain the contents of the LR */
 } panicData_t;
 
+/* Called by panic() with interrupts disabled, before halting */
+typedef void (*pfPanicFlushHook_t)(void);
+
 
 /*! *********************************************************************************
 *************************************************************************************
@@ -52,6 +55,16 @@ typedef struct
 
 #define ID_PANIC(grp,value) ((panicId_t)(((panicId_t)(grp) << 16)+((panicId_t)(value))))
 
+/*! *********************************************************************************
+*************************************************************************************
+* Public memory declarations
+*************************************************************************************
+********************************************************************************** */
+#if gUsePanic_c
+/* Sends buffered output. Set to DbgConsole_Flush() when the console output is buffered */
+extern pfPanicFlushHook_t pfPanicFlushHook;
+#endif
+
 /*! *********************************************************************************
 *************************************************************************************
 * Public prototypes
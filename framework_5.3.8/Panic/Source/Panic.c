@@ -19,6 +19,21 @@
 #include "Panic.h"
 #include "fsl_os_abstraction.h"
 
+#if defined(CPU_HOST)
+#include <stdlib.h>
+#elif gUsePanic_c
+#include "fsl_debug_console.h"
+#endif
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+********************************************************************************** */
+#if gUsePanic_c && DEBUG_CONSOLE_TX_BUFFER_SIZE
+static void Panic_FlushDebugConsole(void);
+#endif
+
 /*! *********************************************************************************
 *************************************************************************************
 * Private memory declarations
@@ -26,6 +41,13 @@
 ********************************************************************************** */
 #if gUsePanic_c
 panicData_t panic_data;
+#if DEBUG_CONSOLE_TX_BUFFER_SIZE
+/* The buffered debug console is flushed by default. DbgConsole_Flush() does nothing
+   until DbgConsole_Init() is called. */
+pfPanicFlushHook_t pfPanicFlushHook = Panic_FlushDebugConsole;
+#else
+pfPanicFlushHook_t pfPanicFlushHook = NULL;
+#endif
 #endif
 
 /*! *********************************************************************************
@@ -49,11 +71,15 @@ void panic( panicId_t id, uint32_t location, uint32_t extra1, uint32_t extra2 )
 #if gUsePanic_c
     /* Save the Link Register */
     volatile uint32_t savedLR = 0;
+#if defined(CPU_HOST)
+    savedLR = (uint32_t)(uintptr_t)__builtin_return_address(0);
+#else
     __asm("push {r2}  ");
     __asm("push {LR} ");
     __asm("pop  {r2} ");
     __asm("str  r2, [SP, #4]");
     __asm("pop {r2}");
+#endif
 
     panic_data.id = id;
     panic_data.location = location;
@@ -64,6 +90,17 @@ void panic( panicId_t id, uint32_t location, uint32_t extra1, uint32_t extra2 )
 
     OSA_InterruptDisable(); /* disable interrupts */
 
+    /* Send the buffered debug output, so that it is not lost */
+    if( pfPanicFlushHook )
+    {
+        pfPanicFlushHook();
+    }
+
+#if defined(CPU_HOST)
+    /* End the process, so that a test run fails instead of hanging */
+    abort();
+#endif
+
     /* infinite loop just to ensure this routine never returns */
     for(;;)
     {
@@ -72,6 +109,18 @@ void panic( panicId_t id, uint32_t location, uint32_t extra1, uint32_t extra2 )
 #endif
 }
 
+/*! *********************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+********************************************************************************** */
+#if gUsePanic_c && DEBUG_CONSOLE_TX_BUFFER_SIZE
+static void Panic_FlushDebugConsole(void)
+{
+    (void)DbgConsole_Flush();
+}
+#endif
+
 #if defined(__GNUC__)
 void __attribute__((weak)) __assertion_failed(char* s) {}
 #endif
\ No newline at end of file
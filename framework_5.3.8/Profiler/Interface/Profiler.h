@@ -0,0 +1,268 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* This is the header file for the Profiler module. The Profiler measures the
+* duration of code sections delimited by named probes, and optionally traces the
+* longest windows with interrupts masked.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef _PROFILER_H_
+#define _PROFILER_H_
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include "EmbeddedTypes.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public macros
+*************************************************************************************
+********************************************************************************** */
+
+/* Enables the Profiler. If disabled, the probes are not compiled */
+#ifndef gProfilerEnabled_d
+#define gProfilerEnabled_d            (0)
+#endif
+
+/* Time source: clock_gettime() on a host build, SysTick core clock cycles on target */
+#ifndef gProfilerHostTime_d
+#if defined(__unix__) || defined(__APPLE__)
+#define gProfilerHostTime_d           (1)
+#else
+#define gProfilerHostTime_d           (0)
+#endif
+#endif
+
+/* Profiler FSCI configuration */
+#ifndef gProfilerFsciEnabled_d
+#define gProfilerFsciEnabled_d        (0)
+#endif
+
+/* Default FSCI interface used */
+#ifndef gProfilerFsciInterface_d
+#define gProfilerFsciInterface_d      (0)
+#endif
+
+/* Registers the "prof" shell command */
+#ifndef gProfilerShellEnabled_d
+#define gProfilerShellEnabled_d       (0)
+#endif
+
+/* Traces the longest windows with interrupts masked by OSA_InterruptDisable() */
+#ifndef gProfilerIrqTrace_d
+#define gProfilerIrqTrace_d           (0)
+#endif
+
+/* Number of masked windows kept, one per caller, the longest first */
+#ifndef gProfilerIrqTraceEntries_c
+#define gProfilerIrqTraceEntries_c    (8)
+#endif
+
+/* Operation Groups */
+#define gProfiler_FsciReqOG_d         (0xC2)
+#define gProfiler_FsciCnfOG_d         (0xC3)
+
+/* Commands */
+#define mFsciMsgProfilerGetProbeReq_c (0x01) /* Fsci-ProfilerGetProbe.Request. */
+#define mFsciMsgProfilerResetReq_c    (0x02) /* Fsci-ProfilerReset.Request.    */
+#define mFsciMsgProfilerGetIrqReq_c   (0x03) /* Fsci-ProfilerGetIrqTrace.Request. */
+
+/*
+ * Probe usage, inside a function:
+ *
+ *     PROFILER_PROBE_START(mTmrTaskProbe, "TMR_Task");
+ *     ...
+ *     PROFILER_PROBE_STOP(mTmrTaskProbe);
+ *
+ * START declares the probe and the start time, so it is placed where a declaration
+ * is allowed, once per scope. Every exit path needs a STOP. A probe is listed from
+ * its first STOP on. Probes may be nested, and may be used from interrupts.
+ */
+#if gProfilerEnabled_d
+#define PROFILER_PROBE_START(probe, name)                                         \
+    static profilerProbe_t probe = { (name), NULL, 0, 0xFFFFFFFFU, 0, 0 };       \
+    uint32_t probe##Start = Profiler_GetTime()
+
+#define PROFILER_PROBE_STOP(probe) Profiler_ProbeStop(&(probe), probe##Start)
+#else
+#define PROFILER_PROBE_START(probe, name)
+#define PROFILER_PROBE_STOP(probe)
+#endif
+
+/*
+ * Hooks of the OSA ports, placed in OSA_InterruptDisable() after the interrupts are
+ * masked, and in OSA_InterruptEnable() before they are unmasked. The window is named
+ * by the return address of the function which expands PROFILER_IRQ_MASK_START().
+ */
+#if gProfilerEnabled_d && gProfilerIrqTrace_d
+#if defined(__GNUC__)
+#define Profiler_GetCallerAddress() ((uint32_t)(uintptr_t)__builtin_return_address(0))
+#else
+#define Profiler_GetCallerAddress() ((uint32_t)__get_LR())
+#endif
+
+#define PROFILER_IRQ_MASK_START()  Profiler_IrqMaskStart(Profiler_GetCallerAddress())
+#define PROFILER_IRQ_MASK_END()    Profiler_IrqMaskEnd()
+#else
+#define PROFILER_IRQ_MASK_START()
+#define PROFILER_IRQ_MASK_END()
+#endif
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public type definitions
+*************************************************************************************
+********************************************************************************** */
+
+/* Probe. Times are in Profiler_GetTime() units */
+typedef struct profilerProbe_tag
+{
+    const char                *pName;
+    struct profilerProbe_tag  *pNext;
+    uint32_t                   count;
+    uint32_t                   min;
+    uint32_t                   max;
+    uint64_t                   total;
+} profilerProbe_t;
+
+/* Statistics of a probe. Times are in Profiler_GetTime() units */
+typedef struct profilerStats_tag
+{
+    const char *pName;
+    uint32_t    count;
+    uint32_t    min;
+    uint32_t    max;
+    uint32_t    average;
+} profilerStats_t;
+
+/* Interrupt masked window. The time is in Profiler_GetTime() units */
+typedef struct profilerIrqTrace_tag
+{
+    uint32_t    caller;
+    uint32_t    duration;
+} profilerIrqTrace_t;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+********************************************************************************** */
+#if gProfilerEnabled_d
+/*! *********************************************************************************
+* \brief  Measures the cost of a probe, and registers the FSCI opcode group and the
+*         shell command, if enabled. The shell must be initialized first.
+*
+* \remarks If the bare metal OSA does not use the SysTick, it is started here as a
+*          free running counter of the core clock, without interrupt.
+*
+********************************************************************************** */
+void Profiler_Init(void);
+
+/*! *********************************************************************************
+* \brief  Returns the current time: core clock cycles on target, or nanoseconds on
+*         a host build. The value wraps around.
+*
+* \remarks On target, the time is built from the OSA millisecond counter and the
+*          SysTick, so the OSA tick must be 1 ms. If the bare metal OSA does not use
+*          the SysTick, the time is the free running SysTick, which wraps around
+*          after 2^24 cycles.
+*
+********************************************************************************** */
+uint32_t Profiler_GetTime(void);
+
+/*! *********************************************************************************
+* \brief  Returns the frequency of the Profiler_GetTime() units, in Hz
+*
+********************************************************************************** */
+uint32_t Profiler_GetTimeFrequency(void);
+
+/*! *********************************************************************************
+* \brief  Adds a measurement to a probe. Use PROFILER_PROBE_STOP() instead.
+*
+* \param[in]  pProbe - the probe
+* \param[in]  start  - Profiler_GetTime() value at the start of the section
+*
+********************************************************************************** */
+void Profiler_ProbeStop(profilerProbe_t *pProbe, uint32_t start);
+
+/*! *********************************************************************************
+* \brief  Gets the statistics of a probe, in the order of their first use
+*
+* \param[in]  index  - index of the probe
+* \param[out] pStats - statistics
+*
+* \return  TRUE if the probe exists, FALSE otherwise
+*
+********************************************************************************** */
+bool_t Profiler_GetStats(uint8_t index, profilerStats_t *pStats);
+
+/*! *********************************************************************************
+* \brief  Clears the statistics of all probes, and the interrupt masking trace
+*
+********************************************************************************** */
+void Profiler_Reset(void);
+
+#if gProfilerIrqTrace_d
+/*! *********************************************************************************
+* \brief  Called by OSA_InterruptDisable() after the interrupts are masked. Use
+*         PROFILER_IRQ_MASK_START() instead.
+*
+* \param[in]  caller - return address of the OSA_InterruptDisable() call
+*
+********************************************************************************** */
+void Profiler_IrqMaskStart(uint32_t caller);
+
+/*! *********************************************************************************
+* \brief  Called by OSA_InterruptEnable() before the interrupts are unmasked. Use
+*         PROFILER_IRQ_MASK_END() instead.
+*
+********************************************************************************** */
+void Profiler_IrqMaskEnd(void);
+
+/*! *********************************************************************************
+* \brief  Gets a traced masked window. The windows are sorted by duration, the
+*         longest first, and each caller is listed once, with its longest window.
+*
+* \param[in]  index  - index of the window
+* \param[out] pEntry - the window
+*
+* \return  TRUE if the window exists, FALSE otherwise
+*
+* \remarks The SysTick interrupt is masked too, so the OSA tick does not count the
+*          reloads of the SysTick during the window. On target, the whole periods
+*          are counted on the RTC, which runs free, if its counter is enabled
+*          (SR[TCE]). Otherwise a window which spans more than one reload is
+*          under-reported by whole periods (1 ms). With the free running SysTick,
+*          the windows are measured exactly up to 2^24 cycles.
+*
+********************************************************************************** */
+bool_t Profiler_GetIrqTrace(uint8_t index, profilerIrqTrace_t *pEntry);
+#endif
+
+#if gProfilerFsciEnabled_d
+/*! *********************************************************************************
+* \brief  Profiler FSCI message handler
+*
+* \param[in]  pData - pointer to data message
+* \param[in]  param - pointer to additional parameters (if any)
+* \param[in]  fsciInterface - FSCI interface used
+*
+* \return  None
+*
+********************************************************************************** */
+void Profiler_FsciMsgHandler( void* pData, void* param, uint32_t fsciInterface );
+#endif
+
+#else
+#define Profiler_Init()
+#endif /* gProfilerEnabled_d */
+
+#endif /* _PROFILER_H_ */
@@ -0,0 +1,779 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* This is the source file for the Profiler module.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/************************************************************************************
+*************************************************************************************
+* Includes
+*************************************************************************************
+************************************************************************************/
+#include "Profiler.h"
+
+#if gProfilerEnabled_d
+#include "fsl_os_abstraction.h"
+#include "FunctionLib.h"
+
+#if gProfilerHostTime_d
+#include <time.h>
+#else
+#include "fsl_device_registers.h"
+#if !USE_RTOS
+#include "fsl_os_abstraction_bm.h"
+#endif
+#endif
+
+#if gProfilerFsciEnabled_d
+#include "FsciInterface.h"
+#include "MemManager.h"
+#endif
+
+#if gProfilerShellEnabled_d
+#include "shell.h"
+#include <string.h>
+#endif
+
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+/* Longest probe name sent over FSCI */
+#define mProfilerFsciMaxName_c        (32)
+
+/* GetProbe confirm: status, number of probes, frequency, count, min, max, average,
+   name length, name */
+#define mProfilerFsciProbeCnfLen_c    (1 + 1 + 5 * sizeof(uint32_t) + 1)
+
+/* GetIrqTrace confirm: status, number of windows, frequency, caller, duration */
+#define mProfilerFsciIrqCnfLen_c      (1 + 1 + 3 * sizeof(uint32_t))
+
+/* Without the bare metal OSA timer, the SysTick runs free as a 24 bit cycle counter */
+#if !gProfilerHostTime_d && !USE_RTOS && (FSL_OSA_BM_TIMER_CONFIG == FSL_OSA_BM_TIMER_NONE)
+#define mProfilerFreeRunning_d        (1)
+#define mProfilerTimeMask_c           (SysTick_LOAD_RELOAD_Msk)
+#else
+#define mProfilerFreeRunning_d        (0)
+#define mProfilerTimeMask_c           (0xFFFFFFFFU)
+#endif
+
+/* With the OSA tick, the masked windows are also timed on the RTC, which counts while
+   the SysTick reloads are not. TPR counts 32768 Hz, TSR the overflows of TPR[14]. */
+#if gProfilerIrqTrace_d && !gProfilerHostTime_d && !mProfilerFreeRunning_d
+#define mProfilerIrqRtc_d             (1)
+#define mProfilerRtcBits_c            (15)
+#define mProfilerRtcPrescalerMask_c   ((1U << mProfilerRtcBits_c) - 1U)
+#else
+#define mProfilerIrqRtc_d             (0)
+#endif
+
+
+/************************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+************************************************************************************/
+#if gProfilerFsciEnabled_d
+static void Profiler_FsciGetProbe(clientPacket_t *pPacket, uint32_t fsciInterface);
+#if gProfilerIrqTrace_d
+static void Profiler_FsciGetIrqTrace(clientPacket_t *pPacket, uint32_t fsciInterface);
+#endif
+#endif
+
+#if gProfilerIrqTrace_d
+static void Profiler_IrqTraceInsert(uint32_t caller, uint32_t duration);
+#endif
+
+#if mProfilerIrqRtc_d
+static uint32_t Profiler_GetRtcTime(void);
+static uint32_t Profiler_IrqAddReloads(uint32_t duration);
+#endif
+
+#if gProfilerShellEnabled_d && SHELL_ENABLED
+static int8_t Profiler_ShellCommand(uint8_t argc, char *argv[]);
+static void Profiler_ShellWriteTime(uint32_t time);
+#endif
+
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+/* Probes, in the order of their first use */
+static profilerProbe_t *mpProfilerHead;
+static profilerProbe_t *mpProfilerTail;
+
+/* Cost of a probe, subtracted from each measurement */
+static uint32_t mProfilerOverhead;
+
+#if gProfilerIrqTrace_d
+/* Longest masked windows, sorted by duration. Accessed with interrupts masked. */
+static profilerIrqTrace_t mProfilerIrqTrace[gProfilerIrqTraceEntries_c];
+static uint8_t  mProfilerIrqTraceCount;
+static uint8_t  mProfilerIrqDepth;
+static uint32_t mProfilerIrqCaller;
+static uint32_t mProfilerIrqStart;
+#if mProfilerIrqRtc_d
+static uint32_t mProfilerIrqRtcStart;
+#endif
+#endif
+
+#if gProfilerShellEnabled_d && SHELL_ENABLED
+static const cmd_tbl_t mProfilerShellCmd =
+{
+    .name = "prof",
+    .maxargs = 2,
+    .repeatable = 1,
+    .cmd = Profiler_ShellCommand,
+#if SHELL_USE_HELP
+    .usage = "show the profiling probes",
+    .help = "\r\n"
+            "prof\r\n"
+            "   - print the count, min, max and average duration of each probe\r\n"
+#if gProfilerIrqTrace_d
+            "prof irq\r\n"
+            "   - print the longest interrupt masked windows and their callers\r\n"
+#endif
+            "prof reset\r\n"
+            "   - clear the statistics\r\n",
+#endif
+#if SHELL_USE_AUTO_COMPLETE
+    .complete = NULL,
+#endif
+};
+#endif
+
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+
+/*! *********************************************************************************
+* \brief  Measures the cost of a probe, and registers the FSCI opcode group and the
+*         shell command, if enabled. The shell must be initialized first.
+*
+* \remarks If the bare metal OSA does not use the SysTick, it is started here as a
+*          free running counter of the core clock, without interrupt.
+*
+********************************************************************************** */
+void Profiler_Init(void)
+{
+    uint32_t start;
+
+#if mProfilerFreeRunning_d
+    SysTick->CTRL = 0U;
+    SysTick->LOAD = SysTick_LOAD_RELOAD_Msk;
+    SysTick->VAL = 0U;
+    SysTick->CTRL = SysTick_CTRL_ENABLE_Msk | SysTick_CTRL_CLKSOURCE_Msk;
+#endif
+
+    start = Profiler_GetTime();
+    mProfilerOverhead = (Profiler_GetTime() - start) & mProfilerTimeMask_c;
+
+#if gProfilerFsciEnabled_d
+    FSCI_RegisterOpGroup(gProfiler_FsciReqOG_d,
+                         gFsciMonitorMode_c,
+                         Profiler_FsciMsgHandler,
+                         NULL,
+                         gProfilerFsciInterface_d);
+#endif
+
+#if gProfilerShellEnabled_d && SHELL_ENABLED
+    shell_register_function((cmd_tbl_t*)&mProfilerShellCmd);
+#endif
+}
+
+/*! *********************************************************************************
+* \brief  Returns the current time: core clock cycles on target, or nanoseconds on
+*         a host build. The value wraps around.
+*
+* \remarks On target, the time is built from the OSA millisecond counter and the
+*          SysTick, so the OSA tick must be 1 ms. If the bare metal OSA does not use
+*          the SysTick, the time is the free running SysTick, which wraps around
+*          after 2^24 cycles.
+*
+********************************************************************************** */
+uint32_t Profiler_GetTime(void)
+{
+#if gProfilerHostTime_d
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000U + (uint64_t)ts.tv_nsec);
+#elif mProfilerFreeRunning_d
+    return SysTick_LOAD_RELOAD_Msk - SysTick->VAL;
+#else
+    uint32_t ms;
+    uint32_t count;
+    uint32_t pending;
+
+    do
+    {
+        ms = OSA_TimeGetMsec();
+        count = SysTick->VAL;
+        pending = SCB->ICSR & SCB_ICSR_PENDSTSET_Msk;
+    } while( ms != OSA_TimeGetMsec() );
+
+    /* The SysTick has reloaded, but its interrupt was not served yet */
+    if( pending )
+    {
+        count = SysTick->VAL;
+        ms++;
+    }
+
+    return ms * (SysTick->LOAD + 1U) + (SysTick->LOAD - count);
+#endif
+}
+
+/*! *********************************************************************************
+* \brief  Returns the frequency of the Profiler_GetTime() units, in Hz
+*
+********************************************************************************** */
+uint32_t Profiler_GetTimeFrequency(void)
+{
+#if gProfilerHostTime_d
+    return 1000000000U;
+#elif mProfilerFreeRunning_d
+    return SystemCoreClock;
+#else
+    return (SysTick->LOAD + 1U) * 1000U;
+#endif
+}
+
+/*! *********************************************************************************
+* \brief  Adds a measurement to a probe. Use PROFILER_PROBE_STOP() instead.
+*
+* \param[in]  pProbe - the probe
+* \param[in]  start  - Profiler_GetTime() value at the start of the section
+*
+********************************************************************************** */
+void Profiler_ProbeStop(profilerProbe_t *pProbe, uint32_t start)
+{
+    uint32_t duration = (Profiler_GetTime() - start) & mProfilerTimeMask_c;
+
+    duration = (duration > mProfilerOverhead) ? (duration - mProfilerOverhead) : 0;
+
+    OSA_InterruptDisable();
+
+    /* First use: append the probe to the list */
+    if( (NULL == pProbe->pNext) && (pProbe != mpProfilerTail) )
+    {
+        if( NULL == mpProfilerTail )
+        {
+            mpProfilerHead = pProbe;
+        }
+        else
+        {
+            mpProfilerTail->pNext = pProbe;
+        }
+        mpProfilerTail = pProbe;
+    }
+
+    pProbe->count++;
+    pProbe->total += duration;
+
+    if( duration < pProbe->min )
+    {
+        pProbe->min = duration;
+    }
+
+    if( duration > pProbe->max )
+    {
+        pProbe->max = duration;
+    }
+
+    OSA_InterruptEnable();
+}
+
+/*! *********************************************************************************
+* \brief  Gets the statistics of a probe, in the order of their first use
+*
+* \param[in]  index  - index of the probe
+* \param[out] pStats - statistics
+*
+* \return  TRUE if the probe exists, FALSE otherwise
+*
+********************************************************************************** */
+bool_t Profiler_GetStats(uint8_t index, profilerStats_t *pStats)
+{
+    profilerProbe_t *pProbe = mpProfilerHead;
+    uint64_t total;
+
+    while( (NULL != pProbe) && index )
+    {
+        pProbe = pProbe->pNext;
+        index--;
+    }
+
+    if( NULL == pProbe )
+    {
+        return FALSE;
+    }
+
+    OSA_InterruptDisable();
+    pStats->pName = pProbe->pName;
+    pStats->count = pProbe->count;
+    pStats->min = pProbe->min;
+    pStats->max = pProbe->max;
+    total = pProbe->total;
+    OSA_InterruptEnable();
+
+    if( pStats->count )
+    {
+        pStats->average = (uint32_t)(total / pStats->count);
+    }
+    else
+    {
+        pStats->min = 0;
+        pStats->average = 0;
+    }
+
+    return TRUE;
+}
+
+/*! *********************************************************************************
+* \brief  Clears the statistics of all probes
+*
+********************************************************************************** */
+void Profiler_Reset(void)
+{
+    profilerProbe_t *pProbe;
+
+    for( pProbe = mpProfilerHead; NULL != pProbe; pProbe = pProbe->pNext )
+    {
+        OSA_InterruptDisable();
+        pProbe->count = 0;
+        pProbe->min = 0xFFFFFFFFU;
+        pProbe->max = 0;
+        pProbe->total = 0;
+        OSA_InterruptEnable();
+    }
+
+#if gProfilerIrqTrace_d
+    OSA_InterruptDisable();
+    mProfilerIrqTraceCount = 0;
+    OSA_InterruptEnable();
+#endif
+}
+
+#if gProfilerIrqTrace_d
+/*! *********************************************************************************
+* \brief  Called by OSA_InterruptDisable() after the interrupts are masked
+*
+* \param[in]  caller - return address of the OSA_InterruptDisable() call
+*
+********************************************************************************** */
+void Profiler_IrqMaskStart(uint32_t caller)
+{
+    /* Only the outermost section is timed */
+    if( 0 == mProfilerIrqDepth++ )
+    {
+        mProfilerIrqCaller = caller;
+#if mProfilerIrqRtc_d
+        mProfilerIrqRtcStart = Profiler_GetRtcTime();
+#endif
+        mProfilerIrqStart = Profiler_GetTime();
+    }
+}
+
+/*! *********************************************************************************
+* \brief  Called by OSA_InterruptEnable() before the interrupts are unmasked
+*
+********************************************************************************** */
+void Profiler_IrqMaskEnd(void)
+{
+    uint32_t duration;
+
+    if( (0 == mProfilerIrqDepth) || (0 != --mProfilerIrqDepth) )
+    {
+        return;
+    }
+
+    duration = (Profiler_GetTime() - mProfilerIrqStart) & mProfilerTimeMask_c;
+#if mProfilerIrqRtc_d
+    duration = Profiler_IrqAddReloads(duration);
+#endif
+    duration = (duration > mProfilerOverhead) ? (duration - mProfilerOverhead) : 0;
+
+    /* Most windows are shorter than the last entry of a full table */
+    if( (mProfilerIrqTraceCount < gProfilerIrqTraceEntries_c) ||
+        (duration > mProfilerIrqTrace[gProfilerIrqTraceEntries_c - 1].duration) )
+    {
+        Profiler_IrqTraceInsert(mProfilerIrqCaller, duration);
+    }
+}
+
+/*! *********************************************************************************
+* \brief  Gets a traced masked window. The windows are sorted by duration, the
+*         longest first, and each caller is listed once, with its longest window.
+*
+* \param[in]  index  - index of the window
+* \param[out] pEntry - the window
+*
+* \return  TRUE if the window exists, FALSE otherwise
+*
+********************************************************************************** */
+bool_t Profiler_GetIrqTrace(uint8_t index, profilerIrqTrace_t *pEntry)
+{
+    bool_t status = FALSE;
+
+    OSA_InterruptDisable();
+    if( index < mProfilerIrqTraceCount )
+    {
+        *pEntry = mProfilerIrqTrace[index];
+        status = TRUE;
+    }
+    OSA_InterruptEnable();
+
+    return status;
+}
+#endif /* gProfilerIrqTrace_d */
+
+#if gProfilerFsciEnabled_d
+/*! *********************************************************************************
+* \brief  Profiler FSCI message handler
+*
+* \param[in]  pData - pointer to data message
+* \param[in]  param - pointer to additional parameters (if any)
+* \param[in]  fsciInterface - FSCI interface used
+*
+* \return  None
+*
+********************************************************************************** */
+void Profiler_FsciMsgHandler( void* pData, void* param, uint32_t fsciInterface )
+{
+    switch(((clientPacket_t*)pData)->structured.header.opCode)
+    {
+    case mFsciMsgProfilerGetProbeReq_c:
+        Profiler_FsciGetProbe((clientPacket_t*)pData, fsciInterface);
+        MEM_BufferFree(pData);
+        break;
+
+#if gProfilerIrqTrace_d
+    case mFsciMsgProfilerGetIrqReq_c:
+        Profiler_FsciGetIrqTrace((clientPacket_t*)pData, fsciInterface);
+        MEM_BufferFree(pData);
+        break;
+
+#endif
+    case mFsciMsgProfilerResetReq_c:
+        Profiler_Reset();
+        /* Reuse the received message */
+        ((clientPacket_t*)pData)->structured.header.opGroup = gProfiler_FsciCnfOG_d;
+        ((clientPacket_t*)pData)->structured.header.len = 1;
+        ((clientPacket_t*)pData)->structured.payload[0] = gFsciSuccess_c;
+        FSCI_transmitFormatedPacket( pData, fsciInterface );
+        break;
+
+    default:
+        FSCI_Error( gFsciUnknownOpcode_c, fsciInterface );
+        MEM_BufferFree(pData);
+        break;
+    }
+}
+#endif /* gProfilerFsciEnabled_d */
+
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+
+#if gProfilerFsciEnabled_d
+/*! *********************************************************************************
+* \brief  Sends the statistics of the probe selected by the first payload byte.
+*         A probe index past the end returns gFsciError_c and the number of probes.
+*
+* \param[in]  pPacket - the request
+* \param[in]  fsciInterface - FSCI interface used
+*
+********************************************************************************** */
+static void Profiler_FsciGetProbe(clientPacket_t *pPacket, uint32_t fsciInterface)
+{
+    uint8_t cnf[mProfilerFsciProbeCnfLen_c + mProfilerFsciMaxName_c];
+    profilerStats_t stats;
+    uint8_t *p = &cnf[2];
+    uint32_t value;
+    uint8_t nameLen = 0;
+    uint8_t count = 0;
+
+    while( Profiler_GetStats(count, &stats) )
+    {
+        count++;
+    }
+
+    cnf[1] = count;
+
+    if( (0 == pPacket->structured.header.len) ||
+        !Profiler_GetStats(pPacket->structured.payload[0], &stats) )
+    {
+        cnf[0] = gFsciError_c;
+        FSCI_transmitPayload(gProfiler_FsciCnfOG_d, mFsciMsgProfilerGetProbeReq_c, cnf, 2, fsciInterface);
+        return;
+    }
+
+    cnf[0] = gFsciSuccess_c;
+
+    value = Profiler_GetTimeFrequency();
+    FLib_MemCpy(p, &value, sizeof(uint32_t));
+    p += sizeof(uint32_t);
+    FLib_MemCpy(p, &stats.count, sizeof(uint32_t));
+    p += sizeof(uint32_t);
+    FLib_MemCpy(p, &stats.min, sizeof(uint32_t));
+    p += sizeof(uint32_t);
+    FLib_MemCpy(p, &stats.max, sizeof(uint32_t));
+    p += sizeof(uint32_t);
+    FLib_MemCpy(p, &stats.average, sizeof(uint32_t));
+    p += sizeof(uint32_t);
+
+    while( (nameLen < mProfilerFsciMaxName_c) && stats.pName[nameLen] )
+    {
+        nameLen++;
+    }
+
+    *p++ = nameLen;
+    FLib_MemCpy(p, (void*)stats.pName, nameLen);
+
+    FSCI_transmitPayload(gProfiler_FsciCnfOG_d, mFsciMsgProfilerGetProbeReq_c, cnf,
+                         mProfilerFsciProbeCnfLen_c + nameLen, fsciInterface);
+}
+#if gProfilerIrqTrace_d
+/*! *********************************************************************************
+* \brief  Sends the masked window selected by the first payload byte. An index past
+*         the end returns gFsciError_c and the number of windows.
+*
+* \param[in]  pPacket - the request
+* \param[in]  fsciInterface - FSCI interface used
+*
+********************************************************************************** */
+static void Profiler_FsciGetIrqTrace(clientPacket_t *pPacket, uint32_t fsciInterface)
+{
+    uint8_t cnf[mProfilerFsciIrqCnfLen_c];
+    profilerIrqTrace_t entry;
+    uint32_t value;
+    uint8_t count = 0;
+
+    while( Profiler_GetIrqTrace(count, &entry) )
+    {
+        count++;
+    }
+
+    cnf[1] = count;
+
+    if( (0 == pPacket->structured.header.len) ||
+        !Profiler_GetIrqTrace(pPacket->structured.payload[0], &entry) )
+    {
+        cnf[0] = gFsciError_c;
+        FSCI_transmitPayload(gProfiler_FsciCnfOG_d, mFsciMsgProfilerGetIrqReq_c, cnf, 2, fsciInterface);
+        return;
+    }
+
+    cnf[0] = gFsciSuccess_c;
+    value = Profiler_GetTimeFrequency();
+    FLib_MemCpy(&cnf[2], &value, sizeof(uint32_t));
+    FLib_MemCpy(&cnf[6], &entry.caller, sizeof(uint32_t));
+    FLib_MemCpy(&cnf[10], &entry.duration, sizeof(uint32_t));
+
+    FSCI_transmitPayload(gProfiler_FsciCnfOG_d, mFsciMsgProfilerGetIrqReq_c, cnf,
+                         mProfilerFsciIrqCnfLen_c, fsciInterface);
+}
+#endif /* gProfilerIrqTrace_d */
+#endif /* gProfilerFsciEnabled_d */
+
+#if gProfilerIrqTrace_d
+/*! *********************************************************************************
+* \brief  Records a masked window, keeping one entry per caller, sorted by duration.
+*         Called with interrupts masked.
+*
+* \param[in]  caller   - return address of the OSA_InterruptDisable() call
+* \param[in]  duration - duration of the window
+*
+********************************************************************************** */
+static void Profiler_IrqTraceInsert(uint32_t caller, uint32_t duration)
+{
+    uint8_t i;
+
+    for( i = 0; i < mProfilerIrqTraceCount; i++ )
+    {
+        if( mProfilerIrqTrace[i].caller == caller )
+        {
+            break;
+        }
+    }
+
+    if( i < mProfilerIrqTraceCount )
+    {
+        /* Known caller: keep its longest window */
+        if( duration <= mProfilerIrqTrace[i].duration )
+        {
+            return;
+        }
+    }
+    else if( mProfilerIrqTraceCount < gProfilerIrqTraceEntries_c )
+    {
+        i = mProfilerIrqTraceCount++;
+    }
+    else
+    {
+        /* Replace the shortest window */
+        i = gProfilerIrqTraceEntries_c - 1;
+    }
+
+    /* Move the entry up to its place */
+    while( (i > 0) && (mProfilerIrqTrace[i - 1].duration < duration) )
+    {
+        mProfilerIrqTrace[i] = mProfilerIrqTrace[i - 1];
+        i--;
+    }
+
+    mProfilerIrqTrace[i].caller = caller;
+    mProfilerIrqTrace[i].duration = duration;
+}
+#endif /* gProfilerIrqTrace_d */
+
+#if mProfilerIrqRtc_d
+/*! *********************************************************************************
+* \brief  Returns the RTC time, in 1/32768 s. The value wraps around.
+*
+********************************************************************************** */
+static uint32_t Profiler_GetRtcTime(void)
+{
+    uint32_t seconds;
+    uint32_t prescaler;
+
+    do
+    {
+        seconds = RTC->TSR;
+        prescaler = RTC->TPR;
+    } while( seconds != RTC->TSR );
+
+    return (seconds << mProfilerRtcBits_c) + (prescaler & mProfilerRtcPrescalerMask_c);
+}
+
+/*! *********************************************************************************
+* \brief  Adds the SysTick periods of a masked window which the time base missed.
+*         The OSA tick does not count while the interrupts are masked, and only one
+*         reload is seen as pending. The number of periods is rounded from the RTC
+*         time of the window, whose resolution is well below one period.
+*
+* \param[in]  duration - the window, measured on Profiler_GetTime()
+*
+* \return  the duration, with the missed periods
+*
+********************************************************************************** */
+static uint32_t Profiler_IrqAddReloads(uint32_t duration)
+{
+    uint32_t period = SysTick->LOAD + 1U;
+    uint32_t rtcDuration;
+
+    if( !(RTC->SR & RTC_SR_TCE_MASK) )
+    {
+        return duration;
+    }
+
+    rtcDuration = (uint32_t)(((uint64_t)(Profiler_GetRtcTime() - mProfilerIrqRtcStart) *
+                              Profiler_GetTimeFrequency()) >> mProfilerRtcBits_c);
+
+    if( rtcDuration > duration + period / 2U )
+    {
+        duration += ((rtcDuration - duration + period / 2U) / period) * period;
+    }
+
+    return duration;
+}
+#endif /* mProfilerIrqRtc_d */
+
+#if gProfilerShellEnabled_d && SHELL_ENABLED
+/*! *********************************************************************************
+* \brief  "prof" shell command
+*
+* \param[in]  argc - number of arguments
+* \param[in]  argv - arguments
+*
+* \return  command status
+*
+********************************************************************************** */
+static int8_t Profiler_ShellCommand(uint8_t argc, char *argv[])
+{
+    profilerStats_t stats;
+#if gProfilerIrqTrace_d
+    profilerIrqTrace_t entry;
+#endif
+    uint8_t i;
+
+    if( argc > 1 )
+    {
+        if( 0 == strcmp(argv[1], "reset") )
+        {
+            Profiler_Reset();
+            return CMD_RET_SUCCESS;
+        }
+
+#if gProfilerIrqTrace_d
+        if( 0 == strcmp(argv[1], "irq") )
+        {
+            shell_write("\r\ncaller: masked us");
+
+            for( i = 0; Profiler_GetIrqTrace(i, &entry); i++ )
+            {
+                shell_write("\r\n0x");
+                shell_writeHexLe((uint8_t*)&entry.caller, sizeof(entry.caller));
+                shell_write(": ");
+                Profiler_ShellWriteTime(entry.duration);
+            }
+
+            return CMD_RET_SUCCESS;
+        }
+#endif
+
+        return CMD_RET_USAGE;
+    }
+
+    shell_write("\r\nprobe: count, min/max/avg us");
+
+    for( i = 0; Profiler_GetStats(i, &stats); i++ )
+    {
+        shell_write("\r\n");
+        shell_write((char*)stats.pName);
+        shell_write(": ");
+        shell_writeDec(stats.count);
+        shell_write(", ");
+        Profiler_ShellWriteTime(stats.min);
+        shell_write("/");
+        Profiler_ShellWriteTime(stats.max);
+        shell_write("/");
+        Profiler_ShellWriteTime(stats.average);
+    }
+
+    return CMD_RET_SUCCESS;
+}
+
+/*! *********************************************************************************
+* \brief  Writes a time in microseconds, with one decimal
+*
+* \param[in]  time - time, in Profiler_GetTime() units
+*
+********************************************************************************** */
+static void Profiler_ShellWriteTime(uint32_t time)
+{
+    uint32_t tenths = (uint32_t)(((uint64_t)time * 10000000U) / Profiler_GetTimeFrequency());
+
+    shell_writeDec(tenths / 10);
+    shell_write(".");
+    shell_writeDec(tenths % 10);
+}
+#endif /* gProfilerShellEnabled_d && SHELL_ENABLED */
+
+#endif /* gProfilerEnabled_d */
@@ -24,6 +24,16 @@
 #define gRngNullPointer_d   (0x80)
 #define gRngMaxRequests_d   (100000)
 
+/* Size of the DRBG output buffer [bytes], a multiple of 16 */
+#ifndef gRngBufferSize_d
+#define gRngBufferSize_d    (64)
+#endif
+
+/* Number of DRBG refills after which the DRBG is reseeded with HW entropy */
+#ifndef gRngReseedInterval_d
+#define gRngReseedInterval_d (256)
+#endif
+
 
 /*! *********************************************************************************
 *************************************************************************************
@@ -83,7 +93,7 @@ void RNG_SetPseudoRandomNoSeed(uint8_t* pSeed);
 
 
 /*! *********************************************************************************
-* \brief  Generates a NIST FIPS Publication 186-2-compliant 160 bit pseudo-random number
+* \brief  Generates a pseudo-random number using a NIST SP 800-90A CTR_DRBG (AES-128)
 *
 * \param[out]     pOut - pointer to the output buffer (max 32 bytes)
 * \param[in]      outBytes - the number of bytes to be copyed (1-32)
@@ -94,6 +104,17 @@ void RNG_SetPseudoRandomNoSeed(uint8_t* pSeed);
 ********************************************************************************** */
 int16_t RNG_GetPseudoRandomNo(uint8_t* pOut, uint8_t outBytes, uint8_t* pXSEED);
 
+/*! *********************************************************************************
+* \brief  Fills a buffer of any length with pseudo-random bytes from the DRBG
+*
+* \param[out]     pOut - pointer to the output buffer
+* \param[in]      length - the number of bytes to be generated
+*
+* \return         error code
+*
+********************************************************************************** */
+uint8_t RNG_GetBytes(uint8_t* pOut, uint32_t length);
+
 /*! *********************************************************************************
 * \brief  Returns a random number beween 0 and 256
 *
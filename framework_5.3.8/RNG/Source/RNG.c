@@ -40,6 +40,14 @@
 #define mPRNG_NoOfBytes_c     (mPRNG_NoOfBits_c/8)
 #define mPRNG_NoOfLongWords_c (mPRNG_NoOfBits_c/32)
 
+/* CTR_DRBG (NIST SP 800-90A) using AES-128, without derivation function.
+   The seed holds the new Key followed by the new V. */
+#define mDrbgSeedLen_c        (2*AES_BLOCK_SIZE)
+
+#if (gRngBufferSize_d % AES_BLOCK_SIZE) || (gRngBufferSize_d == 0)
+#error gRngBufferSize_d must be a multiple of the AES block size
+#endif
+
 #if (cPWR_UsePowerDownMode)
 #define RNG_DisallowDeviceToSleep() PWR_DisallowDeviceToSleep()
 #define RNG_AllowDeviceToSleep()    PWR_AllowDeviceToSleep()
@@ -48,14 +56,46 @@
 #define RNG_AllowDeviceToSleep()
 #endif
 
+/* The DRBG state is only changed by tasks, with the mutex held. The output buffer
+   is also read in critical sections, so that RNG_GetBytes() does not take the
+   mutex while the buffer holds enough bytes. */
+#if USE_RTOS
+#define RNG_MUTEX_LOCK()   (void)OSA_MutexLock(mRngMutexId, osaWaitForever_c)
+#define RNG_MUTEX_UNLOCK() (void)OSA_MutexUnlock(mRngMutexId)
+#else
+#define RNG_MUTEX_LOCK()
+#define RNG_MUTEX_UNLOCK()
+#endif
+
 /*! *********************************************************************************
 *************************************************************************************
 * Private memory declarations
 *************************************************************************************
 ********************************************************************************** */
-static uint32_t XKEY[mPRNG_NoOfLongWords_c];
+/* DRBG working state. mPRNG_Requests counts the generate operations since the
+   last seed, the DRBG is not seeded while it equals gRngMaxRequests_d. */
+static uint32_t mDrbgKey[AES_BLOCK_SIZE/4];
+static uint32_t mDrbgV[AES_BLOCK_SIZE/4];
 static uint32_t mPRNG_Requests = gRngMaxRequests_d;
 
+/* Output buffer, the bytes before mRngBufferIdx were already returned */
+static uint32_t mRngBuffer[gRngBufferSize_d/4];
+static uint32_t mRngBufferIdx = gRngBufferSize_d;
+
+#if USE_RTOS
+static osaMutexId_t mRngMutexId;
+#endif
+
+#if FSL_FEATURE_SOC_TRNG_COUNT || FSL_FEATURE_SOC_RNG_COUNT
+/* Entropy read from the HW, used by the next generate operation */
+static uint32_t mRngEntropy[mPRNG_NoOfLongWords_c];
+static volatile bool_t mRngEntropyReady = FALSE;
+#endif
+#if FSL_FEATURE_SOC_TRNG_COUNT
+/* Set when the next entropy generated by the TRNG must be read in TRNG_ISR */
+static volatile bool_t mRngEntropyRequested = FALSE;
+#endif
+
 #if FSL_FEATURE_SOC_TRNG_COUNT
 uint8_t mRngDisallowMcuSleep = 0;
 #endif
@@ -79,7 +119,12 @@ extern void PhyGetRandomNo(uint32_t *pRandomNo);
 ********************************************************************************** */
 #if FSL_FEATURE_SOC_TRNG_COUNT
 static void TRNG_ISR(void);
+static void RNG_TrngReadEntropy(void);
 #endif
+static void RNG_DrbgIncrement(uint8_t* pV);
+static void RNG_DrbgUpdate(const uint8_t* pProvidedData);
+static uint8_t RNG_DrbgGenerate(void);
+static uint32_t RNG_BufferRead(uint8_t* pOut, uint32_t length);
 
 
 /*! *********************************************************************************
@@ -98,6 +143,19 @@ uint8_t RNG_Init(void)
 {
     uint32_t seed;
     uint8_t status = gRngSuccess_d;
+
+#if USE_RTOS
+    if( NULL == mRngMutexId )
+    {
+        mRngMutexId = OSA_MutexCreate();
+
+        if( NULL == mRngMutexId )
+        {
+            return gRngInternalError_d;
+        }
+    }
+#endif
+
 #if FSL_FEATURE_SOC_RNG_COUNT
     RNGA_Init(RNG);
     
@@ -106,6 +164,16 @@ uint8_t RNG_Init(void)
     {
         status = gRngInternalError_d;
     }
+    /* Seed the DRBG */
+    else if( RNGA_GetRandomData(RNG, mRngEntropy, sizeof(mRngEntropy)) )
+    {
+        status = gRngInternalError_d;
+    }
+    else
+    {
+        RNG_SetPseudoRandomNoSeed((uint8_t*)mRngEntropy);
+        FLib_MemSet(mRngEntropy, 0, sizeof(mRngEntropy));
+    }
 #elif FSL_FEATURE_SOC_TRNG_COUNT
     trng_config_t config;
 
@@ -123,11 +191,17 @@ uint8_t RNG_Init(void)
     }
     else
     {
-        /* Get seed for pseudo RNG */
-        if( kStatus_Success != TRNG_GetRandomData(TRNG0, &seed, sizeof(seed)) )
+        /* Seed the DRBG, then get the seed for pseudo RNG from it */
+        if( kStatus_Success != TRNG_GetRandomData(TRNG0, mRngEntropy, sizeof(mRngEntropy)) )
         {
             status = gRngInternalError_d;
         }
+        else
+        {
+            RNG_SetPseudoRandomNoSeed((uint8_t*)mRngEntropy);
+            FLib_MemSet(mRngEntropy, 0, sizeof(mRngEntropy));
+            (void)RNG_GetBytes((uint8_t*)&seed, sizeof(seed));
+        }
 
         /* Check if the entropy generation ongoing */
         if( (!(TRNG0->MCTL & TRNG_MCTL_ENT_VAL_MASK)) && (!mRngDisallowMcuSleep) )
@@ -240,7 +314,9 @@ void RNG_GetRandomNo(uint32_t* pRandomNo)
 
 
 /*! *********************************************************************************
-* \brief  Initialize seed for the PRNG algorithm.
+* \brief  Initialize seed for the PRNG algorithm. The seed is mixed into the
+*         current DRBG state, so a weak seed does not lower the strength of an
+*         already seeded DRBG.
 *
 * \param[in]  pSeed - pointer to a buffer containing 32 bytes (256 bits).
 *             Can be set using the RNG_GetRandomNo() function.
@@ -248,29 +324,23 @@ void RNG_GetRandomNo(uint32_t* pRandomNo)
 ********************************************************************************** */
 void RNG_SetPseudoRandomNoSeed(uint8_t* pSeed)
 {
+    RNG_MUTEX_LOCK();
+    RNG_DrbgUpdate(pSeed);
     mPRNG_Requests = 1;
-    FLib_MemCpy( XKEY, pSeed, mPRNG_NoOfBytes_c );
+    /* Drop the output generated with the previous seed */
+    OSA_InterruptDisable();
+    mRngBufferIdx = gRngBufferSize_d;
+    OSA_InterruptEnable();
+    RNG_MUTEX_UNLOCK();
 }
 
 
 /*! *********************************************************************************
-* \brief  Pseudo Random Number Generator (PRNG) implementation
-*         according to NIST FIPS Publication 186-2, APPENDIX 3
-*
-*         Let x be the signer's private key.  
-*         The following may be used to generate m values of x:
-*           Step 1. Choose a new, secret value for the seed-key, XKEY.
-*           Step 2. In hexadecimal notation let
-*             t = 67452301 EFCDAB89 98BADCFE 10325476 C3D2E1F0.
-*             This is the initial value for H0 || H1 || H2 || H3 || H4 in the SHS.
-*           Step 3. For j = 0 to m - 1 do
-*             a. XSEEDj = optional user input.
-*             b. XVAL = (XKEY + XSEEDj) mod 2^b
-*             c. xj = G(t,XVAL) mod q
-*             d. XKEY = (1 + XKEY + xj) mod 2^b
+* \brief  Pseudo Random Number Generator (PRNG). Returns bytes from the CTR_DRBG
+*         (NIST SP 800-90A, AES-128) output buffer.
 *
 * \param[out]    pOut - pointer to the output buffer
-* \param[in]     outBytes - the number of bytes to be copyed (1-20)
+* \param[in]     outBytes - the number of bytes to be copyed (1-32)
 * \param[in]     pXSEED - optional user SEED. Should be NULL if not used.
 *
 * \return  The number of bytes copied or -1 if reseed is needed
@@ -278,64 +348,73 @@ void RNG_SetPseudoRandomNoSeed(uint8_t* pSeed)
 ********************************************************************************** */
 int16_t RNG_GetPseudoRandomNo(uint8_t* pOut, uint8_t outBytes, uint8_t* pXSEED)
 {
-    uint32_t i;
-    sha256Context_t ctx;
-
     if(pXSEED)
     {
-        mPRNG_Requests = 1;
+        RNG_SetPseudoRandomNoSeed(pXSEED);
     }
 
-    if (mPRNG_Requests == gRngMaxRequests_d)
+    /* Check if the length provided exceeds the output data size */
+    if (outBytes > mPRNG_NoOfBytes_c)
     {
-        outBytes = -1;
+        outBytes = mPRNG_NoOfBytes_c;
     }
-    else
+
+    if( gRngSuccess_d != RNG_GetBytes(pOut, outBytes) )
     {
-        mPRNG_Requests++;
-        
-        /* a. XSEEDj = optional user input. */
-        if (pXSEED)
+        return -1;
+    }
+
+    return outBytes;
+}
+
+/*! *********************************************************************************
+* \brief  Fills a buffer with random bytes from the CTR_DRBG. The output is served
+*         from a buffer of gRngBufferSize_d bytes, which is refilled by a single
+*         AES-128-CTR operation. With a TRNG, fresh entropy is read in TRNG_ISR and
+*         mixed in by the next refill, so the caller never waits for it.
+*
+* \param[out]    pOut - pointer to the output buffer
+* \param[in]     length - the number of bytes to be generated
+*
+* \return  gRngSuccess_d, gRngNullPointer_d, or gRngInternalError_d if the DRBG
+*          is not seeded or needs a reseed which the HW could not provide
+*
+********************************************************************************** */
+uint8_t RNG_GetBytes(uint8_t* pOut, uint32_t length)
+{
+    uint8_t status = gRngSuccess_d;
+    uint32_t size;
+
+    if( (NULL == pOut) && length )
+    {
+        return gRngNullPointer_d;
+    }
+
+    while( length )
+    {
+        size = RNG_BufferRead(pOut, length);
+
+        if( 0 == size )
         {
-            /* b. XVAL = (XKEY + XSEEDj) mod 2^b */
-            for (i=0; i<mPRNG_NoOfBytes_c; i++)
+            /* Another task may have refilled the buffer while this one waited */
+            RNG_MUTEX_LOCK();
+            if( mRngBufferIdx == gRngBufferSize_d )
             {
-                ctx.buffer[i] = ((uint8_t*)XKEY)[i] + pXSEED[i];
+                status = RNG_DrbgGenerate();
             }
-        }
-        else
-        {
-            for (i=0; i<mPRNG_NoOfBytes_c; i++)
+            RNG_MUTEX_UNLOCK();
+
+            if( gRngSuccess_d != status )
             {
-                ctx.buffer[i] = ((uint8_t*)XKEY)[i];
+                break;
             }
         }
-        
-        /* c. xj = G(t,XVAL) mod q
-        ***************************/
-        SHA256_Hash(&ctx, ctx.buffer, mPRNG_NoOfBytes_c);
-        
-        /* d. XKEY = (1 + XKEY + xj) mod 2^b */
-        XKEY[0] += 1;
-        for (i=0; i<mPRNG_NoOfLongWords_c; i++)
-        {
-            XKEY[i] += ctx.hash[i];
-        }
-        
-        /* Check if the length provided exceeds the output data size */
-        if (outBytes > mPRNG_NoOfBytes_c)
-        {
-            outBytes = mPRNG_NoOfBytes_c;
-        }
-        
-        /* Copy the generated number */
-        for (i=0; i < outBytes; i++)
-        {
-            pOut[i] = ((uint8_t*)ctx.hash)[i];
-        }
+
+        pOut += size;
+        length -= size;
     }
 
-    return outBytes;
+    return status;
 }
 
 /*! *********************************************************************************
@@ -377,9 +456,177 @@ uint32_t RND_u32GetRand(uint32_t u32Min, uint32_t u32Max)
 * Private functions
 *************************************************************************************
 ********************************************************************************** */
+/*! *********************************************************************************
+* \brief  Increments V, as a 128-bit big endian number.
+*
+********************************************************************************** */
+static void RNG_DrbgIncrement(uint8_t* pV)
+{
+    uint32_t i = AES_BLOCK_SIZE;
+
+    while( i-- && (++pV[i] == 0) )
+    {
+    }
+}
+
+/*! *********************************************************************************
+* \brief  CTR_DRBG update function. Derives a new Key and V from the current ones,
+*         combined with the provided data.
+*
+* \param[in]  pProvidedData - 32 bytes to be combined with the state, or NULL
+*
+********************************************************************************** */
+static void RNG_DrbgUpdate(const uint8_t* pProvidedData)
+{
+    uint32_t temp[mDrbgSeedLen_c/4] = {0};
+    AES_128_Ctx_t ctx;
+
+    AES_128_SetKey(&ctx, (uint8_t*)mDrbgKey);
+    /* The first block uses V + 1 */
+    RNG_DrbgIncrement((uint8_t*)mDrbgV);
+    AES_128_CTR_WithCtx(&ctx, (uint8_t*)temp, sizeof(temp), (uint8_t*)mDrbgV, (uint8_t*)temp);
+
+    if( pProvidedData )
+    {
+        SecLib_XorN((uint8_t*)temp, (uint8_t*)pProvidedData, sizeof(temp));
+    }
+
+    FLib_MemCpy(mDrbgKey, temp, AES_BLOCK_SIZE);
+    FLib_MemCpy(mDrbgV, (uint8_t*)temp + AES_BLOCK_SIZE, AES_BLOCK_SIZE);
+    FLib_MemSet(temp, 0, sizeof(temp));
+}
+
+/*! *********************************************************************************
+* \brief  CTR_DRBG generate function. Refills the output buffer, mixing in the
+*         entropy read from the HW since the last call. Called with the mutex held.
+*
+*         The output blocks and the blocks of the following update function
+*         encrypt consecutive counter values, so they are computed by a single
+*         AES-128-CTR operation.
+*
+* \return  gRngSuccess_d, or gRngInternalError_d if a reseed is needed
+*
+********************************************************************************** */
+static uint8_t RNG_DrbgGenerate(void)
+{
+    uint32_t temp[(gRngBufferSize_d + mDrbgSeedLen_c)/4] = {0};
+    AES_128_Ctx_t ctx;
+
 #if FSL_FEATURE_SOC_TRNG_COUNT
+    if( (mPRNG_Requests >= gRngReseedInterval_d) && !mRngEntropyReady && !mRngEntropyRequested )
+    {
+        OSA_InterruptDisable();
+        /* Read the entropy now if it is available, otherwise in TRNG_ISR */
+        if( TRNG0->MCTL & TRNG_MCTL_ENT_VAL_MASK )
+        {
+            RNG_TrngReadEntropy();
+        }
+        else
+        {
+            mRngEntropyRequested = TRUE;
+        }
+        OSA_InterruptEnable();
+    }
+#elif FSL_FEATURE_SOC_RNG_COUNT
+    if( (mPRNG_Requests >= gRngReseedInterval_d) &&
+        (0 == RNGA_GetRandomData(RNG, mRngEntropy, sizeof(mRngEntropy))) )
+    {
+        mRngEntropyReady = TRUE;
+    }
+#endif
+
+#if FSL_FEATURE_SOC_TRNG_COUNT || FSL_FEATURE_SOC_RNG_COUNT
+    if( mRngEntropyReady )
+    {
+        /* Reseed */
+        RNG_DrbgUpdate((uint8_t*)mRngEntropy);
+        FLib_MemSet(mRngEntropy, 0, sizeof(mRngEntropy));
+        mRngEntropyReady = FALSE;
+        mPRNG_Requests = 1;
+    }
+#endif
+
+    if( mPRNG_Requests >= gRngMaxRequests_d )
+    {
+        return gRngInternalError_d;
+    }
+
+    mPRNG_Requests++;
+
+    AES_128_SetKey(&ctx, (uint8_t*)mDrbgKey);
+    RNG_DrbgIncrement((uint8_t*)mDrbgV);
+    AES_128_CTR_WithCtx(&ctx, (uint8_t*)temp, sizeof(temp), (uint8_t*)mDrbgV, (uint8_t*)temp);
+
+    FLib_MemCpy(mDrbgKey, (uint8_t*)temp + gRngBufferSize_d, AES_BLOCK_SIZE);
+    FLib_MemCpy(mDrbgV, (uint8_t*)temp + gRngBufferSize_d + AES_BLOCK_SIZE, AES_BLOCK_SIZE);
+
+    OSA_InterruptDisable();
+    FLib_MemCpy(mRngBuffer, temp, gRngBufferSize_d);
+    mRngBufferIdx = 0;
+    OSA_InterruptEnable();
+
+    FLib_MemSet(temp, 0, sizeof(temp));
+
+    return gRngSuccess_d;
+}
+
+/*! *********************************************************************************
+* \brief  Copies up to length unread bytes of the output buffer, and clears them,
+*         in a critical section: no two callers get the same bytes.
+*
+* \return  the number of bytes copied, 0 if the buffer must be refilled
+*
+********************************************************************************** */
+static uint32_t RNG_BufferRead(uint8_t* pOut, uint32_t length)
+{
+    uint32_t size;
+
+    OSA_InterruptDisable();
+    size = gRngBufferSize_d - mRngBufferIdx;
+
+    if( size > length )
+    {
+        size = length;
+    }
+
+    FLib_MemCpy(pOut, (uint8_t*)mRngBuffer + mRngBufferIdx, size);
+    /* Returned bytes are not kept */
+    FLib_MemSet((uint8_t*)mRngBuffer + mRngBufferIdx, 0, size);
+    mRngBufferIdx += size;
+    OSA_InterruptEnable();
+
+    return size;
+}
+
+#if FSL_FEATURE_SOC_TRNG_COUNT
+/*! *********************************************************************************
+* \brief  Reads the entropy generated by the TRNG, which starts a new generation.
+*         Must be called with ENT_VAL set, so that it does not wait.
+*
+********************************************************************************** */
+static void RNG_TrngReadEntropy(void)
+{
+    if( kStatus_Success == TRNG_GetRandomData(TRNG0, mRngEntropy, sizeof(mRngEntropy)) )
+    {
+        mRngEntropyReady = TRUE;
+        mRngEntropyRequested = FALSE;
+    }
+
+    if( (!(TRNG0->MCTL & TRNG_MCTL_ENT_VAL_MASK)) && (!mRngDisallowMcuSleep) )
+    {
+        mRngDisallowMcuSleep = 1;
+        RNG_DisallowDeviceToSleep();
+    }
+}
+
 static void TRNG_ISR(void)
 {
+    /* A generate operation is waiting for entropy */
+    if( mRngEntropyRequested && (TRNG0->MCTL & TRNG_MCTL_ENT_VAL_MASK) )
+    {
+        RNG_TrngReadEntropy();
+    }
+
     /* Clear Interrupt flags */
     TRNG0->INT_CTRL &= ~(TRNG_INT_CTRL_ENT_VAL_MASK | 
                          TRNG_INT_CTRL_HW_ERR_MASK  | 
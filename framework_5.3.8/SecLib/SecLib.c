@@ -41,6 +41,20 @@
 #include "fsl_ltc.h"
 #endif
 
+#if gSecLibSwEcP256_d
+#include "RNG_Interface.h"
+#endif
+
+/* Asynchronous jobs need the LTC and the eDMA */
+#if gSecLibAsyncJobs_d && FSL_FEATURE_SOC_LTC_COUNT && FSL_FEATURE_SOC_EDMA_COUNT
+#define mSecLibAsyncLtc_d 1
+#include "fsl_ltc_edma.h"
+#include "fsl_edma.h"
+#include "fsl_dmamux.h"
+#else
+#define mSecLibAsyncLtc_d 0
+#endif
+
 #ifndef cPWR_UsePowerDownMode
 #define cPWR_UsePowerDownMode 0
 #endif
@@ -73,14 +87,66 @@
     #define SecLib_AllowToSleep()
 #endif
 
+/* Synchronous operations wait for the running asynchronous job, and hold the
+   job queue until they are done with the LTC. The SecLib task restarts the
+   queue once they are done. */
+#if mSecLibAsyncLtc_d
+    #define mSecLibPumpEvent_c     (1 << 0)
+    #define mSecLibJobDoneEvent_c  (1 << 1)
+
+    #define SECLIB_LTC_ACQUIRE() SecLib_AsyncLtcAcquire()
+    #define SECLIB_LTC_RELEASE() SecLib_AsyncLtcRelease()
+#else
+    #define SECLIB_LTC_ACQUIRE()
+    #define SECLIB_LTC_RELEASE()
+#endif
+
 #if USE_RTOS && (FSL_FEATURE_SOC_LTC_COUNT || FSL_FEATURE_SOC_MMCAU_COUNT) && gSecLibUseMutex_c
-    #define SECLIB_MUTEX_LOCK()   OSA_MutexLock(mSecLibMutexId, osaWaitForever_c)
-    #define SECLIB_MUTEX_UNLOCK() OSA_MutexUnlock(mSecLibMutexId)
+    #define SECLIB_MUTEX_LOCK()   do { OSA_MutexLock(mSecLibMutexId, osaWaitForever_c); SECLIB_LTC_ACQUIRE(); } while(0)
+    #define SECLIB_MUTEX_UNLOCK() do { SECLIB_LTC_RELEASE(); OSA_MutexUnlock(mSecLibMutexId); } while(0)
 #else
-    #define SECLIB_MUTEX_LOCK()
-    #define SECLIB_MUTEX_UNLOCK()
+    #define SECLIB_MUTEX_LOCK()   SECLIB_LTC_ACQUIRE()
+    #define SECLIB_MUTEX_UNLOCK() SECLIB_LTC_RELEASE()
 #endif /* USE_RTOS */
 
+#if !(FSL_FEATURE_SOC_MMCAU_COUNT || FSL_FEATURE_SOC_LTC_COUNT)
+/* AES T-table helpers, the state is held as big endian words */
+#define AES_LOAD32(p)      (((uint32_t)(p)[0] << 24) | ((uint32_t)(p)[1] << 16) | \
+                            ((uint32_t)(p)[2] <<  8) |  (uint32_t)(p)[3])
+#define AES_STORE32(p, v)  do { (p)[0] = (uint8_t)((v) >> 24); (p)[1] = (uint8_t)((v) >> 16); \
+                                (p)[2] = (uint8_t)((v) >>  8); (p)[3] = (uint8_t)(v); } while(0)
+#define AES_ROTR(x, n)     (((x) >> (n)) | ((x) << (32 - (n))))
+#define AES_TE0(x)         (mAesTe0[(x)])
+#define AES_TE1(x)         AES_ROTR(mAesTe0[(x)], 8)
+#define AES_TE2(x)         AES_ROTR(mAesTe0[(x)], 16)
+#define AES_TE3(x)         AES_ROTR(mAesTe0[(x)], 24)
+#define AES_LAST_ROUND(a, b, c, d) \
+    (((uint32_t)mAesSbox[(a) >> 24] << 24) ^ ((uint32_t)mAesSbox[((b) >> 16) & 0xFF] << 16) ^ \
+     ((uint32_t)mAesSbox[((c) >> 8) & 0xFF] << 8) ^ ((uint32_t)mAesSbox[(d) & 0xFF]))
+#define AES_TD0(x)         (mAesTd0[(x)])
+#define AES_TD1(x)         AES_ROTR(mAesTd0[(x)], 8)
+#define AES_TD2(x)         AES_ROTR(mAesTd0[(x)], 16)
+#define AES_TD3(x)         AES_ROTR(mAesTd0[(x)], 24)
+#define AES_INV_LAST_ROUND(a, b, c, d) \
+    (((uint32_t)mAesInvSbox[(a) >> 24] << 24) ^ ((uint32_t)mAesInvSbox[((b) >> 16) & 0xFF] << 16) ^ \
+     ((uint32_t)mAesInvSbox[((c) >> 8) & 0xFF] << 8) ^ ((uint32_t)mAesInvSbox[(d) & 0xFF]))
+/* InvMixColumns of a round key word: Td0[S[x]] is x.[0E, 09, 0D, 0B] */
+#define AES_INV_MIX(w) \
+    (AES_TD0(mAesSbox[(w) >> 24]) ^ AES_TD1(mAesSbox[((w) >> 16) & 0xFF]) ^ \
+     AES_TD2(mAesSbox[((w) >> 8) & 0xFF]) ^ AES_TD3(mAesSbox[(w) & 0xFF]))
+#endif /* !(FSL_FEATURE_SOC_MMCAU_COUNT || FSL_FEATURE_SOC_LTC_COUNT) */
+
+#if gSecLibSwEcP256_d
+/* P-256 fixed-base comb: 5 teeth spaced by 52 bits, 31 precomputed points */
+#define mEcP256CombTeeth_c      5
+#define mEcP256CombSpacing_c    52
+#define mEcP256CombPoints_c     31
+/* P-256 signed window used for the Diffie-Hellman key */
+#define mEcP256WindowBits_c     4
+/* Random numbers drawn to get a private key lower than the group order */
+#define mEcP256KeyAttempts_c    4
+#endif /* gSecLibSwEcP256_d */
+
 
 /*! *********************************************************************************
 *************************************************************************************
@@ -93,6 +159,18 @@ typedef union _uuint128_tag
     uint64_t u64[2];
 } uuint128_t;
 
+#if gSecLibSwEcP256_d
+/*! States of a P-256 operation, see ECDH_P256_Continue() */
+typedef enum ecP256State_tag
+{
+    mEcP256Idle_c,
+    mEcP256Comb_c,      /* fixed-base comb of the key generation */
+    mEcP256Table_c,     /* odd multiples of the peer public key */
+    mEcP256Window_c,    /* signed window of the Diffie-Hellman key */
+    mEcP256Finish_c     /* conversion to affine coordinates */
+}ecP256State_t;
+#endif /* gSecLibSwEcP256_d */
+
 #if FSL_FEATURE_SOC_MMCAU_COUNT
 typedef struct mmcauAesContext_tag{
     uint8_t keyExpansion[44*4];
@@ -118,6 +196,261 @@ osaMutexId_t mSecLibMutexId;
 /* Used by ZigBee stack adaptation */
 static tsReg128 sKey;
 
+#if mSecLibAsyncLtc_d
+/* AES job queue. The running job is not in the queue. */
+static secLibJob_t* mpSecLibJobHead;
+static secLibJob_t* mpSecLibJobTail;
+static secLibJob_t* volatile mpSecLibJobActive;
+/* Number of synchronous operations holding the LTC */
+static volatile uint8_t mSecLibLtcSyncCount;
+
+void SecLib_Task(osaTaskParam_t argument);
+OSA_TASK_DEFINE( SecLib_Task, gSecLibTaskPriority_c, 1, gSecLibTaskStackSize_c, FALSE );
+static osaEventId_t mSecLibEventId;
+
+static ltc_edma_handle_t mSecLibLtcEdmaHandle;
+static edma_handle_t mSecLibLtcInputEdmaHandle;
+static edma_handle_t mSecLibLtcOutputEdmaHandle;
+#endif /* mSecLibAsyncLtc_d */
+
+#if !(FSL_FEATURE_SOC_MMCAU_COUNT || FSL_FEATURE_SOC_LTC_COUNT)
+/*! AES S-box, used by the key expansion, the last encryption round and the
+*   InvMixColumns of the decryption round keys */
+static const uint8_t mAesSbox[256] =
+{
+    0x63, 0x7C, 0x77, 0x7B, 0xF2, 0x6B, 0x6F, 0xC5, 0x30, 0x01, 0x67, 0x2B, 0xFE, 0xD7, 0xAB, 0x76,
+    0xCA, 0x82, 0xC9, 0x7D, 0xFA, 0x59, 0x47, 0xF0, 0xAD, 0xD4, 0xA2, 0xAF, 0x9C, 0xA4, 0x72, 0xC0,
+    0xB7, 0xFD, 0x93, 0x26, 0x36, 0x3F, 0xF7, 0xCC, 0x34, 0xA5, 0xE5, 0xF1, 0x71, 0xD8, 0x31, 0x15,
+    0x04, 0xC7, 0x23, 0xC3, 0x18, 0x96, 0x05, 0x9A, 0x07, 0x12, 0x80, 0xE2, 0xEB, 0x27, 0xB2, 0x75,
+    0x09, 0x83, 0x2C, 0x1A, 0x1B, 0x6E, 0x5A, 0xA0, 0x52, 0x3B, 0xD6, 0xB3, 0x29, 0xE3, 0x2F, 0x84,
+    0x53, 0xD1, 0x00, 0xED, 0x20, 0xFC, 0xB1, 0x5B, 0x6A, 0xCB, 0xBE, 0x39, 0x4A, 0x4C, 0x58, 0xCF,
+    0xD0, 0xEF, 0xAA, 0xFB, 0x43, 0x4D, 0x33, 0x85, 0x45, 0xF9, 0x02, 0x7F, 0x50, 0x3C, 0x9F, 0xA8,
+    0x51, 0xA3, 0x40, 0x8F, 0x92, 0x9D, 0x38, 0xF5, 0xBC, 0xB6, 0xDA, 0x21, 0x10, 0xFF, 0xF3, 0xD2,
+    0xCD, 0x0C, 0x13, 0xEC, 0x5F, 0x97, 0x44, 0x17, 0xC4, 0xA7, 0x7E, 0x3D, 0x64, 0x5D, 0x19, 0x73,
+    0x60, 0x81, 0x4F, 0xDC, 0x22, 0x2A, 0x90, 0x88, 0x46, 0xEE, 0xB8, 0x14, 0xDE, 0x5E, 0x0B, 0xDB,
+    0xE0, 0x32, 0x3A, 0x0A, 0x49, 0x06, 0x24, 0x5C, 0xC2, 0xD3, 0xAC, 0x62, 0x91, 0x95, 0xE4, 0x79,
+    0xE7, 0xC8, 0x37, 0x6D, 0x8D, 0xD5, 0x4E, 0xA9, 0x6C, 0x56, 0xF4, 0xEA, 0x65, 0x7A, 0xAE, 0x08,
+    0xBA, 0x78, 0x25, 0x2E, 0x1C, 0xA6, 0xB4, 0xC6, 0xE8, 0xDD, 0x74, 0x1F, 0x4B, 0xBD, 0x8B, 0x8A,
+    0x70, 0x3E, 0xB5, 0x66, 0x48, 0x03, 0xF6, 0x0E, 0x61, 0x35, 0x57, 0xB9, 0x86, 0xC1, 0x1D, 0x9E,
+    0xE1, 0xF8, 0x98, 0x11, 0x69, 0xD9, 0x8E, 0x94, 0x9B, 0x1E, 0x87, 0xE9, 0xCE, 0x55, 0x28, 0xDF,
+    0x8C, 0xA1, 0x89, 0x0D, 0xBF, 0xE6, 0x42, 0x68, 0x41, 0x99, 0x2D, 0x0F, 0xB0, 0x54, 0xBB, 0x16
+};
+
+/*! AES encryption T-table, Te0[x] = S[x].[02, 01, 01, 03]. The other three
+*   tables are byte rotations of Te0 and are computed on the fly. */
+static const uint32_t mAesTe0[256] =
+{
+    0xC66363A5U, 0xF87C7C84U, 0xEE777799U, 0xF67B7B8DU, 0xFFF2F20DU, 0xD66B6BBDU, 0xDE6F6FB1U, 0x91C5C554U,
+    0x60303050U, 0x02010103U, 0xCE6767A9U, 0x562B2B7DU, 0xE7FEFE19U, 0xB5D7D762U, 0x4DABABE6U, 0xEC76769AU,
+    0x8FCACA45U, 0x1F82829DU, 0x89C9C940U, 0xFA7D7D87U, 0xEFFAFA15U, 0xB25959EBU, 0x8E4747C9U, 0xFBF0F00BU,
+    0x41ADADECU, 0xB3D4D467U, 0x5FA2A2FDU, 0x45AFAFEAU, 0x239C9CBFU, 0x53A4A4F7U, 0xE4727296U, 0x9BC0C05BU,
+    0x75B7B7C2U, 0xE1FDFD1CU, 0x3D9393AEU, 0x4C26266AU, 0x6C36365AU, 0x7E3F3F41U, 0xF5F7F702U, 0x83CCCC4FU,
+    0x6834345CU, 0x51A5A5F4U, 0xD1E5E534U, 0xF9F1F108U, 0xE2717193U, 0xABD8D873U, 0x62313153U, 0x2A15153FU,
+    0x0804040CU, 0x95C7C752U, 0x46232365U, 0x9DC3C35EU, 0x30181828U, 0x379696A1U, 0x0A05050FU, 0x2F9A9AB5U,
+    0x0E070709U, 0x24121236U, 0x1B80809BU, 0xDFE2E23DU, 0xCDEBEB26U, 0x4E272769U, 0x7FB2B2CDU, 0xEA75759FU,
+    0x1209091BU, 0x1D83839EU, 0x582C2C74U, 0x341A1A2EU, 0x361B1B2DU, 0xDC6E6EB2U, 0xB45A5AEEU, 0x5BA0A0FBU,
+    0xA45252F6U, 0x763B3B4DU, 0xB7D6D661U, 0x7DB3B3CEU, 0x5229297BU, 0xDDE3E33EU, 0x5E2F2F71U, 0x13848497U,
+    0xA65353F5U, 0xB9D1D168U, 0x00000000U, 0xC1EDED2CU, 0x40202060U, 0xE3FCFC1FU, 0x79B1B1C8U, 0xB65B5BEDU,
+    0xD46A6ABEU, 0x8DCBCB46U, 0x67BEBED9U, 0x7239394BU, 0x944A4ADEU, 0x984C4CD4U, 0xB05858E8U, 0x85CFCF4AU,
+    0xBBD0D06BU, 0xC5EFEF2AU, 0x4FAAAAE5U, 0xEDFBFB16U, 0x864343C5U, 0x9A4D4DD7U, 0x66333355U, 0x11858594U,
+    0x8A4545CFU, 0xE9F9F910U, 0x04020206U, 0xFE7F7F81U, 0xA05050F0U, 0x783C3C44U, 0x259F9FBAU, 0x4BA8A8E3U,
+    0xA25151F3U, 0x5DA3A3FEU, 0x804040C0U, 0x058F8F8AU, 0x3F9292ADU, 0x219D9DBCU, 0x70383848U, 0xF1F5F504U,
+    0x63BCBCDFU, 0x77B6B6C1U, 0xAFDADA75U, 0x42212163U, 0x20101030U, 0xE5FFFF1AU, 0xFDF3F30EU, 0xBFD2D26DU,
+    0x81CDCD4CU, 0x180C0C14U, 0x26131335U, 0xC3ECEC2FU, 0xBE5F5FE1U, 0x359797A2U, 0x884444CCU, 0x2E171739U,
+    0x93C4C457U, 0x55A7A7F2U, 0xFC7E7E82U, 0x7A3D3D47U, 0xC86464ACU, 0xBA5D5DE7U, 0x3219192BU, 0xE6737395U,
+    0xC06060A0U, 0x19818198U, 0x9E4F4FD1U, 0xA3DCDC7FU, 0x44222266U, 0x542A2A7EU, 0x3B9090ABU, 0x0B888883U,
+    0x8C4646CAU, 0xC7EEEE29U, 0x6BB8B8D3U, 0x2814143CU, 0xA7DEDE79U, 0xBC5E5EE2U, 0x160B0B1DU, 0xADDBDB76U,
+    0xDBE0E03BU, 0x64323256U, 0x743A3A4EU, 0x140A0A1EU, 0x924949DBU, 0x0C06060AU, 0x4824246CU, 0xB85C5CE4U,
+    0x9FC2C25DU, 0xBDD3D36EU, 0x43ACACEFU, 0xC46262A6U, 0x399191A8U, 0x319595A4U, 0xD3E4E437U, 0xF279798BU,
+    0xD5E7E732U, 0x8BC8C843U, 0x6E373759U, 0xDA6D6DB7U, 0x018D8D8CU, 0xB1D5D564U, 0x9C4E4ED2U, 0x49A9A9E0U,
+    0xD86C6CB4U, 0xAC5656FAU, 0xF3F4F407U, 0xCFEAEA25U, 0xCA6565AFU, 0xF47A7A8EU, 0x47AEAEE9U, 0x10080818U,
+    0x6FBABAD5U, 0xF0787888U, 0x4A25256FU, 0x5C2E2E72U, 0x381C1C24U, 0x57A6A6F1U, 0x73B4B4C7U, 0x97C6C651U,
+    0xCBE8E823U, 0xA1DDDD7CU, 0xE874749CU, 0x3E1F1F21U, 0x964B4BDDU, 0x61BDBDDCU, 0x0D8B8B86U, 0x0F8A8A85U,
+    0xE0707090U, 0x7C3E3E42U, 0x71B5B5C4U, 0xCC6666AAU, 0x904848D8U, 0x06030305U, 0xF7F6F601U, 0x1C0E0E12U,
+    0xC26161A3U, 0x6A35355FU, 0xAE5757F9U, 0x69B9B9D0U, 0x17868691U, 0x99C1C158U, 0x3A1D1D27U, 0x279E9EB9U,
+    0xD9E1E138U, 0xEBF8F813U, 0x2B9898B3U, 0x22111133U, 0xD26969BBU, 0xA9D9D970U, 0x078E8E89U, 0x339494A7U,
+    0x2D9B9BB6U, 0x3C1E1E22U, 0x15878792U, 0xC9E9E920U, 0x87CECE49U, 0xAA5555FFU, 0x50282878U, 0xA5DFDF7AU,
+    0x038C8C8FU, 0x59A1A1F8U, 0x09898980U, 0x1A0D0D17U, 0x65BFBFDAU, 0xD7E6E631U, 0x844242C6U, 0xD06868B8U,
+    0x824141C3U, 0x299999B0U, 0x5A2D2D77U, 0x1E0F0F11U, 0x7BB0B0CBU, 0xA85454FCU, 0x6DBBBBD6U, 0x2C16163AU
+};
+
+/*! AES inverse S-box, used by the last decryption round */
+static const uint8_t mAesInvSbox[256] =
+{
+    0x52, 0x09, 0x6A, 0xD5, 0x30, 0x36, 0xA5, 0x38, 0xBF, 0x40, 0xA3, 0x9E, 0x81, 0xF3, 0xD7, 0xFB,
+    0x7C, 0xE3, 0x39, 0x82, 0x9B, 0x2F, 0xFF, 0x87, 0x34, 0x8E, 0x43, 0x44, 0xC4, 0xDE, 0xE9, 0xCB,
+    0x54, 0x7B, 0x94, 0x32, 0xA6, 0xC2, 0x23, 0x3D, 0xEE, 0x4C, 0x95, 0x0B, 0x42, 0xFA, 0xC3, 0x4E,
+    0x08, 0x2E, 0xA1, 0x66, 0x28, 0xD9, 0x24, 0xB2, 0x76, 0x5B, 0xA2, 0x49, 0x6D, 0x8B, 0xD1, 0x25,
+    0x72, 0xF8, 0xF6, 0x64, 0x86, 0x68, 0x98, 0x16, 0xD4, 0xA4, 0x5C, 0xCC, 0x5D, 0x65, 0xB6, 0x92,
+    0x6C, 0x70, 0x48, 0x50, 0xFD, 0xED, 0xB9, 0xDA, 0x5E, 0x15, 0x46, 0x57, 0xA7, 0x8D, 0x9D, 0x84,
+    0x90, 0xD8, 0xAB, 0x00, 0x8C, 0xBC, 0xD3, 0x0A, 0xF7, 0xE4, 0x58, 0x05, 0xB8, 0xB3, 0x45, 0x06,
+    0xD0, 0x2C, 0x1E, 0x8F, 0xCA, 0x3F, 0x0F, 0x02, 0xC1, 0xAF, 0xBD, 0x03, 0x01, 0x13, 0x8A, 0x6B,
+    0x3A, 0x91, 0x11, 0x41, 0x4F, 0x67, 0xDC, 0xEA, 0x97, 0xF2, 0xCF, 0xCE, 0xF0, 0xB4, 0xE6, 0x73,
+    0x96, 0xAC, 0x74, 0x22, 0xE7, 0xAD, 0x35, 0x85, 0xE2, 0xF9, 0x37, 0xE8, 0x1C, 0x75, 0xDF, 0x6E,
+    0x47, 0xF1, 0x1A, 0x71, 0x1D, 0x29, 0xC5, 0x89, 0x6F, 0xB7, 0x62, 0x0E, 0xAA, 0x18, 0xBE, 0x1B,
+    0xFC, 0x56, 0x3E, 0x4B, 0xC6, 0xD2, 0x79, 0x20, 0x9A, 0xDB, 0xC0, 0xFE, 0x78, 0xCD, 0x5A, 0xF4,
+    0x1F, 0xDD, 0xA8, 0x33, 0x88, 0x07, 0xC7, 0x31, 0xB1, 0x12, 0x10, 0x59, 0x27, 0x80, 0xEC, 0x5F,
+    0x60, 0x51, 0x7F, 0xA9, 0x19, 0xB5, 0x4A, 0x0D, 0x2D, 0xE5, 0x7A, 0x9F, 0x93, 0xC9, 0x9C, 0xEF,
+    0xA0, 0xE0, 0x3B, 0x4D, 0xAE, 0x2A, 0xF5, 0xB0, 0xC8, 0xEB, 0xBB, 0x3C, 0x83, 0x53, 0x99, 0x61,
+    0x17, 0x2B, 0x04, 0x7E, 0xBA, 0x77, 0xD6, 0x26, 0xE1, 0x69, 0x14, 0x63, 0x55, 0x21, 0x0C, 0x7D
+};
+
+/*! AES decryption T-table, Td0[x] = Si[x].[0E, 09, 0D, 0B]. The other three
+*   tables are byte rotations of Td0 and are computed on the fly. */
+static const uint32_t mAesTd0[256] =
+{
+    0x51F4A750U, 0x7E416553U, 0x1A17A4C3U, 0x3A275E96U, 0x3BAB6BCBU, 0x1F9D45F1U, 0xACFA58ABU, 0x4BE30393U,
+    0x2030FA55U, 0xAD766DF6U, 0x88CC7691U, 0xF5024C25U, 0x4FE5D7FCU, 0xC52ACBD7U, 0x26354480U, 0xB562A38FU,
+    0xDEB15A49U, 0x25BA1B67U, 0x45EA0E98U, 0x5DFEC0E1U, 0xC32F7502U, 0x814CF012U, 0x8D4697A3U, 0x6BD3F9C6U,
+    0x038F5FE7U, 0x15929C95U, 0xBF6D7AEBU, 0x955259DAU, 0xD4BE832DU, 0x587421D3U, 0x49E06929U, 0x8EC9C844U,
+    0x75C2896AU, 0xF48E7978U, 0x99583E6BU, 0x27B971DDU, 0xBEE14FB6U, 0xF088AD17U, 0xC920AC66U, 0x7DCE3AB4U,
+    0x63DF4A18U, 0xE51A3182U, 0x97513360U, 0x62537F45U, 0xB16477E0U, 0xBB6BAE84U, 0xFE81A01CU, 0xF9082B94U,
+    0x70486858U, 0x8F45FD19U, 0x94DE6C87U, 0x527BF8B7U, 0xAB73D323U, 0x724B02E2U, 0xE31F8F57U, 0x6655AB2AU,
+    0xB2EB2807U, 0x2FB5C203U, 0x86C57B9AU, 0xD33708A5U, 0x302887F2U, 0x23BFA5B2U, 0x02036ABAU, 0xED16825CU,
+    0x8ACF1C2BU, 0xA779B492U, 0xF307F2F0U, 0x4E69E2A1U, 0x65DAF4CDU, 0x0605BED5U, 0xD134621FU, 0xC4A6FE8AU,
+    0x342E539DU, 0xA2F355A0U, 0x058AE132U, 0xA4F6EB75U, 0x0B83EC39U, 0x4060EFAAU, 0x5E719F06U, 0xBD6E1051U,
+    0x3E218AF9U, 0x96DD063DU, 0xDD3E05AEU, 0x4DE6BD46U, 0x91548DB5U, 0x71C45D05U, 0x0406D46FU, 0x605015FFU,
+    0x1998FB24U, 0xD6BDE997U, 0x894043CCU, 0x67D99E77U, 0xB0E842BDU, 0x07898B88U, 0xE7195B38U, 0x79C8EEDBU,
+    0xA17C0A47U, 0x7C420FE9U, 0xF8841EC9U, 0x00000000U, 0x09808683U, 0x322BED48U, 0x1E1170ACU, 0x6C5A724EU,
+    0xFD0EFFFBU, 0x0F853856U, 0x3DAED51EU, 0x362D3927U, 0x0A0FD964U, 0x685CA621U, 0x9B5B54D1U, 0x24362E3AU,
+    0x0C0A67B1U, 0x9357E70FU, 0xB4EE96D2U, 0x1B9B919EU, 0x80C0C54FU, 0x61DC20A2U, 0x5A774B69U, 0x1C121A16U,
+    0xE293BA0AU, 0xC0A02AE5U, 0x3C22E043U, 0x121B171DU, 0x0E090D0BU, 0xF28BC7ADU, 0x2DB6A8B9U, 0x141EA9C8U,
+    0x57F11985U, 0xAF75074CU, 0xEE99DDBBU, 0xA37F60FDU, 0xF701269FU, 0x5C72F5BCU, 0x44663BC5U, 0x5BFB7E34U,
+    0x8B432976U, 0xCB23C6DCU, 0xB6EDFC68U, 0xB8E4F163U, 0xD731DCCAU, 0x42638510U, 0x13972240U, 0x84C61120U,
+    0x854A247DU, 0xD2BB3DF8U, 0xAEF93211U, 0xC729A16DU, 0x1D9E2F4BU, 0xDCB230F3U, 0x0D8652ECU, 0x77C1E3D0U,
+    0x2BB3166CU, 0xA970B999U, 0x119448FAU, 0x47E96422U, 0xA8FC8CC4U, 0xA0F03F1AU, 0x567D2CD8U, 0x223390EFU,
+    0x87494EC7U, 0xD938D1C1U, 0x8CCAA2FEU, 0x98D40B36U, 0xA6F581CFU, 0xA57ADE28U, 0xDAB78E26U, 0x3FADBFA4U,
+    0x2C3A9DE4U, 0x5078920DU, 0x6A5FCC9BU, 0x547E4662U, 0xF68D13C2U, 0x90D8B8E8U, 0x2E39F75EU, 0x82C3AFF5U,
+    0x9F5D80BEU, 0x69D0937CU, 0x6FD52DA9U, 0xCF2512B3U, 0xC8AC993BU, 0x10187DA7U, 0xE89C636EU, 0xDB3BBB7BU,
+    0xCD267809U, 0x6E5918F4U, 0xEC9AB701U, 0x834F9AA8U, 0xE6956E65U, 0xAAFFE67EU, 0x21BCCF08U, 0xEF15E8E6U,
+    0xBAE79BD9U, 0x4A6F36CEU, 0xEA9F09D4U, 0x29B07CD6U, 0x31A4B2AFU, 0x2A3F2331U, 0xC6A59430U, 0x35A266C0U,
+    0x744EBC37U, 0xFC82CAA6U, 0xE090D0B0U, 0x33A7D815U, 0xF104984AU, 0x41ECDAF7U, 0x7FCD500EU, 0x1791F62FU,
+    0x764DD68DU, 0x43EFB04DU, 0xCCAA4D54U, 0xE49604DFU, 0x9ED1B5E3U, 0x4C6A881BU, 0xC12C1FB8U, 0x4665517FU,
+    0x9D5EEA04U, 0x018C355DU, 0xFA877473U, 0xFB0B412EU, 0xB3671D5AU, 0x92DBD252U, 0xE9105633U, 0x6DD64713U,
+    0x9AD7618CU, 0x37A10C7AU, 0x59F8148EU, 0xEB133C89U, 0xCEA927EEU, 0xB761C935U, 0xE11CE5EDU, 0x7A47B13CU,
+    0x9CD2DF59U, 0x55F2733FU, 0x1814CE79U, 0x73C737BFU, 0x53F7CDEAU, 0x5FFDAA5BU, 0xDF3D6F14U, 0x7844DB86U,
+    0xCAAFF381U, 0xB968C43EU, 0x3824342CU, 0xC2A3405FU, 0x161DC372U, 0xBCE2250CU, 0x283C498BU, 0xFF0D9541U,
+    0x39A80171U, 0x080CB3DEU, 0xD8B4E49CU, 0x6456C190U, 0x7BCB8461U, 0xD532B670U, 0x486C5C74U, 0xD0B85742U
+};
+
+/*! AES key expansion round constants */
+static const uint32_t mAesRcon[AES128_ROUNDS] =
+{
+    0x01000000, 0x02000000, 0x04000000, 0x08000000, 0x10000000,
+    0x20000000, 0x40000000, 0x80000000, 0x1B000000, 0x36000000
+};
+#endif /* !(FSL_FEATURE_SOC_MMCAU_COUNT || FSL_FEATURE_SOC_LTC_COUNT) */
+
+#if gSecLibSwEcP256_d
+/*! P-256 prime p, little endian words */
+static const uint32_t mEcP256_p[gEcP256Words_c] =
+{
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000000, 0x00000000, 0x00000000, 0x00000001, 0xFFFFFFFF
+};
+
+/*! P-256 group order n */
+static const uint32_t mEcP256_n[gEcP256Words_c] =
+{
+    0xFC632551, 0xF3B9CAC2, 0xA7179E84, 0xBCE6FAAD, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000000, 0xFFFFFFFF
+};
+
+/*! R^2 mod p, with R = 2^256. Converts to the Montgomery form. */
+static const uint32_t mEcP256_R2[gEcP256Words_c] =
+{
+    0x00000003, 0x00000000, 0xFFFFFFFF, 0xFFFFFFFB, 0xFFFFFFFE, 0xFFFFFFFF, 0xFFFFFFFD, 0x00000004
+};
+
+/*! 1 in the Montgomery form (R mod p) */
+static const uint32_t mEcP256_One[gEcP256Words_c] =
+{
+    0x00000001, 0x00000000, 0x00000000, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFE, 0x00000000
+};
+
+/*! Curve coefficient b in the Montgomery form */
+static const uint32_t mEcP256_b[gEcP256Words_c] =
+{
+    0x29C4BDDF, 0xD89CDF62, 0x78843090, 0xACF005CD, 0xF7212ED6, 0xE5A220AB, 0x04874834, 0xDC30061D
+};
+
+/*! Fixed-base comb table. Entry u-1 holds the sum of u_i * 2^(52 * i) * G for
+    i = 0..4, as affine x and y in the Montgomery form. */
+static const uint32_t mEcP256CombTable[mEcP256CombPoints_c][2 * gEcP256Words_c] =
+{
+    /*  1 */ { 0x18A9143C, 0x79E730D4, 0x5FEDB601, 0x75BA95FC, 0x77622510, 0x79FB732B, 0xA53755C6, 0x18905F76,
+               0xCE95560A, 0xDDF25357, 0xBA19E45C, 0x8B4AB8E4, 0xDD21F325, 0xD2E88688, 0x25885D85, 0x8571FF18 },
+    /*  2 */ { 0xCECA9754, 0x83F49167, 0x4B7939A0, 0x426D2CF6, 0x723FD0BF, 0x2555E355, 0xC4F144E2, 0xA96E6D06,
+               0x87880E61, 0x4768A8DD, 0xE508E4D5, 0x15543815, 0xB1B65E15, 0x09D7E772, 0xAC302FA0, 0x63439DD6 },
+    /*  3 */ { 0xA0BE5D0E, 0xF2675562, 0x4D1BB068, 0x4B524D25, 0xA9B75B8C, 0xBC2C5FF2, 0xD9A6F548, 0x4F326643,
+               0x1258835E, 0x50DD6844, 0x676090E0, 0x7D21BEEE, 0xF4A17B42, 0xB0B62C65, 0xB3CEC3B0, 0x60DFAE28 },
+    /*  4 */ { 0xCF7D62D2, 0x20D3C982, 0x23BA8150, 0x1F36E29D, 0x92763F9E, 0x48AE0BF0, 0x1D3A7007, 0x7A527E6B,
+               0x581A85E3, 0xB4A89097, 0xDC158BE5, 0x1F1A520F, 0x167D726E, 0xF98DB37D, 0x1113E862, 0x8802786E },
+    /*  5 */ { 0xB113F918, 0x531E7B64, 0x920A681D, 0x26B5D70A, 0x24C37044, 0x04E52F8F, 0xBB7C375B, 0xBC7C9542,
+               0xF2E26375, 0xB63A044B, 0xE922A3D0, 0xD842A342, 0xA9292D57, 0x9EED2ECA, 0x49AC7832, 0xFE27D2C2 },
+    /*  6 */ { 0xF24AAB7E, 0xEDBD7944, 0xCD1A1921, 0x56E51D9E, 0x962DAE55, 0x11C63188, 0x326ACD14, 0x37090565,
+               0xD71ED134, 0xC436E587, 0xAD89B461, 0x3D96AC3A, 0xDCB718BB, 0xCDF570BC, 0xDCFABDE2, 0xAAA490E9 },
+    /*  7 */ { 0x0B639942, 0xB0AB5401, 0x19379664, 0xA6E12F57, 0x1D040ABC, 0xC535F8B4, 0xA75EEF24, 0xEF255C54,
+               0xAECEB0EA, 0xB236F734, 0x9D879E2F, 0x38FCC8C1, 0x180CACAB, 0x674D8FDC, 0xF624DF06, 0x0A18BAD4 },
+    /*  8 */ { 0xCA8D9D1A, 0x488F1185, 0xD987DED2, 0xADF2C77D, 0x60C46124, 0x5F3039F0, 0x71E095F4, 0xE5D70B75,
+               0x6260E70F, 0x82D58650, 0xF750D105, 0x39D75EA7, 0x75BAC364, 0x8CF3D0B1, 0x21D01329, 0xF3A7564D },
+    /*  9 */ { 0x60530D0A, 0x83FC8091, 0x7BC23DC8, 0x58C24F52, 0xA653AF5A, 0xECDE2F1F, 0xB10E511E, 0xB2E2A374,
+               0x9BEBE1E4, 0xF0C54B32, 0xADE42270, 0x239C25DF, 0x9F22B433, 0xD866F55E, 0xED17EFD3, 0x1E513CA2 },
+    /* 10 */ { 0x5BC98E0D, 0x66313DC8, 0x9A256888, 0xB13FE4E6, 0xECD6E280, 0x74816589, 0x5BA88474, 0xDEE13CDE,
+               0xC53BC78D, 0xAE4E1872, 0x2F08A464, 0x9B79904A, 0x9DA51935, 0xEF6E5CE2, 0x083C47EA, 0x9E58DF82 },
+    /* 11 */ { 0xF5A32632, 0x4E066713, 0x4B36F498, 0x431F75D4, 0x70BD5F07, 0x40AE279F, 0x239EC23D, 0x252CDB93,
+               0x7312A246, 0xC18DDDF8, 0x23A9E561, 0x5B77673C, 0x1715FEDE, 0x020F09C3, 0xA580CFC5, 0xABEF6451 },
+    /* 12 */ { 0xF2A0D962, 0x3C8BC3BF, 0x3405A8AA, 0x59F856EE, 0xB3DC5948, 0x2FB6590C, 0xED85740E, 0xC8AA740C,
+               0xE9AAFE19, 0xF8081CFB, 0x2534800D, 0xF7D2E1F3, 0x8D78D247, 0x355148C2, 0xD1557399, 0xAF0DC5A4 },
+    /* 13 */ { 0xC7F68782, 0x34DFBFC4, 0x08AC2685, 0x2C6A80D6, 0x08D0255B, 0x5479E1BC, 0x9110C616, 0x42EB9DE0,
+               0x10B4ACBA, 0x97991DD8, 0x94D997C7, 0xF36ACC8F, 0x69DDC036, 0xD05AD78B, 0xE68B4243, 0x1AC7E528 },
+    /* 14 */ { 0xE82C8E2A, 0xDD9F8A00, 0x21F80126, 0x104B85C6, 0x5B17A522, 0x1997228D, 0x923D0BD0, 0x706E5EC3,
+               0x1DC33622, 0x00C6AF27, 0x271F09E1, 0xB3BC76C8, 0xE36E325A, 0xEC1B7C0B, 0x68F12BFE, 0x128200E2 },
+    /* 15 */ { 0xA8636D07, 0x8E86CB3D, 0x2BE46DA2, 0xC79C42AC, 0xAA01E0E1, 0xED70E08A, 0xE3B69272, 0x773579FC,
+               0x4D8464C3, 0xBC0FE555, 0xCF54E071, 0x9E87A057, 0x3913B1D3, 0xDA655B0A, 0x9A55DBA4, 0x052774D4 },
+    /* 16 */ { 0xADF7CCCF, 0x75D9BC15, 0xDFA1E1B0, 0x81A3E5D6, 0x249BC17E, 0x8C39E444, 0x8EA7FD43, 0xF37DCCB2,
+               0x907FBA12, 0xDA654873, 0x4A372904, 0x35DAA6DA, 0x6283A6C5, 0x0564CFC6, 0x4A9395BF, 0xD09FA4F6 },
+    /* 17 */ { 0xE37542CA, 0xB1F5C026, 0x72E01034, 0x0B860CF3, 0x025289F2, 0x3A7C10E4, 0x92901032, 0xD2197D5F,
+               0x267CA2F6, 0xFA06F835, 0xBF6E43AA, 0x8FCB9A29, 0x7ED9F8E7, 0x465F6C11, 0xE6077AAF, 0x8A50A5B3 },
+    /* 18 */ { 0xD2B59E85, 0xAD76C703, 0x9204C53F, 0x0A230645, 0x4A9F1335, 0x9BBC0BC4, 0xD0A967E9, 0x71603515,
+               0xA0205375, 0x8B6D6D6E, 0x51AD76DE, 0x63104183, 0xAABBD0AC, 0x5ABFBC21, 0xC71F3060, 0x61FB45C3 },
+    /* 19 */ { 0x1D323961, 0x579345DF, 0x94CD3BC4, 0x45B79EAD, 0x423668D2, 0x50B664BE, 0x42BC26EA, 0x19DD5B75,
+               0x3677AE8F, 0xC7C1FBAA, 0x5D033158, 0x7B2E711A, 0x8942AC93, 0x8AECB50A, 0x8A16718C, 0xE255438B },
+    /* 20 */ { 0x33396533, 0x80253642, 0x2C5AD150, 0x82CB33A7, 0x070CA168, 0x7C147998, 0x6AAC6636, 0x07791253,
+               0x7C78BE24, 0x160003AE, 0xA30EEABF, 0xBBA9FE68, 0x3073F0ED, 0x16C31C40, 0x789CAECA, 0xD329CD28 },
+    /* 21 */ { 0x7972BCDF, 0x840DBCBF, 0xBD11900C, 0xB5C8444F, 0x16520CEE, 0x78B2B290, 0xBE88D914, 0xE19F13A3,
+               0x49D3C0DF, 0x052DDC89, 0xE0B4224B, 0xC9FC183C, 0xCF31E0BB, 0x2C8DD074, 0xA26B1441, 0x872C7B95 },
+    /* 22 */ { 0x74C8A327, 0xED93585D, 0x06BE87CA, 0xF2FB7D08, 0x84E36244, 0x707D83CA, 0x3EFA6833, 0x037F499D,
+               0x99BF5DDE, 0xF3218D42, 0x69FF7CE3, 0xBE0A81C0, 0x9EB7D4C0, 0x068FBBEA, 0xE6938C78, 0xF4EF6609 },
+    /* 23 */ { 0xCB22715E, 0x202E5C5A, 0x288F8243, 0x88E93D23, 0xDC7EACE6, 0xDF1D1F52, 0x373183F8, 0xC6B38B3B,
+               0x3EAC9C4B, 0x77798B7F, 0x6BFA9835, 0xA9D37DFF, 0xFAAC41C9, 0xAFF4A447, 0x0FCB6036, 0xF14FD13C },
+    /* 24 */ { 0x49CCC093, 0xEF5EE27D, 0x40D359A3, 0x7FF3263D, 0xC6D6C0EA, 0x885D1942, 0x28C97FEE, 0x925ABBA3,
+               0x5D95F52D, 0xD7383480, 0x4EB691DB, 0x6979981C, 0x553A29C6, 0x6544E8AE, 0x5043559F, 0x28324EF8 },
+    /* 25 */ { 0x300C0E39, 0xD6C8E4B7, 0x3E37F58A, 0x37AD4A1A, 0xE5E8CDFB, 0x763330F5, 0x870EA133, 0x62BF8C2C,
+               0x763CCAC9, 0x03FBC63A, 0xFB1886C0, 0xC889D8A5, 0xBE49D9FE, 0xF0486DE5, 0x62C23338, 0xAF9A8778 },
+    /* 26 */ { 0x76AA81B3, 0x8A43A2A1, 0x8A0CC3D2, 0x89602129, 0x821F6640, 0x49D311E8, 0x5C734AE4, 0x8035608F,
+               0x349ADC3B, 0xA7BE0561, 0x96A337B5, 0x328525B2, 0x6BCCF78A, 0x575413C3, 0x4854960F, 0x6C7292EC },
+    /* 27 */ { 0x3C2943FF, 0x121E6A71, 0x6374C47E, 0x0468565C, 0x2826F138, 0xD66FE993, 0x7748E3AC, 0x4E2CFAF1,
+               0x4708A6C8, 0xE9BAAA2C, 0x66FFB5B4, 0xA3845C8C, 0xB77C8FAC, 0xAD3E293E, 0x440A35E8, 0x00B5CFA9 },
+    /* 28 */ { 0x63E06277, 0x3F55F58C, 0x64BA6E8C, 0x1A81DE8A, 0xF4CC043B, 0x85CFDC74, 0x048D26E0, 0x7CBEFB98,
+               0x82ABA891, 0x5BDE4B3C, 0x86DB6F46, 0x863D8F75, 0x845186C5, 0xC7AF5C1F, 0xCB527CEC, 0x41D7D404 },
+    /* 29 */ { 0x83E1A246, 0x3B446994, 0xF6B819A2, 0x11C5CED4, 0xAFF79A46, 0xC79D4660, 0x5F22411A, 0x423BBDC1,
+               0xA964039D, 0x22652251, 0xE738657B, 0x808D6753, 0x4E909DC8, 0xC0CA19E3, 0x34AB0D07, 0x0E036E47 },
+    /* 30 */ { 0x7A26F742, 0x233593E7, 0xFC0F14D9, 0xDDC1C79F, 0x2D359358, 0xB33C8980, 0x730AACFE, 0x51DF6155,
+               0x0F2C0B8D, 0xA9A6066C, 0x2E706F80, 0xB9212227, 0x96A5EFE9, 0x3994A532, 0x52316B12, 0xCF3D168B },
+    /* 31 */ { 0x27EAFCC0, 0xBE47DD50, 0xEC7E66DB, 0x23DF1041, 0x78A4DDDD, 0x18C977FF, 0x9D2D152E, 0xB51565D7,
+               0x78F4A4DE, 0x24F6A6D5, 0x7D86B2CA, 0xBBC15B20, 0x1D3B43CA, 0xA064D39C, 0x52200839, 0x55248667 }
+};
+#endif /* gSecLibSwEcP256_d */
+
+#if gSecLibSwEcP256_d
+/************************************************************************************
+*************************************************************************************
+* Public memory declarations
+*************************************************************************************
+************************************************************************************/
+/* Size of the buffer passed to Ecdh_GenerateNewKeys() and Ecdh_ComputeDhKey() */
+const uint32_t gEcP256_MultiplicationBufferSize_c = sizeof(ecP256Context_t);
+#endif /* gSecLibSwEcP256_d */
+
 /*! *********************************************************************************
 *************************************************************************************
 * Public prototypes
@@ -167,16 +500,60 @@ ecdhStatus_t Ecdh_ComputeDhKey
 ********************************************************************************** */
 static void SHA1_hash_n(uint8_t* pData, uint32_t nBlk, uint32_t* pHash);
 static void SHA256_hash_n(uint8_t* pData, uint32_t nBlk, uint32_t* pHash);
-static void AES_128_CMAC_Generate_Subkey(uint8_t *key, uint8_t *K1, uint8_t *K2);
+static void AES_128_CMAC_Generate_Subkey(AES_128_Ctx_t *pCtx, uint8_t *K1, uint8_t *K2);
+static void AES_128_EncryptBlock(AES_128_Ctx_t* pCtx, const uint8_t* pInput, uint8_t* pOutput);
+static void AES_128_CMAC_Compute(AES_128_Ctx_t* pCtx, const uint8_t* pPrefix, const uint8_t* pInput, uint32_t inputLen, uint8_t* pOutput);
+static void AES_128_EAX_Omac(AES_128_Ctx_t* pCtx, uint8_t tag, const uint8_t* pInput, uint32_t inputLen, uint8_t* pOutput);
 static void SecLib_LeftShiftOneBit(uint8_t *input, uint8_t *output);
 static void SecLib_Padding(uint8_t *lastb, uint8_t *pad, uint32_t length);
 static void SecLib_Xor128(uint8_t *a, uint8_t *b, uint8_t *out);
 
-#if FSL_FEATURE_SOC_LTC_COUNT
-#else
+static void AES_128_CbcMacBlocks(AES_128_Ctx_t* pCtx, uint8_t* pMac, const uint8_t* pInput, uint32_t numBlocks);
+static void AES_128_CTR_Process(AES_128_CTR_Ctx_t* pCtx, const uint8_t* pInput, uint32_t inputLen, uint8_t* pOutput);
+static void AES_128_CCM_MacUpdate(AES_128_CCM_Ctx_t* pCtx, const uint8_t* pInput, uint32_t inputLen);
+static void AES_128_CCM_MacPad(AES_128_CCM_Ctx_t* pCtx);
 static void AES_128_IncrementCounter(uint8_t* ctr);
+static secResultType_t SecLib_RunJob(secLibJob_t* pJob);
+
+#if mSecLibAsyncLtc_d
+static void SecLib_AsyncLtcAcquire(void);
+static void SecLib_AsyncLtcRelease(void);
+static void SecLib_AsyncLtcPoll(void);
+static void SecLib_AsyncPump(void);
+static bool_t SecLib_AsyncStart(secLibJob_t* pJob, secResultType_t* pStatus);
+static void SecLib_AsyncFinish(secLibJob_t* pJob, secResultType_t status);
+static void SecLib_LtcEdmaCallback(LTC_Type *base, ltc_edma_handle_t *handle, status_t status, void *userData);
+#endif
+
+#if !(FSL_FEATURE_SOC_MMCAU_COUNT || FSL_FEATURE_SOC_LTC_COUNT)
+static void AES_128_SwExpandKey(const uint8_t* pKey, uint32_t* rk);
+static void AES_128_SwEncrypt(const uint32_t* rk, const uint8_t* pInput, uint8_t* pOutput);
+static void AES_128_SwDecrypt(const uint32_t* rk, const uint8_t* pInput, uint8_t* pOutput);
 #endif
 
+#if gSecLibSwEcP256_d
+static uint32_t EcP256_AddWords(uint32_t* pR, const uint32_t* pA, const uint32_t* pB);
+static uint32_t EcP256_SubWords(uint32_t* pR, const uint32_t* pA, const uint32_t* pB);
+static void EcP256_CondCopy(uint32_t* pR, const uint32_t* pA, uint32_t mask, uint32_t words);
+static uint32_t EcP256_EqualMask(uint32_t a, uint32_t b);
+static bool_t EcP256_IsZero(const uint32_t* pA);
+static bool_t EcP256_IsLess(const uint32_t* pA, const uint32_t* pB);
+static void EcP256_Load(uint32_t* pR, const uint8_t* pIn);
+static void EcP256_Store(uint8_t* pOut, const uint32_t* pA);
+static void EcP256_FieldAdd(uint32_t* pR, const uint32_t* pA, const uint32_t* pB);
+static void EcP256_FieldSub(uint32_t* pR, const uint32_t* pA, const uint32_t* pB);
+static void EcP256_FieldMul(uint32_t* pR, const uint32_t* pA, const uint32_t* pB);
+static void EcP256_FieldInv(uint32_t* pR, const uint32_t* pA);
+static void EcP256_PointDouble(ecP256Point_t* pR, const ecP256Point_t* pP);
+static void EcP256_PointAdd(ecP256Point_t* pR, const ecP256Point_t* pP, const ecP256Point_t* pQ);
+static uint32_t EcP256_CombIndex(const uint32_t* pScalar, uint32_t column);
+static void EcP256_CombLookup(ecP256Point_t* pR, uint32_t index);
+static void EcP256_WindowLookup(ecP256Point_t* pR, const ecP256Point_t* pTable, int8_t digit);
+static void EcP256_Recode(int8_t* pDigits, uint32_t* pScalar);
+static secResultType_t EcP256_GenerateScalar(uint32_t* pScalar);
+static secResultType_t EcP256_Finish(ecP256Context_t* pCtx);
+#endif /* gSecLibSwEcP256_d */
+
 
 /*! *********************************************************************************
 *************************************************************************************
@@ -190,10 +567,38 @@ static void AES_128_IncrementCounter(uint8_t* ctr);
 ********************************************************************************** */
 void SecLib_Init(void)
 {
+#if mSecLibAsyncLtc_d && gSecLibLtcDmaInit_d
+    edma_config_t dmaConfig;
+#endif
+
 #if FSL_FEATURE_SOC_LTC_COUNT
     LTC_Init(LTC0);
 #endif /* FSL_FEATURE_SOC_LTC_COUNT */
 
+#if mSecLibAsyncLtc_d
+#if gSecLibLtcDmaInit_d
+    DMAMUX_Init(gSecLibLtcDmaMux_c);
+    EDMA_GetDefaultConfig(&dmaConfig);
+    EDMA_Init(gSecLibLtcDma_c, &dmaConfig);
+#endif
+    DMAMUX_SetSource(gSecLibLtcDmaMux_c, gSecLibLtcInputDmaChannel_c, kDmaRequestMux0LTC0InputFIFO);
+    DMAMUX_EnableChannel(gSecLibLtcDmaMux_c, gSecLibLtcInputDmaChannel_c);
+    DMAMUX_SetSource(gSecLibLtcDmaMux_c, gSecLibLtcOutputDmaChannel_c, kDmaRequestMux0LTC0OutputFIFO);
+    DMAMUX_EnableChannel(gSecLibLtcDmaMux_c, gSecLibLtcOutputDmaChannel_c);
+
+    EDMA_CreateHandle(&mSecLibLtcInputEdmaHandle, gSecLibLtcDma_c, gSecLibLtcInputDmaChannel_c);
+    EDMA_CreateHandle(&mSecLibLtcOutputEdmaHandle, gSecLibLtcDma_c, gSecLibLtcOutputDmaChannel_c);
+    LTC_CreateHandleEDMA(LTC0, &mSecLibLtcEdmaHandle, SecLib_LtcEdmaCallback, NULL,
+                         &mSecLibLtcInputEdmaHandle, &mSecLibLtcOutputEdmaHandle);
+
+    mSecLibEventId = OSA_EventCreate(TRUE);
+    if( (NULL == mSecLibEventId) || (NULL == OSA_TaskCreate(OSA_TASK(SecLib_Task), NULL)) )
+    {
+        panic( ID_PANIC(0,0), (uint32_t)SecLib_Init, 0, 0 );
+        return;
+    }
+#endif /* mSecLibAsyncLtc_d */
+
 #if USE_RTOS && (FSL_FEATURE_SOC_LTC_COUNT || FSL_FEATURE_SOC_MMCAU_COUNT)
     /*! Initialize the MMCAU AES Context Buffer Mutex here. */
        mSecLibMutexId = OSA_MutexCreate();
@@ -305,6 +710,8 @@ void AES_128_Decrypt(const uint8_t* pInput,
     mmcauAesContext_t *pCtx = &mmcauAesCtx;
     uint8_t* pIn;
     uint8_t* pOut;
+#elif !FSL_FEATURE_SOC_LTC_COUNT
+    uint32_t roundKeys[AES_128_EXPANDED_KEY_WORDS];
 #endif
 
     SecLib_DisallowToSleep();
@@ -357,7 +764,9 @@ void AES_128_Decrypt(const uint8_t* pInput,
 #elif FSL_FEATURE_SOC_LTC_COUNT
     LTC_AES_DecryptEcb(LTC0, pInput, pOutput, AES_BLOCK_SIZE, pKey, AES_BLOCK_SIZE, kLTC_EncryptKey);
 #else
-    sw_Aes128(pInput, pKey, 0, pOutput);
+    AES_128_SwExpandKey(pKey, roundKeys);
+    AES_128_SwDecrypt(roundKeys, pInput, pOutput);
+    FLib_MemSet(roundKeys, 0, sizeof(roundKeys));
 #endif
 
     SECLIB_MUTEX_UNLOCK();
@@ -385,19 +794,24 @@ void AES_128_ECB_Encrypt(uint8_t* pInput,
 {
     uint8_t tempBuffIn[AES_BLOCK_SIZE] = {0};
     uint8_t tempBuffOut[AES_BLOCK_SIZE] = {0};
+    AES_128_Ctx_t ctx;
+    uint32_t numBlocks = 0;
 
-    /* If remaining data bigger than one AES block size */
-    while( inputLen > AES_BLOCK_SIZE )
+    AES_128_SetKey(&ctx, pKey);
+
+    /* All blocks but the last one are processed at once */
+    if( inputLen > AES_BLOCK_SIZE )
     {
-        AES_128_Encrypt(pInput, pKey, pOutput);
-        pInput += AES_BLOCK_SIZE;
-        pOutput += AES_BLOCK_SIZE;
-        inputLen -= AES_BLOCK_SIZE;
+        numBlocks = (inputLen - 1) / AES_BLOCK_SIZE;
+        AES_128_ECB_Block_Encrypt_WithCtx(&ctx, pInput, numBlocks, pOutput);
+        pInput += numBlocks * AES_BLOCK_SIZE;
+        pOutput += numBlocks * AES_BLOCK_SIZE;
+        inputLen -= numBlocks * AES_BLOCK_SIZE;
     }
 
     /* If remaining data is smaller then one AES block size */
     FLib_MemCpy(tempBuffIn, pInput, inputLen);
-    AES_128_Encrypt(tempBuffIn, pKey, tempBuffOut);
+    AES_128_Encrypt_WithCtx(&ctx, tempBuffIn, tempBuffOut);
     FLib_MemCpy(pOutput, tempBuffOut, inputLen);
 }
 
@@ -420,13 +834,10 @@ void AES_128_ECB_Block_Encrypt(uint8_t* pInput,
                                const uint8_t* pKey,
                                uint8_t* pOutput)
 {
-    while( numBlocks )
-    {
-        AES_128_Encrypt(pInput, pKey, pOutput);
-        numBlocks--;
-        pInput += AES_BLOCK_SIZE;
-        pOutput += AES_BLOCK_SIZE;
-    }
+    AES_128_Ctx_t ctx;
+
+    AES_128_SetKey(&ctx, pKey);
+    AES_128_ECB_Block_Encrypt_WithCtx(&ctx, pInput, numBlocks, pOutput);
 }
 
 /*! *********************************************************************************
@@ -464,26 +875,29 @@ void AES_128_CBC_Encrypt(uint8_t* pInput,
 #else
     static uint8_t tempBuffIn[AES_BLOCK_SIZE] = {0};
     uint8_t tempBuffOut[AES_BLOCK_SIZE] = {0};
+    AES_128_Ctx_t ctx;
+    uint32_t fullLen = 0;
 
     if( pInitVector != NULL )
     {
         FLib_MemCpy(tempBuffIn, pInitVector, AES_BLOCK_SIZE);
     }
 
-    /* If remaining data is bigger than one AES block size */
-    while( inputLen > AES_BLOCK_SIZE )
+    AES_128_SetKey(&ctx, pKey);
+
+    /* All blocks but the last one are chained at once, tempBuffIn holds the IV */
+    if( inputLen > AES_BLOCK_SIZE )
     {
-        SecLib_XorN(tempBuffIn, pInput, AES_BLOCK_SIZE);
-        AES_128_Encrypt(tempBuffIn, pKey, pOutput);
-        FLib_MemCpy(tempBuffIn, pOutput, AES_BLOCK_SIZE);
-        pInput += AES_BLOCK_SIZE;
-        pOutput += AES_BLOCK_SIZE;
-        inputLen -= AES_BLOCK_SIZE;
+        fullLen = (inputLen - 1) & ~(uint32_t)(AES_BLOCK_SIZE - 1);
+        AES_128_CBC_Encrypt_WithCtx(&ctx, pInput, fullLen, tempBuffIn, pOutput);
+        pInput += fullLen;
+        pOutput += fullLen;
+        inputLen -= fullLen;
     }
 
     /* If remaining data is smaller then one AES block size  */
     SecLib_XorN(tempBuffIn, pInput, inputLen);
-    AES_128_Encrypt(tempBuffIn, pKey, tempBuffOut);
+    AES_128_Encrypt_WithCtx(&ctx, tempBuffIn, tempBuffOut);
     FLib_MemCpy(pOutput, tempBuffOut, inputLen);
 #endif
 }
@@ -534,21 +948,15 @@ uint32_t AES_128_CBC_Encrypt_And_Pad(uint8_t* pInput,
     SecLib_AllowToSleep();
 #else
     static uint8_t tempBuffIn[AES_BLOCK_SIZE] = {0};
+    AES_128_Ctx_t ctx;
 
     if( pInitVector != NULL )
     {
         FLib_MemCpy(tempBuffIn, pInitVector, AES_BLOCK_SIZE);
     }
-    inputLen = newLen;
-    while( inputLen > 0 )
-    {
-        SecLib_XorN(tempBuffIn, pInput, AES_BLOCK_SIZE);
-        AES_128_Encrypt(tempBuffIn, pKey, pOutput);
-        FLib_MemCpy(tempBuffIn, pOutput, AES_BLOCK_SIZE);
-        pInput += AES_BLOCK_SIZE;
-        pOutput += AES_BLOCK_SIZE;
-        inputLen -= AES_BLOCK_SIZE;
-    }
+
+    AES_128_SetKey(&ctx, pKey);
+    AES_128_CBC_Encrypt_WithCtx(&ctx, pInput, newLen, tempBuffIn, pOutput);
 #endif
     return newLen;
 }
@@ -647,28 +1055,10 @@ void AES_128_CTR(uint8_t* pInput,
     SecLib_AllowToSleep();
 
 #else
-    uint8_t tempBuffIn[AES_BLOCK_SIZE] = {0};
-    uint8_t encrCtr[AES_BLOCK_SIZE] = {0};
-
-    /* If remaining data bigger than one AES block size */
-    while( inputLen > AES_BLOCK_SIZE )
-    {
-        FLib_MemCpy(tempBuffIn, pInput, AES_BLOCK_SIZE);
-        AES_128_Encrypt(pCounter, pKey, encrCtr);
-        SecLib_XorN(tempBuffIn, encrCtr, AES_BLOCK_SIZE);
-        FLib_MemCpy(pOutput, tempBuffIn, AES_BLOCK_SIZE);
-        pInput += AES_BLOCK_SIZE;
-        pOutput += AES_BLOCK_SIZE;
-        inputLen -= AES_BLOCK_SIZE;
-        AES_128_IncrementCounter(pCounter);
-    }
+    AES_128_Ctx_t ctx;
 
-    /* If remaining data is smaller then one AES block size  */
-    FLib_MemCpy(tempBuffIn, pInput, inputLen);
-    AES_128_Encrypt(pCounter, pKey, encrCtr);
-    SecLib_XorN(tempBuffIn, encrCtr, AES_BLOCK_SIZE);
-    FLib_MemCpy(pOutput, tempBuffIn, inputLen);
-    AES_128_IncrementCounter(pCounter);
+    AES_128_SetKey(&ctx, pKey);
+    AES_128_CTR_WithCtx(&ctx, pInput, inputLen, pCounter, pOutput);
 #endif
 }
 
@@ -692,30 +1082,10 @@ void AES_128_OFB(uint8_t* pInput,
                  uint8_t* pKey,
                  uint8_t* pOutput)
 {
-    uint8_t tempBuffIn[AES_BLOCK_SIZE] = {0};
-    uint8_t tempBuffOut[AES_BLOCK_SIZE] = {0};
-
-    if( pInitVector != NULL )
-    {
-        FLib_MemCpy(tempBuffIn, pInitVector, AES_BLOCK_SIZE);
-    }
+    AES_128_Ctx_t ctx;
 
-    /* If remaining data is bigger than one AES block size */
-    while( inputLen > AES_BLOCK_SIZE )
-    {
-        AES_128_Encrypt(tempBuffIn, pKey, tempBuffOut);
-        FLib_MemCpy(tempBuffIn, tempBuffOut, AES_BLOCK_SIZE);
-        SecLib_XorN(tempBuffOut, pInput, AES_BLOCK_SIZE);
-        FLib_MemCpy(pOutput, tempBuffOut, AES_BLOCK_SIZE);
-        pInput += AES_BLOCK_SIZE;
-        pOutput += AES_BLOCK_SIZE;
-        inputLen -= AES_BLOCK_SIZE;
-    }
-
-    /* If remaining data is smaller then one AES block size  */
-    AES_128_Encrypt(tempBuffIn, pKey, tempBuffOut);
-    SecLib_XorN(tempBuffOut, pInput, inputLen);
-    FLib_MemCpy(pOutput, tempBuffOut, inputLen);
+    AES_128_SetKey(&ctx, pKey);
+    AES_128_OFB_WithCtx(&ctx, pInput, inputLen, pInitVector, pOutput);
 }
 
 /*! *********************************************************************************
@@ -737,68 +1107,10 @@ void AES_128_CMAC(uint8_t* pInput,
                   uint8_t* pKey,
                   uint8_t* pOutput)
 {
-    uint8_t X[16];
-    uint8_t Y[16];
-    uint8_t M_last[16] = {0};
-    uint8_t padded[16] = {0};
-
-    uint8_t K1[16] = {0};
-    uint8_t K2[16] = {0};
-
-    uint8_t n;
-    uint32_t i;
-    uint8_t flag;
-
-    AES_128_CMAC_Generate_Subkey(pKey, K1, K2);
-
-    n = (uint8_t) ((inputLen + 15) / 16); /* n is number of rounds */
-
-    if (n == 0)
-    {
-        n = 1;
-        flag = 0;
-    }
-    else
-    {
-        if ((inputLen % 16) == 0)
-        { /* last block is a complete block */
-            flag = 1;
-        }
-        else
-        { /* last block is not complete block */
-            flag = 0;
-        }
-    }
-
-    /* Process the last block  - the last part the MSB first input data */
-    if (flag)
-    { /* last block is complete block */
-        SecLib_Xor128(&pInput[16 * (n - 1)], K1, M_last);
-    }
-    else
-    {
-        SecLib_Padding(&pInput[16 * (n - 1)], padded, inputLen % 16);
-        SecLib_Xor128(padded, K2, M_last);
-    }
-
-    for (i = 0; i < 16; i++)
-    {
-        X[i] = 0;
-    }
-
-    for (i = 0; i < n - 1; i++)
-    {
-        SecLib_Xor128(X, &pInput[16 * i], Y); /* Y := Mi (+) X  */
-        AES_128_Encrypt(Y, pKey, X); /* X := AES-128(KEY, Y) */
-    }
-
-    SecLib_Xor128(X, M_last, Y);
-    AES_128_Encrypt(Y, pKey, X);
+    AES_128_Ctx_t ctx;
 
-    for (i = 0; i < 16; i++)
-    {
-        pOutput[i] = X[i];
-    }
+    AES_128_SetKey(&ctx, pKey);
+    AES_128_CMAC_WithCtx(&ctx, pInput, inputLen, pOutput);
 }
 
 
@@ -832,8 +1144,14 @@ void AES_128_CMAC_LsbFirstInput (uint8_t* pInput,
     uint8_t n;
     uint32_t i;
     uint8_t flag;
+    AES_128_Ctx_t ctx;
+
+    AES_128_SetKey(&ctx, pKey);
+
+    SecLib_DisallowToSleep();
+    SECLIB_MUTEX_LOCK();
 
-    AES_128_CMAC_Generate_Subkey(pKey, K1, K2);
+    AES_128_CMAC_Generate_Subkey(&ctx, K1, K2);
 
     n = (uint8_t) ((inputLen + 15) / 16); /* n is number of rounds */
 
@@ -876,11 +1194,14 @@ void AES_128_CMAC_LsbFirstInput (uint8_t* pInput,
     {
         FLib_MemCpyReverseOrder (reversedBlock, &pInput[inputLen - 16 * (i + 1)], 16);
         SecLib_Xor128(X, reversedBlock, Y); /* Y := Mi (+) X  */
-        AES_128_Encrypt(Y, pKey, X); /* X := AES-128(KEY, Y) */
+        AES_128_EncryptBlock(&ctx, Y, X); /* X := AES-128(KEY, Y) */
     }
 
     SecLib_Xor128(X, M_last, Y);
-    AES_128_Encrypt(Y, pKey, X);
+    AES_128_EncryptBlock(&ctx, Y, X);
+
+    SECLIB_MUTEX_UNLOCK();
+    SecLib_AllowToSleep();
 
     for (i = 0; i < 16; i++) {
         pOutput[i] = X[i];
@@ -966,67 +1287,12 @@ secResultType_t AES_128_EAX_Encrypt(uint8_t* pInput,
                                     uint8_t* pOutput,
                                     uint8_t* pTag)
 {
-    uint8_t *buf;
-    uint32_t buf_len;
-    uint8_t nonce_mac[AES_BLOCK_SIZE] = {0};
-    uint8_t hdr_mac[AES_BLOCK_SIZE] = {0};
-    uint8_t data_mac[AES_BLOCK_SIZE] = {0};
-    uint8_t tempBuff[AES_BLOCK_SIZE] = {0};
-    secResultType_t status = gSecSuccess_c;
-    uint32_t i;
-
-    if( nonceLen > inputLen )
-    {
-        buf_len = nonceLen;
-    }
-    else
-    {
-        buf_len = inputLen;
-    }
-
-    if( headerLen > buf_len )
-    {
-        buf_len = headerLen;
-    }
+    AES_128_Ctx_t ctx;
 
-    buf_len += 16U;
-
-    buf = MEM_BufferAlloc(buf_len);
-
-    if( buf == NULL )
-    {
-        status = gSecAllocError_c;
-    }
-    else
-    {
-        FLib_MemSet(buf, 0, 15);
-
-        buf[15] = 0;
-        FLib_MemCpy((buf + 16), pNonce, nonceLen);
-        AES_128_CMAC(buf, 16 + nonceLen, pKey, nonce_mac);
-
-        buf[15] = 1;
-        FLib_MemCpy((buf + 16), pHeader, headerLen);
-        AES_128_CMAC(buf, 16 + headerLen, pKey, hdr_mac);
-
-        /* keep the original value of nonce_mac, because AES_128_CTR will increment it */
-        FLib_MemCpy(tempBuff, nonce_mac, nonceLen);
-
-        AES_128_CTR(pInput, inputLen, tempBuff, pKey, pOutput);
-
-        buf[15] = 2;
-        FLib_MemCpy((buf + 16), pOutput, inputLen);
-        AES_128_CMAC(buf, 16 + inputLen, pKey, data_mac);
-
-        for (i = 0; i < AES_BLOCK_SIZE; i++)
-        {
-            pTag[i] = nonce_mac[i] ^ data_mac[i] ^ hdr_mac[i];
-        }
-
-        MEM_BufferFree(buf);
-    }
+    AES_128_SetKey(&ctx, pKey);
 
-    return status;
+    return AES_128_EAX_Encrypt_WithCtx(&ctx, pInput, inputLen, pNonce, nonceLen,
+                                       pHeader, headerLen, pOutput, pTag);
 }
 
 /*! *********************************************************************************
@@ -1061,70 +1327,12 @@ secResultType_t AES_128_EAX_Decrypt(uint8_t* pInput,
                                     uint8_t* pOutput,
                                     uint8_t* pTag)
 {
-    uint8_t *buf;
-    uint32_t buf_len;
-    uint8_t nonce_mac[AES_BLOCK_SIZE] = {0};
-    uint8_t hdr_mac[AES_BLOCK_SIZE] = {0};
-    uint8_t data_mac[AES_BLOCK_SIZE] = {0};
-    secResultType_t status = gSecSuccess_c;
-    uint32_t i;
-
-    if( nonceLen > inputLen )
-    {
-        buf_len = nonceLen;
-    }
-    else
-    {
-        buf_len = inputLen;
-    }
-
-    if( headerLen > buf_len )
-    {
-        buf_len = headerLen;
-    }
-
-    buf_len += 16U;
-
-    buf = MEM_BufferAlloc(buf_len);
-
-    if( buf == NULL )
-    {
-        status = gSecAllocError_c;
-    }
-    else
-    {
-        FLib_MemSet(buf, 0, 15);
-
-        buf[15] = 0;
-        FLib_MemCpy((buf + 16), pNonce, nonceLen);
-        AES_128_CMAC(buf, 16 + nonceLen, pKey, nonce_mac);
-
-        buf[15] = 1;
-        FLib_MemCpy((buf + 16), pHeader, headerLen);
-        AES_128_CMAC(buf, 16 + headerLen, pKey, hdr_mac);
-
-        buf[15] = 2;
-        FLib_MemCpy((buf + 16), pInput, inputLen);
-        AES_128_CMAC(buf, 16 + inputLen, pKey, data_mac);
-
-        MEM_BufferFree(buf);
-
-        for (i = 0; i < AES_BLOCK_SIZE; i++)
-        {
-            if (pTag[i] != (nonce_mac[i] ^ data_mac[i] ^ hdr_mac[i]))
-            {
-                status = gSecError_c;
-                break;
-            }
-        }
+    AES_128_Ctx_t ctx;
 
-        if( gSecSuccess_c == status )
-        {
-            AES_128_CTR(pInput, inputLen, nonce_mac, pKey, pOutput);
-        }
-    }
+    AES_128_SetKey(&ctx, pKey);
 
-    return status;
+    return AES_128_EAX_Decrypt_WithCtx(&ctx, pInput, inputLen, pNonce, nonceLen,
+                                       pHeader, headerLen, pOutput, pTag);
 }
 
 /*! *********************************************************************************
@@ -1198,74 +1406,2332 @@ uint8_t AES_128_CCM(uint8_t* pInput,
 }
 
 /*! *********************************************************************************
-* \brief  This function calculates XOR of individual byte pairs in two uint8_t arrays.
-*         pDst[i] := pDst[i] ^ pSrc[i] for i=0 to n-1
-*
-* \param[in, out]  pDst First byte array operand for XOR and destination byte array
+* \brief  This function expands an AES-128 key into a context, to be used by the
+*         *_WithCtx functions.
 *
-* \param[in]  pSrc Second byte array operand for XOR
+* \param[out] pCtx Pointer to the AES-128 context.
 *
-* \param[in]  n  Length of the byte arrays which will be XORed
+* \param[in]  pKey Pointer to the location of the 128-bit key.
 *
 ********************************************************************************** */
-void SecLib_XorN(uint8_t* pDst,
-                 uint8_t* pSrc,
-                 uint8_t n)
+void AES_128_SetKey(AES_128_Ctx_t* pCtx,
+                    const uint8_t* pKey)
 {
-    while( n )
+#if FSL_FEATURE_SOC_MMCAU_COUNT
+    SecLib_DisallowToSleep();
+    SECLIB_MUTEX_LOCK();
+
+    /* Check if pKey is 4 bytes aligned */
+    if ((uintptr_t)pKey & 0x00000003)
     {
-        *pDst = *pDst ^ *pSrc;
-        pDst = pDst + 1;
-        pSrc = pSrc + 1;
-        n--;
+        FLib_MemCpy(mmcauAesCtx.alignedIn, (uint8_t*)pKey, AES_BLOCK_SIZE);
+        pKey = mmcauAesCtx.alignedIn;
     }
+
+    mmcau_aes_set_key(pKey, AES128, (uint8_t*)pCtx->roundKeys);
+
+    SECLIB_MUTEX_UNLOCK();
+    SecLib_AllowToSleep();
+
+#elif FSL_FEATURE_SOC_LTC_COUNT
+    /* The LTC expands the key internally, only the raw key is kept */
+    FLib_MemCpy(pCtx->roundKeys, (uint8_t*)pKey, AES_BLOCK_SIZE);
+
+#else
+    AES_128_SwExpandKey(pKey, pCtx->roundKeys);
+#endif
 }
 
 /*! *********************************************************************************
+* \brief  This function performs AES-128 encryption on a 16-byte block.
+*
+* \param[in]  pCtx Pointer to the AES-128 context.
+*
+* \param[in]  pInput Pointer to the location of the 16-byte plain text block.
+*
+* \param[out]  pOutput Pointer to the location to store the 16-byte ciphered output.
+*
+********************************************************************************** */
+void AES_128_Encrypt_WithCtx(AES_128_Ctx_t* pCtx,
+                             const uint8_t* pInput,
+                             uint8_t* pOutput)
+{
+    SecLib_DisallowToSleep();
+    SECLIB_MUTEX_LOCK();
+    AES_128_EncryptBlock(pCtx, pInput, pOutput);
+    SECLIB_MUTEX_UNLOCK();
+    SecLib_AllowToSleep();
+}
+
+/*! *********************************************************************************
+* \brief  This function performs AES-128 decryption on a 16-byte block.
+*
+* \param[in]  pCtx Pointer to the AES-128 context.
+*
+* \param[in]  pInput Pointer to the location of the 16-byte ciphered block.
+*
+* \param[out]  pOutput Pointer to the location to store the 16-byte plain text output.
+*
+********************************************************************************** */
+void AES_128_Decrypt_WithCtx(AES_128_Ctx_t* pCtx,
+                             const uint8_t* pInput,
+                             uint8_t* pOutput)
+{
+#if FSL_FEATURE_SOC_MMCAU_COUNT
+    mmcauAesContext_t *pAligned = &mmcauAesCtx;
+    const uint8_t* pIn = pInput;
+    uint8_t* pOut = pOutput;
+#endif
+
+    SecLib_DisallowToSleep();
+    SECLIB_MUTEX_LOCK();
+
+#if FSL_FEATURE_SOC_MMCAU_COUNT
+    if ((uintptr_t)pInput & 0x00000003)
+    {
+        FLib_MemCpy(pAligned->alignedIn, (uint8_t*)pInput, AES_BLOCK_SIZE);
+        pIn = pAligned->alignedIn;
+    }
+
+    if ((uintptr_t)pOutput & 0x00000003)
+    {
+        pOut = pAligned->alignedOut;
+    }
+
+    mmcau_aes_decrypt(pIn, (uint8_t*)pCtx->roundKeys, AES128_ROUNDS, pOut);
+
+    if (pOut == pAligned->alignedOut)
+    {
+        FLib_MemCpy(pOutput, pAligned->alignedOut, AES_BLOCK_SIZE);
+    }
+
+#elif FSL_FEATURE_SOC_LTC_COUNT
+    LTC_AES_DecryptEcb(LTC0, pInput, pOutput, AES_BLOCK_SIZE, (uint8_t*)pCtx->roundKeys, AES_BLOCK_SIZE, kLTC_EncryptKey);
+
+#else
+    AES_128_SwDecrypt(pCtx->roundKeys, pInput, pOutput);
+#endif
+
+    SECLIB_MUTEX_UNLOCK();
+    SecLib_AllowToSleep();
+}
+
+/*! *********************************************************************************
+* \brief  This function performs AES-128-ECB encryption on a message block.
+*
+* \param[in]  pCtx Pointer to the AES-128 context.
+*
+* \param[in]  pInput Pointer to the location of the input message.
+*
+* \param[in]  numBlocks Input message number of 16-byte blocks.
+*
+* \param[out]  pOutput Pointer to the location to store the ciphered output.
+*
+********************************************************************************** */
+void AES_128_ECB_Block_Encrypt_WithCtx(AES_128_Ctx_t* pCtx,
+                                       const uint8_t* pInput,
+                                       uint32_t numBlocks,
+                                       uint8_t* pOutput)
+{
+    SecLib_DisallowToSleep();
+    SECLIB_MUTEX_LOCK();
+
+#if FSL_FEATURE_SOC_LTC_COUNT
+    if( numBlocks )
+    {
+        LTC_AES_EncryptEcb(LTC0, pInput, pOutput, numBlocks * AES_BLOCK_SIZE, (uint8_t*)pCtx->roundKeys, AES_BLOCK_SIZE);
+    }
+#else
+    while( numBlocks )
+    {
+        AES_128_EncryptBlock(pCtx, pInput, pOutput);
+        numBlocks--;
+        pInput += AES_BLOCK_SIZE;
+        pOutput += AES_BLOCK_SIZE;
+    }
+#endif
+
+    SECLIB_MUTEX_UNLOCK();
+    SecLib_AllowToSleep();
+}
+
+/*! *********************************************************************************
+* \brief  This function performs AES-128-CBC encryption on a message block.
+*
+* \param[in]  pCtx Pointer to the AES-128 context.
+*
+* \param[in]  pInput Pointer to the location of the input message.
+*
+* \param[in]  inputLen Input message length in bytes. Must be a multiple of the AES block size.
+*
+* \param[in, out]  pInitVector Pointer to the location of the 128-bit initialization vector.
+*                  It is updated with the last ciphered block, so that consecutive calls chain.
+*
+* \param[out]  pOutput Pointer to the location to store the ciphered output.
+*
+********************************************************************************** */
+void AES_128_CBC_Encrypt_WithCtx(AES_128_Ctx_t* pCtx,
+                                 const uint8_t* pInput,
+                                 uint32_t inputLen,
+                                 uint8_t* pInitVector,
+                                 uint8_t* pOutput)
+{
+#if !FSL_FEATURE_SOC_LTC_COUNT
+    uint8_t tempBuff[AES_BLOCK_SIZE];
+#endif
+
+    inputLen &= ~(uint32_t)(AES_BLOCK_SIZE - 1);
+
+    if( inputLen == 0 )
+    {
+        return;
+    }
+
+    SecLib_DisallowToSleep();
+    SECLIB_MUTEX_LOCK();
+
+#if FSL_FEATURE_SOC_LTC_COUNT
+    LTC_AES_EncryptCbc(LTC0, pInput, pOutput, inputLen, pInitVector, (uint8_t*)pCtx->roundKeys, AES_BLOCK_SIZE);
+    FLib_MemCpy(pInitVector, pOutput + inputLen - AES_BLOCK_SIZE, AES_BLOCK_SIZE);
+#else
+    while( inputLen )
+    {
+        FLib_MemCpy(tempBuff, (uint8_t*)pInput, AES_BLOCK_SIZE);
+        SecLib_XorN(tempBuff, pInitVector, AES_BLOCK_SIZE);
+        AES_128_EncryptBlock(pCtx, tempBuff, pOutput);
+        FLib_MemCpy(pInitVector, pOutput, AES_BLOCK_SIZE);
+        pInput += AES_BLOCK_SIZE;
+        pOutput += AES_BLOCK_SIZE;
+        inputLen -= AES_BLOCK_SIZE;
+    }
+#endif
+
+    SECLIB_MUTEX_UNLOCK();
+    SecLib_AllowToSleep();
+}
+
+/*! *********************************************************************************
+* \brief  This function performs AES-128-CTR encryption on a message block.
+*
+* \param[in]  pCtx Pointer to the AES-128 context.
+*
+* \param[in]  pInput Pointer to the location of the input message.
+*
+* \param[in]  inputLen Input message length in bytes.
+*
+* \param[in, out]  pCounter Pointer to the location of the 128-bit counter.
+*
+* \param[out]  pOutput Pointer to the location to store the ciphered output.
+*
+********************************************************************************** */
+void AES_128_CTR_WithCtx(AES_128_Ctx_t* pCtx,
+                         const uint8_t* pInput,
+                         uint32_t inputLen,
+                         uint8_t* pCounter,
+                         uint8_t* pOutput)
+{
+#if !FSL_FEATURE_SOC_LTC_COUNT
+    uint8_t tempBuffIn[AES_BLOCK_SIZE] = {0};
+    uint8_t encrCtr[AES_BLOCK_SIZE];
+#endif
+
+    SecLib_DisallowToSleep();
+    SECLIB_MUTEX_LOCK();
+
+#if FSL_FEATURE_SOC_LTC_COUNT
+    LTC_AES_EncryptCtr(LTC0, pInput, pOutput, inputLen, pCounter, (uint8_t*)pCtx->roundKeys, AES_BLOCK_SIZE, NULL, NULL);
+#else
+    /* If remaining data bigger than one AES block size */
+    while( inputLen > AES_BLOCK_SIZE )
+    {
+        FLib_MemCpy(tempBuffIn, (uint8_t*)pInput, AES_BLOCK_SIZE);
+        AES_128_EncryptBlock(pCtx, pCounter, encrCtr);
+        SecLib_XorN(tempBuffIn, encrCtr, AES_BLOCK_SIZE);
+        FLib_MemCpy(pOutput, tempBuffIn, AES_BLOCK_SIZE);
+        pInput += AES_BLOCK_SIZE;
+        pOutput += AES_BLOCK_SIZE;
+        inputLen -= AES_BLOCK_SIZE;
+        AES_128_IncrementCounter(pCounter);
+    }
+
+    /* If remaining data is smaller then one AES block size  */
+    FLib_MemCpy(tempBuffIn, (uint8_t*)pInput, inputLen);
+    AES_128_EncryptBlock(pCtx, pCounter, encrCtr);
+    SecLib_XorN(tempBuffIn, encrCtr, AES_BLOCK_SIZE);
+    FLib_MemCpy(pOutput, tempBuffIn, inputLen);
+    AES_128_IncrementCounter(pCounter);
+#endif
+
+    SECLIB_MUTEX_UNLOCK();
+    SecLib_AllowToSleep();
+}
+
+/*! *********************************************************************************
+* \brief  This function performs AES-128-OFB encryption on a message block.
+*
+* \param[in]  pCtx Pointer to the AES-128 context.
+*
+* \param[in]  pInput Pointer to the location of the input message.
+*
+* \param[in]  inputLen Input message length in bytes.
+*
+* \param[in]  pInitVector Pointer to the location of the 128-bit initialization vector.
+*
+* \param[out]  pOutput Pointer to the location to store the ciphered output.
+*
+********************************************************************************** */
+void AES_128_OFB_WithCtx(AES_128_Ctx_t* pCtx,
+                         const uint8_t* pInput,
+                         uint32_t inputLen,
+                         const uint8_t* pInitVector,
+                         uint8_t* pOutput)
+{
+    uint8_t tempBuffIn[AES_BLOCK_SIZE] = {0};
+    uint8_t tempBuffOut[AES_BLOCK_SIZE];
+
+    if( pInitVector != NULL )
+    {
+        FLib_MemCpy(tempBuffIn, (uint8_t*)pInitVector, AES_BLOCK_SIZE);
+    }
+
+    SecLib_DisallowToSleep();
+    SECLIB_MUTEX_LOCK();
+
+    /* If remaining data is bigger than one AES block size */
+    while( inputLen > AES_BLOCK_SIZE )
+    {
+        AES_128_EncryptBlock(pCtx, tempBuffIn, tempBuffOut);
+        FLib_MemCpy(tempBuffIn, tempBuffOut, AES_BLOCK_SIZE);
+        SecLib_XorN(tempBuffOut, (uint8_t*)pInput, AES_BLOCK_SIZE);
+        FLib_MemCpy(pOutput, tempBuffOut, AES_BLOCK_SIZE);
+        pInput += AES_BLOCK_SIZE;
+        pOutput += AES_BLOCK_SIZE;
+        inputLen -= AES_BLOCK_SIZE;
+    }
+
+    /* If remaining data is smaller then one AES block size  */
+    AES_128_EncryptBlock(pCtx, tempBuffIn, tempBuffOut);
+    SecLib_XorN(tempBuffOut, (uint8_t*)pInput, inputLen);
+    FLib_MemCpy(pOutput, tempBuffOut, inputLen);
+
+    SECLIB_MUTEX_UNLOCK();
+    SecLib_AllowToSleep();
+}
+
+/*! *********************************************************************************
+* \brief  This function performs AES-128-CMAC on a message block.
+*
+* \param[in]  pCtx Pointer to the AES-128 context.
+*
+* \param[in]  pInput Pointer to the location of the input message. The input data must be provided MSB first.
+*
+* \param[in]  inputLen Length of the input message in bytes.
+*
+* \param[out]  pOutput Pointer to the location to store the 16-byte authentication code.
+*
+********************************************************************************** */
+void AES_128_CMAC_WithCtx(AES_128_Ctx_t* pCtx,
+                          const uint8_t* pInput,
+                          uint32_t inputLen,
+                          uint8_t* pOutput)
+{
+    SecLib_DisallowToSleep();
+    SECLIB_MUTEX_LOCK();
+    AES_128_CMAC_Compute(pCtx, NULL, pInput, inputLen, pOutput);
+    SECLIB_MUTEX_UNLOCK();
+    SecLib_AllowToSleep();
+}
+
+/*! *********************************************************************************
+* \brief  This function performs AES-128-EAX encryption on a message block.
+*
+* \param[in]  pCtx Pointer to the AES-128 context.
+*
+* \param[in]  pInput Pointer to the location of the input message.
+*
+* \param[in]  inputLen Length of the input message in bytes.
+*
+* \param[in]  pNonce Pointer to the location of the nonce.
+*
+* \param[in]  nonceLen Nonce length in bytes.
+*
+* \param[in]  pHeader Pointer to the location of header.
+*
+* \param[in]  headerLen Header length in bytes.
+*
+* \param[out]  pOutput Pointer to the location to store the ciphered output.
+*
+* \param[out]  pTag Pointer to the location to store the 128-bit tag.
+*
+* \return gSecSuccess_c or error.
+*
+********************************************************************************** */
+secResultType_t AES_128_EAX_Encrypt_WithCtx(AES_128_Ctx_t* pCtx,
+                                            const uint8_t* pInput,
+                                            uint32_t inputLen,
+                                            const uint8_t* pNonce,
+                                            uint32_t nonceLen,
+                                            const uint8_t* pHeader,
+                                            uint8_t headerLen,
+                                            uint8_t* pOutput,
+                                            uint8_t* pTag)
+{
+    uint8_t nonce_mac[AES_BLOCK_SIZE];
+    uint8_t hdr_mac[AES_BLOCK_SIZE];
+    uint8_t data_mac[AES_BLOCK_SIZE];
+    uint8_t tempBuff[AES_BLOCK_SIZE] = {0};
+    uint32_t i;
+
+    AES_128_EAX_Omac(pCtx, 0, pNonce, nonceLen, nonce_mac);
+    AES_128_EAX_Omac(pCtx, 1, pHeader, headerLen, hdr_mac);
+
+    /* keep the original value of nonce_mac, because AES_128_CTR will increment it */
+    FLib_MemCpy(tempBuff, nonce_mac, (nonceLen < AES_BLOCK_SIZE) ? nonceLen : AES_BLOCK_SIZE);
+    AES_128_CTR_WithCtx(pCtx, pInput, inputLen, tempBuff, pOutput);
+
+    AES_128_EAX_Omac(pCtx, 2, pOutput, inputLen, data_mac);
+
+    for (i = 0; i < AES_BLOCK_SIZE; i++)
+    {
+        pTag[i] = nonce_mac[i] ^ data_mac[i] ^ hdr_mac[i];
+    }
+
+    return gSecSuccess_c;
+}
+
+/*! *********************************************************************************
+* \brief  This function performs AES-128-EAX decryption on a message block.
+*
+* \param[in]  pCtx Pointer to the AES-128 context.
+*
+* \param[in]  pInput Pointer to the location of the ciphered message.
+*
+* \param[in]  inputLen Length of the input message in bytes.
+*
+* \param[in]  pNonce Pointer to the location of the nonce.
+*
+* \param[in]  nonceLen Nonce length in bytes.
+*
+* \param[in]  pHeader Pointer to the location of header.
+*
+* \param[in]  headerLen Header length in bytes.
+*
+* \param[out]  pOutput Pointer to the location to store the plain text output.
+*
+* \param[in]  pTag Pointer to the location of the 128-bit tag to be checked.
+*
+* \return gSecSuccess_c, or gSecError_c if the tag does not match.
+*
+********************************************************************************** */
+secResultType_t AES_128_EAX_Decrypt_WithCtx(AES_128_Ctx_t* pCtx,
+                                            const uint8_t* pInput,
+                                            uint32_t inputLen,
+                                            const uint8_t* pNonce,
+                                            uint32_t nonceLen,
+                                            const uint8_t* pHeader,
+                                            uint8_t headerLen,
+                                            uint8_t* pOutput,
+                                            const uint8_t* pTag)
+{
+    uint8_t nonce_mac[AES_BLOCK_SIZE];
+    uint8_t hdr_mac[AES_BLOCK_SIZE];
+    uint8_t data_mac[AES_BLOCK_SIZE];
+    secResultType_t status = gSecSuccess_c;
+    uint32_t i;
+
+    AES_128_EAX_Omac(pCtx, 0, pNonce, nonceLen, nonce_mac);
+    AES_128_EAX_Omac(pCtx, 1, pHeader, headerLen, hdr_mac);
+    AES_128_EAX_Omac(pCtx, 2, pInput, inputLen, data_mac);
+
+    for (i = 0; i < AES_BLOCK_SIZE; i++)
+    {
+        if (pTag[i] != (nonce_mac[i] ^ data_mac[i] ^ hdr_mac[i]))
+        {
+            status = gSecError_c;
+            break;
+        }
+    }
+
+    if( gSecSuccess_c == status )
+    {
+        AES_128_CTR_WithCtx(pCtx, pInput, inputLen, nonce_mac, pOutput);
+    }
+
+    return status;
+}
+
+/*! *********************************************************************************
+* \brief  This function initializes an AES-128-CMAC streaming context.
+*
+* \param[out] pCtx Pointer to the AES-128-CMAC context.
+*
+* \param[in]  pKey Pointer to the location of the 128-bit key.
+*
+********************************************************************************** */
+void AES_128_CMAC_Init(AES_128_CMAC_Ctx_t* pCtx,
+                       const uint8_t* pKey)
+{
+    AES_128_SetKey(&pCtx->aesCtx, pKey);
+    FLib_MemSet(pCtx->mac, 0, AES_BLOCK_SIZE);
+    pCtx->bufferLen = 0;
+}
+
+/*! *********************************************************************************
+* \brief  This function adds data to an AES-128-CMAC computation. The message
+*         may be split in chunks of any size.
+*
+* \param[in, out] pCtx Pointer to the AES-128-CMAC context.
+*
+* \param[in]  pInput Pointer to the location of the message chunk. MSB first.
+*
+* \param[in]  inputLen Length of the message chunk in bytes.
+*
+********************************************************************************** */
+void AES_128_CMAC_Update(AES_128_CMAC_Ctx_t* pCtx,
+                         const uint8_t* pInput,
+                         uint32_t inputLen)
+{
+    uint32_t n;
+
+    if( inputLen == 0 )
+    {
+        return;
+    }
+
+    SecLib_DisallowToSleep();
+    SECLIB_MUTEX_LOCK();
+
+    /* Complete the buffered block first */
+    if( pCtx->bufferLen )
+    {
+        n = AES_BLOCK_SIZE - pCtx->bufferLen;
+
+        if( n > inputLen )
+        {
+            n = inputLen;
+        }
+
+        FLib_MemCpy(&pCtx->buffer[pCtx->bufferLen], (uint8_t*)pInput, n);
+        pCtx->bufferLen += n;
+        pInput += n;
+        inputLen -= n;
+
+        /* A full block is only processed once it is known not to be the last one */
+        if( inputLen )
+        {
+            AES_128_CbcMacBlocks(&pCtx->aesCtx, pCtx->mac, pCtx->buffer, 1);
+            pCtx->bufferLen = 0;
+        }
+    }
+
+    if( inputLen )
+    {
+        /* Process the blocks in place, keeping at least one byte for the last block */
+        n = (inputLen - 1) / AES_BLOCK_SIZE;
+        AES_128_CbcMacBlocks(&pCtx->aesCtx, pCtx->mac, pInput, n);
+        pInput += n * AES_BLOCK_SIZE;
+        inputLen -= n * AES_BLOCK_SIZE;
+
+        FLib_MemCpy(pCtx->buffer, (uint8_t*)pInput, inputLen);
+        pCtx->bufferLen = inputLen;
+    }
+
+    SECLIB_MUTEX_UNLOCK();
+    SecLib_AllowToSleep();
+}
+
+/*! *********************************************************************************
+* \brief  This function finishes an AES-128-CMAC computation.
+*
+* \param[in]  pCtx Pointer to the AES-128-CMAC context.
+*
+* \param[out]  pOutput Pointer to the location to store the 16-byte authentication code.
+*
+********************************************************************************** */
+void AES_128_CMAC_Finish(AES_128_CMAC_Ctx_t* pCtx,
+                         uint8_t* pOutput)
+{
+    uint8_t M_last[AES_BLOCK_SIZE];
+    uint8_t K1[AES_BLOCK_SIZE];
+    uint8_t K2[AES_BLOCK_SIZE];
+
+    SecLib_DisallowToSleep();
+    SECLIB_MUTEX_LOCK();
+
+    AES_128_CMAC_Generate_Subkey(&pCtx->aesCtx, K1, K2);
+
+    if( pCtx->bufferLen == AES_BLOCK_SIZE )
+    {
+        SecLib_Xor128(pCtx->buffer, K1, M_last);
+    }
+    else
+    {
+        SecLib_Padding(pCtx->buffer, M_last, pCtx->bufferLen);
+        SecLib_XorN(M_last, K2, AES_BLOCK_SIZE);
+    }
+
+    SecLib_XorN(pCtx->mac, M_last, AES_BLOCK_SIZE);
+    AES_128_EncryptBlock(&pCtx->aesCtx, pCtx->mac, pOutput);
+
+    SECLIB_MUTEX_UNLOCK();
+    SecLib_AllowToSleep();
+}
+
+/*! *********************************************************************************
+* \brief  This function initializes an AES-128-CTR streaming context.
+*
+* \param[out] pCtx Pointer to the AES-128-CTR context.
+*
+* \param[in]  pKey Pointer to the location of the 128-bit key.
+*
+* \param[in]  pCounter Pointer to the location of the initial 128-bit counter.
+*
+********************************************************************************** */
+void AES_128_CTR_Init(AES_128_CTR_Ctx_t* pCtx,
+                      const uint8_t* pKey,
+                      const uint8_t* pCounter)
+{
+    AES_128_SetKey(&pCtx->aesCtx, pKey);
+    FLib_MemCpy(pCtx->counter, (uint8_t*)pCounter, AES_BLOCK_SIZE);
+    pCtx->keyStreamUsed = AES_BLOCK_SIZE;
+}
+
+/*! *********************************************************************************
+* \brief  This function encrypts or decrypts the next chunk of an AES-128-CTR
+*         stream. The stream may be split in chunks of any size.
+*
+* \param[in, out] pCtx Pointer to the AES-128-CTR context.
+*
+* \param[in]  pInput Pointer to the location of the input chunk.
+*
+* \param[in]  inputLen Length of the input chunk in bytes.
+*
+* \param[out]  pOutput Pointer to the location to store the output chunk. May be the same as pInput.
+*
+********************************************************************************** */
+void AES_128_CTR_Update(AES_128_CTR_Ctx_t* pCtx,
+                        const uint8_t* pInput,
+                        uint32_t inputLen,
+                        uint8_t* pOutput)
+{
+    if( inputLen == 0 )
+    {
+        return;
+    }
+
+    SecLib_DisallowToSleep();
+    SECLIB_MUTEX_LOCK();
+    AES_128_CTR_Process(pCtx, pInput, inputLen, pOutput);
+    SECLIB_MUTEX_UNLOCK();
+    SecLib_AllowToSleep();
+}
+
+/*! *********************************************************************************
+* \brief  This function initializes an AES-128-CCM streaming context. The total
+*         lengths are part of the first CCM block, so they must be known upfront.
+*
+* \param[out] pCtx Pointer to the AES-128-CCM context.
+*
+* \param[in]  pKey Pointer to the location of the 128-bit key.
+*
+* \param[in]  pNonce Pointer to the Nonce.
+*
+* \param[in]  nonceSize The size of the nonce (7-13).
+*
+* \param[in]  authDataLen Total length of the additional authentication data.
+*
+* \param[in]  inputLen Total length of the plaintext (or of the cyphertext without the MAC).
+*
+* \param[in]  macSize The size of the MAC (4, 6, ..., 16).
+*
+* \param[in]  flags Select encrypt/decrypt operations (gSecLib_CCM_Encrypt_c, gSecLib_CCM_Decrypt_c)
+*
+* \return gSecSuccess_c, or gSecError_c if the parameters are not valid.
+*
+********************************************************************************** */
+secResultType_t AES_128_CCM_Init(AES_128_CCM_Ctx_t* pCtx,
+                                 const uint8_t* pKey,
+                                 const uint8_t* pNonce,
+                                 uint8_t  nonceSize,
+                                 uint32_t authDataLen,
+                                 uint32_t inputLen,
+                                 uint8_t  macSize,
+                                 uint32_t flags)
+{
+    uint8_t block[AES_BLOCK_SIZE] = {0};
+    uint8_t lenSize = AES_BLOCK_SIZE - 1 - nonceSize; /* L */
+    uint8_t i;
+
+    if( (nonceSize < 7) || (nonceSize > 13) ||
+        (macSize < 4) || (macSize > AES_BLOCK_SIZE) || (macSize & 1) ||
+        ((lenSize < 4) && (inputLen >> (8 * lenSize))) )
+    {
+        return gSecError_c;
+    }
+
+    AES_128_SetKey(&pCtx->ctrCtx.aesCtx, pKey);
+    pCtx->authDataLeft = authDataLen;
+    pCtx->inputLeft = inputLen;
+    pCtx->macUsed = 0;
+    pCtx->macSize = macSize;
+    pCtx->flags = (uint8_t)flags;
+
+    /* B0 = Flags | Nonce | l(m) */
+    block[0] = (uint8_t)(((authDataLen != 0) ? 0x40 : 0x00) | (((macSize - 2) / 2) << 3) | (lenSize - 1));
+    FLib_MemCpy(&block[1], (uint8_t*)pNonce, nonceSize);
+
+    for( i = 0; (i < lenSize) && (i < sizeof(inputLen)); i++ )
+    {
+        block[AES_BLOCK_SIZE - 1 - i] = (uint8_t)(inputLen >> (8 * i));
+    }
+
+    SecLib_DisallowToSleep();
+    SECLIB_MUTEX_LOCK();
+
+    AES_128_EncryptBlock(&pCtx->ctrCtx.aesCtx, block, pCtx->mac);
+
+    /* A0 = Flags | Nonce | 0, used to mask the MAC. The message starts at A1. */
+    FLib_MemSet(block, 0, AES_BLOCK_SIZE);
+    block[0] = lenSize - 1;
+    FLib_MemCpy(&block[1], (uint8_t*)pNonce, nonceSize);
+    AES_128_EncryptBlock(&pCtx->ctrCtx.aesCtx, block, pCtx->tagMask);
+
+    block[AES_BLOCK_SIZE - 1] = 1;
+    FLib_MemCpy(pCtx->ctrCtx.counter, block, AES_BLOCK_SIZE);
+    pCtx->ctrCtx.keyStreamUsed = AES_BLOCK_SIZE;
+
+    /* The encoded length of the authentication data starts the first B block */
+    if( authDataLen != 0 )
+    {
+        if( authDataLen < 0xFF00 )
+        {
+            block[0] = (uint8_t)(authDataLen >> 8);
+            block[1] = (uint8_t)(authDataLen);
+            AES_128_CCM_MacUpdate(pCtx, block, 2);
+        }
+        else
+        {
+            block[0] = 0xFF;
+            block[1] = 0xFE;
+            block[2] = (uint8_t)(authDataLen >> 24);
+            block[3] = (uint8_t)(authDataLen >> 16);
+            block[4] = (uint8_t)(authDataLen >> 8);
+            block[5] = (uint8_t)(authDataLen);
+            AES_128_CCM_MacUpdate(pCtx, block, 6);
+        }
+    }
+
+    SECLIB_MUTEX_UNLOCK();
+    SecLib_AllowToSleep();
+
+    return gSecSuccess_c;
+}
+
+/*! *********************************************************************************
+* \brief  This function adds a chunk of additional authentication data to an
+*         AES-128-CCM operation. All the authentication data must be added before
+*         the first call to AES_128_CCM_Update().
+*
+* \param[in, out] pCtx Pointer to the AES-128-CCM context.
+*
+* \param[in]  pAuthData Pointer to the authentication data chunk.
+*
+* \param[in]  authDataLen Length of the authentication data chunk.
+*
+* \return gSecSuccess_c, or gSecError_c if more data than announced is added.
+*
+********************************************************************************** */
+secResultType_t AES_128_CCM_UpdateAuthData(AES_128_CCM_Ctx_t* pCtx,
+                                           const uint8_t* pAuthData,
+                                           uint32_t authDataLen)
+{
+    if( authDataLen > pCtx->authDataLeft )
+    {
+        return gSecError_c;
+    }
+
+    if( authDataLen == 0 )
+    {
+        return gSecSuccess_c;
+    }
+
+    SecLib_DisallowToSleep();
+    SECLIB_MUTEX_LOCK();
+
+    AES_128_CCM_MacUpdate(pCtx, pAuthData, authDataLen);
+    pCtx->authDataLeft -= authDataLen;
+
+    /* The authentication data is zero padded to a block boundary */
+    if( pCtx->authDataLeft == 0 )
+    {
+        AES_128_CCM_MacPad(pCtx);
+    }
+
+    SECLIB_MUTEX_UNLOCK();
+    SecLib_AllowToSleep();
+
+    return gSecSuccess_c;
+}
+
+/*! *********************************************************************************
+* \brief  This function encrypts or decrypts the next chunk of an AES-128-CCM message.
+*
+* \param[in, out] pCtx Pointer to the AES-128-CCM context.
+*
+* \param[in]  pInput Pointer to the location of the input chunk.
+*
+* \param[in]  inputLen Length of the input chunk in bytes.
+*
+* \param[out]  pOutput Pointer to the location to store the output chunk. May be the same as pInput.
+*
+* \return gSecSuccess_c, or gSecError_c if called out of order or with more data than announced.
+*
+* \remarks The decrypted data must not be trusted before AES_128_CCM_Finish() succeeds.
+*
+********************************************************************************** */
+secResultType_t AES_128_CCM_Update(AES_128_CCM_Ctx_t* pCtx,
+                                   const uint8_t* pInput,
+                                   uint32_t inputLen,
+                                   uint8_t* pOutput)
+{
+    if( (pCtx->authDataLeft != 0) || (inputLen > pCtx->inputLeft) )
+    {
+        return gSecError_c;
+    }
+
+    if( inputLen == 0 )
+    {
+        return gSecSuccess_c;
+    }
+
+    SecLib_DisallowToSleep();
+    SECLIB_MUTEX_LOCK();
+
+    /* The MAC is always computed over the plaintext */
+    if( pCtx->flags & gSecLib_CCM_Decrypt_c )
+    {
+        AES_128_CTR_Process(&pCtx->ctrCtx, pInput, inputLen, pOutput);
+        AES_128_CCM_MacUpdate(pCtx, pOutput, inputLen);
+    }
+    else
+    {
+        AES_128_CCM_MacUpdate(pCtx, pInput, inputLen);
+        AES_128_CTR_Process(&pCtx->ctrCtx, pInput, inputLen, pOutput);
+    }
+
+    pCtx->inputLeft -= inputLen;
+
+    SECLIB_MUTEX_UNLOCK();
+    SecLib_AllowToSleep();
+
+    return gSecSuccess_c;
+}
+
+/*! *********************************************************************************
+* \brief  This function finishes an AES-128-CCM operation.
+*
+* \param[in]  pCtx Pointer to the AES-128-CCM context.
+*
+* \param[in, out]  pCbcMac Pointer to the location to store the MAC when encrypting.
+*                  Pointer to the location where the received MAC can be found when decrypting.
+*
+* \return gSecSuccess_c, or gSecError_c if the data announced was not processed
+*         or the MAC check failed.
+*
+********************************************************************************** */
+secResultType_t AES_128_CCM_Finish(AES_128_CCM_Ctx_t* pCtx,
+                                   uint8_t* pCbcMac)
+{
+    uint8_t diff = 0;
+    uint8_t i;
+
+    if( (pCtx->authDataLeft != 0) || (pCtx->inputLeft != 0) )
+    {
+        return gSecError_c;
+    }
+
+    SecLib_DisallowToSleep();
+    SECLIB_MUTEX_LOCK();
+    AES_128_CCM_MacPad(pCtx);
+    SECLIB_MUTEX_UNLOCK();
+    SecLib_AllowToSleep();
+
+    SecLib_XorN(pCtx->mac, pCtx->tagMask, pCtx->macSize);
+
+    if( pCtx->flags & gSecLib_CCM_Decrypt_c )
+    {
+        /* Compare all the bytes, so that the time does not depend on the MAC */
+        for( i = 0; i < pCtx->macSize; i++ )
+        {
+            diff |= pCtx->mac[i] ^ pCbcMac[i];
+        }
+    }
+    else
+    {
+        FLib_MemCpy(pCbcMac, pCtx->mac, pCtx->macSize);
+    }
+
+    return (diff == 0) ? gSecSuccess_c : gSecError_c;
+}
+
+/*! *********************************************************************************
+* \brief  This function queues an AES-128 job. With gSecLibAsyncJobs_d enabled,
+*         CTR and CBC jobs are transferred to and from the LTC by eDMA, so the
+*         CPU is free until the completion callback. CCM jobs are run by the LTC
+*         when they reach the head of the queue, since the eDMA driver does not
+*         support CCM. Otherwise the job runs before this function returns.
+*
+* \param[in]  pJob Pointer to the job.
+*
+* \return gSecSuccess_c if the job was accepted, or gSecError_c if it is not valid.
+*         The result of the job itself is passed to the callback.
+*
+********************************************************************************** */
+secResultType_t SecLib_SubmitJob(secLibJob_t* pJob)
+{
+#if !mSecLibAsyncLtc_d
+    secResultType_t status;
+#endif
+
+    if( (pJob == NULL) || (pJob->pKey == NULL) || (pJob->type > gSecLibJobCcm_c) )
+    {
+        return gSecError_c;
+    }
+
+    if( (pJob->type != gSecLibJobCcm_c) &&
+        ((pJob->pIv == NULL) || (pJob->length == 0)) )
+    {
+        return gSecError_c;
+    }
+
+    if( ((pJob->type == gSecLibJobCbcEncrypt_c) || (pJob->type == gSecLibJobCbcDecrypt_c)) &&
+        (pJob->length & (AES_BLOCK_SIZE - 1)) )
+    {
+        return gSecError_c;
+    }
+
+#if mSecLibAsyncLtc_d
+    /* The device must not sleep while the LTC and the eDMA are working */
+    SecLib_DisallowToSleep();
+
+    pJob->pNext = NULL;
+
+    OSA_InterruptDisable();
+
+    if( mpSecLibJobTail == NULL )
+    {
+        mpSecLibJobHead = pJob;
+    }
+    else
+    {
+        mpSecLibJobTail->pNext = pJob;
+    }
+
+    mpSecLibJobTail = pJob;
+
+    OSA_InterruptEnable();
+
+    (void)OSA_EventSet(mSecLibEventId, mSecLibPumpEvent_c);
+#else
+    status = SecLib_RunJob(pJob);
+
+    if( pJob->callback != NULL )
+    {
+        pJob->callback(pJob, status);
+    }
+#endif
+
+    return gSecSuccess_c;
+}
+
+/*! *********************************************************************************
+* \brief  This function calculates XOR of individual byte pairs in two uint8_t arrays.
+*         pDst[i] := pDst[i] ^ pSrc[i] for i=0 to n-1
+*
+* \param[in, out]  pDst First byte array operand for XOR and destination byte array
+*
+* \param[in]  pSrc Second byte array operand for XOR
+*
+* \param[in]  n  Length of the byte arrays which will be XORed
+*
+********************************************************************************** */
+void SecLib_XorN(uint8_t* pDst,
+                 uint8_t* pSrc,
+                 uint8_t n)
+{
+    /* Word-wise when both buffers are word aligned, as AES blocks usually are */
+    if( (((uintptr_t)pDst | (uintptr_t)pSrc) & 0x03) == 0 )
+    {
+        while( n >= sizeof(uint32_t) )
+        {
+            *(uint32_alias_t*)pDst ^= *(uint32_alias_t*)pSrc;
+            pDst = pDst + sizeof(uint32_t);
+            pSrc = pSrc + sizeof(uint32_t);
+            n -= sizeof(uint32_t);
+        }
+    }
+
+    while( n )
+    {
+        *pDst = *pDst ^ *pSrc;
+        pDst = pDst + 1;
+        pSrc = pSrc + 1;
+        n--;
+    }
+}
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private functions
 *************************************************************************************
-* Private functions
-*************************************************************************************
 ********************************************************************************** */
 
-#if !(FSL_FEATURE_SOC_LTC_COUNT)
 /*! *********************************************************************************
-* \brief  Increments the value of a given counter vector.
+* \brief  Encrypts one block with an AES-128 context. Must be called with the
+*         SecLib mutex taken.
+*
+* \param [in]    pCtx       AES-128 context.
+*
+* \param [in]    pInput     16-byte plain text block.
+*
+* \param [out]   pOutput    16-byte ciphered block. May be the same as pInput.
+*
+********************************************************************************** */
+static void AES_128_EncryptBlock(AES_128_Ctx_t* pCtx,
+                                 const uint8_t* pInput,
+                                 uint8_t* pOutput)
+{
+#if FSL_FEATURE_SOC_MMCAU_COUNT
+    mmcauAesContext_t *pAligned = &mmcauAesCtx;
+    const uint8_t* pIn = pInput;
+    uint8_t* pOut = pOutput;
+
+    /* Check if pData is 4 bytes aligned */
+    if ((uintptr_t)pInput & 0x00000003)
+    {
+        FLib_MemCpy(pAligned->alignedIn, (uint8_t*)pInput, AES_BLOCK_SIZE);
+        pIn = pAligned->alignedIn;
+    }
+
+    /* Check if pReturnData is 4 bytes aligned */
+    if ((uintptr_t)pOutput & 0x00000003)
+    {
+        pOut = pAligned->alignedOut;
+    }
+
+    mmcau_aes_encrypt(pIn, (uint8_t*)pCtx->roundKeys, AES128_ROUNDS, pOut);
+
+    if (pOut == pAligned->alignedOut)
+    {
+        FLib_MemCpy(pOutput, pAligned->alignedOut, AES_BLOCK_SIZE);
+    }
+
+#elif FSL_FEATURE_SOC_LTC_COUNT
+    LTC_AES_EncryptEcb(LTC0, pInput, pOutput, AES_BLOCK_SIZE, (uint8_t*)pCtx->roundKeys, AES_BLOCK_SIZE);
+
+#else
+    AES_128_SwEncrypt(pCtx->roundKeys, pInput, pOutput);
+#endif
+}
+
+#if !(FSL_FEATURE_SOC_MMCAU_COUNT || FSL_FEATURE_SOC_LTC_COUNT)
+/*! *********************************************************************************
+* \brief  Expands an AES-128 key into the 44 round key words.
+*
+* \param [in]    pKey       128-bit key.
+*
+* \param [out]   rk         Round keys, stored as big endian words.
+*
+********************************************************************************** */
+static void AES_128_SwExpandKey(const uint8_t* pKey,
+                                uint32_t* rk)
+{
+    uint32_t temp;
+    uint32_t i;
+
+    rk[0] = AES_LOAD32(pKey);
+    rk[1] = AES_LOAD32(pKey + 4);
+    rk[2] = AES_LOAD32(pKey + 8);
+    rk[3] = AES_LOAD32(pKey + 12);
+
+    for (i = 0; i < AES128_ROUNDS; i++)
+    {
+        temp  = rk[3];
+        rk[4] = rk[0] ^ mAesRcon[i] ^
+                ((uint32_t)mAesSbox[(temp >> 16) & 0xFF] << 24) ^
+                ((uint32_t)mAesSbox[(temp >>  8) & 0xFF] << 16) ^
+                ((uint32_t)mAesSbox[(temp      ) & 0xFF] <<  8) ^
+                ((uint32_t)mAesSbox[(temp >> 24)       ]      );
+        rk[5] = rk[1] ^ rk[4];
+        rk[6] = rk[2] ^ rk[5];
+        rk[7] = rk[3] ^ rk[6];
+        rk += 4;
+    }
+}
+
+/*! *********************************************************************************
+* \brief  Encrypts one block using the T-table implementation of AES-128.
+*
+* \param [in]    rk         Round keys, see AES_128_SwExpandKey().
+*
+* \param [in]    pInput     16-byte plain text block.
+*
+* \param [out]   pOutput    16-byte ciphered block. May be the same as pInput.
+*
+********************************************************************************** */
+static void AES_128_SwEncrypt(const uint32_t* rk,
+                              const uint8_t* pInput,
+                              uint8_t* pOutput)
+{
+    uint32_t s0, s1, s2, s3;
+    uint32_t t0, t1, t2, t3;
+    uint32_t r;
+
+    s0 = AES_LOAD32(pInput)      ^ rk[0];
+    s1 = AES_LOAD32(pInput + 4)  ^ rk[1];
+    s2 = AES_LOAD32(pInput + 8)  ^ rk[2];
+    s3 = AES_LOAD32(pInput + 12) ^ rk[3];
+
+    for (r = 1; r < AES128_ROUNDS; r++)
+    {
+        rk += 4;
+        t0 = AES_TE0(s0 >> 24) ^ AES_TE1((s1 >> 16) & 0xFF) ^ AES_TE2((s2 >> 8) & 0xFF) ^ AES_TE3(s3 & 0xFF) ^ rk[0];
+        t1 = AES_TE0(s1 >> 24) ^ AES_TE1((s2 >> 16) & 0xFF) ^ AES_TE2((s3 >> 8) & 0xFF) ^ AES_TE3(s0 & 0xFF) ^ rk[1];
+        t2 = AES_TE0(s2 >> 24) ^ AES_TE1((s3 >> 16) & 0xFF) ^ AES_TE2((s0 >> 8) & 0xFF) ^ AES_TE3(s1 & 0xFF) ^ rk[2];
+        t3 = AES_TE0(s3 >> 24) ^ AES_TE1((s0 >> 16) & 0xFF) ^ AES_TE2((s1 >> 8) & 0xFF) ^ AES_TE3(s2 & 0xFF) ^ rk[3];
+        s0 = t0;
+        s1 = t1;
+        s2 = t2;
+        s3 = t3;
+    }
+
+    /* The last round has no MixColumns */
+    rk += 4;
+    t0 = AES_LAST_ROUND(s0, s1, s2, s3) ^ rk[0];
+    t1 = AES_LAST_ROUND(s1, s2, s3, s0) ^ rk[1];
+    t2 = AES_LAST_ROUND(s2, s3, s0, s1) ^ rk[2];
+    t3 = AES_LAST_ROUND(s3, s0, s1, s2) ^ rk[3];
+
+    AES_STORE32(pOutput,      t0);
+    AES_STORE32(pOutput + 4,  t1);
+    AES_STORE32(pOutput + 8,  t2);
+    AES_STORE32(pOutput + 12, t3);
+}
+
+/*! *********************************************************************************
+* \brief  Decrypts one block using the T-table implementation of AES-128. The
+*         equivalent inverse cipher needs InvMixColumns applied to the middle
+*         round keys; it is applied on the fly, so the context is shared with
+*         encryption.
+*
+* \param [in]    rk         Round keys, see AES_128_SwExpandKey().
+*
+* \param [in]    pInput     16-byte ciphered block.
+*
+* \param [out]   pOutput    16-byte plain text block. May be the same as pInput.
+*
+********************************************************************************** */
+static void AES_128_SwDecrypt(const uint32_t* rk,
+                              const uint8_t* pInput,
+                              uint8_t* pOutput)
+{
+    uint32_t s0, s1, s2, s3;
+    uint32_t t0, t1, t2, t3;
+    uint32_t r;
+
+    rk += 4 * AES128_ROUNDS;
+    s0 = AES_LOAD32(pInput)      ^ rk[0];
+    s1 = AES_LOAD32(pInput + 4)  ^ rk[1];
+    s2 = AES_LOAD32(pInput + 8)  ^ rk[2];
+    s3 = AES_LOAD32(pInput + 12) ^ rk[3];
+
+    for (r = 1; r < AES128_ROUNDS; r++)
+    {
+        rk -= 4;
+        t0 = AES_TD0(s0 >> 24) ^ AES_TD1((s3 >> 16) & 0xFF) ^ AES_TD2((s2 >> 8) & 0xFF) ^ AES_TD3(s1 & 0xFF) ^ AES_INV_MIX(rk[0]);
+        t1 = AES_TD0(s1 >> 24) ^ AES_TD1((s0 >> 16) & 0xFF) ^ AES_TD2((s3 >> 8) & 0xFF) ^ AES_TD3(s2 & 0xFF) ^ AES_INV_MIX(rk[1]);
+        t2 = AES_TD0(s2 >> 24) ^ AES_TD1((s1 >> 16) & 0xFF) ^ AES_TD2((s0 >> 8) & 0xFF) ^ AES_TD3(s3 & 0xFF) ^ AES_INV_MIX(rk[2]);
+        t3 = AES_TD0(s3 >> 24) ^ AES_TD1((s2 >> 16) & 0xFF) ^ AES_TD2((s1 >> 8) & 0xFF) ^ AES_TD3(s0 & 0xFF) ^ AES_INV_MIX(rk[3]);
+        s0 = t0;
+        s1 = t1;
+        s2 = t2;
+        s3 = t3;
+    }
+
+    /* The last round has no InvMixColumns */
+    rk -= 4;
+    t0 = AES_INV_LAST_ROUND(s0, s3, s2, s1) ^ rk[0];
+    t1 = AES_INV_LAST_ROUND(s1, s0, s3, s2) ^ rk[1];
+    t2 = AES_INV_LAST_ROUND(s2, s1, s0, s3) ^ rk[2];
+    t3 = AES_INV_LAST_ROUND(s3, s2, s1, s0) ^ rk[3];
+
+    AES_STORE32(pOutput,      t0);
+    AES_STORE32(pOutput + 4,  t1);
+    AES_STORE32(pOutput + 8,  t2);
+    AES_STORE32(pOutput + 12, t3);
+}
+#endif /* !(FSL_FEATURE_SOC_MMCAU_COUNT || FSL_FEATURE_SOC_LTC_COUNT) */
+
+/*! *********************************************************************************
+* \brief  Computes the AES-128-CMAC of an optional 16-byte prefix block followed by
+*         a message. Must be called with the SecLib mutex taken.
+*
+* \param [in]    pCtx       AES-128 context.
+*
+* \param [in]    pPrefix    16-byte block processed before the message, or NULL.
+*
+* \param [in]    pInput     Message, MSB first.
+*
+* \param [in]    inputLen   Length of the message in bytes.
+*
+* \param [out]   pOutput    16-byte authentication code.
+*
+********************************************************************************** */
+static void AES_128_CMAC_Compute(AES_128_Ctx_t* pCtx,
+                                 const uint8_t* pPrefix,
+                                 const uint8_t* pInput,
+                                 uint32_t inputLen,
+                                 uint8_t* pOutput)
+{
+    uint8_t X[AES_BLOCK_SIZE] = {0};
+    uint8_t M_last[AES_BLOCK_SIZE];
+    uint8_t padded[AES_BLOCK_SIZE];
+    uint8_t K1[AES_BLOCK_SIZE];
+    uint8_t K2[AES_BLOCK_SIZE];
+    uint32_t n;
+
+    AES_128_CMAC_Generate_Subkey(pCtx, K1, K2);
+
+    if( pPrefix != NULL )
+    {
+        if( inputLen == 0 )
+        {
+            /* The prefix is the last, complete block */
+            pInput = pPrefix;
+            inputLen = AES_BLOCK_SIZE;
+        }
+        else
+        {
+            SecLib_XorN(X, (uint8_t*)pPrefix, AES_BLOCK_SIZE);
+            AES_128_EncryptBlock(pCtx, X, X);
+        }
+    }
+
+    n = (inputLen + AES_BLOCK_SIZE - 1) / AES_BLOCK_SIZE; /* n is number of rounds */
+
+    /* Process the last block */
+    if( (n != 0) && ((inputLen % AES_BLOCK_SIZE) == 0) )
+    {
+        SecLib_Xor128((uint8_t*)&pInput[AES_BLOCK_SIZE * (n - 1)], K1, M_last);
+    }
+    else
+    {
+        if( n == 0 )
+        {
+            n = 1;
+        }
+
+        SecLib_Padding((uint8_t*)&pInput[AES_BLOCK_SIZE * (n - 1)], padded, inputLen % AES_BLOCK_SIZE);
+        SecLib_Xor128(padded, K2, M_last);
+    }
+
+    while( --n )
+    {
+        SecLib_XorN(X, (uint8_t*)pInput, AES_BLOCK_SIZE); /* X := Mi (+) X */
+        AES_128_EncryptBlock(pCtx, X, X);                 /* X := AES-128(KEY, X) */
+        pInput += AES_BLOCK_SIZE;
+    }
+
+    SecLib_XorN(X, M_last, AES_BLOCK_SIZE);
+    AES_128_EncryptBlock(pCtx, X, pOutput);
+}
+
+/*! *********************************************************************************
+* \brief  Computes the EAX OMAC of a message, for the given domain tag, without
+*         copying the message behind the tag block.
+*
+* \param [in]    pCtx       AES-128 context.
+*
+* \param [in]    tag        Domain tag: 0 for the nonce, 1 for the header,
+*                           2 for the ciphered data.
+*
+* \param [in]    pInput     Message.
+*
+* \param [in]    inputLen   Length of the message in bytes.
+*
+* \param [out]   pOutput    16-byte authentication code.
+*
+********************************************************************************** */
+static void AES_128_EAX_Omac(AES_128_Ctx_t* pCtx,
+                             uint8_t tag,
+                             const uint8_t* pInput,
+                             uint32_t inputLen,
+                             uint8_t* pOutput)
+{
+    uint8_t prefix[AES_BLOCK_SIZE] = {0};
+
+    prefix[AES_BLOCK_SIZE - 1] = tag;
+
+    SecLib_DisallowToSleep();
+    SECLIB_MUTEX_LOCK();
+    AES_128_CMAC_Compute(pCtx, prefix, pInput, inputLen, pOutput);
+    SECLIB_MUTEX_UNLOCK();
+    SecLib_AllowToSleep();
+}
+
+/*! *********************************************************************************
+* \brief  Runs the CBC-MAC over whole blocks. Must be called with the SecLib
+*         mutex taken.
+*
+* \param [in]      pCtx       AES-128 context.
+*
+* \param [in, out] pMac       16-byte CBC-MAC state.
+*
+* \param [in]      pInput     Input blocks.
+*
+* \param [in]      numBlocks  Number of 16-byte blocks.
+*
+********************************************************************************** */
+static void AES_128_CbcMacBlocks(AES_128_Ctx_t* pCtx,
+                                 uint8_t* pMac,
+                                 const uint8_t* pInput,
+                                 uint32_t numBlocks)
+{
+#if FSL_FEATURE_SOC_LTC_COUNT
+    /* Several blocks are chained in one LTC session, only the last output is kept */
+    uint8_t tempBuff[gSecLibCbcMacChunkBlocks_c * AES_BLOCK_SIZE];
+    uint32_t n;
+
+    while( numBlocks )
+    {
+        n = (numBlocks > gSecLibCbcMacChunkBlocks_c) ? gSecLibCbcMacChunkBlocks_c : numBlocks;
+        LTC_AES_EncryptCbc(LTC0, pInput, tempBuff, n * AES_BLOCK_SIZE, pMac, (uint8_t*)pCtx->roundKeys, AES_BLOCK_SIZE);
+        FLib_MemCpy(pMac, &tempBuff[(n - 1) * AES_BLOCK_SIZE], AES_BLOCK_SIZE);
+        pInput += n * AES_BLOCK_SIZE;
+        numBlocks -= n;
+    }
+#else
+    while( numBlocks )
+    {
+        SecLib_XorN(pMac, (uint8_t*)pInput, AES_BLOCK_SIZE);
+        AES_128_EncryptBlock(pCtx, pMac, pMac);
+        pInput += AES_BLOCK_SIZE;
+        numBlocks--;
+    }
+#endif
+}
+
+/*! *********************************************************************************
+* \brief  Encrypts or decrypts the next chunk of a CTR stream. Must be called with
+*         the SecLib mutex taken.
+*
+* \param [in, out] pCtx       AES-128-CTR context.
+*
+* \param [in]      pInput     Input chunk.
+*
+* \param [in]      inputLen   Length of the chunk in bytes.
+*
+* \param [out]     pOutput    Output chunk. May be the same as pInput.
+*
+********************************************************************************** */
+static void AES_128_CTR_Process(AES_128_CTR_Ctx_t* pCtx,
+                                const uint8_t* pInput,
+                                uint32_t inputLen,
+                                uint8_t* pOutput)
+{
+    uint32_t numBlocks;
+    uint32_t i;
+
+    /* Use the key stream left by the previous chunk */
+    while( inputLen && (pCtx->keyStreamUsed < AES_BLOCK_SIZE) )
+    {
+        *pOutput++ = *pInput++ ^ pCtx->keyStream[pCtx->keyStreamUsed++];
+        inputLen--;
+    }
+
+    numBlocks = inputLen / AES_BLOCK_SIZE;
+
+    if( numBlocks )
+    {
+#if FSL_FEATURE_SOC_LTC_COUNT
+        LTC_AES_EncryptCtr(LTC0, pInput, pOutput, numBlocks * AES_BLOCK_SIZE, pCtx->counter,
+                           (uint8_t*)pCtx->aesCtx.roundKeys, AES_BLOCK_SIZE, NULL, NULL);
+#else
+        for( i = 0; i < numBlocks * AES_BLOCK_SIZE; i++ )
+        {
+            if( (i % AES_BLOCK_SIZE) == 0 )
+            {
+                AES_128_EncryptBlock(&pCtx->aesCtx, pCtx->counter, pCtx->keyStream);
+                AES_128_IncrementCounter(pCtx->counter);
+            }
+
+            pOutput[i] = pInput[i] ^ pCtx->keyStream[i % AES_BLOCK_SIZE];
+        }
+#endif
+        pInput += numBlocks * AES_BLOCK_SIZE;
+        pOutput += numBlocks * AES_BLOCK_SIZE;
+        inputLen -= numBlocks * AES_BLOCK_SIZE;
+    }
+
+    /* Keep the rest of the last key stream block for the next chunk */
+    if( inputLen )
+    {
+        AES_128_EncryptBlock(&pCtx->aesCtx, pCtx->counter, pCtx->keyStream);
+        AES_128_IncrementCounter(pCtx->counter);
+
+        for( i = 0; i < inputLen; i++ )
+        {
+            pOutput[i] = pInput[i] ^ pCtx->keyStream[i];
+        }
+
+        pCtx->keyStreamUsed = (uint8_t)inputLen;
+    }
+}
+
+/*! *********************************************************************************
+* \brief  Adds data to the CBC-MAC of a CCM operation. Must be called with the
+*         SecLib mutex taken.
+*
+* \param [in, out] pCtx       AES-128-CCM context.
+*
+* \param [in]      pInput     Data.
+*
+* \param [in]      inputLen   Length of the data in bytes.
+*
+********************************************************************************** */
+static void AES_128_CCM_MacUpdate(AES_128_CCM_Ctx_t* pCtx,
+                                  const uint8_t* pInput,
+                                  uint32_t inputLen)
+{
+    uint32_t n;
+
+    if( pCtx->macUsed )
+    {
+        n = AES_BLOCK_SIZE - pCtx->macUsed;
+
+        if( n > inputLen )
+        {
+            n = inputLen;
+        }
+
+        SecLib_XorN(&pCtx->mac[pCtx->macUsed], (uint8_t*)pInput, (uint8_t)n);
+        pCtx->macUsed += n;
+        pInput += n;
+        inputLen -= n;
+
+        if( pCtx->macUsed < AES_BLOCK_SIZE )
+        {
+            return;
+        }
+
+        AES_128_EncryptBlock(&pCtx->ctrCtx.aesCtx, pCtx->mac, pCtx->mac);
+        pCtx->macUsed = 0;
+    }
+
+    n = inputLen / AES_BLOCK_SIZE;
+    AES_128_CbcMacBlocks(&pCtx->ctrCtx.aesCtx, pCtx->mac, pInput, n);
+    pInput += n * AES_BLOCK_SIZE;
+    inputLen -= n * AES_BLOCK_SIZE;
+
+    SecLib_XorN(pCtx->mac, (uint8_t*)pInput, (uint8_t)inputLen);
+    pCtx->macUsed = (uint8_t)inputLen;
+}
+
+/*! *********************************************************************************
+* \brief  Zero pads the CBC-MAC of a CCM operation to a block boundary. Must be
+*         called with the SecLib mutex taken.
+*
+* \param [in, out] pCtx       AES-128-CCM context.
+*
+********************************************************************************** */
+static void AES_128_CCM_MacPad(AES_128_CCM_Ctx_t* pCtx)
+{
+    if( pCtx->macUsed )
+    {
+        AES_128_EncryptBlock(&pCtx->ctrCtx.aesCtx, pCtx->mac, pCtx->mac);
+        pCtx->macUsed = 0;
+    }
+}
+
+/*! *********************************************************************************
+* \brief  Increments the value of a given counter vector.
+*
+* \param [in/out]     ctr         Counter.
+*
+* \remarks
+*
+********************************************************************************** */
+static void AES_128_IncrementCounter(uint8_t* ctr)
+{
+    uint32_t i;
+    uint64_t tempLow;
+    uuint128_t tempCtr;
+
+    for(i=0;i<AES_BLOCK_SIZE;i++)
+    {
+        tempCtr.u8[AES_BLOCK_SIZE-i-1] = ctr[i];
+    }
+
+    tempLow = tempCtr.u64[0];
+    tempCtr.u64[0]++;
+
+    if(tempLow > tempCtr.u64[0])
+    {
+        tempCtr.u64[1]++;
+    }
+
+    for(i=0;i<AES_BLOCK_SIZE;i++)
+    {
+        ctr[i] = tempCtr.u8[AES_BLOCK_SIZE-i-1];
+    }
+}
+
+/*! *********************************************************************************
+* \brief  Runs an AES-128 job synchronously, using the blocking SecLib functions.
+*
+* \param [in]    pJob       Job.
+*
+* \return gSecSuccess_c or gSecError_c.
+*
+********************************************************************************** */
+static secResultType_t SecLib_RunJob(secLibJob_t* pJob)
+{
+    secResultType_t status = gSecSuccess_c;
+#if !FSL_FEATURE_SOC_LTC_COUNT
+    AES_128_Ctx_t ctx;
+    uint8_t chain[AES_BLOCK_SIZE];
+    uint8_t block[AES_BLOCK_SIZE];
+    uint32_t i;
+#endif
+
+    switch( pJob->type )
+    {
+    case gSecLibJobCtr_c:
+        AES_128_CTR((uint8_t*)pJob->pInput, pJob->length, pJob->pIv, (uint8_t*)pJob->pKey, pJob->pOutput);
+        break;
+
+    case gSecLibJobCbcEncrypt_c:
+        AES_128_CBC_Encrypt((uint8_t*)pJob->pInput, pJob->length, pJob->pIv, (uint8_t*)pJob->pKey, pJob->pOutput);
+        break;
+
+    case gSecLibJobCbcDecrypt_c:
+#if FSL_FEATURE_SOC_LTC_COUNT
+        SecLib_DisallowToSleep();
+        SECLIB_MUTEX_LOCK();
+        if( kStatus_Success != LTC_AES_DecryptCbc(LTC0, pJob->pInput, pJob->pOutput, pJob->length, pJob->pIv,
+                                                  pJob->pKey, AES_BLOCK_SIZE, kLTC_EncryptKey) )
+        {
+            status = gSecError_c;
+        }
+        SECLIB_MUTEX_UNLOCK();
+        SecLib_AllowToSleep();
+#else
+        AES_128_SetKey(&ctx, pJob->pKey);
+        FLib_MemCpy(chain, pJob->pIv, AES_BLOCK_SIZE);
+
+        for( i = 0; i < pJob->length; i += AES_BLOCK_SIZE )
+        {
+            /* Keep the ciphered block, the output may overwrite it */
+            FLib_MemCpy(block, (uint8_t*)&pJob->pInput[i], AES_BLOCK_SIZE);
+            AES_128_Decrypt_WithCtx(&ctx, block, &pJob->pOutput[i]);
+            SecLib_XorN(&pJob->pOutput[i], chain, AES_BLOCK_SIZE);
+            FLib_MemCpy(chain, block, AES_BLOCK_SIZE);
+        }
+#endif
+        break;
+
+    case gSecLibJobCcm_c:
+        if( 0 != AES_128_CCM((uint8_t*)pJob->pInput, pJob->length, (uint8_t*)pJob->pAuthData, pJob->authDataLen,
+                             (uint8_t*)pJob->pNonce, pJob->nonceSize, (uint8_t*)pJob->pKey, pJob->pOutput,
+                             pJob->pMac, pJob->macSize, pJob->flags) )
+        {
+            status = gSecError_c;
+        }
+        break;
+
+    default:
+        status = gSecError_c;
+        break;
+    }
+
+    return status;
+}
+
+#if mSecLibAsyncLtc_d
+/*! *********************************************************************************
+* \brief  SecLib task. Starts the queued jobs when the LTC is free.
+*
+* \param[in] argument  not used
+*
+********************************************************************************** */
+void SecLib_Task(osaTaskParam_t argument)
+{
+    osaEventFlags_t flags;
+
+    (void)argument;
+
+    while( 1 )
+    {
+        (void)OSA_EventWait(mSecLibEventId, mSecLibPumpEvent_c, FALSE, osaWaitForever_c, &flags);
+        SecLib_AsyncPump();
+
+        /* For BareMetal break the while(1) after 1 run */
+        if( gUseRtos_c == 0 )
+        {
+            break;
+        }
+    }
+}
+
+/*! *********************************************************************************
+* \brief  Takes the LTC for a synchronous operation. Waits for the running job and
+*         keeps the queued ones from starting.
+*
+********************************************************************************** */
+static void SecLib_AsyncLtcAcquire(void)
+{
+#if USE_RTOS
+    osaEventFlags_t flags;
+#endif
+
+    OSA_InterruptDisable();
+    mSecLibLtcSyncCount++;
+    OSA_InterruptEnable();
+
+    while( mpSecLibJobActive != NULL )
+    {
+#if USE_RTOS
+        if( !__get_IPSR() && !__get_PRIMASK() )
+        {
+            (void)OSA_EventWait(mSecLibEventId, mSecLibJobDoneEvent_c, FALSE, osaWaitForever_c, &flags);
+            continue;
+        }
+#endif
+        /* The eDMA interrupt cannot be taken here */
+        SecLib_AsyncLtcPoll();
+    }
+}
+
+/*! *********************************************************************************
+* \brief  Releases the LTC after a synchronous operation. The SecLib task starts
+*         the queued jobs.
+*
+********************************************************************************** */
+static void SecLib_AsyncLtcRelease(void)
+{
+    OSA_InterruptDisable();
+    mSecLibLtcSyncCount--;
+    OSA_InterruptEnable();
+
+    if( mpSecLibJobHead != NULL )
+    {
+        (void)OSA_EventSet(mSecLibEventId, mSecLibPumpEvent_c);
+    }
+}
+
+/*! *********************************************************************************
+* \brief  Serves the eDMA channels of the running job, in place of the eDMA
+*         interrupt handler.
+*
+********************************************************************************** */
+static void SecLib_AsyncLtcPoll(void)
+{
+    OSA_InterruptDisable();
+
+    if( EDMA_GetChannelStatusFlags(gSecLibLtcDma_c, gSecLibLtcInputDmaChannel_c) & kEDMA_InterruptFlag )
+    {
+        EDMA_HandleIRQ(&mSecLibLtcInputEdmaHandle);
+    }
+
+    if( EDMA_GetChannelStatusFlags(gSecLibLtcDma_c, gSecLibLtcOutputDmaChannel_c) & kEDMA_InterruptFlag )
+    {
+        EDMA_HandleIRQ(&mSecLibLtcOutputEdmaHandle);
+    }
+
+    OSA_InterruptEnable();
+}
+
+/*! *********************************************************************************
+* \brief  Starts the queued jobs, until one is left running on the eDMA. Runs in
+*         the SecLib task.
+*
+********************************************************************************** */
+static void SecLib_AsyncPump(void)
+{
+    secLibJob_t* pJob;
+    secResultType_t status;
+
+    for( ;; )
+    {
+        pJob = NULL;
+
+        OSA_InterruptDisable();
+
+        if( (mpSecLibJobActive == NULL) && (mpSecLibJobHead != NULL) && (mSecLibLtcSyncCount == 0) )
+        {
+            pJob = mpSecLibJobHead;
+            mpSecLibJobHead = pJob->pNext;
+
+            if( mpSecLibJobHead == NULL )
+            {
+                mpSecLibJobTail = NULL;
+            }
+
+            mpSecLibJobActive = pJob;
+        }
+
+        OSA_InterruptEnable();
+
+        if( pJob == NULL )
+        {
+            break;
+        }
+
+        if( SecLib_AsyncStart(pJob, &status) )
+        {
+            /* Completes in SecLib_LtcEdmaCallback() */
+            break;
+        }
+
+        SecLib_AsyncFinish(pJob, status);
+    }
+}
+
+/*! *********************************************************************************
+* \brief  Starts a job on the LTC.
+*
+* \param [in]    pJob       Job.
+*
+* \param [out]   pStatus    Result of the job, if it was completed.
+*
+* \return TRUE if the job is running on the eDMA, FALSE if it was completed.
+*
+********************************************************************************** */
+static bool_t SecLib_AsyncStart(secLibJob_t* pJob, secResultType_t* pStatus)
+{
+    status_t status;
+
+    switch( pJob->type )
+    {
+    case gSecLibJobCtr_c:
+        status = LTC_AES_CryptCtrEDMA(LTC0, &mSecLibLtcEdmaHandle, pJob->pInput, pJob->pOutput, pJob->length,
+                                      pJob->pIv, pJob->pKey, AES_BLOCK_SIZE, NULL, NULL);
+        break;
+
+    case gSecLibJobCbcEncrypt_c:
+        status = LTC_AES_EncryptCbcEDMA(LTC0, &mSecLibLtcEdmaHandle, pJob->pInput, pJob->pOutput, pJob->length,
+                                        pJob->pIv, pJob->pKey, AES_BLOCK_SIZE);
+        break;
+
+    case gSecLibJobCbcDecrypt_c:
+        status = LTC_AES_DecryptCbcEDMA(LTC0, &mSecLibLtcEdmaHandle, pJob->pInput, pJob->pOutput, pJob->length,
+                                        pJob->pIv, pJob->pKey, AES_BLOCK_SIZE, kLTC_EncryptKey);
+        break;
+
+    case gSecLibJobCcm_c:
+        if( pJob->flags & gSecLib_CCM_Decrypt_c )
+        {
+            status = LTC_AES_DecryptTagCcm(LTC0, pJob->pInput, pJob->pOutput, pJob->length, pJob->pNonce,
+                                           pJob->nonceSize, pJob->pAuthData, pJob->authDataLen, pJob->pKey,
+                                           AES_BLOCK_SIZE, pJob->pMac, pJob->macSize);
+        }
+        else
+        {
+            status = LTC_AES_EncryptTagCcm(LTC0, pJob->pInput, pJob->pOutput, pJob->length, pJob->pNonce,
+                                           pJob->nonceSize, pJob->pAuthData, pJob->authDataLen, pJob->pKey,
+                                           AES_BLOCK_SIZE, pJob->pMac, pJob->macSize);
+        }
+
+        *pStatus = (kStatus_Success == status) ? gSecSuccess_c : gSecError_c;
+        return FALSE;
+
+    default:
+        status = kStatus_InvalidArgument;
+        break;
+    }
+
+    if( kStatus_Success != status )
+    {
+        *pStatus = gSecError_c;
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+/*! *********************************************************************************
+* \brief  Completes the running job and calls its callback.
+*
+* \param [in]    pJob       Job.
+*
+* \param [in]    status     Result of the job.
+*
+********************************************************************************** */
+static void SecLib_AsyncFinish(secLibJob_t* pJob, secResultType_t status)
+{
+    mpSecLibJobActive = NULL;
+    SecLib_AllowToSleep();
+
+    if( pJob->callback != NULL )
+    {
+        pJob->callback(pJob, status);
+    }
+
+    /* Wakes the synchronous operation waiting for the LTC, and the SecLib task */
+    (void)OSA_EventSet(mSecLibEventId, mSecLibJobDoneEvent_c | mSecLibPumpEvent_c);
+}
+
+/*! *********************************************************************************
+* \brief  LTC eDMA completion callback. Runs in interrupt context, or in the
+*         synchronous operation which serves the eDMA channels.
+*
+********************************************************************************** */
+static void SecLib_LtcEdmaCallback(LTC_Type *base, ltc_edma_handle_t *handle, status_t status, void *userData)
+{
+    secLibJob_t* pJob = mpSecLibJobActive;
+
+    (void)base;
+    (void)handle;
+    (void)userData;
+
+    if( pJob != NULL )
+    {
+        SecLib_AsyncFinish(pJob, (kStatus_Success == status) ? gSecSuccess_c : gSecError_c);
+    }
+}
+#endif /* mSecLibAsyncLtc_d */
+
+#if gSecLibSwEcP256_d
+/*! *********************************************************************************
+* \brief  Adds two 256-bit numbers.
+*
+* \return The carry.
+*
+********************************************************************************** */
+static uint32_t EcP256_AddWords(uint32_t* pR, const uint32_t* pA, const uint32_t* pB)
+{
+    uint64_t acc = 0;
+    uint32_t i;
+
+    for( i = 0; i < gEcP256Words_c; i++ )
+    {
+        acc += (uint64_t)pA[i] + pB[i];
+        pR[i] = (uint32_t)acc;
+        acc >>= 32;
+    }
+
+    return (uint32_t)acc;
+}
+
+/*! *********************************************************************************
+* \brief  Subtracts two 256-bit numbers.
+*
+* \return The borrow.
+*
+********************************************************************************** */
+static uint32_t EcP256_SubWords(uint32_t* pR, const uint32_t* pA, const uint32_t* pB)
+{
+    uint64_t diff;
+    uint32_t borrow = 0;
+    uint32_t i;
+
+    for( i = 0; i < gEcP256Words_c; i++ )
+    {
+        diff = (uint64_t)pA[i] - pB[i] - borrow;
+        pR[i] = (uint32_t)diff;
+        borrow = (uint32_t)(diff >> 32) & 1;
+    }
+
+    return borrow;
+}
+
+/*! *********************************************************************************
+* \brief  Copies pA to pR if mask is all ones, in constant time.
+*
+* \param [in]    mask       0 or 0xFFFFFFFF.
+*
+* \param [in]    words      Number of words to copy.
+*
+********************************************************************************** */
+static void EcP256_CondCopy(uint32_t* pR, const uint32_t* pA, uint32_t mask, uint32_t words)
+{
+    uint32_t i;
+
+    for( i = 0; i < words; i++ )
+    {
+        pR[i] = (pR[i] & ~mask) | (pA[i] & mask);
+    }
+}
+
+/*! *********************************************************************************
+* \brief  Returns 0xFFFFFFFF if a == b, else 0, in constant time.
+*
+********************************************************************************** */
+static uint32_t EcP256_EqualMask(uint32_t a, uint32_t b)
+{
+    uint32_t x = a ^ b;
+
+    return ((x | (0 - x)) >> 31) - 1;
+}
+
+/*! *********************************************************************************
+* \brief  Checks if a 256-bit number is zero.
+*
+********************************************************************************** */
+static bool_t EcP256_IsZero(const uint32_t* pA)
+{
+    uint32_t acc = 0;
+    uint32_t i;
+
+    for( i = 0; i < gEcP256Words_c; i++ )
+    {
+        acc |= pA[i];
+    }
+
+    return (0 == acc);
+}
+
+/*! *********************************************************************************
+* \brief  Checks if a < b.
+*
+********************************************************************************** */
+static bool_t EcP256_IsLess(const uint32_t* pA, const uint32_t* pB)
+{
+    uint32_t t[gEcP256Words_c];
+
+    return (1 == EcP256_SubWords(t, pA, pB));
+}
+
+/*! *********************************************************************************
+* \brief  Loads a 256-bit number stored as 32 little endian bytes.
+*
+********************************************************************************** */
+static void EcP256_Load(uint32_t* pR, const uint8_t* pIn)
+{
+    uint32_t i;
+
+    for( i = 0; i < gEcP256Words_c; i++ )
+    {
+        pR[i] = (uint32_t)pIn[4 * i] | ((uint32_t)pIn[4 * i + 1] << 8) |
+                ((uint32_t)pIn[4 * i + 2] << 16) | ((uint32_t)pIn[4 * i + 3] << 24);
+    }
+}
+
+/*! *********************************************************************************
+* \brief  Stores a 256-bit number as 32 little endian bytes.
+*
+********************************************************************************** */
+static void EcP256_Store(uint8_t* pOut, const uint32_t* pA)
+{
+    uint32_t i;
+
+    for( i = 0; i < gEcP256Words_c; i++ )
+    {
+        pOut[4 * i]     = (uint8_t)pA[i];
+        pOut[4 * i + 1] = (uint8_t)(pA[i] >> 8);
+        pOut[4 * i + 2] = (uint8_t)(pA[i] >> 16);
+        pOut[4 * i + 3] = (uint8_t)(pA[i] >> 24);
+    }
+}
+
+/*! *********************************************************************************
+* \brief  r = a + b mod p
+*
+********************************************************************************** */
+static void EcP256_FieldAdd(uint32_t* pR, const uint32_t* pA, const uint32_t* pB)
+{
+    uint32_t t[gEcP256Words_c];
+    uint32_t carry;
+    uint32_t borrow;
+
+    carry = EcP256_AddWords(pR, pA, pB);
+    borrow = EcP256_SubWords(t, pR, mEcP256_p);
+
+    /* Keep the reduced value if the sum did not fit in 256 bits, or was >= p */
+    EcP256_CondCopy(pR, t, 0 - (carry | (borrow ^ 1)), gEcP256Words_c);
+}
+
+/*! *********************************************************************************
+* \brief  r = a - b mod p
+*
+********************************************************************************** */
+static void EcP256_FieldSub(uint32_t* pR, const uint32_t* pA, const uint32_t* pB)
+{
+    uint32_t t[gEcP256Words_c];
+    uint32_t borrow;
+
+    borrow = EcP256_SubWords(pR, pA, pB);
+    EcP256_AddWords(t, pR, mEcP256_p);
+    EcP256_CondCopy(pR, t, 0 - borrow, gEcP256Words_c);
+}
+
+/*! *********************************************************************************
+* \brief  Montgomery multiplication, r = a * b / 2^256 mod p. Since p = -1 mod 2^32,
+*         the reduction factor of each step is the lowest word.
+*
+********************************************************************************** */
+static void EcP256_FieldMul(uint32_t* pR, const uint32_t* pA, const uint32_t* pB)
+{
+    uint32_t t[gEcP256Words_c + 2] = {0};
+    uint32_t s[gEcP256Words_c];
+    uint64_t acc;
+    uint32_t m;
+    uint32_t borrow;
+    uint32_t i, j;
+
+    for( i = 0; i < gEcP256Words_c; i++ )
+    {
+        /* t += a * b[i] */
+        acc = 0;
+
+        for( j = 0; j < gEcP256Words_c; j++ )
+        {
+            acc += (uint64_t)pA[j] * pB[i] + t[j];
+            t[j] = (uint32_t)acc;
+            acc >>= 32;
+        }
+
+        acc += t[gEcP256Words_c];
+        t[gEcP256Words_c] = (uint32_t)acc;
+        t[gEcP256Words_c + 1] = (uint32_t)(acc >> 32);
+
+        /* t = (t + m * p) / 2^32 */
+        m = t[0];
+        acc = ((uint64_t)m * mEcP256_p[0] + t[0]) >> 32;
+
+        for( j = 1; j < gEcP256Words_c; j++ )
+        {
+            acc += (uint64_t)m * mEcP256_p[j] + t[j];
+            t[j - 1] = (uint32_t)acc;
+            acc >>= 32;
+        }
+
+        acc += t[gEcP256Words_c];
+        t[gEcP256Words_c - 1] = (uint32_t)acc;
+        t[gEcP256Words_c] = t[gEcP256Words_c + 1] + (uint32_t)(acc >> 32);
+    }
+
+    /* t < 2p */
+    borrow = EcP256_SubWords(s, t, mEcP256_p);
+    EcP256_CondCopy(t, s, 0 - (t[gEcP256Words_c] | (borrow ^ 1)), gEcP256Words_c);
+    FLib_MemCpy(pR, t, sizeof(s));
+}
+
+/*! *********************************************************************************
+* \brief  r = a^(p - 2) = 1 / a mod p, in the Montgomery form. The exponent is
+*         public, so the sequence of operations does not depend on a.
 *
-* \param [in/out]     ctr         Counter.
+********************************************************************************** */
+static void EcP256_FieldInv(uint32_t* pR, const uint32_t* pA)
+{
+    uint32_t e[gEcP256Words_c];
+    uint32_t r[gEcP256Words_c];
+    int32_t i;
+
+    FLib_MemCpy(e, (void*)mEcP256_p, sizeof(e));
+    e[0] -= 2;
+    FLib_MemCpy(r, (void*)mEcP256_One, sizeof(r));
+
+    for( i = 255; i >= 0; i-- )
+    {
+        EcP256_FieldMul(r, r, r);
+
+        if( (e[i >> 5] >> (i & 31)) & 1 )
+        {
+            EcP256_FieldMul(r, r, pA);
+        }
+    }
+
+    FLib_MemCpy(pR, r, sizeof(r));
+}
+
+/*! *********************************************************************************
+* \brief  Point doubling, using the complete formulas for a = -3 of Renes, Costello
+*         and Batina. Valid for all inputs, including the point at infinity.
 *
-* \remarks
+********************************************************************************** */
+static void EcP256_PointDouble(ecP256Point_t* pR, const ecP256Point_t* pP)
+{
+    uint32_t t0[gEcP256Words_c], t1[gEcP256Words_c], t2[gEcP256Words_c], t3[gEcP256Words_c];
+    uint32_t x3[gEcP256Words_c], y3[gEcP256Words_c], z3[gEcP256Words_c];
+
+    EcP256_FieldMul(t0, pP->X, pP->X);
+    EcP256_FieldMul(t1, pP->Y, pP->Y);
+    EcP256_FieldMul(t2, pP->Z, pP->Z);
+    EcP256_FieldMul(t3, pP->X, pP->Y);
+    EcP256_FieldAdd(t3, t3, t3);
+    EcP256_FieldMul(z3, pP->X, pP->Z);
+    EcP256_FieldAdd(z3, z3, z3);
+    EcP256_FieldMul(y3, mEcP256_b, t2);
+    EcP256_FieldSub(y3, y3, z3);
+    EcP256_FieldAdd(x3, y3, y3);
+    EcP256_FieldAdd(y3, x3, y3);
+    EcP256_FieldSub(x3, t1, y3);
+    EcP256_FieldAdd(y3, t1, y3);
+    EcP256_FieldMul(y3, x3, y3);
+    EcP256_FieldMul(x3, x3, t3);
+    EcP256_FieldAdd(t3, t2, t2);
+    EcP256_FieldAdd(t2, t2, t3);
+    EcP256_FieldMul(z3, mEcP256_b, z3);
+    EcP256_FieldSub(z3, z3, t2);
+    EcP256_FieldSub(z3, z3, t0);
+    EcP256_FieldAdd(t3, z3, z3);
+    EcP256_FieldAdd(z3, z3, t3);
+    EcP256_FieldAdd(t3, t0, t0);
+    EcP256_FieldAdd(t0, t3, t0);
+    EcP256_FieldSub(t0, t0, t2);
+    EcP256_FieldMul(t0, t0, z3);
+    EcP256_FieldAdd(y3, y3, t0);
+    EcP256_FieldMul(t0, pP->Y, pP->Z);
+    EcP256_FieldAdd(t0, t0, t0);
+    EcP256_FieldMul(z3, t0, z3);
+    EcP256_FieldSub(x3, x3, z3);
+    EcP256_FieldMul(z3, t0, t1);
+    EcP256_FieldAdd(z3, z3, z3);
+    EcP256_FieldAdd(z3, z3, z3);
+
+    FLib_MemCpy(pR->X, x3, sizeof(x3));
+    FLib_MemCpy(pR->Y, y3, sizeof(y3));
+    FLib_MemCpy(pR->Z, z3, sizeof(z3));
+}
+
+/*! *********************************************************************************
+* \brief  Point addition, using the complete formulas for a = -3 of Renes, Costello
+*         and Batina. Valid for all inputs, including P = Q and the point at infinity.
 *
 ********************************************************************************** */
-static void AES_128_IncrementCounter(uint8_t* ctr)
+static void EcP256_PointAdd(ecP256Point_t* pR, const ecP256Point_t* pP, const ecP256Point_t* pQ)
+{
+    uint32_t t0[gEcP256Words_c], t1[gEcP256Words_c], t2[gEcP256Words_c];
+    uint32_t t3[gEcP256Words_c], t4[gEcP256Words_c];
+    uint32_t x3[gEcP256Words_c], y3[gEcP256Words_c], z3[gEcP256Words_c];
+
+    EcP256_FieldMul(t0, pP->X, pQ->X);
+    EcP256_FieldMul(t1, pP->Y, pQ->Y);
+    EcP256_FieldMul(t2, pP->Z, pQ->Z);
+    EcP256_FieldAdd(t3, pP->X, pP->Y);
+    EcP256_FieldAdd(t4, pQ->X, pQ->Y);
+    EcP256_FieldMul(t3, t3, t4);
+    EcP256_FieldAdd(t4, t0, t1);
+    EcP256_FieldSub(t3, t3, t4);
+    EcP256_FieldAdd(t4, pP->Y, pP->Z);
+    EcP256_FieldAdd(x3, pQ->Y, pQ->Z);
+    EcP256_FieldMul(t4, t4, x3);
+    EcP256_FieldAdd(x3, t1, t2);
+    EcP256_FieldSub(t4, t4, x3);
+    EcP256_FieldAdd(x3, pP->X, pP->Z);
+    EcP256_FieldAdd(y3, pQ->X, pQ->Z);
+    EcP256_FieldMul(x3, x3, y3);
+    EcP256_FieldAdd(y3, t0, t2);
+    EcP256_FieldSub(y3, x3, y3);
+    EcP256_FieldMul(z3, mEcP256_b, t2);
+    EcP256_FieldSub(x3, y3, z3);
+    EcP256_FieldAdd(z3, x3, x3);
+    EcP256_FieldAdd(x3, x3, z3);
+    EcP256_FieldSub(z3, t1, x3);
+    EcP256_FieldAdd(x3, t1, x3);
+    EcP256_FieldMul(y3, mEcP256_b, y3);
+    EcP256_FieldAdd(t1, t2, t2);
+    EcP256_FieldAdd(t2, t1, t2);
+    EcP256_FieldSub(y3, y3, t2);
+    EcP256_FieldSub(y3, y3, t0);
+    EcP256_FieldAdd(t1, y3, y3);
+    EcP256_FieldAdd(y3, t1, y3);
+    EcP256_FieldAdd(t1, t0, t0);
+    EcP256_FieldAdd(t0, t1, t0);
+    EcP256_FieldSub(t0, t0, t2);
+    EcP256_FieldMul(t1, t4, y3);
+    EcP256_FieldMul(t2, t0, y3);
+    EcP256_FieldMul(y3, x3, z3);
+    EcP256_FieldAdd(y3, y3, t2);
+    EcP256_FieldMul(x3, t3, x3);
+    EcP256_FieldSub(x3, x3, t1);
+    EcP256_FieldMul(z3, t4, z3);
+    EcP256_FieldMul(t1, t3, t0);
+    EcP256_FieldAdd(z3, z3, t1);
+
+    FLib_MemCpy(pR->X, x3, sizeof(x3));
+    FLib_MemCpy(pR->Y, y3, sizeof(y3));
+    FLib_MemCpy(pR->Z, z3, sizeof(z3));
+}
+
+/*! *********************************************************************************
+* \brief  Returns the comb table index of a column: bit i of the index is bit
+*         (52 * i + column) of the scalar.
+*
+********************************************************************************** */
+static uint32_t EcP256_CombIndex(const uint32_t* pScalar, uint32_t column)
 {
+    uint32_t index = 0;
+    uint32_t bit;
     uint32_t i;
-    uint64_t tempLow;
-    uuint128_t tempCtr;
 
-    for(i=0;i<AES_BLOCK_SIZE;i++)
+    for( i = 0; i < mEcP256CombTeeth_c; i++ )
     {
-        tempCtr.u8[AES_BLOCK_SIZE-i-1] = ctr[i];
+        bit = i * mEcP256CombSpacing_c + column;
+
+        if( bit < 256 )
+        {
+            index |= ((pScalar[bit >> 5] >> (bit & 31)) & 1) << i;
+        }
     }
 
-    tempLow = tempCtr.u64[0];
-    tempCtr.u64[0]++;
+    return index;
+}
 
-    if(tempLow > tempCtr.u64[0])
+/*! *********************************************************************************
+* \brief  Reads a comb table entry, or the point at infinity for index 0. All the
+*         entries are read, so the access pattern does not depend on the index.
+*
+********************************************************************************** */
+static void EcP256_CombLookup(ecP256Point_t* pR, uint32_t index)
+{
+    uint32_t mask;
+    uint32_t u;
+
+    FLib_MemSet(pR, 0, sizeof(ecP256Point_t));
+    FLib_MemCpy(pR->Y, (void*)mEcP256_One, sizeof(mEcP256_One));
+
+    for( u = 1; u <= mEcP256CombPoints_c; u++ )
     {
-        tempCtr.u64[1]++;
+        mask = EcP256_EqualMask(u, index);
+        EcP256_CondCopy(pR->X, &mEcP256CombTable[u - 1][0], mask, gEcP256Words_c);
+        EcP256_CondCopy(pR->Y, &mEcP256CombTable[u - 1][gEcP256Words_c], mask, gEcP256Words_c);
+        EcP256_CondCopy(pR->Z, mEcP256_One, mask, gEcP256Words_c);
     }
+}
 
-    for(i=0;i<AES_BLOCK_SIZE;i++)
+/*! *********************************************************************************
+* \brief  Reads digit * P from the table of odd multiples, for an odd signed digit.
+*         All the entries are read and the negation is always computed.
+*
+********************************************************************************** */
+static void EcP256_WindowLookup(ecP256Point_t* pR, const ecP256Point_t* pTable, int8_t digit)
+{
+    uint32_t d = (uint32_t)(int32_t)digit;
+    uint32_t sign = 0 - (d >> 31);
+    uint32_t index = ((d ^ sign) - sign) >> 1;
+    uint32_t negY[gEcP256Words_c];
+    uint32_t zero[gEcP256Words_c] = {0};
+    uint32_t i;
+
+    for( i = 0; i < gEcP256WindowPoints_c; i++ )
     {
-        ctr[i] = tempCtr.u8[AES_BLOCK_SIZE-i-1];
+        EcP256_CondCopy((uint32_t*)pR, (const uint32_t*)&pTable[i], EcP256_EqualMask(i, index),
+                        sizeof(ecP256Point_t) / sizeof(uint32_t));
+    }
+
+    EcP256_FieldSub(negY, zero, pR->Y);
+    EcP256_CondCopy(pR->Y, negY, sign, gEcP256Words_c);
+}
+
+/*! *********************************************************************************
+* \brief  Recodes an odd scalar into 65 odd signed digits, in [-15, 15], such that
+*         k = sum(digits[i] * 16^i). The scalar is destroyed.
+*
+********************************************************************************** */
+static void EcP256_Recode(int8_t* pDigits, uint32_t* pScalar)
+{
+    uint32_t i, j;
+
+    for( i = 0; i < gEcP256ScalarDigits_c - 1; i++ )
+    {
+        /* d = (k mod 32) - 16, then k = (k - d) / 16, which stays odd */
+        pDigits[i] = (int8_t)((int32_t)(pScalar[0] & 0x1F) - 16);
+        pScalar[0] = (pScalar[0] & ~0x1FU) | 0x10;
+
+        for( j = 0; j < gEcP256Words_c - 1; j++ )
+        {
+            pScalar[j] = (pScalar[j] >> mEcP256WindowBits_c) | (pScalar[j + 1] << (32 - mEcP256WindowBits_c));
+        }
+
+        pScalar[gEcP256Words_c - 1] >>= mEcP256WindowBits_c;
+    }
+
+    pDigits[gEcP256ScalarDigits_c - 1] = (int8_t)pScalar[0];
+}
+
+/*! *********************************************************************************
+* \brief  Draws a random scalar in [1, n - 1].
+*
+********************************************************************************** */
+static secResultType_t EcP256_GenerateScalar(uint32_t* pScalar)
+{
+    uint8_t bytes[32];
+    uint32_t seed[gEcP256Words_c];
+    uint32_t attempt;
+    uint32_t i;
+
+    for( attempt = 0; attempt < mEcP256KeyAttempts_c; attempt++ )
+    {
+        if( sizeof(bytes) != RNG_GetPseudoRandomNo(bytes, sizeof(bytes), NULL) )
+        {
+            /* The PRNG needs a new seed */
+            for( i = 0; i < gEcP256Words_c; i++ )
+            {
+                RNG_GetRandomNo(&seed[i]);
+            }
+
+            RNG_SetPseudoRandomNoSeed((uint8_t*)seed);
+
+            if( sizeof(bytes) != RNG_GetPseudoRandomNo(bytes, sizeof(bytes), NULL) )
+            {
+                break;
+            }
+        }
+
+        EcP256_Load(pScalar, bytes);
+
+        if( !EcP256_IsZero(pScalar) && EcP256_IsLess(pScalar, mEcP256_n) )
+        {
+            FLib_MemSet(bytes, 0, sizeof(bytes));
+            return gSecSuccess_c;
+        }
+    }
+
+    FLib_MemSet(bytes, 0, sizeof(bytes));
+    return gSecError_c;
+}
+
+/*! *********************************************************************************
+* \brief  Converts the result to affine coordinates, writes it and clears the context.
+*
+********************************************************************************** */
+static secResultType_t EcP256_Finish(ecP256Context_t* pCtx)
+{
+    ecP256Point_t* pQ = &pCtx->result;
+    uint32_t one[gEcP256Words_c] = {1};
+    uint32_t zero[gEcP256Words_c] = {0};
+    uint32_t t[gEcP256Words_c];
+    secResultType_t result = gSecError_c;
+
+    EcP256_FieldSub(t, zero, pQ->Y);
+    EcP256_CondCopy(pQ->Y, t, 0 - (uint32_t)pCtx->negate, gEcP256Words_c);
+
+    if( !EcP256_IsZero(pQ->Z) )
+    {
+        /* 1 / Z out of the Montgomery form, so that the products below are too */
+        EcP256_FieldInv(pQ->Z, pQ->Z);
+        EcP256_FieldMul(pQ->Z, pQ->Z, one);
+
+        EcP256_FieldMul(t, pQ->X, pQ->Z);
+        EcP256_Store(pCtx->pOutPoint->components_8bit.x, t);
+        EcP256_FieldMul(t, pQ->Y, pQ->Z);
+        EcP256_Store(pCtx->pOutPoint->components_8bit.y, t);
+        result = gSecSuccess_c;
     }
+
+    FLib_MemSet(pCtx, 0, sizeof(ecP256Context_t));
+    FLib_MemSet(t, 0, sizeof(t));
+
+    return result;
 }
-#endif /* !(FSL_FEATURE_SOC_LTC_COUNT) */
+#endif /* gSecLibSwEcP256_d */
 
 /*! *********************************************************************************
 * \brief  Generates the two subkeys that correspond two an AES key
 *
-* \param [in]    key        AES Key.
+* \param [in]    pCtx       AES-128 context. Must be called with the SecLib mutex taken.
 *
 * \param [out]   K1         First subkey.
 *
@@ -1274,7 +3740,7 @@ static void AES_128_IncrementCounter(uint8_t* ctr)
 * \remarks   This is public open source code! Terms of use must be checked before use!
 *
 ********************************************************************************** */
-static void AES_128_CMAC_Generate_Subkey(uint8_t *key,
+static void AES_128_CMAC_Generate_Subkey(AES_128_Ctx_t *pCtx,
                                          uint8_t *K1,
                                          uint8_t *K2)
 {
@@ -1292,7 +3758,7 @@ static void AES_128_CMAC_Generate_Subkey(uint8_t *key,
         Z[i] = 0;
     }
 
-    AES_128_Encrypt(Z,key,L);
+    AES_128_EncryptBlock(pCtx,Z,L);
 
     if ( (L[0] & 0x80) == 0 )
     {
@@ -1874,6 +4340,266 @@ secResultType_t ECDH_P256_ComputeDhKey
     return result;
 }
 
+#if gSecLibSwEcP256_d
+/************************************************************************************
+* \brief Generates a new Private/Public Key Pair. Replaces the lib_crypto function
+*        used by ECDH_P256_GenerateKeys().
+*
+* \return gEcdhSuccess_c or error
+*
+************************************************************************************/
+ecdhStatus_t Ecdh_GenerateNewKeys
+(
+    ecdhPublicKey_t*    pOutPublicKey,
+    ecdhPrivateKey_t*   pOutPrivateKey,
+    void*               pMultiplicationBuffer
+)
+{
+    ecP256Context_t* pCtx = (ecP256Context_t*)pMultiplicationBuffer;
+    secResultType_t result;
+
+    result = ECDH_P256_GenerateKeysStart(pCtx, pOutPublicKey, pOutPrivateKey);
+
+    while( gSecResultPending_c == result )
+    {
+        result = ECDH_P256_Continue(pCtx);
+    }
+
+    return (gSecSuccess_c == result) ? gEcdhSuccess_c : gEcdhRngError_c;
+}
+
+/************************************************************************************
+* \brief Computes Diffie-Hellman key. Replaces the lib_crypto function used by
+*        ECDH_P256_ComputeDhKey().
+*
+* \return gEcdhSuccess_c or error
+*
+************************************************************************************/
+ecdhStatus_t Ecdh_ComputeDhKey
+(
+    ecdhPrivateKey_t*   pPrivateKey,
+    ecdhPublicKey_t*    pPeerPublicKey,
+    ecdhDhKey_t*        pOutDhKey,
+    void*               pMultiplicationBuffer
+)
+{
+    ecP256Context_t* pCtx = (ecP256Context_t*)pMultiplicationBuffer;
+    secResultType_t result;
+
+    result = ECDH_P256_ComputeDhKeyStart(pCtx, pPrivateKey, pPeerPublicKey, pOutDhKey);
+
+    while( gSecResultPending_c == result )
+    {
+        result = ECDH_P256_Continue(pCtx);
+    }
+
+    if( gSecInvalidPublicKey_c == result )
+    {
+        return gEcdhInvalidPublicKey_c;
+    }
+
+    return (gSecSuccess_c == result) ? gEcdhSuccess_c : gEcdhBadParameters_c;
+}
+
+/************************************************************************************
+* \brief Starts the generation of a new Private/Public Key Pair. The private key is
+*        written before returning, the public key by the last ECDH_P256_Continue() call.
+*
+* \param [in]  pCtx           Context, owned by the caller until the operation ends.
+* \param [out] pOutPublicKey  Public key, little endian coordinates.
+* \param [out] pOutPrivateKey Private key, little endian.
+*
+* \return gSecResultPending_c, or gSecError_c if no random number is available
+*
+************************************************************************************/
+secResultType_t ECDH_P256_GenerateKeysStart
+(
+    ecP256Context_t*    pCtx,
+    ecdhPublicKey_t*    pOutPublicKey,
+    ecdhPrivateKey_t*   pOutPrivateKey
+)
+{
+    FLib_MemSet(pCtx, 0, sizeof(ecP256Context_t));
+
+    if( gSecSuccess_c != EcP256_GenerateScalar(pCtx->scalar) )
+    {
+        return gSecError_c;
+    }
+
+    EcP256_Store(pOutPrivateKey->raw_8bit, pCtx->scalar);
+
+    /* Start from the point at infinity, (0 : 1 : 0) */
+    FLib_MemCpy(pCtx->result.Y, (void*)mEcP256_One, sizeof(mEcP256_One));
+
+    pCtx->pOutPoint = pOutPublicKey;
+    pCtx->step = mEcP256CombSpacing_c;
+    pCtx->state = mEcP256Comb_c;
+
+    return gSecResultPending_c;
+}
+
+/************************************************************************************
+* \brief Starts the computation of a Diffie-Hellman key. The key is written by the
+*        last ECDH_P256_Continue() call.
+*
+* \param [in]  pCtx           Context, owned by the caller until the operation ends.
+* \param [in]  pPrivateKey    Private key, little endian.
+* \param [in]  pPeerPublicKey Peer public key, little endian coordinates.
+* \param [out] pOutDhKey      Diffie-Hellman key, little endian coordinates.
+*
+* \return gSecResultPending_c, gSecInvalidPublicKey_c if the peer key is not on the
+*         curve, or gSecError_c if the private key is not valid
+*
+************************************************************************************/
+secResultType_t ECDH_P256_ComputeDhKeyStart
+(
+    ecP256Context_t*    pCtx,
+    const ecdhPrivateKey_t* pPrivateKey,
+    const ecdhPublicKey_t*  pPeerPublicKey,
+    ecdhDhKey_t*        pOutDhKey
+)
+{
+    ecP256Point_t* pP = &pCtx->table[0];
+    uint32_t t[gEcP256Words_c];
+    uint32_t mask;
+
+    FLib_MemSet(pCtx, 0, sizeof(ecP256Context_t));
+
+    EcP256_Load(pCtx->scalar, pPrivateKey->raw_8bit);
+
+    if( EcP256_IsZero(pCtx->scalar) || !EcP256_IsLess(pCtx->scalar, mEcP256_n) )
+    {
+        FLib_MemSet(pCtx, 0, sizeof(ecP256Context_t));
+        return gSecError_c;
+    }
+
+    EcP256_Load(pP->X, pPeerPublicKey->components_8bit.x);
+    EcP256_Load(pP->Y, pPeerPublicKey->components_8bit.y);
+
+    if( !EcP256_IsLess(pP->X, mEcP256_p) || !EcP256_IsLess(pP->Y, mEcP256_p) )
+    {
+        FLib_MemSet(pCtx, 0, sizeof(ecP256Context_t));
+        return gSecInvalidPublicKey_c;
+    }
+
+    EcP256_FieldMul(pP->X, pP->X, mEcP256_R2);
+    EcP256_FieldMul(pP->Y, pP->Y, mEcP256_R2);
+    FLib_MemCpy(pP->Z, (void*)mEcP256_One, sizeof(mEcP256_One));
+
+    /* The peer key must be on the curve: y^2 = x^3 - 3x + b */
+    EcP256_FieldMul(pCtx->result.X, pP->X, pP->X);
+    EcP256_FieldMul(pCtx->result.X, pCtx->result.X, pP->X);
+    EcP256_FieldSub(pCtx->result.X, pCtx->result.X, pP->X);
+    EcP256_FieldSub(pCtx->result.X, pCtx->result.X, pP->X);
+    EcP256_FieldSub(pCtx->result.X, pCtx->result.X, pP->X);
+    EcP256_FieldAdd(pCtx->result.X, pCtx->result.X, mEcP256_b);
+    EcP256_FieldMul(pCtx->result.Y, pP->Y, pP->Y);
+
+    if( !FLib_MemCmp(pCtx->result.X, pCtx->result.Y, sizeof(pCtx->result.X)) )
+    {
+        FLib_MemSet(pCtx, 0, sizeof(ecP256Context_t));
+        return gSecInvalidPublicKey_c;
+    }
+
+    /* The recoding needs an odd scalar. An even k is replaced by n - k, and the
+       result is negated at the end, since (n - k)P = -kP. */
+    mask = (pCtx->scalar[0] & 1) - 1;
+    EcP256_SubWords(t, mEcP256_n, pCtx->scalar);
+    EcP256_CondCopy(pCtx->scalar, t, mask, gEcP256Words_c);
+    pCtx->negate = (uint8_t)(mask & 1);
+
+    EcP256_Recode(pCtx->digits, pCtx->scalar);
+
+    pCtx->pOutPoint = pOutDhKey;
+    pCtx->state = mEcP256Table_c;
+
+    return gSecResultPending_c;
+}
+
+/************************************************************************************
+* \brief Runs the next slice of a P-256 operation.
+*
+* \param [in]  pCtx           Context passed to the Start function.
+*
+* \return gSecResultPending_c while work remains, then gSecSuccess_c or gSecError_c
+*
+************************************************************************************/
+secResultType_t ECDH_P256_Continue
+(
+    ecP256Context_t*    pCtx
+)
+{
+    ecP256Point_t* pQ = &pCtx->result;
+    ecP256Point_t point;
+    int32_t budget = gSecLibEcP256SliceOps_c;
+    uint32_t i;
+
+    switch( pCtx->state )
+    {
+    case mEcP256Comb_c:
+        /* One doubling and one addition for each of the 52 columns of the comb */
+        while( pCtx->step && (budget > 0) )
+        {
+            pCtx->step--;
+            EcP256_PointDouble(pQ, pQ);
+            EcP256_CombLookup(&point, EcP256_CombIndex(pCtx->scalar, pCtx->step));
+            EcP256_PointAdd(pQ, pQ, &point);
+            budget -= 2;
+        }
+
+        if( 0 == pCtx->step )
+        {
+            pCtx->state = mEcP256Finish_c;
+        }
+        break;
+
+    case mEcP256Table_c:
+        /* table[i] = (2i + 1)P */
+        EcP256_PointDouble(&point, &pCtx->table[0]);
+
+        for( i = 1; i < gEcP256WindowPoints_c; i++ )
+        {
+            EcP256_PointAdd(&pCtx->table[i], &pCtx->table[i - 1], &point);
+        }
+
+        EcP256_WindowLookup(pQ, pCtx->table, pCtx->digits[gEcP256ScalarDigits_c - 1]);
+        pCtx->step = gEcP256ScalarDigits_c - 1;
+        pCtx->state = mEcP256Window_c;
+        break;
+
+    case mEcP256Window_c:
+        /* Four doublings and one addition for each signed digit */
+        while( pCtx->step && (budget > 0) )
+        {
+            pCtx->step--;
+
+            for( i = 0; i < mEcP256WindowBits_c; i++ )
+            {
+                EcP256_PointDouble(pQ, pQ);
+            }
+
+            EcP256_WindowLookup(&point, pCtx->table, pCtx->digits[pCtx->step]);
+            EcP256_PointAdd(pQ, pQ, &point);
+            budget -= mEcP256WindowBits_c + 1;
+        }
+
+        if( 0 == pCtx->step )
+        {
+            pCtx->state = mEcP256Finish_c;
+        }
+        break;
+
+    case mEcP256Finish_c:
+        return EcP256_Finish(pCtx);
+
+    default:
+        return gSecError_c;
+    }
+
+    return gSecResultPending_c;
+}
+#endif /* gSecLibSwEcP256_d */
+
 /****************************************************************************
  *
  * NAME:       bACI_WriteKey
@@ -2044,9 +4770,14 @@ uint32_t u32Reverse(uint32_t u32InWord)
 {
     uint32_t u32OutWord;
 
+#if defined(CPU_HOST)
+    u32OutWord = (u32InWord >> 24) | ((u32InWord >> 8) & 0x0000FF00) |
+                 ((u32InWord << 8) & 0x00FF0000) | (u32InWord << 24);
+#else
     asm volatile ("REV %[reverse], %[input];"
                   : [reverse] "=r" (u32OutWord)
                   : [input]  "r"  (u32InWord)   );
+#endif
 
     return u32OutWord;
 }
@@ -37,8 +37,71 @@
 #define gSecLib_CCM_Decrypt_c 1
 
 #define AES_BLOCK_SIZE     16 /* [bytes] */
+#define AES_128_EXPANDED_KEY_WORDS 44 /* [words] 4 * (10 rounds + 1) */
 #define AESSW_BLK_SIZE     (AES_BLOCK_SIZE)
 
+/* Number of blocks passed to the LTC in one CBC-MAC session by the streaming
+   CMAC and CCM functions. Bounds the stack used for the discarded output. */
+#ifndef gSecLibCbcMacChunkBlocks_c
+#define gSecLibCbcMacChunkBlocks_c 4
+#endif
+
+/* Run the jobs passed to SecLib_SubmitJob() asynchronously, on the LTC fed by
+   eDMA. When disabled, or on parts without LTC, the jobs run synchronously. */
+#ifndef gSecLibAsyncJobs_d
+#define gSecLibAsyncJobs_d 0
+#endif
+
+/* eDMA channels used to feed the LTC input and output FIFOs */
+#ifndef gSecLibLtcInputDmaChannel_c
+#define gSecLibLtcInputDmaChannel_c  2
+#endif
+
+#ifndef gSecLibLtcOutputDmaChannel_c
+#define gSecLibLtcOutputDmaChannel_c 3
+#endif
+
+/* eDMA and DMAMUX instances of those channels */
+#ifndef gSecLibLtcDma_c
+#define gSecLibLtcDma_c              DMA0
+#endif
+
+#ifndef gSecLibLtcDmaMux_c
+#define gSecLibLtcDmaMux_c           DMAMUX0
+#endif
+
+/* SecLib_Init() initializes the eDMA and the DMAMUX. Disable it when the
+   application initializes them for all their users. */
+#ifndef gSecLibLtcDmaInit_d
+#define gSecLibLtcDmaInit_d          1
+#endif
+
+/* The SecLib task starts the asynchronous jobs, and runs the CCM ones */
+#ifndef gSecLibTaskStackSize_c
+#define gSecLibTaskStackSize_c       600
+#endif
+
+#ifndef gSecLibTaskPriority_c
+#define gSecLibTaskPriority_c        2
+#endif
+
+/* Use the SecLib P-256 implementation for ECDH instead of the one from lib_crypto.
+   ECDH_P256_GenerateKeys() and ECDH_P256_ComputeDhKey() then allocate a context of
+   gEcP256_MultiplicationBufferSize_c bytes (about 1 KB), larger than the default
+   memory pools: the application must add a pool for it. */
+#ifndef gSecLibSwEcP256_d
+#define gSecLibSwEcP256_d 0
+#endif
+
+/* Number of point doublings and additions done by one ECDH_P256_Continue() call */
+#ifndef gSecLibEcP256SliceOps_c
+#define gSecLibEcP256SliceOps_c 16
+#endif
+
+#define gEcP256Words_c          8  /* [words] */
+#define gEcP256WindowPoints_c   8  /* odd multiples 1P..15P of the peer public key */
+#define gEcP256ScalarDigits_c  65  /* signed 4-bit digits of a 256-bit scalar */
+
 #define SHA1_HASH_SIZE     20 /* [bytes] */
 #define SHA1_BLOCK_SIZE    64 /* [bytes] */
 
@@ -59,7 +122,8 @@ typedef enum
     gSecSuccess_c,
     gSecAllocError_c,
     gSecError_c,
-    gSecInvalidPublicKey_c
+    gSecInvalidPublicKey_c,
+    gSecResultPending_c
 } secResultType_t;
 
 typedef struct sha1Context_tag{
@@ -81,6 +145,77 @@ typedef struct HMAC_SHA256_context_tag{
     uint8_t pad[SHA256_BLOCK_SIZE];
 }HMAC_SHA256_context_t;
 
+/*! AES-128 context. Holds the expanded key (software and MMCAU), or the raw
+*   key (LTC), so that multi-block operations set up the key only once. */
+typedef struct AES_128_Ctx_tag{
+    uint32_t roundKeys[AES_128_EXPANDED_KEY_WORDS];
+}AES_128_Ctx_t;
+
+/*! AES-128-CMAC streaming context. The last block received is kept in the
+*   buffer, since it is processed differently when the MAC is finished. */
+typedef struct AES_128_CMAC_Ctx_tag{
+    AES_128_Ctx_t aesCtx;
+    uint8_t mac[AES_BLOCK_SIZE];
+    uint8_t buffer[AES_BLOCK_SIZE];
+    uint8_t bufferLen;
+}AES_128_CMAC_Ctx_t;
+
+/*! AES-128-CTR streaming context. The key stream left unused by a call is
+*   consumed by the next one, so the data may be split at any byte. */
+typedef struct AES_128_CTR_Ctx_tag{
+    AES_128_Ctx_t aesCtx;
+    uint8_t counter[AES_BLOCK_SIZE];
+    uint8_t keyStream[AES_BLOCK_SIZE];
+    uint8_t keyStreamUsed;
+}AES_128_CTR_Ctx_t;
+
+/*! AES-128-CCM streaming context */
+typedef struct AES_128_CCM_Ctx_tag{
+    AES_128_CTR_Ctx_t ctrCtx;
+    uint8_t  mac[AES_BLOCK_SIZE];
+    uint8_t  tagMask[AES_BLOCK_SIZE];
+    uint32_t authDataLeft;
+    uint32_t inputLeft;
+    uint8_t  macUsed;
+    uint8_t  macSize;
+    uint8_t  flags;
+}AES_128_CCM_Ctx_t;
+
+/*! AES-128 job types */
+typedef enum secLibJobType_tag {
+    gSecLibJobCtr_c,
+    gSecLibJobCbcEncrypt_c,
+    gSecLibJobCbcDecrypt_c,
+    gSecLibJobCcm_c
+} secLibJobType_t;
+
+struct secLibJob_tag;
+
+/*! Job completion callback. When the jobs are processed asynchronously, it runs
+*   in interrupt context for CTR and CBC jobs, and in the SecLib task for CCM jobs. */
+typedef void (*secLibJobCallback_t)(struct secLibJob_tag* pJob, secResultType_t status);
+
+/*! AES-128 job. The job and all the buffers it points to are owned by the
+*   caller and must remain valid until the completion callback is called. */
+typedef struct secLibJob_tag{
+    secLibJobType_t     type;
+    const uint8_t*      pKey;        /*!< 128-bit key */
+    const uint8_t*      pInput;
+    uint8_t*            pOutput;
+    uint32_t            length;      /*!< Multiple of the AES block size for CBC jobs */
+    uint8_t*            pIv;         /*!< CBC initialization vector, or CTR counter (updated) */
+    const uint8_t*      pAuthData;   /*!< CCM additional authentication data */
+    uint16_t            authDataLen;
+    const uint8_t*      pNonce;      /*!< CCM nonce */
+    uint8_t             nonceSize;
+    uint8_t             macSize;
+    uint8_t*            pMac;        /*!< CCM MAC, written when encrypting, checked when decrypting */
+    uint32_t            flags;       /*!< CCM direction, gSecLib_CCM_Encrypt_c or gSecLib_CCM_Decrypt_c */
+    secLibJobCallback_t callback;
+    void*               pParam;      /*!< Not used by SecLib */
+    struct secLibJob_tag* pNext;     /*!< Used internally by the job queue */
+}secLibJob_t;
+
 typedef enum ecdhStatus_tag {
     gEcdhSuccess_c,
     gEcdhBadParameters_c,
@@ -111,6 +246,26 @@ typedef ecdhPoint_t ecdhPublicKey_t;
 
 typedef ecdhPoint_t ecdhDhKey_t;
 
+/*! P-256 point in projective coordinates, Montgomery form */
+typedef struct ecP256Point_tag{
+    uint32_t X[gEcP256Words_c];
+    uint32_t Y[gEcP256Words_c];
+    uint32_t Z[gEcP256Words_c];
+}ecP256Point_t;
+
+/*! Context of a P-256 key generation or Diffie-Hellman computation, done in
+*   slices by ECDH_P256_Continue(). Holds secret data until the operation ends. */
+typedef struct ecP256Context_tag{
+    ecP256Point_t  table[gEcP256WindowPoints_c];
+    ecP256Point_t  result;
+    uint32_t       scalar[gEcP256Words_c];
+    int8_t         digits[gEcP256ScalarDigits_c];
+    uint8_t        state;
+    uint8_t        step;
+    uint8_t        negate;
+    ecdhPoint_t*   pOutPoint;
+}ecP256Context_t;
+
 /* Security block definition */
 typedef union
 {
@@ -499,6 +654,385 @@ uint8_t AES_128_CCM(uint8_t* pInput,
                     uint8_t  macSize,
                     uint32_t flags);
 
+/*! *********************************************************************************
+* \brief  This function expands an AES-128 key into a context, to be used by the
+*         *_WithCtx functions.
+*
+* \param[out] pCtx Pointer to the AES-128 context.
+*
+* \param[in]  pKey Pointer to the location of the 128-bit key.
+*
+********************************************************************************** */
+void AES_128_SetKey(AES_128_Ctx_t* pCtx,
+                    const uint8_t* pKey);
+
+/*! *********************************************************************************
+* \brief  This function performs AES-128 encryption on a 16-byte block.
+*
+* \param[in]  pCtx Pointer to the AES-128 context.
+*
+* \param[in]  pInput Pointer to the location of the 16-byte plain text block.
+*
+* \param[out]  pOutput Pointer to the location to store the 16-byte ciphered output.
+*
+********************************************************************************** */
+void AES_128_Encrypt_WithCtx(AES_128_Ctx_t* pCtx,
+                             const uint8_t* pInput,
+                             uint8_t* pOutput);
+
+/*! *********************************************************************************
+* \brief  This function performs AES-128 decryption on a 16-byte block.
+*
+* \param[in]  pCtx Pointer to the AES-128 context.
+*
+* \param[in]  pInput Pointer to the location of the 16-byte ciphered block.
+*
+* \param[out]  pOutput Pointer to the location to store the 16-byte plain text output.
+*
+********************************************************************************** */
+void AES_128_Decrypt_WithCtx(AES_128_Ctx_t* pCtx,
+                             const uint8_t* pInput,
+                             uint8_t* pOutput);
+
+/*! *********************************************************************************
+* \brief  This function performs AES-128-ECB encryption on a message block.
+*
+* \param[in]  pCtx Pointer to the AES-128 context.
+*
+* \param[in]  pInput Pointer to the location of the input message.
+*
+* \param[in]  numBlocks Input message number of 16-byte blocks.
+*
+* \param[out]  pOutput Pointer to the location to store the ciphered output.
+*
+********************************************************************************** */
+void AES_128_ECB_Block_Encrypt_WithCtx(AES_128_Ctx_t* pCtx,
+                                       const uint8_t* pInput,
+                                       uint32_t numBlocks,
+                                       uint8_t* pOutput);
+
+/*! *********************************************************************************
+* \brief  This function performs AES-128-CBC encryption on a message block.
+*
+* \param[in]  pCtx Pointer to the AES-128 context.
+*
+* \param[in]  pInput Pointer to the location of the input message.
+*
+* \param[in]  inputLen Input message length in bytes. Must be a multiple of the AES block size.
+*
+* \param[in, out]  pInitVector Pointer to the location of the 128-bit initialization vector.
+*                  It is updated with the last ciphered block, so that consecutive calls chain.
+*
+* \param[out]  pOutput Pointer to the location to store the ciphered output.
+*
+********************************************************************************** */
+void AES_128_CBC_Encrypt_WithCtx(AES_128_Ctx_t* pCtx,
+                                 const uint8_t* pInput,
+                                 uint32_t inputLen,
+                                 uint8_t* pInitVector,
+                                 uint8_t* pOutput);
+
+/*! *********************************************************************************
+* \brief  This function performs AES-128-CTR encryption on a message block.
+*
+* \param[in]  pCtx Pointer to the AES-128 context.
+*
+* \param[in]  pInput Pointer to the location of the input message.
+*
+* \param[in]  inputLen Input message length in bytes.
+*
+* \param[in, out]  pCounter Pointer to the location of the 128-bit counter.
+*
+* \param[out]  pOutput Pointer to the location to store the ciphered output.
+*
+********************************************************************************** */
+void AES_128_CTR_WithCtx(AES_128_Ctx_t* pCtx,
+                         const uint8_t* pInput,
+                         uint32_t inputLen,
+                         uint8_t* pCounter,
+                         uint8_t* pOutput);
+
+/*! *********************************************************************************
+* \brief  This function performs AES-128-OFB encryption on a message block.
+*
+* \param[in]  pCtx Pointer to the AES-128 context.
+*
+* \param[in]  pInput Pointer to the location of the input message.
+*
+* \param[in]  inputLen Input message length in bytes.
+*
+* \param[in]  pInitVector Pointer to the location of the 128-bit initialization vector.
+*
+* \param[out]  pOutput Pointer to the location to store the ciphered output.
+*
+********************************************************************************** */
+void AES_128_OFB_WithCtx(AES_128_Ctx_t* pCtx,
+                         const uint8_t* pInput,
+                         uint32_t inputLen,
+                         const uint8_t* pInitVector,
+                         uint8_t* pOutput);
+
+/*! *********************************************************************************
+* \brief  This function performs AES-128-CMAC on a message block.
+*
+* \param[in]  pCtx Pointer to the AES-128 context.
+*
+* \param[in]  pInput Pointer to the location of the input message. The input data must be provided MSB first.
+*
+* \param[in]  inputLen Length of the input message in bytes.
+*
+* \param[out]  pOutput Pointer to the location to store the 16-byte authentication code.
+*
+********************************************************************************** */
+void AES_128_CMAC_WithCtx(AES_128_Ctx_t* pCtx,
+                          const uint8_t* pInput,
+                          uint32_t inputLen,
+                          uint8_t* pOutput);
+
+/*! *********************************************************************************
+* \brief  This function performs AES-128-EAX encryption on a message block.
+*
+* \param[in]  pCtx Pointer to the AES-128 context.
+*
+* \param[in]  pInput Pointer to the location of the input message.
+*
+* \param[in]  inputLen Length of the input message in bytes.
+*
+* \param[in]  pNonce Pointer to the location of the nonce.
+*
+* \param[in]  nonceLen Nonce length in bytes.
+*
+* \param[in]  pHeader Pointer to the location of header.
+*
+* \param[in]  headerLen Header length in bytes.
+*
+* \param[out]  pOutput Pointer to the location to store the ciphered output.
+*
+* \param[out]  pTag Pointer to the location to store the 128-bit tag.
+*
+* \return gSecSuccess_c or error.
+*
+********************************************************************************** */
+secResultType_t AES_128_EAX_Encrypt_WithCtx(AES_128_Ctx_t* pCtx,
+                                            const uint8_t* pInput,
+                                            uint32_t inputLen,
+                                            const uint8_t* pNonce,
+                                            uint32_t nonceLen,
+                                            const uint8_t* pHeader,
+                                            uint8_t headerLen,
+                                            uint8_t* pOutput,
+                                            uint8_t* pTag);
+
+/*! *********************************************************************************
+* \brief  This function performs AES-128-EAX decryption on a message block.
+*
+* \param[in]  pCtx Pointer to the AES-128 context.
+*
+* \param[in]  pInput Pointer to the location of the ciphered message.
+*
+* \param[in]  inputLen Length of the input message in bytes.
+*
+* \param[in]  pNonce Pointer to the location of the nonce.
+*
+* \param[in]  nonceLen Nonce length in bytes.
+*
+* \param[in]  pHeader Pointer to the location of header.
+*
+* \param[in]  headerLen Header length in bytes.
+*
+* \param[out]  pOutput Pointer to the location to store the plain text output.
+*
+* \param[in]  pTag Pointer to the location of the 128-bit tag to be checked.
+*
+* \return gSecSuccess_c, or gSecError_c if the tag does not match.
+*
+********************************************************************************** */
+secResultType_t AES_128_EAX_Decrypt_WithCtx(AES_128_Ctx_t* pCtx,
+                                            const uint8_t* pInput,
+                                            uint32_t inputLen,
+                                            const uint8_t* pNonce,
+                                            uint32_t nonceLen,
+                                            const uint8_t* pHeader,
+                                            uint8_t headerLen,
+                                            uint8_t* pOutput,
+                                            const uint8_t* pTag);
+
+/*! *********************************************************************************
+* \brief  This function initializes an AES-128-CMAC streaming context.
+*
+* \param[out] pCtx Pointer to the AES-128-CMAC context.
+*
+* \param[in]  pKey Pointer to the location of the 128-bit key.
+*
+********************************************************************************** */
+void AES_128_CMAC_Init(AES_128_CMAC_Ctx_t* pCtx,
+                       const uint8_t* pKey);
+
+/*! *********************************************************************************
+* \brief  This function adds data to an AES-128-CMAC computation. The message
+*         may be split in chunks of any size.
+*
+* \param[in, out] pCtx Pointer to the AES-128-CMAC context.
+*
+* \param[in]  pInput Pointer to the location of the message chunk. MSB first.
+*
+* \param[in]  inputLen Length of the message chunk in bytes.
+*
+********************************************************************************** */
+void AES_128_CMAC_Update(AES_128_CMAC_Ctx_t* pCtx,
+                         const uint8_t* pInput,
+                         uint32_t inputLen);
+
+/*! *********************************************************************************
+* \brief  This function finishes an AES-128-CMAC computation.
+*
+* \param[in]  pCtx Pointer to the AES-128-CMAC context.
+*
+* \param[out]  pOutput Pointer to the location to store the 16-byte authentication code.
+*
+********************************************************************************** */
+void AES_128_CMAC_Finish(AES_128_CMAC_Ctx_t* pCtx,
+                         uint8_t* pOutput);
+
+/*! *********************************************************************************
+* \brief  This function initializes an AES-128-CTR streaming context.
+*
+* \param[out] pCtx Pointer to the AES-128-CTR context.
+*
+* \param[in]  pKey Pointer to the location of the 128-bit key.
+*
+* \param[in]  pCounter Pointer to the location of the initial 128-bit counter.
+*
+********************************************************************************** */
+void AES_128_CTR_Init(AES_128_CTR_Ctx_t* pCtx,
+                      const uint8_t* pKey,
+                      const uint8_t* pCounter);
+
+/*! *********************************************************************************
+* \brief  This function encrypts or decrypts the next chunk of an AES-128-CTR
+*         stream. The stream may be split in chunks of any size.
+*
+* \param[in, out] pCtx Pointer to the AES-128-CTR context.
+*
+* \param[in]  pInput Pointer to the location of the input chunk.
+*
+* \param[in]  inputLen Length of the input chunk in bytes.
+*
+* \param[out]  pOutput Pointer to the location to store the output chunk. May be the same as pInput.
+*
+********************************************************************************** */
+void AES_128_CTR_Update(AES_128_CTR_Ctx_t* pCtx,
+                        const uint8_t* pInput,
+                        uint32_t inputLen,
+                        uint8_t* pOutput);
+
+/*! *********************************************************************************
+* \brief  This function initializes an AES-128-CCM streaming context. The total
+*         lengths are part of the first CCM block, so they must be known upfront.
+*
+* \param[out] pCtx Pointer to the AES-128-CCM context.
+*
+* \param[in]  pKey Pointer to the location of the 128-bit key.
+*
+* \param[in]  pNonce Pointer to the Nonce.
+*
+* \param[in]  nonceSize The size of the nonce (7-13).
+*
+* \param[in]  authDataLen Total length of the additional authentication data.
+*
+* \param[in]  inputLen Total length of the plaintext (or of the cyphertext without the MAC).
+*
+* \param[in]  macSize The size of the MAC (4, 6, ..., 16).
+*
+* \param[in]  flags Select encrypt/decrypt operations (gSecLib_CCM_Encrypt_c, gSecLib_CCM_Decrypt_c)
+*
+* \return gSecSuccess_c, or gSecError_c if the parameters are not valid.
+*
+********************************************************************************** */
+secResultType_t AES_128_CCM_Init(AES_128_CCM_Ctx_t* pCtx,
+                                 const uint8_t* pKey,
+                                 const uint8_t* pNonce,
+                                 uint8_t  nonceSize,
+                                 uint32_t authDataLen,
+                                 uint32_t inputLen,
+                                 uint8_t  macSize,
+                                 uint32_t flags);
+
+/*! *********************************************************************************
+* \brief  This function adds a chunk of additional authentication data to an
+*         AES-128-CCM operation. All the authentication data must be added before
+*         the first call to AES_128_CCM_Update().
+*
+* \param[in, out] pCtx Pointer to the AES-128-CCM context.
+*
+* \param[in]  pAuthData Pointer to the authentication data chunk.
+*
+* \param[in]  authDataLen Length of the authentication data chunk.
+*
+* \return gSecSuccess_c, or gSecError_c if more data than announced is added.
+*
+********************************************************************************** */
+secResultType_t AES_128_CCM_UpdateAuthData(AES_128_CCM_Ctx_t* pCtx,
+                                           const uint8_t* pAuthData,
+                                           uint32_t authDataLen);
+
+/*! *********************************************************************************
+* \brief  This function encrypts or decrypts the next chunk of an AES-128-CCM message.
+*
+* \param[in, out] pCtx Pointer to the AES-128-CCM context.
+*
+* \param[in]  pInput Pointer to the location of the input chunk.
+*
+* \param[in]  inputLen Length of the input chunk in bytes.
+*
+* \param[out]  pOutput Pointer to the location to store the output chunk. May be the same as pInput.
+*
+* \return gSecSuccess_c, or gSecError_c if called out of order or with more data than announced.
+*
+* \remarks The decrypted data must not be trusted before AES_128_CCM_Finish() succeeds.
+*
+********************************************************************************** */
+secResultType_t AES_128_CCM_Update(AES_128_CCM_Ctx_t* pCtx,
+                                   const uint8_t* pInput,
+                                   uint32_t inputLen,
+                                   uint8_t* pOutput);
+
+/*! *********************************************************************************
+* \brief  This function finishes an AES-128-CCM operation.
+*
+* \param[in]  pCtx Pointer to the AES-128-CCM context.
+*
+* \param[in, out]  pCbcMac Pointer to the location to store the MAC when encrypting.
+*                  Pointer to the location where the received MAC can be found when decrypting.
+*
+* \return gSecSuccess_c, or gSecError_c if the data announced was not processed
+*         or the MAC check failed.
+*
+********************************************************************************** */
+secResultType_t AES_128_CCM_Finish(AES_128_CCM_Ctx_t* pCtx,
+                                   uint8_t* pCbcMac);
+
+/*! *********************************************************************************
+* \brief  This function queues an AES-128 job. With gSecLibAsyncJobs_d enabled,
+*         the SecLib task starts the queued jobs: CTR and CBC jobs are transferred
+*         to and from the LTC by eDMA, so the CPU is free until the completion
+*         callback. CCM jobs are run by the LTC in the SecLib task, since the eDMA
+*         driver does not support CCM. Otherwise the job runs before this function
+*         returns. It may be called from interrupt context.
+*
+*         A synchronous SecLib operation waits for the running job. Called from
+*         an interrupt handler, or with the interrupts masked, it serves the eDMA
+*         channels itself. It must not preempt a CCM job, like it must not preempt
+*         another synchronous operation.
+*
+* \param[in]  pJob Pointer to the job.
+*
+* \return gSecSuccess_c if the job was accepted, or gSecError_c if it is not valid.
+*         The result of the job itself is passed to the callback.
+*
+********************************************************************************** */
+secResultType_t SecLib_SubmitJob(secLibJob_t* pJob);
+
 /*! *********************************************************************************
 * \brief  This function initializes the SHA1 context data
 *
@@ -705,6 +1239,64 @@ secResultType_t ECDH_P256_ComputeDhKey
     ecdhDhKey_t*        pOutDhKey
 );
 
+#if gSecLibSwEcP256_d
+/************************************************************************************
+* \brief Starts the generation of a new Private/Public Key Pair. The private key is
+*        written before returning, the public key by the last ECDH_P256_Continue() call.
+*        The public key is computed with a fixed-base comb over a table in flash.
+*
+* \param [in]  pCtx           Context, owned by the caller until the operation ends.
+* \param [out] pOutPublicKey  Public key, little endian coordinates.
+* \param [out] pOutPrivateKey Private key, little endian.
+*
+* \return gSecResultPending_c, or gSecError_c if no random number is available
+*
+************************************************************************************/
+secResultType_t ECDH_P256_GenerateKeysStart
+(
+    ecP256Context_t*    pCtx,
+    ecdhPublicKey_t*    pOutPublicKey,
+    ecdhPrivateKey_t*   pOutPrivateKey
+);
+
+/************************************************************************************
+* \brief Starts the computation of a Diffie-Hellman key. The key is written by the
+*        last ECDH_P256_Continue() call. The scalar multiplication uses a signed
+*        4-bit window with constant time table lookups.
+*
+* \param [in]  pCtx           Context, owned by the caller until the operation ends.
+* \param [in]  pPrivateKey    Private key, little endian.
+* \param [in]  pPeerPublicKey Peer public key, little endian coordinates.
+* \param [out] pOutDhKey      Diffie-Hellman key, little endian coordinates.
+*
+* \return gSecResultPending_c, gSecInvalidPublicKey_c if the peer key is not on the
+*         curve, or gSecError_c if the private key is not valid
+*
+************************************************************************************/
+secResultType_t ECDH_P256_ComputeDhKeyStart
+(
+    ecP256Context_t*    pCtx,
+    const ecdhPrivateKey_t* pPrivateKey,
+    const ecdhPublicKey_t*  pPeerPublicKey,
+    ecdhDhKey_t*        pOutDhKey
+);
+
+/************************************************************************************
+* \brief Runs the next slice of a P-256 operation, at most gSecLibEcP256SliceOps_c
+*        point operations or the final inversion. Can be called from a low priority
+*        task, so that other tasks run between the slices.
+*
+* \param [in]  pCtx           Context passed to the Start function.
+*
+* \return gSecResultPending_c while work remains, then gSecSuccess_c or gSecError_c
+*
+************************************************************************************/
+secResultType_t ECDH_P256_Continue
+(
+    ecP256Context_t*    pCtx
+);
+#endif /* gSecLibSwEcP256_d */
+
 /****************************************************************************
  * \brief Perform an MMO Block Update on the hash
  *        H[j] = E(H[j-1], M[j]) ^ M[j]
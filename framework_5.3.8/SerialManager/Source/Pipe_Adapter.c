@@ -0,0 +1,367 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* This is the source file for the Pipe adapter of the Host platform. It implements
+* the custom interface functions of the SerialManager over file descriptors.
+*
+* A receive thread and a transmit thread do the blocking I/O. They pend
+* gPipeIrqId_c when data is received or sent, and the handler notifies the
+* SerialManager, so the notifications run in interrupt context, as with a UART.
+* Bytes the SerialManager cannot store are delivered again one tick later.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#define _GNU_SOURCE
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "fsl_device_registers.h"
+#include "fsl_os_abstraction.h"
+#include "SerialManager.h"
+#include "Pipe_Adapter.h"
+#include "Host.h"
+
+#if gSerialMgrUseCustomInterface_c
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+********************************************************************************** */
+static void  Pipe_ISR(void);
+static void* Pipe_RxThread(void *pParam);
+static void* Pipe_TxThread(void *pParam);
+static void  Pipe_SetRawMode(int fd);
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+********************************************************************************** */
+static pthread_mutex_t mPipeLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  mPipeTxCond = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t  mPipeRxCond;
+
+static uint8_t  mPipeInterfaceId;
+static bool_t   mPipeInitialized;
+static int      mPipeRxFd = -1;
+static int      mPipeTxFd = -1;
+static char     mPipeDeviceName[64];
+
+/* Block being sent by the transmit thread, and end of transmission flag */
+static uint8_t *mpPipeTxData;
+static uint32_t mPipeTxSize;
+static bool_t   mPipeTxDone;
+
+/* Bytes received, not yet stored by the SerialManager */
+static uint8_t  mPipeRxBuffer[gPipeRxBufferSize_c];
+static uint32_t mPipeRxOffset;
+static uint32_t mPipeRxCount;
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+
+/*! *********************************************************************************
+* \brief  Connects a custom interface of the SerialManager to a host device
+*
+********************************************************************************** */
+uint32_t Pipe_Initialize(uint8_t interfaceId, const char *pDevice)
+{
+    pthread_condattr_t attr;
+    const char *pSlaveName;
+    int slaveFd;
+    int fd;
+
+    if( mPipeInitialized )
+    {
+        return gPipeBusy_c;
+    }
+
+    if( NULL == pDevice )
+    {
+        mPipeRxFd = STDIN_FILENO;
+        mPipeTxFd = STDOUT_FILENO;
+        strncpy(mPipeDeviceName, "stdio", sizeof(mPipeDeviceName) - 1);
+    }
+    else if( 0 == strcmp(pDevice, gPipePtyDevice_c) )
+    {
+        fd = posix_openpt(O_RDWR | O_NOCTTY);
+        if( (fd < 0) || grantpt(fd) || unlockpt(fd) || (NULL == (pSlaveName = ptsname(fd))) )
+        {
+            return gPipeOpenError_c;
+        }
+        strncpy(mPipeDeviceName, pSlaveName, sizeof(mPipeDeviceName) - 1);
+
+        /* The slave is kept open: it keeps the line raw for the peer, and the reads
+           of the master from failing while no peer is connected */
+        slaveFd = open(mPipeDeviceName, O_RDWR | O_NOCTTY);
+        if( slaveFd < 0 )
+        {
+            (void)close(fd);
+            return gPipeOpenError_c;
+        }
+        Pipe_SetRawMode(slaveFd);
+
+        mPipeRxFd = fd;
+        mPipeTxFd = fd;
+    }
+    else
+    {
+        fd = open(pDevice, O_RDWR | O_NOCTTY);
+        if( fd < 0 )
+        {
+            return gPipeOpenError_c;
+        }
+        strncpy(mPipeDeviceName, pDevice, sizeof(mPipeDeviceName) - 1);
+        Pipe_SetRawMode(fd);
+
+        mPipeRxFd = fd;
+        mPipeTxFd = fd;
+    }
+
+    /* A write to a closed peer fails instead of ending the process */
+    (void)signal(SIGPIPE, SIG_IGN);
+
+    (void)pthread_condattr_init(&attr);
+    (void)pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    (void)pthread_cond_init(&mPipeRxCond, &attr);
+    (void)pthread_condattr_destroy(&attr);
+
+    mPipeInterfaceId = interfaceId;
+    mPipeInitialized = TRUE;
+
+    OSA_InstallIntHandler(gPipeIrqId_c, Pipe_ISR);
+    NVIC_ClearPendingIRQ(gPipeIrqId_c);
+    NVIC_EnableIRQ(gPipeIrqId_c);
+
+    if( !Host_ThreadCreate(Pipe_RxThread, NULL, 0) ||
+        !Host_ThreadCreate(Pipe_TxThread, NULL, 0) )
+    {
+        return gPipeOpenError_c;
+    }
+
+    return gPipeSuccess_c;
+}
+
+/*! *********************************************************************************
+* \brief  Returns the path of the device to open on the other side
+*
+********************************************************************************** */
+const char* Pipe_GetDeviceName(void)
+{
+    return mPipeDeviceName;
+}
+
+/*! *********************************************************************************
+* \brief  Starts the transmission of a block. Called by the SerialManager.
+*
+* \return 0 if the transmission is started, 1 otherwise
+*
+********************************************************************************** */
+uint32_t Serial_CustomSendData(uint8_t *pData, uint32_t size)
+{
+    uint32_t status = 1;
+
+    (void)pthread_mutex_lock(&mPipeLock);
+    if( mPipeInitialized && (NULL == mpPipeTxData) )
+    {
+        mpPipeTxData = pData;
+        mPipeTxSize = size;
+        (void)pthread_cond_signal(&mPipeTxCond);
+        status = 0;
+    }
+    (void)pthread_mutex_unlock(&mPipeLock);
+
+    return status;
+}
+
+/*! *********************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+********************************************************************************** */
+
+/*! *********************************************************************************
+* \brief  Notifies the SerialManager of the end of a transmission and of the
+*         received bytes
+*
+********************************************************************************** */
+static void Pipe_ISR(void)
+{
+    bool_t txDone;
+    uint32_t count;
+    uint32_t offset;
+    uint32_t left;
+
+    (void)pthread_mutex_lock(&mPipeLock);
+    txDone = mPipeTxDone;
+    mPipeTxDone = FALSE;
+    count = mPipeRxCount;
+    offset = mPipeRxOffset;
+    (void)pthread_mutex_unlock(&mPipeLock);
+
+    if( txDone )
+    {
+        Serial_CustomSendCompleted(mPipeInterfaceId);
+    }
+
+    /* The receive thread does not touch the buffer until all bytes are stored */
+    if( count )
+    {
+        left = Serial_CustomReceiveData(mPipeInterfaceId, &mPipeRxBuffer[offset], count);
+
+        (void)pthread_mutex_lock(&mPipeLock);
+        mPipeRxOffset += count - left;
+        mPipeRxCount = left;
+        (void)pthread_cond_signal(&mPipeRxCond);
+        (void)pthread_mutex_unlock(&mPipeLock);
+    }
+}
+
+/*! *********************************************************************************
+* \brief  Reads the device, and hands the bytes to the handler
+*
+********************************************************************************** */
+static void* Pipe_RxThread(void *pParam)
+{
+    struct timespec deadline;
+    ssize_t count;
+
+    (void)pParam;
+
+    while( 1 )
+    {
+        count = read(mPipeRxFd, mPipeRxBuffer, sizeof(mPipeRxBuffer));
+
+        if( count < 0 )
+        {
+            if( (errno == EINTR) || (errno == EIO) )
+            {
+                /* EIO: no peer on the pseudo terminal */
+                OSA_TimeDelay(1);
+                continue;
+            }
+            break;
+        }
+
+        if( 0 == count )
+        {
+            /* End of the input stream */
+            break;
+        }
+
+        (void)pthread_mutex_lock(&mPipeLock);
+        mPipeRxOffset = 0;
+        mPipeRxCount = (uint32_t)count;
+
+        while( mPipeRxCount )
+        {
+            (void)pthread_mutex_unlock(&mPipeLock);
+            NVIC_SetPendingIRQ(gPipeIrqId_c);
+            (void)pthread_mutex_lock(&mPipeLock);
+
+            (void)clock_gettime(CLOCK_MONOTONIC, &deadline);
+            deadline.tv_nsec += gHostTickPeriodUs_c * 1000L;
+            if( deadline.tv_nsec >= 1000000000L )
+            {
+                deadline.tv_nsec -= 1000000000L;
+                deadline.tv_sec++;
+            }
+
+            /* Woken when the handler ran; the bytes left are delivered again */
+            (void)pthread_cond_timedwait(&mPipeRxCond, &mPipeLock, &deadline);
+        }
+        (void)pthread_mutex_unlock(&mPipeLock);
+    }
+
+    return NULL;
+}
+
+/*! *********************************************************************************
+* \brief  Writes the blocks of Serial_CustomSendData() to the device
+*
+********************************************************************************** */
+static void* Pipe_TxThread(void *pParam)
+{
+    uint8_t *pData;
+    uint32_t size;
+    ssize_t written;
+
+    (void)pParam;
+
+    while( 1 )
+    {
+        (void)pthread_mutex_lock(&mPipeLock);
+        while( NULL == mpPipeTxData )
+        {
+            (void)pthread_cond_wait(&mPipeTxCond, &mPipeLock);
+        }
+        pData = mpPipeTxData;
+        size = mPipeTxSize;
+        (void)pthread_mutex_unlock(&mPipeLock);
+
+        while( size )
+        {
+            written = write(mPipeTxFd, pData, size);
+
+            if( written < 0 )
+            {
+                if( errno == EINTR )
+                {
+                    continue;
+                }
+                /* The peer is gone: the data is dropped, as on an open line */
+                break;
+            }
+
+            pData += written;
+            size -= (uint32_t)written;
+        }
+
+        (void)pthread_mutex_lock(&mPipeLock);
+        mpPipeTxData = NULL;
+        mPipeTxDone = TRUE;
+        (void)pthread_mutex_unlock(&mPipeLock);
+
+        NVIC_SetPendingIRQ(gPipeIrqId_c);
+    }
+
+    return NULL;
+}
+
+/*! *********************************************************************************
+* \brief  Disables the line processing of a terminal, since the data is binary
+*
+********************************************************************************** */
+static void Pipe_SetRawMode(int fd)
+{
+    struct termios settings;
+
+    if( isatty(fd) && (0 == tcgetattr(fd, &settings)) )
+    {
+        cfmakeraw(&settings);
+        (void)tcsetattr(fd, TCSANOW, &settings);
+    }
+}
+
+#endif /* gSerialMgrUseCustomInterface_c */
@@ -0,0 +1,82 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* This is the header file for the Pipe adapter of the Host platform. It connects a
+* custom interface of the SerialManager to the standard streams of the process, to a
+* pseudo terminal, or to a FIFO or a tty device.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef __PIPE_ADAPTER_H__
+#define __PIPE_ADAPTER_H__
+
+/*! *********************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+********************************************************************************** */
+#include "EmbeddedTypes.h"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public macros
+*************************************************************************************
+********************************************************************************** */
+
+/* Interrupt used to run the notifications in interrupt context, like a UART */
+#ifndef gPipeIrqId_c
+#define gPipeIrqId_c          (LPUART0_IRQn)
+#endif
+
+/* Maximum number of bytes read at once */
+#ifndef gPipeRxBufferSize_c
+#define gPipeRxBufferSize_c   (64)
+#endif
+
+/* Device name which selects a new pseudo terminal */
+#define gPipePtyDevice_c      "pty"
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public type definitions
+*************************************************************************************
+********************************************************************************** */
+enum pipeStatus_tag {
+    gPipeSuccess_c,
+    gPipeInvalidParameter_c,
+    gPipeOpenError_c,
+    gPipeBusy_c
+};
+
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+
+/*! *********************************************************************************
+* \brief  Connects a custom interface of the SerialManager to a host device. Only one
+*         interface can be connected.
+*
+* \param[in]  interfaceId - interface returned by Serial_InitInterface() for the
+*                           gSerialMgrCustom_c type
+* \param[in]  pDevice     - NULL for the standard input and output, gPipePtyDevice_c
+*                           for a new pseudo terminal, or the path of a FIFO or a tty
+*
+* \return  gPipeSuccess_c, or an error code
+*
+********************************************************************************** */
+uint32_t Pipe_Initialize(uint8_t interfaceId, const char *pDevice);
+
+/*! *********************************************************************************
+* \brief  Returns the path of the device to open on the other side: the slave of the
+*         pseudo terminal, or the device given to Pipe_Initialize()
+*
+********************************************************************************** */
+const char* Pipe_GetDeviceName(void);
+
+#endif /* __PIPE_ADAPTER_H__ */
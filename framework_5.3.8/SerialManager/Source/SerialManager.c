@@ -260,7 +260,10 @@ osaEventId_t        mSMTaskEventId;
  * SMGR internal data
  */
 static serial_t      mSerials[gSerialManagerMaxInterfaces_c];
+#if (gSerialMgrUseUart_c && (FSL_FEATURE_SOC_UART_COUNT || FSL_FEATURE_SOC_LPUART_COUNT || FSL_FEATURE_SOC_LPSCI_COUNT)) || \
+    (gSerialMgrUseUSB_c) || (gSerialMgrUseUSB_VNIC_c) || (gSerialMgrUseIIC_c) || (gSerialMgrUseSPI_c)
 static smgrDrvData_t mDrvData[gSerialManagerMaxInterfaces_c];
+#endif
 
 /*
  * Default configuration for IIC driver
@@ -2194,7 +2197,8 @@ uint32_t Serial_CustomReceiveData(uint8_t InterfaceId, uint8_t *pRxData, uint32_
 {
     serial_t *pSer = &mSerials[InterfaceId];
 
-    while(size--)
+    /* size is the number of bytes not stored */
+    while(size)
     {
         OSA_InterruptDisable();
         pSer->rxBuffer[pSer->rxIn] = *pRxData++;
@@ -2204,10 +2208,10 @@ uint32_t Serial_CustomReceiveData(uint8_t InterfaceId, uint8_t *pRxData, uint32_
         {
             mSerial_DecIdx_d(pSer->rxIn, gSMRxBufSize_c);
             OSA_InterruptEnable();
-            size++;
             break;
         }
         OSA_InterruptEnable();
+        size--;
     }
 
     /* Signal SMGR task if not allready done */
@@ -94,6 +94,8 @@ void shell_writeHex(uint8_t *pHex, uint8_t len);
 void shell_writeHexLe(uint8_t *pHex, uint8_t len);
 void shell_writeBool(bool_t boolValue);
 void shell_putc(char c);
+uint16_t shell_get_tx_space(void);
+uint32_t shell_get_tx_dropped(void);
 #if SHELL_USE_PRINTF
 uint16_t shell_printf(char * format,...);
 #endif
@@ -121,6 +123,8 @@ void shell_task(void);
 #define shell_writeHexLe(pHex,len)
 #define shell_writeBool(boolValue)
 #define shell_putc(c)
+#define shell_get_tx_space()                           0
+#define shell_get_tx_dropped()                         0
 #define shell_find_command(cmd) NULL
 #define make_argv(s,argvsz,argv) 0
 #define shell_get_opt(argc,argv,pOption) NULL
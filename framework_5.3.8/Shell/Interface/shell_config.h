@@ -62,6 +62,20 @@
 #define SHELL_MAX_COMMANDS            (5)
 #endif
 
+/* number of buckets of the command index, power of 2 */
+#ifndef SHELL_CMD_HASH_SIZE
+#define SHELL_CMD_HASH_SIZE           (16)
+#endif
+
+/* output ring size, in bytes. If set to 0, every write waits for the serial
+   interface. Otherwise the output is sent with asynchronous serial writes; from
+   the Serial Manager task or without an RTOS the writer cannot wait for space,
+   and the output which does not fit in the ring is dropped, see
+   shell_get_tx_dropped() */
+#ifndef SHELL_TX_BUFFER_SIZE
+#define SHELL_TX_BUFFER_SIZE          (0)
+#endif
+
 /* Shell will use an alternate task for command processing */
 #ifndef SHELL_USE_ALT_TASK
 #define SHELL_USE_ALT_TASK            (0)
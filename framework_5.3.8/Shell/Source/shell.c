@@ -19,6 +19,7 @@
 #include "FunctionLib.h"
 #include "SerialManager.h"
 #include "MemManager.h"
+#include "fsl_os_abstraction.h"
 #include "mcux_board.h"
 
 #if SHELL_ENABLED
@@ -47,6 +48,31 @@ if( mCmdIdx < mCmdLen )                                 \
     mCmdIdx = mCmdLen;                                  \
 }
 
+/* Command index */
+#define mShellCmdNone_c         (0xFF)
+#define mShellCmdBucket_d(name) (shell_cmd_hash(name) & (SHELL_CMD_HASH_SIZE - 1))
+
+#if (SHELL_CMD_HASH_SIZE == 0) || (SHELL_CMD_HASH_SIZE & (SHELL_CMD_HASH_SIZE - 1))
+#error "SHELL_CMD_HASH_SIZE must be a power of 2"
+#endif
+
+#if (SHELL_MAX_COMMANDS >= mShellCmdNone_c)
+#error "SHELL_MAX_COMMANDS must be lower than 255"
+#endif
+
+/* Output ring */
+#if SHELL_TX_BUFFER_SIZE
+#define mShellTxEvent_c         (1 << 0)
+#define mShellTxIsBuffered_d()  ((SHELL_IO_TYPE != gSerialMgrIICSlave_c) && \
+                                 (SHELL_IO_TYPE != gSerialMgrSPISlave_c))
+
+#if defined(FWK_SMALL_RAM_CONFIG)
+#define mShellSerialTaskId      gFwkCommonTaskId
+#else
+#define mShellSerialTaskId      gSerialManagerTaskId
+#endif
+#endif
+
 /* Clear current input */
 #define SHELL_RESET() \
 {                            \
@@ -63,6 +89,13 @@ if( mCmdIdx < mCmdLen )                                 \
 static void shell_main( void *params );
 static int16_t shell_ProcessChr( void );
 static void shell_erase_to_eol( void );
+static uint32_t shell_cmd_hash( const char *name );
+#if SHELL_TX_BUFFER_SIZE
+static void shell_tx_write( const char *pBuff, uint16_t n );
+static uint16_t shell_tx_put( const char *pBuff, uint16_t n );
+static bool_t shell_tx_start( void );
+static void shell_tx_done( void *param );
+#endif
 
 /************************************************************************************
 *************************************************************************************
@@ -80,6 +113,22 @@ uint8_t  mShellMaxCmdLen = 0;
 
 cmd_tbl_t *gpCmdTable[SHELL_MAX_COMMANDS];
 
+/* Hashed command index: each bucket holds a list of gpCmdTable indexes */
+static uint8_t mShellCmdBucket[SHELL_CMD_HASH_SIZE];
+static uint8_t mShellCmdNext[SHELL_MAX_COMMANDS];
+
+#if SHELL_TX_BUFFER_SIZE
+/* Output ring. The Serial Manager owns [mShellTxTail, mShellTxTail + mShellTxSending) */
+static uint8_t           mShellTxBuf[SHELL_TX_BUFFER_SIZE];
+static volatile uint16_t mShellTxHead;
+static volatile uint16_t mShellTxTail;
+static volatile uint16_t mShellTxSending;
+static volatile uint32_t mShellTxDropped;
+static osaEventId_t      mShellTxEventId;
+
+extern osaTaskId_t mShellSerialTaskId;
+#endif
+
 int8_t (*mpfShellBreak)(uint8_t argc, char * argv[]) = NULL;
 void (*pfShellProcessCommand) (char * pCmd, uint16_t length) = NULL;
 
@@ -137,6 +186,13 @@ void shell_init(char* prompt)
 {
     pPrompt = prompt;
 
+#if SHELL_TX_BUFFER_SIZE
+    if( NULL == mShellTxEventId )
+    {
+        mShellTxEventId = OSA_EventCreate(TRUE);
+    }
+#endif
+
     SerialManager_Init();
 
     /* Register Serial Manager interface */
@@ -154,6 +210,7 @@ void shell_init(char* prompt)
     mCmdLen = 0;
     mCmdIdx = 0;
     FLib_MemSet(gpCmdTable, 0, sizeof(gpCmdTable));
+    FLib_MemSet(mShellCmdBucket, mShellCmdNone_c, sizeof(mShellCmdBucket));
     FLib_MemSet(mCmdBuf, 0, sizeof(mCmdBuf));
 #if SHELL_USE_HELP
     shell_register_function(&CommandFun_Help);
@@ -245,7 +302,11 @@ void shell_writeN(char *pBuff, uint16_t n)
     }
     else
     {
+#if SHELL_TX_BUFFER_SIZE
+        shell_tx_write(pBuff, n);
+#else
         Serial_SyncWrite(gShellSerMgrIf, (uint8_t*)pBuff, n);
+#endif
     }
 }
 
@@ -272,9 +333,54 @@ void shell_write( char *pBuff )
 ********************************************************************************** */
 void shell_putc(char c)
 {
+#if SHELL_TX_BUFFER_SIZE
+    if( mShellTxIsBuffered_d() )
+    {
+        shell_tx_write(&c, 1);
+        return;
+    }
+#endif
     Serial_SyncWrite(gShellSerMgrIf, (uint8_t*)&c, 1);
 }
 
+/*! *********************************************************************************
+* \brief  Returns the number of characters which can be written without waiting
+*
+* \return  free space in the output ring, or 0xFFFF if the output is not buffered
+*
+* \remarks Commands printing large amounts of data can use it to print in steps
+*
+********************************************************************************** */
+uint16_t shell_get_tx_space(void)
+{
+#if SHELL_TX_BUFFER_SIZE
+    uint16_t space;
+
+    OSA_InterruptDisable();
+    space = (mShellTxTail + SHELL_TX_BUFFER_SIZE - mShellTxHead - 1) % SHELL_TX_BUFFER_SIZE;
+    OSA_InterruptEnable();
+
+    return space;
+#else
+    return 0xFFFF;
+#endif
+}
+
+/*! *********************************************************************************
+* \brief  Returns the number of characters dropped because the output ring was full
+*
+* \return  number of dropped characters
+*
+********************************************************************************** */
+uint32_t shell_get_tx_dropped(void)
+{
+#if SHELL_TX_BUFFER_SIZE
+    return mShellTxDropped;
+#else
+    return 0;
+#endif
+}
+
 /*! *********************************************************************************
 * \brief  This function will write a decimal number over the serial interface
 *
@@ -288,7 +394,20 @@ void shell_writeDec
     uint32_t nb
 )
 {
+#if SHELL_TX_BUFFER_SIZE
+    char decString[10];
+    uint8_t i = sizeof(decString);
+
+    do
+    {
+        decString[--i] = '0' + (char)(nb % 10);
+        nb /= 10;
+    } while( nb );
+
+    shell_writeN(&decString[i], sizeof(decString) - i);
+#else
     Serial_PrintDec(gShellSerMgrIf, nb);
+#endif
 }
 
 /*! *********************************************************************************
@@ -310,7 +429,7 @@ void shell_writeSignedDec
         shell_write("-");
         nb = ~(nb - 1);
     }
-    Serial_PrintDec(gShellSerMgrIf, nb);
+    shell_writeDec((uint8_t)nb);
 }
 
 /*! *********************************************************************************
@@ -328,7 +447,19 @@ void shell_writeHex
     uint8_t len
 )
 {
+#if SHELL_TX_BUFFER_SIZE
+    char hexString[2];
+
+    while( len-- )
+    {
+        hexString[0] = HexToAscii(*pHex >> 4);
+        hexString[1] = HexToAscii(*pHex);
+        shell_writeN(hexString, sizeof(hexString));
+        pHex++;
+    }
+#else
     Serial_PrintHex(gShellSerMgrIf, pHex, len, gPrtHexBigEndian_c);
+#endif
 }
 
 /*! *********************************************************************************
@@ -346,7 +477,20 @@ void shell_writeHexLe
     uint8_t len
 )
 {
+#if SHELL_TX_BUFFER_SIZE
+    char hexString[2];
+
+    pHex += len;
+    while( len-- )
+    {
+        pHex--;
+        hexString[0] = HexToAscii(*pHex >> 4);
+        hexString[1] = HexToAscii(*pHex);
+        shell_writeN(hexString, sizeof(hexString));
+    }
+#else
     Serial_PrintHex(gShellSerMgrIf, pHex, len, gPrtHexNoFormat_c);
+#endif
 }
 
 /*! *********************************************************************************
@@ -388,19 +532,27 @@ void shell_writeBool
 uint16_t shell_printf(char * format,...)
 {
     va_list ap;
-    uint16_t n = 0;
-    char *pStr = (char*)MEM_BufferAlloc(SHELL_CB_SIZE);
+    int n;
+    char str[SHELL_CB_SIZE];
+
+    va_start(ap, format);
+    n = vsnprintf(str, SHELL_CB_SIZE, format, ap);
+    va_end(ap);
+
+    if( n < 0 )
+    {
+        return 0;
+    }
 
-    if (pStr)
+    /* The output is truncated to the buffer size */
+    if( n >= SHELL_CB_SIZE )
     {
-        va_start(ap, format);
-        n = vsnprintf(pStr, SHELL_CB_SIZE, format, ap);
-        //va_end(ap); /* follow MISRA... */
-        Serial_SyncWrite(gShellSerMgrIf, (uint8_t*)pStr, n);
-        MEM_BufferFree(pStr);
+        n = SHELL_CB_SIZE - 1;
     }
 
-    return n;
+    shell_writeN(str, (uint16_t)n);
+
+    return (uint16_t)n;
 }
 #endif
 
@@ -415,13 +567,12 @@ uint16_t shell_printf(char * format,...)
 uint8_t shell_register_function(cmd_tbl_t * pAddress)
 {
     uint16_t i;
+    uint32_t bucket;
+
     /* check name conflict */
-    for(i = 0; i< SHELL_MAX_COMMANDS; i++)
+    if (shell_find_command(pAddress->name))
     {
-        if (gpCmdTable[i] && !strcmp(pAddress->name, gpCmdTable[i]->name))
-        {
-            return 1;
-        }
+        return 1;
     }
     /* insert */
     for (i = 0; i< SHELL_MAX_COMMANDS; i++)
@@ -429,6 +580,10 @@ uint8_t shell_register_function(cmd_tbl_t * pAddress)
         if (gpCmdTable[i] == NULL)
         {
             gpCmdTable[i] =  pAddress;
+            /* add to the command index */
+            bucket = mShellCmdBucket_d(pAddress->name);
+            mShellCmdNext[i] = mShellCmdBucket[bucket];
+            mShellCmdBucket[bucket] = (uint8_t)i;
             // Update max command length
             i = strlen(pAddress->name);
             if (i > mShellMaxCmdLen)
@@ -469,15 +624,22 @@ void shell_register_function_array(cmd_tbl_t * pAddress, uint8_t num)
 ********************************************************************************** */
 uint8_t shell_unregister_function(char * name)
 {
-    uint16_t i;
+    uint8_t *pIdx;
+    uint8_t i;
+
+    pIdx = &mShellCmdBucket[mShellCmdBucket_d(name)];
 
-    for( i=0; i<SHELL_MAX_COMMANDS; i++ )
+    while( *pIdx != mShellCmdNone_c )
     {
-        if( gpCmdTable[i] && !strcmp(name, gpCmdTable[i]->name) )
+        i = *pIdx;
+        if( !strcmp(name, gpCmdTable[i]->name) )
         {
+            /* remove from the command index */
+            *pIdx = mShellCmdNext[i];
             gpCmdTable[i] = NULL;
             return 0;
         }
+        pIdx = &mShellCmdNext[i];
     }
 
     return 1;
@@ -536,16 +698,16 @@ char * shell_get_opt
 ********************************************************************************** */
 cmd_tbl_t * shell_find_command (char * cmd)
 {
-    uint16_t i;
+    uint8_t i;
 
     if (!cmd)
     {
         return NULL;
     }
 
-    for( i=0; i < SHELL_MAX_COMMANDS; i++)
+    for( i = mShellCmdBucket[mShellCmdBucket_d(cmd)]; i != mShellCmdNone_c; i = mShellCmdNext[i] )
     {
-        if ((gpCmdTable[i] != NULL) && !strcmp((char*)cmd, gpCmdTable[i]->name))
+        if (!strcmp((char*)cmd, gpCmdTable[i]->name))
         {
             return gpCmdTable[i];
         }
@@ -1023,4 +1185,179 @@ static void shell_erase_to_eol(void)
         mCmdLen = mCmdIdx;
     }
 }
+/*! *********************************************************************************
+* \brief  Computes the FNV-1a hash of a command name
+*
+* \param[in]  name  command name
+*
+* \return  hash
+*
+********************************************************************************** */
+static uint32_t shell_cmd_hash(const char *name)
+{
+    uint32_t hash = 2166136261U;
+
+    while( *name )
+    {
+        hash ^= (uint8_t)*name++;
+        hash *= 16777619U;
+    }
+
+    return hash;
+}
+
+#if SHELL_TX_BUFFER_SIZE
+/*! *********************************************************************************
+* \brief  Queues data into the output ring and starts the transmission.
+*         If the ring is full, the caller waits for the Serial Manager to free space.
+*         The Serial Manager task and bare metal applications cannot wait, so the
+*         characters which do not fit are dropped and counted. The ring should be
+*         sized for the largest output of a command, or SHELL_USE_ALT_TASK used.
+*
+* \param[in]  pBuff  pointer to the data
+* \param[in]  n      number of characters
+*
+********************************************************************************** */
+static void shell_tx_write(const char *pBuff, uint16_t n)
+{
+    osaEventFlags_t ev;
+    uint16_t written;
+
+    for( ;; )
+    {
+        written = shell_tx_put(pBuff, n);
+        pBuff += written;
+        n -= written;
+
+        if( !shell_tx_start() || (0 == n) ||
+            !gUseRtos_c || (OSA_TaskGetId() == mShellSerialTaskId) )
+        {
+            break;
+        }
+
+        (void)OSA_EventWait(mShellTxEventId, mShellTxEvent_c, FALSE, osaWaitForever_c, &ev);
+    }
+
+    if( n )
+    {
+        OSA_InterruptDisable();
+        mShellTxDropped += n;
+        OSA_InterruptEnable();
+    }
+}
+
+/*! *********************************************************************************
+* \brief  Copies as much data as fits into the output ring
+*
+* \param[in]  pBuff  pointer to the data
+* \param[in]  n      number of characters
+*
+* \return  number of characters copied
+*
+********************************************************************************** */
+static uint16_t shell_tx_put(const char *pBuff, uint16_t n)
+{
+    uint16_t head, space, chunk;
+    uint16_t written = 0;
+
+    /* The copy is bounded by the ring size */
+    OSA_InterruptDisable();
+    head = mShellTxHead;
+    space = (mShellTxTail + SHELL_TX_BUFFER_SIZE - head - 1) % SHELL_TX_BUFFER_SIZE;
+
+    if( n > space )
+    {
+        n = space;
+    }
+
+    while( written < n )
+    {
+        chunk = n - written;
+
+        if( chunk > SHELL_TX_BUFFER_SIZE - head )
+        {
+            chunk = SHELL_TX_BUFFER_SIZE - head;
+        }
+
+        FLib_MemCpy(&mShellTxBuf[head], (void*)&pBuff[written], chunk);
+        written += chunk;
+        head += chunk;
+
+        if( head == SHELL_TX_BUFFER_SIZE )
+        {
+            head = 0;
+        }
+    }
+
+    mShellTxHead = head;
+    OSA_InterruptEnable();
+
+    return written;
+}
+
+/*! *********************************************************************************
+* \brief  Passes the next contiguous block of the output ring to the Serial Manager,
+*         if no transmission is ongoing
+*
+* \return  TRUE if a transmission is ongoing, FALSE otherwise
+*
+********************************************************************************** */
+static bool_t shell_tx_start(void)
+{
+    uint16_t tail = 0;
+    uint16_t len = 0;
+    bool_t ongoing;
+
+    OSA_InterruptDisable();
+    if( (0 == mShellTxSending) && (mShellTxHead != mShellTxTail) )
+    {
+        tail = mShellTxTail;
+        len = (mShellTxHead > tail) ? (mShellTxHead - tail) : (SHELL_TX_BUFFER_SIZE - tail);
+        mShellTxSending = len;
+    }
+    ongoing = (0 != mShellTxSending);
+    OSA_InterruptEnable();
+
+    if( len )
+    {
+        if( gSerial_Success_c != Serial_AsyncWrite(gShellSerMgrIf, &mShellTxBuf[tail], len, shell_tx_done, NULL) )
+        {
+            OSA_InterruptDisable();
+            mShellTxSending = 0;
+            OSA_InterruptEnable();
+            ongoing = FALSE;
+        }
+    }
+
+    return ongoing;
+}
+
+/*! *********************************************************************************
+* \brief  Serial Manager TX callback. Frees the sent block, starts the next one and
+*         wakes up the writer waiting for space.
+*
+* \param[in]  param  not used
+*
+********************************************************************************** */
+static void shell_tx_done(void *param)
+{
+    uint16_t tail;
+
+    (void)param;
+
+    OSA_InterruptDisable();
+    tail = mShellTxTail + mShellTxSending;
+    mShellTxTail = (tail >= SHELL_TX_BUFFER_SIZE) ? (tail - SHELL_TX_BUFFER_SIZE) : tail;
+    mShellTxSending = 0;
+    OSA_InterruptEnable();
+
+    (void)shell_tx_start();
+
+    if( mShellTxEventId )
+    {
+        (void)OSA_EventSet(mShellTxEventId, mShellTxEvent_c);
+    }
+}
+#endif /* SHELL_TX_BUFFER_SIZE */
+
 #endif /* SHELL_ENABLED */
\ No newline at end of file
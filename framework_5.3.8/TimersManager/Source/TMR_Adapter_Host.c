@@ -0,0 +1,275 @@
+/*! *********************************************************************************
+* Copyright 2017 NXP
+* All rights reserved.
+*
+* \file
+*
+* TMR adapter of the Host platform. It replaces TMR_Adapter.c in a host build.
+*
+* The stack timer is a model of the TPM used on the MCU: a 16 bit free running
+* counter, at the TPM clock divided by 128, with one compare channel. A thread
+* follows CLOCK_MONOTONIC and pends the TPM interrupt when the counter reaches the
+* compare value or overflows. The interrupt is pended on these events only, so the
+* status flags are not modelled. The PWM functions have no effect.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#include <pthread.h>
+#include <time.h>
+
+#include "TMR_Adapter.h"
+#include "fsl_device_registers.h"
+#include "fsl_os_abstraction.h"
+#include "fsl_common.h"
+#include "mcux_board.h"
+#include "Host.h"
+
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mStackTimerIrqId_c        (TPM0_IRQn)
+#define mStackTimerPrescaler_c    (7)         /* divide by 128, as on the MCU */
+#define mStackTimerModulo_c       (0x10000U)
+
+/************************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+************************************************************************************/
+static void* StackTimer_Thread(void *pParam);
+static uint64_t StackTimer_GetTicks(void);
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static pthread_mutex_t mStackTimerLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  mStackTimerCond;
+static uint8_t         mStackTimerRunning;
+static uint32_t        mStackTimerFreqHz;
+static uint32_t        mStackTimerCompare = 0x01;
+/* Ticks counted before the last start, and the time of the last start */
+static uint64_t        mStackTimerBaseTicks;
+static uint64_t        mStackTimerStartUs;
+/* Ticks already checked for the compare and overflow events */
+static uint64_t        mStackTimerCheckedTicks;
+
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+void StackTimer_Init(void (*cb)(void))
+{
+    static uint8_t threadStarted;
+    pthread_condattr_t attr;
+
+    mStackTimerFreqHz = StackTimer_GetInputFrequency();
+
+    if( !threadStarted )
+    {
+        threadStarted = TRUE;
+        (void)pthread_condattr_init(&attr);
+        (void)pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+        (void)pthread_cond_init(&mStackTimerCond, &attr);
+        (void)pthread_condattr_destroy(&attr);
+        (void)Host_ThreadCreate(StackTimer_Thread, NULL, 0);
+    }
+
+    StackTimer_Disable();
+
+    /* Overwrite old ISR */
+    OSA_InstallIntHandler(mStackTimerIrqId_c, cb);
+    /* set interrupt priority */
+    NVIC_SetPriority(mStackTimerIrqId_c, gStackTimer_IsrPrio_c >> (8 - __NVIC_PRIO_BITS));
+    NVIC_ClearPendingIRQ(mStackTimerIrqId_c);
+    NVIC_EnableIRQ(mStackTimerIrqId_c);
+}
+
+/*************************************************************************************/
+void StackTimer_Enable(void)
+{
+    (void)pthread_mutex_lock(&mStackTimerLock);
+    if( !mStackTimerRunning )
+    {
+        mStackTimerStartUs = Host_GetTimeUs();
+        mStackTimerRunning = TRUE;
+        (void)pthread_cond_signal(&mStackTimerCond);
+    }
+    (void)pthread_mutex_unlock(&mStackTimerLock);
+}
+
+/*************************************************************************************/
+void StackTimer_Disable(void)
+{
+    (void)pthread_mutex_lock(&mStackTimerLock);
+    if( mStackTimerRunning )
+    {
+        mStackTimerBaseTicks = StackTimer_GetTicks();
+        mStackTimerRunning = FALSE;
+    }
+    (void)pthread_mutex_unlock(&mStackTimerLock);
+}
+
+/*************************************************************************************/
+uint32_t StackTimer_GetInputFrequency(void)
+{
+    return BOARD_GetTpmClock(gStackTimerInstance_c) / (1 << mStackTimerPrescaler_c);
+}
+
+/*************************************************************************************/
+uint32_t StackTimer_GetCounterValue(void)
+{
+    uint32_t counter;
+
+    (void)pthread_mutex_lock(&mStackTimerLock);
+    counter = (uint32_t)(StackTimer_GetTicks() % mStackTimerModulo_c);
+    (void)pthread_mutex_unlock(&mStackTimerLock);
+
+    return counter;
+}
+
+/*************************************************************************************/
+void StackTimer_SetOffsetTicks(uint32_t offset)
+{
+    (void)pthread_mutex_lock(&mStackTimerLock);
+    mStackTimerCompare = offset % mStackTimerModulo_c;
+    (void)pthread_cond_signal(&mStackTimerCond);
+    (void)pthread_mutex_unlock(&mStackTimerLock);
+}
+
+/*************************************************************************************/
+void StackTimer_ClearIntFlag(void)
+{
+}
+
+/*************************************************************************************/
+/*                                       PWM                                         */
+/*************************************************************************************/
+void PWM_Init(uint8_t instance)
+{
+    (void)instance;
+}
+
+/*************************************************************************************/
+void PWM_SetChnCountVal(uint8_t instance, uint8_t channel, uint16_t val)
+{
+    (void)instance;
+    (void)channel;
+    (void)val;
+}
+
+/*************************************************************************************/
+uint16_t PWM_GetChnCountVal(uint8_t instance, uint8_t channel)
+{
+    (void)instance;
+    (void)channel;
+    return 0;
+}
+
+/*************************************************************************************/
+void PWM_StartEdgeAlignedLowTrue(uint8_t instance, tmr_adapter_pwm_param_t *param, uint8_t channel)
+{
+    (void)instance;
+    (void)param;
+    (void)channel;
+}
+
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+
+/*************************************************************************************/
+/* Number of ticks counted since the init. Called with mStackTimerLock held.          */
+/*************************************************************************************/
+static uint64_t StackTimer_GetTicks(void)
+{
+    uint64_t ticks = mStackTimerBaseTicks;
+
+    if( mStackTimerRunning )
+    {
+        ticks += (Host_GetTimeUs() - mStackTimerStartUs) * mStackTimerFreqHz / 1000000U;
+    }
+
+    return ticks;
+}
+
+/*************************************************************************************/
+/* Sleeps until the next compare or overflow event, and pends the interrupt.        */
+/*************************************************************************************/
+static void* StackTimer_Thread(void *pParam)
+{
+    struct timespec deadline;
+    uint64_t ticks;
+    uint64_t nextEvent;
+    uint64_t waitUs;
+    uint32_t counter;
+    uint32_t toCompare;
+    bool_t event;
+
+    (void)pParam;
+    (void)pthread_mutex_lock(&mStackTimerLock);
+
+    while( 1 )
+    {
+        if( !mStackTimerRunning )
+        {
+            (void)pthread_cond_wait(&mStackTimerCond, &mStackTimerLock);
+            continue;
+        }
+
+        ticks = StackTimer_GetTicks();
+        event = FALSE;
+
+        /* The counter reached the compare value, or overflowed, since the last check */
+        if( ticks > mStackTimerCheckedTicks )
+        {
+            counter = (uint32_t)(mStackTimerCheckedTicks % mStackTimerModulo_c);
+            toCompare = (mStackTimerCompare - counter - 1) % mStackTimerModulo_c + 1;
+
+            if( (ticks - mStackTimerCheckedTicks >= toCompare) ||
+                (ticks / mStackTimerModulo_c != mStackTimerCheckedTicks / mStackTimerModulo_c) )
+            {
+                event = TRUE;
+            }
+        }
+        mStackTimerCheckedTicks = ticks;
+
+        if( event )
+        {
+            Host_NvicSetPendingIrq(mStackTimerIrqId_c);
+        }
+
+        /* The next event is the compare match or the overflow, whichever comes first */
+        counter = (uint32_t)(ticks % mStackTimerModulo_c);
+        toCompare = (mStackTimerCompare - counter - 1) % mStackTimerModulo_c + 1;
+        nextEvent = mStackTimerModulo_c - counter;
+        if( toCompare < nextEvent )
+        {
+            nextEvent = toCompare;
+        }
+
+        waitUs = (nextEvent * 1000000U + mStackTimerFreqHz - 1) / mStackTimerFreqHz;
+        (void)clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_sec  += (time_t)(waitUs / 1000000U);
+        deadline.tv_nsec += (long)(waitUs % 1000000U) * 1000;
+        if( deadline.tv_nsec >= 1000000000L )
+        {
+            deadline.tv_nsec -= 1000000000L;
+            deadline.tv_sec++;
+        }
+
+        (void)pthread_cond_timedwait(&mStackTimerCond, &mStackTimerLock, &deadline);
+    }
+
+    return NULL;
+}
@@ -18,6 +18,7 @@
 
 #include "fsl_device_registers.h"
 #include "fsl_os_abstraction.h"
+#include "Profiler.h"
 #include "fsl_common.h"
 #include "fsl_clock.h"
 #include "pin_mux.h"
@@ -952,6 +953,8 @@ void TMR_Task
     {
         (void)OSA_EventWait(mTimerThreadEventId, osaEventFlagsAll_c, FALSE, osaWaitForever_c, &ev);
 #endif
+        PROFILER_PROBE_START(mTmrTaskProbe, "TMR_Task");
+
         TmrIntDisableAll();
 
         currentTimeInTicks = StackTimer_GetCounterValue();
@@ -1088,6 +1091,8 @@ void TMR_Task
             
         TmrIntRestoreAll();      
 
+        PROFILER_PROBE_STOP(mTmrTaskProbe);
+
 #if !defined(FWK_SMALL_RAM_CONFIG)        
         /* For BareMetal break the while(1) after 1 run */
         if (gUseRtos_c == 0)